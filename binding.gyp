@@ -1,4 +1,11 @@
 {
+  "variables": {
+    # node-gyp rebuild --dspx_bench=true also builds the native benchmark
+    "dspx_bench%": "false",
+    # node-gyp rebuild --dspx_track_allocations=true counts heap allocations
+    # made while stages process (see src/native/utils/AllocationTracker.h)
+    "dspx_track_allocations%": "false"
+  },
   "targets": [
     {
       "target_name": "dspx",
@@ -16,12 +23,36 @@
         "src/native/core/MovingFftFilter.cc",
         "src/native/core/FirFilter.cc",
         "src/native/core/IirFilter.cc",
+        "src/native/core/MovingPercentileFilter.cc",
+        "src/native/core/EmgFeatureExtractor.cc",
+        "src/native/core/SpatialFilter.cc",
+        "src/native/core/StreamingPca.cc",
+        "src/native/core/LmsFilter.cc",
+        "src/native/core/RlsFilter.cc",
+        "src/native/core/KalmanFilter.cc",
+        "src/native/core/WaveletTransform.cc",
+        "src/native/core/MovingStatisticsFilter.cc",
         "src/native/FftBindings.cc",
         "src/native/FilterBindings.cc",
+        "src/native/SimdBindings.cc",
+        "src/native/utils/AllocationTracker.cc",
+        "src/native/utils/Arena.cc",
+        "src/native/utils/BinaryState.cc",
         "src/native/utils/CircularBufferArray.cc",
         "src/native/utils/CircularBufferVector.cc",
+        "src/native/utils/CpuFeatures.cc",
+        "src/native/utils/FloatCodec.cc",
         "src/native/utils/NapiUtils.cc",
+        "src/native/utils/PipelineMetrics.cc",
+        "src/native/utils/SimdDispatch.cc",
+        "src/native/utils/SimdKernelsAvx2.cc",
+        "src/native/utils/SimdKernelsAvx512.cc",
+        "src/native/utils/SimdKernelsNeon.cc",
+        "src/native/utils/SimdKernelsScalar.cc",
+        "src/native/utils/SimdKernelsSse2.cc",
         "src/native/utils/SlidingWindowFilter.cc",
+        "src/native/utils/MultiChannelSlidingWindow.cc",
+        "src/native/utils/PrefixSumWindow.cc",
         "src/native/utils/TimeSeriesBuffer.cc"
       ],
       "include_dirs": [
@@ -42,7 +73,7 @@
       "msvs_settings": {
         "VCCLCompilerTool": {
           "ExceptionHandling": 1,
-          "AdditionalOptions": [ "/std:c++17", "/O2", "/fp:fast", "/arch:AVX2" ],
+          "AdditionalOptions": [ "/std:c++17", "/O2", "/fp:fast" ],
           "Optimization": 3,
           "FavorSizeOrSpeed": 1,
           "InlineFunctionExpansion": 2
@@ -60,29 +91,115 @@
         ["OS=='win'", {
           "defines": [ "_HAS_EXCEPTIONS=1" ]
         }],
-        # Condition for x64 architecture (Linux/macOS)
-        ['target_arch=="x64"', {
-          "cflags+": [ "-msse3", "-mavx", "-mavx2" ],
-          "cflags_cc+": [ "-msse3", "-mavx", "-mavx2" ],
-          'xcode_settings': {
-            'OTHER_CPLUSPLUSFLAGS+': [ '-msse3', '-mavx', '-mavx2' ]
-          }
-        }],
-        # Condition for ia32 architecture (Linux/macOS - if you support 32-bit x86)
+        # x64 and arm64 build for the architecture baseline (SSE2 / NEON).
+        # Wider kernels (utils/SimdKernelsAvx2.cc, ...) are compiled per
+        # function with target attributes and picked at load time from
+        # cpuid, so one prebuild runs on every CPU of the architecture.
         ['target_arch=="ia32"', {
-           "cflags+": [ "-msse3", "-mavx", "-mavx2" ], # Or adjust based on 32-bit support
-           "cflags_cc+": [ "-msse3", "-mavx", "-mavx2" ],
+          "cflags+": [ "-msse2" ],
+          "cflags_cc+": [ "-msse2" ],
           'xcode_settings': {
-            'OTHER_CPLUSPLUSFLAGS+': [ '-msse3', '-mavx', '-mavx2' ]
+            'OTHER_CPLUSPLUSFLAGS+': [ '-msse2' ]
           }
+        }],
+        # Replaces the global operator new to count allocations (debug only).
+        # -Bsymbolic-functions makes the addon's own code use the replacement
+        # instead of the one exported by the node binary.
+        ["dspx_track_allocations=='true' and OS!='win'", {
+          "defines": [ "DSPX_TRACK_ALLOCATIONS" ],
+          "ldflags": [ "-Wl,-Bsymbolic-functions" ]
         }]
-        # Add NEON flags for arm64 if desired, e.g.:
-        # ['target_arch=="arm64"', {
-        #   "cflags+": ["-mfpu=neon"], # Example flag, check compiler docs
-        #   "cflags_cc+": ["-mfpu=neon"],
-        #   'xcode_settings': { 'OTHER_CPLUSPLUSFLAGS+': ['-mfpu=neon'] }
-        # }]
       ]
     }
+  ],
+  "conditions": [
+    # Standalone micro-benchmark (src/native/bench): the core filters, utils
+    # and FFT without N-API, compiled with the same optimization flags
+    ["dspx_bench=='true'", {
+      "targets": [
+        {
+          "target_name": "dspx_bench",
+          "type": "executable",
+          "sources": [
+            "src/native/bench/NativeBenchmark.cc",
+            "src/native/core/MovingAbsoluteValueFilter.cc",
+            "src/native/core/MovingAverageFilter.cc",
+            "src/native/core/MovingVarianceFilter.cc",
+            "src/native/core/MovingZScoreFilter.cc",
+            "src/native/core/RmsFilter.cc",
+            "src/native/core/SscFilter.cc",
+            "src/native/core/WampFilter.cc",
+            "src/native/core/WaveformLengthFilter.cc",
+            "src/native/core/FftEngine.cc",
+            "src/native/core/MovingFftFilter.cc",
+            "src/native/core/FirFilter.cc",
+            "src/native/core/IirFilter.cc",
+            "src/native/core/MovingPercentileFilter.cc",
+            "src/native/core/EmgFeatureExtractor.cc",
+            "src/native/core/SpatialFilter.cc",
+            "src/native/core/StreamingPca.cc",
+            "src/native/core/LmsFilter.cc",
+            "src/native/core/RlsFilter.cc",
+            "src/native/core/KalmanFilter.cc",
+            "src/native/core/WaveletTransform.cc",
+            "src/native/core/MovingStatisticsFilter.cc",
+            "src/native/utils/AllocationTracker.cc",
+            "src/native/utils/Arena.cc",
+            "src/native/utils/BinaryState.cc",
+            "src/native/utils/CircularBufferArray.cc",
+            "src/native/utils/CircularBufferVector.cc",
+            "src/native/utils/CpuFeatures.cc",
+            "src/native/utils/FloatCodec.cc",
+            "src/native/utils/SimdDispatch.cc",
+            "src/native/utils/SimdKernelsAvx2.cc",
+            "src/native/utils/SimdKernelsAvx512.cc",
+            "src/native/utils/SimdKernelsNeon.cc",
+            "src/native/utils/SimdKernelsScalar.cc",
+            "src/native/utils/SimdKernelsSse2.cc",
+            "src/native/utils/SlidingWindowFilter.cc",
+            "src/native/utils/MultiChannelSlidingWindow.cc",
+            "src/native/utils/PrefixSumWindow.cc",
+            "src/native/utils/TimeSeriesBuffer.cc"
+          ],
+          "include_dirs": [
+            "src/native",
+            "src/native/core",
+            "src/native/utils"
+          ],
+          "cflags!": [ "-fno-exceptions" ],
+          "cflags_cc!": [ "-fno-exceptions" ],
+          "cflags": [ "-O3", "-ffast-math" ],
+          "cflags_cc": [ "-std=c++17", "-O3", "-ffast-math" ],
+          "msvs_settings": {
+            "VCCLCompilerTool": {
+              "ExceptionHandling": 1,
+              "AdditionalOptions": [ "/std:c++17", "/O2", "/fp:fast" ],
+              "Optimization": 3,
+              "FavorSizeOrSpeed": 1,
+              "InlineFunctionExpansion": 2
+            }
+          },
+          "xcode_settings": {
+            "GCC_ENABLE_CPP_EXCEPTIONS": "YES",
+            "CLANG_CXX_LIBRARY": "libc++",
+            "MACOSX_DEPLOYMENT_TARGET": "10.15",
+            "OTHER_CPLUSPLUSFLAGS": [ "-std=c++17", "-stdlib=libc++", "-O3", "-ffast-math"],
+            "GCC_OPTIMIZATION_LEVEL": "3"
+          },
+          "conditions": [
+            ["OS=='win'", {
+              "defines": [ "_HAS_EXCEPTIONS=1" ]
+            }],
+            ['target_arch=="ia32"', {
+              "cflags+": [ "-msse2" ],
+              "cflags_cc+": [ "-msse2" ],
+              'xcode_settings': {
+                'OTHER_CPLUSPLUSFLAGS+': [ '-msse2' ]
+              }
+            }]
+          ]
+        }
+      ]
+    }]
   ]
 }
@@ -0,0 +1,52 @@
+// Compares two native benchmark results (JSON from dspx_bench).
+// Usage: node scripts/compare-bench.js base.json head.json [--threshold 10]
+// Exits with 1 when any benchmark got slower by more than threshold percent.
+import fs from "fs";
+
+const args = process.argv.slice(2);
+const thresholdIndex = args.indexOf("--threshold");
+const threshold =
+  thresholdIndex >= 0 ? Number(args.splice(thresholdIndex, 2)[1]) : 10;
+if (args.length !== 2 || !(threshold >= 0)) {
+  console.error(
+    "Usage: node scripts/compare-bench.js base.json head.json [--threshold 10]"
+  );
+  process.exit(2);
+}
+
+const load = (file) => JSON.parse(fs.readFileSync(file, "utf8"));
+const key = (r) => `${r.group}/${r.name} ch=${r.channels} n=${r.window}`;
+
+const [base, head] = args.map(load);
+const baseline = new Map(base.results.map((r) => [key(r), r]));
+
+console.log(
+  `base: ${base.label || "?"} (${base.machine.compiler}, ${base.machine.simd})`
+);
+console.log(
+  `head: ${head.label || "?"} (${head.machine.compiler}, ${head.machine.simd})\n`
+);
+
+let regressions = 0;
+for (const result of head.results) {
+  const before = baseline.get(key(result));
+  if (!before) {
+    continue;
+  }
+  const change = (result.nsPerItem / before.nsPerItem - 1) * 100;
+  let mark = "";
+  if (change > threshold) {
+    mark = "  <-- slower";
+    regressions++;
+  } else if (change < -threshold) {
+    mark = "  faster";
+  }
+  console.log(
+    `${key(result).padEnd(48)} ${before.nsPerItem.toFixed(2).padStart(10)} -> ` +
+      `${result.nsPerItem.toFixed(2).padStart(10)} ns/${result.unit} ` +
+      `(${change >= 0 ? "+" : ""}${change.toFixed(1)}%)${mark}`
+  );
+}
+
+console.log(`\n${regressions} regression(s) above ${threshold}%`);
+process.exit(regressions > 0 ? 1 : 0);
@@ -0,0 +1,34 @@
+// Runs the native micro-benchmark built by `node-gyp rebuild --dspx_bench=true`.
+// Arguments are passed through; the current git commit is used as the
+// label unless --label is given.
+import fs from "fs";
+import path from "path";
+import { execSync, spawn } from "child_process";
+
+const exe = path.resolve(
+  "build/Release",
+  process.platform === "win32" ? "dspx_bench.exe" : "dspx_bench"
+);
+if (!fs.existsSync(exe)) {
+  console.error(
+    `${exe} not found; build it with node-gyp rebuild --dspx_bench=true`
+  );
+  process.exit(1);
+}
+
+const args = process.argv.slice(2);
+if (!args.includes("--label")) {
+  try {
+    const commit = execSync("git rev-parse --short HEAD", {
+      stdio: ["ignore", "pipe", "ignore"],
+    });
+    args.push("--label", commit.toString().trim());
+  } catch {
+    // Not a git checkout; leave the label empty
+  }
+}
+
+const child = spawn(exe, args, { stdio: "inherit" });
+child.on("exit", (code) => {
+  process.exit(code ?? 1);
+});
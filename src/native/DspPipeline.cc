@@ -8,16 +8,33 @@
 #include "adapters/WaveformLengthStage.h"    // Waveform Length method
 #include "adapters/SscStage.h"               // Slope Sign Change method
 #include "adapters/WampStage.h"              // Willison Amplitude method
+#include "adapters/MovingPercentileStage.h"  // Moving Median / Percentile methods
+#include "adapters/EmgFeaturesStage.h"       // Fused EMG feature frames
+#include "adapters/MovingStatisticsStage.h"  // Several statistics over one window
+#include "adapters/PrebuiltStage.h"          // Fused fixed chains (StaticPipeline)
+#include "adapters/SpatialFilterStage.h"     // Channel mixing matrix (re-referencing)
+#include "adapters/PcaStage.h"               // Streaming PCA / whitening
+#include "adapters/LmsFilterStage.h"         // LMS / NLMS adaptive noise cancellation
+#include "adapters/RlsFilterStage.h"         // RLS adaptive noise cancellation
+#include "adapters/KalmanFilterStage.h"      // Batched per-channel Kalman filters
+#include "adapters/WaveletTransformStage.h"   // Streaming lifting DWT / wavelet denoising
+#include "utils/AllocationTracker.h"
+#include "utils/BinaryState.h"
+#include "utils/NapiUtils.h"
+#include "utils/PipelineMetrics.h"
 
 namespace dsp
 {
     // Forward declarations for bindings
     extern void InitFftBindings(Napi::Env env, Napi::Object exports);
     extern void InitFilterBindings(Napi::Env env, Napi::Object exports);
+    extern void InitSimdBindings(Napi::Env env, Napi::Object exports);
 }
 
 #include <iostream>
 #include <ctime>
+#include <cmath>
+#include <algorithm>
 
 namespace dsp
 {
@@ -37,6 +54,17 @@ namespace dsp
                                                                   InstanceMethod("loadState", &DspPipeline::LoadState),
                                                                   InstanceMethod("clearState", &DspPipeline::ClearState),
                                                                   InstanceMethod("listState", &DspPipeline::ListState),
+                                                                  InstanceMethod("saveStateBinary", &DspPipeline::SaveStateBinary),
+                                                                  InstanceMethod("loadStateBinary", &DspPipeline::LoadStateBinary),
+                                                                  InstanceMethod("checkpoint", &DspPipeline::Checkpoint),
+
+                                                                  // Timing counters
+                                                                  InstanceMethod("getMetrics", &DspPipeline::GetMetrics),
+                                                                  InstanceMethod("resetMetrics", &DspPipeline::ResetMetrics),
+
+                                                                  // Real-time mode
+                                                                  InstanceMethod("prepare", &DspPipeline::Prepare),
+                                                                  InstanceMethod("getAllocations", &DspPipeline::GetAllocations),
                                                               });
 
         exports.Set("DspPipeline", func);
@@ -48,6 +76,24 @@ namespace dsp
         : Napi::ObjectWrap<DspPipeline>(info)
     {
         // Config logic from TS (redis, stateKey) would go here
+        if (info.Length() >= 1 && info[0].IsObject())
+        {
+            Napi::Object config = info[0].As<Napi::Object>();
+            if (config.Has("snapshotCodec") && config.Get("snapshotCodec").IsString())
+            {
+                try
+                {
+                    m_floatCodec = dsp::utils::parseFloatCodec(
+                        config.Get("snapshotCodec").As<Napi::String>().Utf8Value());
+                }
+                catch (const std::invalid_argument &e)
+                {
+                    Napi::TypeError::New(info.Env(), e.what()).ThrowAsJavaScriptException();
+                    return;
+                }
+            }
+        }
+
         InitializeStageFactories();
     }
 
@@ -261,6 +307,451 @@ namespace dsp
 
             return std::make_unique<dsp::adapters::WampStage>(windowSize, threshold);
         };
+
+        // Shared parameter parsing for movingMedian / movingPercentile
+        auto makePercentileStage = [](const Napi::Object &params, double percentile, bool isMedian, const char *name)
+        {
+            size_t windowSize = 0;
+            double windowDurationMs = 0.0;
+
+            if (params.Has("windowSize"))
+            {
+                windowSize = params.Get("windowSize").As<Napi::Number>().Uint32Value();
+            }
+            else if (params.Has("windowDuration"))
+            {
+                windowDurationMs = params.Get("windowDuration").As<Napi::Number>().DoubleValue();
+            }
+            else
+            {
+                throw std::invalid_argument(std::string(name) + ": either 'windowSize' or 'windowDuration' is required");
+            }
+
+            dsp::adapters::PercentileMethod method = dsp::adapters::PercentileMethod::Exact;
+            if (params.Has("method"))
+            {
+                std::string methodStr = params.Get("method").As<Napi::String>().Utf8Value();
+                if (methodStr == "approximate")
+                {
+                    method = dsp::adapters::PercentileMethod::Approximate;
+                }
+                else if (methodStr != "exact")
+                {
+                    throw std::invalid_argument(std::string(name) + ": method must be 'exact' or 'approximate'");
+                }
+            }
+
+            return std::make_unique<dsp::adapters::MovingPercentileStage>(percentile, method, windowSize, windowDurationMs, isMedian);
+        };
+
+        // Factory for Moving Median stage
+        m_stageFactories["movingMedian"] = [makePercentileStage](const Napi::Object &params)
+        {
+            return makePercentileStage(params, 50.0, true, "MovingMedian");
+        };
+
+        // Factory for Moving Percentile stage
+        m_stageFactories["movingPercentile"] = [makePercentileStage](const Napi::Object &params)
+        {
+            if (!params.Has("percentile"))
+            {
+                throw std::invalid_argument("MovingPercentile: 'percentile' is required");
+            }
+            double percentile = params.Get("percentile").As<Napi::Number>().DoubleValue();
+            return makePercentileStage(params, percentile, false, "MovingPercentile");
+        };
+
+        // Factory for the multi-statistic window stage
+        m_stageFactories["movingStatistics"] = [](const Napi::Object &params)
+        {
+            if (!params.Has("windowSize"))
+            {
+                throw std::invalid_argument("MovingStatistics: 'windowSize' is required");
+            }
+            size_t windowSize = params.Get("windowSize").As<Napi::Number>().Uint32Value();
+
+            if (!params.Has("statistics"))
+            {
+                throw std::invalid_argument("MovingStatistics: 'statistics' is required");
+            }
+            Napi::Array names = params.Get("statistics").As<Napi::Array>();
+            std::vector<dsp::core::MovingStatistic> statistics;
+            for (uint32_t i = 0; i < names.Length(); ++i)
+            {
+                std::string name = names.Get(i).As<Napi::String>().Utf8Value();
+                dsp::core::MovingStatistic statistic;
+                if (!dsp::core::parseMovingStatistic(name, statistic))
+                {
+                    throw std::invalid_argument("MovingStatistics: unknown statistic '" + name + "'");
+                }
+                statistics.push_back(statistic);
+            }
+
+            return std::make_unique<dsp::adapters::MovingStatisticsStage>(windowSize, std::move(statistics));
+        };
+
+        // Factory for the fused EMG feature stage
+        m_stageFactories["emgFeatures"] = [](const Napi::Object &params)
+        {
+            if (!params.Has("windowSize"))
+            {
+                throw std::invalid_argument("EmgFeatures: 'windowSize' is required");
+            }
+            size_t windowSize = params.Get("windowSize").As<Napi::Number>().Uint32Value();
+
+            size_t hopSize = windowSize;
+            if (params.Has("hopSize"))
+            {
+                hopSize = params.Get("hopSize").As<Napi::Number>().Uint32Value();
+            }
+
+            // Default: every feature, in declaration order
+            std::vector<dsp::core::EmgFeature> features = {
+                dsp::core::EmgFeature::MeanAbsoluteValue, dsp::core::EmgFeature::Rms,
+                dsp::core::EmgFeature::WaveformLength, dsp::core::EmgFeature::SlopeSignChange,
+                dsp::core::EmgFeature::WillisonAmplitude, dsp::core::EmgFeature::ZeroCrossings,
+                dsp::core::EmgFeature::Variance};
+            if (params.Has("features"))
+            {
+                Napi::Array names = params.Get("features").As<Napi::Array>();
+                features.clear();
+                for (uint32_t i = 0; i < names.Length(); ++i)
+                {
+                    std::string name = names.Get(i).As<Napi::String>().Utf8Value();
+                    dsp::core::EmgFeature feature;
+                    if (!dsp::core::parseEmgFeature(name, feature))
+                    {
+                        throw std::invalid_argument("EmgFeatures: unknown feature '" + name + "'");
+                    }
+                    features.push_back(feature);
+                }
+            }
+
+            auto threshold = [&params](const char *key)
+            {
+                return params.Has(key) ? params.Get(key).As<Napi::Number>().FloatValue() : 0.0f;
+            };
+
+            return std::make_unique<dsp::adapters::EmgFeaturesStage>(
+                windowSize, hopSize, std::move(features),
+                threshold("sscThreshold"), threshold("wampThreshold"), threshold("zcThreshold"));
+        };
+
+        // Factory for the spatial filter (channel mixing matrix) stage
+        m_stageFactories["spatialFilter"] = [](const Napi::Object &params)
+        {
+            if (!params.Has("mode"))
+            {
+                throw std::invalid_argument("SpatialFilter: 'mode' is required");
+            }
+            std::string mode = params.Get("mode").As<Napi::String>().Utf8Value();
+
+            auto requireChannels = [&params]()
+            {
+                if (!params.Has("channels"))
+                {
+                    throw std::invalid_argument("SpatialFilter: 'channels' is required");
+                }
+                return static_cast<size_t>(params.Get("channels").As<Napi::Number>().Uint32Value());
+            };
+
+            dsp::core::SpatialLayout layout = dsp::core::SpatialLayout::Auto;
+            if (params.Has("layout"))
+            {
+                std::string name = params.Get("layout").As<Napi::String>().Utf8Value();
+                if (name == "dense")
+                {
+                    layout = dsp::core::SpatialLayout::Dense;
+                }
+                else if (name == "sparse")
+                {
+                    layout = dsp::core::SpatialLayout::Sparse;
+                }
+                else if (name != "auto")
+                {
+                    throw std::invalid_argument("SpatialFilter: unknown layout '" + name + "'");
+                }
+            }
+
+            size_t inputChannels = 0;
+            size_t outputChannels = 0;
+            std::vector<float> weights;
+            if (mode == "car")
+            {
+                inputChannels = outputChannels = requireChannels();
+                weights = dsp::core::SpatialFilter::commonAverage(inputChannels);
+            }
+            else if (mode == "laplacian")
+            {
+                if (!params.Has("neighbors"))
+                {
+                    throw std::invalid_argument("SpatialFilter: 'neighbors' is required");
+                }
+                Napi::Array lists = params.Get("neighbors").As<Napi::Array>();
+                std::vector<std::vector<size_t>> neighbors(lists.Length());
+                for (uint32_t c = 0; c < lists.Length(); ++c)
+                {
+                    Napi::Array list = lists.Get(c).As<Napi::Array>();
+                    for (uint32_t i = 0; i < list.Length(); ++i)
+                    {
+                        neighbors[c].push_back(list.Get(i).As<Napi::Number>().Uint32Value());
+                    }
+                }
+                inputChannels = outputChannels = neighbors.size();
+                weights = dsp::core::SpatialFilter::laplacian(inputChannels, neighbors);
+            }
+            else if (mode == "bipolar")
+            {
+                inputChannels = requireChannels();
+                if (!params.Has("pairs"))
+                {
+                    throw std::invalid_argument("SpatialFilter: 'pairs' is required");
+                }
+                Napi::Array list = params.Get("pairs").As<Napi::Array>();
+                std::vector<std::pair<size_t, size_t>> pairs;
+                for (uint32_t i = 0; i < list.Length(); ++i)
+                {
+                    Napi::Array pair = list.Get(i).As<Napi::Array>();
+                    pairs.emplace_back(pair.Get(0u).As<Napi::Number>().Uint32Value(),
+                                       pair.Get(1u).As<Napi::Number>().Uint32Value());
+                }
+                outputChannels = pairs.size();
+                weights = dsp::core::SpatialFilter::bipolar(inputChannels, pairs);
+            }
+            else if (mode == "matrix")
+            {
+                inputChannels = requireChannels();
+                if (!params.Has("weights"))
+                {
+                    throw std::invalid_argument("SpatialFilter: 'weights' is required");
+                }
+                weights = dsp::utils::NapiArrayToVector<float>(params.Get("weights").As<Napi::Array>());
+                outputChannels = inputChannels > 0 ? weights.size() / inputChannels : 0;
+            }
+            else
+            {
+                throw std::invalid_argument("SpatialFilter: unknown mode '" + mode + "'");
+            }
+
+            return std::make_unique<dsp::adapters::SpatialFilterStage>(
+                mode, dsp::core::SpatialFilter(outputChannels, inputChannels, std::move(weights), layout));
+        };
+
+        // Factory for the streaming PCA / whitening stage
+        m_stageFactories["pca"] = [](const Napi::Object &params)
+        {
+            dsp::core::PcaOptions options;
+            if (params.Has("mode"))
+            {
+                std::string mode = params.Get("mode").As<Napi::String>().Utf8Value();
+                if (!dsp::core::parsePcaMode(mode, options.mode))
+                {
+                    throw std::invalid_argument("Pca: unknown mode '" + mode + "'");
+                }
+            }
+            if (params.Has("components"))
+            {
+                options.components = params.Get("components").As<Napi::Number>().Uint32Value();
+            }
+            if (params.Has("windowSize"))
+            {
+                options.windowSize = params.Get("windowSize").As<Napi::Number>().Uint32Value();
+            }
+            if (params.Has("alpha"))
+            {
+                options.alpha = params.Get("alpha").As<Napi::Number>().DoubleValue();
+            }
+            if (params.Has("updateInterval"))
+            {
+                options.updateInterval = params.Get("updateInterval").As<Napi::Number>().Uint32Value();
+            }
+            if (params.Has("epsilon"))
+            {
+                options.epsilon = params.Get("epsilon").As<Napi::Number>().DoubleValue();
+            }
+            if (params.Has("background"))
+            {
+                options.background = params.Get("background").As<Napi::Boolean>().Value();
+            }
+
+            return std::make_unique<dsp::adapters::PcaStage>(options);
+        };
+
+        // Factory for the LMS / NLMS adaptive filters (same stage, NLMS normalizes the step)
+        auto lmsFactory = [](bool normalized)
+        {
+            return [normalized](const Napi::Object &params)
+            {
+                const char *name = normalized ? "NlmsFilter" : "LmsFilter";
+                if (!params.Has("numTaps"))
+                {
+                    throw std::invalid_argument(std::string(name) + ": 'numTaps' is required");
+                }
+                if (!params.Has("stepSize"))
+                {
+                    throw std::invalid_argument(std::string(name) + ": 'stepSize' is required");
+                }
+                size_t numTaps = params.Get("numTaps").As<Napi::Number>().Uint32Value();
+                float stepSize = params.Get("stepSize").As<Napi::Number>().FloatValue();
+                float epsilon = params.Has("epsilon") ? params.Get("epsilon").As<Napi::Number>().FloatValue() : 1e-6f;
+                int referenceChannel =
+                    params.Has("referenceChannel") ? params.Get("referenceChannel").As<Napi::Number>().Int32Value() : -1;
+
+                return std::make_unique<dsp::adapters::LmsFilterStage>(numTaps, stepSize, normalized, epsilon,
+                                                                       referenceChannel);
+            };
+        };
+        m_stageFactories["lmsFilter"] = lmsFactory(false);
+        m_stageFactories["nlmsFilter"] = lmsFactory(true);
+
+        // Factory for the RLS adaptive filter
+        m_stageFactories["rlsFilter"] = [](const Napi::Object &params)
+        {
+            if (!params.Has("numTaps"))
+            {
+                throw std::invalid_argument("RlsFilter: 'numTaps' is required");
+            }
+            size_t numTaps = params.Get("numTaps").As<Napi::Number>().Uint32Value();
+            float lambda = params.Has("lambda") ? params.Get("lambda").As<Napi::Number>().FloatValue() : 0.99f;
+            float delta = params.Has("delta") ? params.Get("delta").As<Napi::Number>().FloatValue() : 0.01f;
+            int referenceChannel =
+                params.Has("referenceChannel") ? params.Get("referenceChannel").As<Napi::Number>().Int32Value() : -1;
+
+            return std::make_unique<dsp::adapters::RlsFilterStage>(numTaps, lambda, delta, referenceChannel);
+        };
+
+        // Factory for the batched Kalman filter (one filter per channel, shared model)
+        m_stageFactories["kalmanFilter"] = [](const Napi::Object &params)
+        {
+            dsp::core::KalmanOptions options;
+            if (params.Has("model"))
+            {
+                std::string model = params.Get("model").As<Napi::String>().Utf8Value();
+                if (!dsp::core::parseKalmanModel(model, options.model))
+                {
+                    throw std::invalid_argument("KalmanFilter: unknown model '" + model + "'");
+                }
+            }
+            if (params.Has("processNoise"))
+            {
+                options.processNoise = params.Get("processNoise").As<Napi::Number>().FloatValue();
+            }
+            if (params.Has("measurementNoise"))
+            {
+                options.measurementNoise = params.Get("measurementNoise").As<Napi::Number>().FloatValue();
+            }
+            if (params.Has("dt"))
+            {
+                options.dt = params.Get("dt").As<Napi::Number>().FloatValue();
+            }
+            if (params.Has("initialCovariance"))
+            {
+                options.initialCovariance = params.Get("initialCovariance").As<Napi::Number>().FloatValue();
+            }
+            if (params.Has("steadyState"))
+            {
+                options.steadyState = params.Get("steadyState").As<Napi::Boolean>().Value();
+            }
+            if (options.model == dsp::core::KalmanModel::Custom)
+            {
+                for (const char *name : {"transition", "observation", "processCovariance"})
+                {
+                    if (!params.Has(name))
+                    {
+                        throw std::invalid_argument(std::string("KalmanFilter: '") + name +
+                                                    "' is required for a custom model");
+                    }
+                }
+                options.transition =
+                    dsp::utils::NapiArrayToVector<float>(params.Get("transition").As<Napi::Array>());
+                options.observation =
+                    dsp::utils::NapiArrayToVector<float>(params.Get("observation").As<Napi::Array>());
+                options.processCovariance =
+                    dsp::utils::NapiArrayToVector<float>(params.Get("processCovariance").As<Napi::Array>());
+            }
+
+            return std::make_unique<dsp::adapters::KalmanFilterStage>(options);
+        };
+
+        // Factory for the streaming discrete wavelet transform (lifting scheme)
+        m_stageFactories["waveletTransform"] = [](const Napi::Object &params)
+        {
+            dsp::core::WaveletOptions options;
+            if (params.Has("wavelet"))
+            {
+                std::string wavelet = params.Get("wavelet").As<Napi::String>().Utf8Value();
+                if (!dsp::core::parseWavelet(wavelet, options.order))
+                {
+                    throw std::invalid_argument("WaveletTransform: unknown wavelet '" + wavelet + "'");
+                }
+            }
+            if (params.Has("levels"))
+            {
+                options.levels = params.Get("levels").As<Napi::Number>().Uint32Value();
+            }
+            if (params.Has("mode"))
+            {
+                std::string mode = params.Get("mode").As<Napi::String>().Utf8Value();
+                if (!dsp::core::parseWaveletMode(mode, options.mode))
+                {
+                    throw std::invalid_argument("WaveletTransform: unknown mode '" + mode + "'");
+                }
+            }
+            if (params.Has("thresholdMode"))
+            {
+                std::string thresholdMode = params.Get("thresholdMode").As<Napi::String>().Utf8Value();
+                if (!dsp::core::parseWaveletThreshold(thresholdMode, options.thresholdMode))
+                {
+                    throw std::invalid_argument("WaveletTransform: unknown thresholdMode '" + thresholdMode + "'");
+                }
+            }
+            if (params.Has("threshold"))
+            {
+                // One threshold for every level, or one per level (finest first)
+                Napi::Value threshold = params.Get("threshold");
+                if (threshold.IsArray())
+                {
+                    options.thresholds = dsp::utils::NapiArrayToVector<float>(threshold.As<Napi::Array>());
+                }
+                else
+                {
+                    options.thresholds.assign(options.levels, threshold.As<Napi::Number>().FloatValue());
+                }
+            }
+
+            return std::make_unique<dsp::adapters::WaveletTransformStage>(options);
+        };
+
+        // Factory for the named prebuilt (statically fused) chains
+        m_stageFactories["prebuilt"] = [](const Napi::Object &params)
+        {
+            if (!params.Has("name"))
+            {
+                throw std::invalid_argument("Prebuilt: 'name' is required");
+            }
+            std::string name = params.Get("name").As<Napi::String>().Utf8Value();
+
+            if (!params.Has("windowSize"))
+            {
+                throw std::invalid_argument("Prebuilt: 'windowSize' is required");
+            }
+            dsp::adapters::PrebuiltParams prebuilt;
+            prebuilt.windowSize = params.Get("windowSize").As<Napi::Number>().Uint32Value();
+            if (params.Has("zScoreWindowSize"))
+            {
+                prebuilt.zScoreWindowSize = params.Get("zScoreWindowSize").As<Napi::Number>().Uint32Value();
+            }
+            if (params.Has("epsilon"))
+            {
+                prebuilt.epsilon = params.Get("epsilon").As<Napi::Number>().FloatValue();
+            }
+            if (params.Has("mode"))
+            {
+                prebuilt.halfWave = params.Get("mode").As<Napi::String>().Utf8Value() == "half";
+            }
+
+            return dsp::adapters::makePrebuiltStage(name, prebuilt);
+        };
     }
 
     /**
@@ -281,8 +772,19 @@ namespace dsp
         {
             try
             {
-                // Factory found - create and add the stage
-                m_stages.push_back(it->second(params));
+                // Factory found - create and add the stage (a worker may be
+                // walking the stage list, so append under the state lock).
+                // Buffers sized by the constructor come from the arena.
+                std::unique_ptr<IDspStage> stage;
+                {
+                    dsp::utils::ArenaScope scope(&m_arena);
+                    stage = it->second(params);
+                }
+                std::lock_guard<std::mutex> lock(m_stateMutex);
+                m_stages.push_back(std::move(stage));
+                m_metrics.addStage();
+                m_realtime.prepared = false; // The new stage has not been prepared
+                m_summaries.capture(m_stages); // Listed even while a chunk is running
             }
             catch (const std::invalid_argument &e)
             {
@@ -306,6 +808,19 @@ namespace dsp
         return env.Undefined();
     }
 
+    void StageSummaries::capture(const std::vector<std::unique_ptr<IDspStage>> &pipeline)
+    {
+        // Counters only: describe() never touches the buffered samples
+        std::lock_guard<std::mutex> lock(mutex);
+        types.resize(pipeline.size());
+        stages.resize(pipeline.size());
+        for (size_t i = 0; i < pipeline.size(); ++i)
+        {
+            types[i] = pipeline[i]->getType();
+            stages[i] = pipeline[i]->describe();
+        }
+    }
+
     /**
      * AsyncWorker for processing DSP pipeline in background thread
      */
@@ -315,22 +830,44 @@ namespace dsp
         ProcessWorker(Napi::Env env,
                       Napi::Promise::Deferred deferred,
                       std::vector<std::unique_ptr<IDspStage>> &stages,
+                      std::mutex &stateMutex,
+                      dsp::utils::PipelineMetrics &metrics,
+                      dsp::utils::Arena &arena,
+                      size_t &preparedStages,
+                      RealtimeStats &realtime,
+                      StageSummaries &summaries,
                       float *data,
-                      float *timestamps,
+                      const float *timestamps,
                       size_t numSamples,
                       int channels,
                       Napi::Reference<Napi::Float32Array> &&bufferRef,
-                      Napi::Reference<Napi::Float32Array> &&timestampRef)
+                      Napi::Reference<Napi::Float32Array> &&timestampRef,
+                      std::shared_ptr<const std::vector<float>> implicitTimestamps = nullptr)
             : Napi::AsyncWorker(env),
               m_deferred(std::move(deferred)),
               m_stages(stages),
+              m_stateMutex(stateMutex),
+              m_metrics(metrics),
+              m_arena(arena),
+              m_preparedStages(preparedStages),
+              m_realtime(realtime),
+              m_summaries(summaries),
+              m_queuedNs(dsp::utils::monotonicNs()),
               m_data(data),
               m_timestamps(timestamps),
               m_numSamples(numSamples),
               m_channels(channels),
               m_bufferRef(std::move(bufferRef)),
-              m_timestampRef(std::move(timestampRef))
+              m_timestampRef(std::move(timestampRef)),
+              m_implicitTimestamps(std::move(implicitTimestamps))
         {
+            // Reserve the resizing stages' buffers here, on the main thread,
+            // so Execute() only resizes within capacity
+            for (int i = 0; i < 2; ++i)
+            {
+                m_outputs[i].reserve(realtime.outputCapacity);
+                m_outputTimestamps[i].reserve(realtime.outputCapacity);
+            }
         }
 
     protected:
@@ -341,42 +878,145 @@ namespace dsp
             {
                 // Process the buffer through all stages
                 // Pass timestamps to stages that support time-based processing
-                for (const auto &stage : m_stages)
+                std::lock_guard<std::mutex> lock(m_stateMutex);
+                const uint64_t startNs = dsp::utils::monotonicNs();
+                m_metrics.queue.record(startNs - m_queuedNs);
+
+                // Stages work in place on the caller's buffer until a resizing
+                // stage writes a new stream; from then on they work on that one
+                float *data = m_data;
+                const float *timestamps = m_timestamps;
+                size_t numSamples = m_numSamples;
+                int channels = m_channels;
+
+                // Debug hook: counts heap allocations made by the stages
+                // (zero unless built with DSPX_TRACK_ALLOCATIONS)
+                dsp::utils::AllocationScope allocations;
+
+                uint64_t stageStartNs = startNs;
+                for (size_t i = 0; i < m_stages.size(); ++i)
                 {
-                    stage->process(m_data, m_numSamples, m_channels, m_timestamps);
+                    const size_t inputSamples = numSamples;
+                    // Stages size their per-channel windows on their first
+                    // chunk: carve those from the arena, later ones from the heap
+                    dsp::utils::ArenaScope scope(i >= m_preparedStages ? &m_arena : nullptr);
+                    if (m_stages[i]->isResizing())
+                    {
+                        // Ping-pong between two output buffers so a stage never
+                        // writes over its own input
+                        auto &output = m_outputs[m_resized % 2];
+                        auto &outputTimestamps = m_outputTimestamps[m_resized % 2];
+                        const size_t capacity = m_stages[i]->maxOutputSize(numSamples, channels);
+                        output.resize(capacity);
+                        outputTimestamps.resize(capacity);
+
+                        int outputChannels = channels;
+                        numSamples = m_stages[i]->processResizing(data, numSamples, channels, timestamps,
+                                                                  output.data(), outputTimestamps.data(), outputChannels);
+                        data = output.data();
+                        timestamps = outputTimestamps.data();
+                        channels = outputChannels;
+                        ++m_resized;
+                    }
+                    else
+                    {
+                        m_stages[i]->process(data, numSamples, channels, timestamps);
+                    }
+
+                    const uint64_t stageEndNs = dsp::utils::monotonicNs();
+                    m_metrics.stage(i).record(stageEndNs - stageStartNs, inputSamples);
+                    stageStartNs = stageEndNs;
                 }
+                m_metrics.execute.record(stageStartNs - startNs);
+                m_outputSamples = numSamples;
+                m_preparedStages = m_stages.size();
+
+                ++m_realtime.calls;
+                m_realtime.allocatingCalls += allocations.count() > 0 ? 1 : 0;
+                m_realtime.allocations += allocations.count();
+                m_realtime.allocatedBytes += allocations.bytes();
+                m_realtime.lastCallAllocations = allocations.count();
+
+                // Outside the counted stage loop, so it never shows up as a
+                // real-time allocation
+                m_summaries.capture(m_stages);
             }
             catch (const std::exception &e)
             {
                 SetError(e.what());
             }
+            m_executedNs = dsp::utils::monotonicNs();
         }
 
         // This runs on the main thread after Execute() completes
         void OnOK() override
         {
+            m_metrics.resolve.record(dsp::utils::monotonicNs() - m_executedNs);
             Napi::Env env = Env();
-            // Resolve the promise with the processed buffer
-            Napi::Float32Array buffer = m_bufferRef.Value();
-            m_deferred.Resolve(buffer);
+            // Resolve the promise with the processed buffer, or with a copy of
+            // the last resizing stage's output
+            if (m_resized == 0)
+            {
+                Napi::Float32Array buffer = m_bufferRef.Value();
+                m_deferred.Resolve(buffer);
+                return;
+            }
+            const std::vector<float> &output = m_outputs[(m_resized - 1) % 2];
+            Napi::Float32Array result = Napi::Float32Array::New(env, m_outputSamples);
+            std::copy(output.begin(), output.begin() + m_outputSamples, result.Data());
+            m_deferred.Resolve(result);
         }
 
         void OnError(const Napi::Error &error) override
         {
+            m_metrics.resolve.record(dsp::utils::monotonicNs() - m_executedNs);
             m_deferred.Reject(error.Value());
         }
 
     private:
         Napi::Promise::Deferred m_deferred;
         std::vector<std::unique_ptr<IDspStage>> &m_stages;
+        std::mutex &m_stateMutex;
+        dsp::utils::PipelineMetrics &m_metrics;
+        dsp::utils::Arena &m_arena;
+        size_t &m_preparedStages; // Stages that have run at least once (guarded by m_stateMutex)
+        RealtimeStats &m_realtime;  // Allocation counters (guarded by m_stateMutex)
+        StageSummaries &m_summaries;
+        uint64_t m_queuedNs;
+        uint64_t m_executedNs = 0;
         float *m_data;
-        float *m_timestamps;
+        const float *m_timestamps;
         size_t m_numSamples;
         int m_channels;
         Napi::Reference<Napi::Float32Array> m_bufferRef;
         Napi::Reference<Napi::Float32Array> m_timestampRef;
+        std::shared_ptr<const std::vector<float>> m_implicitTimestamps; // Keeps synthesized timestamps alive
+        std::vector<float> m_outputs[2];          // Resizing stage outputs (ping-pong)
+        std::vector<float> m_outputTimestamps[2]; // Their per-sample timestamps
+        size_t m_resized = 0;                     // Resizing stages run
+        size_t m_outputSamples = 0;               // Samples in the final stream
     };
 
+    /**
+     * Uniform streams usually arrive in fixed-size chunks, so the synthesized
+     * clock is built once and shared by every call with the same shape.
+     * A replaced clock stays alive for any worker still holding it.
+     */
+    std::shared_ptr<const std::vector<float>> DspPipeline::GetImplicitTimestamps(size_t numSamples, double periodMs)
+    {
+        if (!m_implicitTimestamps || m_implicitTimestamps->size() != numSamples || m_implicitPeriodMs != periodMs)
+        {
+            auto timestamps = std::make_shared<std::vector<float>>(numSamples);
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                (*timestamps)[i] = static_cast<float>(static_cast<double>(i) * periodMs);
+            }
+            m_implicitTimestamps = std::move(timestamps);
+            m_implicitPeriodMs = periodMs;
+        }
+        return m_implicitTimestamps;
+    }
+
     /**
      * This is the "Process" method.
      * TS calls:
@@ -399,7 +1039,7 @@ namespace dsp
         //   process(buffer, timestamps, options) - new time-based API
         //   process(buffer, options) - legacy sample-based API (timestamps = nullptr)
         Napi::Float32Array jsTimestamps;
-        float *timestamps = nullptr;
+        const float *timestamps = nullptr;
         Napi::Object options;
 
         if (info.Length() >= 2 && info[1].IsTypedArray())
@@ -419,12 +1059,27 @@ namespace dsp
         }
         else
         {
-            // Legacy API: no timestamps (will use sample indices)
+            // Legacy API: no timestamps
             options = info[1].As<Napi::Object>();
         }
 
         int channels = options.Get("channels").As<Napi::Number>().Uint32Value();
-        // int sampleRate = options.Get("sampleRate").As<Napi::Number>().Uint32Value();
+
+        // Without explicit timestamps the stream is treated as uniformly sampled:
+        // i * (1000 / sampleRate) ms, or plain sample indices when no rate is given.
+        // The clock is cached on the pipeline so steady chunk sizes allocate nothing.
+        std::shared_ptr<const std::vector<float>> implicitTimestamps;
+        if (timestamps == nullptr)
+        {
+            double periodMs = 1.0;
+            Napi::Value sampleRate = options.Get("sampleRate");
+            if (sampleRate.IsNumber() && sampleRate.As<Napi::Number>().DoubleValue() > 0.0)
+            {
+                periodMs = 1000.0 / sampleRate.As<Napi::Number>().DoubleValue();
+            }
+            implicitTimestamps = GetImplicitTimestamps(numSamples, periodMs);
+            timestamps = implicitTimestamps->data();
+        }
 
         // 3. Create a deferred promise and get the promise before moving
         Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
@@ -433,13 +1088,13 @@ namespace dsp
         // 4. Create references to keep buffers alive during async operation
         Napi::Reference<Napi::Float32Array> bufferRef = Napi::Reference<Napi::Float32Array>::New(jsBuffer, 1);
         Napi::Reference<Napi::Float32Array> timestampRef;
-        if (timestamps != nullptr)
+        if (!implicitTimestamps)
         {
             timestampRef = Napi::Reference<Napi::Float32Array>::New(jsTimestamps, 1);
         }
 
         // 5. Create and queue the worker
-        ProcessWorker *worker = new ProcessWorker(env, std::move(deferred), m_stages, data, timestamps, numSamples, channels, std::move(bufferRef), std::move(timestampRef));
+        ProcessWorker *worker = new ProcessWorker(env, std::move(deferred), m_stages, m_stateMutex, m_metrics, m_arena, m_preparedStages, m_realtime, m_summaries, data, timestamps, numSamples, channels, std::move(bufferRef), std::move(timestampRef), std::move(implicitTimestamps));
         worker->Queue();
 
         // 6. Return the promise immediately
@@ -460,7 +1115,9 @@ namespace dsp
         // Save timestamp
         stateObj.Set("timestamp", static_cast<double>(std::time(nullptr)));
 
-        // Save pipeline configuration and full state
+        // Save pipeline configuration and full state; the lock keeps workers
+        // (process, checkpoint) off the stages while they are serialized
+        std::lock_guard<std::mutex> lock(m_stateMutex);
         Napi::Array stagesArray = Napi::Array::New(env, m_stages.size());
 
         for (size_t i = 0; i < m_stages.size(); ++i)
@@ -537,6 +1194,7 @@ namespace dsp
             std::cout << "Restoring pipeline state with " << stageCount << " stages" << std::endl;
 
             // Restore each stage's state
+            std::lock_guard<std::mutex> lock(m_stateMutex);
             for (uint32_t i = 0; i < stageCount; ++i)
             {
                 Napi::Object stageConfig = stagesArray.Get(i).As<Napi::Object>();
@@ -559,22 +1217,488 @@ namespace dsp
         }
     }
 
-    /**
-     * Clear all pipeline state (reset all stages)
-     * This resets filters to their initial state without removing them
-     */
-    Napi::Value DspPipeline::ClearState(const Napi::CallbackInfo &info)
+    namespace
     {
-        Napi::Env env = info.Env();
-
+        // Binary snapshot layout (all values little-endian):
+        //
+        //   header   magic "DSPB" | u16 version | u16 flags | f64 timestamp | u32 stageCount
+        //            u64 generation | u64 baseGeneration            (version >= 2)
+        //   stage*   string type | u8 encoding | u32 length | payload[length]
+        //   trailer  u32 CRC-32 of every preceding byte
+        //
+        // encoding 0 = the stage's own serializeBinary() section,
+        // encoding 1 = its serializeState() tree written with WriteNapiValue(),
+        // encoding 2 = a serializeBinaryDelta() section (delta snapshots only).
+        //
+        // Every checkpoint gets the next generation number. A full snapshot is
+        // its own base (baseGeneration == generation); a delta snapshot
+        // (flag bit 0) only applies on top of the state at baseGeneration.
+        // saveStateBinary() snapshots are generation 0 and do not move the
+        // chain, so deltas keep following the previous checkpoint.
+        //
+        // Flag bits 1-2 hold the FloatCodec used for every float array in the
+        // stage sections (0 = raw).
+        constexpr uint8_t kSnapshotMagic[4] = {'D', 'S', 'P', 'B'};
+        constexpr uint16_t kSnapshotVersion = 2;
+        constexpr uint16_t kSnapshotFlagDelta = 1u << 0;
+        constexpr uint16_t kSnapshotCodecShift = 1;
+        constexpr uint16_t kSnapshotCodecMask = 0x3u << kSnapshotCodecShift;
+        constexpr uint16_t kSnapshotKnownFlags = kSnapshotFlagDelta | kSnapshotCodecMask;
+        constexpr uint8_t kStageEncodingNative = 0;
+        constexpr uint8_t kStageEncodingTree = 1;
+        constexpr uint8_t kStageEncodingDelta = 2;
+        constexpr size_t kSnapshotHeaderSize = 4 + 2 + 2 + 8 + 4; // version 1 header, the minimum
+        constexpr size_t kSnapshotTrailerSize = 4;
+
+        void appendChecksum(dsp::utils::BinaryWriter &writer)
+        {
+            writer.writeU32(dsp::utils::crc32(writer.data(), writer.size()));
+        }
+
+        // Writes the header, every captured stage section (float arrays
+        // through the snapshot codec) and the checksum. Touches no stage,
+        // so it runs without the state lock.
+        void EncodeSnapshot(const SnapshotCapture &capture, dsp::utils::BinaryWriter &writer)
+        {
+            for (uint8_t byte : kSnapshotMagic)
+            {
+                writer.writeU8(byte);
+            }
+            writer.writeU16(kSnapshotVersion);
+            writer.writeU16(capture.flags);
+            writer.writeF64(capture.timestamp);
+            writer.writeU32(static_cast<uint32_t>(capture.stages.size()));
+            writer.writeU64(capture.generation);
+            writer.writeU64(capture.baseGeneration);
+
+            size_t begin = 0;
+            for (const SnapshotCapture::Stage &stage : capture.stages)
+            {
+                writer.writeString(stage.type);
+                writer.writeU8(stage.encoding);
+                size_t marker = writer.beginSection();
+                writer.setFloatCodec(capture.codec);
+                writer.writeReencoded(capture.sections, capture.floatArrays, begin, stage.end);
+                writer.setFloatCodec(dsp::utils::FloatCodec::None);
+                writer.endSection(marker);
+                begin = stage.end;
+            }
+            appendChecksum(writer);
+        }
+    }
+
+    std::vector<std::vector<dsp::utils::WindowMark>> DspPipeline::CollectWindowMarks() const
+    {
+        std::vector<std::vector<dsp::utils::WindowMark>> marks;
+        marks.reserve(m_stages.size());
+        for (const auto &stage : m_stages)
+        {
+            marks.push_back(stage->windowMarks());
+        }
+        return marks;
+    }
+
+    void DspPipeline::CaptureSnapshot(SnapshotCapture &capture, const Napi::Env *env, bool chain, uint32_t maxDeltas)
+    {
+        // Compaction: a delta needs the marks of the previous snapshot, and a
+        // full base is forced after maxDeltas deltas or once deltas stop paying off
+        bool delta = chain && maxDeltas > 0 &&
+                     !m_forceFullSnapshot &&
+                     m_deltasSinceBase < maxDeltas &&
+                     m_generationMarks.size() == m_stages.size();
+        // Plain saves are generation 0, which no delta is ever based on
+        uint64_t generation = chain ? m_generation + 1 : 0;
+
+        capture.flags = static_cast<uint16_t>((delta ? kSnapshotFlagDelta : 0) |
+                                              (static_cast<uint16_t>(m_floatCodec) << kSnapshotCodecShift));
+        capture.timestamp = static_cast<double>(std::time(nullptr));
+        capture.generation = generation;
+        capture.baseGeneration = delta ? m_generation : generation;
+        capture.codec = m_floatCodec;
+        capture.stages.clear();
+        capture.stages.reserve(m_stages.size());
+
+        // Float arrays are copied raw; EncodeSnapshot() applies the codec
+        dsp::utils::BinaryWriter &writer = capture.sections;
+        writer.logFloatArrays(&capture.floatArrays);
+        size_t start = writer.size();
+
+        for (size_t i = 0; i < m_stages.size(); ++i)
+        {
+            const auto &stage = m_stages[i];
+            SnapshotCapture::Stage section;
+            section.type = stage->getType();
+            section.encoding = kStageEncodingDelta;
+
+            if (!(delta && stage->serializeBinaryDelta(writer, m_generationMarks[i])))
+            {
+                section.encoding = kStageEncodingNative;
+                if (!stage->serializeBinary(writer))
+                {
+                    if (env == nullptr)
+                    {
+                        throw std::runtime_error(std::string(stage->getType()) +
+                                                 " has no binary state; use saveStateBinary() instead");
+                    }
+                    section.encoding = kStageEncodingTree;
+                    dsp::utils::WriteNapiValue(writer, stage->serializeState(*env));
+                }
+            }
+            section.end = writer.size();
+            capture.stages.push_back(std::move(section));
+        }
+        writer.logFloatArrays(nullptr);
+
+        if (!chain)
+        {
+            return;
+        }
+        size_t written = writer.size() - start;
+        m_generation = generation;
+        m_generationMarks = CollectWindowMarks();
+        if (delta)
+        {
+            ++m_deltasSinceBase;
+            // Windows mostly rewritten since the base: the next snapshot is a full one
+            m_forceFullSnapshot = written * 2 > m_lastBaseSize;
+        }
+        else
+        {
+            m_deltasSinceBase = 0;
+            m_lastBaseSize = written;
+            m_forceFullSnapshot = false;
+        }
+    }
+
+    void DspPipeline::DecodeSnapshot(Napi::Env env, const uint8_t *data, size_t size)
+    {
+        if (size < kSnapshotHeaderSize + kSnapshotTrailerSize)
+        {
+            throw std::runtime_error("Snapshot too small");
+        }
+
+        // Verify the checksum before trusting any length field
+        size_t bodySize = size - kSnapshotTrailerSize;
+        dsp::utils::BinaryReader trailer(data + bodySize, kSnapshotTrailerSize);
+        if (trailer.readU32() != dsp::utils::crc32(data, bodySize))
+        {
+            throw std::runtime_error("Snapshot checksum mismatch");
+        }
+
+        dsp::utils::BinaryReader reader(data, bodySize);
+        for (uint8_t byte : kSnapshotMagic)
+        {
+            if (reader.readU8() != byte)
+            {
+                throw std::runtime_error("Not a DSP pipeline snapshot");
+            }
+        }
+
+        uint16_t version = reader.readU16();
+        if (version > kSnapshotVersion)
+        {
+            throw std::runtime_error("Unsupported snapshot version " + std::to_string(version));
+        }
+        uint16_t flags = reader.readU16();
+        if (flags & ~kSnapshotKnownFlags)
+        {
+            throw std::runtime_error("Unsupported snapshot flags " + std::to_string(flags));
+        }
+        reader.setFloatCodec(static_cast<dsp::utils::FloatCodec>((flags & kSnapshotCodecMask) >> kSnapshotCodecShift));
+        reader.readF64(); // timestamp
+
+        uint32_t stageCount = reader.readU32();
+        if (stageCount != m_stages.size())
+        {
+            throw std::runtime_error("Stage count mismatch: expected " +
+                                     std::to_string(m_stages.size()) + " but got " + std::to_string(stageCount));
+        }
+
+        uint64_t generation = 0;
+        uint64_t baseGeneration = 0;
+        if (version >= 2)
+        {
+            generation = reader.readU64();
+            baseGeneration = reader.readU64();
+        }
+
+        // A delta only applies to the exact state of its base generation:
+        // the last snapshot loaded (or written), with nothing processed since
+        bool delta = (flags & kSnapshotFlagDelta) != 0;
+        if (delta)
+        {
+            if (m_generationMarks.size() != m_stages.size() || baseGeneration != m_generation)
+            {
+                throw std::runtime_error("Delta snapshot " + std::to_string(generation) +
+                                         " needs base generation " + std::to_string(baseGeneration) +
+                                         " but the pipeline is at generation " + std::to_string(m_generation));
+            }
+            if (CollectWindowMarks() != m_generationMarks)
+            {
+                throw std::runtime_error("Delta snapshot " + std::to_string(generation) +
+                                         " cannot be applied: the pipeline has changed since generation " +
+                                         std::to_string(m_generation));
+            }
+        }
+
+        // Until every stage is restored there is no consistent generation
+        m_generationMarks.clear();
+
+        for (uint32_t i = 0; i < stageCount; ++i)
+        {
+            std::string type = reader.readString();
+            if (type != m_stages[i]->getType())
+            {
+                throw std::runtime_error("Stage " + std::to_string(i) + " type mismatch: expected " +
+                                         m_stages[i]->getType() + " but got " + type);
+            }
+
+            uint8_t encoding = reader.readU8();
+            dsp::utils::BinaryReader section = reader.readSection(reader.readU32());
+
+            if (encoding == kStageEncodingNative)
+            {
+                m_stages[i]->deserializeBinary(section);
+            }
+            else if (encoding == kStageEncodingDelta && delta)
+            {
+                m_stages[i]->deserializeBinaryDelta(section);
+            }
+            else if (encoding == kStageEncodingTree)
+            {
+                Napi::Value state = dsp::utils::ReadNapiValue(env, section);
+                m_stages[i]->deserializeState(state.As<Napi::Object>());
+            }
+            else
+            {
+                throw std::runtime_error("Unknown stage encoding " + std::to_string(encoding));
+            }
+
+            if (section.remaining() != 0)
+            {
+                throw std::runtime_error("Stage " + std::to_string(i) + " (" + type + ") left unread bytes in snapshot");
+            }
+        }
+
+        if (reader.remaining() != 0)
+        {
+            throw std::runtime_error("Snapshot has trailing data");
+        }
+
+        // Further deltas of this chain can now be applied; a checkpoint taken
+        // from here on starts a new chain with a full base
+        m_generation = generation;
+        m_generationMarks = CollectWindowMarks();
+        m_deltasSinceBase = 0;
+        m_forceFullSnapshot = true;
+    }
+
+    /**
+     * Save current pipeline state as a binary snapshot
+     * Far smaller and faster than SaveState for large windows: sample buffers
+     * are copied as raw float arrays instead of one JS number per sample.
+     *
+     * Returns: Buffer holding the snapshot
+     */
+    Napi::Value DspPipeline::SaveStateBinary(const Napi::CallbackInfo &info)
+    {
+        Napi::Env env = info.Env();
+
+        try
+        {
+            SnapshotCapture capture;
+            {
+                std::lock_guard<std::mutex> lock(m_stateMutex);
+                CaptureSnapshot(capture, &env, false, 0);
+            }
+            dsp::utils::BinaryWriter writer;
+            EncodeSnapshot(capture, writer);
+            return Napi::Buffer<uint8_t>::Copy(env, writer.data(), writer.size());
+        }
+        catch (const std::exception &e)
+        {
+            Napi::Error::New(env, std::string("Failed to save state: ") + e.what())
+                .ThrowAsJavaScriptException();
+            return env.Undefined();
+        }
+    }
+
+    /**
+     * Load pipeline state from a binary snapshot
+     *
+     * Accepts: Buffer, Uint8Array or ArrayBuffer produced by saveStateBinary
+     */
+    Napi::Value DspPipeline::LoadStateBinary(const Napi::CallbackInfo &info)
+    {
+        Napi::Env env = info.Env();
+
+        const uint8_t *data = nullptr;
+        size_t size = 0;
+        if (info.Length() >= 1 && info[0].IsArrayBuffer())
+        {
+            Napi::ArrayBuffer buffer = info[0].As<Napi::ArrayBuffer>();
+            data = static_cast<const uint8_t *>(buffer.Data());
+            size = buffer.ByteLength();
+        }
+        else if (info.Length() >= 1 && info[0].IsTypedArray())
+        {
+            Napi::TypedArray view = info[0].As<Napi::TypedArray>();
+            data = static_cast<const uint8_t *>(view.ArrayBuffer().Data()) + view.ByteOffset();
+            size = view.ByteLength();
+        }
+        else
+        {
+            Napi::TypeError::New(env, "Expected state snapshot (Buffer, Uint8Array or ArrayBuffer) as first argument")
+                .ThrowAsJavaScriptException();
+            return env.Undefined();
+        }
+
+        try
+        {
+            std::lock_guard<std::mutex> lock(m_stateMutex);
+            DecodeSnapshot(env, data, size);
+            return Napi::Boolean::New(env, true);
+        }
+        catch (const std::exception &e)
+        {
+            Napi::Error::New(env, std::string("Failed to load state: ") + e.what())
+                .ThrowAsJavaScriptException();
+            return Napi::Boolean::New(env, false);
+        }
+    }
+
+    /**
+     * AsyncWorker for background checkpoints
+     *
+     * Execute() takes the state lock only long enough to copy every stage's
+     * binary section into a private buffer (the capture therefore sits
+     * between two processed chunks), then releases it and writes the header
+     * and checksum while processing continues.
+     */
+    class CheckpointWorker : public Napi::AsyncWorker
+    {
+    public:
+        CheckpointWorker(Napi::Env env,
+                         Napi::Promise::Deferred deferred,
+                         std::mutex &stateMutex,
+                         std::atomic<size_t> &lastSize,
+                         std::function<void(SnapshotCapture &)> capture)
+            : Napi::AsyncWorker(env),
+              m_deferred(std::move(deferred)),
+              m_stateMutex(stateMutex),
+              m_lastSize(lastSize),
+              m_capture(std::move(capture))
+        {
+        }
+
+    protected:
+        void Execute() override
+        {
+            try
+            {
+                const size_t expected = m_lastSize.load(std::memory_order_relaxed);
+                SnapshotCapture capture;
+                capture.sections.reserve(expected);
+                {
+                    std::lock_guard<std::mutex> lock(m_stateMutex);
+                    m_capture(capture);
+                }
+                m_writer.reserve(expected);
+                EncodeSnapshot(capture, m_writer);
+                m_lastSize.store(m_writer.size(), std::memory_order_relaxed);
+            }
+            catch (const std::exception &e)
+            {
+                SetError(std::string("Checkpoint failed: ") + e.what());
+            }
+        }
+
+        void OnOK() override
+        {
+            // Hand the bytes to JS without another copy on the main thread
+            auto *bytes = new std::vector<uint8_t>(std::move(m_writer.buffer()));
+            Napi::Buffer<uint8_t> buffer = Napi::Buffer<uint8_t>::New(
+                Env(), bytes->data(), bytes->size(),
+                [](Napi::Env, uint8_t *, std::vector<uint8_t> *hint)
+                { delete hint; },
+                bytes);
+            m_deferred.Resolve(buffer);
+        }
+
+        void OnError(const Napi::Error &error) override
+        {
+            m_deferred.Reject(error.Value());
+        }
+
+    private:
+        Napi::Promise::Deferred m_deferred;
+        std::mutex &m_stateMutex;
+        std::atomic<size_t> &m_lastSize;
+        std::function<void(SnapshotCapture &)> m_capture;
+        dsp::utils::BinaryWriter m_writer;
+    };
+
+    /**
+     * Start a background checkpoint
+     * TS calls:
+     *   const snapshot = await native.checkpoint();
+     *   const snapshot = await native.checkpoint({ delta: true, fullEvery: 16 });
+     * Resolves with the same binary format as saveStateBinary(). With delta,
+     * window stages only record the samples pushed since the previous
+     * snapshot; a full base is still written at least every fullEvery checkpoints.
+     */
+    Napi::Value DspPipeline::Checkpoint(const Napi::CallbackInfo &info)
+    {
+        Napi::Env env = info.Env();
+
+        uint32_t maxDeltas = 0;
+        if (info.Length() >= 1 && info[0].IsObject())
+        {
+            Napi::Object options = info[0].As<Napi::Object>();
+            if (options.Has("delta") && options.Get("delta").ToBoolean().Value())
+            {
+                double fullEvery = 16;
+                if (options.Has("fullEvery") && options.Get("fullEvery").IsNumber())
+                {
+                    fullEvery = options.Get("fullEvery").As<Napi::Number>().DoubleValue();
+                }
+                if (!(fullEvery >= 1))
+                {
+                    Napi::TypeError::New(env, "fullEvery must be at least 1").ThrowAsJavaScriptException();
+                    return env.Undefined();
+                }
+                maxDeltas = static_cast<uint32_t>(std::min(fullEvery, 4294967296.0) - 1);
+            }
+        }
+
+        Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+        Napi::Promise promise = deferred.Promise();
+
+        auto capture = [this, maxDeltas](SnapshotCapture &snapshot)
+        { CaptureSnapshot(snapshot, nullptr, true, maxDeltas); };
+
+        CheckpointWorker *worker = new CheckpointWorker(env, std::move(deferred), m_stateMutex,
+                                                        m_lastCheckpointSize, std::move(capture));
+        worker->Queue();
+
+        return promise;
+    }
+
+    /**
+     * Clear all pipeline state (reset all stages)
+     * This resets filters to their initial state without removing them
+     */
+    Napi::Value DspPipeline::ClearState(const Napi::CallbackInfo &info)
+    {
+        Napi::Env env = info.Env();
+
         // Reset all stages
+        std::lock_guard<std::mutex> lock(m_stateMutex);
         for (auto &stage : m_stages)
         {
             stage->reset();
         }
 
-        std::cout << "Pipeline state cleared (" << m_stages.size() << " stages reset)" << std::endl;
-
         return env.Undefined();
     }
 
@@ -588,56 +1712,67 @@ namespace dsp
     Napi::Value DspPipeline::ListState(const Napi::CallbackInfo &info)
     {
         Napi::Env env = info.Env();
+
+        // Never wait for a chunk on the JS thread: describe the stages now if
+        // no worker holds the state lock, else report the last chunk's counters
+        std::vector<const char *> types;
+        std::vector<StageDescription> descriptions;
+        {
+            std::unique_lock<std::mutex> stateLock(m_stateMutex, std::try_to_lock);
+            if (stateLock.owns_lock())
+            {
+                m_summaries.capture(m_stages);
+            }
+            std::lock_guard<std::mutex> lock(m_summaries.mutex);
+            types = m_summaries.types;
+            descriptions = m_summaries.stages;
+        }
+
         Napi::Object summary = Napi::Object::New(env);
 
         // Basic pipeline info
-        summary.Set("stageCount", static_cast<uint32_t>(m_stages.size()));
+        summary.Set("stageCount", static_cast<uint32_t>(types.size()));
         summary.Set("timestamp", static_cast<double>(std::time(nullptr)));
 
         // Create array of stage summaries
-        Napi::Array stagesArray = Napi::Array::New(env, m_stages.size());
+        Napi::Array stagesArray = Napi::Array::New(env, types.size());
 
-        for (size_t i = 0; i < m_stages.size(); ++i)
+        for (size_t i = 0; i < types.size(); ++i)
         {
             Napi::Object stageSummary = Napi::Object::New(env);
 
             // Basic stage info
             stageSummary.Set("index", static_cast<uint32_t>(i));
-            stageSummary.Set("type", m_stages[i]->getType());
+            stageSummary.Set("type", types[i]);
 
-            // Get full state to extract key info
-            Napi::Object fullState = m_stages[i]->serializeState(env);
+            const StageDescription &description = descriptions[i];
 
-            // Extract common fields (windowSize, numChannels, mode)
-            if (fullState.Has("windowSize"))
+            if (description.windowSize)
             {
-                stageSummary.Set("windowSize", fullState.Get("windowSize"));
+                stageSummary.Set("windowSize", static_cast<uint32_t>(*description.windowSize));
             }
 
-            if (fullState.Has("numChannels"))
+            if (description.windowDurationMs)
             {
-                stageSummary.Set("numChannels", fullState.Get("numChannels"));
+                stageSummary.Set("windowDuration", *description.windowDurationMs);
             }
 
-            if (fullState.Has("mode"))
+            if (!description.mode.empty())
             {
-                stageSummary.Set("mode", fullState.Get("mode"));
+                stageSummary.Set("mode", description.mode);
             }
 
             // Add buffer occupancy info for stateful filters
-            if (fullState.Has("channels"))
+            if (description.numChannels)
             {
-                Napi::Array channels = fullState.Get("channels").As<Napi::Array>();
-                if (channels.Length() > 0)
-                {
-                    Napi::Object firstChannel = channels.Get(uint32_t(0)).As<Napi::Object>();
-                    if (firstChannel.Has("buffer"))
-                    {
-                        Napi::Array buffer = firstChannel.Get("buffer").As<Napi::Array>();
-                        stageSummary.Set("bufferSize", buffer.Length());
-                    }
-                }
-                stageSummary.Set("channelCount", channels.Length());
+                uint32_t numChannels = static_cast<uint32_t>(*description.numChannels);
+                stageSummary.Set("numChannels", numChannels);
+                stageSummary.Set("channelCount", numChannels);
+            }
+
+            if (description.bufferSize)
+            {
+                stageSummary.Set("bufferSize", static_cast<uint32_t>(*description.bufferSize));
             }
 
             stagesArray.Set(static_cast<uint32_t>(i), stageSummary);
@@ -645,9 +1780,142 @@ namespace dsp
 
         summary.Set("stages", stagesArray);
 
+        Napi::Object arena = Napi::Object::New(env);
+        arena.Set("usedBytes", static_cast<double>(m_arena.used()));
+        arena.Set("capacityBytes", static_cast<double>(m_arena.capacity()));
+        arena.Set("blocks", static_cast<uint32_t>(m_arena.blockCount()));
+        summary.Set("arena", arena);
+
         return summary;
     }
 
+    /**
+     * Snapshot of the timing counters as a Float64Array (layout in
+     * PipelineMetrics.h). Lock-free, so polling never waits for a chunk.
+     */
+    Napi::Value DspPipeline::GetMetrics(const Napi::CallbackInfo &info)
+    {
+        Napi::Env env = info.Env();
+        Napi::Float64Array snapshot = Napi::Float64Array::New(env, m_metrics.snapshotSize());
+        m_metrics.snapshot(snapshot.Data());
+        return snapshot;
+    }
+
+    /**
+     * Zero every timing counter
+     */
+    Napi::Value DspPipeline::ResetMetrics(const Napi::CallbackInfo &info)
+    {
+        m_metrics.reset();
+        return info.Env().Undefined();
+    }
+
+    /**
+     * Real-time mode: allocates up front everything the stages would
+     * otherwise allocate on their first chunk or on a channel-count change.
+     * TS calls: native.prepare(maxBlockSize, channels, sampleRate)
+     *
+     * maxBlockSize is in samples per channel. Each stage is prepared for the
+     * stream it will actually see (resizing stages change the shape for the
+     * stages after them), and the largest resizing-stage output is kept so
+     * every process() job reserves its buffers before it is queued. After
+     * this, chunks with that channel count and at most maxBlockSize samples
+     * per channel do not allocate in the stage loop; getAllocations()
+     * reports whether that held.
+     */
+    Napi::Value DspPipeline::Prepare(const Napi::CallbackInfo &info)
+    {
+        Napi::Env env = info.Env();
+
+        const double maxBlockSize = info.Length() >= 1 && info[0].IsNumber() ? info[0].As<Napi::Number>().DoubleValue() : 0.0;
+        const double channels = info.Length() >= 2 && info[1].IsNumber() ? info[1].As<Napi::Number>().DoubleValue() : 0.0;
+        const double sampleRate = info.Length() >= 3 && info[2].IsNumber() ? info[2].As<Napi::Number>().DoubleValue() : 0.0;
+        if (!(maxBlockSize >= 1.0) || maxBlockSize != std::floor(maxBlockSize) || !(channels >= 1.0) || channels != std::floor(channels))
+        {
+            Napi::TypeError::New(env, "prepare: maxBlockSize and channels must be positive integers").ThrowAsJavaScriptException();
+            return env.Undefined();
+        }
+        if (!(sampleRate >= 0.0))
+        {
+            Napi::TypeError::New(env, "prepare: sampleRate must be a non-negative number").ThrowAsJavaScriptException();
+            return env.Undefined();
+        }
+
+        try
+        {
+            std::lock_guard<std::mutex> lock(m_stateMutex);
+
+            size_t frames = static_cast<size_t>(maxBlockSize);
+            int numChannels = static_cast<int>(channels);
+            double rate = sampleRate;
+            size_t outputCapacity = 0;
+            for (size_t i = 0; i < m_stages.size(); ++i)
+            {
+                // Windows sized here would otherwise be sized by the first
+                // chunk, so they come from the arena on the same terms
+                dsp::utils::ArenaScope scope(i >= m_preparedStages ? &m_arena : nullptr);
+                m_stages[i]->prepare(frames, numChannels, rate);
+
+                if (m_stages[i]->isResizing())
+                {
+                    const size_t samples = m_stages[i]->maxOutputSize(frames * numChannels, numChannels);
+                    const int outputChannels = m_stages[i]->outputChannels(numChannels);
+                    const size_t outputFrames = outputChannels > 0 ? samples / outputChannels : 0;
+                    // Later stages see the output frame rate (e.g. one frame per hop)
+                    rate = frames > 0 ? rate * static_cast<double>(outputFrames) / static_cast<double>(frames) : 0.0;
+                    outputCapacity = std::max(outputCapacity, samples);
+                    frames = outputFrames;
+                    numChannels = outputChannels;
+                }
+            }
+            m_preparedStages = m_stages.size();
+
+            m_realtime = RealtimeStats();
+            m_realtime.prepared = true;
+            m_realtime.maxBlockSize = static_cast<size_t>(maxBlockSize);
+            m_realtime.channels = static_cast<int>(channels);
+            m_realtime.sampleRate = sampleRate;
+            m_realtime.outputCapacity = outputCapacity;
+        }
+        catch (const std::invalid_argument &e)
+        {
+            Napi::TypeError::New(env, e.what()).ThrowAsJavaScriptException();
+        }
+        catch (const std::exception &e)
+        {
+            Napi::Error::New(env, e.what()).ThrowAsJavaScriptException();
+        }
+
+        return env.Undefined();
+    }
+
+    /**
+     * Heap allocations counted inside the stage loop since prepare()
+     * (or since the pipeline was built). The counts are only real in
+     * builds with DSPX_TRACK_ALLOCATIONS; "tracked" says which this is.
+     */
+    Napi::Value DspPipeline::GetAllocations(const Napi::CallbackInfo &info)
+    {
+        Napi::Env env = info.Env();
+        Napi::Object result = Napi::Object::New(env);
+
+        std::lock_guard<std::mutex> lock(m_stateMutex);
+        result.Set("tracked", dsp::utils::AllocationScope::enabled());
+        result.Set("prepared", m_realtime.prepared);
+        result.Set("calls", static_cast<double>(m_realtime.calls));
+        result.Set("allocatingCalls", static_cast<double>(m_realtime.allocatingCalls));
+        result.Set("allocations", static_cast<double>(m_realtime.allocations));
+        result.Set("bytes", static_cast<double>(m_realtime.allocatedBytes));
+        result.Set("lastCallAllocations", static_cast<double>(m_realtime.lastCallAllocations));
+        if (m_realtime.prepared)
+        {
+            result.Set("maxBlockSize", static_cast<double>(m_realtime.maxBlockSize));
+            result.Set("channels", m_realtime.channels);
+            result.Set("sampleRate", m_realtime.sampleRate);
+        }
+        return result;
+    }
+
 } // namespace dsp
 
 // Forward declare FFT bindings init
@@ -668,6 +1936,9 @@ Napi::Object InitAll(Napi::Env env, Napi::Object exports)
     // Initialize FIR/IIR filter bindings
     dsp::InitFilterBindings(env, exports);
 
+    // Initialize SIMD dispatch diagnostics
+    dsp::InitSimdBindings(env, exports);
+
     return exports;
 }
 
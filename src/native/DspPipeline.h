@@ -4,10 +4,72 @@
 #include <memory>
 #include <unordered_map>
 #include <functional>
+#include <cstdint>
+#include <mutex>
+#include <atomic>
+#include <string>
 #include "IDspStage.h"
+#include "utils/PipelineMetrics.h"
+#include "utils/Arena.h"
 
 namespace dsp
 {
+    /**
+     * @brief What DspPipeline::prepare() was given, and the heap allocations
+     * counted inside the stage loop of every process() call since.
+     */
+    struct RealtimeStats
+    {
+        bool prepared = false;     // Cleared again when a stage is added
+        size_t maxBlockSize = 0;   // Samples per channel
+        int channels = 0;
+        double sampleRate = 0.0;
+        size_t outputCapacity = 0; // Samples each resizing-stage buffer is reserved for
+        uint64_t calls = 0;
+        uint64_t allocatingCalls = 0;
+        uint64_t allocations = 0;
+        uint64_t allocatedBytes = 0;
+        uint64_t lastCallAllocations = 0;
+    };
+
+    /**
+     * @brief Every stage's snapshot section, copied out while the state lock
+     * is held. Turning it into snapshot bytes (float codec, header,
+     * checksum) needs no stage, so it runs after the lock is released.
+     */
+    struct SnapshotCapture
+    {
+        struct Stage
+        {
+            std::string type;
+            uint8_t encoding = 0;
+            size_t end = 0; // End of the stage's section in sections
+        };
+
+        uint16_t flags = 0;
+        double timestamp = 0.0;
+        uint64_t generation = 0;
+        uint64_t baseGeneration = 0;
+        dsp::utils::FloatCodec codec = dsp::utils::FloatCodec::None;
+        std::vector<Stage> stages;
+        dsp::utils::BinaryWriter sections; // Every stage's section, back to back, float arrays raw
+        std::vector<size_t> floatArrays;   // Where each float array starts in sections
+    };
+
+    /**
+     * @brief Every stage's describe() counters as of the end of the last
+     * processed chunk, so listState() can answer while a chunk is running.
+     */
+    struct StageSummaries
+    {
+        std::mutex mutex;
+        std::vector<const char *> types;
+        std::vector<StageDescription> stages;
+
+        // Caller holds the pipeline's state lock
+        void capture(const std::vector<std::unique_ptr<IDspStage>> &pipeline);
+    };
+
     class DspPipeline : public Napi::ObjectWrap<DspPipeline>
     {
     public:
@@ -28,17 +90,91 @@ namespace dsp
         Napi::Value ClearState(const Napi::CallbackInfo &info);
         Napi::Value ListState(const Napi::CallbackInfo &info);
 
+        // Binary snapshot variants of SaveState/LoadState (see DspPipeline.cc for the layout)
+        Napi::Value SaveStateBinary(const Napi::CallbackInfo &info);
+        Napi::Value LoadStateBinary(const Napi::CallbackInfo &info);
+
+        // Captures state between chunks and encodes it on a worker thread
+        Napi::Value Checkpoint(const Napi::CallbackInfo &info);
+
+        // Per-stage timings and process() job latencies (see utils/PipelineMetrics.h)
+        Napi::Value GetMetrics(const Napi::CallbackInfo &info);
+        Napi::Value ResetMetrics(const Napi::CallbackInfo &info);
+
+        // Real-time mode: preallocate every stage, then report the heap
+        // allocations made while processing (see utils/AllocationTracker.h)
+        Napi::Value Prepare(const Napi::CallbackInfo &info);
+        Napi::Value GetAllocations(const Napi::CallbackInfo &info);
+
+        // Copies every stage section into capture; EncodeSnapshot() in
+        // DspPipeline.cc turns it into the snapshot bytes. env serves stages
+        // without a binary hook; pass nullptr off the main thread, in which
+        // case such stages make this throw. With chain (checkpoints), the
+        // snapshot gets the next generation and becomes the base of the
+        // next delta, which maxDeltas > 0 allows; without it (plain saves)
+        // the delta chain is left alone. Caller holds m_stateMutex.
+        void CaptureSnapshot(SnapshotCapture &capture, const Napi::Env *env, bool chain, uint32_t maxDeltas);
+
+        // Every stage's windowMarks(), in pipeline order
+        std::vector<std::vector<dsp::utils::WindowMark>> CollectWindowMarks() const;
+
+        // Validates a snapshot and restores every stage from it (throws on mismatch)
+        void DecodeSnapshot(Napi::Env env, const uint8_t *data, size_t size);
+
         // Initialize the stage factory map
         void InitializeStageFactories();
 
+        // Returns the cached implicit clock (i * periodMs) for calls made
+        // without timestamps, rebuilding it only when the shape changes
+        std::shared_ptr<const std::vector<float>> GetImplicitTimestamps(size_t numSamples, double periodMs);
+
         // Type alias for stage factory functions
         using StageFactory = std::function<std::unique_ptr<IDspStage>(const Napi::Object &)>;
 
         // Map of stage names to factory functions
         std::unordered_map<std::string, StageFactory> m_stageFactories;
 
+        // 64-byte aligned storage for the stages' windows, carved when a stage
+        // is built and on its first chunk. Declared before m_stages so it is
+        // released after them, in one go.
+        dsp::utils::Arena m_arena;
+
         // This is the "pipeline": a vector of our abstract filter stages
         std::vector<std::unique_ptr<IDspStage>> m_stages;
+
+        // Stages [0, m_preparedStages) have processed a chunk or been prepared (guarded by m_stateMutex)
+        size_t m_preparedStages = 0;
+
+        // Implicit timestamps shared with in-flight workers (never mutated once built)
+        std::shared_ptr<const std::vector<float>> m_implicitTimestamps;
+        double m_implicitPeriodMs = 0.0;
+
+        // Held by workers while they touch stage state, so a checkpoint
+        // capture always lands between two processed chunks
+        std::mutex m_stateMutex;
+
+        // Size of the previous checkpoint, used to pre-size the next capture
+        std::atomic<size_t> m_lastCheckpointSize{0};
+
+        // Delta snapshot chain (guarded by m_stateMutex): the generation of the
+        // last snapshot written or loaded, and the window marks at that point
+        uint64_t m_generation = 0;
+        std::vector<std::vector<dsp::utils::WindowMark>> m_generationMarks;
+        uint32_t m_deltasSinceBase = 0;
+        size_t m_lastBaseSize = 0;
+        bool m_forceFullSnapshot = false;
+
+        // Encoding of float arrays in binary snapshots (config.snapshotCodec)
+        dsp::utils::FloatCodec m_floatCodec = dsp::utils::FloatCodec::None;
+
+        // Timing counters, one StageMetrics per entry of m_stages
+        dsp::utils::PipelineMetrics m_metrics;
+
+        // Real-time mode settings and allocation counters (guarded by m_stateMutex)
+        RealtimeStats m_realtime;
+
+        // Stage counters published by every worker for listState()
+        StageSummaries m_summaries;
     };
 
 } // namespace dsp
\ No newline at end of file
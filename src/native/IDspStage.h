@@ -1,8 +1,26 @@
 #pragma once
 #include <napi.h>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "utils/BinaryState.h"
 
 namespace dsp
 {
+    /**
+     * @brief Configuration and buffer occupancy of a stage, as reported by
+     * IDspStage::describe(). Fields that do not apply to a stage stay unset.
+     */
+    struct StageDescription
+    {
+        std::string mode;                       // e.g. "moving", "half"; empty if the stage has no mode
+        std::optional<size_t> windowSize;       // Window length in samples
+        std::optional<double> windowDurationMs; // Window length in milliseconds (time-based windows)
+        std::optional<size_t> numChannels;      // Channels the stage currently keeps state for
+        std::optional<size_t> bufferSize;       // Samples buffered in the first channel's window
+    };
+
     // This abstract class is the key.
     // Every filter you add will implement this.
     class IDspStage
@@ -29,6 +47,82 @@ namespace dsp
          */
         virtual void process(float *buffer, size_t numSamples, int numChannels, const float *timestamps = nullptr) = 0;
 
+        /**
+         * @brief Allocates everything process() would otherwise allocate lazily.
+         *
+         * Called by DspPipeline::prepare() before a real-time stream starts.
+         * A stage creates its per-channel state for numChannels, sizes
+         * duration-based windows from sampleRate and reserves its scratch,
+         * so that process() calls with the same channel count and at most
+         * maxBlockSize samples per channel do not allocate. Stages without
+         * lazy state keep the default, which does nothing.
+         *
+         * @param maxBlockSize Largest chunk, in samples per channel.
+         * @param numChannels The channel count the stream will use.
+         * @param sampleRate The stream's sample rate in Hz (0 if unknown).
+         */
+        virtual void prepare(size_t maxBlockSize, int numChannels, double sampleRate)
+        {
+            (void)maxBlockSize;
+            (void)numChannels;
+            (void)sampleRate;
+        }
+
+        /**
+         * @brief Whether the stage changes the length or channel count of the stream.
+         *
+         * Resizing stages (e.g. feature extractors that emit one frame per
+         * hop) are run through processResizing() instead of process(), and
+         * the pipeline hands their output to the next stage.
+         */
+        virtual bool isResizing() const
+        {
+            return false;
+        }
+
+        /**
+         * @brief Upper bound on the samples processResizing() writes for an input chunk.
+         */
+        virtual size_t maxOutputSize(size_t numSamples, int numChannels) const
+        {
+            (void)numChannels;
+            return numSamples;
+        }
+
+        /**
+         * @brief Channel count of processResizing()'s output for a given
+         * input channel count (lets the pipeline plan buffers ahead).
+         */
+        virtual int outputChannels(int numChannels) const
+        {
+            return numChannels;
+        }
+
+        /**
+         * @brief Processes a chunk into a separate output buffer (resizing stages only).
+         *
+         * @param input The interleaved input samples.
+         * @param numSamples The total number of input samples.
+         * @param numChannels The number of input channels.
+         * @param timestamps Per-sample input timestamps (may be nullptr).
+         * @param output Room for maxOutputSize(numSamples, numChannels) samples.
+         * @param outputTimestamps Same size as output; receives per-sample output timestamps.
+         * @param outputChannels Set to the number of interleaved output channels.
+         * @return size_t The number of samples written to output.
+         */
+        virtual size_t processResizing(const float *input, size_t numSamples, int numChannels, const float *timestamps,
+                                       float *output, float *outputTimestamps, int &outputChannels)
+        {
+            (void)input;
+            (void)numSamples;
+            (void)numChannels;
+            (void)timestamps;
+            (void)output;
+            (void)outputTimestamps;
+            (void)outputChannels;
+            throw std::runtime_error(std::string(getType()) + " is not a resizing stage");
+        }
+
         /**
          * @brief Serializes the stage's internal state to a Napi::Object.
          *
@@ -44,6 +138,90 @@ namespace dsp
          */
         virtual void deserializeState(const Napi::Object &state) = 0;
 
+        /**
+         * @brief Writes the stage's internal state into a binary snapshot section.
+         *
+         * Stages with large buffers override this to write raw arrays instead
+         * of building a Napi::Object tree. The default returns false, and the
+         * pipeline then stores the serializeState() tree in binary form instead.
+         *
+         * @param writer The snapshot writer, positioned at this stage's section.
+         * @return true if the stage wrote its own section.
+         */
+        virtual bool serializeBinary(dsp::utils::BinaryWriter &writer) const
+        {
+            (void)writer;
+            return false;
+        }
+
+        /**
+         * @brief Restores state written by serializeBinary().
+         *
+         * @param reader A reader over exactly this stage's section.
+         */
+        virtual void deserializeBinary(dsp::utils::BinaryReader &reader)
+        {
+            (void)reader;
+            throw std::runtime_error(std::string(getType()) + " does not support binary state");
+        }
+
+        /**
+         * @brief Returns one WindowMark per sliding window (usually per channel).
+         *
+         * The pipeline records these at every checkpoint and hands them back
+         * to serializeBinaryDelta() at the next one. Stages without windows
+         * return an empty vector.
+         */
+        virtual std::vector<dsp::utils::WindowMark> windowMarks() const
+        {
+            return {};
+        }
+
+        /**
+         * @brief Writes only what changed since the marks of an earlier checkpoint.
+         *
+         * A delta section holds, per window, the samples pushed since then
+         * plus the scalar state (running sums etc.). It must write nothing
+         * and return false when a delta cannot be expressed (channel count
+         * changed, window cleared or restored), in which case the pipeline
+         * falls back to a full section for this stage.
+         *
+         * @param writer The snapshot writer, positioned at this stage's section.
+         * @param since The windowMarks() recorded at the base checkpoint.
+         * @return true if the stage wrote a delta section.
+         */
+        virtual bool serializeBinaryDelta(dsp::utils::BinaryWriter &writer,
+                                          const std::vector<dsp::utils::WindowMark> &since) const
+        {
+            (void)writer;
+            (void)since;
+            return false;
+        }
+
+        /**
+         * @brief Applies a section written by serializeBinaryDelta() on top of
+         * the state of the checkpoint it was taken against.
+         *
+         * @param reader A reader over exactly this stage's section.
+         */
+        virtual void deserializeBinaryDelta(dsp::utils::BinaryReader &reader)
+        {
+            (void)reader;
+            throw std::runtime_error(std::string(getType()) + " does not support delta state");
+        }
+
+        /**
+         * @brief Describes the stage's configuration and buffer occupancy.
+         *
+         * Unlike serializeState(), this reads counters only and never copies
+         * buffered samples, so it is cheap enough for frequent health polls.
+         * The default reports nothing beyond the stage type.
+         */
+        virtual StageDescription describe() const
+        {
+            return {};
+        }
+
         /**
          * @brief Resets the stage's internal state to initial values.
          */
@@ -0,0 +1,93 @@
+/**
+ * N-API Bindings for SIMD kernel dispatch (diagnostics and testing)
+ */
+
+#include <napi.h>
+#include "utils/CpuFeatures.h"
+#include "utils/SimdOps.h"
+
+namespace dsp
+{
+    namespace
+    {
+        constexpr simd::SimdLevel kLevels[] = {
+            simd::SimdLevel::Scalar,
+            simd::SimdLevel::Sse2,
+            simd::SimdLevel::Avx2,
+            simd::SimdLevel::Avx512,
+            simd::SimdLevel::Neon,
+        };
+
+        /**
+         * getSimdInfo() -> { level, best, supported, features }
+         */
+        Napi::Value GetSimdInfo(const Napi::CallbackInfo &info)
+        {
+            Napi::Env env = info.Env();
+            Napi::Object result = Napi::Object::New(env);
+
+            result.Set("level", simd::levelName(simd::activeLevel()));
+            result.Set("best", simd::levelName(simd::bestLevel()));
+
+            Napi::Array supported = Napi::Array::New(env);
+            for (simd::SimdLevel level : kLevels)
+            {
+                if (simd::isSupported(level))
+                {
+                    supported.Set(supported.Length(), simd::levelName(level));
+                }
+            }
+            result.Set("supported", supported);
+
+            const utils::CpuFeatures &cpu = utils::cpuFeatures();
+            Napi::Object features = Napi::Object::New(env);
+            features.Set("sse2", cpu.sse2);
+            features.Set("sse3", cpu.sse3);
+            features.Set("avx", cpu.avx);
+            features.Set("avx2", cpu.avx2);
+            features.Set("fma", cpu.fma);
+            features.Set("avx512f", cpu.avx512f);
+            features.Set("neon", cpu.neon);
+            result.Set("features", features);
+
+            return result;
+        }
+
+        /**
+         * setSimdLevel(level: string) -> previous level
+         */
+        Napi::Value SetSimdLevel(const Napi::CallbackInfo &info)
+        {
+            Napi::Env env = info.Env();
+            if (info.Length() < 1 || !info[0].IsString())
+            {
+                Napi::TypeError::New(env, "Expected SIMD level name").ThrowAsJavaScriptException();
+                return env.Null();
+            }
+
+            const std::string name = info[0].As<Napi::String>().Utf8Value();
+            simd::SimdLevel level;
+            if (!simd::parseLevel(name.c_str(), level))
+            {
+                Napi::TypeError::New(env, "Unknown SIMD level: " + name).ThrowAsJavaScriptException();
+                return env.Null();
+            }
+
+            const simd::SimdLevel previous = simd::activeLevel();
+            if (!simd::setLevel(level))
+            {
+                Napi::Error::New(env, "SIMD level not supported on this CPU: " + name).ThrowAsJavaScriptException();
+                return env.Null();
+            }
+            return Napi::String::New(env, simd::levelName(previous));
+        }
+    }
+
+    // Module initialization
+    void InitSimdBindings(Napi::Env env, Napi::Object exports)
+    {
+        exports.Set("getSimdInfo", Napi::Function::New(env, GetSimdInfo));
+        exports.Set("setSimdLevel", Napi::Function::New(env, SetSimdLevel));
+    }
+
+} // namespace dsp
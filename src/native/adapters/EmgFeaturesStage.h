@@ -0,0 +1,286 @@
+#pragma once
+
+#include "../IDspStage.h"
+#include "../core/EmgFeatureExtractor.h"
+#include "../utils/NapiUtils.h"
+#include <memory>
+#include <vector>
+#include <string>
+#include <stdexcept>
+
+namespace dsp::adapters
+{
+    /**
+     * @brief Fused EMG time-domain features, one feature frame per hop.
+     *
+     * Replaces a chain of per-sample MAV / RMS / WL / SSC / WAMP stages with
+     * one shared window per channel. The output stream has
+     * numChannels * features.size() channels ([channel][feature] per frame)
+     * and one frame every hopSize input frames, so this is a resizing stage.
+     */
+    class EmgFeaturesStage : public IDspStage
+    {
+    public:
+        EmgFeaturesStage(size_t window_size, size_t hop_size, std::vector<dsp::core::EmgFeature> features,
+                         float ssc_threshold, float wamp_threshold, float zc_threshold)
+            : m_window_size(window_size),
+              m_hop_size(hop_size),
+              m_features(std::move(features)),
+              m_ssc_threshold(ssc_threshold),
+              m_wamp_threshold(wamp_threshold),
+              m_zc_threshold(zc_threshold)
+        {
+            if (window_size == 0)
+            {
+                throw std::invalid_argument("EmgFeatures: window size must be greater than 0");
+            }
+            if (hop_size == 0)
+            {
+                throw std::invalid_argument("EmgFeatures: hop size must be greater than 0");
+            }
+            if (m_features.empty())
+            {
+                throw std::invalid_argument("EmgFeatures: at least one feature is required");
+            }
+        }
+
+        const char *getType() const override { return "emgFeatures"; }
+
+        void process(float *buffer, size_t numSamples, int numChannels, const float *timestamps = nullptr) override
+        {
+            (void)buffer;
+            (void)numSamples;
+            (void)numChannels;
+            (void)timestamps;
+            throw std::runtime_error("EmgFeatures changes the stream size and must be run through processResizing()");
+        }
+
+        bool isResizing() const override { return true; }
+
+        size_t maxOutputSize(size_t numSamples, int numChannels) const override
+        {
+            if (numChannels <= 0)
+            {
+                return 0;
+            }
+            // At most one frame per hop whatever the extractor's phase, so
+            // a prepared pipeline can size its output buffers once
+            const size_t channels = static_cast<size_t>(numChannels);
+            const size_t numFrames = numSamples / channels;
+            const size_t frames = numFrames == 0 ? 0 : 1 + (numFrames - 1) / m_hop_size;
+            return frames * channels * m_features.size();
+        }
+
+        int outputChannels(int numChannels) const override
+        {
+            return numChannels * static_cast<int>(m_features.size());
+        }
+
+        // Build the extractor ahead of the first chunk
+        void prepare(size_t /*maxBlockSize*/, int numChannels, double /*sampleRate*/) override
+        {
+            if (numChannels <= 0)
+            {
+                return;
+            }
+            const size_t channels = static_cast<size_t>(numChannels);
+            if (!m_extractor || m_extractor->getNumChannels() != channels)
+            {
+                createExtractor(channels);
+            }
+        }
+
+        size_t processResizing(const float *input, size_t numSamples, int numChannels, const float *timestamps,
+                               float *output, float *outputTimestamps, int &outputChannels) override
+        {
+            if (numChannels <= 0 || numSamples % static_cast<size_t>(numChannels) != 0)
+            {
+                throw std::invalid_argument("EmgFeatures: sample count must be a multiple of the channel count");
+            }
+            const size_t channels = static_cast<size_t>(numChannels);
+            if (!m_extractor || m_extractor->getNumChannels() != channels)
+            {
+                createExtractor(channels);
+            }
+
+            outputChannels = static_cast<int>(channels * m_features.size());
+            const size_t frames = m_extractor->process(input, numSamples / channels, timestamps,
+                                                       output, outputTimestamps);
+            return frames * channels * m_features.size();
+        }
+
+        StageDescription describe() const override
+        {
+            StageDescription description;
+            description.windowSize = m_window_size;
+            description.numChannels = m_extractor ? m_extractor->getNumChannels() : 0;
+            if (m_extractor)
+            {
+                description.bufferSize = std::min(m_extractor->getCount(), m_window_size);
+            }
+            return description;
+        }
+
+        void reset() override
+        {
+            if (m_extractor)
+            {
+                m_extractor->clear();
+            }
+        }
+
+        Napi::Object serializeState(Napi::Env env) const override
+        {
+            Napi::Object state = Napi::Object::New(env);
+            state.Set("windowSize", static_cast<uint32_t>(m_window_size));
+            state.Set("hopSize", static_cast<uint32_t>(m_hop_size));
+            state.Set("features", featureNames(env));
+            state.Set("sscThreshold", Napi::Number::New(env, m_ssc_threshold));
+            state.Set("wampThreshold", Napi::Number::New(env, m_wamp_threshold));
+            state.Set("zcThreshold", Napi::Number::New(env, m_zc_threshold));
+
+            const size_t numChannels = m_extractor ? m_extractor->getNumChannels() : 0;
+            state.Set("numChannels", static_cast<uint32_t>(numChannels));
+            state.Set("framesUntilOutput",
+                      static_cast<uint32_t>(m_extractor ? m_extractor->getFramesUntilOutput() : m_window_size));
+
+            Napi::Array channelsArray = Napi::Array::New(env, numChannels);
+            for (size_t i = 0; i < numChannels; ++i)
+            {
+                Napi::Object channelState = Napi::Object::New(env);
+                channelState.Set("history", dsp::utils::VectorToNapiArray(env, m_extractor->getChannelHistory(i)));
+                channelsArray.Set(static_cast<uint32_t>(i), channelState);
+            }
+            state.Set("channels", channelsArray);
+            return state;
+        }
+
+        void deserializeState(const Napi::Object &state) override
+        {
+            size_t windowSize = state.Get("windowSize").As<Napi::Number>().Uint32Value();
+            size_t hopSize = state.Get("hopSize").As<Napi::Number>().Uint32Value();
+            Napi::Array features = state.Get("features").As<Napi::Array>();
+            std::vector<std::string> names;
+            for (uint32_t i = 0; i < features.Length(); ++i)
+            {
+                names.push_back(features.Get(i).As<Napi::String>().Utf8Value());
+            }
+            float sscThreshold = state.Get("sscThreshold").As<Napi::Number>().FloatValue();
+            float wampThreshold = state.Get("wampThreshold").As<Napi::Number>().FloatValue();
+            float zcThreshold = state.Get("zcThreshold").As<Napi::Number>().FloatValue();
+            checkParameters(windowSize, hopSize, names, sscThreshold, wampThreshold, zcThreshold);
+
+            Napi::Array channelsArray = state.Get("channels").As<Napi::Array>();
+            std::vector<std::vector<float>> histories;
+            for (uint32_t i = 0; i < channelsArray.Length(); ++i)
+            {
+                Napi::Object channelState = channelsArray.Get(i).As<Napi::Object>();
+                histories.push_back(dsp::utils::NapiArrayToVector<float>(channelState.Get("history").As<Napi::Array>()));
+            }
+            size_t framesUntilOutput = state.Get("framesUntilOutput").As<Napi::Number>().Uint32Value();
+            restore(histories, framesUntilOutput);
+        }
+
+        bool serializeBinary(dsp::utils::BinaryWriter &writer) const override
+        {
+            writer.writeU32(static_cast<uint32_t>(m_window_size));
+            writer.writeU32(static_cast<uint32_t>(m_hop_size));
+            writer.writeU32(static_cast<uint32_t>(m_features.size()));
+            for (auto feature : m_features)
+            {
+                writer.writeString(dsp::core::emgFeatureName(feature));
+            }
+            writer.writeF32(m_ssc_threshold);
+            writer.writeF32(m_wamp_threshold);
+            writer.writeF32(m_zc_threshold);
+
+            const size_t numChannels = m_extractor ? m_extractor->getNumChannels() : 0;
+            writer.writeU32(static_cast<uint32_t>(numChannels));
+            writer.writeU32(static_cast<uint32_t>(m_extractor ? m_extractor->getFramesUntilOutput() : m_window_size));
+            for (size_t i = 0; i < numChannels; ++i)
+            {
+                writer.writeArray(m_extractor->getChannelHistory(i));
+            }
+            return true;
+        }
+
+        void deserializeBinary(dsp::utils::BinaryReader &reader) override
+        {
+            size_t windowSize = reader.readU32();
+            size_t hopSize = reader.readU32();
+            uint32_t numFeatures = reader.readU32();
+            std::vector<std::string> names;
+            for (uint32_t i = 0; i < numFeatures; ++i)
+            {
+                names.push_back(reader.readString());
+            }
+            float sscThreshold = reader.readF32();
+            float wampThreshold = reader.readF32();
+            float zcThreshold = reader.readF32();
+            checkParameters(windowSize, hopSize, names, sscThreshold, wampThreshold, zcThreshold);
+
+            uint32_t numChannels = reader.readU32();
+            size_t framesUntilOutput = reader.readU32();
+            std::vector<std::vector<float>> histories;
+            for (uint32_t i = 0; i < numChannels; ++i)
+            {
+                histories.push_back(reader.readArray<float>());
+            }
+            restore(histories, framesUntilOutput);
+        }
+
+    private:
+        void createExtractor(size_t numChannels)
+        {
+            m_extractor = std::make_unique<dsp::core::EmgFeatureExtractor>(
+                m_window_size, m_hop_size, numChannels, m_features,
+                m_ssc_threshold, m_wamp_threshold, m_zc_threshold);
+        }
+
+        Napi::Array featureNames(Napi::Env env) const
+        {
+            Napi::Array names = Napi::Array::New(env, m_features.size());
+            for (size_t i = 0; i < m_features.size(); ++i)
+            {
+                names.Set(static_cast<uint32_t>(i), Napi::String::New(env, dsp::core::emgFeatureName(m_features[i])));
+            }
+            return names;
+        }
+
+        void checkParameters(size_t windowSize, size_t hopSize, const std::vector<std::string> &names,
+                             float sscThreshold, float wampThreshold, float zcThreshold) const
+        {
+            bool match = windowSize == m_window_size && hopSize == m_hop_size && names.size() == m_features.size() &&
+                         sscThreshold == m_ssc_threshold && wampThreshold == m_wamp_threshold &&
+                         zcThreshold == m_zc_threshold;
+            for (size_t i = 0; match && i < names.size(); ++i)
+            {
+                match = names[i] == dsp::core::emgFeatureName(m_features[i]);
+            }
+            if (!match)
+            {
+                throw std::runtime_error("EmgFeatures parameter mismatch during deserialization");
+            }
+        }
+
+        void restore(const std::vector<std::vector<float>> &histories, size_t framesUntilOutput)
+        {
+            if (histories.empty())
+            {
+                m_extractor.reset();
+                return;
+            }
+            createExtractor(histories.size());
+            m_extractor->setState(histories, framesUntilOutput);
+        }
+
+        size_t m_window_size;
+        size_t m_hop_size;
+        std::vector<dsp::core::EmgFeature> m_features;
+        float m_ssc_threshold;
+        float m_wamp_threshold;
+        float m_zc_threshold;
+        std::unique_ptr<dsp::core::EmgFeatureExtractor> m_extractor; // Created for the first chunk's channel count
+    };
+
+} // namespace dsp::adapters
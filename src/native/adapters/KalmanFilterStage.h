@@ -0,0 +1,186 @@
+#pragma once
+
+#include "../IDspStage.h"
+#include "../core/KalmanFilter.h"
+#include "../utils/NapiUtils.h"
+#include <memory>
+#include <string>
+#include <stdexcept>
+#include <vector>
+
+namespace dsp::adapters
+{
+    /**
+     * @brief One Kalman filter per channel over a shared model (see core::KalmanFilter).
+     *
+     * Each sample is replaced by its channel's filtered estimate. The bank
+     * is created for the channel count of the first chunk (or of
+     * prepare()) and rebuilt if it changes. The state carries every
+     * channel's state vector and covariance, so a restored pipeline
+     * continues exactly where the original left off.
+     */
+    class KalmanFilterStage : public IDspStage
+    {
+    public:
+        explicit KalmanFilterStage(const dsp::core::KalmanOptions &options) : m_options(options)
+        {
+            // Validates the model (and, with steadyState, that it has a steady state) up front
+            dsp::core::KalmanFilter(1, options);
+        }
+
+        const char *getType() const override { return "kalmanFilter"; }
+
+        void process(float *buffer, size_t numSamples, int numChannels, const float *timestamps = nullptr) override
+        {
+            (void)timestamps;
+            if (numChannels <= 0 || numSamples % static_cast<size_t>(numChannels) != 0)
+            {
+                throw std::invalid_argument("KalmanFilter: sample count must be a multiple of the channel count");
+            }
+            ensureChannels(numChannels);
+            m_filter->process(buffer, numSamples / static_cast<size_t>(numChannels));
+        }
+
+        void prepare(size_t /*maxBlockSize*/, int numChannels, double /*sampleRate*/) override
+        {
+            ensureChannels(numChannels);
+        }
+
+        StageDescription describe() const override
+        {
+            StageDescription description;
+            description.mode = dsp::core::kalmanModelName(m_options.model);
+            description.numChannels = m_filter ? m_filter->getChannels() : 0;
+            return description;
+        }
+
+        void reset() override
+        {
+            if (m_filter)
+            {
+                m_filter->reset();
+            }
+        }
+
+        Napi::Object serializeState(Napi::Env env) const override
+        {
+            Napi::Object state = Napi::Object::New(env);
+            state.Set("model", dsp::core::kalmanModelName(m_options.model));
+            state.Set("processNoise", m_options.processNoise);
+            state.Set("measurementNoise", m_options.measurementNoise);
+            state.Set("dt", m_options.dt);
+            state.Set("initialCovariance", m_options.initialCovariance);
+            state.Set("steadyState", m_options.steadyState);
+            state.Set("transition", dsp::utils::VectorToNapiArray(env, m_options.transition));
+            state.Set("observation", dsp::utils::VectorToNapiArray(env, m_options.observation));
+            state.Set("processCovariance", dsp::utils::VectorToNapiArray(env, m_options.processCovariance));
+
+            state.Set("numChannels", static_cast<uint32_t>(m_filter ? m_filter->getChannels() : 0));
+            state.Set("initialized", m_filter ? m_filter->isInitialized() : false);
+            state.Set("state", dsp::utils::VectorToNapiArray(env, m_filter ? m_filter->getState()
+                                                                          : std::vector<float>()));
+            state.Set("covariance", dsp::utils::VectorToNapiArray(env, m_filter ? m_filter->getCovariance()
+                                                                               : std::vector<float>()));
+            return state;
+        }
+
+        void deserializeState(const Napi::Object &state) override
+        {
+            dsp::core::KalmanOptions options;
+            options.processNoise = state.Get("processNoise").As<Napi::Number>().FloatValue();
+            options.measurementNoise = state.Get("measurementNoise").As<Napi::Number>().FloatValue();
+            options.dt = state.Get("dt").As<Napi::Number>().FloatValue();
+            options.initialCovariance = state.Get("initialCovariance").As<Napi::Number>().FloatValue();
+            options.steadyState = state.Get("steadyState").As<Napi::Boolean>().Value();
+            options.transition = dsp::utils::NapiArrayToVector<float>(state.Get("transition").As<Napi::Array>());
+            options.observation = dsp::utils::NapiArrayToVector<float>(state.Get("observation").As<Napi::Array>());
+            options.processCovariance =
+                dsp::utils::NapiArrayToVector<float>(state.Get("processCovariance").As<Napi::Array>());
+            checkParameters(state.Get("model").As<Napi::String>().Utf8Value(), options);
+
+            restore(state.Get("numChannels").As<Napi::Number>().Uint32Value(),
+                    dsp::utils::NapiArrayToVector<float>(state.Get("state").As<Napi::Array>()),
+                    dsp::utils::NapiArrayToVector<float>(state.Get("covariance").As<Napi::Array>()),
+                    state.Get("initialized").As<Napi::Boolean>().Value());
+        }
+
+        bool serializeBinary(dsp::utils::BinaryWriter &writer) const override
+        {
+            writer.writeString(dsp::core::kalmanModelName(m_options.model));
+            writer.writeF32(m_options.processNoise);
+            writer.writeF32(m_options.measurementNoise);
+            writer.writeF32(m_options.dt);
+            writer.writeF32(m_options.initialCovariance);
+            writer.writeU8(m_options.steadyState ? 1 : 0);
+            writer.writeArray(m_options.transition);
+            writer.writeArray(m_options.observation);
+            writer.writeArray(m_options.processCovariance);
+
+            writer.writeU32(static_cast<uint32_t>(m_filter ? m_filter->getChannels() : 0));
+            writer.writeU8(m_filter && m_filter->isInitialized() ? 1 : 0);
+            writer.writeArray(m_filter ? m_filter->getState() : std::vector<float>());
+            writer.writeArray(m_filter ? m_filter->getCovariance() : std::vector<float>());
+            return true;
+        }
+
+        void deserializeBinary(dsp::utils::BinaryReader &reader) override
+        {
+            std::string model = reader.readString();
+            dsp::core::KalmanOptions options;
+            options.processNoise = reader.readF32();
+            options.measurementNoise = reader.readF32();
+            options.dt = reader.readF32();
+            options.initialCovariance = reader.readF32();
+            options.steadyState = reader.readU8() != 0;
+            options.transition = reader.readArray<float>();
+            options.observation = reader.readArray<float>();
+            options.processCovariance = reader.readArray<float>();
+            checkParameters(model, options);
+
+            uint32_t numChannels = reader.readU32();
+            bool initialized = reader.readU8() != 0;
+            std::vector<float> filterState = reader.readArray<float>();
+            std::vector<float> covariance = reader.readArray<float>();
+            restore(numChannels, filterState, covariance, initialized);
+        }
+
+    private:
+        void ensureChannels(int numChannels)
+        {
+            if (numChannels > 0 && (!m_filter || m_filter->getChannels() != static_cast<size_t>(numChannels)))
+            {
+                m_filter = std::make_unique<dsp::core::KalmanFilter>(static_cast<size_t>(numChannels), m_options);
+            }
+        }
+
+        void restore(uint32_t numChannels, const std::vector<float> &filterState,
+                     const std::vector<float> &covariance, bool initialized)
+        {
+            if (numChannels == 0)
+            {
+                m_filter.reset();
+                return;
+            }
+            ensureChannels(static_cast<int>(numChannels));
+            m_filter->setState(filterState, covariance, initialized);
+        }
+
+        void checkParameters(const std::string &model, const dsp::core::KalmanOptions &options) const
+        {
+            if (model != dsp::core::kalmanModelName(m_options.model) ||
+                options.processNoise != m_options.processNoise ||
+                options.measurementNoise != m_options.measurementNoise || options.dt != m_options.dt ||
+                options.initialCovariance != m_options.initialCovariance ||
+                options.steadyState != m_options.steadyState || options.transition != m_options.transition ||
+                options.observation != m_options.observation ||
+                options.processCovariance != m_options.processCovariance)
+            {
+                throw std::runtime_error("KalmanFilter parameter mismatch during deserialization");
+            }
+        }
+
+        dsp::core::KalmanOptions m_options;
+        std::unique_ptr<dsp::core::KalmanFilter> m_filter;
+    };
+
+} // namespace dsp::adapters
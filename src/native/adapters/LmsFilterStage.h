@@ -0,0 +1,239 @@
+#pragma once
+
+#include "../IDspStage.h"
+#include "../core/LmsFilter.h"
+#include "../utils/NapiUtils.h"
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <stdexcept>
+#include <vector>
+
+namespace dsp::adapters
+{
+    /**
+     * @brief LMS / NLMS adaptive noise cancellation (see core::LmsFilter).
+     *
+     * One channel of the interleaved stream is the reference (by default
+     * the last one); every other channel is a primary with its own adaptive
+     * filter. The output is the primaries with the reference-correlated
+     * part removed, so a C-channel stream becomes C - 1 channels (a
+     * resizing stage). The filter is created for the channel count of the
+     * first chunk (or of prepare()) and rebuilt if it changes.
+     */
+    class LmsFilterStage : public IDspStage
+    {
+    public:
+        /**
+         * @param referenceChannel Index of the reference channel; -1 = last.
+         */
+        LmsFilterStage(size_t numTaps, float stepSize, bool normalized, float epsilon, int referenceChannel)
+            : m_numTaps(numTaps), m_stepSize(stepSize), m_normalized(normalized), m_epsilon(epsilon),
+              m_referenceChannel(referenceChannel)
+        {
+            if (referenceChannel < -1)
+            {
+                throw std::invalid_argument("LmsFilter: referenceChannel must be a channel index or -1");
+            }
+            // Validates the rest up front
+            dsp::core::LmsFilter(1, numTaps, stepSize, normalized, epsilon);
+        }
+
+        const char *getType() const override { return m_normalized ? "nlmsFilter" : "lmsFilter"; }
+
+        void process(float *buffer, size_t numSamples, int numChannels, const float *timestamps = nullptr) override
+        {
+            (void)buffer;
+            (void)numSamples;
+            (void)numChannels;
+            (void)timestamps;
+            throw std::runtime_error("LmsFilter changes the stream size and must be run through processResizing()");
+        }
+
+        bool isResizing() const override { return true; }
+
+        size_t maxOutputSize(size_t numSamples, int numChannels) const override
+        {
+            return numChannels > 1 ? numSamples / static_cast<size_t>(numChannels) * (numChannels - 1) : 0;
+        }
+
+        int outputChannels(int numChannels) const override { return numChannels - 1; }
+
+        void prepare(size_t /*maxBlockSize*/, int numChannels, double /*sampleRate*/) override
+        {
+            ensureChannels(numChannels);
+        }
+
+        size_t processResizing(const float *input, size_t numSamples, int numChannels, const float *timestamps,
+                               float *output, float *outputTimestamps, int &outputChannels) override
+        {
+            if (numChannels <= 0 || numSamples % static_cast<size_t>(numChannels) != 0)
+            {
+                throw std::invalid_argument("LmsFilter: sample count must be a multiple of the channel count");
+            }
+            ensureChannels(numChannels);
+
+            const size_t C = static_cast<size_t>(numChannels);
+            const size_t P = C - 1;
+            const size_t reference = referenceIndex(numChannels);
+            const size_t numFrames = numSamples / C;
+            for (size_t f = 0; f < numFrames; ++f)
+            {
+                const float *frame = input + f * C;
+                float *primary = output + f * P;
+                if (reference == P)
+                {
+                    m_filter->processFrame(frame, frame[P], primary);
+                }
+                else
+                {
+                    // Drop the reference from the frame; the filter works in place
+                    std::copy(frame, frame + reference, primary);
+                    std::copy(frame + reference + 1, frame + C, primary + reference);
+                    m_filter->processFrame(primary, frame[reference], primary);
+                }
+            }
+
+            if (timestamps != nullptr)
+            {
+                for (size_t f = 0; f < numFrames; ++f)
+                {
+                    std::fill(outputTimestamps + f * P, outputTimestamps + (f + 1) * P, timestamps[f * C]);
+                }
+            }
+
+            outputChannels = static_cast<int>(P);
+            return numFrames * P;
+        }
+
+        StageDescription describe() const override
+        {
+            StageDescription description;
+            description.mode = m_normalized ? "nlms" : "lms";
+            description.windowSize = m_numTaps;
+            description.numChannels = m_filter ? m_filter->getChannels() + 1 : 0;
+            return description;
+        }
+
+        void reset() override
+        {
+            if (m_filter)
+            {
+                m_filter->reset();
+            }
+        }
+
+        Napi::Object serializeState(Napi::Env env) const override
+        {
+            Napi::Object state = Napi::Object::New(env);
+            state.Set("numTaps", static_cast<uint32_t>(m_numTaps));
+            state.Set("stepSize", m_stepSize);
+            state.Set("normalized", m_normalized);
+            state.Set("epsilon", m_epsilon);
+            state.Set("referenceChannel", m_referenceChannel);
+            state.Set("numChannels", static_cast<uint32_t>(m_filter ? m_filter->getChannels() + 1 : 0));
+            state.Set("weights", dsp::utils::VectorToNapiArray(env, m_filter ? m_filter->getWeights()
+                                                                            : std::vector<float>()));
+            state.Set("history", dsp::utils::VectorToNapiArray(env, m_filter ? m_filter->getHistory()
+                                                                            : std::vector<float>()));
+            return state;
+        }
+
+        void deserializeState(const Napi::Object &state) override
+        {
+            checkParameters(state.Get("numTaps").As<Napi::Number>().Uint32Value(),
+                            state.Get("stepSize").As<Napi::Number>().FloatValue(),
+                            state.Get("normalized").As<Napi::Boolean>().Value(),
+                            state.Get("epsilon").As<Napi::Number>().FloatValue(),
+                            state.Get("referenceChannel").As<Napi::Number>().Int32Value());
+
+            restore(state.Get("numChannels").As<Napi::Number>().Uint32Value(),
+                    dsp::utils::NapiArrayToVector<float>(state.Get("weights").As<Napi::Array>()),
+                    dsp::utils::NapiArrayToVector<float>(state.Get("history").As<Napi::Array>()));
+        }
+
+        bool serializeBinary(dsp::utils::BinaryWriter &writer) const override
+        {
+            writer.writeU32(static_cast<uint32_t>(m_numTaps));
+            writer.writeF32(m_stepSize);
+            writer.writeU8(m_normalized ? 1 : 0);
+            writer.writeF32(m_epsilon);
+            writer.writeI32(m_referenceChannel);
+            writer.writeU32(static_cast<uint32_t>(m_filter ? m_filter->getChannels() + 1 : 0));
+            writer.writeArray(m_filter ? m_filter->getWeights() : std::vector<float>());
+            writer.writeArray(m_filter ? m_filter->getHistory() : std::vector<float>());
+            return true;
+        }
+
+        void deserializeBinary(dsp::utils::BinaryReader &reader) override
+        {
+            size_t numTaps = reader.readU32();
+            float stepSize = reader.readF32();
+            bool normalized = reader.readU8() != 0;
+            float epsilon = reader.readF32();
+            int referenceChannel = reader.readI32();
+            checkParameters(numTaps, stepSize, normalized, epsilon, referenceChannel);
+
+            uint32_t numChannels = reader.readU32();
+            std::vector<float> weights = reader.readArray<float>();
+            std::vector<float> history = reader.readArray<float>();
+            restore(numChannels, weights, history);
+        }
+
+    private:
+        size_t referenceIndex(int numChannels) const
+        {
+            return m_referenceChannel < 0 ? static_cast<size_t>(numChannels - 1)
+                                          : static_cast<size_t>(m_referenceChannel);
+        }
+
+        void ensureChannels(int numChannels)
+        {
+            if (numChannels < 2)
+            {
+                throw std::invalid_argument("LmsFilter: needs a reference and at least one primary channel, got " +
+                                            std::to_string(numChannels) + " channels");
+            }
+            if (m_referenceChannel >= numChannels)
+            {
+                throw std::invalid_argument("LmsFilter: referenceChannel " + std::to_string(m_referenceChannel) +
+                                            " is out of range for " + std::to_string(numChannels) + " channels");
+            }
+            const size_t primaries = static_cast<size_t>(numChannels - 1);
+            if (!m_filter || m_filter->getChannels() != primaries)
+            {
+                m_filter = std::make_unique<dsp::core::LmsFilter>(primaries, m_numTaps, m_stepSize, m_normalized,
+                                                                  m_epsilon);
+            }
+        }
+
+        void restore(uint32_t numChannels, const std::vector<float> &weights, const std::vector<float> &history)
+        {
+            if (numChannels == 0)
+            {
+                m_filter.reset();
+                return;
+            }
+            ensureChannels(static_cast<int>(numChannels));
+            m_filter->setState(weights, history);
+        }
+
+        void checkParameters(size_t numTaps, float stepSize, bool normalized, float epsilon,
+                             int referenceChannel) const
+        {
+            if (numTaps != m_numTaps || stepSize != m_stepSize || normalized != m_normalized ||
+                epsilon != m_epsilon || referenceChannel != m_referenceChannel)
+            {
+                throw std::runtime_error("LmsFilter parameter mismatch during deserialization");
+            }
+        }
+
+        size_t m_numTaps;
+        float m_stepSize;
+        bool m_normalized;
+        float m_epsilon;
+        int m_referenceChannel;
+        std::unique_ptr<dsp::core::LmsFilter> m_filter;
+    };
+
+} // namespace dsp::adapters
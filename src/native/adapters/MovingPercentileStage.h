@@ -0,0 +1,410 @@
+#pragma once
+
+#include "../IDspStage.h"
+#include "../core/MovingPercentileFilter.h"
+#include "../utils/NapiUtils.h"
+#include <vector>
+#include <stdexcept>
+#include <cmath>
+#include <string>
+#include <algorithm>
+
+namespace dsp::adapters
+{
+    enum class PercentileMethod
+    {
+        Exact,      // Double heap with lazy deletion, O(log w) per sample
+        Approximate // Staggered P² estimators, O(1) memory per channel
+    };
+
+    class MovingPercentileStage : public IDspStage
+    {
+    public:
+        /**
+         * @brief Constructs a new Moving Percentile Stage.
+         * @param percentile The percentile to track, in [0, 100] (50 = median).
+         * @param method Exact (heap-based) or Approximate (P²).
+         * @param window_size The window size in samples (0 if using duration-based).
+         * @param window_duration_ms The window duration in milliseconds (0 if using size-based).
+         * @param is_median True if created through the "movingMedian" factory.
+         */
+        explicit MovingPercentileStage(double percentile,
+                                       PercentileMethod method,
+                                       size_t window_size = 0,
+                                       double window_duration_ms = 0.0,
+                                       bool is_median = false)
+            : m_percentile(percentile),
+              m_method(method),
+              m_window_size(window_size),
+              m_window_duration_ms(window_duration_ms),
+              m_is_initialized(window_size > 0),
+              m_is_median(is_median)
+        {
+            if (!(percentile >= 0.0 && percentile <= 100.0))
+            {
+                throw std::invalid_argument("MovingPercentile: percentile must be between 0 and 100");
+            }
+            if (window_size == 0 && window_duration_ms <= 0.0)
+            {
+                throw std::invalid_argument("MovingPercentile: either window size or window duration must be greater than 0");
+            }
+            if (method == PercentileMethod::Approximate && window_size == 0)
+            {
+                throw std::invalid_argument("MovingPercentile: 'approximate' method requires 'windowSize'");
+            }
+        }
+
+        const char *getType() const override
+        {
+            return m_is_median ? "movingMedian" : "movingPercentile";
+        }
+
+        void process(float *buffer, size_t numSamples, int numChannels, const float *timestamps = nullptr) override
+        {
+            if (m_method == PercentileMethod::Approximate)
+            {
+                processApproximate(buffer, numSamples, numChannels);
+            }
+            else
+            {
+                processExact(buffer, numSamples, numChannels, timestamps);
+            }
+        }
+
+        // Create the channels ahead of the first process(). The exact
+        // method's heaps still grow and shrink while running; only the
+        // approximate method is allocation-free afterwards.
+        void prepare(size_t /*maxBlockSize*/, int numChannels, double sampleRate) override
+        {
+            if (numChannels <= 0)
+            {
+                return;
+            }
+            if (m_method == PercentileMethod::Approximate)
+            {
+                if (m_approx_filters.size() != static_cast<size_t>(numChannels))
+                {
+                    m_approx_filters.clear();
+                    for (int i = 0; i < numChannels; ++i)
+                    {
+                        m_approx_filters.emplace_back(m_window_size, m_percentile / 100.0);
+                    }
+                }
+                return;
+            }
+
+            // Same window estimate processExact() derives from the first timestamps
+            if (!m_is_initialized && m_window_duration_ms > 0.0)
+            {
+                if (sampleRate <= 0.0)
+                {
+                    throw std::invalid_argument("MovingPercentile: prepare() needs a sample rate to size a windowDuration window");
+                }
+                size_t estimated_size = static_cast<size_t>((m_window_duration_ms / 1000.0) * sampleRate);
+                m_window_size = std::max(size_t(1), estimated_size * 3);
+                m_is_initialized = true;
+            }
+
+            if (m_filters.size() != static_cast<size_t>(numChannels))
+            {
+                m_filters.clear();
+                for (int i = 0; i < numChannels; ++i)
+                {
+                    m_filters.push_back(createExactFilter(m_window_duration_ms > 0.0));
+                }
+            }
+        }
+
+        Napi::Object serializeState(Napi::Env env) const override
+        {
+            Napi::Object state = Napi::Object::New(env);
+            state.Set("windowSize", static_cast<uint32_t>(m_window_size));
+            state.Set("percentile", m_percentile);
+            state.Set("method", m_method == PercentileMethod::Exact ? "exact" : "approximate");
+
+            if (m_method == PercentileMethod::Exact)
+            {
+                state.Set("numChannels", static_cast<uint32_t>(m_filters.size()));
+                Napi::Array channelsArray = Napi::Array::New(env, m_filters.size());
+                for (size_t i = 0; i < m_filters.size(); ++i)
+                {
+                    // The heaps are derived data; the window contents are the full state
+                    Napi::Object channelState = Napi::Object::New(env);
+                    channelState.Set("buffer", dsp::utils::VectorToNapiArray(env, m_filters[i].getState()));
+                    channelsArray.Set(static_cast<uint32_t>(i), channelState);
+                }
+                state.Set("channels", channelsArray);
+            }
+            else
+            {
+                state.Set("numChannels", static_cast<uint32_t>(m_approx_filters.size()));
+                Napi::Array channelsArray = Napi::Array::New(env, m_approx_filters.size());
+                for (size_t i = 0; i < m_approx_filters.size(); ++i)
+                {
+                    auto [total, estimators] = m_approx_filters[i].getState();
+                    Napi::Object channelState = Napi::Object::New(env);
+                    channelState.Set("total", static_cast<double>(total));
+                    channelState.Set("estimatorA", dsp::utils::VectorToNapiArray(env, estimators.first));
+                    channelState.Set("estimatorB", dsp::utils::VectorToNapiArray(env, estimators.second));
+                    channelsArray.Set(static_cast<uint32_t>(i), channelState);
+                }
+                state.Set("channels", channelsArray);
+            }
+
+            return state;
+        }
+
+        void deserializeState(const Napi::Object &state) override
+        {
+            size_t windowSize = state.Get("windowSize").As<Napi::Number>().Uint32Value();
+            if (windowSize != m_window_size)
+            {
+                throw std::runtime_error("Window size mismatch during deserialization");
+            }
+
+            double percentile = state.Get("percentile").As<Napi::Number>().DoubleValue();
+            if (std::abs(percentile - m_percentile) > 1e-9)
+            {
+                throw std::runtime_error("MovingPercentile percentile mismatch during deserialization");
+            }
+
+            std::string methodStr = state.Get("method").As<Napi::String>().Utf8Value();
+            PercentileMethod method = (methodStr == "approximate") ? PercentileMethod::Approximate : PercentileMethod::Exact;
+            if (method != m_method)
+            {
+                throw std::runtime_error("MovingPercentile method mismatch during deserialization");
+            }
+
+            Napi::Array channelsArray = state.Get("channels").As<Napi::Array>();
+            uint32_t numChannels = channelsArray.Length();
+
+            if (m_method == PercentileMethod::Exact)
+            {
+                m_filters.clear();
+                for (uint32_t i = 0; i < numChannels; ++i)
+                {
+                    m_filters.push_back(createExactFilter(m_window_duration_ms > 0.0));
+                    Napi::Object channelState = channelsArray.Get(i).As<Napi::Object>();
+                    std::vector<float> bufferData = dsp::utils::NapiArrayToVector<float>(channelState.Get("buffer").As<Napi::Array>());
+                    if (bufferData.size() > m_window_size)
+                    {
+                        throw std::runtime_error("MovingPercentile buffer larger than window size");
+                    }
+                    m_filters[i].setState(bufferData);
+                }
+            }
+            else
+            {
+                m_approx_filters.clear();
+                for (uint32_t i = 0; i < numChannels; ++i)
+                {
+                    m_approx_filters.emplace_back(m_window_size, m_percentile / 100.0);
+                    Napi::Object channelState = channelsArray.Get(i).As<Napi::Object>();
+                    size_t total = static_cast<size_t>(channelState.Get("total").As<Napi::Number>().DoubleValue());
+                    std::vector<double> first = dsp::utils::NapiArrayToVector<double>(channelState.Get("estimatorA").As<Napi::Array>());
+                    std::vector<double> second = dsp::utils::NapiArrayToVector<double>(channelState.Get("estimatorB").As<Napi::Array>());
+                    m_approx_filters[i].setState(total, first, second);
+                }
+            }
+        }
+
+        bool serializeBinary(dsp::utils::BinaryWriter &writer) const override
+        {
+            writer.writeU32(static_cast<uint32_t>(m_window_size));
+            writer.writeF64(m_percentile);
+            writer.writeU8(static_cast<uint8_t>(m_method));
+
+            if (m_method == PercentileMethod::Exact)
+            {
+                writer.writeU32(static_cast<uint32_t>(m_filters.size()));
+                for (const auto &filter : m_filters)
+                {
+                    writer.writeArray(filter.getState());
+                }
+            }
+            else
+            {
+                writer.writeU32(static_cast<uint32_t>(m_approx_filters.size()));
+                for (const auto &filter : m_approx_filters)
+                {
+                    auto [total, estimators] = filter.getState();
+                    writer.writeU64(static_cast<uint64_t>(total));
+                    writer.writeArray(estimators.first);
+                    writer.writeArray(estimators.second);
+                }
+            }
+            return true;
+        }
+
+        void deserializeBinary(dsp::utils::BinaryReader &reader) override
+        {
+            size_t windowSize = reader.readU32();
+            if (windowSize != m_window_size)
+            {
+                throw std::runtime_error("Window size mismatch during deserialization");
+            }
+            if (std::abs(reader.readF64() - m_percentile) > 1e-9)
+            {
+                throw std::runtime_error("MovingPercentile percentile mismatch during deserialization");
+            }
+            if (static_cast<PercentileMethod>(reader.readU8()) != m_method)
+            {
+                throw std::runtime_error("MovingPercentile method mismatch during deserialization");
+            }
+
+            uint32_t numChannels = reader.readU32();
+            if (m_method == PercentileMethod::Exact)
+            {
+                m_filters.clear();
+                for (uint32_t i = 0; i < numChannels; ++i)
+                {
+                    m_filters.push_back(createExactFilter(m_window_duration_ms > 0.0));
+                    std::vector<float> bufferData = reader.readArray<float>();
+                    if (bufferData.size() > m_window_size)
+                    {
+                        throw std::runtime_error("MovingPercentile buffer larger than window size");
+                    }
+                    m_filters[i].setState(bufferData);
+                }
+            }
+            else
+            {
+                m_approx_filters.clear();
+                for (uint32_t i = 0; i < numChannels; ++i)
+                {
+                    m_approx_filters.emplace_back(m_window_size, m_percentile / 100.0);
+                    size_t total = static_cast<size_t>(reader.readU64());
+                    std::vector<double> first = reader.readArray<double>();
+                    std::vector<double> second = reader.readArray<double>();
+                    m_approx_filters[i].setState(total, first, second);
+                }
+            }
+        }
+
+        // Report configuration and occupancy without copying the windows
+        StageDescription describe() const override
+        {
+            StageDescription description;
+            description.windowSize = m_window_size;
+            if (m_window_duration_ms > 0.0)
+            {
+                description.windowDurationMs = m_window_duration_ms;
+            }
+            if (m_method == PercentileMethod::Exact)
+            {
+                description.numChannels = m_filters.size();
+                if (!m_filters.empty())
+                {
+                    description.bufferSize = m_filters[0].getCount();
+                }
+            }
+            else
+            {
+                // P2 estimators keep no sample buffer
+                description.numChannels = m_approx_filters.size();
+            }
+            return description;
+        }
+
+        void reset() override
+        {
+            for (auto &filter : m_filters)
+            {
+                filter.clear();
+            }
+            for (auto &filter : m_approx_filters)
+            {
+                filter.clear();
+            }
+        }
+
+    private:
+        dsp::core::MovingPercentileFilter<float> createExactFilter(bool timeAware) const
+        {
+            if (timeAware)
+            {
+                return dsp::core::MovingPercentileFilter<float>(m_window_size, m_window_duration_ms, m_percentile / 100.0);
+            }
+            return dsp::core::MovingPercentileFilter<float>(m_window_size, m_percentile / 100.0);
+        }
+
+        void processExact(float *buffer, size_t numSamples, int numChannels, const float *timestamps)
+        {
+            bool useTimeAware = (m_window_duration_ms > 0.0) && timestamps != nullptr;
+
+            // Lazy initialization: convert windowDuration to windowSize if needed
+            if (!m_is_initialized && m_window_duration_ms > 0.0)
+            {
+                if (timestamps != nullptr && numSamples > 1)
+                {
+                    size_t samples_to_check = std::min(numSamples, size_t(10));
+                    double total_time_ms = timestamps[samples_to_check - 1] - timestamps[0];
+                    double avg_sample_period_ms = total_time_ms / (samples_to_check - 1);
+                    double estimated_sample_rate = 1000.0 / avg_sample_period_ms; // Hz
+
+                    // Use 3x the estimated size so time-based expiration always wins
+                    size_t estimated_size = static_cast<size_t>((m_window_duration_ms / 1000.0) * estimated_sample_rate);
+                    m_window_size = std::max(size_t(1), estimated_size * 3);
+
+                    m_is_initialized = true;
+                }
+                else
+                {
+                    throw std::runtime_error("MovingPercentile: windowDuration was set, but timestamps are not available to derive sample rate");
+                }
+            }
+
+            if (m_filters.size() != static_cast<size_t>(numChannels))
+            {
+                m_filters.clear();
+                for (int i = 0; i < numChannels; ++i)
+                {
+                    m_filters.push_back(createExactFilter(useTimeAware));
+                }
+            }
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                int channel = i % numChannels;
+                size_t sample_index = i / numChannels;
+
+                if (useTimeAware)
+                {
+                    buffer[i] = m_filters[channel].addSampleWithTimestamp(buffer[i], timestamps[sample_index]);
+                }
+                else
+                {
+                    buffer[i] = m_filters[channel].addSample(buffer[i]);
+                }
+            }
+        }
+
+        void processApproximate(float *buffer, size_t numSamples, int numChannels)
+        {
+            if (m_approx_filters.size() != static_cast<size_t>(numChannels))
+            {
+                m_approx_filters.clear();
+                for (int i = 0; i < numChannels; ++i)
+                {
+                    m_approx_filters.emplace_back(m_window_size, m_percentile / 100.0);
+                }
+            }
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                int channel = i % numChannels;
+                buffer[i] = m_approx_filters[channel].addSample(buffer[i]);
+            }
+        }
+
+        double m_percentile;
+        PercentileMethod m_method;
+        size_t m_window_size;
+        double m_window_duration_ms;
+        bool m_is_initialized;
+        bool m_is_median;
+        std::vector<dsp::core::MovingPercentileFilter<float>> m_filters;
+        std::vector<dsp::core::ApproxMovingPercentileFilter<float>> m_approx_filters;
+    };
+
+} // namespace dsp::adapters
@@ -0,0 +1,234 @@
+#pragma once
+
+#include "../IDspStage.h"
+#include "../core/MovingStatisticsFilter.h"
+#include "../utils/NapiUtils.h"
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <stdexcept>
+
+namespace dsp::adapters
+{
+    /**
+     * @brief Several moving statistics over one shared window per channel.
+     *
+     * Each input channel becomes statistics.size() output channels
+     * ([channel][statistic] per frame), so this is a resizing stage: the
+     * frame count is unchanged but the stream gets wider.
+     */
+    class MovingStatisticsStage : public IDspStage
+    {
+    public:
+        MovingStatisticsStage(size_t window_size, std::vector<dsp::core::MovingStatistic> statistics)
+            : m_window_size(window_size), m_statistics(std::move(statistics))
+        {
+            if (window_size == 0)
+            {
+                throw std::invalid_argument("MovingStatistics: window size must be greater than 0");
+            }
+            if (m_statistics.empty())
+            {
+                throw std::invalid_argument("MovingStatistics: at least one statistic is required");
+            }
+        }
+
+        const char *getType() const override { return "movingStatistics"; }
+
+        void process(float *buffer, size_t numSamples, int numChannels, const float *timestamps = nullptr) override
+        {
+            (void)buffer;
+            (void)numSamples;
+            (void)numChannels;
+            (void)timestamps;
+            throw std::runtime_error("MovingStatistics changes the stream size and must be run through processResizing()");
+        }
+
+        bool isResizing() const override { return true; }
+
+        size_t maxOutputSize(size_t numSamples, int numChannels) const override
+        {
+            (void)numChannels;
+            return numSamples * m_statistics.size();
+        }
+
+        int outputChannels(int numChannels) const override
+        {
+            return numChannels * static_cast<int>(m_statistics.size());
+        }
+
+        void prepare(size_t /*maxBlockSize*/, int numChannels, double /*sampleRate*/) override
+        {
+            if (numChannels > 0 && m_filters.size() != static_cast<size_t>(numChannels))
+            {
+                m_filters.clear();
+                for (int i = 0; i < numChannels; ++i)
+                {
+                    m_filters.emplace_back(m_window_size);
+                }
+            }
+        }
+
+        size_t processResizing(const float *input, size_t numSamples, int numChannels, const float *timestamps,
+                               float *output, float *outputTimestamps, int &outputChannels) override
+        {
+            if (numChannels <= 0 || numSamples % static_cast<size_t>(numChannels) != 0)
+            {
+                throw std::invalid_argument("MovingStatistics: sample count must be a multiple of the channel count");
+            }
+            if (m_filters.size() != static_cast<size_t>(numChannels))
+            {
+                m_filters.clear();
+                for (int i = 0; i < numChannels; ++i)
+                {
+                    m_filters.emplace_back(m_window_size);
+                }
+            }
+
+            const size_t numStatistics = m_statistics.size();
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                const size_t channel = i % numChannels;
+                const auto results = m_filters[channel].addSample(input[i]);
+                float *out = output + i * numStatistics;
+                for (size_t s = 0; s < numStatistics; ++s)
+                {
+                    out[s] = results[static_cast<size_t>(m_statistics[s])];
+                }
+                if (timestamps != nullptr)
+                {
+                    std::fill(outputTimestamps + i * numStatistics, outputTimestamps + (i + 1) * numStatistics, timestamps[i]);
+                }
+            }
+
+            outputChannels = numChannels * static_cast<int>(numStatistics);
+            return numSamples * numStatistics;
+        }
+
+        StageDescription describe() const override
+        {
+            StageDescription description;
+            description.windowSize = m_window_size;
+            description.numChannels = m_filters.size();
+            if (!m_filters.empty())
+            {
+                description.bufferSize = m_filters[0].getCount();
+            }
+            return description;
+        }
+
+        void reset() override
+        {
+            for (auto &filter : m_filters)
+            {
+                filter.clear();
+            }
+        }
+
+        Napi::Object serializeState(Napi::Env env) const override
+        {
+            Napi::Object state = Napi::Object::New(env);
+            state.Set("windowSize", static_cast<uint32_t>(m_window_size));
+            state.Set("statistics", statisticNames(env));
+            state.Set("numChannels", static_cast<uint32_t>(m_filters.size()));
+
+            Napi::Array channelsArray = Napi::Array::New(env, m_filters.size());
+            for (size_t i = 0; i < m_filters.size(); ++i)
+            {
+                Napi::Object channelState = Napi::Object::New(env);
+                channelState.Set("buffer", dsp::utils::VectorToNapiArray(env, m_filters[i].getBufferContents()));
+                channelsArray.Set(static_cast<uint32_t>(i), channelState);
+            }
+            state.Set("channels", channelsArray);
+            return state;
+        }
+
+        void deserializeState(const Napi::Object &state) override
+        {
+            size_t windowSize = state.Get("windowSize").As<Napi::Number>().Uint32Value();
+            Napi::Array statistics = state.Get("statistics").As<Napi::Array>();
+            std::vector<std::string> names;
+            for (uint32_t i = 0; i < statistics.Length(); ++i)
+            {
+                names.push_back(statistics.Get(i).As<Napi::String>().Utf8Value());
+            }
+            checkParameters(windowSize, names);
+
+            Napi::Array channelsArray = state.Get("channels").As<Napi::Array>();
+            uint32_t numChannels = channelsArray.Length();
+            m_filters.clear();
+            for (uint32_t i = 0; i < numChannels; ++i)
+            {
+                Napi::Object channelState = channelsArray.Get(i).As<Napi::Object>();
+                m_filters.emplace_back(m_window_size);
+                m_filters.back().setBufferContents(
+                    dsp::utils::NapiArrayToVector<float>(channelState.Get("buffer").As<Napi::Array>()));
+            }
+        }
+
+        bool serializeBinary(dsp::utils::BinaryWriter &writer) const override
+        {
+            writer.writeU32(static_cast<uint32_t>(m_window_size));
+            writer.writeU32(static_cast<uint32_t>(m_statistics.size()));
+            for (auto statistic : m_statistics)
+            {
+                writer.writeString(dsp::core::movingStatisticName(statistic));
+            }
+            writer.writeU32(static_cast<uint32_t>(m_filters.size()));
+            for (const auto &filter : m_filters)
+            {
+                writer.writeArray(filter.getBufferContents());
+            }
+            return true;
+        }
+
+        void deserializeBinary(dsp::utils::BinaryReader &reader) override
+        {
+            size_t windowSize = reader.readU32();
+            uint32_t numStatistics = reader.readU32();
+            std::vector<std::string> names;
+            for (uint32_t i = 0; i < numStatistics; ++i)
+            {
+                names.push_back(reader.readString());
+            }
+            checkParameters(windowSize, names);
+
+            uint32_t numChannels = reader.readU32();
+            m_filters.clear();
+            for (uint32_t i = 0; i < numChannels; ++i)
+            {
+                m_filters.emplace_back(m_window_size);
+                m_filters.back().setBufferContents(reader.readArray<float>());
+            }
+        }
+
+    private:
+        Napi::Array statisticNames(Napi::Env env) const
+        {
+            Napi::Array names = Napi::Array::New(env, m_statistics.size());
+            for (size_t i = 0; i < m_statistics.size(); ++i)
+            {
+                names.Set(static_cast<uint32_t>(i), Napi::String::New(env, dsp::core::movingStatisticName(m_statistics[i])));
+            }
+            return names;
+        }
+
+        void checkParameters(size_t windowSize, const std::vector<std::string> &names) const
+        {
+            bool match = windowSize == m_window_size && names.size() == m_statistics.size();
+            for (size_t i = 0; match && i < names.size(); ++i)
+            {
+                match = names[i] == dsp::core::movingStatisticName(m_statistics[i]);
+            }
+            if (!match)
+            {
+                throw std::runtime_error("MovingStatistics parameter mismatch during deserialization");
+            }
+        }
+
+        size_t m_window_size;
+        std::vector<dsp::core::MovingStatistic> m_statistics;
+        std::vector<dsp::core::MovingStatisticsFilter<float>> m_filters;
+    };
+
+} // namespace dsp::adapters
@@ -0,0 +1,251 @@
+#pragma once
+
+#include "../IDspStage.h"
+#include "../core/StreamingPca.h"
+#include "../utils/NapiUtils.h"
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <stdexcept>
+#include <vector>
+
+namespace dsp::adapters
+{
+    /**
+     * @brief Streaming PCA / whitening (see core::StreamingPca).
+     *
+     * The estimator is created for the channel count of the first chunk
+     * (or of prepare()) and rebuilt if it changes. Outputs `components`
+     * channels in "pca" / "whiten" mode and one per input channel in "zca"
+     * mode, so this is a resizing stage.
+     */
+    class PcaStage : public IDspStage
+    {
+    public:
+        explicit PcaStage(const dsp::core::PcaOptions &options) : m_options(options)
+        {
+            if ((options.windowSize == 0) == (options.alpha == 0.0))
+            {
+                throw std::invalid_argument("Pca: exactly one of windowSize and alpha must be set");
+            }
+            if (options.windowSize == 0 && !(options.alpha > 0.0 && options.alpha <= 1.0))
+            {
+                throw std::invalid_argument("Pca: alpha must be in (0, 1]");
+            }
+            if (options.updateInterval == 0)
+            {
+                throw std::invalid_argument("Pca: update interval must be greater than 0");
+            }
+            if (!(options.epsilon >= 0.0))
+            {
+                throw std::invalid_argument("Pca: epsilon must be non-negative");
+            }
+        }
+
+        const char *getType() const override { return "pca"; }
+
+        void process(float *buffer, size_t numSamples, int numChannels, const float *timestamps = nullptr) override
+        {
+            (void)buffer;
+            (void)numSamples;
+            (void)numChannels;
+            (void)timestamps;
+            throw std::runtime_error("Pca changes the stream size and must be run through processResizing()");
+        }
+
+        bool isResizing() const override { return true; }
+
+        size_t maxOutputSize(size_t numSamples, int numChannels) const override
+        {
+            return numChannels > 0 ? numSamples / static_cast<size_t>(numChannels) * outputChannels(numChannels) : 0;
+        }
+
+        int outputChannels(int numChannels) const override
+        {
+            if (m_options.mode == dsp::core::PcaMode::Zca || m_options.components == 0)
+            {
+                return numChannels;
+            }
+            return static_cast<int>(m_options.components);
+        }
+
+        void prepare(size_t /*maxBlockSize*/, int numChannels, double /*sampleRate*/) override
+        {
+            ensureChannels(numChannels);
+        }
+
+        size_t processResizing(const float *input, size_t numSamples, int numChannels, const float *timestamps,
+                               float *output, float *outputTimestamps, int &outputChannels) override
+        {
+            if (numChannels <= 0 || numSamples % static_cast<size_t>(numChannels) != 0)
+            {
+                throw std::invalid_argument("Pca: sample count must be a multiple of the channel count");
+            }
+            ensureChannels(numChannels);
+
+            const size_t numFrames = numSamples / static_cast<size_t>(numChannels);
+            const size_t outChannels = m_pca->getOutputChannels();
+            m_pca->process(input, numFrames, output);
+            if (timestamps != nullptr)
+            {
+                for (size_t f = 0; f < numFrames; ++f)
+                {
+                    std::fill(outputTimestamps + f * outChannels, outputTimestamps + (f + 1) * outChannels,
+                              timestamps[f * numChannels]);
+                }
+            }
+
+            outputChannels = static_cast<int>(outChannels);
+            return numFrames * outChannels;
+        }
+
+        StageDescription describe() const override
+        {
+            StageDescription description;
+            description.mode = dsp::core::pcaModeName(m_options.mode);
+            if (m_options.windowSize != 0)
+            {
+                description.windowSize = m_options.windowSize;
+            }
+            description.numChannels = m_pca ? m_pca->getInputChannels() : 0;
+            if (m_pca)
+            {
+                description.bufferSize = m_pca->getCount();
+            }
+            return description;
+        }
+
+        void reset() override
+        {
+            if (m_pca)
+            {
+                m_pca->reset();
+            }
+        }
+
+        Napi::Object serializeState(Napi::Env env) const override
+        {
+            Napi::Object state = Napi::Object::New(env);
+            state.Set("mode", dsp::core::pcaModeName(m_options.mode));
+            state.Set("components", static_cast<uint32_t>(m_options.components));
+            state.Set("windowSize", static_cast<uint32_t>(m_options.windowSize));
+            state.Set("alpha", m_options.alpha);
+            state.Set("updateInterval", static_cast<uint32_t>(m_options.updateInterval));
+            state.Set("epsilon", m_options.epsilon);
+
+            const dsp::core::PcaState pca = m_pca ? m_pca->getState() : dsp::core::PcaState();
+            state.Set("numChannels", static_cast<uint32_t>(m_pca ? m_pca->getInputChannels() : 0));
+            state.Set("count", static_cast<double>(pca.count));
+            state.Set("sinceUpdate", static_cast<uint32_t>(pca.sinceUpdate));
+            state.Set("first", dsp::utils::VectorToNapiArray(env, pca.first));
+            state.Set("second", dsp::utils::VectorToNapiArray(env, pca.second));
+            state.Set("window", dsp::utils::VectorToNapiArray(env, pca.window));
+            state.Set("weights", dsp::utils::VectorToNapiArray(env, pca.weights));
+            state.Set("bias", dsp::utils::VectorToNapiArray(env, pca.bias));
+            state.Set("eigenvalues", dsp::utils::VectorToNapiArray(env, pca.eigenvalues));
+            return state;
+        }
+
+        void deserializeState(const Napi::Object &state) override
+        {
+            checkParameters(state.Get("mode").As<Napi::String>().Utf8Value(),
+                            state.Get("components").As<Napi::Number>().Uint32Value(),
+                            state.Get("windowSize").As<Napi::Number>().Uint32Value(),
+                            state.Get("alpha").As<Napi::Number>().DoubleValue(),
+                            state.Get("updateInterval").As<Napi::Number>().Uint32Value(),
+                            state.Get("epsilon").As<Napi::Number>().DoubleValue());
+
+            dsp::core::PcaState pca;
+            pca.count = static_cast<size_t>(state.Get("count").As<Napi::Number>().DoubleValue());
+            pca.sinceUpdate = state.Get("sinceUpdate").As<Napi::Number>().Uint32Value();
+            pca.first = dsp::utils::NapiArrayToVector<double>(state.Get("first").As<Napi::Array>());
+            pca.second = dsp::utils::NapiArrayToVector<double>(state.Get("second").As<Napi::Array>());
+            pca.window = dsp::utils::NapiArrayToVector<float>(state.Get("window").As<Napi::Array>());
+            pca.weights = dsp::utils::NapiArrayToVector<float>(state.Get("weights").As<Napi::Array>());
+            pca.bias = dsp::utils::NapiArrayToVector<float>(state.Get("bias").As<Napi::Array>());
+            pca.eigenvalues = dsp::utils::NapiArrayToVector<double>(state.Get("eigenvalues").As<Napi::Array>());
+            restore(state.Get("numChannels").As<Napi::Number>().Uint32Value(), pca);
+        }
+
+        bool serializeBinary(dsp::utils::BinaryWriter &writer) const override
+        {
+            writer.writeString(dsp::core::pcaModeName(m_options.mode));
+            writer.writeU32(static_cast<uint32_t>(m_options.components));
+            writer.writeU32(static_cast<uint32_t>(m_options.windowSize));
+            writer.writeF64(m_options.alpha);
+            writer.writeU32(static_cast<uint32_t>(m_options.updateInterval));
+            writer.writeF64(m_options.epsilon);
+
+            const dsp::core::PcaState pca = m_pca ? m_pca->getState() : dsp::core::PcaState();
+            writer.writeU32(static_cast<uint32_t>(m_pca ? m_pca->getInputChannels() : 0));
+            writer.writeF64(static_cast<double>(pca.count));
+            writer.writeU32(static_cast<uint32_t>(pca.sinceUpdate));
+            writer.writeArray(pca.first);
+            writer.writeArray(pca.second);
+            writer.writeArray(pca.window);
+            writer.writeArray(pca.weights);
+            writer.writeArray(pca.bias);
+            writer.writeArray(pca.eigenvalues);
+            return true;
+        }
+
+        void deserializeBinary(dsp::utils::BinaryReader &reader) override
+        {
+            std::string mode = reader.readString();
+            size_t components = reader.readU32();
+            size_t windowSize = reader.readU32();
+            double alpha = reader.readF64();
+            size_t updateInterval = reader.readU32();
+            double epsilon = reader.readF64();
+            checkParameters(mode, components, windowSize, alpha, updateInterval, epsilon);
+
+            uint32_t numChannels = reader.readU32();
+            dsp::core::PcaState pca;
+            pca.count = static_cast<size_t>(reader.readF64());
+            pca.sinceUpdate = reader.readU32();
+            pca.first = reader.readArray<double>();
+            pca.second = reader.readArray<double>();
+            pca.window = reader.readArray<float>();
+            pca.weights = reader.readArray<float>();
+            pca.bias = reader.readArray<float>();
+            pca.eigenvalues = reader.readArray<double>();
+            restore(numChannels, pca);
+        }
+
+    private:
+        void ensureChannels(int numChannels)
+        {
+            if (numChannels > 0 && (!m_pca || m_pca->getInputChannels() != static_cast<size_t>(numChannels)))
+            {
+                m_pca.reset();
+                m_pca = std::make_unique<dsp::core::StreamingPca>(static_cast<size_t>(numChannels), m_options);
+            }
+        }
+
+        void restore(uint32_t numChannels, const dsp::core::PcaState &pca)
+        {
+            if (numChannels == 0)
+            {
+                m_pca.reset();
+                return;
+            }
+            ensureChannels(static_cast<int>(numChannels));
+            m_pca->setState(pca);
+        }
+
+        void checkParameters(const std::string &mode, size_t components, size_t windowSize, double alpha,
+                             size_t updateInterval, double epsilon) const
+        {
+            if (mode != dsp::core::pcaModeName(m_options.mode) || components != m_options.components ||
+                windowSize != m_options.windowSize || alpha != m_options.alpha ||
+                updateInterval != m_options.updateInterval || epsilon != m_options.epsilon)
+            {
+                throw std::runtime_error("Pca parameter mismatch during deserialization");
+            }
+        }
+
+        dsp::core::PcaOptions m_options;
+        std::unique_ptr<dsp::core::StreamingPca> m_pca;
+    };
+
+} // namespace dsp::adapters
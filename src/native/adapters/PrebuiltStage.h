@@ -0,0 +1,227 @@
+#pragma once
+
+#include "../IDspStage.h"
+#include "../core/StaticPipeline.h"
+#include "../utils/NapiUtils.h"
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+namespace dsp::adapters
+{
+    /**
+     * @brief Runs a StaticPipeline as one pipeline stage.
+     *
+     * The chain is fixed at compile time, so the whole thing costs one
+     * virtual call per chunk instead of one per stage. State is every
+     * windowed step's per-channel window; stateless steps save nothing.
+     *
+     * @tparam Pipeline A dsp::core::StaticPipeline<...> instantiation.
+     */
+    template <typename Pipeline>
+    class StaticPipelineStage : public IDspStage
+    {
+    public:
+        StaticPipelineStage(std::string name, Pipeline pipeline)
+            : m_name(std::move(name)), m_pipeline(std::move(pipeline)) {}
+
+        const char *getType() const override { return "prebuilt"; }
+
+        void process(float *buffer, size_t numSamples, int numChannels, const float * /*timestamps*/ = nullptr) override
+        {
+            m_pipeline.process(buffer, numSamples, numChannels);
+        }
+
+        void prepare(size_t /*maxBlockSize*/, int numChannels, double /*sampleRate*/) override
+        {
+            if (numChannels > 0 && m_pipeline.getNumChannels() != static_cast<size_t>(numChannels))
+            {
+                m_pipeline.setNumChannels(numChannels);
+            }
+        }
+
+        StageDescription describe() const override
+        {
+            StageDescription description;
+            description.mode = m_name;
+            description.numChannels = m_pipeline.getNumChannels();
+            // Report the first windowed step
+            m_pipeline.forEachStep([&description](const auto &step)
+                                   {
+                if (!description.windowSize && step.getWindowSize() > 0)
+                {
+                    description.windowSize = step.getWindowSize();
+                    description.bufferSize = step.getCount();
+                } });
+            return description;
+        }
+
+        void reset() override { m_pipeline.clear(); }
+
+        Napi::Object serializeState(Napi::Env env) const override
+        {
+            Napi::Object state = Napi::Object::New(env);
+            state.Set("name", m_name);
+            state.Set("numChannels", static_cast<uint32_t>(m_pipeline.getNumChannels()));
+
+            Napi::Array stepsArray = Napi::Array::New(env, Pipeline::kNumSteps);
+            uint32_t index = 0;
+            m_pipeline.forEachStep([&](const auto &step)
+                                   {
+                Napi::Object stepState = Napi::Object::New(env);
+                stepState.Set("windowSize", static_cast<uint32_t>(step.getWindowSize()));
+                size_t numChannels = step.getWindowSize() > 0 ? m_pipeline.getNumChannels() : 0;
+                Napi::Array channelsArray = Napi::Array::New(env, numChannels);
+                for (size_t c = 0; c < numChannels; ++c)
+                {
+                    channelsArray.Set(static_cast<uint32_t>(c), dsp::utils::VectorToNapiArray(env, step.getWindow(c)));
+                }
+                stepState.Set("channels", channelsArray);
+                stepsArray.Set(index++, stepState); });
+            state.Set("steps", stepsArray);
+            return state;
+        }
+
+        void deserializeState(const Napi::Object &state) override
+        {
+            std::string name = state.Get("name").As<Napi::String>().Utf8Value();
+            Napi::Array stepsArray = state.Get("steps").As<Napi::Array>();
+            checkShape(name, stepsArray.Length());
+
+            m_pipeline.setNumChannels(state.Get("numChannels").As<Napi::Number>().Uint32Value());
+            uint32_t index = 0;
+            m_pipeline.forEachStep([&](auto &step)
+                                   {
+                Napi::Object stepState = stepsArray.Get(index++).As<Napi::Object>();
+                checkWindowSize(step.getWindowSize(), stepState.Get("windowSize").As<Napi::Number>().Uint32Value());
+                if (step.getWindowSize() > 0)
+                {
+                    Napi::Array channelsArray = stepState.Get("channels").As<Napi::Array>();
+                    std::vector<std::vector<float>> windows;
+                    for (uint32_t c = 0; c < channelsArray.Length(); ++c)
+                    {
+                        windows.push_back(dsp::utils::NapiArrayToVector<float>(channelsArray.Get(c).As<Napi::Array>()));
+                    }
+                    checkChannels(windows.size());
+                    step.setWindows(windows);
+                } });
+        }
+
+        bool serializeBinary(dsp::utils::BinaryWriter &writer) const override
+        {
+            writer.writeString(m_name);
+            writer.writeU32(static_cast<uint32_t>(m_pipeline.getNumChannels()));
+            writer.writeU32(static_cast<uint32_t>(Pipeline::kNumSteps));
+            m_pipeline.forEachStep([&](const auto &step)
+                                   {
+                writer.writeU32(static_cast<uint32_t>(step.getWindowSize()));
+                if (step.getWindowSize() > 0)
+                {
+                    for (size_t c = 0; c < m_pipeline.getNumChannels(); ++c)
+                    {
+                        writer.writeArray(step.getWindow(c));
+                    }
+                } });
+            return true;
+        }
+
+        void deserializeBinary(dsp::utils::BinaryReader &reader) override
+        {
+            std::string name = reader.readString();
+            uint32_t numChannels = reader.readU32();
+            checkShape(name, reader.readU32());
+
+            m_pipeline.setNumChannels(numChannels);
+            m_pipeline.forEachStep([&](auto &step)
+                                   {
+                checkWindowSize(step.getWindowSize(), reader.readU32());
+                if (step.getWindowSize() > 0)
+                {
+                    std::vector<std::vector<float>> windows;
+                    for (uint32_t c = 0; c < numChannels; ++c)
+                    {
+                        windows.push_back(reader.readArray<float>());
+                    }
+                    step.setWindows(windows);
+                } });
+        }
+
+    private:
+        void checkShape(const std::string &name, size_t numSteps) const
+        {
+            if (name != m_name || numSteps != Pipeline::kNumSteps)
+            {
+                throw std::runtime_error("Prebuilt pipeline mismatch during deserialization: expected '" + m_name + "'");
+            }
+        }
+
+        static void checkWindowSize(size_t expected, size_t actual)
+        {
+            if (expected != actual)
+            {
+                throw std::runtime_error("Prebuilt pipeline window size mismatch during deserialization");
+            }
+        }
+
+        void checkChannels(size_t numChannels) const
+        {
+            if (numChannels != m_pipeline.getNumChannels())
+            {
+                throw std::runtime_error("Prebuilt pipeline channel count mismatch during deserialization");
+            }
+        }
+
+        std::string m_name;
+        Pipeline m_pipeline;
+    };
+
+    /**
+     * @brief Parameters shared by the prebuilt chains (each uses what it needs).
+     */
+    struct PrebuiltParams
+    {
+        size_t windowSize = 0;       // Envelope window (MAV / RMS)
+        size_t zScoreWindowSize = 0; // Normalization window; 0 = windowSize
+        float epsilon = 1e-6f;       // ZScore: stddev below which the output is 0
+        bool halfWave = false;       // Rectify: max(x, 0) instead of |x|
+    };
+
+    /**
+     * @brief Builds a named prebuilt chain.
+     *
+     *   rectifyMavZScore  Rectify -> MeanAbsoluteValue -> ZScoreNormalize
+     *   rmsZScore         Rms -> ZScoreNormalize
+     *
+     * Each matches the same stages added one by one in "moving" mode with
+     * sample-count windows.
+     *
+     * @throws std::invalid_argument for an unknown name or a zero window.
+     */
+    inline std::unique_ptr<IDspStage> makePrebuiltStage(const std::string &name, const PrebuiltParams &params)
+    {
+        namespace steps = dsp::core::steps;
+        if (params.windowSize == 0)
+        {
+            throw std::invalid_argument("Prebuilt: window size must be greater than 0");
+        }
+        const size_t zScoreWindow = params.zScoreWindowSize > 0 ? params.zScoreWindowSize : params.windowSize;
+        const steps::ZScoreResult zScore{params.epsilon};
+
+        if (name == "rectifyMavZScore")
+        {
+            using Pipeline = dsp::core::StaticPipeline<steps::Rectify, steps::MeanAbsoluteValue, steps::ZScore>;
+            return std::make_unique<StaticPipelineStage<Pipeline>>(
+                name, Pipeline(steps::Rectify(params.halfWave), steps::MeanAbsoluteValue(params.windowSize),
+                               steps::ZScore(zScoreWindow, zScore)));
+        }
+        if (name == "rmsZScore")
+        {
+            using Pipeline = dsp::core::StaticPipeline<steps::Rms, steps::ZScore>;
+            return std::make_unique<StaticPipelineStage<Pipeline>>(
+                name, Pipeline(steps::Rms(params.windowSize), steps::ZScore(zScoreWindow, zScore)));
+        }
+        throw std::invalid_argument("Prebuilt: unknown pipeline '" + name + "'");
+    }
+
+} // namespace dsp::adapters
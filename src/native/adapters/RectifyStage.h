@@ -80,6 +80,27 @@ namespace dsp::adapters
                 throw std::runtime_error("Invalid rectify mode");
         }
 
+        bool serializeBinary(dsp::utils::BinaryWriter &writer) const override
+        {
+            writer.writeU8(m_mode == RectifyMode::FullWave ? 0 : 1);
+            return true;
+        }
+
+        void deserializeBinary(dsp::utils::BinaryReader &reader) override
+        {
+            uint8_t mode = reader.readU8();
+            if (mode > 1)
+                throw std::runtime_error("Invalid rectify mode");
+            m_mode = (mode == 0) ? RectifyMode::FullWave : RectifyMode::HalfWave;
+        }
+
+        StageDescription describe() const override
+        {
+            StageDescription description;
+            description.mode = m_mode == RectifyMode::FullWave ? "full" : "half";
+            return description;
+        }
+
         void reset() override {} // No internal buffers
 
     private:
@@ -0,0 +1,236 @@
+#pragma once
+
+#include "../IDspStage.h"
+#include "../core/RlsFilter.h"
+#include "../utils/NapiUtils.h"
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <stdexcept>
+#include <vector>
+
+namespace dsp::adapters
+{
+    /**
+     * @brief RLS adaptive noise cancellation (see core::RlsFilter).
+     *
+     * Routes channels like LmsFilterStage: the reference channel (default:
+     * last) drives one adaptive filter per remaining channel and is dropped
+     * from the output (C channels in, C - 1 out). Snapshots carry the
+     * shared inverse correlation matrix along with the weights, so a
+     * restored filter keeps its fast tracking instead of re-initializing P.
+     */
+    class RlsFilterStage : public IDspStage
+    {
+    public:
+        /**
+         * @param referenceChannel Index of the reference channel; -1 = last.
+         */
+        RlsFilterStage(size_t numTaps, float lambda, float delta, int referenceChannel)
+            : m_numTaps(numTaps), m_lambda(lambda), m_delta(delta), m_referenceChannel(referenceChannel)
+        {
+            if (referenceChannel < -1)
+            {
+                throw std::invalid_argument("RlsFilter: referenceChannel must be a channel index or -1");
+            }
+            // Validates the rest up front
+            dsp::core::RlsFilter(1, numTaps, lambda, delta);
+        }
+
+        const char *getType() const override { return "rlsFilter"; }
+
+        void process(float *buffer, size_t numSamples, int numChannels, const float *timestamps = nullptr) override
+        {
+            (void)buffer;
+            (void)numSamples;
+            (void)numChannels;
+            (void)timestamps;
+            throw std::runtime_error("RlsFilter changes the stream size and must be run through processResizing()");
+        }
+
+        bool isResizing() const override { return true; }
+
+        size_t maxOutputSize(size_t numSamples, int numChannels) const override
+        {
+            return numChannels > 1 ? numSamples / static_cast<size_t>(numChannels) * (numChannels - 1) : 0;
+        }
+
+        int outputChannels(int numChannels) const override { return numChannels - 1; }
+
+        void prepare(size_t /*maxBlockSize*/, int numChannels, double /*sampleRate*/) override
+        {
+            ensureChannels(numChannels);
+        }
+
+        size_t processResizing(const float *input, size_t numSamples, int numChannels, const float *timestamps,
+                               float *output, float *outputTimestamps, int &outputChannels) override
+        {
+            if (numChannels <= 0 || numSamples % static_cast<size_t>(numChannels) != 0)
+            {
+                throw std::invalid_argument("RlsFilter: sample count must be a multiple of the channel count");
+            }
+            ensureChannels(numChannels);
+
+            const size_t C = static_cast<size_t>(numChannels);
+            const size_t P = C - 1;
+            const size_t reference = referenceIndex(numChannels);
+            const size_t numFrames = numSamples / C;
+            for (size_t f = 0; f < numFrames; ++f)
+            {
+                const float *frame = input + f * C;
+                float *primary = output + f * P;
+                if (reference == P)
+                {
+                    m_filter->processFrame(frame, frame[P], primary);
+                }
+                else
+                {
+                    // Drop the reference from the frame; the filter works in place
+                    std::copy(frame, frame + reference, primary);
+                    std::copy(frame + reference + 1, frame + C, primary + reference);
+                    m_filter->processFrame(primary, frame[reference], primary);
+                }
+            }
+
+            if (timestamps != nullptr)
+            {
+                for (size_t f = 0; f < numFrames; ++f)
+                {
+                    std::fill(outputTimestamps + f * P, outputTimestamps + (f + 1) * P, timestamps[f * C]);
+                }
+            }
+
+            outputChannels = static_cast<int>(P);
+            return numFrames * P;
+        }
+
+        StageDescription describe() const override
+        {
+            StageDescription description;
+            description.windowSize = m_numTaps;
+            description.numChannels = m_filter ? m_filter->getChannels() + 1 : 0;
+            return description;
+        }
+
+        void reset() override
+        {
+            if (m_filter)
+            {
+                m_filter->reset();
+            }
+        }
+
+        Napi::Object serializeState(Napi::Env env) const override
+        {
+            Napi::Object state = Napi::Object::New(env);
+            state.Set("numTaps", static_cast<uint32_t>(m_numTaps));
+            state.Set("lambda", m_lambda);
+            state.Set("delta", m_delta);
+            state.Set("referenceChannel", m_referenceChannel);
+            state.Set("numChannels", static_cast<uint32_t>(m_filter ? m_filter->getChannels() + 1 : 0));
+            state.Set("weights", dsp::utils::VectorToNapiArray(env, m_filter ? m_filter->getWeights()
+                                                                            : std::vector<float>()));
+            state.Set("history", dsp::utils::VectorToNapiArray(env, m_filter ? m_filter->getHistory()
+                                                                            : std::vector<float>()));
+            state.Set("inverseCorrelation",
+                      dsp::utils::VectorToNapiArray(env, m_filter ? m_filter->getInverseCorrelation()
+                                                                  : std::vector<float>()));
+            return state;
+        }
+
+        void deserializeState(const Napi::Object &state) override
+        {
+            checkParameters(state.Get("numTaps").As<Napi::Number>().Uint32Value(),
+                            state.Get("lambda").As<Napi::Number>().FloatValue(),
+                            state.Get("delta").As<Napi::Number>().FloatValue(),
+                            state.Get("referenceChannel").As<Napi::Number>().Int32Value());
+
+            restore(state.Get("numChannels").As<Napi::Number>().Uint32Value(),
+                    dsp::utils::NapiArrayToVector<float>(state.Get("weights").As<Napi::Array>()),
+                    dsp::utils::NapiArrayToVector<float>(state.Get("history").As<Napi::Array>()),
+                    dsp::utils::NapiArrayToVector<float>(state.Get("inverseCorrelation").As<Napi::Array>()));
+        }
+
+        bool serializeBinary(dsp::utils::BinaryWriter &writer) const override
+        {
+            writer.writeU32(static_cast<uint32_t>(m_numTaps));
+            writer.writeF32(m_lambda);
+            writer.writeF32(m_delta);
+            writer.writeI32(m_referenceChannel);
+            writer.writeU32(static_cast<uint32_t>(m_filter ? m_filter->getChannels() + 1 : 0));
+            writer.writeArray(m_filter ? m_filter->getWeights() : std::vector<float>());
+            writer.writeArray(m_filter ? m_filter->getHistory() : std::vector<float>());
+            writer.writeArray(m_filter ? m_filter->getInverseCorrelation() : std::vector<float>());
+            return true;
+        }
+
+        void deserializeBinary(dsp::utils::BinaryReader &reader) override
+        {
+            size_t numTaps = reader.readU32();
+            float lambda = reader.readF32();
+            float delta = reader.readF32();
+            int referenceChannel = reader.readI32();
+            checkParameters(numTaps, lambda, delta, referenceChannel);
+
+            uint32_t numChannels = reader.readU32();
+            std::vector<float> weights = reader.readArray<float>();
+            std::vector<float> history = reader.readArray<float>();
+            std::vector<float> inverseCorrelation = reader.readArray<float>();
+            restore(numChannels, weights, history, inverseCorrelation);
+        }
+
+    private:
+        size_t referenceIndex(int numChannels) const
+        {
+            return m_referenceChannel < 0 ? static_cast<size_t>(numChannels - 1)
+                                          : static_cast<size_t>(m_referenceChannel);
+        }
+
+        void ensureChannels(int numChannels)
+        {
+            if (numChannels < 2)
+            {
+                throw std::invalid_argument("RlsFilter: needs a reference and at least one primary channel, got " +
+                                            std::to_string(numChannels) + " channels");
+            }
+            if (m_referenceChannel >= numChannels)
+            {
+                throw std::invalid_argument("RlsFilter: referenceChannel " + std::to_string(m_referenceChannel) +
+                                            " is out of range for " + std::to_string(numChannels) + " channels");
+            }
+            const size_t primaries = static_cast<size_t>(numChannels - 1);
+            if (!m_filter || m_filter->getChannels() != primaries)
+            {
+                m_filter = std::make_unique<dsp::core::RlsFilter>(primaries, m_numTaps, m_lambda, m_delta);
+            }
+        }
+
+        void restore(uint32_t numChannels, const std::vector<float> &weights, const std::vector<float> &history,
+                     const std::vector<float> &inverseCorrelation)
+        {
+            if (numChannels == 0)
+            {
+                m_filter.reset();
+                return;
+            }
+            ensureChannels(static_cast<int>(numChannels));
+            m_filter->setState(weights, history, inverseCorrelation);
+        }
+
+        void checkParameters(size_t numTaps, float lambda, float delta, int referenceChannel) const
+        {
+            if (numTaps != m_numTaps || lambda != m_lambda || delta != m_delta ||
+                referenceChannel != m_referenceChannel)
+            {
+                throw std::runtime_error("RlsFilter parameter mismatch during deserialization");
+            }
+        }
+
+        size_t m_numTaps;
+        float m_lambda;
+        float m_delta;
+        int m_referenceChannel;
+        std::unique_ptr<dsp::core::RlsFilter> m_filter;
+    };
+
+} // namespace dsp::adapters
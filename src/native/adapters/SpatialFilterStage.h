@@ -0,0 +1,154 @@
+#pragma once
+
+#include "../IDspStage.h"
+#include "../core/SpatialFilter.h"
+#include "../utils/NapiUtils.h"
+#include <algorithm>
+#include <string>
+#include <stdexcept>
+#include <vector>
+
+namespace dsp::adapters
+{
+    /**
+     * @brief Mixes the channels of every frame through an M x C matrix.
+     *
+     * A C-channel stream becomes an M-channel one with the same frame
+     * count, so this is a resizing stage. The mode ("car", "laplacian",
+     * "bipolar", "matrix") only records how the matrix was built.
+     */
+    class SpatialFilterStage : public IDspStage
+    {
+    public:
+        SpatialFilterStage(std::string mode, dsp::core::SpatialFilter filter)
+            : m_mode(std::move(mode)), m_filter(std::move(filter))
+        {
+        }
+
+        const char *getType() const override { return "spatialFilter"; }
+
+        void process(float *buffer, size_t numSamples, int numChannels, const float *timestamps = nullptr) override
+        {
+            (void)buffer;
+            (void)numSamples;
+            (void)numChannels;
+            (void)timestamps;
+            throw std::runtime_error("SpatialFilter changes the stream size and must be run through processResizing()");
+        }
+
+        bool isResizing() const override { return true; }
+
+        size_t maxOutputSize(size_t numSamples, int numChannels) const override
+        {
+            return numChannels > 0 ? numSamples / static_cast<size_t>(numChannels) * m_filter.getOutputChannels() : 0;
+        }
+
+        int outputChannels(int numChannels) const override
+        {
+            (void)numChannels;
+            return static_cast<int>(m_filter.getOutputChannels());
+        }
+
+        void prepare(size_t /*maxBlockSize*/, int numChannels, double /*sampleRate*/) override
+        {
+            // Nothing is allocated lazily; report a montage/stream mismatch up front
+            checkChannels(numChannels);
+        }
+
+        size_t processResizing(const float *input, size_t numSamples, int numChannels, const float *timestamps,
+                               float *output, float *outputTimestamps, int &outputChannels) override
+        {
+            checkChannels(numChannels);
+            if (numSamples % static_cast<size_t>(numChannels) != 0)
+            {
+                throw std::invalid_argument("SpatialFilter: sample count must be a multiple of the channel count");
+            }
+
+            const size_t numFrames = numSamples / static_cast<size_t>(numChannels);
+            const size_t outChannels = m_filter.getOutputChannels();
+            m_filter.process(input, numFrames, output);
+            if (timestamps != nullptr)
+            {
+                for (size_t f = 0; f < numFrames; ++f)
+                {
+                    std::fill(outputTimestamps + f * outChannels, outputTimestamps + (f + 1) * outChannels,
+                              timestamps[f * numChannels]);
+                }
+            }
+
+            outputChannels = static_cast<int>(outChannels);
+            return numFrames * outChannels;
+        }
+
+        StageDescription describe() const override
+        {
+            StageDescription description;
+            description.mode = m_mode;
+            description.numChannels = m_filter.getInputChannels();
+            return description;
+        }
+
+        void reset() override
+        {
+            // Stateless: every frame is mixed on its own
+        }
+
+        Napi::Object serializeState(Napi::Env env) const override
+        {
+            Napi::Object state = Napi::Object::New(env);
+            state.Set("mode", m_mode);
+            state.Set("inputChannels", static_cast<uint32_t>(m_filter.getInputChannels()));
+            state.Set("outputChannels", static_cast<uint32_t>(m_filter.getOutputChannels()));
+            state.Set("weights", dsp::utils::VectorToNapiArray(env, m_filter.getWeights()));
+            return state;
+        }
+
+        void deserializeState(const Napi::Object &state) override
+        {
+            checkParameters(state.Get("inputChannels").As<Napi::Number>().Uint32Value(),
+                            state.Get("outputChannels").As<Napi::Number>().Uint32Value(),
+                            dsp::utils::NapiArrayToVector<float>(state.Get("weights").As<Napi::Array>()));
+        }
+
+        bool serializeBinary(dsp::utils::BinaryWriter &writer) const override
+        {
+            writer.writeString(m_mode);
+            writer.writeU32(static_cast<uint32_t>(m_filter.getInputChannels()));
+            writer.writeU32(static_cast<uint32_t>(m_filter.getOutputChannels()));
+            writer.writeArray(m_filter.getWeights());
+            return true;
+        }
+
+        void deserializeBinary(dsp::utils::BinaryReader &reader) override
+        {
+            reader.readString();
+            size_t inputChannels = reader.readU32();
+            size_t outputChannels = reader.readU32();
+            checkParameters(inputChannels, outputChannels, reader.readArray<float>());
+        }
+
+    private:
+        void checkChannels(int numChannels) const
+        {
+            if (numChannels <= 0 || static_cast<size_t>(numChannels) != m_filter.getInputChannels())
+            {
+                throw std::invalid_argument("SpatialFilter: expected " + std::to_string(m_filter.getInputChannels()) +
+                                            " input channels, got " + std::to_string(numChannels));
+            }
+        }
+
+        // The matrix is the whole configuration, so a snapshot only has to match it
+        void checkParameters(size_t inputChannels, size_t outputChannels, const std::vector<float> &weights) const
+        {
+            if (inputChannels != m_filter.getInputChannels() || outputChannels != m_filter.getOutputChannels() ||
+                weights != m_filter.getWeights())
+            {
+                throw std::runtime_error("SpatialFilter parameter mismatch during deserialization");
+            }
+        }
+
+        std::string m_mode;
+        dsp::core::SpatialFilter m_filter;
+    };
+
+} // namespace dsp::adapters
@@ -41,6 +41,30 @@ namespace dsp::adapters
             }
         }
 
+        void prepare(size_t /*maxBlockSize*/, int numChannels, double /*sampleRate*/) override
+        {
+            if (numChannels > 0 && m_filters.size() != static_cast<size_t>(numChannels))
+            {
+                m_filters.clear();
+                for (int i = 0; i < numChannels; ++i)
+                {
+                    m_filters.emplace_back(m_window_size, m_threshold);
+                }
+            }
+        }
+
+        StageDescription describe() const override
+        {
+            StageDescription description;
+            description.windowSize = m_window_size;
+            description.numChannels = m_filters.size();
+            if (!m_filters.empty())
+            {
+                description.bufferSize = m_filters[0].getInternalFilter().getCount();
+            }
+            return description;
+        }
+
         void reset() override
         {
             for (auto &filter : m_filters)
@@ -112,6 +136,58 @@ namespace dsp::adapters
             }
         }
 
+        bool serializeBinary(dsp::utils::BinaryWriter &writer) const override
+        {
+            writer.writeU32(static_cast<uint32_t>(m_window_size));
+            writer.writeF32(m_threshold);
+            writer.writeU32(static_cast<uint32_t>(m_filters.size()));
+            for (const auto &filter : m_filters)
+            {
+                auto [internalState, filterState] = filter.getState();
+                writer.writeBoolArray(internalState.first);
+                writer.writeU32(static_cast<uint32_t>(internalState.second));
+                writer.writeF32(filterState.sample_minus_1);
+                writer.writeF32(filterState.sample_minus_2);
+                writer.writeI32(filterState.init_count);
+            }
+            return true;
+        }
+
+        void deserializeBinary(dsp::utils::BinaryReader &reader) override
+        {
+            size_t windowSize = reader.readU32();
+            float threshold = reader.readF32();
+            if (windowSize != m_window_size || threshold != m_threshold)
+            {
+                throw std::runtime_error("SSC parameter mismatch during deserialization");
+            }
+
+            uint32_t numChannels = reader.readU32();
+            m_filters.clear();
+            for (uint32_t i = 0; i < numChannels; ++i)
+            {
+                m_filters.emplace_back(m_window_size, m_threshold);
+            }
+
+            for (uint32_t i = 0; i < numChannels; ++i)
+            {
+                std::vector<bool> bufferData = reader.readBoolArray();
+                size_t runningCount = reader.readU32();
+
+                dsp::core::SscFilter<float>::SscFilterState filterState;
+                filterState.sample_minus_1 = reader.readF32();
+                filterState.sample_minus_2 = reader.readF32();
+                filterState.init_count = reader.readI32();
+
+                if (!dsp::core::CounterPolicy::validateState(runningCount, bufferData))
+                {
+                    throw std::runtime_error("SSC running count validation failed");
+                }
+
+                m_filters[i].setState(bufferData, runningCount, filterState);
+            }
+        }
+
     private:
         size_t m_window_size;
         float m_threshold;
@@ -2,6 +2,8 @@
 
 #include "../IDspStage.h"
 #include "../core/MovingVarianceFilter.h"
+#include "../utils/MultiChannelSlidingWindow.h"
+#include <memory>
 #include <vector>
 #include <string>
 #include <stdexcept>
@@ -57,6 +59,37 @@ namespace dsp::adapters
             }
         }
 
+        // Create the channels and reserve block scratch ahead of the first process()
+        void prepare(size_t maxBlockSize, int numChannels, double sampleRate) override
+        {
+            if (m_mode != VarianceMode::Moving || numChannels <= 0)
+            {
+                return;
+            }
+
+            // Same window estimate processMoving() derives from the first timestamps
+            if (!m_is_initialized && m_window_duration_ms > 0.0)
+            {
+                if (sampleRate <= 0.0)
+                {
+                    throw std::invalid_argument("Variance: prepare() needs a sample rate to size a windowDuration window");
+                }
+                size_t estimated_size = static_cast<size_t>((m_window_duration_ms / 1000.0) * sampleRate);
+                m_window_size = std::max(size_t(1), estimated_size * 3);
+                m_is_initialized = true;
+            }
+
+            // The pipeline always passes timestamps, so duration windows are time-aware
+            if (channelCount() != static_cast<size_t>(numChannels))
+            {
+                createChannels(numChannels, m_window_duration_ms > 0.0);
+            }
+            for (auto &filter : m_filters)
+            {
+                filter.reserve(maxBlockSize);
+            }
+        }
+
         // Serialize the stage's state
         Napi::Object serializeState(Napi::Env env) const override
         {
@@ -67,16 +100,16 @@ namespace dsp::adapters
             if (m_mode == VarianceMode::Moving)
             {
                 state.Set("windowSize", static_cast<uint32_t>(m_window_size));
-                state.Set("numChannels", static_cast<uint32_t>(m_filters.size()));
+                state.Set("numChannels", static_cast<uint32_t>(channelCount()));
 
                 // Serialize each channel's filter state
-                Napi::Array channelsArray = Napi::Array::New(env, m_filters.size());
-                for (size_t i = 0; i < m_filters.size(); ++i)
+                Napi::Array channelsArray = Napi::Array::New(env, channelCount());
+                for (size_t i = 0; i < channelCount(); ++i)
                 {
                     Napi::Object channelState = Napi::Object::New(env);
 
                     // Get the filter's internal state
-                    auto [bufferData, sums] = m_filters[i].getState();
+                    auto [bufferData, sums] = getChannelState(i);
                     auto [runningSum, runningSumOfSquares] = sums;
 
                     // Convert buffer data to JavaScript array
@@ -122,11 +155,7 @@ namespace dsp::adapters
                 uint32_t numChannels = state.Get("channels").As<Napi::Array>().Length();
 
                 // Recreate filters
-                m_filters.clear();
-                for (uint32_t i = 0; i < numChannels; ++i)
-                {
-                    m_filters.emplace_back(m_window_size);
-                }
+                createChannels(numChannels, false);
 
                 // Restore each channel's state
                 Napi::Array channelsArray = state.Get("channels").As<Napi::Array>();
@@ -147,43 +176,142 @@ namespace dsp::adapters
                     float runningSum = channelState.Get("runningSum").As<Napi::Number>().FloatValue();
                     float runningSumOfSquares = channelState.Get("runningSumOfSquares").As<Napi::Number>().FloatValue();
 
-                    // --- Validation (similar to RmsStage and MovingAverageStage) ---
-                    float actualSum = 0.0f;
-                    float actualSumOfSquares = 0.0f;
-                    for (const auto &val : bufferData)
-                    {
-                        actualSum += val;
-                        actualSumOfSquares += val * val;
-                    }
+                    restoreChannel(i, bufferData, runningSum, runningSumOfSquares);
+                }
+            }
+        }
 
-                    const float toleranceSum = 0.0001f * std::max(1.0f, std::abs(actualSum));
-                    if (std::abs(runningSum - actualSum) > toleranceSum)
-                    {
-                        throw std::runtime_error(
-                            "Running sum validation failed: expected " +
-                            std::to_string(actualSum) + " but got " +
-                            std::to_string(runningSum));
-                    }
+        // Write the stage's state as a binary snapshot section
+        bool serializeBinary(dsp::utils::BinaryWriter &writer) const override
+        {
+            writer.writeU8(static_cast<uint8_t>(m_mode));
+            if (m_mode == VarianceMode::Moving)
+            {
+                writer.writeU32(static_cast<uint32_t>(m_window_size));
+                writer.writeU32(static_cast<uint32_t>(channelCount()));
+                for (size_t i = 0; i < channelCount(); ++i)
+                {
+                    auto [bufferData, sums] = getChannelState(i);
+                    writer.writeArray(bufferData);
+                    writer.writeF32(sums.first);
+                    writer.writeF32(sums.second);
+                }
+            }
+            return true;
+        }
 
-                    const float toleranceSq = 0.0001f * std::max(1.0f, std::abs(actualSumOfSquares));
-                    if (std::abs(runningSumOfSquares - actualSumOfSquares) > toleranceSq)
-                    {
-                        throw std::runtime_error(
-                            "Running sum of squares validation failed: expected " +
-                            std::to_string(actualSumOfSquares) + " but got " +
-                            std::to_string(runningSumOfSquares));
-                    }
-                    // --- End Validation ---
+        // Restore the stage's state from a binary snapshot section
+        void deserializeBinary(dsp::utils::BinaryReader &reader) override
+        {
+            if (static_cast<VarianceMode>(reader.readU8()) != m_mode)
+            {
+                throw std::runtime_error("Variance mode mismatch during deserialization");
+            }
 
-                    // Restore the filter's state
-                    m_filters[i].setState(bufferData, runningSum, runningSumOfSquares);
+            if (m_mode == VarianceMode::Moving)
+            {
+                size_t windowSize = reader.readU32();
+                if (windowSize != m_window_size)
+                {
+                    throw std::runtime_error("Window size mismatch during deserialization");
+                }
+
+                uint32_t numChannels = reader.readU32();
+                createChannels(numChannels, false);
+
+                for (uint32_t i = 0; i < numChannels; ++i)
+                {
+                    std::vector<float> bufferData = reader.readArray<float>();
+                    float runningSum = reader.readF32();
+                    float runningSumOfSquares = reader.readF32();
+                    restoreChannel(i, bufferData, runningSum, runningSumOfSquares);
                 }
             }
         }
 
+        std::vector<dsp::utils::WindowMark> windowMarks() const override
+        {
+            return m_lockstep ? m_lockstep->windowMarks() : dsp::utils::collectWindowMarks(m_filters);
+        }
+
+        // Write only the samples pushed since the given marks, plus the running sums
+        bool serializeBinaryDelta(dsp::utils::BinaryWriter &writer,
+                                  const std::vector<dsp::utils::WindowMark> &since) const override
+        {
+            std::vector<uint64_t> pushed;
+            if (m_mode != VarianceMode::Moving || !dsp::utils::pushedSinceMarks(windowMarks(), since, pushed))
+            {
+                return false;
+            }
+
+            writer.writeU32(static_cast<uint32_t>(channelCount()));
+            for (size_t i = 0; i < channelCount(); ++i)
+            {
+                auto [bufferData, sums] = getChannelState(i);
+                dsp::utils::writeWindowTail(writer, bufferData, pushed[i]);
+                writer.writeF32(sums.first);
+                writer.writeF32(sums.second);
+            }
+            return true;
+        }
+
+        // Apply a delta section on top of the state it was taken against
+        void deserializeBinaryDelta(dsp::utils::BinaryReader &reader) override
+        {
+            if (reader.readU32() != channelCount())
+            {
+                throw std::runtime_error("Channel count mismatch in delta snapshot");
+            }
+
+            // Read every channel before restoring any (lock-step windows
+            // are rewritten from channel 0 on)
+            std::vector<ChannelState> states;
+            for (size_t i = 0; i < channelCount(); ++i)
+            {
+                auto [bufferData, sums] = getChannelState(i);
+                dsp::utils::applyWindowTail(reader, bufferData);
+                sums.first = reader.readF32();
+                sums.second = reader.readF32();
+                states.emplace_back(std::move(bufferData), sums);
+            }
+            for (size_t i = 0; i < states.size(); ++i)
+            {
+                restoreChannel(i, states[i].first, states[i].second.first, states[i].second.second);
+            }
+        }
+
+        // Report configuration and occupancy without copying the windows
+        StageDescription describe() const override
+        {
+            StageDescription description;
+            description.mode = (m_mode == VarianceMode::Moving) ? "moving" : "batch";
+            if (m_mode == VarianceMode::Moving)
+            {
+                description.windowSize = m_window_size;
+                if (m_window_duration_ms > 0.0)
+                {
+                    description.windowDurationMs = m_window_duration_ms;
+                }
+                description.numChannels = channelCount();
+                if (m_lockstep)
+                {
+                    description.bufferSize = m_lockstep->getCount();
+                }
+                else if (!m_filters.empty())
+                {
+                    description.bufferSize = m_filters[0].getCount();
+                }
+            }
+            return description;
+        }
+
         // Reset all filters to initial state
         void reset() override
         {
+            if (m_lockstep)
+            {
+                m_lockstep->clear();
+            }
             for (auto &filter : m_filters)
             {
                 filter.clear();
@@ -191,6 +319,97 @@ namespace dsp::adapters
         }
 
     private:
+        using ChannelState = std::pair<std::vector<float>, std::pair<float, float>>;
+
+        size_t channelCount() const
+        {
+            return m_lockstep ? m_lockstep->getNumChannels() : m_filters.size();
+        }
+
+        /**
+         * @brief A channel's window contents and running sums.
+         */
+        ChannelState getChannelState(size_t channel) const
+        {
+            if (m_lockstep)
+            {
+                return {m_lockstep->getChannelWindow(channel), {m_lockstep->getSum(channel), m_lockstep->getSumOfSquares(channel)}};
+            }
+            return m_filters[channel].getState();
+        }
+
+        /**
+         * @brief Recreates the per-channel state: lock-step windows for
+         * sample-count mode with enough channels, one filter per channel otherwise.
+         */
+        void createChannels(size_t numChannels, bool timeAware)
+        {
+            m_filters.clear();
+            m_lockstep.reset();
+            if (!timeAware && numChannels >= dsp::utils::MultiChannelSlidingWindow::kMinChannels)
+            {
+                m_lockstep = std::make_unique<dsp::utils::MultiChannelSlidingWindow>(
+                    m_window_size, numChannels, dsp::simd::WindowStatistic::Variance);
+                return;
+            }
+
+            for (size_t i = 0; i < numChannels; ++i)
+            {
+                if (timeAware)
+                {
+                    // Create time-aware filter
+                    m_filters.emplace_back(m_window_size, m_window_duration_ms);
+                }
+                else
+                {
+                    // Create regular filter
+                    m_filters.emplace_back(m_window_size);
+                }
+            }
+        }
+
+        /**
+         * @brief Validates a channel's running sums against its buffer and restores it.
+         */
+        void restoreChannel(size_t channel, const std::vector<float> &bufferData, float runningSum, float runningSumOfSquares)
+        {
+            float actualSum = 0.0f;
+            float actualSumOfSquares = 0.0f;
+            for (const auto &val : bufferData)
+            {
+                actualSum += val;
+                actualSumOfSquares += val * val;
+            }
+
+            const float toleranceSum = 0.0001f * std::max(1.0f, std::abs(actualSum));
+            if (std::abs(runningSum - actualSum) > toleranceSum)
+            {
+                throw std::runtime_error(
+                    "Running sum validation failed: expected " +
+                    std::to_string(actualSum) + " but got " +
+                    std::to_string(runningSum));
+            }
+
+            const float toleranceSq = 0.0001f * std::max(1.0f, std::abs(actualSumOfSquares));
+            if (std::abs(runningSumOfSquares - actualSumOfSquares) > toleranceSq)
+            {
+                throw std::runtime_error(
+                    "Running sum of squares validation failed: expected " +
+                    std::to_string(actualSumOfSquares) + " but got " +
+                    std::to_string(runningSumOfSquares));
+            }
+
+            // Restore the filter's state
+            if (m_lockstep)
+            {
+                m_lockstep->setChannelState(channel, bufferData, runningSum, runningSumOfSquares);
+            }
+            else
+            {
+                m_filters[channel].setState(bufferData, runningSum, runningSumOfSquares);
+            }
+        }
+
         /**
          * @brief Statelessly calculates the variance for each channel
          * and overwrites all samples in that channel with the result.
@@ -259,40 +478,36 @@ namespace dsp::adapters
             }
 
             // Lazily initialize our filters, one for each channel
-            if (m_filters.size() != static_cast<size_t>(numChannels))
+            if (channelCount() != static_cast<size_t>(numChannels))
+            {
+                createChannels(numChannels, useTimeAware);
+            }
+
+            if (m_lockstep)
             {
-                m_filters.clear();
-                for (int i = 0; i < numChannels; ++i)
+                // Whole frames, all channels at once (no de-interleaving)
+                m_lockstep->process(buffer, numSamples / numChannels);
+                return;
+            }
+
+            if (!useTimeAware)
+            {
+                // Each channel's samples as one strided chunk, so long chunks
+                // are evaluated block-wise from prefix sums
+                for (size_t channel = 0; channel < static_cast<size_t>(numChannels) && channel < numSamples; ++channel)
                 {
-                    if (useTimeAware)
-                    {
-                        // Create time-aware filter
-                        m_filters.emplace_back(m_window_size, m_window_duration_ms);
-                    }
-                    else
-                    {
-                        // Create regular filter
-                        m_filters.emplace_back(m_window_size);
-                    }
+                    size_t count = (numSamples - channel + numChannels - 1) / numChannels;
+                    m_filters[channel].addSamples(buffer + channel, count, numChannels);
                 }
+                return;
             }
 
-            // Process the buffer sample by sample, de-interleaving
+            // Time-aware: process the buffer sample by sample, de-interleaving
             for (size_t i = 0; i < numSamples; ++i)
             {
                 int channel = i % numChannels;
                 size_t sample_index = i / numChannels;
-
-                if (useTimeAware)
-                {
-                    // Use time-aware processing
-                    buffer[i] = m_filters[channel].addSampleWithTimestamp(buffer[i], timestamps[sample_index]);
-                }
-                else
-                {
-                    // Use sample-count processing
-                    buffer[i] = m_filters[channel].addSample(buffer[i]);
-                }
+                buffer[i] = m_filters[channel].addSampleWithTimestamp(buffer[i], timestamps[sample_index]);
             }
         }
 
@@ -300,8 +515,10 @@ namespace dsp::adapters
         size_t m_window_size;
         double m_window_duration_ms;
         bool m_is_initialized;
-        // We need a separate filter instance for each channel's state
+        // We need a separate filter instance for each channel's state,
+        // or lock-step windows for all of them (see createChannels())
         std::vector<dsp::core::MovingVarianceFilter<float>> m_filters;
+        std::unique_ptr<dsp::utils::MultiChannelSlidingWindow> m_lockstep;
     };
 
 } // namespace dsp::adapters
\ No newline at end of file
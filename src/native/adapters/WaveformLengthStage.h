@@ -40,6 +40,30 @@ namespace dsp::adapters
             }
         }
 
+        void prepare(size_t /*maxBlockSize*/, int numChannels, double /*sampleRate*/) override
+        {
+            if (numChannels > 0 && m_filters.size() != static_cast<size_t>(numChannels))
+            {
+                m_filters.clear();
+                for (int i = 0; i < numChannels; ++i)
+                {
+                    m_filters.emplace_back(m_window_size);
+                }
+            }
+        }
+
+        StageDescription describe() const override
+        {
+            StageDescription description;
+            description.windowSize = m_window_size;
+            description.numChannels = m_filters.size();
+            if (!m_filters.empty())
+            {
+                description.bufferSize = m_filters[0].getCount();
+            }
+            return description;
+        }
+
         void reset() override
         {
             for (auto &filter : m_filters)
@@ -107,6 +131,100 @@ namespace dsp::adapters
             }
         }
 
+        bool serializeBinary(dsp::utils::BinaryWriter &writer) const override
+        {
+            writer.writeU32(static_cast<uint32_t>(m_window_size));
+            writer.writeU32(static_cast<uint32_t>(m_filters.size()));
+            for (const auto &filter : m_filters)
+            {
+                auto state = filter.getState();
+                writer.writeArray(state.first.first);
+                writer.writeF64(state.first.second);
+                writer.writeF32(state.second);
+            }
+            return true;
+        }
+
+        void deserializeBinary(dsp::utils::BinaryReader &reader) override
+        {
+            size_t windowSize = reader.readU32();
+            if (windowSize != m_window_size)
+            {
+                throw std::runtime_error("Window size mismatch during deserialization");
+            }
+
+            uint32_t numChannels = reader.readU32();
+            m_filters.clear();
+            for (uint32_t i = 0; i < numChannels; ++i)
+            {
+                m_filters.emplace_back(m_window_size);
+            }
+
+            for (uint32_t i = 0; i < numChannels; ++i)
+            {
+                std::vector<float> bufferData = reader.readArray<float>();
+                double runningSum = reader.readF64();
+                float prevSample = reader.readF32();
+
+                if (!dsp::core::SumPolicy<float>::validateState(runningSum, bufferData))
+                {
+                    throw std::runtime_error("WaveformLength running sum validation failed");
+                }
+
+                m_filters[i].setState(bufferData, runningSum, prevSample);
+            }
+        }
+
+        std::vector<dsp::utils::WindowMark> windowMarks() const override
+        {
+            return dsp::utils::collectWindowMarks(m_filters);
+        }
+
+        // Write only the samples pushed since the given marks, plus the running sums
+        bool serializeBinaryDelta(dsp::utils::BinaryWriter &writer,
+                                  const std::vector<dsp::utils::WindowMark> &since) const override
+        {
+            std::vector<uint64_t> pushed;
+            if (!dsp::utils::pushedSinceMarks(m_filters, since, pushed))
+            {
+                return false;
+            }
+
+            writer.writeU32(static_cast<uint32_t>(m_filters.size()));
+            for (size_t i = 0; i < m_filters.size(); ++i)
+            {
+                auto [window, prevSample] = m_filters[i].getState();
+                dsp::utils::writeWindowTail(writer, window.first, pushed[i]);
+                writer.writeF64(window.second);
+                writer.writeF32(prevSample);
+            }
+            return true;
+        }
+
+        // Apply a delta section on top of the state it was taken against
+        void deserializeBinaryDelta(dsp::utils::BinaryReader &reader) override
+        {
+            if (reader.readU32() != m_filters.size())
+            {
+                throw std::runtime_error("Channel count mismatch in delta snapshot");
+            }
+
+            for (size_t i = 0; i < m_filters.size(); ++i)
+            {
+                auto [window, prevSample] = m_filters[i].getState();
+                dsp::utils::applyWindowTail(reader, window.first);
+                window.second = reader.readF64();
+                prevSample = reader.readF32();
+
+                if (!dsp::core::SumPolicy<float>::validateState(window.second, window.first))
+                {
+                    throw std::runtime_error("WaveformLength running sum validation failed");
+                }
+
+                m_filters[i].setState(window.first, window.second, prevSample);
+            }
+        }
+
     private:
         size_t m_window_size;
         std::vector<dsp::core::WaveformLengthFilter<float>> m_filters;
@@ -0,0 +1,259 @@
+#pragma once
+
+#include "../IDspStage.h"
+#include "../core/WaveletTransform.h"
+#include "../utils/NapiUtils.h"
+#include <memory>
+#include <string>
+#include <stdexcept>
+#include <vector>
+
+namespace dsp::adapters
+{
+    /**
+     * @brief Streaming multi-level discrete wavelet transform (see core::WaveletTransform).
+     *
+     * In "decompose" mode this is a resizing stage: every 2^levels input
+     * frames become one frame of numChannels * 2^levels coefficients,
+     * [channel][coefficient] in Mallat order (a_J, d_J, ..., d_1). In
+     * "denoise" mode the detail coefficients are thresholded and the signal
+     * is reconstructed in place, delayed by the transform's latency.
+     */
+    class WaveletTransformStage : public IDspStage
+    {
+    public:
+        explicit WaveletTransformStage(const dsp::core::WaveletOptions &options) : m_options(options)
+        {
+            // Validates the wavelet, depth and thresholds up front
+            dsp::core::WaveletTransform(1, options);
+        }
+
+        const char *getType() const override { return "waveletTransform"; }
+
+        void process(float *buffer, size_t numSamples, int numChannels, const float *timestamps = nullptr) override
+        {
+            (void)timestamps;
+            if (m_options.mode != dsp::core::WaveletMode::Denoise)
+            {
+                throw std::runtime_error(
+                    "WaveletTransform changes the stream size and must be run through processResizing()");
+            }
+            checkSamples(numSamples, numChannels);
+            ensureChannels(numChannels);
+            m_transform->denoise(buffer, numSamples / static_cast<size_t>(numChannels));
+        }
+
+        bool isResizing() const override { return m_options.mode == dsp::core::WaveletMode::Decompose; }
+
+        size_t maxOutputSize(size_t numSamples, int numChannels) const override
+        {
+            if (numChannels <= 0)
+            {
+                return 0;
+            }
+            // At most one frame per block whatever the phase, so a prepared
+            // pipeline can size its output buffers once
+            const size_t channels = static_cast<size_t>(numChannels);
+            const size_t numFrames = numSamples / channels;
+            const size_t blockSize = blockSizeFor(m_options.levels);
+            const size_t frames = numFrames == 0 ? 0 : 1 + (numFrames - 1) / blockSize;
+            return frames * channels * blockSize;
+        }
+
+        int outputChannels(int numChannels) const override
+        {
+            return isResizing() ? numChannels * static_cast<int>(blockSizeFor(m_options.levels)) : numChannels;
+        }
+
+        size_t processResizing(const float *input, size_t numSamples, int numChannels, const float *timestamps,
+                               float *output, float *outputTimestamps, int &outputChannels) override
+        {
+            checkSamples(numSamples, numChannels);
+            ensureChannels(numChannels);
+
+            const size_t channels = static_cast<size_t>(numChannels);
+            const size_t blockSize = m_transform->getBlockSize();
+            outputChannels = static_cast<int>(channels * blockSize);
+            const size_t frames = m_transform->decompose(input, numSamples / channels, timestamps,
+                                                         output, outputTimestamps);
+            return frames * channels * blockSize;
+        }
+
+        // Build the transform and size its buffers ahead of the first chunk
+        void prepare(size_t maxBlockSize, int numChannels, double /*sampleRate*/) override
+        {
+            ensureChannels(numChannels);
+            if (m_transform)
+            {
+                m_transform->reserve(maxBlockSize);
+            }
+        }
+
+        StageDescription describe() const override
+        {
+            StageDescription description;
+            description.mode = dsp::core::waveletModeName(m_options.mode);
+            description.windowSize = blockSizeFor(m_options.levels);
+            description.numChannels = m_transform ? m_transform->getChannels() : 0;
+            return description;
+        }
+
+        void reset() override
+        {
+            if (m_transform)
+            {
+                m_transform->reset();
+            }
+        }
+
+        Napi::Object serializeState(Napi::Env env) const override
+        {
+            Napi::Object state = Napi::Object::New(env);
+            state.Set("wavelet", dsp::core::waveletName(m_options.order));
+            state.Set("levels", static_cast<uint32_t>(m_options.levels));
+            state.Set("mode", dsp::core::waveletModeName(m_options.mode));
+            state.Set("thresholdMode", dsp::core::waveletThresholdName(m_options.thresholdMode));
+            state.Set("thresholds", dsp::utils::VectorToNapiArray(env, m_options.thresholds));
+
+            const dsp::core::WaveletState transformState =
+                m_transform ? m_transform->getState() : dsp::core::WaveletState();
+            state.Set("numChannels", static_cast<uint32_t>(m_transform ? m_transform->getChannels() : 0));
+            state.Set("framesUntilOutput", static_cast<uint32_t>(transformState.framesUntilOutput));
+
+            Napi::Array levels = Napi::Array::New(env, transformState.levels.size());
+            for (size_t i = 0; i < transformState.levels.size(); ++i)
+            {
+                const dsp::core::WaveletLevelState &level = transformState.levels[i];
+                Napi::Object levelState = Napi::Object::New(env);
+                levelState.Set("input", dsp::utils::VectorToNapiArray(env, level.input));
+                levelState.Set("details", dsp::utils::VectorToNapiArray(env, level.details));
+                levelState.Set("approximation", dsp::utils::VectorToNapiArray(env, level.approximation));
+                levels.Set(static_cast<uint32_t>(i), levelState);
+            }
+            state.Set("levelStates", levels);
+            state.Set("output", dsp::utils::VectorToNapiArray(env, transformState.output));
+            return state;
+        }
+
+        void deserializeState(const Napi::Object &state) override
+        {
+            dsp::core::WaveletOptions options;
+            options.levels = state.Get("levels").As<Napi::Number>().Uint32Value();
+            options.thresholds = dsp::utils::NapiArrayToVector<float>(state.Get("thresholds").As<Napi::Array>());
+            checkParameters(state.Get("wavelet").As<Napi::String>().Utf8Value(), options.levels,
+                            state.Get("mode").As<Napi::String>().Utf8Value(),
+                            state.Get("thresholdMode").As<Napi::String>().Utf8Value(), options.thresholds);
+
+            dsp::core::WaveletState transformState;
+            transformState.framesUntilOutput = state.Get("framesUntilOutput").As<Napi::Number>().Uint32Value();
+            Napi::Array levels = state.Get("levelStates").As<Napi::Array>();
+            for (uint32_t i = 0; i < levels.Length(); ++i)
+            {
+                Napi::Object levelState = levels.Get(i).As<Napi::Object>();
+                dsp::core::WaveletLevelState level;
+                level.input = dsp::utils::NapiArrayToVector<float>(levelState.Get("input").As<Napi::Array>());
+                level.details = dsp::utils::NapiArrayToVector<float>(levelState.Get("details").As<Napi::Array>());
+                level.approximation =
+                    dsp::utils::NapiArrayToVector<float>(levelState.Get("approximation").As<Napi::Array>());
+                transformState.levels.push_back(std::move(level));
+            }
+            transformState.output = dsp::utils::NapiArrayToVector<float>(state.Get("output").As<Napi::Array>());
+            restore(state.Get("numChannels").As<Napi::Number>().Uint32Value(), transformState);
+        }
+
+        bool serializeBinary(dsp::utils::BinaryWriter &writer) const override
+        {
+            writer.writeString(dsp::core::waveletName(m_options.order));
+            writer.writeU32(static_cast<uint32_t>(m_options.levels));
+            writer.writeString(dsp::core::waveletModeName(m_options.mode));
+            writer.writeString(dsp::core::waveletThresholdName(m_options.thresholdMode));
+            writer.writeArray(m_options.thresholds);
+
+            const dsp::core::WaveletState transformState =
+                m_transform ? m_transform->getState() : dsp::core::WaveletState();
+            writer.writeU32(static_cast<uint32_t>(m_transform ? m_transform->getChannels() : 0));
+            writer.writeU32(static_cast<uint32_t>(transformState.framesUntilOutput));
+            writer.writeU32(static_cast<uint32_t>(transformState.levels.size()));
+            for (const auto &level : transformState.levels)
+            {
+                writer.writeArray(level.input);
+                writer.writeArray(level.details);
+                writer.writeArray(level.approximation);
+            }
+            writer.writeArray(transformState.output);
+            return true;
+        }
+
+        void deserializeBinary(dsp::utils::BinaryReader &reader) override
+        {
+            std::string wavelet = reader.readString();
+            size_t levels = reader.readU32();
+            std::string mode = reader.readString();
+            std::string thresholdMode = reader.readString();
+            std::vector<float> thresholds = reader.readArray<float>();
+            checkParameters(wavelet, levels, mode, thresholdMode, thresholds);
+
+            uint32_t numChannels = reader.readU32();
+            dsp::core::WaveletState transformState;
+            transformState.framesUntilOutput = reader.readU32();
+            uint32_t numLevels = reader.readU32();
+            for (uint32_t i = 0; i < numLevels; ++i)
+            {
+                dsp::core::WaveletLevelState level;
+                level.input = reader.readArray<float>();
+                level.details = reader.readArray<float>();
+                level.approximation = reader.readArray<float>();
+                transformState.levels.push_back(std::move(level));
+            }
+            transformState.output = reader.readArray<float>();
+            restore(numChannels, transformState);
+        }
+
+    private:
+        static size_t blockSizeFor(size_t levels) { return size_t{1} << levels; }
+
+        static void checkSamples(size_t numSamples, int numChannels)
+        {
+            if (numChannels <= 0 || numSamples % static_cast<size_t>(numChannels) != 0)
+            {
+                throw std::invalid_argument("WaveletTransform: sample count must be a multiple of the channel count");
+            }
+        }
+
+        void ensureChannels(int numChannels)
+        {
+            if (numChannels > 0 && (!m_transform || m_transform->getChannels() != static_cast<size_t>(numChannels)))
+            {
+                m_transform = std::make_unique<dsp::core::WaveletTransform>(static_cast<size_t>(numChannels),
+                                                                            m_options);
+            }
+        }
+
+        void restore(uint32_t numChannels, const dsp::core::WaveletState &state)
+        {
+            if (numChannels == 0)
+            {
+                m_transform.reset();
+                return;
+            }
+            ensureChannels(static_cast<int>(numChannels));
+            m_transform->setState(state);
+        }
+
+        void checkParameters(const std::string &wavelet, size_t levels, const std::string &mode,
+                             const std::string &thresholdMode, const std::vector<float> &thresholds) const
+        {
+            if (wavelet != dsp::core::waveletName(m_options.order) || levels != m_options.levels ||
+                mode != dsp::core::waveletModeName(m_options.mode) ||
+                thresholdMode != dsp::core::waveletThresholdName(m_options.thresholdMode) ||
+                thresholds != m_options.thresholds)
+            {
+                throw std::runtime_error("WaveletTransform parameter mismatch during deserialization");
+            }
+        }
+
+        dsp::core::WaveletOptions m_options;
+        std::unique_ptr<dsp::core::WaveletTransform> m_transform;
+    };
+
+} // namespace dsp::adapters
@@ -0,0 +1,981 @@
+/**
+ * @file NativeBenchmark.cc
+ * @brief Standalone micro-benchmarks for the native core, without N-API.
+ *
+ * Times every core filter (per sample, chunked and fused in a StaticPipeline),
+ * the LMS / NLMS / RLS adaptive filters, sliding-window policy, SimdOps
+ * kernel, FFT size, spatial filter layout, streaming PCA mode, Kalman
+ * filter bank form and wavelet transform over a grid of channel counts and window sizes, and prints one JSON document so results
+ * can be stored per commit and diffed between machines
+ * (see scripts/compare-bench.js).
+ *
+ * Build and run: npm run bench:native -- [options]
+ *   --filter <text>   only run benchmarks whose "group/name" contains text
+ *   --min-time <ms>   measuring time per benchmark (default 100)
+ *   --label <text>    free-form tag stored in the output, e.g. a commit id
+ *   --output <file>   write the JSON there instead of stdout
+ *   --quick           smaller parameter grid
+ *   --simd <level>    run the SimdOps/FFT kernels at another supported level
+ *                     (scalar, sse2, avx2, avx512, neon) instead of the best one
+ */
+
+#include "core/FftEngine.h"
+#include "core/FirFilter.h"
+#include "core/IirFilter.h"
+#include "core/KalmanFilter.h"
+#include "core/LmsFilter.h"
+#include "core/MovingAbsoluteValueFilter.h"
+#include "core/MovingAverageFilter.h"
+#include "core/MovingPercentileFilter.h"
+#include "core/MovingVarianceFilter.h"
+#include "core/MovingZScoreFilter.h"
+#include "core/Policies.h"
+#include "core/RlsFilter.h"
+#include "core/RmsFilter.h"
+#include "core/SpatialFilter.h"
+#include "core/WaveletTransform.h"
+#include "core/StaticPipeline.h"
+#include "core/SscFilter.h"
+#include "core/StreamingPca.h"
+#include "core/WampFilter.h"
+#include "core/WaveformLengthFilter.h"
+#include "utils/SimdOps.h"
+#include "utils/SlidingWindowFilter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct Options
+    {
+        std::string filter;
+        std::string label;
+        std::string output;
+        double minTimeMs = 100.0;
+        bool quick = false;
+    };
+
+    struct Result
+    {
+        std::string group;
+        std::string name;
+        size_t channels = 0; // 0 when not applicable
+        size_t window = 0;   // Window, taps or vector length; 0 when not applicable
+        const char *unit = "sample";
+        size_t itemsPerIteration = 0;
+        uint64_t iterations = 0;
+        double nsPerItem = 0.0;    // Median over rounds
+        double minNsPerItem = 0.0; // Best round
+    };
+
+    // Keeps results observable so the optimizer cannot drop the work
+    volatile double g_sink = 0.0;
+
+    std::vector<float> makeSignal(size_t length, unsigned seed = 1)
+    {
+        std::vector<float> signal(length);
+        uint32_t state = seed * 2654435761u + 1u;
+        for (size_t i = 0; i < length; ++i)
+        {
+            state = state * 1664525u + 1013904223u;
+            float noise = static_cast<float>(state >> 8) / 16777216.0f - 0.5f;
+            signal[i] = std::sin(static_cast<float>(i) * 0.01f) + 0.1f * noise;
+        }
+        return signal;
+    }
+
+    std::string jsonEscape(const std::string &text)
+    {
+        std::string out;
+        for (char c : text)
+        {
+            switch (c)
+            {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) >= 0x20)
+                {
+                    out += c;
+                }
+            }
+        }
+        return out;
+    }
+
+    const char *simdLevel()
+    {
+        return dsp::simd::levelName(dsp::simd::activeLevel());
+    }
+
+    const char *compilerName()
+    {
+#if defined(__clang__)
+        return "clang " __clang_version__;
+#elif defined(__GNUC__)
+        return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+        return "msvc";
+#else
+        return "unknown";
+#endif
+    }
+
+    // -------------------------------------------------------------------------
+    // Harness: runs body until the time budget is spent, split into rounds,
+    // and reports the median and best ns per item across rounds
+    // -------------------------------------------------------------------------
+    class Runner
+    {
+    public:
+        explicit Runner(const Options &options) : m_options(options) {}
+
+        void run(Result result, const std::function<void()> &body)
+        {
+            std::string id = result.group + "/" + result.name;
+            if (!m_options.filter.empty() && id.find(m_options.filter) == std::string::npos)
+            {
+                return;
+            }
+            std::cerr << "  " << id << " channels=" << result.channels << " window=" << result.window << std::endl;
+
+            body(); // Warm-up: first-touch allocations, caches, branch predictors
+
+            constexpr int kRounds = 5;
+            const double roundNs = m_options.minTimeMs * 1e6 / kRounds;
+            std::vector<double> perItem;
+            for (int round = 0; round < kRounds; ++round)
+            {
+                uint64_t iterations = 0;
+                double elapsed = 0.0;
+                auto start = Clock::now();
+                do
+                {
+                    body();
+                    ++iterations;
+                    elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+                } while (elapsed < roundNs);
+
+                result.iterations += iterations;
+                perItem.push_back(elapsed / (static_cast<double>(iterations) * result.itemsPerIteration));
+            }
+
+            std::sort(perItem.begin(), perItem.end());
+            result.nsPerItem = perItem[kRounds / 2];
+            result.minNsPerItem = perItem.front();
+            m_results.push_back(std::move(result));
+        }
+
+        void writeJson(std::ostream &out) const
+        {
+            std::time_t now = std::time(nullptr);
+            char date[32];
+            std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+            out << "{\n";
+            out << "  \"schema\": 1,\n";
+            out << "  \"label\": \"" << jsonEscape(m_options.label) << "\",\n";
+            out << "  \"date\": \"" << date << "\",\n";
+            out << "  \"machine\": {\n";
+            out << "    \"compiler\": \"" << jsonEscape(compilerName()) << "\",\n";
+            out << "    \"simd\": \"" << simdLevel() << "\",\n";
+            out << "    \"threads\": " << std::thread::hardware_concurrency() << ",\n";
+            out << "    \"pointerBits\": " << sizeof(void *) * 8 << "\n";
+            out << "  },\n";
+            out << "  \"minTimeMs\": " << m_options.minTimeMs << ",\n";
+            out << "  \"results\": [";
+            for (size_t i = 0; i < m_results.size(); ++i)
+            {
+                const Result &r = m_results[i];
+                out << (i == 0 ? "\n" : ",\n");
+                out << "    {\"group\": \"" << r.group << "\", \"name\": \"" << r.name << "\""
+                    << ", \"channels\": " << r.channels
+                    << ", \"window\": " << r.window
+                    << ", \"unit\": \"" << r.unit << "\""
+                    << ", \"itemsPerIteration\": " << r.itemsPerIteration
+                    << ", \"iterations\": " << r.iterations
+                    << ", \"nsPerItem\": " << r.nsPerItem
+                    << ", \"minNsPerItem\": " << r.minNsPerItem
+                    << ", \"itemsPerSecond\": " << (r.nsPerItem > 0.0 ? 1e9 / r.nsPerItem : 0.0)
+                    << "}";
+            }
+            out << "\n  ]\n}\n";
+        }
+
+    private:
+        const Options &m_options;
+        std::vector<Result> m_results;
+    };
+
+    // -------------------------------------------------------------------------
+    // Core filters: one filter per channel over an interleaved chunk, the way
+    // the pipeline adapters drive them
+    // -------------------------------------------------------------------------
+    template <typename Filter, typename Make>
+    void benchFilter(Runner &runner, const char *name, size_t channels, size_t window, size_t frames, Make make)
+    {
+        std::vector<Filter> filters;
+        filters.reserve(channels);
+        for (size_t c = 0; c < channels; ++c)
+        {
+            filters.push_back(make(window));
+        }
+        const std::vector<float> input = makeSignal(channels * frames);
+
+        Result result;
+        result.group = "filter";
+        result.name = name;
+        result.channels = channels;
+        result.window = window;
+        result.itemsPerIteration = input.size();
+        runner.run(result, [&]()
+                   {
+            double acc = 0.0;
+            for (size_t i = 0; i < input.size(); ++i)
+            {
+                acc += filters[i % channels].addSample(input[i]);
+            }
+            g_sink = g_sink + acc; });
+    }
+
+    void benchFilters(Runner &runner, const std::vector<size_t> &channelCounts,
+                      const std::vector<size_t> &windows, size_t frames)
+    {
+        using namespace dsp::core;
+        for (size_t channels : channelCounts)
+        {
+            for (size_t window : windows)
+            {
+                benchFilter<MovingAverageFilter<float>>(runner, "movingAverage", channels, window, frames,
+                                                        [](size_t w)
+                                                        { return MovingAverageFilter<float>(w); });
+                benchFilter<RmsFilter<float>>(runner, "rms", channels, window, frames,
+                                              [](size_t w)
+                                              { return RmsFilter<float>(w); });
+                benchFilter<MovingAbsoluteValueFilter<float>>(runner, "meanAbsoluteValue", channels, window, frames,
+                                                              [](size_t w)
+                                                              { return MovingAbsoluteValueFilter<float>(w); });
+                benchFilter<MovingVarianceFilter<float>>(runner, "variance", channels, window, frames,
+                                                         [](size_t w)
+                                                         { return MovingVarianceFilter<float>(w); });
+                benchFilter<MovingZScoreFilter<float>>(runner, "zScoreNormalize", channels, window, frames,
+                                                       [](size_t w)
+                                                       { return MovingZScoreFilter<float>(w); });
+                benchFilter<WaveformLengthFilter<float>>(runner, "waveformLength", channels, window, frames,
+                                                         [](size_t w)
+                                                         { return WaveformLengthFilter<float>(w); });
+                benchFilter<SscFilter<float>>(runner, "slopeSignChange", channels, window, frames,
+                                              [](size_t w)
+                                              { return SscFilter<float>(w, 0.0f); });
+                benchFilter<WampFilter<float>>(runner, "willisonAmplitude", channels, window, frames,
+                                               [](size_t w)
+                                               { return WampFilter<float>(w, 0.05f); });
+                benchFilter<MovingPercentileFilter<float>>(runner, "movingMedian", channels, window, frames,
+                                                           [](size_t w)
+                                                           { return MovingPercentileFilter<float>(w, 0.5); });
+                benchFilter<ApproxMovingPercentileFilter<float>>(runner, "movingMedianApprox", channels, window, frames,
+                                                                 [](size_t w)
+                                                                 { return ApproxMovingPercentileFilter<float>(w, 0.5); });
+            }
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    // Chunked moving statistics: each channel's samples handed to addSamples()
+    // as one strided chunk (prefix sums once the chunk spans a window)
+    // -------------------------------------------------------------------------
+    template <typename Filter, typename Make>
+    void benchBlockFilter(Runner &runner, const char *name, size_t channels, size_t window, size_t frames, Make make)
+    {
+        std::vector<Filter> filters;
+        filters.reserve(channels);
+        for (size_t c = 0; c < channels; ++c)
+        {
+            filters.push_back(make(window));
+        }
+        const std::vector<float> input = makeSignal(channels * frames);
+        std::vector<float> buffer(input.size());
+
+        Result result;
+        result.group = "block";
+        result.name = name;
+        result.channels = channels;
+        result.window = window;
+        result.itemsPerIteration = input.size();
+        runner.run(result, [&]()
+                   {
+            std::copy(input.begin(), input.end(), buffer.begin());
+            for (size_t c = 0; c < channels; ++c)
+            {
+                filters[c].addSamples(buffer.data() + c, frames, channels);
+            }
+            g_sink = g_sink + buffer[buffer.size() - 1]; });
+    }
+
+    void benchBlockFilters(Runner &runner, const std::vector<size_t> &channelCounts,
+                           const std::vector<size_t> &windows, size_t frames)
+    {
+        using namespace dsp::core;
+        for (size_t channels : channelCounts)
+        {
+            for (size_t window : windows)
+            {
+                benchBlockFilter<MovingAverageFilter<float>>(runner, "movingAverage", channels, window, frames,
+                                                             [](size_t w)
+                                                             { return MovingAverageFilter<float>(w); });
+                benchBlockFilter<RmsFilter<float>>(runner, "rms", channels, window, frames,
+                                                   [](size_t w)
+                                                   { return RmsFilter<float>(w); });
+                benchBlockFilter<MovingAbsoluteValueFilter<float>>(runner, "meanAbsoluteValue", channels, window, frames,
+                                                                   [](size_t w)
+                                                                   { return MovingAbsoluteValueFilter<float>(w); });
+                benchBlockFilter<MovingVarianceFilter<float>>(runner, "variance", channels, window, frames,
+                                                              [](size_t w)
+                                                              { return MovingVarianceFilter<float>(w); });
+                benchBlockFilter<MovingZScoreFilter<float>>(runner, "zScoreNormalize", channels, window, frames,
+                                                            [](size_t w)
+                                                            { return MovingZScoreFilter<float>(w); });
+            }
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    // Rectify -> MAV -> zScore: one pass per stage over the chunk (the way the
+    // dynamic pipeline runs it) against the same chain fused by StaticPipeline
+    // -------------------------------------------------------------------------
+    void benchStaticPipeline(Runner &runner, const std::vector<size_t> &channelCounts,
+                             const std::vector<size_t> &windows, size_t frames)
+    {
+        using namespace dsp::core;
+        for (size_t channels : channelCounts)
+        {
+            for (size_t window : windows)
+            {
+                const std::vector<float> input = makeSignal(channels * frames);
+                std::vector<float> buffer(input.size());
+
+                Result result;
+                result.group = "staticPipeline";
+                result.channels = channels;
+                result.window = window;
+                result.itemsPerIteration = input.size();
+
+                std::vector<MovingAbsoluteValueFilter<float>> mav;
+                std::vector<MovingZScoreFilter<float>> zScore;
+                for (size_t c = 0; c < channels; ++c)
+                {
+                    mav.emplace_back(window);
+                    zScore.emplace_back(window);
+                }
+                result.name = "rectifyMavZScore/chained";
+                runner.run(result, [&]()
+                           {
+                    std::copy(input.begin(), input.end(), buffer.begin());
+                    dsp::simd::abs_inplace(buffer.data(), buffer.size());
+                    for (size_t i = 0; i < buffer.size(); ++i)
+                    {
+                        buffer[i] = mav[i % channels].addSample(buffer[i]);
+                    }
+                    for (size_t i = 0; i < buffer.size(); ++i)
+                    {
+                        buffer[i] = zScore[i % channels].addSample(buffer[i]);
+                    }
+                    g_sink = g_sink + buffer[buffer.size() - 1]; });
+
+                StaticPipeline<steps::Rectify, steps::MeanAbsoluteValue, steps::ZScore> fused(
+                    steps::Rectify(false), steps::MeanAbsoluteValue(window), steps::ZScore(window));
+                result.name = "rectifyMavZScore/fused";
+                runner.run(result, [&]()
+                           {
+                    std::copy(input.begin(), input.end(), buffer.begin());
+                    fused.process(buffer.data(), buffer.size(), static_cast<int>(channels));
+                    g_sink = g_sink + buffer[buffer.size() - 1]; });
+            }
+        }
+    }
+
+    // FIR taps follow the window grid; IIR has no window, so only channels vary
+    void benchFirIir(Runner &runner, const std::vector<size_t> &channelCounts,
+                     const std::vector<size_t> &windows, size_t frames)
+    {
+        using namespace dsp::core;
+        const std::vector<float> input = makeSignal(frames);
+        std::vector<float> output(frames);
+
+        for (size_t channels : channelCounts)
+        {
+            for (size_t taps : windows)
+            {
+                std::vector<FirFilter<float>> filters;
+                for (size_t c = 0; c < channels; ++c)
+                {
+                    filters.push_back(FirFilter<float>::createLowPass(0.1f, taps | 1));
+                }
+                Result result;
+                result.group = "filter";
+                result.name = "fir";
+                result.channels = channels;
+                result.window = taps | 1;
+                result.itemsPerIteration = channels * frames;
+                runner.run(result, [&]()
+                           {
+                    for (auto &filter : filters)
+                    {
+                        filter.process(input.data(), output.data(), frames);
+                    }
+                    g_sink = g_sink + output[frames - 1]; });
+
+                // Adaptive FIR of the same length: one filter per channel over a shared reference
+                const std::vector<float> primary = makeSignal(channels * frames, 3);
+                std::vector<float> error(channels * frames);
+                for (bool normalized : {false, true})
+                {
+                    LmsFilter lms(channels, taps, normalized ? 0.1f : 0.001f, normalized);
+                    Result adaptive;
+                    adaptive.group = "filter";
+                    adaptive.name = normalized ? "nlms" : "lms";
+                    adaptive.channels = channels;
+                    adaptive.window = taps;
+                    adaptive.itemsPerIteration = channels * frames;
+                    runner.run(adaptive, [&]()
+                               {
+                        lms.process(primary.data(), input.data(), error.data(), frames);
+                        g_sink = g_sink + error[error.size() - 1]; });
+                }
+            }
+
+            std::vector<IirFilter<float>> filters;
+            for (size_t c = 0; c < channels; ++c)
+            {
+                filters.push_back(IirFilter<float>::createButterworthLowPass(0.1f, 4));
+            }
+            Result result;
+            result.group = "filter";
+            result.name = "iirButterworth4";
+            result.channels = channels;
+            result.itemsPerIteration = channels * frames;
+            runner.run(result, [&]()
+                       {
+                for (auto &filter : filters)
+                {
+                    filter.process(input.data(), output.data(), frames);
+                }
+                g_sink = g_sink + output[frames - 1]; });
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    // RLS: O(order^2) per frame for the shared inverse correlation update plus
+    // O(order) per channel, over the orders it is practical for
+    // -------------------------------------------------------------------------
+    void benchRls(Runner &runner, const std::vector<size_t> &channelCounts, const std::vector<size_t> &orders,
+                  size_t frames)
+    {
+        using namespace dsp::core;
+        const std::vector<float> reference = makeSignal(frames);
+        for (size_t channels : channelCounts)
+        {
+            const std::vector<float> primary = makeSignal(channels * frames, 3);
+            std::vector<float> error(channels * frames);
+            for (size_t order : orders)
+            {
+                RlsFilter rls(channels, order, 0.99f);
+                Result result;
+                result.group = "filter";
+                result.name = "rls";
+                result.channels = channels;
+                result.window = order;
+                result.itemsPerIteration = channels * frames;
+                runner.run(result, [&]()
+                           {
+                    rls.process(primary.data(), reference.data(), error.data(), frames);
+                    g_sink = g_sink + error[error.size() - 1]; });
+            }
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    // Policies: SlidingWindowFilter<float, Policy> on a single channel, so a
+    // policy's cost can be told apart from the filter wrapped around it
+    // -------------------------------------------------------------------------
+    template <typename T, typename Policy>
+    void benchPolicy(Runner &runner, const char *name, size_t window, size_t frames, Policy policy)
+    {
+        dsp::utils::SlidingWindowFilter<T, Policy> filter(window, policy);
+        const std::vector<float> signal = makeSignal(frames);
+        std::vector<T> input(signal.begin(), signal.end());
+        if constexpr (std::is_same<T, bool>::value)
+        {
+            for (size_t i = 0; i < frames; ++i)
+            {
+                input[i] = signal[i] > 0.0f;
+            }
+        }
+
+        Result result;
+        result.group = "policy";
+        result.name = name;
+        result.channels = 1;
+        result.window = window;
+        result.itemsPerIteration = frames;
+        runner.run(result, [&]()
+                   {
+            double acc = 0.0;
+            for (size_t i = 0; i < frames; ++i)
+            {
+                if constexpr (std::is_same<typename dsp::utils::SlidingWindowFilter<T, Policy>::Result, T>::value)
+                {
+                    acc += static_cast<double>(filter.addSample(input[i]));
+                }
+                else
+                {
+                    for (T value : filter.addSample(input[i]))
+                    {
+                        acc += static_cast<double>(value);
+                    }
+                }
+            }
+            g_sink = g_sink + acc; });
+    }
+
+    void benchPolicies(Runner &runner, const std::vector<size_t> &windows, size_t frames)
+    {
+        using namespace dsp::core;
+        for (size_t window : windows)
+        {
+            benchPolicy<float>(runner, "mean", window, frames, MeanPolicy<float>());
+            benchPolicy<float>(runner, "rms", window, frames, RmsPolicy<float>());
+            benchPolicy<float>(runner, "sum", window, frames, SumPolicy<float>());
+            benchPolicy<float>(runner, "meanAbsoluteValue", window, frames, MeanAbsoluteValuePolicy<float>());
+            benchPolicy<float>(runner, "variance", window, frames, VariancePolicy<float>());
+            benchPolicy<float>(runner, "percentile", window, frames, PercentilePolicy<float>(0.5));
+            benchPolicy<bool>(runner, "counter", window, frames, CounterPolicy());
+            // Mean + rms + meanAbsoluteValue + variance over one buffer
+            benchPolicy<float>(runner, "movingStatistics", window, frames, MovingStatisticsPolicy<float>());
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    // SimdOps kernels
+    // -------------------------------------------------------------------------
+    void benchSimd(Runner &runner, const std::vector<size_t> &sizes)
+    {
+        namespace simd = dsp::simd;
+        for (size_t size : sizes)
+        {
+            const std::vector<float> a = makeSignal(size, 1);
+            const std::vector<float> b = makeSignal(size, 2);
+            std::vector<float> work(size), out(size), outImag(size);
+
+            auto add = [&](const char *name, const std::function<void()> &body)
+            {
+                Result result;
+                result.group = "simd";
+                result.name = name;
+                result.window = size;
+                result.unit = "element";
+                result.itemsPerIteration = size;
+                runner.run(result, body);
+            };
+
+            add("abs_inplace", [&]()
+                {
+                std::memcpy(work.data(), a.data(), size * sizeof(float));
+                simd::abs_inplace(work.data(), size);
+                g_sink = g_sink + work[size - 1]; });
+            add("max_zero_inplace", [&]()
+                {
+                std::memcpy(work.data(), a.data(), size * sizeof(float));
+                simd::max_zero_inplace(work.data(), size);
+                g_sink = g_sink + work[size - 1]; });
+            add("sum", [&]()
+                { g_sink = g_sink + simd::sum(a.data(), size); });
+            add("sum_of_squares", [&]()
+                { g_sink = g_sink + simd::sum_of_squares(a.data(), size); });
+            add("dot_product", [&]()
+                { g_sink = g_sink + simd::dot_product(a.data(), b.data(), size); });
+            add("apply_window", [&]()
+                {
+                simd::apply_window(a.data(), b.data(), out.data(), size);
+                g_sink = g_sink + out[size - 1]; });
+            add("complex_magnitude", [&]()
+                {
+                simd::complex_magnitude(a.data(), b.data(), out.data(), size);
+                g_sink = g_sink + out[size - 1]; });
+            add("complex_power", [&]()
+                {
+                simd::complex_power(a.data(), b.data(), out.data(), size);
+                g_sink = g_sink + out[size - 1]; });
+            add("complex_multiply", [&]()
+                {
+                simd::complex_multiply(a.data(), b.data(), b.data(), a.data(), out.data(), outImag.data(), size);
+                g_sink = g_sink + out[size - 1] + outImag[size - 1]; });
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    // FftEngine: complex and real transforms per power-of-two size
+    // -------------------------------------------------------------------------
+    void benchFft(Runner &runner, const std::vector<size_t> &sizes)
+    {
+        using Engine = dsp::core::FftEngine<float>;
+        for (size_t size : sizes)
+        {
+            Engine engine(size);
+            const std::vector<float> signal = makeSignal(size);
+            std::vector<Engine::Complex> complexIn(size), complexOut(size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                complexIn[i] = Engine::Complex(signal[i], 0.0f);
+            }
+            std::vector<Engine::Complex> half(size / 2 + 1);
+            std::vector<float> realOut(size);
+
+            auto add = [&](const char *name, const std::function<void()> &body)
+            {
+                Result result;
+                result.group = "fft";
+                result.name = name;
+                result.window = size;
+                result.unit = "transform";
+                result.itemsPerIteration = 1;
+                runner.run(result, body);
+            };
+
+            add("fft", [&]()
+                {
+                engine.fft(complexIn.data(), complexOut.data());
+                g_sink = g_sink + complexOut[1].real(); });
+            add("ifft", [&]()
+                {
+                engine.ifft(complexIn.data(), complexOut.data());
+                g_sink = g_sink + complexOut[1].real(); });
+            add("rfft", [&]()
+                {
+                engine.rfft(signal.data(), half.data());
+                g_sink = g_sink + half[1].real(); });
+            add("irfft", [&]()
+                {
+                engine.irfft(half.data(), realOut.data());
+                g_sink = g_sink + realOut[1]; });
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    // SpatialFilter: montages (sparse layout) against the blocked GEMM on the
+    // same matrix, plus a dense random matrix, per montage width
+    // -------------------------------------------------------------------------
+    void benchSpatial(Runner &runner, const std::vector<size_t> &channelCounts, size_t frames)
+    {
+        using namespace dsp::core;
+        for (size_t channels : channelCounts)
+        {
+            const std::vector<float> input = makeSignal(frames * channels);
+
+            std::vector<std::pair<size_t, size_t>> pairs;
+            for (size_t c = 0; c + 1 < channels; ++c)
+            {
+                pairs.emplace_back(c, c + 1);
+            }
+            std::vector<float> random = makeSignal(channels * channels, 7);
+
+            auto add = [&](const char *name, size_t outputs, const std::vector<float> &weights, SpatialLayout layout)
+            {
+                SpatialFilter filter(outputs, channels, weights, layout);
+                std::vector<float> output(frames * outputs);
+                Result result;
+                result.group = "spatial";
+                result.name = name;
+                result.channels = channels;
+                result.unit = "frame";
+                result.itemsPerIteration = frames;
+                runner.run(result, [&]()
+                           {
+                    filter.process(input.data(), frames, output.data());
+                    g_sink = g_sink + output[output.size() - 1]; });
+            };
+
+            const std::vector<float> car = SpatialFilter::commonAverage(channels);
+            add("commonAverage/sparse", channels, car, SpatialLayout::Sparse);
+            add("commonAverage/dense", channels, car, SpatialLayout::Dense);
+            if (!pairs.empty())
+            {
+                const std::vector<float> bipolar = SpatialFilter::bipolar(channels, pairs);
+                add("bipolar/sparse", pairs.size(), bipolar, SpatialLayout::Sparse);
+                add("bipolar/dense", pairs.size(), bipolar, SpatialLayout::Dense);
+            }
+            add("matrix/dense", channels, random, SpatialLayout::Dense);
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    // StreamingPca: what the processing thread pays per frame with the
+    // decompositions on the worker thread, against running them inline
+    // -------------------------------------------------------------------------
+    void benchPca(Runner &runner, const std::vector<size_t> &channelCounts, size_t frames)
+    {
+        using namespace dsp::core;
+        for (size_t channels : channelCounts)
+        {
+            const std::vector<float> input = makeSignal(frames * channels);
+            std::vector<float> output(frames * channels);
+
+            auto add = [&](const char *name, bool background)
+            {
+                PcaOptions options;
+                options.mode = PcaMode::Whiten;
+                options.alpha = 0.01;
+                options.updateInterval = 256;
+                options.background = background;
+                StreamingPca pca(channels, options);
+                pca.process(input.data(), frames, output.data());
+
+                Result result;
+                result.group = "pca";
+                result.name = name;
+                result.channels = channels;
+                result.unit = "frame";
+                result.itemsPerIteration = frames;
+                runner.run(result, [&]()
+                           {
+                    pca.process(input.data(), frames, output.data());
+                    g_sink = g_sink + output[output.size() - 1]; });
+            };
+
+            add("whiten/background", true);
+            add("whiten/inline", false);
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    // Kalman filter banks: each kalman_frames() form over many channels. The
+    // custom model is constantVelocity spelled out, so it times the General
+    // update against the closed form on identical work.
+    // -------------------------------------------------------------------------
+    void benchKalman(Runner &runner, const std::vector<size_t> &channelCounts, size_t frames)
+    {
+        using namespace dsp::core;
+        for (size_t channels : channelCounts)
+        {
+            const std::vector<float> input = makeSignal(frames * channels);
+            std::vector<float> buffer(frames * channels);
+
+            auto add = [&](const char *name, const KalmanOptions &options)
+            {
+                KalmanFilter filter(channels, options);
+                Result result;
+                result.group = "kalman";
+                result.name = name;
+                result.channels = channels;
+                result.itemsPerIteration = channels * frames;
+                runner.run(result, [&]()
+                           {
+                    std::copy(input.begin(), input.end(), buffer.begin());
+                    filter.process(buffer.data(), frames);
+                    g_sink = g_sink + buffer[buffer.size() - 1]; });
+            };
+
+            KalmanOptions level;
+            add("level", level);
+
+            KalmanOptions velocity;
+            velocity.model = KalmanModel::ConstantVelocity;
+            add("constantVelocity", velocity);
+
+            KalmanOptions general;
+            general.model = KalmanModel::Custom;
+            general.transition = {1.0f, 1.0f, 0.0f, 1.0f};
+            general.observation = {1.0f, 0.0f};
+            const float q = velocity.processNoise;
+            general.processCovariance = {0.25f * q, 0.5f * q, 0.5f * q, q};
+            add("constantVelocity/general", general);
+
+            KalmanOptions steady = velocity;
+            steady.steadyState = true;
+            add("constantVelocity/steadyState", steady);
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    // Wavelet transforms: lifting decompose and denoise (analysis + synthesis)
+    // for short and long Daubechies filters. window is the filter length 2N.
+    // -------------------------------------------------------------------------
+    void benchWavelet(Runner &runner, const std::vector<size_t> &channelCounts, size_t frames)
+    {
+        using namespace dsp::core;
+        for (size_t channels : channelCounts)
+        {
+            const std::vector<float> input = makeSignal(frames * channels);
+            std::vector<float> buffer(frames * channels);
+
+            for (size_t order : {size_t{1}, size_t{4}, size_t{8}})
+            {
+                WaveletOptions options;
+                options.order = order;
+                options.levels = 4;
+
+                WaveletTransform decomposer(channels, options);
+                decomposer.reserve(frames);
+                std::vector<float> coefficients(decomposer.maxOutputFrames(frames) * channels *
+                                                decomposer.getBlockSize());
+                Result result;
+                result.group = "wavelet";
+                result.name = waveletName(order) + "/decompose";
+                result.channels = channels;
+                result.window = 2 * order;
+                result.itemsPerIteration = channels * frames;
+                runner.run(result, [&]()
+                           {
+                    const size_t written = decomposer.decompose(input.data(), frames, nullptr,
+                                                                coefficients.data(), nullptr);
+                    g_sink = g_sink + coefficients[0] + static_cast<double>(written); });
+
+                options.mode = WaveletMode::Denoise;
+                options.thresholds.assign(options.levels, 0.05f);
+                WaveletTransform denoiser(channels, options);
+                denoiser.reserve(frames);
+                result.name = waveletName(order) + "/denoise";
+                runner.run(result, [&]()
+                           {
+                    std::copy(input.begin(), input.end(), buffer.begin());
+                    denoiser.denoise(buffer.data(), frames);
+                    g_sink = g_sink + buffer[buffer.size() - 1]; });
+            }
+        }
+    }
+
+    bool parseOptions(int argc, char **argv, Options &options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string arg = argv[i];
+            auto value = [&]() -> std::string
+            {
+                if (i + 1 >= argc)
+                {
+                    throw std::invalid_argument("Missing value for " + arg);
+                }
+                return argv[++i];
+            };
+
+            if (arg == "--filter")
+                options.filter = value();
+            else if (arg == "--label")
+                options.label = value();
+            else if (arg == "--output")
+                options.output = value();
+            else if (arg == "--min-time")
+                options.minTimeMs = std::stod(value());
+            else if (arg == "--quick")
+                options.quick = true;
+            else if (arg == "--simd")
+            {
+                const std::string name = value();
+                dsp::simd::SimdLevel level;
+                if (!dsp::simd::parseLevel(name.c_str(), level) || !dsp::simd::setLevel(level))
+                {
+                    throw std::invalid_argument("SIMD level " + name + " is not supported on this CPU");
+                }
+            }
+            else
+            {
+                std::cerr << "Unknown option " << arg << "\n"
+                          << "Usage: dspx_bench [--filter text] [--min-time ms] [--label text] "
+                             "[--output file] [--quick] [--simd level]"
+                          << std::endl;
+                return false;
+            }
+        }
+        return options.minTimeMs > 0.0;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    Options options;
+    try
+    {
+        if (!parseOptions(argc, argv, options))
+        {
+            return 2;
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 2;
+    }
+
+    const std::vector<size_t> channels = options.quick ? std::vector<size_t>{1, 8} : std::vector<size_t>{1, 4, 16};
+    const std::vector<size_t> windows = options.quick ? std::vector<size_t>{64, 1024} : std::vector<size_t>{16, 256, 4096};
+    const std::vector<size_t> vectorSizes = options.quick ? std::vector<size_t>{1024, 65536} : std::vector<size_t>{256, 4096, 65536};
+    const std::vector<size_t> fftSizes = options.quick ? std::vector<size_t>{256, 4096} : std::vector<size_t>{64, 256, 1024, 4096, 16384};
+    const std::vector<size_t> spatialChannels = options.quick ? std::vector<size_t>{32, 256} : std::vector<size_t>{8, 64, 256};
+    const std::vector<size_t> rlsOrders = options.quick ? std::vector<size_t>{8, 64} : std::vector<size_t>{8, 16, 32, 64};
+    const std::vector<size_t> pcaChannels = options.quick ? std::vector<size_t>{8, 64} : std::vector<size_t>{8, 32, 128};
+    const std::vector<size_t> kalmanChannels = options.quick ? std::vector<size_t>{16, 256} : std::vector<size_t>{16, 128, 512};
+    const std::vector<size_t> waveletChannels = options.quick ? std::vector<size_t>{1, 16} : std::vector<size_t>{1, 8, 64};
+    const size_t frames = 4096;
+
+    Runner runner(options);
+    try
+    {
+        std::cerr << "dspx native benchmark (" << simdLevel() << ")" << std::endl;
+        benchFilters(runner, channels, windows, frames);
+        benchBlockFilters(runner, channels, windows, frames);
+        benchFirIir(runner, channels, windows, frames);
+        benchRls(runner, channels, rlsOrders, frames);
+        benchStaticPipeline(runner, channels, windows, frames);
+        benchPolicies(runner, windows, frames);
+        benchSimd(runner, vectorSizes);
+        benchFft(runner, fftSizes);
+        benchSpatial(runner, spatialChannels, 1024);
+        benchPca(runner, pcaChannels, 1024);
+        benchKalman(runner, kalmanChannels, 1024);
+        benchWavelet(runner, waveletChannels, frames);
+    }
+    catch (const std::exception &e)
+    {
+        std::cerr << "Benchmark failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    if (options.output.empty())
+    {
+        runner.writeJson(std::cout);
+    }
+    else
+    {
+        std::ofstream file(options.output);
+        runner.writeJson(file);
+        if (!file)
+        {
+            std::cerr << "Could not write " << options.output << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
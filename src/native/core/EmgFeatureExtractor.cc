@@ -0,0 +1,293 @@
+#include "EmgFeatureExtractor.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+using namespace dsp::core;
+
+namespace
+{
+    struct FeatureName
+    {
+        EmgFeature feature;
+        const char *name;
+    };
+
+    constexpr FeatureName kFeatureNames[] = {
+        {EmgFeature::MeanAbsoluteValue, "meanAbsoluteValue"},
+        {EmgFeature::Rms, "rms"},
+        {EmgFeature::WaveformLength, "waveformLength"},
+        {EmgFeature::SlopeSignChange, "slopeSignChange"},
+        {EmgFeature::WillisonAmplitude, "willisonAmplitude"},
+        {EmgFeature::ZeroCrossings, "zeroCrossings"},
+        {EmgFeature::Variance, "variance"},
+    };
+}
+
+const char *dsp::core::emgFeatureName(EmgFeature feature) noexcept
+{
+    for (const auto &entry : kFeatureNames)
+    {
+        if (entry.feature == feature)
+        {
+            return entry.name;
+        }
+    }
+    return "unknown";
+}
+
+bool dsp::core::parseEmgFeature(const std::string &name, EmgFeature &feature) noexcept
+{
+    for (const auto &entry : kFeatureNames)
+    {
+        if (name == entry.name)
+        {
+            feature = entry.feature;
+            return true;
+        }
+    }
+    return false;
+}
+
+// -----------------------------------------------------------------------------
+// Constructor
+// @ param window_size - Samples per channel in each feature window
+// @ param hop_size - Frames between feature frames
+// @ param num_channels - Number of interleaved channels
+// @ param features - Features to compute, in output order
+// @ param ssc_threshold - Slope sign change threshold
+// @ param wamp_threshold - Willison amplitude threshold
+// @ param zc_threshold - Minimum zero-crossing step
+// -----------------------------------------------------------------------------
+EmgFeatureExtractor::EmgFeatureExtractor(size_t window_size, size_t hop_size, size_t num_channels,
+                                         std::vector<EmgFeature> features,
+                                         float ssc_threshold, float wamp_threshold, float zc_threshold)
+    : m_window_size(window_size),
+      m_hop_size(hop_size),
+      m_num_channels(num_channels),
+      m_features(std::move(features)),
+      m_ssc_threshold(ssc_threshold),
+      m_wamp_threshold(wamp_threshold),
+      m_zc_threshold(zc_threshold),
+      m_capacity(window_size + 2),
+      m_ring((window_size + 2) * num_channels, 0.0f),
+      m_scratch(window_size + 2, 0.0f),
+      m_head(0),
+      m_count(0),
+      m_until_output(window_size)
+{
+    if (window_size == 0)
+    {
+        throw std::invalid_argument("Window size must be greater than 0");
+    }
+    if (hop_size == 0)
+    {
+        throw std::invalid_argument("Hop size must be greater than 0");
+    }
+    if (num_channels == 0)
+    {
+        throw std::invalid_argument("Channel count must be greater than 0");
+    }
+    if (m_features.empty())
+    {
+        throw std::invalid_argument("At least one feature is required");
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Method: maxOutputFrames
+// -----------------------------------------------------------------------------
+size_t EmgFeatureExtractor::maxOutputFrames(size_t numFrames) const noexcept
+{
+    if (numFrames < m_until_output)
+    {
+        return 0;
+    }
+    return 1 + (numFrames - m_until_output) / m_hop_size;
+}
+
+// -----------------------------------------------------------------------------
+// Method: process
+// Pushes each frame into the rings and emits a feature frame every hop
+// @ param input - Interleaved samples
+// @ param numFrames - Number of frames
+// @ param timestamps - Per-sample timestamps, or nullptr
+// @ param output - Feature frames, [frame][channel][feature]
+// @ param outputTimestamps - Per-value timestamps of the feature frames
+// @ return Number of feature frames written
+// -----------------------------------------------------------------------------
+size_t EmgFeatureExtractor::process(const float *input, size_t numFrames, const float *timestamps,
+                                    float *output, float *outputTimestamps)
+{
+    const size_t rowSize = m_num_channels * m_features.size();
+    size_t written = 0;
+
+    for (size_t f = 0; f < numFrames; ++f)
+    {
+        const float *frame = input + f * m_num_channels;
+        for (size_t c = 0; c < m_num_channels; ++c)
+        {
+            m_ring[c * m_capacity + m_head] = frame[c];
+        }
+        m_head = (m_head + 1) % m_capacity;
+        m_count = std::min(m_count + 1, m_capacity);
+
+        if (--m_until_output == 0)
+        {
+            computeFrame(output + written * rowSize);
+            if (timestamps != nullptr && outputTimestamps != nullptr)
+            {
+                const float last = timestamps[(f + 1) * m_num_channels - 1];
+                std::fill(outputTimestamps + written * rowSize, outputTimestamps + (written + 1) * rowSize, last);
+            }
+            ++written;
+            m_until_output = m_hop_size;
+        }
+    }
+    return written;
+}
+
+// -----------------------------------------------------------------------------
+// Method: computeFrame
+// All requested features of every channel, one pass over each window
+// @ param row - getNumChannels() * getFeatures().size() outputs
+// -----------------------------------------------------------------------------
+void EmgFeatureExtractor::computeFrame(float *row)
+{
+    const size_t n = m_count;
+    const size_t start = n > m_window_size ? n - m_window_size : 0;
+    const double w = static_cast<double>(n - start);
+    const double sscThreshold = m_ssc_threshold;
+    const double wampThreshold = m_wamp_threshold;
+    const double zcThreshold = m_zc_threshold;
+
+    for (size_t c = 0; c < m_num_channels; ++c)
+    {
+        // Oldest first: the window plus up to two samples before it
+        const float *ring = m_ring.data() + c * m_capacity;
+        const size_t oldest = (m_head + m_capacity - n) % m_capacity;
+        const size_t firstRun = std::min(n, m_capacity - oldest);
+        std::copy(ring + oldest, ring + oldest + firstRun, m_scratch.begin());
+        std::copy(ring, ring + (n - firstRun), m_scratch.begin() + firstRun);
+        const float *x = m_scratch.data();
+
+        double sum = 0.0, sumAbs = 0.0, sumSq = 0.0, length = 0.0;
+        size_t ssc = 0, wamp = 0, zc = 0;
+        for (size_t k = start; k < n; ++k)
+        {
+            const double value = x[k];
+            sum += value;
+            sumAbs += std::abs(value);
+            sumSq += value * value;
+
+            if (k >= 1)
+            {
+                const double previous = x[k - 1];
+                const double step = std::abs(value - previous);
+                length += step;
+                wamp += step > wampThreshold;
+                zc += (value * previous < 0.0) && step >= zcThreshold;
+
+                if (k >= 2)
+                {
+                    ssc += (previous - x[k - 2]) * (previous - value) > sscThreshold;
+                }
+            }
+        }
+
+        const double mean = sum / w;
+        float *out = row + c * m_features.size();
+        for (size_t i = 0; i < m_features.size(); ++i)
+        {
+            double value = 0.0;
+            switch (m_features[i])
+            {
+            case EmgFeature::MeanAbsoluteValue:
+                value = sumAbs / w;
+                break;
+            case EmgFeature::Rms:
+                value = std::sqrt(sumSq / w);
+                break;
+            case EmgFeature::WaveformLength:
+                value = length;
+                break;
+            case EmgFeature::SlopeSignChange:
+                value = static_cast<double>(ssc);
+                break;
+            case EmgFeature::WillisonAmplitude:
+                value = static_cast<double>(wamp);
+                break;
+            case EmgFeature::ZeroCrossings:
+                value = static_cast<double>(zc);
+                break;
+            case EmgFeature::Variance:
+                value = std::max(0.0, sumSq / w - mean * mean);
+                break;
+            }
+            out[i] = static_cast<float>(value);
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Method: clear
+// -----------------------------------------------------------------------------
+void EmgFeatureExtractor::clear()
+{
+    std::fill(m_ring.begin(), m_ring.end(), 0.0f);
+    m_head = 0;
+    m_count = 0;
+    m_until_output = m_window_size;
+}
+
+// -----------------------------------------------------------------------------
+// Method: getChannelHistory
+// @ param channel - Channel index
+// @ return The channel's held samples, oldest first
+// -----------------------------------------------------------------------------
+std::vector<float> EmgFeatureExtractor::getChannelHistory(size_t channel) const
+{
+    std::vector<float> history(m_count);
+    const float *ring = m_ring.data() + channel * m_capacity;
+    const size_t oldest = (m_head + m_capacity - m_count) % m_capacity;
+    for (size_t k = 0; k < m_count; ++k)
+    {
+        history[k] = ring[(oldest + k) % m_capacity];
+    }
+    return history;
+}
+
+// -----------------------------------------------------------------------------
+// Method: setState
+// @ param histories - One history per channel, oldest first
+// @ param framesUntilOutput - Frames until the next feature frame
+// -----------------------------------------------------------------------------
+void EmgFeatureExtractor::setState(const std::vector<std::vector<float>> &histories, size_t framesUntilOutput)
+{
+    if (histories.size() != m_num_channels)
+    {
+        throw std::runtime_error("EmgFeatureExtractor: channel count mismatch in state");
+    }
+    const size_t count = histories.front().size();
+    for (const auto &history : histories)
+    {
+        if (history.size() != count || count > m_capacity)
+        {
+            throw std::runtime_error("EmgFeatureExtractor: invalid history length in state");
+        }
+    }
+    if (framesUntilOutput == 0 || framesUntilOutput > std::max(m_window_size, m_hop_size))
+    {
+        throw std::runtime_error("EmgFeatureExtractor: invalid hop position in state");
+    }
+
+    std::fill(m_ring.begin(), m_ring.end(), 0.0f);
+    for (size_t c = 0; c < m_num_channels; ++c)
+    {
+        std::copy(histories[c].begin(), histories[c].end(), m_ring.begin() + c * m_capacity);
+    }
+    m_head = count % m_capacity;
+    m_count = count;
+    m_until_output = framesUntilOutput;
+}
@@ -0,0 +1,143 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace dsp::core
+{
+    /**
+     * @brief Time-domain EMG features computed by EmgFeatureExtractor.
+     */
+    enum class EmgFeature
+    {
+        MeanAbsoluteValue, // mean |x|
+        Rms,               // sqrt(mean x^2)
+        WaveformLength,    // sum |x[k] - x[k-1]|
+        SlopeSignChange,   // count of (x[k-1] - x[k-2]) * (x[k-1] - x[k]) > sscThreshold
+        WillisonAmplitude, // count of |x[k] - x[k-1]| > wampThreshold
+        ZeroCrossings,     // count of x[k] * x[k-1] < 0 with |x[k] - x[k-1]| >= zcThreshold
+        Variance           // mean x^2 - (mean x)^2
+    };
+
+    /**
+     * @brief Feature name as used in stage parameters ("meanAbsoluteValue", "rms", ...).
+     */
+    const char *emgFeatureName(EmgFeature feature) noexcept;
+
+    /**
+     * @brief Parses a name returned by emgFeatureName().
+     * @return false if the name is unknown
+     */
+    bool parseEmgFeature(const std::string &name, EmgFeature &feature) noexcept;
+
+    /**
+     * @brief Fused EMG time-domain feature extractor with hop-based output.
+     *
+     * Keeps one window per channel (plus the two samples before it, which
+     * the difference-based features need) and, every hopSize frames once
+     * the first window is full, computes all requested features of every
+     * channel in a single pass over that window. Each feature follows the
+     * definition of the matching per-sample stage (MeanAbsoluteValue, Rms,
+     * WaveformLength, SlopeSignChange, WillisonAmplitude, Variance) for the
+     * same window size.
+     *
+     * Features are recomputed from the window on every frame, so there are
+     * no running sums to drift.
+     */
+    class EmgFeatureExtractor
+    {
+    public:
+        /**
+         * @brief Constructs the extractor.
+         * @param window_size Samples per channel in each feature window.
+         * @param hop_size Frames between consecutive feature frames.
+         * @param num_channels Number of interleaved input channels.
+         * @param features Features to compute, in output order.
+         * @param ssc_threshold Slope sign change threshold.
+         * @param wamp_threshold Willison amplitude threshold.
+         * @param zc_threshold Minimum step for a zero crossing to count.
+         */
+        EmgFeatureExtractor(size_t window_size, size_t hop_size, size_t num_channels,
+                            std::vector<EmgFeature> features,
+                            float ssc_threshold = 0.0f, float wamp_threshold = 0.0f, float zc_threshold = 0.0f);
+
+        /**
+         * @brief Upper bound on the feature frames process() emits for numFrames input frames.
+         */
+        size_t maxOutputFrames(size_t numFrames) const noexcept;
+
+        /**
+         * @brief Pushes interleaved frames and writes one feature frame per hop.
+         *
+         * Output frame i holds getNumChannels() rows of getFeatures().size()
+         * values: output[(i * channels + c) * features + f].
+         *
+         * @param input numFrames * getNumChannels() interleaved samples.
+         * @param numFrames Number of input frames.
+         * @param timestamps Optional per-sample timestamps, same layout as
+         *        input (nullptr if none).
+         * @param output Room for maxOutputFrames(numFrames) feature frames.
+         * @param outputTimestamps Per-value timestamps, same layout as output:
+         *        every value of a feature frame gets the timestamp of the
+         *        frame's last input sample (ignored when timestamps is nullptr).
+         * @return size_t Number of feature frames written.
+         */
+        size_t process(const float *input, size_t numFrames, const float *timestamps,
+                       float *output, float *outputTimestamps);
+
+        /**
+         * @brief Empties every window and restarts the hop count.
+         */
+        void clear();
+
+        size_t getWindowSize() const noexcept { return m_window_size; }
+        size_t getHopSize() const noexcept { return m_hop_size; }
+        size_t getNumChannels() const noexcept { return m_num_channels; }
+        const std::vector<EmgFeature> &getFeatures() const noexcept { return m_features; }
+        float getSscThreshold() const noexcept { return m_ssc_threshold; }
+        float getWampThreshold() const noexcept { return m_wamp_threshold; }
+        float getZcThreshold() const noexcept { return m_zc_threshold; }
+
+        /**
+         * @brief Samples held per channel (at most window size + 2).
+         */
+        size_t getCount() const noexcept { return m_count; }
+
+        /**
+         * @brief Input frames left until the next feature frame.
+         */
+        size_t getFramesUntilOutput() const noexcept { return m_until_output; }
+
+        /**
+         * @brief One channel's held samples, oldest first.
+         */
+        std::vector<float> getChannelHistory(size_t channel) const;
+
+        /**
+         * @brief Restores the held samples and the hop position.
+         * @param histories One history per channel, oldest first, all the same length.
+         * @param framesUntilOutput Value of getFramesUntilOutput() when saved.
+         * @throws std::runtime_error on a channel count or length mismatch.
+         */
+        void setState(const std::vector<std::vector<float>> &histories, size_t framesUntilOutput);
+
+    private:
+        void computeFrame(float *row);
+
+        size_t m_window_size;
+        size_t m_hop_size;
+        size_t m_num_channels;
+        std::vector<EmgFeature> m_features;
+        float m_ssc_threshold;
+        float m_wamp_threshold;
+        float m_zc_threshold;
+
+        size_t m_capacity;           // window size + 2 samples per channel
+        std::vector<float> m_ring;   // Channel-major rings of m_capacity samples
+        std::vector<float> m_scratch; // One channel's history, oldest first
+        size_t m_head;               // Next slot to write (shared by all channels)
+        size_t m_count;              // Samples held per channel
+        size_t m_until_output;       // Frames until the next feature frame
+    };
+
+} // namespace dsp::core
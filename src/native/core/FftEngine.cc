@@ -359,7 +359,9 @@ namespace dsp
 
         /**
          * Core Cooley-Tukey FFT algorithm (in-place)
-         * SIMPLIFIED: Passes 'inverse' flag to SIMD helpers.
+         * Each stage runs through the SIMD kernel table picked for this CPU
+         * at run time (see SimdOps.h), with forward twiddles conjugated by
+         * the kernel for the inverse transform.
          */
         template <typename T>
         void FftEngine<T>::cooleyTukeyFFT(Complex *data, bool inverse)
@@ -369,6 +371,7 @@ namespace dsp
 
             // 2. Cooley-Tukey decimation-in-time
             const size_t logN = static_cast<size_t>(std::log2(static_cast<double>(m_size)));
+            const simd::KernelTable &kernels = simd::kernels();
 
             for (size_t s = 1; s <= logN; ++s)
             {
@@ -377,93 +380,28 @@ namespace dsp
                 const auto &twiddles = m_twiddleFactors; // Always use forward twiddles
                 size_t twiddle_step = m_size / len;
 
-                for (size_t i = 0; i < m_size; i += len)
+                // std::complex<T> is layout-compatible with T[2]
+                if constexpr (std::is_same_v<T, float>)
                 {
-                    size_t k = 0; // Twiddle index
-                    size_t j = 0; // Butterfly index
-
-                    // --- COMPILE-TIME DISPATCH ---
-                    if constexpr (std::is_same_v<T, float>)
-                    {
-                        // --- FLOAT PATH ---
-#if defined(SIMD_AVX2)
-                        for (; j + 3 < halfLen; j += 4)
-                        {
-                            // Load forward twiddles
-                            const float tw_data[8] = {/* ... load k, k+step, k+2s, k+3s ... */
-                                                      twiddles[k].real(), twiddles[k].imag(),
-                                                      twiddles[k + twiddle_step].real(), twiddles[k + twiddle_step].imag(),
-                                                      twiddles[k + 2 * twiddle_step].real(), twiddles[k + 2 * twiddle_step].imag(),
-                                                      twiddles[k + 3 * twiddle_step].real(), twiddles[k + 3 * twiddle_step].imag()};
-                            __m256 tw = _mm256_loadu_ps(tw_data);
-                            __m256 a = _mm256_loadu_ps(reinterpret_cast<float *>(&data[i + j]));
-                            __m256 b = _mm256_loadu_ps(reinterpret_cast<float *>(&data[i + j + halfLen]));
-
-                            // Pass 'inverse' flag to helper
-                            dsp::simd::avx_butterfly(a, b, tw, inverse);
-
-                            _mm256_storeu_ps(reinterpret_cast<float *>(&data[i + j]), a);
-                            _mm256_storeu_ps(reinterpret_cast<float *>(&data[i + j + halfLen]), b);
-                            k += (4 * twiddle_step);
-                        }
-#endif
-#if defined(SIMD_SSE3)
-                        for (; j + 1 < halfLen; j += 2)
-                        {
-                            // Load forward twiddles
-                            const float tw_data[4] = {/* ... load k, k+step ... */
-                                                      twiddles[k].real(), twiddles[k].imag(),
-                                                      twiddles[k + twiddle_step].real(), twiddles[k + twiddle_step].imag()};
-                            __m128 tw = _mm_loadu_ps(tw_data);
-                            __m128 a = _mm_loadu_ps(reinterpret_cast<float *>(&data[i + j]));
-                            __m128 b = _mm_loadu_ps(reinterpret_cast<float *>(&data[i + j + halfLen]));
-
-                            // Pass 'inverse' flag to helper
-                            dsp::simd::sse_butterfly(a, b, tw, inverse);
-
-                            _mm_storeu_ps(reinterpret_cast<float *>(&data[i + j]), a);
-                            _mm_storeu_ps(reinterpret_cast<float *>(&data[i + j + halfLen]), b);
-                            k += (2 * twiddle_step);
-                        }
-#endif
-                    }
-                    else if constexpr (std::is_same_v<T, double>)
-                    {
-                        // --- DOUBLE PATH ---
-#if defined(SIMD_AVX)
-                        for (; j + 1 < halfLen; j += 2)
-                        {
-                            // Load forward twiddles
-                            const double tw_data[4] = {/* ... load k, k+step ... */
-                                                       twiddles[k].real(), twiddles[k].imag(),
-                                                       twiddles[k + twiddle_step].real(), twiddles[k + twiddle_step].imag()};
-                            __m256d tw = _mm256_loadu_pd(tw_data);
-                            __m256d a = _mm256_loadu_pd(reinterpret_cast<const double *>(&data[i + j]));
-                            __m256d b = _mm256_loadu_pd(reinterpret_cast<const double *>(&data[i + j + halfLen]));
-
-                            // Pass 'inverse' flag to helper
-                            dsp::simd::avx_butterfly_double(a, b, tw, inverse);
-
-                            _mm256_storeu_pd(reinterpret_cast<double *>(&data[i + j]), a);
-                            _mm256_storeu_pd(reinterpret_cast<double *>(&data[i + j + halfLen]), b);
-                            k += (2 * twiddle_step);
-                        }
-#endif
-                    }
-
-                    // --- SCALAR CLEANUP (Unchanged) ---
-                    for (; j < halfLen; ++j)
+                    kernels.fft_radix2_stage(reinterpret_cast<float *>(data), m_size, halfLen,
+                                             reinterpret_cast<const float *>(twiddles.data()),
+                                             twiddle_step, inverse);
+                }
+                else if constexpr (std::is_same_v<T, double>)
+                {
+                    kernels.fft_radix2_stage_double(reinterpret_cast<double *>(data), m_size, halfLen,
+                                                    reinterpret_cast<const double *>(twiddles.data()),
+                                                    twiddle_step, inverse);
+                }
+                else
+                {
+                    for (size_t i = 0; i < m_size; i += len)
                     {
-                        const Complex &twiddle = twiddles[k]; // Use forward twiddle
-                        if (inverse)
-                        {
-                            butterfly(data[i + j], data[i + j + halfLen], std::conj(twiddle));
-                        }
-                        else
+                        for (size_t j = 0, k = 0; j < halfLen; ++j, k += twiddle_step)
                         {
+                            const Complex twiddle = inverse ? std::conj(twiddles[k]) : twiddles[k];
                             butterfly(data[i + j], data[i + j + halfLen], twiddle);
                         }
-                        k += twiddle_step;
                     }
                 }
             }
@@ -32,6 +32,7 @@ namespace dsp
             {
                 // Allocate state buffer (need M previous samples)
                 m_state.resize(coefficients.size(), T(0));
+                m_scratch.resize(coefficients.size());
             }
         }
 
@@ -51,18 +52,17 @@ namespace dsp
 
             if constexpr (std::is_same_v<T, float>)
             {
-                // Build aligned buffer for SIMD (coefficients are in reverse order for convolution)
-                std::vector<float> aligned_samples(m_coefficients.size());
-
-                // Copy samples in correct order for dot product
+                // Gather the history into the preallocated scratch buffer
+                // (coefficients are in reverse order for convolution), so
+                // the per-sample path never touches the allocator
                 for (size_t i = 0; i < m_coefficients.size(); ++i)
                 {
                     size_t stateIdx = (m_stateIndex + m_state.size() - i) % m_state.size();
-                    aligned_samples[i] = m_state[stateIdx];
+                    m_scratch[i] = m_state[stateIdx];
                 }
 
                 // SIMD dot product
-                output = simd::dot_product(aligned_samples.data(), m_coefficients.data(),
+                output = simd::dot_product(m_scratch.data(), m_coefficients.data(),
                                            m_coefficients.size());
             }
             else
@@ -157,6 +157,7 @@ namespace dsp
             if (m_stateful)
             {
                 m_state.resize(coefficients.size(), T(0));
+                m_scratch.resize(coefficients.size());
                 m_stateIndex = 0;
             }
         }
@@ -121,6 +121,7 @@ namespace dsp
         private:
             std::vector<T> m_coefficients; // Filter coefficients (b[0], b[1], ..., b[M])
             std::vector<T> m_state;        // Sample history (x[n-1], x[n-2], ..., x[n-M])
+            std::vector<T> m_scratch;      // processSample(): history in dot-product order
             size_t m_stateIndex;           // Current position in circular state buffer
             bool m_stateful;               // Whether to maintain state between calls
 
@@ -0,0 +1,358 @@
+#include "KalmanFilter.h"
+#include "../utils/FloatBits.h"
+#include "../utils/SimdOps.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+using namespace dsp::core;
+
+namespace
+{
+    struct ModelName
+    {
+        KalmanModel model;
+        const char *name;
+    };
+
+    constexpr ModelName kModelNames[] = {
+        {KalmanModel::Level, "level"},
+        {KalmanModel::ConstantVelocity, "constantVelocity"},
+        {KalmanModel::Custom, "custom"},
+    };
+
+    // Riccati iterations allowed before the model is deemed to have no steady state
+    constexpr int kMaxRiccatiIterations = 100000;
+    constexpr double kRiccatiTolerance = 1e-12;
+
+    // NaN and infinite samples are dropouts
+    bool isMeasurement(float value) { return dsp::utils::isFinite(value); }
+
+    bool allFinite(const std::vector<float> &values)
+    {
+        return std::all_of(values.begin(), values.end(), [](float value)
+                           { return dsp::utils::isFinite(value); });
+    }
+}
+
+const char *dsp::core::kalmanModelName(KalmanModel model) noexcept
+{
+    for (const auto &entry : kModelNames)
+    {
+        if (entry.model == model)
+        {
+            return entry.name;
+        }
+    }
+    return "";
+}
+
+bool dsp::core::parseKalmanModel(const std::string &name, KalmanModel &model) noexcept
+{
+    for (const auto &entry : kModelNames)
+    {
+        if (name == entry.name)
+        {
+            model = entry.model;
+            return true;
+        }
+    }
+    return false;
+}
+
+// -----------------------------------------------------------------------------
+// Constructor
+// -----------------------------------------------------------------------------
+KalmanFilter::KalmanFilter(size_t channels, const KalmanOptions &options)
+    : m_channels(channels), m_options(options), m_states(0)
+{
+    if (channels == 0)
+    {
+        throw std::invalid_argument("KalmanFilter: channel count must be greater than 0");
+    }
+    if (!(options.measurementNoise > 0.0f) || !dsp::utils::isFinite(options.measurementNoise))
+    {
+        throw std::invalid_argument("KalmanFilter: measurementNoise must be positive");
+    }
+    if (!(options.initialCovariance > 0.0f) || !dsp::utils::isFinite(options.initialCovariance))
+    {
+        throw std::invalid_argument("KalmanFilter: initialCovariance must be positive");
+    }
+
+    const float q = options.processNoise;
+    switch (options.model)
+    {
+    case KalmanModel::Level:
+    case KalmanModel::ConstantVelocity:
+        if (!(q >= 0.0f) || !dsp::utils::isFinite(q))
+        {
+            throw std::invalid_argument("KalmanFilter: processNoise must be non-negative");
+        }
+        if (options.model == KalmanModel::Level)
+        {
+            m_states = 1;
+            m_transition = {1.0f};
+            m_observation = {1.0f};
+            m_processCovariance = {q};
+        }
+        else
+        {
+            const float dt = options.dt;
+            if (!(dt > 0.0f) || !dsp::utils::isFinite(dt))
+            {
+                throw std::invalid_argument("KalmanFilter: dt must be positive");
+            }
+            // Discrete white-noise acceleration: G = (dt^2 / 2, dt), Q = q G G^T
+            const float g0 = 0.5f * dt * dt;
+            const float g1 = dt;
+            m_states = 2;
+            m_transition = {1.0f, dt, 0.0f, 1.0f};
+            m_observation = {1.0f, 0.0f};
+            m_processCovariance = {q * g0 * g0, q * g0 * g1, q * g1 * g0, q * g1 * g1};
+        }
+        break;
+
+    case KalmanModel::Custom:
+    {
+        const size_t n = options.observation.size();
+        if (n == 0 || n > dsp::simd::kMaxKalmanStates)
+        {
+            throw std::invalid_argument("KalmanFilter: a custom model needs 1 to " +
+                                        std::to_string(dsp::simd::kMaxKalmanStates) + " states, got " +
+                                        std::to_string(n));
+        }
+        if (options.transition.size() != n * n || options.processCovariance.size() != n * n)
+        {
+            throw std::invalid_argument("KalmanFilter: transition and processCovariance must be " +
+                                        std::to_string(n) + "x" + std::to_string(n) + " for " +
+                                        std::to_string(n) + " states");
+        }
+        if (!allFinite(options.transition) || !allFinite(options.observation) ||
+            !allFinite(options.processCovariance))
+        {
+            throw std::invalid_argument("KalmanFilter: model matrices must be finite");
+        }
+        if (std::all_of(options.observation.begin(), options.observation.end(), [](float h)
+                        { return h == 0.0f; }))
+        {
+            throw std::invalid_argument("KalmanFilter: observation must not be all zeros");
+        }
+        for (size_t i = 0; i < n; ++i)
+        {
+            if (options.processCovariance[i * n + i] < 0.0f)
+            {
+                throw std::invalid_argument("KalmanFilter: processCovariance must have a non-negative diagonal");
+            }
+            for (size_t j = i + 1; j < n; ++j)
+            {
+                if (options.processCovariance[i * n + j] != options.processCovariance[j * n + i])
+                {
+                    throw std::invalid_argument("KalmanFilter: processCovariance must be symmetric");
+                }
+            }
+        }
+        m_states = n;
+        m_transition = options.transition;
+        m_observation = options.observation;
+        m_processCovariance = options.processCovariance;
+        break;
+    }
+
+    default:
+        throw std::invalid_argument("KalmanFilter: unknown model");
+    }
+
+    if (options.steadyState)
+    {
+        computeSteadyStateGain();
+    }
+
+    m_state.assign(m_states * channels, 0.0f);
+    if (!options.steadyState)
+    {
+        m_covariance.assign(m_states * m_states * channels, 0.0f);
+    }
+    reset();
+}
+
+// -----------------------------------------------------------------------------
+// Method: process
+// -----------------------------------------------------------------------------
+void KalmanFilter::process(float *frames, size_t numFrames)
+{
+    if (numFrames == 0)
+    {
+        return;
+    }
+    if (!m_initialized)
+    {
+        seed(frames);
+    }
+
+    dsp::simd::KalmanFrames run;
+    run.frames = frames;
+    run.state = m_state.data();
+    run.covariance = m_covariance.empty() ? nullptr : m_covariance.data();
+    run.transition = m_transition.data();
+    run.observation = m_observation.data();
+    run.processNoise = m_processCovariance.data();
+    run.gain = m_gain.empty() ? nullptr : m_gain.data();
+    run.measurementNoise = m_options.measurementNoise;
+    run.channels = m_channels;
+    run.numFrames = numFrames;
+    run.states = m_states;
+    if (m_options.steadyState)
+    {
+        run.form = dsp::simd::KalmanForm::SteadyState;
+    }
+    else if (m_options.model == KalmanModel::ConstantVelocity)
+    {
+        run.form = dsp::simd::KalmanForm::ConstantVelocity;
+    }
+    else
+    {
+        run.form = dsp::simd::KalmanForm::General;
+    }
+    dsp::simd::kalman_frames(run);
+}
+
+void KalmanFilter::seed(const float *frame)
+{
+    double norm = 0.0;
+    for (float h : m_observation)
+    {
+        norm += static_cast<double>(h) * h;
+    }
+    for (size_t c = 0; c < m_channels; ++c)
+    {
+        if (!isMeasurement(frame[c]))
+        {
+            continue;
+        }
+        for (size_t i = 0; i < m_states; ++i)
+        {
+            m_state[i * m_channels + c] = static_cast<float>(m_observation[i] * frame[c] / norm);
+        }
+    }
+    m_initialized = true;
+}
+
+// -----------------------------------------------------------------------------
+// Steady-state gain
+// -----------------------------------------------------------------------------
+void KalmanFilter::computeSteadyStateGain()
+{
+    const size_t n = m_states;
+    const std::vector<double> F(m_transition.begin(), m_transition.end());
+    const std::vector<double> H(m_observation.begin(), m_observation.end());
+    const std::vector<double> Q(m_processCovariance.begin(), m_processCovariance.end());
+    const double R = m_options.measurementNoise;
+
+    std::vector<double> P(n * n, 0.0), FP(n * n), Pp(n * n), ph(n), K(n, 0.0);
+    for (size_t i = 0; i < n; ++i)
+    {
+        P[i * n + i] = m_options.initialCovariance;
+    }
+
+    for (int iteration = 0; iteration < kMaxRiccatiIterations; ++iteration)
+    {
+        // P- = F P F^T + Q
+        for (size_t i = 0; i < n; ++i)
+        {
+            for (size_t k = 0; k < n; ++k)
+            {
+                double acc = 0.0;
+                for (size_t j = 0; j < n; ++j)
+                {
+                    acc += F[i * n + j] * P[j * n + k];
+                }
+                FP[i * n + k] = acc;
+            }
+        }
+        for (size_t i = 0; i < n; ++i)
+        {
+            for (size_t l = 0; l < n; ++l)
+            {
+                double acc = Q[i * n + l];
+                for (size_t k = 0; k < n; ++k)
+                {
+                    acc += FP[i * n + k] * F[l * n + k];
+                }
+                Pp[i * n + l] = acc;
+            }
+        }
+
+        double s = R;
+        for (size_t i = 0; i < n; ++i)
+        {
+            double acc = 0.0;
+            for (size_t j = 0; j < n; ++j)
+            {
+                acc += Pp[i * n + j] * H[j];
+            }
+            ph[i] = acc;
+            s += H[i] * acc;
+        }
+
+        double change = 0.0, size = 0.0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            const double gain = ph[i] / s;
+            change = std::max(change, std::abs(gain - K[i]));
+            size = std::max(size, std::abs(gain));
+            K[i] = gain;
+            for (size_t j = 0; j < n; ++j)
+            {
+                P[i * n + j] = Pp[i * n + j] - ph[i] * ph[j] / s;
+            }
+        }
+        if (!dsp::utils::isFinite(s) || !dsp::utils::isFinite(change))
+        {
+            break;
+        }
+        if (iteration > 0 && change <= kRiccatiTolerance * std::max(size, 1e-6))
+        {
+            m_gain.assign(K.begin(), K.end());
+            return;
+        }
+    }
+
+    throw std::invalid_argument("KalmanFilter: the model has no steady-state gain "
+                                "(it must be observable, with processNoise > 0)");
+}
+
+// -----------------------------------------------------------------------------
+// State
+// -----------------------------------------------------------------------------
+void KalmanFilter::setState(const std::vector<float> &state, const std::vector<float> &covariance, bool initialized)
+{
+    if (state.size() != m_state.size() || covariance.size() != m_covariance.size())
+    {
+        throw std::runtime_error("KalmanFilter: expected " + std::to_string(m_state.size()) + " state and " +
+                                 std::to_string(m_covariance.size()) + " covariance values");
+    }
+    if (!allFinite(state) || !allFinite(covariance))
+    {
+        throw std::runtime_error("KalmanFilter: state values must be finite");
+    }
+
+    m_state = state;
+    m_covariance = covariance;
+    m_initialized = initialized;
+}
+
+void KalmanFilter::reset()
+{
+    std::fill(m_state.begin(), m_state.end(), 0.0f);
+    std::fill(m_covariance.begin(), m_covariance.end(), 0.0f);
+    if (!m_covariance.empty())
+    {
+        for (size_t i = 0; i < m_states; ++i)
+        {
+            float *diagonal = m_covariance.data() + (i * m_states + i) * m_channels;
+            std::fill(diagonal, diagonal + m_channels, m_options.initialCovariance);
+        }
+    }
+    m_initialized = false;
+}
@@ -0,0 +1,140 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace dsp::core
+{
+    /**
+     * @brief State-space model shared by every channel of a KalmanFilter.
+     */
+    enum class KalmanModel
+    {
+        Level,            // x = level (random walk): F = [1], H = [1], Q = [q]
+        ConstantVelocity, // x = (position, velocity): F = [1 dt; 0 1], H = [1 0], white acceleration noise
+        Custom            // F, H and Q given explicitly
+    };
+
+    /**
+     * @brief Model name as used in stage parameters ("level", "constantVelocity", "custom").
+     */
+    const char *kalmanModelName(KalmanModel model) noexcept;
+
+    /**
+     * @brief Parses a name returned by kalmanModelName().
+     * @return false if the name is unknown
+     */
+    bool parseKalmanModel(const std::string &name, KalmanModel &model) noexcept;
+
+    struct KalmanOptions
+    {
+        KalmanModel model = KalmanModel::Level;
+        float processNoise = 1e-4f;     // Level: variance of a step; ConstantVelocity: acceleration variance
+        float measurementNoise = 1e-2f; // R: variance of a measurement
+        float dt = 1.0f;                // ConstantVelocity: time between frames
+        float initialCovariance = 1.0f; // P starts at initialCovariance * I
+        bool steadyState = false;       // Run with the converged gain and no covariance
+
+        // Custom only; the state size is observation.size()
+        std::vector<float> transition;        // F, states x states row-major
+        std::vector<float> observation;       // H, states
+        std::vector<float> processCovariance; // Q, states x states row-major
+    };
+
+    /**
+     * @brief A bank of independent Kalman filters, one per channel, over
+     * one shared small state-space model with a scalar measurement:
+     *
+     *   x- = F x,  P- = F P F^T + Q
+     *   K = P- H^T / (H P- H^T + R),  x = x- + K (z - H x-),  P = P- - K H P-
+     *
+     * The output of each frame is the filtered measurement H x. Channels
+     * are laid out structure-of-arrays (see simd::KalmanFrames), so a frame
+     * of hundreds of channels is a handful of contiguous SIMD loops
+     * (simd::kalman_frames) instead of hundreds of tiny matrix products.
+     *
+     * Two fast paths: the constant-velocity model has a closed-form update,
+     * and with steadyState the gain is computed once up front by iterating
+     * the Riccati recursion to convergence (in double), after which a frame
+     * is just x = F x + K (z - H F x) with no covariance at all. P- and K
+     * do not depend on the data, so every channel converges to the same
+     * gain; steadyState only gives up the faster start of the time-varying
+     * gain.
+     *
+     * The first frame after construction or reset() seeds each channel's
+     * state with the least-squares fit of its measurement,
+     * x = H^T z / (H H^T), rather than starting from zero. A non-finite
+     * measurement (a dropout) skips the update of that channel: the filter
+     * predicts through it.
+     */
+    class KalmanFilter
+    {
+    public:
+        /**
+         * @param channels Independent filters in the bank.
+         * @param options Model and noise levels.
+         * @throws std::invalid_argument on an invalid model, or with
+         *         steadyState if the Riccati recursion does not converge
+         */
+        KalmanFilter(size_t channels, const KalmanOptions &options);
+
+        /**
+         * @brief Filters numFrames interleaved frames in place.
+         * @param frames numFrames * getChannels() measurements, replaced by the estimates.
+         */
+        void process(float *frames, size_t numFrames);
+
+        size_t getChannels() const noexcept { return m_channels; }
+        size_t getStates() const noexcept { return m_states; }
+        const KalmanOptions &getOptions() const noexcept { return m_options; }
+
+        /**
+         * @brief states x channels, state-major: entry i of channel c at i * channels + c.
+         */
+        const std::vector<float> &getState() const noexcept { return m_state; }
+
+        /**
+         * @brief states x states x channels, entry-major: P(i, j) of channel c at
+         * (i * states + j) * channels + c. Empty with steadyState.
+         */
+        const std::vector<float> &getCovariance() const noexcept { return m_covariance; }
+
+        /**
+         * @brief The steady-state gain (states entries), empty without steadyState.
+         */
+        const std::vector<float> &getGain() const noexcept { return m_gain; }
+
+        /**
+         * @brief Whether the state has been seeded from a first frame.
+         */
+        bool isInitialized() const noexcept { return m_initialized; }
+
+        /**
+         * @brief Restores getState() / getCovariance() / isInitialized() results.
+         */
+        void setState(const std::vector<float> &state, const std::vector<float> &covariance, bool initialized);
+
+        /**
+         * @brief Zeroes the state and resets P to initialCovariance * I.
+         */
+        void reset();
+
+    private:
+        void computeSteadyStateGain();
+        void seed(const float *frame);
+
+        size_t m_channels;
+        KalmanOptions m_options;
+        size_t m_states;
+
+        std::vector<float> m_transition;        // F
+        std::vector<float> m_observation;       // H
+        std::vector<float> m_processCovariance; // Q
+        std::vector<float> m_gain;              // steady-state K
+
+        std::vector<float> m_state;
+        std::vector<float> m_covariance;
+        bool m_initialized = false;
+    };
+
+} // namespace dsp::core
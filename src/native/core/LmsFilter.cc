@@ -0,0 +1,133 @@
+#include "LmsFilter.h"
+#include "../utils/FloatBits.h"
+#include "../utils/SimdOps.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+using namespace dsp::core;
+
+// -----------------------------------------------------------------------------
+// Constructor
+// -----------------------------------------------------------------------------
+LmsFilter::LmsFilter(size_t channels, size_t numTaps, float stepSize, bool normalized, float epsilon)
+    : m_channels(channels), m_numTaps(numTaps), m_stepSize(stepSize), m_normalized(normalized), m_epsilon(epsilon)
+{
+    if (channels == 0)
+    {
+        throw std::invalid_argument("LmsFilter: at least one primary channel is required");
+    }
+    if (numTaps == 0)
+    {
+        throw std::invalid_argument("LmsFilter: numTaps must be greater than 0");
+    }
+    if (!(stepSize > 0.0f) || !dsp::utils::isFinite(stepSize))
+    {
+        throw std::invalid_argument("LmsFilter: stepSize must be positive");
+    }
+    if (normalized && stepSize >= 2.0f)
+    {
+        throw std::invalid_argument("LmsFilter: NLMS stepSize must be below 2 to converge");
+    }
+    // NLMS divides by epsilon while the reference window is silent. Below
+    // the smallest normal float the rate overflows (and -ffast-math flushes
+    // epsilon to 0), so inf * 0 would turn the weights into NaN
+    const float minEpsilon = normalized ? std::numeric_limits<float>::min() : 0.0f;
+    if (!(epsilon >= minEpsilon) || !dsp::utils::isFinite(epsilon))
+    {
+        throw std::invalid_argument(normalized ? "LmsFilter: NLMS epsilon must be positive"
+                                               : "LmsFilter: epsilon must be non-negative");
+    }
+
+    m_weights.assign(channels * numTaps, 0.0f);
+    m_history.assign(2 * numTaps, 0.0f);
+}
+
+// -----------------------------------------------------------------------------
+// Method: processFrame
+// -----------------------------------------------------------------------------
+void LmsFilter::processFrame(const float *primary, float reference, float *error)
+{
+    const size_t N = m_numTaps;
+
+    // Step back one slot: it holds the sample leaving the window
+    m_position = (m_position == 0 ? N : m_position) - 1;
+    const float leaving = m_history[m_position];
+    m_history[m_position] = reference;
+    m_history[m_position + N] = reference;
+    const float *x = m_history.data() + m_position;
+
+    if (m_normalized)
+    {
+        // Running |x_n|^2, re-summed once per wrap so rounding cannot build up
+        if (m_position == 0)
+        {
+            m_energy = dsp::simd::sum_of_squares(x, N);
+        }
+        else
+        {
+            m_energy += static_cast<double>(reference) * reference - static_cast<double>(leaving) * leaving;
+            m_energy = std::max(m_energy, 0.0);
+        }
+    }
+    const float rate = m_normalized ? static_cast<float>(m_stepSize / (m_epsilon + m_energy)) : m_stepSize;
+
+    for (size_t c = 0; c < m_channels; ++c)
+    {
+        float *w = m_weights.data() + c * N;
+        const float e = primary[c] - dsp::simd::dot_product(w, x, N);
+        dsp::simd::scaled_add(w, x, rate * e, N);
+        error[c] = e;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Method: process
+// -----------------------------------------------------------------------------
+void LmsFilter::process(const float *primary, const float *reference, float *error, size_t numFrames)
+{
+    for (size_t f = 0; f < numFrames; ++f)
+    {
+        processFrame(primary + f * m_channels, reference[f], error + f * m_channels);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// State
+// -----------------------------------------------------------------------------
+std::vector<float> LmsFilter::getHistory() const
+{
+    return std::vector<float>(m_history.begin() + m_position, m_history.begin() + m_position + m_numTaps);
+}
+
+void LmsFilter::setState(const std::vector<float> &weights, const std::vector<float> &history)
+{
+    if (weights.size() != m_weights.size() || history.size() != m_numTaps)
+    {
+        throw std::runtime_error("LmsFilter: expected " + std::to_string(m_weights.size()) + " weights and " +
+                                 std::to_string(m_numTaps) + " history samples");
+    }
+    for (float value : weights)
+    {
+        if (!dsp::utils::isFinite(value))
+        {
+            throw std::runtime_error("LmsFilter: weights must be finite");
+        }
+    }
+
+    m_weights = weights;
+    m_position = 0;
+    std::copy(history.begin(), history.end(), m_history.begin());
+    std::copy(history.begin(), history.end(), m_history.begin() + m_numTaps);
+    m_energy = dsp::simd::sum_of_squares(history.data(), m_numTaps);
+}
+
+void LmsFilter::reset()
+{
+    std::fill(m_weights.begin(), m_weights.end(), 0.0f);
+    std::fill(m_history.begin(), m_history.end(), 0.0f);
+    m_position = 0;
+    m_energy = 0.0;
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+namespace dsp::core
+{
+    /**
+     * @brief Adaptive FIR filter (LMS / NLMS) for reference-based noise cancellation.
+     *
+     * Every primary channel has its own numTaps weights over the shared
+     * reference signal x. Per frame and channel:
+     *
+     *   y = w^T x_n,  e = d - y,  w += mu_n * e * x_n
+     *
+     * where x_n = (x[n], x[n-1], ..., x[n-numTaps+1]) and d is the primary
+     * sample. e is the output: the primary with the part predictable from
+     * the reference (powerline hum, motion artifacts) removed. LMS uses
+     * mu_n = stepSize; NLMS uses mu_n = stepSize / (epsilon + |x_n|^2), which
+     * makes convergence independent of the reference level (stable for
+     * 0 < stepSize < 2).
+     *
+     * The reference history is kept twice over (2 * numTaps samples), so
+     * x_n is always one contiguous run and both the output and the weight
+     * update are single SIMD passes (simd::dot_product, simd::scaled_add).
+     */
+    class LmsFilter
+    {
+    public:
+        /**
+         * @brief Constructs the filter with zero weights and history.
+         * @param channels Primary channels adapted against the reference.
+         * @param numTaps Weights per channel.
+         * @param stepSize Adaptation rate (mu).
+         * @param normalized true for NLMS.
+         * @param epsilon NLMS regularization added to the reference energy (positive for NLMS).
+         */
+        LmsFilter(size_t channels, size_t numTaps, float stepSize, bool normalized, float epsilon = 1e-6f);
+
+        /**
+         * @brief Filters one frame and adapts the weights.
+         * @param primary getChannels() primary samples.
+         * @param reference The reference sample of the frame.
+         * @param error getChannels() outputs (primary minus estimate); may alias primary.
+         */
+        void processFrame(const float *primary, float reference, float *error);
+
+        /**
+         * @brief Filters numFrames frames.
+         * @param primary numFrames * getChannels() interleaved samples.
+         * @param reference numFrames reference samples.
+         * @param error numFrames * getChannels() outputs; may alias primary.
+         */
+        void process(const float *primary, const float *reference, float *error, size_t numFrames);
+
+        size_t getChannels() const noexcept { return m_channels; }
+        size_t getNumTaps() const noexcept { return m_numTaps; }
+        float getStepSize() const noexcept { return m_stepSize; }
+        bool isNormalized() const noexcept { return m_normalized; }
+        float getEpsilon() const noexcept { return m_epsilon; }
+
+        /**
+         * @brief channels x numTaps weights; weight i of a channel multiplies x[n-i].
+         */
+        const std::vector<float> &getWeights() const noexcept { return m_weights; }
+
+        /**
+         * @brief The last numTaps reference samples, newest first.
+         */
+        std::vector<float> getHistory() const;
+
+        /**
+         * @brief Restores getWeights() / getHistory() results.
+         */
+        void setState(const std::vector<float> &weights, const std::vector<float> &history);
+
+        /**
+         * @brief Zeroes the weights and the history.
+         */
+        void reset();
+
+    private:
+        size_t m_channels;
+        size_t m_numTaps;
+        float m_stepSize;
+        bool m_normalized;
+        float m_epsilon;
+
+        std::vector<float> m_weights;
+        std::vector<float> m_history; // 2 * numTaps, mirrored; x_n starts at m_position
+        size_t m_position = 0;
+        double m_energy = 0.0; // |x_n|^2
+    };
+
+} // namespace dsp::core
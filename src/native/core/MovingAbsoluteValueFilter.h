@@ -69,6 +69,19 @@ namespace dsp::core
          */
         T addSample(T newValue) { return m_filter.addSample(newValue); }
 
+        /**
+         * @brief Adds a chunk of samples (sample-count mode), replacing each with its mean absolute value.
+         * @param samples First sample (in-place).
+         * @param count Number of samples.
+         * @param stride Distance between consecutive samples (channel count for interleaved data).
+         */
+        void addSamples(T *samples, size_t count, size_t stride = 1) { m_filter.addSamples(samples, count, stride); }
+
+        /**
+         * @brief Preallocates for chunks of up to maxCount samples (see SlidingWindowFilter::reserve()).
+         */
+        void reserve(size_t maxCount) { m_filter.reserve(maxCount); }
+
         /**
          * @brief Adds a new sample with timestamp (time-aware mode).
          * @param newValue The new sample value to add (can be negative).
@@ -97,6 +110,11 @@ namespace dsp::core
          */
         bool isFull() const noexcept { return m_filter.isFull(); }
 
+        /**
+         * @brief Gets the number of samples currently in the window.
+         */
+        size_t getCount() const noexcept { return m_filter.getCount(); }
+
         /**
          * @brief Checks if the filter is in time-aware mode.
          * @return true if time-aware, false otherwise.
@@ -129,6 +147,11 @@ namespace dsp::core
             m_filter.setState(bufferData, sumOfAbs);
         }
 
+        /**
+         * @brief Gets the window's position in its push history (for delta snapshots).
+         */
+        dsp::utils::WindowMark getWindowMark() const noexcept { return m_filter.getWindowMark(); }
+
     private:
         SlidingWindowFilter<T, MeanAbsoluteValuePolicy<T>> m_filter;
     };
@@ -0,0 +1,20 @@
+/**
+ * @file MovingPercentileFilter.cc
+ * @brief Implementation file for MovingPercentileFilter (header-only with policy-based design)
+ *
+ * This file only contains explicit template instantiations.
+ * The exact filter delegates to SlidingWindowFilter<T, PercentilePolicy<T>>;
+ * the approximate filter is built on the P2Quantile estimator.
+ */
+
+#include "MovingPercentileFilter.h"
+
+// Explicit template instantiation for common types
+namespace dsp::core
+{
+    template class MovingPercentileFilter<float>;
+    template class MovingPercentileFilter<double>;
+
+    template class ApproxMovingPercentileFilter<float>;
+    template class ApproxMovingPercentileFilter<double>;
+}
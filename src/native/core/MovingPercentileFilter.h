@@ -0,0 +1,261 @@
+#pragma once
+#include "../utils/FloatBits.h"
+#include "../utils/SlidingWindowFilter.h"
+#include "Policies.h"
+#include "P2Quantile.h"
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace dsp::core
+{
+    using dsp::utils::SlidingWindowFilter;
+
+    /**
+     * @brief Exact sliding-window percentile (median when quantile = 0.5).
+     *
+     * Thin wrapper around SlidingWindowFilter using PercentilePolicy, which
+     * keeps the window in a lazily-pruned double heap so every update is
+     * O(log w).
+     *
+     * @tparam T The numeric type of the samples (e.g., float, double).
+     */
+    template <typename T>
+    class MovingPercentileFilter
+    {
+    public:
+        /**
+         * @brief Constructs a new Moving Percentile Filter.
+         * @param window_size The number of samples in the window (N).
+         * @param quantile The quantile to track, in [0, 1].
+         */
+        explicit MovingPercentileFilter(size_t window_size, double quantile)
+            : m_filter(window_size, PercentilePolicy<T>(quantile))
+        {
+            if (window_size == 0)
+            {
+                throw std::invalid_argument("Window size must be greater than 0");
+            }
+            validateQuantile(quantile);
+        }
+
+        /**
+         * @brief Constructs a new time-aware Moving Percentile Filter.
+         * @param window_size The maximum number of samples in the window (N).
+         * @param window_duration_ms The maximum age of samples in milliseconds.
+         * @param quantile The quantile to track, in [0, 1].
+         */
+        explicit MovingPercentileFilter(size_t window_size, double window_duration_ms, double quantile)
+            : m_filter(window_size, window_duration_ms, PercentilePolicy<T>(quantile))
+        {
+            if (window_size == 0)
+            {
+                throw std::invalid_argument("Window size must be greater than 0");
+            }
+            if (window_duration_ms <= 0.0)
+            {
+                throw std::invalid_argument("Window duration must be positive");
+            }
+            validateQuantile(quantile);
+        }
+
+        // Delete copy constructor and copy assignment
+        MovingPercentileFilter(const MovingPercentileFilter &) = delete;
+        MovingPercentileFilter &operator=(const MovingPercentileFilter &) = delete;
+
+        // Enable move semantics
+        MovingPercentileFilter(MovingPercentileFilter &&) noexcept = default;
+        MovingPercentileFilter &operator=(MovingPercentileFilter &&) noexcept = default;
+
+        /**
+         * @brief Adds a new sample to the filter.
+         * @param newValue The new sample value to add.
+         * @return T The percentile of the current window.
+         */
+        T addSample(T newValue) { return m_filter.addSample(newValue); }
+
+        /**
+         * @brief Adds a new sample with timestamp (time-aware mode only).
+         * @param newValue The new sample value to add.
+         * @param timestamp The timestamp in milliseconds.
+         * @return T The percentile of the current window.
+         */
+        T addSampleWithTimestamp(T newValue, double timestamp)
+        {
+            return m_filter.addSampleWithTimestamp(newValue, timestamp);
+        }
+
+        /**
+         * @brief Checks if this is a time-aware filter.
+         */
+        bool isTimeAware() const noexcept { return m_filter.isTimeAware(); }
+
+        /**
+         * @brief Gets the percentile of the samples currently in the window.
+         */
+        T getPercentile() const { return m_filter.getPolicy().getResult(m_filter.getCount()); }
+
+        /**
+         * @brief Gets the tracked quantile in [0, 1].
+         */
+        double getQuantile() const { return m_filter.getPolicy().getState(); }
+
+        /**
+         * @brief Clears all samples from the filter.
+         */
+        void clear() { m_filter.clear(); }
+
+        /**
+         * @brief Checks if the filter's buffer is full (i.e., has N samples).
+         */
+        bool isFull() const noexcept { return m_filter.isFull(); }
+
+        /**
+         * @brief Gets the number of samples currently in the window.
+         */
+        size_t getCount() const noexcept { return m_filter.getCount(); }
+
+        /**
+         * @brief Exports the window contents (oldest first).
+         *
+         * The heaps are derived data, so the window alone is the full state.
+         */
+        std::vector<T> getState() const { return m_filter.getBufferContents(); }
+
+        /**
+         * @brief Restores the window contents and rebuilds the heaps.
+         * @param bufferData The window contents (oldest first).
+         */
+        void setState(const std::vector<T> &bufferData)
+        {
+            m_filter.setBufferContents(bufferData);
+            auto &policy = m_filter.getPolicy();
+            policy.clear();
+            for (const auto &value : bufferData)
+            {
+                policy.onAdd(value);
+            }
+        }
+
+    private:
+        static void validateQuantile(double quantile)
+        {
+            if (!(quantile >= 0.0 && quantile <= 1.0))
+            {
+                throw std::invalid_argument("Quantile must be between 0 and 1");
+            }
+        }
+
+        SlidingWindowFilter<T, PercentilePolicy<T>> m_filter;
+    };
+
+    /**
+     * @brief Approximate sliding-window percentile with O(1) memory.
+     *
+     * Runs two P² estimators staggered by half a window. Each estimator is
+     * restarted every window_size samples, and the output always comes from
+     * the one that has seen more data, so the answer describes roughly the
+     * most recent window_size / 2 .. window_size samples. Intended for very
+     * long windows where storing every sample is undesirable.
+     *
+     * @tparam T The numeric type of the samples (e.g., float, double).
+     */
+    template <typename T>
+    class ApproxMovingPercentileFilter
+    {
+    public:
+        /**
+         * @brief Constructs a new approximate Moving Percentile Filter.
+         * @param window_size The nominal window length in samples (N).
+         * @param quantile The quantile to track, in [0, 1].
+         */
+        explicit ApproxMovingPercentileFilter(size_t window_size, double quantile)
+            : m_window_size(window_size),
+              m_half_window(std::max<size_t>(1, window_size / 2)),
+              m_estimators{P2Quantile(quantile), P2Quantile(quantile)}
+        {
+            if (window_size == 0)
+            {
+                throw std::invalid_argument("Window size must be greater than 0");
+            }
+            if (!(quantile >= 0.0 && quantile <= 1.0))
+            {
+                throw std::invalid_argument("Quantile must be between 0 and 1");
+            }
+        }
+
+        /**
+         * @brief Adds a new sample to the filter.
+         * @param newValue The new sample value to add.
+         * @return T The estimated percentile of the recent window.
+         */
+        T addSample(T newValue)
+        {
+            double x = static_cast<double>(newValue);
+
+            // NaN samples are skipped, as by the exact filter's policy
+            if (!dsp::utils::isNaN(x))
+            {
+                feed(m_estimators[0], x);
+                // The second estimator starts half a window late
+                if (m_total >= m_half_window)
+                {
+                    feed(m_estimators[1], x);
+                }
+                ++m_total;
+            }
+
+            const P2Quantile &older = (m_estimators[0].getCount() >= m_estimators[1].getCount())
+                                          ? m_estimators[0]
+                                          : m_estimators[1];
+            return static_cast<T>(older.getResult());
+        }
+
+        void clear()
+        {
+            m_estimators[0].reset();
+            m_estimators[1].reset();
+            m_total = 0;
+        }
+
+        size_t getWindowSize() const { return m_window_size; }
+        double getQuantile() const { return m_estimators[0].getQuantile(); }
+
+        /**
+         * @brief Exports the filter state: total sample count plus both
+         * estimators' marker states.
+         */
+        std::pair<size_t, std::pair<std::vector<double>, std::vector<double>>> getState() const
+        {
+            return {m_total, {m_estimators[0].getState(), m_estimators[1].getState()}};
+        }
+
+        /**
+         * @brief Restores the filter state produced by getState().
+         */
+        void setState(size_t total, const std::vector<double> &first, const std::vector<double> &second)
+        {
+            if (!m_estimators[0].setState(first) || !m_estimators[1].setState(second))
+            {
+                clear();
+                throw std::runtime_error("Invalid P2 estimator state");
+            }
+            m_total = total;
+        }
+
+    private:
+        void feed(P2Quantile &estimator, double x)
+        {
+            if (estimator.getCount() >= m_window_size)
+            {
+                estimator.reset();
+            }
+            estimator.add(x);
+        }
+
+        size_t m_window_size;
+        size_t m_half_window;
+        P2Quantile m_estimators[2];
+        size_t m_total = 0;
+    };
+} // namespace dsp::core
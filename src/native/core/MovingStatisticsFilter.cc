@@ -0,0 +1,56 @@
+/**
+ * @file MovingStatisticsFilter.cc
+ * @brief Statistic names and explicit template instantiations for MovingStatisticsFilter.
+ * The filter itself is header-only and delegates to
+ * SlidingWindowFilter<T, MovingStatisticsPolicy<T>>.
+ */
+
+#include "MovingStatisticsFilter.h"
+
+namespace dsp::core
+{
+    namespace
+    {
+        struct StatisticName
+        {
+            MovingStatistic statistic;
+            const char *name;
+        };
+
+        constexpr StatisticName kStatisticNames[] = {
+            {MovingStatistic::Mean, "mean"},
+            {MovingStatistic::Rms, "rms"},
+            {MovingStatistic::MeanAbsoluteValue, "meanAbsoluteValue"},
+            {MovingStatistic::Variance, "variance"},
+        };
+    }
+
+    const char *movingStatisticName(MovingStatistic statistic) noexcept
+    {
+        for (const auto &entry : kStatisticNames)
+        {
+            if (entry.statistic == statistic)
+            {
+                return entry.name;
+            }
+        }
+        return "unknown";
+    }
+
+    bool parseMovingStatistic(const std::string &name, MovingStatistic &statistic) noexcept
+    {
+        for (const auto &entry : kStatisticNames)
+        {
+            if (name == entry.name)
+            {
+                statistic = entry.statistic;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Explicit template instantiation for common types
+    template class MovingStatisticsFilter<float>;
+    template class MovingStatisticsFilter<double>;
+}
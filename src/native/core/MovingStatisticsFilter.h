@@ -0,0 +1,122 @@
+#pragma once
+#include "../utils/SlidingWindowFilter.h"
+#include "Policies.h"
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace dsp::core
+{
+    using dsp::utils::SlidingWindowFilter;
+
+    /**
+     * @brief A statistic reported by MovingStatisticsFilter; the value is
+     * its index in the filter's result array.
+     */
+    enum class MovingStatistic
+    {
+        Mean = 0,
+        Rms = 1,
+        MeanAbsoluteValue = 2,
+        Variance = 3
+    };
+
+    /**
+     * @brief Statistic name as used in stage parameters ("mean", "rms", "meanAbsoluteValue", "variance").
+     */
+    const char *movingStatisticName(MovingStatistic statistic) noexcept;
+
+    /**
+     * @brief Parses a name returned by movingStatisticName().
+     * @return false if the name is unknown
+     */
+    bool parseMovingStatistic(const std::string &name, MovingStatistic &statistic) noexcept;
+
+    /**
+     * @brief Mean, RMS, mean absolute value and variance over one shared window.
+     *
+     * A thin wrapper around SlidingWindowFilter with MovingStatisticsPolicy
+     * (a CompositePolicy): one ring buffer and one push/pop per sample,
+     * with every statistic returned by each addSample(). Each result equals
+     * what the matching single-statistic filter reports for the same samples.
+     *
+     * @tparam T The numeric type of the samples (e.g., float, double).
+     */
+    template <typename T>
+    class MovingStatisticsFilter
+    {
+    public:
+        using Result = typename MovingStatisticsPolicy<T>::Result;
+
+        /**
+         * @brief Constructs a new Moving Statistics Filter.
+         * @param window_size The number of samples in the window.
+         */
+        explicit MovingStatisticsFilter(size_t window_size)
+            : m_filter(window_size, MovingStatisticsPolicy<T>{})
+        {
+            if (window_size == 0)
+            {
+                throw std::invalid_argument("Window size must be greater than 0");
+            }
+        }
+
+        // Delete copy constructor and copy assignment
+        MovingStatisticsFilter(const MovingStatisticsFilter &) = delete;
+        MovingStatisticsFilter &operator=(const MovingStatisticsFilter &) = delete;
+
+        // Enable move semantics
+        MovingStatisticsFilter(MovingStatisticsFilter &&) noexcept = default;
+        MovingStatisticsFilter &operator=(MovingStatisticsFilter &&) noexcept = default;
+
+        /**
+         * @brief Adds a new sample to the filter.
+         * @param newValue The new sample value to add.
+         * @return Result Every statistic, indexed by MovingStatistic.
+         */
+        Result addSample(T newValue) { return m_filter.addSample(newValue); }
+
+        /**
+         * @brief Clears all samples from the filter and resets the sums.
+         */
+        void clear() { m_filter.clear(); }
+
+        /**
+         * @brief Gets the number of samples currently in the window.
+         */
+        size_t getCount() const noexcept { return m_filter.getCount(); }
+
+        /**
+         * @brief Gets the window size.
+         */
+        size_t getWindowSize() const noexcept { return m_filter.getWindowSize(); }
+
+        /**
+         * @brief Exports the samples in the window, oldest first.
+         */
+        std::vector<T> getBufferContents() const { return m_filter.getBufferContents(); }
+
+        /**
+         * @brief Restores the window and rebuilds every running sum from it.
+         * @param bufferData The samples to restore, oldest first.
+         */
+        void setBufferContents(const std::vector<T> &bufferData)
+        {
+            auto &policy = m_filter.getPolicy();
+            policy.clear();
+            for (const T &value : bufferData)
+            {
+                policy.onAdd(value);
+            }
+            m_filter.setBufferContents(bufferData);
+        }
+
+        /**
+         * @brief Gets the window's position in its push history (for delta snapshots).
+         */
+        dsp::utils::WindowMark getWindowMark() const noexcept { return m_filter.getWindowMark(); }
+
+    private:
+        SlidingWindowFilter<T, MovingStatisticsPolicy<T>> m_filter;
+    };
+} // namespace dsp::core
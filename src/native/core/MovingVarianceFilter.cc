@@ -1,16 +1,46 @@
 #include "MovingVarianceFilter.h"
+#include "../utils/SimdOps.h"
+#include <type_traits>
 
 using namespace dsp::core;
 
+namespace
+{
+    // Sum and sum of squares over a contiguous run of expired samples
+    // (SIMD for float, scalar otherwise)
+    template <typename T>
+    void accumulateSpan(const T *data, size_t size, double &sum, double &sumSq)
+    {
+        if constexpr (std::is_same_v<T, float>)
+        {
+            sum += dsp::simd::sum(data, size);
+            sumSq += dsp::simd::sum_of_squares(data, size);
+        }
+        else
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                double v = static_cast<double>(data[i]);
+                sum += v;
+                sumSq += v * v;
+            }
+        }
+    }
+}
+
 // -----------------------------------------------------------------------------
 // Constructor
 // -----------------------------------------------------------------------------
 template <typename T>
 MovingVarianceFilter<T>::MovingVarianceFilter(size_t window_size)
     : buffer(window_size), // Initialize the circular buffer
+      time_buffer(1),
+      window_duration_ms(0.0),
+      time_aware(false),
       running_sum(0),
       running_sum_of_squares(0),
-      window_size(window_size)
+      window_size(window_size),
+      mark{dsp::utils::nextWindowEpoch(), 0}
 {
     if (window_size == 0)
     {
@@ -23,10 +53,14 @@ MovingVarianceFilter<T>::MovingVarianceFilter(size_t window_size)
 // -----------------------------------------------------------------------------
 template <typename T>
 MovingVarianceFilter<T>::MovingVarianceFilter(size_t window_size, double window_duration_ms)
-    : buffer(window_size, window_duration_ms), // Initialize time-aware circular buffer
+    : buffer(1),
+      time_buffer(window_size, window_duration_ms), // Initialize time-aware SoA ring
+      window_duration_ms(window_duration_ms),
+      time_aware(true),
       running_sum(0),
       running_sum_of_squares(0),
-      window_size(window_size)
+      window_size(window_size),
+      mark{dsp::utils::nextWindowEpoch(), 0}
 {
     if (window_size == 0)
     {
@@ -54,6 +88,7 @@ T MovingVarianceFilter<T>::addSample(T newValue)
 
     // Add the new value to the buffer
     buffer.pushOverwrite(newValue);
+    ++mark.pushed;
 
     // Update running sums
     T oldestValueSquared = oldestValue * oldestValue;
@@ -66,38 +101,93 @@ T MovingVarianceFilter<T>::addSample(T newValue)
     return getVariance();
 }
 
+// -----------------------------------------------------------------------------
+// Method: addSamples
+// -----------------------------------------------------------------------------
+template <typename T>
+void MovingVarianceFilter<T>::addSamples(T *samples, size_t count, size_t stride)
+{
+    if constexpr (std::is_same_v<T, float>)
+    {
+        if (!time_aware && dsp::utils::PrefixSumWindow::accepts(count, window_size))
+        {
+            double sum = 0.0;
+            double sumSq = 0.0;
+            block.process(buffer, samples, count, stride, dsp::simd::WindowStatistic::Variance, 0.0f, sum, sumSq);
+            running_sum = static_cast<T>(sum);
+            running_sum_of_squares = static_cast<T>(sumSq);
+            mark.pushed += count;
+            return;
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        samples[i * stride] = addSample(samples[i * stride]);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Method: reserve
+// -----------------------------------------------------------------------------
+template <typename T>
+void MovingVarianceFilter<T>::reserve(size_t maxCount)
+{
+    if (time_aware)
+    {
+        time_buffer.reserveClock();
+    }
+    else if constexpr (std::is_same_v<T, float>)
+    {
+        block.reserve(window_size, maxCount);
+    }
+}
+
 // -----------------------------------------------------------------------------
 // Method: addSampleWithTimestamp
 // -----------------------------------------------------------------------------
 template <typename T>
 T MovingVarianceFilter<T>::addSampleWithTimestamp(T newValue, double timestamp)
 {
-    // Expire old samples
-    size_t initial_count = buffer.getCount();
-    size_t expired_count = buffer.expireOld(timestamp);
+    if (!time_aware)
+    {
+        throw std::runtime_error("addSampleWithTimestamp requires time-aware mode");
+    }
 
-    // Rebuild running statistics if samples were expired
+    // Expire old samples: binary search for the cutoff, then subtract the
+    // expired run from the running sums (no O(w) rebuild)
+    size_t expired_count = time_buffer.countOlderThan(timestamp - window_duration_ms);
     if (expired_count > 0)
     {
-        running_sum = 0;
-        running_sum_of_squares = 0;
+        double expiredSum = 0.0;
+        double expiredSumSq = 0.0;
+        auto spans = time_buffer.valueSpans(0, expired_count);
+        accumulateSpan(spans.first.data, spans.first.size, expiredSum, expiredSumSq);
+        accumulateSpan(spans.second.data, spans.second.size, expiredSum, expiredSumSq);
+        time_buffer.popFront(expired_count);
 
-        auto remaining = buffer.toVector();
-        for (const auto &value : remaining)
+        if (time_buffer.empty())
+        {
+            // Nothing left in the window: drop any accumulated rounding error
+            running_sum = 0;
+            running_sum_of_squares = 0;
+        }
+        else
         {
-            running_sum += value;
-            running_sum_of_squares += value * value;
+            running_sum -= static_cast<T>(expiredSum);
+            running_sum_of_squares -= static_cast<T>(expiredSumSq);
         }
     }
 
-    // Add new sample
+    // Add new sample (push() overwrites the oldest when the ring is full)
     T oldestValue = 0;
-    if (buffer.isFull())
+    if (time_buffer.isFull())
     {
-        oldestValue = buffer.peek();
+        oldestValue = time_buffer.valueAt(0);
     }
 
-    buffer.pushOverwriteWithTimestamp(newValue, timestamp);
+    time_buffer.push(timestamp, newValue);
+    ++mark.pushed;
 
     // Update running sums
     T oldestValueSquared = oldestValue * oldestValue;
@@ -115,7 +205,7 @@ T MovingVarianceFilter<T>::addSampleWithTimestamp(T newValue, double timestamp)
 template <typename T>
 T MovingVarianceFilter<T>::getVariance() const
 {
-    size_t count = buffer.getCount();
+    size_t count = sampleCount();
     if (count == 0)
     {
         return 0; // Avoid division by zero
@@ -143,8 +233,10 @@ template <typename T>
 void MovingVarianceFilter<T>::clear()
 {
     buffer.clear();
+    time_buffer.clear();
     running_sum = 0;
     running_sum_of_squares = 0;
+    mark = {dsp::utils::nextWindowEpoch(), 0};
 }
 
 // -----------------------------------------------------------------------------
@@ -153,7 +245,7 @@ void MovingVarianceFilter<T>::clear()
 template <typename T>
 bool MovingVarianceFilter<T>::isFull() const noexcept
 {
-    return buffer.isFull();
+    return time_aware ? time_buffer.isFull() : buffer.isFull();
 }
 
 // -----------------------------------------------------------------------------
@@ -162,7 +254,7 @@ bool MovingVarianceFilter<T>::isFull() const noexcept
 template <typename T>
 bool MovingVarianceFilter<T>::isTimeAware() const noexcept
 {
-    return buffer.isTimeAware();
+    return time_aware;
 }
 
 // -----------------------------------------------------------------------------
@@ -171,7 +263,8 @@ bool MovingVarianceFilter<T>::isTimeAware() const noexcept
 template <typename T>
 std::pair<std::vector<T>, std::pair<T, T>> MovingVarianceFilter<T>::getState() const
 {
-    return {buffer.toVector(), {running_sum, running_sum_of_squares}};
+    std::vector<T> contents = time_aware ? time_buffer.valuesToVector() : buffer.toVector();
+    return {contents, {running_sum, running_sum_of_squares}};
 }
 
 // -----------------------------------------------------------------------------
@@ -180,9 +273,27 @@ std::pair<std::vector<T>, std::pair<T, T>> MovingVarianceFilter<T>::getState() c
 template <typename T>
 void MovingVarianceFilter<T>::setState(const std::vector<T> &bufferData, T sum, T sumOfSquares)
 {
-    buffer.fromVector(bufferData);
+    if (time_aware)
+    {
+        // Saved state carries no timestamps; restored samples are stamped 0
+        time_buffer.fromValues(bufferData);
+    }
+    else
+    {
+        buffer.fromVector(bufferData);
+    }
     running_sum = sum;
     running_sum_of_squares = sumOfSquares;
+    mark = {dsp::utils::nextWindowEpoch(), 0};
+}
+
+// -----------------------------------------------------------------------------
+// Method: sampleCount
+// -----------------------------------------------------------------------------
+template <typename T>
+size_t MovingVarianceFilter<T>::sampleCount() const noexcept
+{
+    return time_aware ? time_buffer.size() : buffer.getCount();
 }
 
 // Explicit template instantiation for common types
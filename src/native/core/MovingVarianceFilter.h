@@ -1,6 +1,9 @@
 #pragma once
 
 #include "../utils/CircularBufferArray.h"
+#include "../utils/TimeSeriesBuffer.h"
+#include "../utils/BinaryState.h"
+#include "../utils/PrefixSumWindow.h"
 #include <utility>
 #include <vector>
 #include <cmath>
@@ -66,6 +69,25 @@ namespace dsp::core
          */
         T addSampleWithTimestamp(T newValue, double timestamp);
 
+        /**
+         * @brief Adds a chunk of samples (sample-count mode), replacing each with its moving variance.
+         *
+         * Float chunks of at least one window are evaluated from prefix
+         * sums (see PrefixSumWindow); anything else goes through addSample().
+         *
+         * @param samples First sample (in-place).
+         * @param count Number of samples.
+         * @param stride Distance between consecutive samples (channel count for interleaved data).
+         */
+        void addSamples(T *samples, size_t count, size_t stride = 1);
+
+        /**
+         * @brief Preallocates what adding chunks of up to maxCount samples
+         * needs (block scratch, or the time-aware clock), so the add paths
+         * do not allocate afterwards.
+         */
+        void reserve(size_t maxCount);
+
         /**
          * @brief Gets the current moving variance.
          * @return T The variance of the samples currently in the buffer.
@@ -83,6 +105,11 @@ namespace dsp::core
          */
         bool isFull() const noexcept;
 
+        /**
+         * @brief Gets the number of samples currently in the window.
+         */
+        size_t getCount() const noexcept { return sampleCount(); }
+
         /**
          * @brief Checks if the filter is in time-aware mode.
          * @return true if time-aware, false otherwise.
@@ -105,10 +132,25 @@ namespace dsp::core
          */
         void setState(const std::vector<T> &bufferData, T sum, T sumOfSquares);
 
+        /**
+         * @brief Gets the window's position in its push history (for delta snapshots).
+         */
+        dsp::utils::WindowMark getWindowMark() const noexcept { return mark; }
+
     private:
-        dsp::utils::CircularBufferArray<T> buffer;
+        /**
+         * @brief Number of samples currently in the active buffer.
+         */
+        size_t sampleCount() const noexcept;
+
+        dsp::utils::CircularBufferArray<T> buffer;  // Sample-count mode storage
+        dsp::utils::TimeSeriesBuffer<T> time_buffer; // Time-aware mode storage
+        double window_duration_ms;
+        bool time_aware;
         T running_sum;
         T running_sum_of_squares;
         size_t window_size;
+        dsp::utils::WindowMark mark; // New epoch on clear/restore, pushed++ per sample
+        dsp::utils::PrefixSumWindow block; // Scratch for addSamples()
     };
 } // namespace dsp::core
\ No newline at end of file
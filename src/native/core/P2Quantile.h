@@ -0,0 +1,189 @@
+#pragma once
+#include "../utils/FloatBits.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace dsp::core
+{
+    /**
+     * @brief P² (piecewise-parabolic) streaming quantile estimator.
+     *
+     * Jain & Chlamtac's algorithm tracks a single quantile with five markers,
+     * so memory is constant regardless of how many samples are observed.
+     * Until five samples have been seen the exact quantile is returned.
+     */
+    class P2Quantile
+    {
+    public:
+        explicit P2Quantile(double quantile = 0.5)
+            : m_quantile(std::clamp(quantile, 0.0, 1.0))
+        {
+            reset();
+        }
+
+        /**
+         * @brief Feeds one observation into the estimator.
+         * @param x The new observation.
+         */
+        void add(double x)
+        {
+            if (m_count < 5)
+            {
+                m_heights[m_count++] = x;
+                if (m_count == 5)
+                {
+                    std::sort(m_heights.begin(), m_heights.end());
+                }
+                return;
+            }
+
+            // Locate the cell containing x and stretch the extreme markers
+            size_t k;
+            if (x < m_heights[0])
+            {
+                m_heights[0] = x;
+                k = 0;
+            }
+            else if (x >= m_heights[4])
+            {
+                m_heights[4] = x;
+                k = 3;
+            }
+            else
+            {
+                k = 0;
+                while (k < 3 && x >= m_heights[k + 1])
+                    ++k;
+            }
+
+            for (size_t i = k + 1; i < 5; ++i)
+                m_positions[i] += 1.0;
+            for (size_t i = 0; i < 5; ++i)
+                m_desired[i] += m_increments[i];
+            ++m_count;
+
+            // Nudge the three inner markers towards their desired positions
+            for (size_t i = 1; i < 4; ++i)
+            {
+                double d = m_desired[i] - m_positions[i];
+                if ((d >= 1.0 && m_positions[i + 1] - m_positions[i] > 1.0) ||
+                    (d <= -1.0 && m_positions[i - 1] - m_positions[i] < -1.0))
+                {
+                    double step = (d > 0.0) ? 1.0 : -1.0;
+                    double candidate = parabolic(i, step);
+                    if (m_heights[i - 1] < candidate && candidate < m_heights[i + 1])
+                    {
+                        m_heights[i] = candidate;
+                    }
+                    else
+                    {
+                        m_heights[i] = linear(i, step);
+                    }
+                    m_positions[i] += step;
+                }
+            }
+        }
+
+        /**
+         * @brief Current quantile estimate (0 if no samples have been seen).
+         */
+        double getResult() const
+        {
+            if (m_count == 0)
+                return 0.0;
+
+            if (m_count < 5)
+            {
+                // Exact interpolated quantile over the few samples we hold
+                std::array<double, 5> sorted = m_heights;
+                std::sort(sorted.begin(), sorted.begin() + m_count);
+                double pos = m_quantile * static_cast<double>(m_count - 1);
+                size_t lo = static_cast<size_t>(std::floor(pos));
+                size_t hi = std::min(lo + 1, m_count - 1);
+                double frac = pos - static_cast<double>(lo);
+                return sorted[lo] + frac * (sorted[hi] - sorted[lo]);
+            }
+
+            return m_heights[2];
+        }
+
+        void reset()
+        {
+            m_count = 0;
+            m_heights.fill(0.0);
+            m_positions = {0.0, 1.0, 2.0, 3.0, 4.0};
+            m_desired = {0.0, 2.0 * m_quantile, 4.0 * m_quantile, 2.0 + 2.0 * m_quantile, 4.0};
+            m_increments = {0.0, m_quantile / 2.0, m_quantile, (1.0 + m_quantile) / 2.0, 1.0};
+        }
+
+        size_t getCount() const { return m_count; }
+        double getQuantile() const { return m_quantile; }
+
+        /**
+         * @brief Exports the estimator state as a flat vector:
+         * [count, heights[5], positions[5], desired[5]].
+         */
+        std::vector<double> getState() const
+        {
+            std::vector<double> state;
+            state.reserve(16);
+            state.push_back(static_cast<double>(m_count));
+            state.insert(state.end(), m_heights.begin(), m_heights.end());
+            state.insert(state.end(), m_positions.begin(), m_positions.end());
+            state.insert(state.end(), m_desired.begin(), m_desired.end());
+            return state;
+        }
+
+        /**
+         * @brief Restores the estimator state produced by getState().
+         * @return false if the layout is invalid (state left reset).
+         */
+        bool setState(const std::vector<double> &state)
+        {
+            reset();
+            if (state.size() != 16 ||
+                !std::all_of(state.begin(), state.end(), [](double value)
+                             { return dsp::utils::isFinite(value); }))
+                return false;
+
+            // The count must be a whole number in range before the cast
+            if (state[0] < 0.0 || state[0] > kMaxCount || state[0] != std::floor(state[0]))
+                return false;
+
+            m_count = static_cast<size_t>(state[0]);
+            std::copy(state.begin() + 1, state.begin() + 6, m_heights.begin());
+            std::copy(state.begin() + 6, state.begin() + 11, m_positions.begin());
+            std::copy(state.begin() + 11, state.begin() + 16, m_desired.begin());
+            return true;
+        }
+
+    private:
+        // Largest count a double holds exactly (2^53)
+        static constexpr double kMaxCount = 9007199254740992.0;
+
+        double parabolic(size_t i, double d) const
+        {
+            const auto &q = m_heights;
+            const auto &n = m_positions;
+            return q[i] + d / (n[i + 1] - n[i - 1]) *
+                              ((n[i] - n[i - 1] + d) * (q[i + 1] - q[i]) / (n[i + 1] - n[i]) +
+                               (n[i + 1] - n[i] - d) * (q[i] - q[i - 1]) / (n[i] - n[i - 1]));
+        }
+
+        double linear(size_t i, double d) const
+        {
+            size_t j = (d > 0.0) ? i + 1 : i - 1;
+            return m_heights[i] + d * (m_heights[j] - m_heights[i]) / (m_positions[j] - m_positions[i]);
+        }
+
+        double m_quantile;
+        size_t m_count = 0;
+        std::array<double, 5> m_heights{};    // Marker heights (q_i)
+        std::array<double, 5> m_positions{};  // Actual marker positions (n_i)
+        std::array<double, 5> m_desired{};    // Desired marker positions (n'_i)
+        std::array<double, 5> m_increments{}; // Desired position increments (dn'_i)
+    };
+} // namespace dsp::core
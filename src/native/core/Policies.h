@@ -1,7 +1,16 @@
 #pragma once
+#include "../utils/FloatBits.h"
+#include "../utils/SimdOps.h"
 #include <cmath>
 #include <algorithm>
+#include <array>
 #include <numeric>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <functional>
+#include <unordered_map>
 
 namespace dsp::core
 {
@@ -29,6 +38,10 @@ namespace dsp::core
         // For state serialization
         T getState() const { return m_sum; }
         void setState(T sum) { m_sum = sum; }
+
+        // Block evaluation (SlidingWindowFilter::addSamples)
+        static constexpr dsp::simd::WindowStatistic kBlockStatistic = dsp::simd::WindowStatistic::Mean;
+        void setBlockSums(double sum, double) { m_sum = static_cast<T>(sum); }
     };
 
     /**
@@ -57,6 +70,10 @@ namespace dsp::core
         // For state serialization
         T getState() const { return m_sum_sq; }
         void setState(T sumSq) { m_sum_sq = sumSq; }
+
+        // Block evaluation (SlidingWindowFilter::addSamples)
+        static constexpr dsp::simd::WindowStatistic kBlockStatistic = dsp::simd::WindowStatistic::Rms;
+        void setBlockSums(double, double sumSq) { m_sum_sq = static_cast<T>(sumSq); }
     };
 
     /**
@@ -191,6 +208,10 @@ namespace dsp::core
         // For state serialization
         T getState() const { return m_sum_abs; }
         void setState(T sumAbs) { m_sum_abs = sumAbs; }
+
+        // Block evaluation (SlidingWindowFilter::addSamples)
+        static constexpr dsp::simd::WindowStatistic kBlockStatistic = dsp::simd::WindowStatistic::MeanAbs;
+        void setBlockSums(double sumAbs, double) { m_sum_abs = static_cast<T>(sumAbs); }
     };
 
     /**
@@ -242,6 +263,14 @@ namespace dsp::core
             m_sum = sum;
             m_sum_sq = sumSq;
         }
+
+        // Block evaluation (SlidingWindowFilter::addSamples)
+        static constexpr dsp::simd::WindowStatistic kBlockStatistic = dsp::simd::WindowStatistic::Variance;
+        void setBlockSums(double sum, double sumSq)
+        {
+            m_sum = static_cast<T>(sum);
+            m_sum_sq = static_cast<T>(sumSq);
+        }
     };
 
     /**
@@ -309,6 +338,311 @@ namespace dsp::core
         T getEpsilon() const { return m_epsilon; }
     };
 
+    /**
+     * @brief Policy for calculating a sliding quantile (median, percentiles).
+     *
+     * Keeps the window split across two binary heaps: a max-heap holding the
+     * lower ceil-part of the order statistics and a min-heap holding the rest.
+     * Removals are lazy: the value is recorded in a per-heap "delayed" table and
+     * physically discarded only once it surfaces at the heap top (or when the
+     * heap is compacted). Every add/remove is therefore O(log w) instead of the
+     * O(w log w) re-sort a naive implementation needs.
+     *
+     * The result is linearly interpolated between the two order statistics that
+     * bracket q * (n - 1), matching numpy's default "linear" percentile method.
+     *
+     * NaN samples are left out, as in numpy's nanpercentile: they never enter
+     * a heap, whose ordering and delayed table (NaN never equals itself, so
+     * its removal would never match) would both break.
+     */
+    template <typename T>
+    struct PercentilePolicy
+    {
+        double m_quantile; // In [0, 1]
+
+        std::vector<T> m_low;  // Max-heap (std::less)
+        std::vector<T> m_high; // Min-heap (std::greater)
+        std::unordered_map<T, size_t> m_delayedLow;
+        std::unordered_map<T, size_t> m_delayedHigh;
+        size_t m_lowSize = 0;  // Live elements in m_low
+        size_t m_highSize = 0; // Live elements in m_high
+
+        explicit PercentilePolicy(double quantile = 0.5)
+            : m_quantile(std::clamp(quantile, 0.0, 1.0)) {}
+
+        void onAdd(T val)
+        {
+            if (isNaN(val))
+                return;
+
+            if (m_lowSize == 0 || val <= m_low.front())
+            {
+                m_low.push_back(val);
+                std::push_heap(m_low.begin(), m_low.end(), std::less<T>());
+                ++m_lowSize;
+            }
+            else
+            {
+                m_high.push_back(val);
+                std::push_heap(m_high.begin(), m_high.end(), std::greater<T>());
+                ++m_highSize;
+            }
+            rebalance();
+        }
+
+        void onRemove(T val)
+        {
+            if (isNaN(val))
+                return;
+
+            // Live tops are always pruned, so the heap that owns 'val' can be
+            // decided by comparing against the lower top alone.
+            if (m_lowSize > 0 && val <= m_low.front())
+            {
+                ++m_delayedLow[val];
+                --m_lowSize;
+                prune(m_low, m_delayedLow, std::less<T>());
+            }
+            else if (m_highSize > 0)
+            {
+                ++m_delayedHigh[val];
+                --m_highSize;
+                prune(m_high, m_delayedHigh, std::greater<T>());
+            }
+            rebalance();
+        }
+
+        void clear()
+        {
+            m_low.clear();
+            m_high.clear();
+            m_delayedLow.clear();
+            m_delayedHigh.clear();
+            m_lowSize = 0;
+            m_highSize = 0;
+        }
+
+        T getResult(size_t count) const
+        {
+            size_t n = m_lowSize + m_highSize;
+            if (count == 0 || n == 0)
+                return 0;
+
+            double pos = m_quantile * static_cast<double>(n - 1);
+            double frac = pos - std::floor(pos);
+            double lower = static_cast<double>(m_low.front());
+            if (frac <= 0.0 || m_highSize == 0)
+                return static_cast<T>(lower);
+
+            double upper = static_cast<double>(m_high.front());
+            return static_cast<T>(lower + frac * (upper - lower));
+        }
+
+        // For state serialization: the heaps are rebuilt from the window
+        // contents on restore, so only the configured quantile is exported.
+        double getState() const { return m_quantile; }
+        void setState(double quantile)
+        {
+            m_quantile = std::clamp(quantile, 0.0, 1.0);
+            clear();
+        }
+
+    private:
+        static bool isNaN(T val)
+        {
+            if constexpr (std::is_floating_point_v<T>)
+                return dsp::utils::isNaN(val);
+            else
+                return false;
+        }
+
+        // Number of live elements that belong in the lower heap for n samples
+        size_t targetLowSize(size_t n) const
+        {
+            if (n == 0)
+                return 0;
+            return static_cast<size_t>(std::floor(m_quantile * static_cast<double>(n - 1))) + 1;
+        }
+
+        template <typename Compare>
+        static void prune(std::vector<T> &heap, std::unordered_map<T, size_t> &delayed, Compare comp)
+        {
+            while (!heap.empty())
+            {
+                auto it = delayed.find(heap.front());
+                if (it == delayed.end())
+                    break;
+
+                if (--it->second == 0)
+                    delayed.erase(it);
+                std::pop_heap(heap.begin(), heap.end(), comp);
+                heap.pop_back();
+            }
+        }
+
+        // Physically drops delayed entries once they dominate the heap, so that
+        // memory stays O(w) even when removals never reach the top.
+        template <typename Compare>
+        static void compact(std::vector<T> &heap, std::unordered_map<T, size_t> &delayed, size_t liveSize, Compare comp)
+        {
+            if (heap.size() <= 2 * liveSize + 16)
+                return;
+
+            size_t kept = 0;
+            for (size_t i = 0; i < heap.size(); ++i)
+            {
+                auto it = delayed.find(heap[i]);
+                if (it != delayed.end())
+                {
+                    if (--it->second == 0)
+                        delayed.erase(it);
+                    continue;
+                }
+                heap[kept++] = heap[i];
+            }
+            heap.resize(kept);
+            std::make_heap(heap.begin(), heap.end(), comp);
+            delayed.clear();
+        }
+
+        void rebalance()
+        {
+            size_t target = targetLowSize(m_lowSize + m_highSize);
+
+            while (m_lowSize > target)
+            {
+                T top = m_low.front();
+                std::pop_heap(m_low.begin(), m_low.end(), std::less<T>());
+                m_low.pop_back();
+                --m_lowSize;
+                prune(m_low, m_delayedLow, std::less<T>());
+
+                m_high.push_back(top);
+                std::push_heap(m_high.begin(), m_high.end(), std::greater<T>());
+                ++m_highSize;
+            }
+
+            while (m_lowSize < target && m_highSize > 0)
+            {
+                T top = m_high.front();
+                std::pop_heap(m_high.begin(), m_high.end(), std::greater<T>());
+                m_high.pop_back();
+                --m_highSize;
+                prune(m_high, m_delayedHigh, std::greater<T>());
+
+                m_low.push_back(top);
+                std::push_heap(m_low.begin(), m_low.end(), std::less<T>());
+                ++m_lowSize;
+            }
+
+            compact(m_low, m_delayedLow, m_lowSize, std::less<T>());
+            compact(m_high, m_delayedHigh, m_highSize, std::greater<T>());
+        }
+    };
+
+    /**
+     * @brief Runs several policies over one window.
+     *
+     * Each sample is handed once to every policy (folded over a tuple, so
+     * the calls inline exactly as with a single policy), and getResult()
+     * returns one result per policy, in declaration order. A filter with
+     * N statistics thus keeps one ring buffer and does one push/pop per
+     * sample instead of N of each.
+     *
+     * Every policy must implement getResult(size_t) returning T (ZScorePolicy
+     * and PercentilePolicy do not fit). SlidingWindowFilter picks up the
+     * Result type, so addSample() returns the whole array.
+     *
+     * @tparam T The numeric type (e.g., float, double).
+     * @tparam Policies The policies to combine.
+     */
+    template <typename T, typename... Policies>
+    struct CompositePolicy
+    {
+        static constexpr size_t kSize = sizeof...(Policies);
+        using Result = std::array<T, kSize>;
+
+        std::tuple<Policies...> m_policies;
+
+        CompositePolicy() = default;
+        explicit CompositePolicy(Policies... policies) : m_policies(std::move(policies)...) {}
+
+        void onAdd(T val)
+        {
+            std::apply([val](auto &...policy)
+                       { (policy.onAdd(val), ...); }, m_policies);
+        }
+
+        void onRemove(T val)
+        {
+            std::apply([val](auto &...policy)
+                       { (policy.onRemove(val), ...); }, m_policies);
+        }
+
+        void clear()
+        {
+            std::apply([](auto &...policy)
+                       { (policy.clear(), ...); }, m_policies);
+        }
+
+        Result getResult(size_t count) const
+        {
+            return std::apply([count](const auto &...policy)
+                              { return Result{static_cast<T>(policy.getResult(count))...}; }, m_policies);
+        }
+
+        /**
+         * @brief The I-th policy (e.g. for its own getState()).
+         */
+        template <size_t I>
+        auto &get() { return std::get<I>(m_policies); }
+
+        template <size_t I>
+        const auto &get() const { return std::get<I>(m_policies); }
+
+        // For state serialization: one state per policy
+        auto getState() const
+        {
+            return std::apply([](const auto &...policy)
+                              { return std::make_tuple(policy.getState()...); }, m_policies);
+        }
+
+        template <typename... States>
+        void setState(const std::tuple<States...> &states)
+        {
+            setStates(states, std::index_sequence_for<Policies...>{});
+        }
+
+    private:
+        template <typename States, size_t... I>
+        void setStates(const States &states, std::index_sequence<I...>)
+        {
+            (setOne(std::get<I>(m_policies), std::get<I>(states)), ...);
+        }
+
+        // Policies with two running sums take them as separate arguments
+        template <typename Policy, typename State>
+        static void setOne(Policy &policy, const State &state)
+        {
+            if constexpr (std::is_invocable_v<decltype(&Policy::setState), Policy &, const State &>)
+            {
+                policy.setState(state);
+            }
+            else
+            {
+                std::apply([&policy](const auto &...parts)
+                           { policy.setState(parts...); }, state);
+            }
+        }
+    };
+
+    /**
+     * @brief Mean, RMS, mean absolute value and variance over one window
+     * (the movingStatistics stage).
+     */
+    template <typename T>
+    using MovingStatisticsPolicy = CompositePolicy<T, MeanPolicy<T>, RmsPolicy<T>, MeanAbsoluteValuePolicy<T>, VariancePolicy<T>>;
+
     /**
      * @brief Policy for FIR filter convolution.
      *
@@ -0,0 +1,220 @@
+#include "RlsFilter.h"
+#include "../utils/FloatBits.h"
+#include "../utils/SimdOps.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+using namespace dsp::core;
+
+namespace
+{
+    // Folds the scale into S at least this often, even for tiny filters
+    constexpr size_t kMinSymmetrizeInterval = 16;
+}
+
+// -----------------------------------------------------------------------------
+// Constructor
+// -----------------------------------------------------------------------------
+RlsFilter::RlsFilter(size_t channels, size_t numTaps, float lambda, float delta)
+    : m_channels(channels), m_numTaps(numTaps), m_lambda(lambda), m_delta(delta),
+      m_symmetrizeInterval(std::max(numTaps, kMinSymmetrizeInterval))
+{
+    if (channels == 0)
+    {
+        throw std::invalid_argument("RlsFilter: at least one primary channel is required");
+    }
+    if (numTaps == 0)
+    {
+        throw std::invalid_argument("RlsFilter: numTaps must be greater than 0");
+    }
+    if (!(lambda > 0.0f && lambda <= 1.0f) || !dsp::utils::isFinite(lambda))
+    {
+        throw std::invalid_argument("RlsFilter: lambda must be in (0, 1]");
+    }
+    if (!(delta > 0.0f) || !dsp::utils::isFinite(delta))
+    {
+        throw std::invalid_argument("RlsFilter: delta must be positive");
+    }
+
+    m_weights.assign(channels * numTaps, 0.0f);
+    m_history.assign(2 * numTaps, 0.0f);
+    m_matrix.assign(numTaps * numTaps, 0.0f);
+    m_pi.assign(numTaps, 0.0f);
+    m_gain.assign(numTaps, 0.0f);
+    resetInverseCorrelation();
+}
+
+// -----------------------------------------------------------------------------
+// Method: processFrame
+// -----------------------------------------------------------------------------
+void RlsFilter::processFrame(const float *primary, float reference, float *error)
+{
+    const size_t N = m_numTaps;
+
+    // Step back one slot: it holds the sample leaving the window. A NaN or
+    // infinite reference sample is a dropout and enters as 0; kept, it would
+    // make P and every weight NaN for good
+    m_position = (m_position == 0 ? N : m_position) - 1;
+    if (!dsp::utils::isFinite(reference))
+    {
+        reference = 0.0f;
+    }
+    m_history[m_position] = reference;
+    m_history[m_position + N] = reference;
+    const float *x = m_history.data() + m_position;
+
+    // pi = S x (S is symmetric, so row i dotted with x)
+    auto multiply = [this, x, N]()
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            m_pi[i] = dsp::simd::dot_product(m_matrix.data() + i * N, x, N);
+        }
+        return static_cast<double>(m_lambda) + m_scale * dsp::simd::dot_product(x, m_pi.data(), N);
+    };
+    double denominator = multiply();
+    if (!(denominator > 0.0) || !dsp::utils::isFinite(denominator))
+    {
+        // P lost positive definiteness: start it over, keep the weights
+        resetInverseCorrelation();
+        denominator = multiply();
+    }
+
+    const double gainScale = m_scale / denominator;
+    for (size_t i = 0; i < N; ++i)
+    {
+        m_gain[i] = static_cast<float>(gainScale * m_pi[i]);
+    }
+
+    // P = (P - k (P x)^T) / lambda  <=>  S -= k pi^T, scale /= lambda
+    for (size_t i = 0; i < N; ++i)
+    {
+        dsp::simd::scaled_add(m_matrix.data() + i * N, m_pi.data(), -m_gain[i], N);
+    }
+    m_scale /= m_lambda;
+
+    for (size_t c = 0; c < m_channels; ++c)
+    {
+        float *w = m_weights.data() + c * N;
+        const float e = primary[c] - dsp::simd::dot_product(w, x, N);
+        // A non-finite primary sample passes through without adapting
+        if (dsp::utils::isFinite(e))
+        {
+            dsp::simd::scaled_add(w, m_gain.data(), e, N);
+        }
+        error[c] = e;
+    }
+
+    if (++m_sinceSymmetrize >= m_symmetrizeInterval)
+    {
+        symmetrize();
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Method: process
+// -----------------------------------------------------------------------------
+void RlsFilter::process(const float *primary, const float *reference, float *error, size_t numFrames)
+{
+    for (size_t f = 0; f < numFrames; ++f)
+    {
+        processFrame(primary + f * m_channels, reference[f], error + f * m_channels);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Inverse correlation upkeep
+// -----------------------------------------------------------------------------
+void RlsFilter::resetInverseCorrelation()
+{
+    const size_t N = m_numTaps;
+    std::fill(m_matrix.begin(), m_matrix.end(), 0.0f);
+    for (size_t i = 0; i < N; ++i)
+    {
+        m_matrix[i * N + i] = 1.0f / m_delta;
+    }
+    m_scale = 1.0;
+    m_sinceSymmetrize = 0;
+}
+
+void RlsFilter::symmetrize()
+{
+    const size_t N = m_numTaps;
+    const double scale = m_scale;
+    for (size_t i = 0; i < N; ++i)
+    {
+        float &diagonal = m_matrix[i * N + i];
+        diagonal = static_cast<float>(scale * diagonal);
+        if (!(diagonal > 0.0f) || !(diagonal <= kMaxDiagonal) || !dsp::utils::isFinite(diagonal))
+        {
+            resetInverseCorrelation();
+            return;
+        }
+        for (size_t j = i + 1; j < N; ++j)
+        {
+            const float value = static_cast<float>(0.5 * scale * (m_matrix[i * N + j] + m_matrix[j * N + i]));
+            m_matrix[i * N + j] = value;
+            m_matrix[j * N + i] = value;
+        }
+    }
+    m_scale = 1.0;
+    m_sinceSymmetrize = 0;
+}
+
+// -----------------------------------------------------------------------------
+// State
+// -----------------------------------------------------------------------------
+std::vector<float> RlsFilter::getHistory() const
+{
+    return std::vector<float>(m_history.begin() + m_position, m_history.begin() + m_position + m_numTaps);
+}
+
+std::vector<float> RlsFilter::getInverseCorrelation() const
+{
+    std::vector<float> p(m_matrix.size());
+    for (size_t i = 0; i < p.size(); ++i)
+    {
+        p[i] = static_cast<float>(m_scale * m_matrix[i]);
+    }
+    return p;
+}
+
+void RlsFilter::setState(const std::vector<float> &weights, const std::vector<float> &history,
+                         const std::vector<float> &inverseCorrelation)
+{
+    if (weights.size() != m_weights.size() || history.size() != m_numTaps ||
+        inverseCorrelation.size() != m_matrix.size())
+    {
+        throw std::runtime_error("RlsFilter: expected " + std::to_string(m_weights.size()) + " weights, " +
+                                 std::to_string(m_numTaps) + " history samples and a " +
+                                 std::to_string(m_numTaps) + "x" + std::to_string(m_numTaps) + " matrix");
+    }
+    for (const std::vector<float> *values : {&weights, &inverseCorrelation})
+    {
+        for (float value : *values)
+        {
+            if (!dsp::utils::isFinite(value))
+            {
+                throw std::runtime_error("RlsFilter: state values must be finite");
+            }
+        }
+    }
+
+    m_weights = weights;
+    m_position = 0;
+    std::copy(history.begin(), history.end(), m_history.begin());
+    std::copy(history.begin(), history.end(), m_history.begin() + m_numTaps);
+    m_matrix = inverseCorrelation;
+    m_scale = 1.0;
+    m_sinceSymmetrize = 0;
+}
+
+void RlsFilter::reset()
+{
+    std::fill(m_weights.begin(), m_weights.end(), 0.0f);
+    std::fill(m_history.begin(), m_history.end(), 0.0f);
+    m_position = 0;
+    resetInverseCorrelation();
+}
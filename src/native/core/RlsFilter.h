@@ -0,0 +1,120 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+namespace dsp::core
+{
+    /**
+     * @brief Recursive-least-squares adaptive FIR filter for reference-based
+     * noise cancellation (the RLS counterpart of LmsFilter).
+     *
+     * Per frame, with x_n = (x[n], ..., x[n-numTaps+1]) the reference window
+     * and P the inverse correlation matrix of the reference:
+     *
+     *   pi = P x_n,  k = pi / (lambda + x_n^T pi),  P = (P - k pi^T) / lambda
+     *
+     * and for every primary channel:
+     *
+     *   e = d - w^T x_n,  w += k e
+     *
+     * P and k only depend on the reference, so the O(numTaps^2) part runs
+     * once per frame however many primary channels share it; each channel
+     * costs two O(numTaps) passes. Convergence takes on the order of
+     * 2 * numTaps frames regardless of the reference's eigenvalue spread,
+     * where LMS / NLMS can take thousands.
+     *
+     * P is kept as scale * S. Then the 1/lambda of every update is a scalar
+     * multiply, and the rank-1 update is one simd::scaled_add per row of S;
+     * P x_n is one simd::dot_product per row. Every numTaps frames (at
+     * least 16) S is folded with its scale and symmetrized, so rounding
+     * cannot pull P away from symmetry. If P stops being positive
+     * definite, it is reset to I / delta and the weights are kept. The
+     * same happens if P's diagonal grows past kMaxDiagonal, which a
+     * reference that does not excite every direction causes with
+     * lambda < 1. A NaN or infinite reference sample enters the window as
+     * 0, and a non-finite primary sample is output without adapting.
+     */
+    class RlsFilter
+    {
+    public:
+        /**
+         * @brief Constructs the filter with zero weights and history and P = I / delta.
+         * @param channels Primary channels adapted against the reference.
+         * @param numTaps Weights per channel (filter order).
+         * @param lambda Forgetting factor in (0, 1]; the effective memory is 1 / (1 - lambda) frames.
+         * @param delta Initial regularization: P starts at I / delta.
+         */
+        RlsFilter(size_t channels, size_t numTaps, float lambda, float delta = 0.01f);
+
+        /**
+         * @brief Filters one frame and adapts the weights.
+         * @param primary getChannels() primary samples.
+         * @param reference The reference sample of the frame.
+         * @param error getChannels() outputs (primary minus estimate); may alias primary.
+         */
+        void processFrame(const float *primary, float reference, float *error);
+
+        /**
+         * @brief Filters numFrames frames.
+         * @param primary numFrames * getChannels() interleaved samples.
+         * @param reference numFrames reference samples.
+         * @param error numFrames * getChannels() outputs; may alias primary.
+         */
+        void process(const float *primary, const float *reference, float *error, size_t numFrames);
+
+        size_t getChannels() const noexcept { return m_channels; }
+        size_t getNumTaps() const noexcept { return m_numTaps; }
+        float getLambda() const noexcept { return m_lambda; }
+        float getDelta() const noexcept { return m_delta; }
+
+        /**
+         * @brief channels x numTaps weights; weight i of a channel multiplies x[n-i].
+         */
+        const std::vector<float> &getWeights() const noexcept { return m_weights; }
+
+        /**
+         * @brief The last numTaps reference samples, newest first.
+         */
+        std::vector<float> getHistory() const;
+
+        /**
+         * @brief The inverse correlation matrix P, numTaps x numTaps row-major.
+         */
+        std::vector<float> getInverseCorrelation() const;
+
+        /**
+         * @brief Restores getWeights() / getHistory() / getInverseCorrelation() results.
+         */
+        void setState(const std::vector<float> &weights, const std::vector<float> &history,
+                      const std::vector<float> &inverseCorrelation);
+
+        /**
+         * @brief Zeroes the weights and the history and resets P to I / delta.
+         */
+        void reset();
+
+        // Diagonal of P beyond which it is reset (the reference stopped exciting some direction)
+        static constexpr float kMaxDiagonal = 1e10f;
+
+    private:
+        void resetInverseCorrelation();
+        void symmetrize();
+
+        size_t m_channels;
+        size_t m_numTaps;
+        float m_lambda;
+        float m_delta;
+        size_t m_symmetrizeInterval;
+
+        std::vector<float> m_weights;
+        std::vector<float> m_history; // 2 * numTaps, mirrored; x_n starts at m_position
+        size_t m_position = 0;
+
+        std::vector<float> m_matrix; // S, numTaps x numTaps: P = m_scale * S
+        double m_scale = 1.0;
+        size_t m_sinceSymmetrize = 0;
+        std::vector<float> m_pi;   // S x_n
+        std::vector<float> m_gain; // k
+    };
+
+} // namespace dsp::core
@@ -0,0 +1,214 @@
+#include "SpatialFilter.h"
+#include "../utils/FloatBits.h"
+#include "../utils/SimdOps.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+using namespace dsp::core;
+
+namespace
+{
+    // The sparse loop gathers one input per term and the GEMM does several
+    // multiply-adds per cycle, so sparse only wins well below full density
+    constexpr size_t kSparseWorkRatio = 8;
+}
+
+// -----------------------------------------------------------------------------
+// Constructor
+// -----------------------------------------------------------------------------
+SpatialFilter::SpatialFilter(size_t output_channels, size_t input_channels, std::vector<float> weights,
+                             SpatialLayout layout)
+    : m_outputChannels(output_channels), m_inputChannels(input_channels), m_weights(std::move(weights))
+{
+    if (output_channels == 0 || input_channels == 0)
+    {
+        throw std::invalid_argument("SpatialFilter: the matrix must have at least one row and one column");
+    }
+    if (m_weights.size() != output_channels * input_channels)
+    {
+        throw std::invalid_argument("SpatialFilter: expected " + std::to_string(output_channels * input_channels) +
+                                    " weights, got " + std::to_string(m_weights.size()));
+    }
+    for (float weight : m_weights)
+    {
+        if (!dsp::utils::isFinite(weight))
+        {
+            throw std::invalid_argument("SpatialFilter: weights must be finite");
+        }
+    }
+
+    if (layout != SpatialLayout::Dense)
+    {
+        buildSparse();
+        const size_t terms = m_values.size() + (m_hasRowConstant ? m_inputChannels : 0);
+        m_sparse = layout == SpatialLayout::Sparse ||
+                   terms * kSparseWorkRatio <= m_outputChannels * m_inputChannels;
+    }
+
+    if (!m_sparse)
+    {
+        m_rowConstant.clear();
+        m_rowStart.clear();
+        m_columns.clear();
+        m_values.clear();
+
+        m_transposed.resize(m_weights.size());
+        for (size_t m = 0; m < m_outputChannels; ++m)
+        {
+            for (size_t c = 0; c < m_inputChannels; ++c)
+            {
+                m_transposed[c * m_outputChannels + m] = m_weights[m * m_inputChannels + c];
+            }
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Method: buildSparse
+// Splits each row into its most common value (0 unless another value is
+// strictly more common) and the entries that differ from it
+// -----------------------------------------------------------------------------
+void SpatialFilter::buildSparse()
+{
+    m_rowConstant.assign(m_outputChannels, 0.0f);
+    m_rowStart.assign(1, 0);
+    m_columns.clear();
+    m_values.clear();
+    m_hasRowConstant = false;
+
+    std::vector<float> sorted(m_inputChannels);
+    for (size_t m = 0; m < m_outputChannels; ++m)
+    {
+        const float *row = m_weights.data() + m * m_inputChannels;
+        sorted.assign(row, row + m_inputChannels);
+        std::sort(sorted.begin(), sorted.end());
+
+        float constant = 0.0f;
+        size_t best = static_cast<size_t>(std::count(sorted.begin(), sorted.end(), 0.0f));
+        for (size_t i = 0; i < sorted.size();)
+        {
+            size_t j = i;
+            while (j < sorted.size() && sorted[j] == sorted[i])
+            {
+                ++j;
+            }
+            if (sorted[i] != 0.0f && j - i > best)
+            {
+                best = j - i;
+                constant = sorted[i];
+            }
+            i = j;
+        }
+
+        m_rowConstant[m] = constant;
+        m_hasRowConstant = m_hasRowConstant || constant != 0.0f;
+        for (size_t c = 0; c < m_inputChannels; ++c)
+        {
+            if (row[c] != constant)
+            {
+                m_columns.push_back(static_cast<uint32_t>(c));
+                m_values.push_back(row[c] - constant);
+            }
+        }
+        m_rowStart.push_back(static_cast<uint32_t>(m_values.size()));
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Method: process
+// -----------------------------------------------------------------------------
+void SpatialFilter::process(const float *input, size_t numFrames, float *output) const
+{
+    if (!m_sparse)
+    {
+        dsp::simd::mix_frames({input, m_transposed.data(), output, numFrames, m_inputChannels, m_outputChannels});
+        return;
+    }
+
+    for (size_t f = 0; f < numFrames; ++f)
+    {
+        const float *x = input + f * m_inputChannels;
+        float *y = output + f * m_outputChannels;
+        const float total = m_hasRowConstant ? static_cast<float>(dsp::simd::sum(x, m_inputChannels)) : 0.0f;
+
+        for (size_t m = 0; m < m_outputChannels; ++m)
+        {
+            float acc = m_rowConstant[m] * total;
+            for (uint32_t j = m_rowStart[m]; j < m_rowStart[m + 1]; ++j)
+            {
+                acc += m_values[j] * x[m_columns[j]];
+            }
+            y[m] = acc;
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Presets
+// -----------------------------------------------------------------------------
+std::vector<float> SpatialFilter::commonAverage(size_t channels)
+{
+    if (channels == 0)
+    {
+        throw std::invalid_argument("SpatialFilter: common average reference needs at least one channel");
+    }
+    const float share = 1.0f / static_cast<float>(channels);
+    std::vector<float> weights(channels * channels, -share);
+    for (size_t c = 0; c < channels; ++c)
+    {
+        weights[c * channels + c] = 1.0f - share;
+    }
+    return weights;
+}
+
+std::vector<float> SpatialFilter::laplacian(size_t channels, const std::vector<std::vector<size_t>> &neighbors)
+{
+    if (channels == 0 || neighbors.size() != channels)
+    {
+        throw std::invalid_argument("SpatialFilter: Laplacian needs one neighbor list per channel");
+    }
+    std::vector<float> weights(channels * channels, 0.0f);
+    for (size_t c = 0; c < channels; ++c)
+    {
+        float *row = weights.data() + c * channels;
+        row[c] = 1.0f;
+        if (neighbors[c].empty())
+        {
+            continue;
+        }
+        const float share = 1.0f / static_cast<float>(neighbors[c].size());
+        for (size_t neighbor : neighbors[c])
+        {
+            if (neighbor >= channels || neighbor == c)
+            {
+                throw std::invalid_argument("SpatialFilter: invalid neighbor " + std::to_string(neighbor) +
+                                            " of channel " + std::to_string(c));
+            }
+            row[neighbor] -= share;
+        }
+    }
+    return weights;
+}
+
+std::vector<float> SpatialFilter::bipolar(size_t channels, const std::vector<std::pair<size_t, size_t>> &pairs)
+{
+    if (channels == 0 || pairs.empty())
+    {
+        throw std::invalid_argument("SpatialFilter: bipolar montage needs at least one channel pair");
+    }
+    std::vector<float> weights(pairs.size() * channels, 0.0f);
+    for (size_t m = 0; m < pairs.size(); ++m)
+    {
+        const auto [a, b] = pairs[m];
+        if (a >= channels || b >= channels || a == b)
+        {
+            throw std::invalid_argument("SpatialFilter: invalid bipolar pair (" + std::to_string(a) + ", " +
+                                        std::to_string(b) + ")");
+        }
+        weights[m * channels + a] = 1.0f;
+        weights[m * channels + b] = -1.0f;
+    }
+    return weights;
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace dsp::core
+{
+    /**
+     * @brief How SpatialFilter evaluates its matrix.
+     */
+    enum class SpatialLayout
+    {
+        Auto,  // Sparse when that does at most 1/8 of the dense work
+        Dense, // Blocked SIMD GEMM (simd::mix_frames)
+        Sparse // Per-row nonzero lists plus an optional per-row constant
+    };
+
+    /**
+     * @brief Applies an M x C mixing matrix to every frame of a C-channel stream.
+     *
+     * output[f][m] = sum over c of weights[m * C + c] * input[f][c]. Covers
+     * re-referencing (common average, Laplacian, bipolar montages) and
+     * arbitrary spatial filters such as CSP or ICA unmixing matrices.
+     *
+     * Dense matrices run through a cache-blocked GEMM over the whole chunk.
+     * Montage-style matrices are mostly one value per row (0 for bipolar
+     * and Laplacian rows, -1/C for common average), so the sparse layout
+     * stores each row as that constant plus the entries that differ from
+     * it: y[m] = constant[m] * sum(x) + sum of the few remaining terms.
+     * Common average reference then costs O(C) per frame instead of O(C^2).
+     *
+     * The filter has no state; frames are independent.
+     */
+    class SpatialFilter
+    {
+    public:
+        /**
+         * @brief Constructs the filter.
+         * @param output_channels Rows of the matrix (M).
+         * @param input_channels Columns of the matrix (C).
+         * @param weights M * C weights, row-major (row m produces output channel m).
+         * @param layout Evaluation strategy; Auto picks by sparsity.
+         */
+        SpatialFilter(size_t output_channels, size_t input_channels, std::vector<float> weights,
+                      SpatialLayout layout = SpatialLayout::Auto);
+
+        /**
+         * @brief Common average reference: x[c] - mean(x), C x C.
+         */
+        static std::vector<float> commonAverage(size_t channels);
+
+        /**
+         * @brief Surface Laplacian: x[c] - mean of x over neighbors[c], C x C.
+         * Channels without neighbors pass through unchanged.
+         */
+        static std::vector<float> laplacian(size_t channels, const std::vector<std::vector<size_t>> &neighbors);
+
+        /**
+         * @brief Bipolar montage: one output x[a] - x[b] per (a, b) pair, pairs.size() x C.
+         */
+        static std::vector<float> bipolar(size_t channels, const std::vector<std::pair<size_t, size_t>> &pairs);
+
+        /**
+         * @brief Mixes numFrames interleaved frames.
+         * @param input numFrames * getInputChannels() samples.
+         * @param numFrames Number of frames.
+         * @param output numFrames * getOutputChannels() samples; must not alias input.
+         */
+        void process(const float *input, size_t numFrames, float *output) const;
+
+        size_t getInputChannels() const noexcept { return m_inputChannels; }
+        size_t getOutputChannels() const noexcept { return m_outputChannels; }
+        const std::vector<float> &getWeights() const noexcept { return m_weights; }
+
+        /**
+         * @brief Whether process() uses the sparse layout.
+         */
+        bool isSparse() const noexcept { return m_sparse; }
+
+    private:
+        void buildSparse();
+
+        size_t m_outputChannels;
+        size_t m_inputChannels;
+        std::vector<float> m_weights; // M x C, row-major, as given
+        bool m_sparse = false;
+
+        // Dense layout
+        std::vector<float> m_transposed; // C x M (input-major, as mix_frames() reads it)
+
+        // Sparse layout
+        std::vector<float> m_rowConstant;  // Value most entries of each row share
+        bool m_hasRowConstant = false;     // Any nonzero row constant (needs sum(x))
+        std::vector<uint32_t> m_rowStart;  // M + 1 offsets into m_columns / m_values
+        std::vector<uint32_t> m_columns;   // Input channel of each remaining term
+        std::vector<float> m_values;       // Weight minus the row constant
+    };
+
+} // namespace dsp::core
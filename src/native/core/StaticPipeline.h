@@ -0,0 +1,327 @@
+#pragma once
+
+#include "Policies.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace dsp::core
+{
+    /**
+     * @brief Per-sample steps for StaticPipeline.
+     *
+     * A step maps one sample of one channel to one output sample and keeps
+     * whatever per-channel state it needs. Every step provides:
+     *
+     *   void  resize(size_t numChannels)    drop state, keep numChannels channels
+     *   float apply(float x, size_t channel) the per-sample kernel
+     *   void  advance()                     called once after every frame
+     *   void  clear()
+     *   size_t getWindowSize() const        0 for stateless steps
+     *   size_t getCount() const             samples per channel in the window
+     *   std::vector<float> getWindow(size_t channel) const  oldest first
+     *   void  setWindows(const std::vector<std::vector<float>> &windows)
+     *
+     * apply() and advance() are defined in the class so the pipeline loop can
+     * inline them; the running sums are the same Policies the dynamic
+     * stages use, updated in the same order, so a fused chain produces what
+     * the equivalent per-sample filters produce.
+     */
+    namespace steps
+    {
+        /**
+         * @brief Full-wave (|x|) or half-wave (max(x, 0)) rectification.
+         */
+        class Rectify
+        {
+        public:
+            explicit Rectify(bool halfWave = false) : m_half_wave(halfWave) {}
+
+            void resize(size_t /*numChannels*/) {}
+
+            float apply(float x, size_t /*channel*/) const
+            {
+                return m_half_wave ? std::max(x, 0.0f) : std::abs(x);
+            }
+
+            void advance() {}
+            void clear() {}
+
+            bool isHalfWave() const noexcept { return m_half_wave; }
+            size_t getWindowSize() const noexcept { return 0; }
+            size_t getCount() const noexcept { return 0; }
+            std::vector<float> getWindow(size_t /*channel*/) const { return {}; }
+            void setWindows(const std::vector<std::vector<float>> & /*windows*/) {}
+
+        private:
+            bool m_half_wave;
+        };
+
+        /**
+         * @brief Replaces a sample with Policy::getResult() over the channel's window.
+         */
+        struct WindowResult
+        {
+            template <typename Policy>
+            float operator()(const Policy &policy, size_t count, float /*x*/) const
+            {
+                return policy.getResult(count);
+            }
+        };
+
+        /**
+         * @brief Z-score of the new sample against its channel's window
+         * (same arithmetic as MovingZScoreFilter::addSample()).
+         */
+        struct ZScoreResult
+        {
+            float epsilon = 1e-6f;
+
+            float operator()(const VariancePolicy<float> &policy, size_t count, float x) const
+            {
+                float countT = static_cast<float>(count);
+                float mean = policy.m_sum / countT;
+                float meanOfSquares = policy.m_sum_sq / countT;
+                float stddev = std::sqrt(std::max(0.0f, meanOfSquares - mean * mean));
+                return stddev < epsilon ? 0.0f : (x - mean) / stddev;
+            }
+        };
+
+        /**
+         * @brief Sample-count sliding window over every channel in lock-step.
+         *
+         * The ring stores whole frames (slot s holds sample s of every
+         * channel), like MultiChannelSlidingWindow, so all channels share one
+         * ring position and one sample count.
+         *
+         * @tparam Policy Running-sum policy from Policies.h (one per channel).
+         * @tparam Output Turns the policy, the sample count and the new sample
+         *                into the step's output.
+         */
+        template <typename Policy, typename Output = WindowResult>
+        class Window
+        {
+        public:
+            explicit Window(size_t windowSize, Output output = Output())
+                : m_window_size(windowSize), m_output(output)
+            {
+                if (windowSize == 0)
+                {
+                    throw std::invalid_argument("StaticPipeline: window size must be greater than 0");
+                }
+            }
+
+            void resize(size_t numChannels)
+            {
+                m_num_channels = numChannels;
+                m_ring.assign(m_window_size * numChannels, 0.0f);
+                m_policies.assign(numChannels, Policy());
+                m_head = 0;
+                m_count = 0;
+            }
+
+            float apply(float x, size_t channel)
+            {
+                float &slot = m_ring[m_head * m_num_channels + channel];
+                Policy &policy = m_policies[channel];
+                if (m_count == m_window_size)
+                {
+                    policy.onRemove(slot);
+                }
+                slot = x;
+                policy.onAdd(x);
+                return m_output(policy, std::min(m_count + 1, m_window_size), x);
+            }
+
+            void advance()
+            {
+                if (++m_head == m_window_size)
+                {
+                    m_head = 0;
+                }
+                if (m_count < m_window_size)
+                {
+                    ++m_count;
+                }
+            }
+
+            void clear() { resize(m_num_channels); }
+
+            size_t getWindowSize() const noexcept { return m_window_size; }
+            size_t getCount() const noexcept { return m_count; }
+            const Output &getOutput() const noexcept { return m_output; }
+
+            std::vector<float> getWindow(size_t channel) const
+            {
+                std::vector<float> window(m_count);
+                size_t slot = (m_head + m_window_size - m_count) % m_window_size;
+                for (size_t i = 0; i < m_count; ++i)
+                {
+                    window[i] = m_ring[slot * m_num_channels + channel];
+                    if (++slot == m_window_size)
+                    {
+                        slot = 0;
+                    }
+                }
+                return window;
+            }
+
+            /**
+             * @brief Restores every channel's window (oldest first) and
+             * rebuilds the running sums from it.
+             *
+             * Windows longer than the window size keep their newest samples.
+             * @throws std::runtime_error if the channels' lengths differ.
+             */
+            void setWindows(const std::vector<std::vector<float>> &windows)
+            {
+                resize(windows.size());
+                if (windows.empty())
+                {
+                    return;
+                }
+                const size_t length = windows[0].size();
+                const size_t kept = std::min(length, m_window_size);
+                for (size_t c = 0; c < windows.size(); ++c)
+                {
+                    if (windows[c].size() != length)
+                    {
+                        throw std::runtime_error("StaticPipeline: every channel's window must hold the same number of samples");
+                    }
+                    for (size_t i = length - kept; i < length; ++i)
+                    {
+                        size_t slot = i - (length - kept);
+                        m_ring[slot * m_num_channels + c] = windows[c][i];
+                        m_policies[c].onAdd(windows[c][i]);
+                    }
+                }
+                m_count = kept;
+                m_head = kept % m_window_size;
+            }
+
+        private:
+            size_t m_window_size;
+            Output m_output;
+            size_t m_num_channels = 0;
+            std::vector<float> m_ring;     // m_window_size slots of m_num_channels samples
+            std::vector<Policy> m_policies; // Per channel
+            size_t m_head = 0;              // Next slot to write
+            size_t m_count = 0;             // Samples per channel in the window
+        };
+
+        using MovingAverage = Window<MeanPolicy<float>>;
+        using Rms = Window<RmsPolicy<float>>;
+        using MeanAbsoluteValue = Window<MeanAbsoluteValuePolicy<float>>;
+        using Variance = Window<VariancePolicy<float>>;
+        using ZScore = Window<VariancePolicy<float>, ZScoreResult>;
+    } // namespace steps
+
+    /**
+     * @brief A fixed chain of per-sample steps fused into one loop.
+     *
+     * The dynamic pipeline runs each stage over the whole chunk behind a
+     * virtual call, so a chain of N stages reads and writes the buffer N
+     * times. Here the chain is a type: every sample goes through all steps
+     * while it is in a register, and the compiler can inline the steps into
+     * a single loop.
+     *
+     *   StaticPipeline<steps::Rectify, steps::MeanAbsoluteValue, steps::ZScore>
+     *       pipeline(steps::Rectify(), steps::MeanAbsoluteValue(64),
+     *                steps::ZScore(256, steps::ZScoreResult{1e-6f}));
+     *
+     * State is kept per channel and is dropped when the channel count changes.
+     */
+    template <typename... Steps>
+    class StaticPipeline
+    {
+    public:
+        static constexpr size_t kNumSteps = sizeof...(Steps);
+
+        explicit StaticPipeline(Steps... steps) : m_steps(std::move(steps)...) {}
+
+        /**
+         * @brief Runs every step over an interleaved chunk, in place.
+         * @throws std::invalid_argument if numSamples is not a multiple of numChannels.
+         */
+        void process(float *buffer, size_t numSamples, int numChannels)
+        {
+            if (numChannels <= 0 || numSamples % static_cast<size_t>(numChannels) != 0)
+            {
+                throw std::invalid_argument("StaticPipeline: sample count must be a multiple of the channel count");
+            }
+            const size_t channels = static_cast<size_t>(numChannels);
+            if (channels != m_num_channels)
+            {
+                m_num_channels = channels;
+                forEachStep([channels](auto &step)
+                            { step.resize(channels); });
+            }
+
+            for (size_t frame = 0; frame < numSamples; frame += channels)
+            {
+                float *samples = buffer + frame;
+                for (size_t c = 0; c < channels; ++c)
+                {
+                    samples[c] = std::apply([&](auto &...step)
+                                            {
+                                                float x = samples[c];
+                                                ((x = step.apply(x, c)), ...);
+                                                return x; },
+                                            m_steps);
+                }
+                forEachStep([](auto &step)
+                            { step.advance(); });
+            }
+        }
+
+        void clear()
+        {
+            forEachStep([](auto &step)
+                        { step.clear(); });
+        }
+
+        size_t getNumChannels() const noexcept { return m_num_channels; }
+
+        /**
+         * @brief Sets the channel count and empties every step (used before
+         * restoring their windows).
+         */
+        void setNumChannels(size_t numChannels)
+        {
+            m_num_channels = numChannels;
+            forEachStep([numChannels](auto &step)
+                        { step.resize(numChannels); });
+        }
+
+        template <size_t I>
+        auto &step() { return std::get<I>(m_steps); }
+
+        template <size_t I>
+        const auto &step() const { return std::get<I>(m_steps); }
+
+        template <typename F>
+        void forEachStep(F &&f)
+        {
+            std::apply([&](auto &...step)
+                       { (f(step), ...); },
+                       m_steps);
+        }
+
+        template <typename F>
+        void forEachStep(F &&f) const
+        {
+            std::apply([&](const auto &...step)
+                       { (f(step), ...); },
+                       m_steps);
+        }
+
+    private:
+        std::tuple<Steps...> m_steps;
+        size_t m_num_channels = 0;
+    };
+
+} // namespace dsp::core
@@ -0,0 +1,718 @@
+#include "StreamingPca.h"
+#include "../utils/FloatBits.h"
+#include "../utils/SimdOps.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+using namespace dsp::core;
+
+namespace
+{
+    struct ModeName
+    {
+        PcaMode mode;
+        const char *name;
+    };
+
+    constexpr ModeName kModeNames[] = {
+        {PcaMode::Pca, "pca"},
+        {PcaMode::Whiten, "whiten"},
+        {PcaMode::Zca, "zca"},
+    };
+
+    // Bounds a missed wake-up (the processing thread notifies without the lock)
+    constexpr std::chrono::milliseconds kWorkerPoll(20);
+
+    constexpr int kMaxQlIterations = 64;
+
+    /**
+     * Eigen-decomposition of the symmetric n x n matrix `v` (row-major):
+     * Householder reduction to tridiagonal form, then implicit QL with
+     * shifts (the EISPACK tred2 / tql2 pair). On return the columns of `v`
+     * hold the eigenvectors and `d` the eigenvalues (unsorted); `e` is n
+     * values of scratch. O(n^3) with a small constant and no allocation,
+     * so it can run on the processing thread.
+     */
+    void symmetricEigen(double *v, double *d, double *e, size_t n)
+    {
+        auto V = [v, n](size_t row, size_t column) -> double &
+        {
+            return v[row * n + column];
+        };
+
+        // ---- Householder tridiagonalization
+        for (size_t j = 0; j < n; ++j)
+        {
+            d[j] = V(n - 1, j);
+        }
+        for (size_t i = n - 1; i > 0; --i)
+        {
+            double scale = 0.0;
+            double h = 0.0;
+            for (size_t k = 0; k < i; ++k)
+            {
+                scale += std::abs(d[k]);
+            }
+            if (scale == 0.0)
+            {
+                e[i] = d[i - 1];
+                for (size_t j = 0; j < i; ++j)
+                {
+                    d[j] = V(i - 1, j);
+                    V(i, j) = 0.0;
+                    V(j, i) = 0.0;
+                }
+            }
+            else
+            {
+                for (size_t k = 0; k < i; ++k)
+                {
+                    d[k] /= scale;
+                    h += d[k] * d[k];
+                }
+                double f = d[i - 1];
+                double g = f > 0.0 ? -std::sqrt(h) : std::sqrt(h);
+                e[i] = scale * g;
+                h -= f * g;
+                d[i - 1] = f - g;
+                std::fill(e, e + i, 0.0);
+
+                for (size_t j = 0; j < i; ++j)
+                {
+                    f = d[j];
+                    V(j, i) = f;
+                    g = e[j] + V(j, j) * f;
+                    for (size_t k = j + 1; k < i; ++k)
+                    {
+                        g += V(k, j) * d[k];
+                        e[k] += V(k, j) * f;
+                    }
+                    e[j] = g;
+                }
+                f = 0.0;
+                for (size_t j = 0; j < i; ++j)
+                {
+                    e[j] /= h;
+                    f += e[j] * d[j];
+                }
+                const double hh = f / (h + h);
+                for (size_t j = 0; j < i; ++j)
+                {
+                    e[j] -= hh * d[j];
+                }
+                for (size_t j = 0; j < i; ++j)
+                {
+                    f = d[j];
+                    g = e[j];
+                    for (size_t k = j; k < i; ++k)
+                    {
+                        V(k, j) -= f * e[k] + g * d[k];
+                    }
+                    d[j] = V(i - 1, j);
+                    V(i, j) = 0.0;
+                }
+            }
+            d[i] = h;
+        }
+
+        // Accumulate the Householder reflections into v
+        for (size_t i = 0; i + 1 < n; ++i)
+        {
+            V(n - 1, i) = V(i, i);
+            V(i, i) = 1.0;
+            const double h = d[i + 1];
+            if (h != 0.0)
+            {
+                for (size_t k = 0; k <= i; ++k)
+                {
+                    d[k] = V(k, i + 1) / h;
+                }
+                for (size_t j = 0; j <= i; ++j)
+                {
+                    double g = 0.0;
+                    for (size_t k = 0; k <= i; ++k)
+                    {
+                        g += V(k, i + 1) * V(k, j);
+                    }
+                    for (size_t k = 0; k <= i; ++k)
+                    {
+                        V(k, j) -= g * d[k];
+                    }
+                }
+            }
+            for (size_t k = 0; k <= i; ++k)
+            {
+                V(k, i + 1) = 0.0;
+            }
+        }
+        for (size_t j = 0; j < n; ++j)
+        {
+            d[j] = V(n - 1, j);
+            V(n - 1, j) = 0.0;
+        }
+        V(n - 1, n - 1) = 1.0;
+        e[0] = 0.0;
+
+        // ---- Implicit QL on the tridiagonal (d, e)
+        for (size_t i = 1; i < n; ++i)
+        {
+            e[i - 1] = e[i];
+        }
+        e[n - 1] = 0.0;
+
+        const double eps = std::numeric_limits<double>::epsilon();
+        double shift = 0.0;
+        double norm = 0.0;
+        for (size_t l = 0; l < n; ++l)
+        {
+            norm = std::max(norm, std::abs(d[l]) + std::abs(e[l]));
+            size_t m = l;
+            while (m + 1 < n && std::abs(e[m]) > eps * norm)
+            {
+                ++m;
+            }
+
+            for (int iteration = 0; m > l && iteration < kMaxQlIterations && std::abs(e[l]) > eps * norm;
+                 ++iteration)
+            {
+                double g = d[l];
+                double p = (d[l + 1] - g) / (2.0 * e[l]);
+                double r = std::hypot(p, 1.0);
+                if (p < 0.0)
+                {
+                    r = -r;
+                }
+                d[l] = e[l] / (p + r);
+                d[l + 1] = e[l] * (p + r);
+                const double dl1 = d[l + 1];
+                double h = g - d[l];
+                for (size_t i = l + 2; i < n; ++i)
+                {
+                    d[i] -= h;
+                }
+                shift += h;
+
+                p = d[m];
+                double c = 1.0, c2 = 1.0, c3 = 1.0;
+                double s = 0.0, s2 = 0.0;
+                const double el1 = e[l + 1];
+                for (size_t i = m; i-- > l;)
+                {
+                    c3 = c2;
+                    c2 = c;
+                    s2 = s;
+                    g = c * e[i];
+                    h = c * p;
+                    r = std::hypot(p, e[i]);
+                    e[i + 1] = s * r;
+                    s = e[i] / r;
+                    c = p / r;
+                    p = c * d[i] - s * g;
+                    d[i + 1] = h + s * (c * g + s * d[i]);
+                    for (size_t k = 0; k < n; ++k)
+                    {
+                        h = V(k, i + 1);
+                        V(k, i + 1) = s * V(k, i) + c * h;
+                        V(k, i) = c * V(k, i) - s * h;
+                    }
+                }
+                p = -s * s2 * c3 * el1 * e[l] / dl1;
+                e[l] = s * p;
+                d[l] = c * p;
+            }
+            d[l] += shift;
+            e[l] = 0.0;
+        }
+    }
+}
+
+const char *dsp::core::pcaModeName(PcaMode mode) noexcept
+{
+    for (const auto &entry : kModeNames)
+    {
+        if (entry.mode == mode)
+        {
+            return entry.name;
+        }
+    }
+    return "";
+}
+
+bool dsp::core::parsePcaMode(const std::string &name, PcaMode &mode) noexcept
+{
+    for (const auto &entry : kModeNames)
+    {
+        if (name == entry.name)
+        {
+            mode = entry.mode;
+            return true;
+        }
+    }
+    return false;
+}
+
+// -----------------------------------------------------------------------------
+// Constructor / destructor
+// -----------------------------------------------------------------------------
+StreamingPca::StreamingPca(size_t channels, const PcaOptions &options)
+    : m_channels(channels), m_options(options)
+{
+    if (channels == 0)
+    {
+        throw std::invalid_argument("StreamingPca: channel count must be greater than 0");
+    }
+    if (options.components > channels)
+    {
+        throw std::invalid_argument("StreamingPca: cannot keep " + std::to_string(options.components) +
+                                    " components of " + std::to_string(channels) + " channels");
+    }
+    if ((options.windowSize == 0) == (options.alpha == 0.0))
+    {
+        throw std::invalid_argument("StreamingPca: exactly one of windowSize and alpha must be set");
+    }
+    if (options.windowSize == 0 && !(options.alpha > 0.0 && options.alpha <= 1.0))
+    {
+        throw std::invalid_argument("StreamingPca: alpha must be in (0, 1]");
+    }
+    if (options.updateInterval == 0)
+    {
+        throw std::invalid_argument("StreamingPca: update interval must be greater than 0");
+    }
+    if (!(options.epsilon >= 0.0))
+    {
+        throw std::invalid_argument("StreamingPca: epsilon must be non-negative");
+    }
+
+    m_components = options.components == 0 ? channels : options.components;
+    m_outputChannels = options.mode == PcaMode::Zca ? channels : m_components;
+
+    m_first.assign(channels, 0.0);
+    m_second.assign(channels * channels, 0.0);
+    m_delta.assign(channels, 0.0);
+    m_window.assign(options.windowSize * channels, 0.0f);
+    initProjection(m_inline);
+    initWorkspace(m_inlineSpace);
+
+    if (options.background)
+    {
+        for (size_t i = 0; i < 3; ++i)
+        {
+            m_snapshots.slot(i).first.assign(channels, 0.0);
+            m_snapshots.slot(i).second.assign(channels * channels, 0.0);
+            initProjection(m_projections.slot(i));
+        }
+        initWorkspace(m_workerSpace);
+        m_worker = std::thread(&StreamingPca::workerLoop, this);
+    }
+}
+
+StreamingPca::~StreamingPca()
+{
+    if (m_worker.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_wakeMutex);
+            m_stop = true;
+        }
+        m_wake.notify_one();
+        m_worker.join();
+    }
+}
+
+void StreamingPca::initProjection(Projection &projection) const
+{
+    projection.weights.assign(m_channels * m_outputChannels, 0.0f);
+    projection.bias.assign(m_outputChannels, 0.0f);
+    projection.eigenvalues.assign(m_components, 0.0);
+}
+
+void StreamingPca::initWorkspace(Workspace &workspace) const
+{
+    workspace.mean.assign(m_channels, 0.0);
+    workspace.matrix.assign(m_channels * m_channels, 0.0);
+    workspace.offDiagonal.assign(m_channels, 0.0);
+    workspace.values.assign(m_channels, 0.0);
+    workspace.order.assign(m_channels, 0);
+}
+
+// -----------------------------------------------------------------------------
+// Method: process
+// Splits the chunk at decomposition points, so a projection computed inline
+// applies from the very next frame
+// -----------------------------------------------------------------------------
+void StreamingPca::process(const float *input, size_t numFrames, float *output)
+{
+    size_t f = 0;
+    while (f < numFrames)
+    {
+        if (m_options.background)
+        {
+            pickUp();
+        }
+
+        const size_t run = std::min(numFrames - f, m_options.updateInterval - m_sinceUpdate);
+        project(input + f * m_channels, run, output + f * m_outputChannels);
+        for (size_t i = 0; i < run; ++i)
+        {
+            accumulate(input + (f + i) * m_channels);
+        }
+
+        f += run;
+        m_sinceUpdate += run;
+        if (m_sinceUpdate == m_options.updateInterval)
+        {
+            m_sinceUpdate = 0;
+            requestUpdate();
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Method: accumulate
+// Rank-1 update of the upper triangle of the second moment
+// -----------------------------------------------------------------------------
+void StreamingPca::accumulate(const float *frame)
+{
+    const size_t C = m_channels;
+    double *__restrict second = m_second.data();
+
+    if (m_options.windowSize == 0)
+    {
+        // Exponentially weighted mean and covariance; plain averages until
+        // 1/count drops below alpha, so the start is not biased towards 0
+        ++m_count;
+        const double a = std::max(m_options.alpha, 1.0 / static_cast<double>(m_count));
+        double *__restrict delta = m_delta.data();
+        for (size_t c = 0; c < C; ++c)
+        {
+            delta[c] = frame[c] - m_first[c];
+            m_first[c] += a * delta[c];
+        }
+        for (size_t i = 0; i < C; ++i)
+        {
+            double *row = second + i * C;
+            const double scaled = a * delta[i];
+            for (size_t j = i; j < C; ++j)
+            {
+                row[j] = (1.0 - a) * (row[j] + scaled * delta[j]);
+            }
+        }
+        return;
+    }
+
+    // Sliding window: add the new frame, remove the one leaving the window
+    float *slot = m_window.data() + m_head * C;
+    const bool full = m_count == m_options.windowSize;
+    for (size_t i = 0; i < C; ++i)
+    {
+        const double x = frame[i];
+        const double old = full ? slot[i] : 0.0;
+        m_first[i] += x - old;
+        double *row = second + i * C;
+        for (size_t j = i; j < C; ++j)
+        {
+            row[j] += x * frame[j] - old * (full ? slot[j] : 0.0f);
+        }
+    }
+    std::copy(frame, frame + C, slot);
+    m_head = (m_head + 1) % m_options.windowSize;
+    if (!full)
+    {
+        ++m_count;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Method: project
+// -----------------------------------------------------------------------------
+void StreamingPca::project(const float *input, size_t numFrames, float *output) const
+{
+    const size_t M = m_outputChannels;
+    if (m_current == nullptr)
+    {
+        std::fill(output, output + numFrames * M, 0.0f);
+        return;
+    }
+
+    dsp::simd::mix_frames({input, m_current->weights.data(), output, numFrames, m_channels, M});
+    const float *bias = m_current->bias.data();
+    for (size_t f = 0; f < numFrames; ++f)
+    {
+        float *__restrict y = output + f * M;
+        for (size_t m = 0; m < M; ++m)
+        {
+            y[m] += bias[m];
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Method: requestUpdate
+// -----------------------------------------------------------------------------
+void StreamingPca::requestUpdate()
+{
+    if (!m_options.background)
+    {
+        decompose(m_count, m_first.data(), m_second.data(), m_inline, m_inlineSpace);
+        m_current = m_inline.valid ? &m_inline : nullptr;
+        return;
+    }
+
+    Snapshot &snapshot = m_snapshots.back();
+    snapshot.generation = m_generation;
+    snapshot.count = m_count;
+    std::copy(m_first.begin(), m_first.end(), snapshot.first.begin());
+    std::copy(m_second.begin(), m_second.end(), snapshot.second.begin());
+    m_snapshots.publish();
+    m_wake.notify_one();
+}
+
+// -----------------------------------------------------------------------------
+// Method: pickUp
+// Swaps in the worker's latest projection. Projections of a covariance from
+// before reset() / setState() are dropped; m_current never points at them
+// then (it is nullptr or &m_inline), so the swapped-out slot is not in use.
+// -----------------------------------------------------------------------------
+void StreamingPca::pickUp()
+{
+    if (!m_projections.update())
+    {
+        return;
+    }
+    const Projection &latest = m_projections.front();
+    if (latest.generation == m_generation && latest.valid)
+    {
+        m_current = &latest;
+    }
+    else if (m_current != &m_inline)
+    {
+        m_current = nullptr;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Method: workerLoop
+// -----------------------------------------------------------------------------
+void StreamingPca::workerLoop()
+{
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_wakeMutex);
+            m_wake.wait_for(lock, kWorkerPoll, [this]
+                            { return m_stop.load() || m_snapshots.hasFresh(); });
+            if (m_stop)
+            {
+                return;
+            }
+        }
+        if (!m_snapshots.update())
+        {
+            continue;
+        }
+
+        const Snapshot &snapshot = m_snapshots.front();
+        Projection &projection = m_projections.back();
+        decompose(snapshot.count, snapshot.first.data(), snapshot.second.data(), projection, m_workerSpace);
+        projection.generation = snapshot.generation;
+        m_projections.publish();
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Method: decompose
+// Covariance -> eigenpairs (largest first, largest entry of each vector
+// positive so projections do not flip sign between updates) -> weights
+// -----------------------------------------------------------------------------
+void StreamingPca::decompose(size_t count, const double *first, const double *second,
+                             Projection &projection, Workspace &workspace) const
+{
+    const size_t C = m_channels;
+    const size_t K = m_components;
+    const size_t M = m_outputChannels;
+    projection.valid = false;
+    if (count < 2)
+    {
+        return;
+    }
+
+    double *mean = workspace.mean.data();
+    double *a = workspace.matrix.data();
+    const bool windowed = m_options.windowSize != 0;
+    const double n = static_cast<double>(count);
+    for (size_t i = 0; i < C; ++i)
+    {
+        mean[i] = windowed ? first[i] / n : first[i];
+    }
+    for (size_t i = 0; i < C; ++i)
+    {
+        for (size_t j = i; j < C; ++j)
+        {
+            double value = windowed ? second[i * C + j] / n - mean[i] * mean[j] : second[i * C + j];
+            if (!dsp::utils::isFinite(value))
+            {
+                return;
+            }
+            a[i * C + j] = value;
+            a[j * C + i] = value;
+        }
+    }
+
+    double *values = workspace.values.data();
+    symmetricEigen(a, values, workspace.offDiagonal.data(), C);
+    const double *v = a;
+
+    size_t *order = workspace.order.data();
+    for (size_t i = 0; i < C; ++i)
+    {
+        order[i] = i;
+        values[i] = std::max(0.0, values[i]);
+    }
+    std::sort(order, order + C, [values](size_t x, size_t y)
+              { return values[x] > values[y]; });
+
+    // Row k of the K x C projection, scaled for whitening, is kept in
+    // projection.weights' transpose slots directly
+    std::fill(projection.weights.begin(), projection.weights.end(), 0.0f);
+    for (size_t k = 0; k < K; ++k)
+    {
+        const size_t column = order[k];
+        const double lambda = values[column];
+        projection.eigenvalues[k] = lambda;
+
+        size_t largest = 0;
+        for (size_t c = 1; c < C; ++c)
+        {
+            if (std::abs(v[c * C + column]) > std::abs(v[largest * C + column]))
+            {
+                largest = c;
+            }
+        }
+        const double sign = v[largest * C + column] < 0.0 ? -1.0 : 1.0;
+        const double scale = m_options.mode == PcaMode::Pca ? sign : sign / std::sqrt(lambda + m_options.epsilon);
+
+        if (m_options.mode == PcaMode::Zca)
+        {
+            // W = sum over k of scale_k * v_k v_k^T (sign cancels)
+            for (size_t c = 0; c < C; ++c)
+            {
+                const double vc = v[c * C + column] * std::abs(scale);
+                for (size_t m = 0; m < M; ++m)
+                {
+                    projection.weights[c * M + m] += static_cast<float>(vc * v[m * C + column]);
+                }
+            }
+        }
+        else
+        {
+            for (size_t c = 0; c < C; ++c)
+            {
+                projection.weights[c * M + k] = static_cast<float>(scale * v[c * C + column]);
+            }
+        }
+    }
+
+    for (size_t m = 0; m < M; ++m)
+    {
+        double bias = 0.0;
+        for (size_t c = 0; c < C; ++c)
+        {
+            bias -= projection.weights[c * M + m] * mean[c];
+        }
+        projection.bias[m] = static_cast<float>(bias);
+        // Whitening a zero eigenvalue with epsilon 0 divides by zero
+        if (!dsp::utils::isFinite(bias))
+        {
+            return;
+        }
+    }
+    projection.valid = true;
+}
+
+// -----------------------------------------------------------------------------
+// State
+// -----------------------------------------------------------------------------
+std::vector<double> StreamingPca::getEigenvalues() const
+{
+    return m_current != nullptr ? m_current->eigenvalues : std::vector<double>();
+}
+
+PcaState StreamingPca::getState() const
+{
+    PcaState state;
+    state.count = m_count;
+    state.sinceUpdate = m_sinceUpdate;
+    state.first = m_first;
+    state.second = m_second;
+    if (m_current != nullptr)
+    {
+        state.weights = m_current->weights;
+        state.bias = m_current->bias;
+        state.eigenvalues = m_current->eigenvalues;
+    }
+    if (m_options.windowSize != 0)
+    {
+        // Oldest first: the ring starts at m_head once it is full
+        const size_t C = m_channels;
+        const size_t start = m_count == m_options.windowSize ? m_head : 0;
+        state.window.reserve(m_count * C);
+        for (size_t i = 0; i < m_count; ++i)
+        {
+            const float *frame = m_window.data() + ((start + i) % m_options.windowSize) * C;
+            state.window.insert(state.window.end(), frame, frame + C);
+        }
+    }
+    return state;
+}
+
+void StreamingPca::setState(const PcaState &state)
+{
+    const size_t C = m_channels;
+    const bool windowed = m_options.windowSize != 0;
+    if (state.first.size() != C || state.second.size() != C * C || state.sinceUpdate >= m_options.updateInterval ||
+        (windowed && (state.count > m_options.windowSize || state.window.size() != state.count * C)) ||
+        (!state.weights.empty() && (state.weights.size() != C * m_outputChannels ||
+                                    state.bias.size() != m_outputChannels ||
+                                    state.eigenvalues.size() != m_components)))
+    {
+        throw std::runtime_error("StreamingPca: state does not match the configuration");
+    }
+
+    m_count = state.count;
+    m_sinceUpdate = state.sinceUpdate;
+    m_first = state.first;
+    m_second = state.second;
+    if (windowed)
+    {
+        std::fill(m_window.begin(), m_window.end(), 0.0f);
+        std::copy(state.window.begin(), state.window.end(), m_window.begin());
+        m_head = m_count % m_options.windowSize;
+    }
+
+    // Decompositions still in flight describe the old estimate
+    ++m_generation;
+    m_current = nullptr;
+    if (!state.weights.empty())
+    {
+        std::copy(state.weights.begin(), state.weights.end(), m_inline.weights.begin());
+        std::copy(state.bias.begin(), state.bias.end(), m_inline.bias.begin());
+        std::copy(state.eigenvalues.begin(), state.eigenvalues.end(), m_inline.eigenvalues.begin());
+        m_inline.valid = true;
+        m_current = &m_inline;
+    }
+}
+
+void StreamingPca::reset()
+{
+    m_count = 0;
+    m_sinceUpdate = 0;
+    m_head = 0;
+    std::fill(m_first.begin(), m_first.end(), 0.0);
+    std::fill(m_second.begin(), m_second.end(), 0.0);
+    std::fill(m_window.begin(), m_window.end(), 0.0f);
+    ++m_generation;
+    m_current = nullptr;
+}
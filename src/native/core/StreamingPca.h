@@ -0,0 +1,206 @@
+#pragma once
+#include "../utils/TripleBuffer.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dsp::core
+{
+    /**
+     * @brief What StreamingPca does with the eigenvectors it tracks.
+     */
+    enum class PcaMode
+    {
+        Pca,    // y = V_K^T (x - mean): K principal components
+        Whiten, // y = diag(1 / sqrt(lambda + eps)) V_K^T (x - mean): K unit-variance components
+        Zca     // y = V_K diag(1 / sqrt(lambda + eps)) V_K^T (x - mean): whitened, back in channel space
+    };
+
+    /**
+     * @brief Mode name as used in stage parameters ("pca", "whiten", "zca").
+     */
+    const char *pcaModeName(PcaMode mode) noexcept;
+
+    /**
+     * @brief Parses a name returned by pcaModeName().
+     * @return false if the name is unknown
+     */
+    bool parsePcaMode(const std::string &name, PcaMode &mode) noexcept;
+
+    struct PcaOptions
+    {
+        PcaMode mode = PcaMode::Pca;
+        size_t components = 0;       // Eigenvectors kept, largest first (0 = all)
+        size_t windowSize = 0;       // Frames in a sliding window (0 = exponential weighting)
+        double alpha = 0.0;          // Exponential weight of each new frame (windowSize == 0)
+        size_t updateInterval = 256; // Frames between eigen-decompositions
+        double epsilon = 1e-6;       // Added to eigenvalues before whitening
+        bool background = true;      // Decompose on a worker thread instead of inline
+    };
+
+    /**
+     * @brief Running covariance of the channels, as restored by setState().
+     *
+     * Exponential weighting: first = mean, second = covariance. Sliding
+     * window: first = sum of the frames, second = sum of their outer
+     * products, window = the frames in the window, oldest first. Only the
+     * upper triangle of second (row-major, C x C) is meaningful.
+     *
+     * weights / bias / eigenvalues are the projection in use (empty if
+     * there is none yet), so a restored instance projects exactly like the
+     * original until its next update point.
+     */
+    struct PcaState
+    {
+        size_t count = 0;       // Frames seen (exponential) or in the window
+        size_t sinceUpdate = 0; // Frames since the last decomposition
+        std::vector<double> first;
+        std::vector<double> second;
+        std::vector<float> window;
+        std::vector<float> weights;      // C x M, input-major
+        std::vector<float> bias;         // M
+        std::vector<double> eigenvalues; // K, largest first
+    };
+
+    /**
+     * @brief Streaming PCA / whitening of a multi-channel stream.
+     *
+     * Every frame updates the channel covariance (exponentially weighted,
+     * or over a sliding window) with a rank-1 update in double precision.
+     * Every updateInterval frames the covariance is eigen-decomposed
+     * (Householder tridiagonalization + implicit QL, O(C^3)) into a
+     * projection, and each chunk is mapped through
+     * the latest projection with the blocked SIMD GEMM (simd::mix_frames).
+     * Until the first projection exists the output is 0.
+     *
+     * In background mode the processing thread only copies the covariance
+     * into a TripleBuffer and wakes a worker thread; the finished projection
+     * comes back through another TripleBuffer and is swapped in at the next
+     * segment boundary. Neither side waits for the other and processing
+     * never allocates. If decompositions take longer than updateInterval
+     * frames, intermediate snapshots are skipped and the projection simply
+     * lags.
+     */
+    class StreamingPca
+    {
+    public:
+        StreamingPca(size_t channels, const PcaOptions &options);
+        ~StreamingPca();
+
+        StreamingPca(const StreamingPca &) = delete;
+        StreamingPca &operator=(const StreamingPca &) = delete;
+
+        /**
+         * @brief Projects numFrames interleaved frames, then adds them to the estimate.
+         * @param input numFrames * getInputChannels() samples.
+         * @param numFrames Number of frames.
+         * @param output numFrames * getOutputChannels() samples; must not alias input.
+         */
+        void process(const float *input, size_t numFrames, float *output);
+
+        size_t getInputChannels() const noexcept { return m_channels; }
+        size_t getOutputChannels() const noexcept { return m_outputChannels; }
+        size_t getComponents() const noexcept { return m_components; }
+        const PcaOptions &getOptions() const noexcept { return m_options; }
+
+        /**
+         * @brief Frames currently in the estimate.
+         */
+        size_t getCount() const noexcept { return m_count; }
+
+        /**
+         * @brief Whether process() applies a projection yet (processing thread only).
+         */
+        bool hasProjection() const noexcept { return m_current != nullptr; }
+
+        /**
+         * @brief Eigenvalues of the projection in use, largest first (empty if none).
+         */
+        std::vector<double> getEigenvalues() const;
+
+        PcaState getState() const;
+
+        /**
+         * @brief Restores a getState() result, including the projection in use.
+         */
+        void setState(const PcaState &state);
+
+        /**
+         * @brief Clears the estimate and drops the projection.
+         */
+        void reset();
+
+    private:
+        struct Projection
+        {
+            uint64_t generation = 0;
+            bool valid = false;
+            std::vector<float> weights;      // C x M, input-major (as mix_frames() reads it)
+            std::vector<float> bias;         // M: -W * mean
+            std::vector<double> eigenvalues; // K, largest first
+        };
+
+        struct Snapshot
+        {
+            uint64_t generation = 0;
+            size_t count = 0;
+            std::vector<double> first;
+            std::vector<double> second;
+        };
+
+        // Scratch of one decomposition (one per thread that runs them)
+        struct Workspace
+        {
+            std::vector<double> mean;
+            std::vector<double> matrix; // Covariance in, eigenvectors out
+            std::vector<double> values;
+            std::vector<double> offDiagonal;
+            std::vector<size_t> order;
+        };
+
+        void initProjection(Projection &projection) const;
+        void initWorkspace(Workspace &workspace) const;
+        void accumulate(const float *frame);
+        void project(const float *input, size_t numFrames, float *output) const;
+        void decompose(size_t count, const double *first, const double *second,
+                       Projection &projection, Workspace &workspace) const;
+        void requestUpdate();
+        void pickUp();
+        void workerLoop();
+
+        size_t m_channels;
+        PcaOptions m_options;
+        size_t m_components;
+        size_t m_outputChannels;
+
+        // Estimate (processing thread)
+        size_t m_count = 0;
+        size_t m_sinceUpdate = 0;
+        std::vector<double> m_first;
+        std::vector<double> m_second;
+        std::vector<double> m_delta;
+        std::vector<float> m_window;
+        size_t m_head = 0;
+        uint64_t m_generation = 1;
+
+        // Projection in use: nullptr, &m_inline or &m_projections.front()
+        const Projection *m_current = nullptr;
+        Projection m_inline;
+        Workspace m_inlineSpace;
+
+        // Background decomposition
+        dsp::utils::TripleBuffer<Snapshot> m_snapshots;
+        dsp::utils::TripleBuffer<Projection> m_projections;
+        Workspace m_workerSpace;
+        std::mutex m_wakeMutex;
+        std::condition_variable m_wake;
+        std::atomic<bool> m_stop{false};
+        std::thread m_worker;
+    };
+
+} // namespace dsp::core
@@ -57,6 +57,11 @@ namespace dsp::core
             m_is_initialized = false;
         }
 
+        /**
+         * @brief Gets the number of differences currently in the window.
+         */
+        size_t getCount() const noexcept { return m_filter.getCount(); }
+
         /**
          * @brief Exports the complete filter state (buffer + previous sample).
          * @return A pair containing the buffer contents, running sum, and previous sample.
@@ -81,6 +86,11 @@ namespace dsp::core
             m_is_initialized = true; // Assume if state is set, we are init'd
         }
 
+        /**
+         * @brief Gets the window's position in its push history (for delta snapshots).
+         */
+        dsp::utils::WindowMark getWindowMark() const noexcept { return m_filter.getWindowMark(); }
+
         /**
          * @brief Gets const access to the internal SlidingWindowFilter.
          * @return const SlidingWindowFilter<float, SumPolicy<float>>& Reference to the internal filter
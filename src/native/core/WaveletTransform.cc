@@ -0,0 +1,714 @@
+#include "WaveletTransform.h"
+#include "../utils/FloatBits.h"
+#include "../utils/SimdOps.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+using namespace dsp::core;
+
+namespace
+{
+    // Daubechies scaling filters h of db1 - db10, back to back: the 2N taps
+    // of db<N> start at N (N - 1). Computed by spectral factorization of the
+    // maximally flat half-band filter, keeping the roots inside the unit
+    // circle (the usual minimum-phase choice), normalized to sum sqrt(2).
+    constexpr double kScalingFilters[] = {
+        // db1
+        0.70710678118654752, 0.70710678118654752,
+        // db2
+        0.48296291314453414, 0.83651630373780791, 0.22414386804201338, -0.12940952255126038,
+        // db3
+        0.33267055295008262, 0.80689150931109258, 0.45987750211849157, -0.13501102001025459, -0.085441273882026662,
+        0.035226291885709537,
+        // db4
+        0.23037781330889650, 0.71484657055291565, 0.63088076792985891, -0.027983769416859854, -0.18703481171909308,
+        0.030841381835560764, 0.032883011666885200, -0.010597401785069032,
+        // db5
+        0.16010239797419291, 0.60382926979718967, 0.72430852843777293, 0.13842814590132073, -0.24229488706638203,
+        -0.032244869584638375, 0.077571493840045714, -0.0062414902127982743, -0.012580751999081999,
+        0.0033357252854737713,
+        // db6
+        0.11154074335010946, 0.49462389039845309, 0.75113390802109535, 0.31525035170919763, -0.22626469396543982,
+        -0.12976686756726194, 0.097501605587323049, 0.027522865530305729, -0.031582039317486030,
+        0.00055384220116149614, 0.0047772575109455106, -0.0010773010853084796,
+        // db7
+        0.077852054085009179, 0.39653931948191731, 0.72913209084623512, 0.46978228740519312, -0.14390600392856498,
+        -0.22403618499387498, 0.071309219266830265, 0.080612609151083072, -0.038029936935014414,
+        -0.016574541630666881, 0.012550998556099841, 0.00042957797292136652, -0.0018016407040474909,
+        0.00035371379997452025,
+        // db8
+        0.054415842243104010, 0.31287159091429997, 0.67563073629728981, 0.58535468365420671, -0.015829105256349306,
+        -0.28401554296154693, 0.00047248457391328277, 0.12874742662047846, -0.017369301001807546,
+        -0.044088253930794752, 0.013981027917398282, 0.0087460940474057767, -0.0048703529934515743,
+        -0.00039174037337694705, 0.00067544940645056937, -0.00011747678412476953,
+        // db9
+        0.038077947363878347, 0.24383467461259035, 0.60482312369011111, 0.65728807805130054, 0.13319738582500758,
+        -0.29327378327917491, -0.096840783222976461, 0.14854074933810638, 0.030725681479333379,
+        -0.067632829061329974, 0.00025094711483145196, 0.022361662123679097, -0.0047232047577513973,
+        -0.0042815036824634298, 0.0018476468830562265, 0.00023038576352319597, -0.00025196318894271014,
+        0.000039347320316271599,
+        // db10
+        0.026670057900555554, 0.18817680007769149, 0.52720118893172559, 0.68845903945360357, 0.28117234366057746,
+        -0.24984642432731538, -0.19594627437737704, 0.12736934033579326, 0.093057364603572351,
+        -0.071394147166397087, -0.029457536821875813, 0.033212674059341002, 0.0036065535669561697,
+        -0.010733175483330575, 0.0013953517470529012, 0.0019924052951850561, -0.00068585669495971163,
+        -0.00011646685512928545, 0.000093588670320069591, -0.000013264202894521245,
+    };
+
+    // Largest entry left where the lattice factorization expects a zero
+    constexpr double kLatticeTolerance = 1e-9;
+
+    struct ModeName
+    {
+        WaveletMode mode;
+        const char *name;
+    };
+
+    constexpr ModeName kModeNames[] = {
+        {WaveletMode::Decompose, "decompose"},
+        {WaveletMode::Denoise, "denoise"},
+    };
+
+    struct ThresholdName
+    {
+        WaveletThreshold threshold;
+        const char *name;
+    };
+
+    constexpr ThresholdName kThresholdNames[] = {
+        {WaveletThreshold::Soft, "soft"},
+        {WaveletThreshold::Hard, "hard"},
+    };
+
+    // Appends size zeros to buffer and returns where they start
+    float *grow(std::vector<float> &buffer, size_t size)
+    {
+        const size_t used = buffer.size();
+        buffer.resize(used + size);
+        return buffer.data() + used;
+    }
+
+    void dropFront(std::vector<float> &buffer, size_t size)
+    {
+        buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(size));
+    }
+
+    // target row r = scale * source row r, rows of channels samples at the given strides
+    void scaleRows(const float *source, size_t sourceStride, float *target, size_t targetStride, size_t rows,
+                   size_t channels, float scale)
+    {
+        if (channels == 1)
+        {
+            // The common mono case: a plain strided loop the compiler can vectorize
+            for (size_t r = 0; r < rows; ++r)
+            {
+                target[r * targetStride] = scale * source[r * sourceStride];
+            }
+            return;
+        }
+        for (size_t r = 0; r < rows; ++r)
+        {
+            for (size_t c = 0; c < channels; ++c)
+            {
+                target[r * targetStride + c] = scale * source[r * sourceStride + c];
+            }
+        }
+    }
+
+    // Branch-free so both loops vectorize
+    void shrink(float *details, size_t size, float threshold, WaveletThreshold mode)
+    {
+        if (!(threshold > 0.0f))
+        {
+            return;
+        }
+        if (mode == WaveletThreshold::Soft)
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                details[i] -= std::min(std::max(details[i], -threshold), threshold);
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                details[i] = std::abs(details[i]) > threshold ? details[i] : 0.0f;
+            }
+        }
+    }
+
+    bool allFinite(const std::vector<float> &values)
+    {
+        return std::all_of(values.begin(), values.end(), [](float value)
+                           { return dsp::utils::isFinite(value); });
+    }
+}
+
+std::string dsp::core::waveletName(size_t order)
+{
+    return order == 1 ? "haar" : "db" + std::to_string(order);
+}
+
+bool dsp::core::parseWavelet(const std::string &name, size_t &order) noexcept
+{
+    for (size_t n = 1; n <= kMaxWaveletOrder; ++n)
+    {
+        if (name == "db" + std::to_string(n) || (n == 1 && name == "haar"))
+        {
+            order = n;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char *dsp::core::waveletModeName(WaveletMode mode) noexcept
+{
+    for (const auto &entry : kModeNames)
+    {
+        if (entry.mode == mode)
+        {
+            return entry.name;
+        }
+    }
+    return "";
+}
+
+bool dsp::core::parseWaveletMode(const std::string &name, WaveletMode &mode) noexcept
+{
+    for (const auto &entry : kModeNames)
+    {
+        if (name == entry.name)
+        {
+            mode = entry.mode;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char *dsp::core::waveletThresholdName(WaveletThreshold threshold) noexcept
+{
+    for (const auto &entry : kThresholdNames)
+    {
+        if (entry.threshold == threshold)
+        {
+            return entry.name;
+        }
+    }
+    return "";
+}
+
+bool dsp::core::parseWaveletThreshold(const std::string &name, WaveletThreshold &threshold) noexcept
+{
+    for (const auto &entry : kThresholdNames)
+    {
+        if (name == entry.name)
+        {
+            threshold = entry.threshold;
+            return true;
+        }
+    }
+    return false;
+}
+
+// -----------------------------------------------------------------------------
+// Constructor
+// -----------------------------------------------------------------------------
+WaveletTransform::WaveletTransform(size_t channels, const WaveletOptions &options)
+    : m_channels(channels), m_options(options), m_blockSize(0)
+{
+    if (channels == 0)
+    {
+        throw std::invalid_argument("WaveletTransform: channel count must be greater than 0");
+    }
+    if (options.order < 1 || options.order > kMaxWaveletOrder)
+    {
+        throw std::invalid_argument("WaveletTransform: wavelet order must be 1 (haar) to " +
+                                    std::to_string(kMaxWaveletOrder) + ", got " + std::to_string(options.order));
+    }
+    if (options.levels < 1 || options.levels > kMaxWaveletLevels)
+    {
+        throw std::invalid_argument("WaveletTransform: levels must be 1 to " + std::to_string(kMaxWaveletLevels) +
+                                    ", got " + std::to_string(options.levels));
+    }
+    if (!options.thresholds.empty() && options.thresholds.size() != options.levels)
+    {
+        throw std::invalid_argument("WaveletTransform: expected one threshold per level (" +
+                                    std::to_string(options.levels) + "), got " +
+                                    std::to_string(options.thresholds.size()));
+    }
+    for (float threshold : options.thresholds)
+    {
+        if (!(threshold >= 0.0f) || !dsp::utils::isFinite(threshold))
+        {
+            throw std::invalid_argument("WaveletTransform: thresholds must be non-negative");
+        }
+    }
+
+    m_blockSize = size_t(1) << options.levels;
+    factorize();
+
+    // Level j's lookahead of `after` pairs is 2^j input frames each
+    const size_t analysisDelay = m_analysis.after * (2 * m_blockSize - 2);
+    const size_t synthesisDelay = m_synthesis.after * (2 * m_blockSize - 2);
+    m_latency = options.mode == WaveletMode::Denoise ? m_blockSize - 1 + analysisDelay + synthesisDelay
+                                                     : analysisDelay;
+    reset();
+}
+
+// -----------------------------------------------------------------------------
+// Lifting factorization
+// -----------------------------------------------------------------------------
+void WaveletTransform::factorize()
+{
+    const size_t N = m_options.order;
+    const double *h = kScalingFilters + N * (N - 1);
+
+    // Analysis polyphase matrix E(z) = sum_i E_i z^-i: row a = (h[2i + 1], h[2i]),
+    // row d = (g[2i + 1], g[2i]) over the (even, odd) samples
+    auto g = [h, N](size_t m)
+    { return (m % 2 == 0 ? 1.0 : -1.0) * h[2 * N - 1 - m]; };
+    std::vector<std::array<double, 4>> E(N);
+    for (size_t i = 0; i < N; ++i)
+    {
+        E[i] = {h[2 * i + 1], h[2 * i], g(2 * i + 1), g(2 * i)};
+    }
+
+    // Peel E(z) = R(theta) diag(1, z^-1) E'(z), R = [c s; -s c], down to a
+    // constant rotation: R's transpose must clear row a of the last E_i and
+    // row d of E_0. rotation[r] is the r-th rotation applied to the samples.
+    std::vector<double> rotation(N);
+    for (size_t n = N - 1; n > 0; --n)
+    {
+        const auto &last = E[n];
+        const size_t column = std::abs(last[0]) + std::abs(last[2]) >= std::abs(last[1]) + std::abs(last[3]) ? 0 : 1;
+        const double theta = std::atan2(last[column], last[2 + column]);
+        const double c = std::cos(theta), s = std::sin(theta);
+
+        std::vector<std::array<double, 4>> peeled(n);
+        double residual = 0.0;
+        for (size_t i = 0; i <= n; ++i)
+        {
+            const std::array<double, 4> &e = E[i];
+            const double a0 = c * e[0] - s * e[2], a1 = c * e[1] - s * e[3];
+            const double d0 = s * e[0] + c * e[2], d1 = s * e[1] + c * e[3];
+            if (i < n)
+            {
+                peeled[i][0] = a0;
+                peeled[i][1] = a1;
+            }
+            else
+            {
+                residual = std::max({residual, std::abs(a0), std::abs(a1)});
+            }
+            if (i > 0)
+            {
+                peeled[i - 1][2] = d0;
+                peeled[i - 1][3] = d1;
+            }
+            else
+            {
+                residual = std::max({residual, std::abs(d0), std::abs(d1)});
+            }
+        }
+        if (residual > kLatticeTolerance)
+        {
+            throw std::logic_error("WaveletTransform: " + waveletName(N) + " has no lattice factorization");
+        }
+        E = std::move(peeled);
+        rotation[n] = theta;
+    }
+    const std::array<double, 4> &e = E[0];
+    rotation[0] = std::atan2(e[1], e[0]);
+    if (std::abs(e[0] - e[3]) > kLatticeTolerance || std::abs(e[1] + e[2]) > kLatticeTolerance)
+    {
+        throw std::logic_error("WaveletTransform: " + waveletName(N) + " has no lattice factorization");
+    }
+
+    // Each rotation is the lifting steps u += (s / c) v, v -= s c u, then the
+    // scaling (u, v) = (c u, v / c). The streams hold u / alpha and v / beta
+    // with the scalings so far folded into alpha and beta, and v is read
+    // `delays` samples late: diag(1, z^-1) between the rotations only moves
+    // where the next steps look.
+    m_analysis = Lifting();
+    double alpha = 1.0, beta = 1.0;
+    int delays = 0;
+    for (size_t r = 0; r < N; ++r)
+    {
+        delays = static_cast<int>(r);
+        const double c = std::cos(rotation[r]), s = std::sin(rotation[r]);
+        m_analysis.steps.push_back({0, -delays, static_cast<float>(s / c * beta / alpha), {}});
+        m_analysis.steps.push_back({1, delays, static_cast<float>(-s * c * alpha / beta), {}});
+        alpha *= c;
+        beta /= c;
+    }
+    m_analysis.outputShift[1] = -delays;
+    m_analysis.outputScale[0] = static_cast<float>(alpha);
+    m_analysis.outputScale[1] = static_cast<float>(beta);
+
+    // The same steps undone in reverse
+    m_synthesis = Lifting();
+    for (auto step = m_analysis.steps.rbegin(); step != m_analysis.steps.rend(); ++step)
+    {
+        m_synthesis.steps.push_back({step->target, step->offset, -step->coefficient, {}});
+    }
+    m_synthesis.inputShift[1] = delays;
+    m_synthesis.inputScale[0] = static_cast<float>(1.0 / alpha);
+    m_synthesis.inputScale[1] = static_cast<float>(1.0 / beta);
+
+    plan(m_analysis);
+    plan(m_synthesis);
+}
+
+// Works back from the outputs to the positions each step must cover, and
+// from there to how many inputs an output depends on
+void WaveletTransform::plan(Lifting &lifting)
+{
+    Region need[2];
+    for (int i = 0; i < 2; ++i)
+    {
+        need[i] = {lifting.outputShift[i], lifting.outputShift[i]};
+    }
+    for (auto step = lifting.steps.rbegin(); step != lifting.steps.rend(); ++step)
+    {
+        const Region &target = need[step->target];
+        Region &source = need[1 - step->target];
+        step->region = target;
+        source.lo = std::min(source.lo, target.lo + step->offset);
+        source.hi = std::max(source.hi, target.hi + step->offset);
+    }
+
+    int before = 0, after = 0;
+    for (int i = 0; i < 2; ++i)
+    {
+        lifting.fill[i] = need[i];
+        before = std::max(before, -(need[i].lo + lifting.inputShift[i]));
+        after = std::max(after, need[i].hi + lifting.inputShift[i]);
+    }
+    lifting.before = static_cast<size_t>(before);
+    lifting.after = static_cast<size_t>(after);
+}
+
+// -----------------------------------------------------------------------------
+// Method: lift
+// Runs one direction of the transform over count input pairs, which must be
+// more than lifting.before + lifting.after
+// @ param in0, in1 - Input rows i at in0 + i * inStride (and in1)
+// @ param out0, out1 - Output rows, out0 + k * outStride (and out1)
+// @ return Outputs written: count - before - after
+// -----------------------------------------------------------------------------
+size_t WaveletTransform::lift(const Lifting &lifting, const float *in0, const float *in1, size_t inStride,
+                              size_t count, float *out0, float *out1, size_t outStride)
+{
+    const size_t C = m_channels;
+    const int begin = static_cast<int>(lifting.before);
+    const int end = static_cast<int>(count - lifting.after);
+    const float *input[2] = {in0, in1};
+    float *output[2] = {out0, out1};
+
+    // stream[i] holds positions first[i] onwards
+    float *stream[2];
+    int first[2];
+    for (int i = 0; i < 2; ++i)
+    {
+        first[i] = begin + lifting.fill[i].lo;
+        const int last = end + lifting.fill[i].hi;
+        const size_t size = static_cast<size_t>(last - first[i]) * C;
+        if (m_streams[i].size() < size)
+        {
+            m_streams[i].resize(size);
+        }
+        stream[i] = m_streams[i].data();
+
+        scaleRows(input[i] + static_cast<size_t>(first[i] + lifting.inputShift[i]) * inStride, inStride,
+                  stream[i], C, static_cast<size_t>(last - first[i]), C, lifting.inputScale[i]);
+    }
+
+    for (const LiftingStep &step : lifting.steps)
+    {
+        const int t = step.target;
+        const int lo = begin + step.region.lo;
+        const int hi = end + step.region.hi;
+        dsp::simd::scaled_add(stream[t] + static_cast<size_t>(lo - first[t]) * C,
+                              stream[1 - t] + static_cast<size_t>(lo + step.offset - first[1 - t]) * C,
+                              step.coefficient, static_cast<size_t>(hi - lo) * C);
+    }
+
+    for (int i = 0; i < 2; ++i)
+    {
+        scaleRows(stream[i] + static_cast<size_t>(begin + lifting.outputShift[i] - first[i]) * C, C, output[i],
+                  outStride, static_cast<size_t>(end - begin), C, lifting.outputScale[i]);
+    }
+    return static_cast<size_t>(end - begin);
+}
+
+// -----------------------------------------------------------------------------
+// Method: analyze
+// Transforms the complete pairs in a level's input into the next level's
+// input (or the deepest approximation) and the level's details
+// @ return Pairs transformed
+// -----------------------------------------------------------------------------
+size_t WaveletTransform::analyze(size_t level)
+{
+    const size_t C = m_channels;
+    WaveletLevelState &state = m_state[level];
+    const size_t pairs = state.input.size() / (2 * C);
+    const size_t history = m_analysis.before + m_analysis.after;
+    if (pairs <= history)
+    {
+        return 0;
+    }
+
+    const size_t n = pairs - history;
+    std::vector<float> &approximation =
+        level + 1 == m_options.levels ? state.approximation : m_state[level + 1].input;
+    float *a = grow(approximation, n * C);
+    float *d = grow(state.details, n * C);
+    lift(m_analysis, state.input.data(), state.input.data() + C, 2 * C, pairs, a, d, C);
+    if (m_options.mode == WaveletMode::Denoise && !m_options.thresholds.empty())
+    {
+        shrink(d, n * C, m_options.thresholds[level], m_options.thresholdMode);
+    }
+    dropFront(state.input, 2 * n * C);
+    return n;
+}
+
+// -----------------------------------------------------------------------------
+// Method: synthesize
+// Reconstructs the level's input from the pairs of approximation and
+// details both available, into the finer level's approximation (or output)
+// @ return Pairs reconstructed
+// -----------------------------------------------------------------------------
+size_t WaveletTransform::synthesize(size_t level)
+{
+    const size_t C = m_channels;
+    WaveletLevelState &state = m_state[level];
+    const size_t count = std::min(state.approximation.size(), state.details.size()) / C;
+    const size_t history = m_synthesis.before + m_synthesis.after;
+    if (count <= history)
+    {
+        return 0;
+    }
+
+    const size_t n = count - history;
+    float *x = grow(level == 0 ? m_output : m_state[level - 1].approximation, 2 * n * C);
+    lift(m_synthesis, state.approximation.data(), state.details.data(), C, count, x, x + C, 2 * C);
+    dropFront(state.approximation, n * C);
+    dropFront(state.details, n * C);
+    return n;
+}
+
+// -----------------------------------------------------------------------------
+// Method: decompose
+// -----------------------------------------------------------------------------
+size_t WaveletTransform::maxOutputFrames(size_t numFrames) const noexcept
+{
+    // At most one frame per block whatever the phase
+    return numFrames == 0 ? 0 : 1 + (numFrames - 1) / m_blockSize;
+}
+
+size_t WaveletTransform::decompose(const float *input, size_t numFrames, const float *timestamps, float *output,
+                                   float *outputTimestamps)
+{
+    if (m_options.mode != WaveletMode::Decompose)
+    {
+        throw std::logic_error("WaveletTransform: decompose() needs the decompose mode");
+    }
+    const size_t C = m_channels;
+    const size_t J = m_options.levels;
+    std::copy(input, input + numFrames * C, grow(m_state[0].input, numFrames * C));
+    for (size_t level = 0; level < J && analyze(level) > 0; ++level)
+    {
+    }
+
+    // Gather each block into Mallat order, [frame][channel][coefficient]
+    const size_t frames = m_state[J - 1].approximation.size() / C;
+    const size_t B = m_blockSize;
+    for (size_t f = 0; f < frames; ++f)
+    {
+        for (size_t c = 0; c < C; ++c)
+        {
+            float *row = output + (f * C + c) * B;
+            row[0] = m_state[J - 1].approximation[f * C + c];
+            for (size_t level = 0; level < J; ++level)
+            {
+                // Level j + 1 contributes 2^(J - j - 1) details, stored from that offset
+                const size_t count = B >> (level + 1);
+                const float *details = m_state[level].details.data() + f * count * C + c;
+                for (size_t i = 0; i < count; ++i)
+                {
+                    row[count + i] = details[i * C];
+                }
+            }
+        }
+    }
+    dropFront(m_state[J - 1].approximation, frames * C);
+    for (size_t level = 0; level < J; ++level)
+    {
+        dropFront(m_state[level].details, frames * (B >> (level + 1)) * C);
+    }
+
+    // A frame is complete at the last input frame of its block (plus any lookahead)
+    size_t f = m_framesUntilOutput - 1;
+    for (size_t written = 0; f < numFrames; f += B, ++written)
+    {
+        if (timestamps != nullptr && outputTimestamps != nullptr && written < frames)
+        {
+            std::fill(outputTimestamps + written * C * B, outputTimestamps + (written + 1) * C * B,
+                      timestamps[(f + 1) * C - 1]);
+        }
+    }
+    m_framesUntilOutput = f + 1 - numFrames;
+    return frames;
+}
+
+// -----------------------------------------------------------------------------
+// Method: denoise
+// -----------------------------------------------------------------------------
+void WaveletTransform::denoise(float *frames, size_t numFrames)
+{
+    if (m_options.mode != WaveletMode::Denoise)
+    {
+        throw std::logic_error("WaveletTransform: denoise() needs the denoise mode");
+    }
+    const size_t C = m_channels;
+    const size_t J = m_options.levels;
+    std::copy(frames, frames + numFrames * C, grow(m_state[0].input, numFrames * C));
+    for (size_t level = 0; level < J && analyze(level) > 0; ++level)
+    {
+    }
+    for (size_t level = J; level-- > 0;)
+    {
+        synthesize(level);
+    }
+
+    // The latency covers the worst case, so this only fails on a bad setState()
+    if (m_output.size() < numFrames * C)
+    {
+        throw std::runtime_error("WaveletTransform: restored state does not hold enough output");
+    }
+    std::copy(m_output.begin(), m_output.begin() + static_cast<std::ptrdiff_t>(numFrames * C), frames);
+    dropFront(m_output, numFrames * C);
+}
+
+// -----------------------------------------------------------------------------
+// Buffers
+// -----------------------------------------------------------------------------
+void WaveletTransform::reserve(size_t maxFrames)
+{
+    const size_t C = m_channels;
+    const size_t analysisHistory = 2 * (m_analysis.before + m_analysis.after) + 1;
+    const size_t synthesisHistory = m_synthesis.before + m_synthesis.after;
+    size_t largest = 0;
+    for (size_t level = 0; level < m_options.levels; ++level)
+    {
+        // A level sees at most half the frames of the one above it, plus a carried sample
+        const size_t frames = (maxFrames >> level) + 2;
+        const size_t held = (m_latency >> level) + (m_blockSize >> level) + 2;
+        WaveletLevelState &state = m_state[level];
+        state.input.reserve((analysisHistory + frames) * C);
+        state.details.reserve((synthesisHistory + held + frames) * C);
+        state.approximation.reserve((synthesisHistory + held + frames) * C);
+        largest = std::max(largest, std::max(analysisHistory + frames, synthesisHistory + held + frames));
+    }
+    m_output.reserve((m_latency + maxFrames + 1) * C);
+
+    for (int i = 0; i < 2; ++i)
+    {
+        int margin = 0;
+        for (const Lifting *lifting : {&m_analysis, &m_synthesis})
+        {
+            margin = std::max(margin, lifting->fill[i].hi - lifting->fill[i].lo);
+        }
+        const size_t size = (largest + static_cast<size_t>(margin)) * C;
+        if (m_streams[i].size() < size)
+        {
+            m_streams[i].resize(size);
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// State
+// -----------------------------------------------------------------------------
+WaveletState WaveletTransform::getState() const
+{
+    WaveletState state;
+    state.levels = m_state;
+    state.output = m_output;
+    state.framesUntilOutput = m_framesUntilOutput;
+    return state;
+}
+
+void WaveletTransform::setState(const WaveletState &state)
+{
+    const size_t C = m_channels;
+    const size_t J = m_options.levels;
+    const bool denoise = m_options.mode == WaveletMode::Denoise;
+    if (state.levels.size() != J)
+    {
+        throw std::runtime_error("WaveletTransform: expected " + std::to_string(J) + " levels, got " +
+                                 std::to_string(state.levels.size()));
+    }
+    if (state.framesUntilOutput < 1 || state.framesUntilOutput > m_blockSize + m_latency)
+    {
+        throw std::runtime_error("WaveletTransform: framesUntilOutput out of range");
+    }
+
+    auto rows = [C](const std::vector<float> &buffer)
+    {
+        if (buffer.size() % C != 0 || !allFinite(buffer))
+        {
+            throw std::runtime_error("WaveletTransform: state buffers must hold whole frames of finite values");
+        }
+        return buffer.size() / C;
+    };
+    const size_t frames = rows(state.levels[J - 1].approximation);
+    for (size_t level = 0; level < J; ++level)
+    {
+        const WaveletLevelState &saved = state.levels[level];
+        const size_t details = rows(saved.details);
+        const size_t approximation = rows(saved.approximation);
+        bool valid = rows(saved.input) >= 2 * m_analysis.before;
+        if (denoise)
+        {
+            valid = valid && details >= m_synthesis.before && approximation >= m_synthesis.before;
+        }
+        else
+        {
+            // Every pending frame needs its details
+            valid = valid && details >= frames * (m_blockSize >> (level + 1)) &&
+                    (level + 1 == J || approximation == 0);
+        }
+        if (!valid)
+        {
+            throw std::runtime_error("WaveletTransform: inconsistent state for level " + std::to_string(level + 1));
+        }
+    }
+    rows(state.output);
+
+    m_state = state.levels;
+    m_output = state.output;
+    m_framesUntilOutput = state.framesUntilOutput;
+}
+
+void WaveletTransform::reset()
+{
+    const size_t C = m_channels;
+    const bool denoise = m_options.mode == WaveletMode::Denoise;
+    m_state.resize(m_options.levels);
+    for (WaveletLevelState &state : m_state)
+    {
+        // The history a stream of zeros would have left
+        state.input.assign(2 * m_analysis.before * C, 0.0f);
+        state.details.assign(denoise ? m_synthesis.before * C : 0, 0.0f);
+        state.approximation.assign(denoise ? m_synthesis.before * C : 0, 0.0f);
+    }
+    m_output.assign(denoise ? m_latency * C : 0, 0.0f);
+    m_framesUntilOutput = m_blockSize + (denoise ? 0 : m_latency);
+}
@@ -0,0 +1,253 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace dsp::core
+{
+    constexpr size_t kMaxWaveletOrder = 10;  // db10
+    constexpr size_t kMaxWaveletLevels = 16; // 65536 coefficients per channel in a decompose frame
+
+    /**
+     * @brief What WaveletTransform does with the coefficients.
+     */
+    enum class WaveletMode
+    {
+        Decompose, // Emit every level's coefficients, one frame per 2^levels input frames
+        Denoise    // Threshold the detail coefficients and reconstruct the signal
+    };
+
+    /**
+     * @brief How Denoise shrinks a detail coefficient d against its level's threshold t.
+     */
+    enum class WaveletThreshold
+    {
+        Soft, // sign(d) * max(|d| - t, 0)
+        Hard  // d if |d| > t, else 0
+    };
+
+    /**
+     * @brief Wavelet name as used in stage parameters: "haar" for order 1, else "db<order>".
+     */
+    std::string waveletName(size_t order);
+
+    /**
+     * @brief Parses "haar" or "db1" ... "db10" into a Daubechies order.
+     * @return false if the name is unknown
+     */
+    bool parseWavelet(const std::string &name, size_t &order) noexcept;
+
+    /**
+     * @brief Mode name as used in stage parameters ("decompose", "denoise").
+     */
+    const char *waveletModeName(WaveletMode mode) noexcept;
+
+    /**
+     * @brief Parses a name returned by waveletModeName().
+     * @return false if the name is unknown
+     */
+    bool parseWaveletMode(const std::string &name, WaveletMode &mode) noexcept;
+
+    /**
+     * @brief Threshold name as used in stage parameters ("soft", "hard").
+     */
+    const char *waveletThresholdName(WaveletThreshold threshold) noexcept;
+
+    /**
+     * @brief Parses a name returned by waveletThresholdName().
+     * @return false if the name is unknown
+     */
+    bool parseWaveletThreshold(const std::string &name, WaveletThreshold &threshold) noexcept;
+
+    struct WaveletOptions
+    {
+        size_t order = 4;  // Daubechies order N (2N taps, N vanishing moments); 1 is haar
+        size_t levels = 3; // Decomposition depth J
+        WaveletMode mode = WaveletMode::Decompose;
+        WaveletThreshold thresholdMode = WaveletThreshold::Soft;
+        std::vector<float> thresholds; // Denoise: one per level, finest first (empty = all 0)
+    };
+
+    /**
+     * @brief Samples a WaveletTransform holds between chunks, as restored by
+     * setState(). Every buffer is rows of getChannels() samples.
+     *
+     * Per level (finest first): input = the tail of the level's input
+     * stream still needed by the lifting steps; details = detail
+     * coefficients not yet emitted (Decompose) or not yet reconstructed
+     * (Denoise, thresholded, with the synthesis history in front);
+     * approximation = the deepest approximation not yet emitted
+     * (Decompose, last level only) or the reconstructed approximation
+     * waiting for its details (Denoise). output = reconstructed frames not
+     * yet returned (Denoise).
+     */
+    struct WaveletLevelState
+    {
+        std::vector<float> input;
+        std::vector<float> details;
+        std::vector<float> approximation;
+    };
+
+    struct WaveletState
+    {
+        std::vector<WaveletLevelState> levels;
+        std::vector<float> output;
+        size_t framesUntilOutput = 0;
+    };
+
+    /**
+     * @brief Streaming multi-level discrete wavelet transform (Daubechies
+     * db1 (haar) to db10) of every channel, computed with the lifting scheme.
+     *
+     * Each level splits its input into even / odd samples and runs a
+     * short sequence of lifting steps, stream[t][k] += c * stream[1 - t][k + o],
+     * followed by one scaling of each stream. The steps come from the
+     * wavelet's paraunitary lattice: each of its N rotations becomes two
+     * lifting steps, and the scalings of all rotations collect into the
+     * final one. That is 2N + 2 multiplies per pair of samples where the
+     * filter-bank form needs 4N, and every rotation of db1 - db10 has
+     * |cos| >= 0.4, so the factorization is well conditioned. Each lifting
+     * step is one axpy over the whole chunk (simd::scaled_add): channels are
+     * laid out as in the interleaved stream, so the steps run over
+     * frames * channels contiguous samples at once.
+     *
+     * The transform is causal and the stream is taken as zero before its
+     * first sample. At every level
+     *
+     *   a[k] = sum_m h[m] x[2k + 1 - m],   d[k] = sum_m g[m] x[2k + 1 - m],
+     *
+     * with h the Daubechies scaling filter (2N taps, sum sqrt(2)) and
+     * g[m] = (-1)^m h[2N - 1 - m]; the next level transforms a. Each level
+     * keeps just enough of its input between chunks to continue, so any
+     * chunking gives the same coefficients.
+     *
+     * Decompose emits one frame per 2^levels input frames, holding per
+     * channel the 2^levels coefficients of that block in Mallat order:
+     * a_J, d_J, d_J-1 (2 values), ..., d_1 (2^(J-1) values). A frame is
+     * emitted as soon as its last input frame arrives.
+     *
+     * Denoise thresholds the detail coefficients of every level and runs
+     * the inverse lifting steps back up. The output lags the input by
+     * getLatency() frames (the first ones are 0); with all thresholds 0 it
+     * is the input, delayed.
+     */
+    class WaveletTransform
+    {
+    public:
+        /**
+         * @param channels Channels transformed independently.
+         * @param options Wavelet, depth and mode.
+         * @throws std::invalid_argument on an invalid order, depth or threshold
+         */
+        WaveletTransform(size_t channels, const WaveletOptions &options);
+
+        size_t getChannels() const noexcept { return m_channels; }
+        const WaveletOptions &getOptions() const noexcept { return m_options; }
+
+        /**
+         * @brief Input frames per decompose frame, and coefficients per channel in one: 2^levels.
+         */
+        size_t getBlockSize() const noexcept { return m_blockSize; }
+
+        /**
+         * @brief Denoise: frames the output lags the input. Decompose: frames
+         * between the last input frame of a block and its output frame (0 for
+         * every supported wavelet, whose analysis is causal).
+         */
+        size_t getLatency() const noexcept { return m_latency; }
+
+        /**
+         * @brief Upper bound on decompose()'s frames for numFrames input frames.
+         */
+        size_t maxOutputFrames(size_t numFrames) const noexcept;
+
+        /**
+         * @brief Transforms numFrames interleaved frames (Decompose).
+         * @param input numFrames * getChannels() samples.
+         * @param timestamps Per-sample timestamps, or nullptr.
+         * @param output Room for maxOutputFrames(numFrames) frames of
+         *        getChannels() * getBlockSize() coefficients, [frame][channel][coefficient].
+         * @param outputTimestamps Same size as output: each frame gets the
+         *        timestamp of the input frame that completed it.
+         * @return Frames written.
+         */
+        size_t decompose(const float *input, size_t numFrames, const float *timestamps, float *output,
+                         float *outputTimestamps);
+
+        /**
+         * @brief Denoises numFrames interleaved frames in place (Denoise).
+         */
+        void denoise(float *frames, size_t numFrames);
+
+        /**
+         * @brief Sizes every buffer for chunks of up to maxFrames frames, so
+         * that processing them does not allocate.
+         */
+        void reserve(size_t maxFrames);
+
+        WaveletState getState() const;
+
+        /**
+         * @brief Restores a getState() result.
+         */
+        void setState(const WaveletState &state);
+
+        /**
+         * @brief Back to a stream of zeros.
+         */
+        void reset();
+
+    private:
+        // Positions [before + lo, count - after + hi) of a stream, for a lift() over count inputs
+        struct Region
+        {
+            int lo = 0;
+            int hi = 0;
+        };
+
+        // stream[target][p] += coefficient * stream[1 - target][p + offset], over region
+        struct LiftingStep
+        {
+            int target;
+            int offset;
+            float coefficient;
+            Region region;
+        };
+
+        // One direction of the transform. Stream i starts as input i at
+        // index p + inputShift[i] (times inputScale[i]); output i at index k
+        // is stream i at k + outputShift[i] (times outputScale[i]).
+        struct Lifting
+        {
+            std::vector<LiftingStep> steps;
+            int inputShift[2] = {0, 0};
+            int outputShift[2] = {0, 0};
+            float inputScale[2] = {1.0f, 1.0f};
+            float outputScale[2] = {1.0f, 1.0f};
+            Region fill[2];
+            size_t before = 0; // Inputs before an output's index it depends on
+            size_t after = 0;  // Inputs after it
+        };
+
+        void factorize();
+        static void plan(Lifting &lifting);
+        size_t analyze(size_t level);
+        size_t synthesize(size_t level);
+        size_t lift(const Lifting &lifting, const float *in0, const float *in1, size_t inStride, size_t count,
+                    float *out0, float *out1, size_t outStride);
+
+        size_t m_channels;
+        WaveletOptions m_options;
+        size_t m_blockSize;
+        size_t m_latency = 0;
+
+        Lifting m_analysis;
+        Lifting m_synthesis;
+
+        std::vector<WaveletLevelState> m_state;
+        std::vector<float> m_output;
+        size_t m_framesUntilOutput = 0;
+        std::vector<float> m_streams[2]; // lift() scratch
+    };
+
+} // namespace dsp::core
@@ -0,0 +1,121 @@
+#include "AllocationTracker.h"
+
+#if defined(DSPX_TRACK_ALLOCATIONS) && !defined(_WIN32)
+#include <cstdlib>
+#include <new>
+#define DSPX_ALLOCATION_HOOKS 1
+#endif
+
+using namespace dsp::utils;
+
+namespace
+{
+    thread_local AllocationScope *t_innermost = nullptr;
+}
+
+// -----------------------------------------------------------------------------
+// AllocationScope
+// -----------------------------------------------------------------------------
+AllocationScope::AllocationScope() noexcept : m_previous(t_innermost)
+{
+    t_innermost = this;
+}
+
+AllocationScope::~AllocationScope()
+{
+    t_innermost = m_previous;
+}
+
+bool AllocationScope::enabled() noexcept
+{
+#ifdef DSPX_ALLOCATION_HOOKS
+    return true;
+#else
+    return false;
+#endif
+}
+
+void AllocationScope::note(size_t bytes) noexcept
+{
+    for (AllocationScope *scope = t_innermost; scope != nullptr; scope = scope->m_previous)
+    {
+        ++scope->m_count;
+        scope->m_bytes += bytes;
+    }
+}
+
+#ifdef DSPX_ALLOCATION_HOOKS
+// -----------------------------------------------------------------------------
+// Global operator new / delete replacements
+// malloc-based like the default ones (so memory from either side can be freed
+// by the other), with every allocation reported to the live scopes first
+// -----------------------------------------------------------------------------
+namespace
+{
+    void *trackedMalloc(size_t size, size_t alignment) noexcept
+    {
+        AllocationScope::note(size);
+        if (size == 0)
+        {
+            size = 1;
+        }
+        if (alignment <= alignof(std::max_align_t))
+        {
+            return std::malloc(size);
+        }
+        void *data = nullptr;
+        return posix_memalign(&data, alignment, size) == 0 ? data : nullptr;
+    }
+
+    void *trackedNew(size_t size, size_t alignment)
+    {
+        for (;;)
+        {
+            if (void *data = trackedMalloc(size, alignment))
+            {
+                return data;
+            }
+            std::new_handler handler = std::get_new_handler();
+            if (handler == nullptr)
+            {
+                throw std::bad_alloc();
+            }
+            handler();
+        }
+    }
+
+    void *trackedNewNothrow(size_t size, size_t alignment) noexcept
+    {
+        try
+        {
+            return trackedNew(size, alignment);
+        }
+        catch (...)
+        {
+            return nullptr;
+        }
+    }
+}
+
+void *operator new(size_t size) { return trackedNew(size, 0); }
+void *operator new[](size_t size) { return trackedNew(size, 0); }
+void *operator new(size_t size, const std::nothrow_t &) noexcept { return trackedNewNothrow(size, 0); }
+void *operator new[](size_t size, const std::nothrow_t &) noexcept { return trackedNewNothrow(size, 0); }
+void *operator new(size_t size, std::align_val_t alignment) { return trackedNew(size, static_cast<size_t>(alignment)); }
+void *operator new[](size_t size, std::align_val_t alignment) { return trackedNew(size, static_cast<size_t>(alignment)); }
+void *operator new(size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept { return trackedNewNothrow(size, static_cast<size_t>(alignment)); }
+void *operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept { return trackedNewNothrow(size, static_cast<size_t>(alignment)); }
+
+void operator delete(void *data) noexcept { std::free(data); }
+void operator delete[](void *data) noexcept { std::free(data); }
+void operator delete(void *data, size_t) noexcept { std::free(data); }
+void operator delete[](void *data, size_t) noexcept { std::free(data); }
+void operator delete(void *data, const std::nothrow_t &) noexcept { std::free(data); }
+void operator delete[](void *data, const std::nothrow_t &) noexcept { std::free(data); }
+void operator delete(void *data, std::align_val_t) noexcept { std::free(data); }
+void operator delete[](void *data, std::align_val_t) noexcept { std::free(data); }
+void operator delete(void *data, size_t, std::align_val_t) noexcept { std::free(data); }
+void operator delete[](void *data, size_t, std::align_val_t) noexcept { std::free(data); }
+void operator delete(void *data, std::align_val_t, const std::nothrow_t &) noexcept { std::free(data); }
+void operator delete[](void *data, std::align_val_t, const std::nothrow_t &) noexcept { std::free(data); }
+#endif
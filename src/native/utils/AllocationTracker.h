@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+
+namespace dsp::utils
+{
+    /**
+     * @brief Counts the heap allocations made on this thread while it is
+     * alive (RAII, nestable: every live scope on the thread counts).
+     *
+     * Debug hook for real-time mode: DspPipeline opens one around the stage
+     * loop of every process() call, so a prepared pipeline can prove that
+     * processing never touched the allocator.
+     *
+     * The counting is done by replacements of the global operator new that
+     * are only compiled into builds with DSPX_TRACK_ALLOCATIONS
+     * (node-gyp rebuild --dspx_track_allocations=true), since replacing the
+     * allocator affects the whole addon. In other builds enabled() is
+     * false and scopes always report zero.
+     */
+    class AllocationScope
+    {
+    public:
+        AllocationScope() noexcept;
+        ~AllocationScope();
+
+        AllocationScope(const AllocationScope &) = delete;
+        AllocationScope &operator=(const AllocationScope &) = delete;
+
+        /**
+         * @brief Allocations made on this thread since the scope opened.
+         */
+        size_t count() const noexcept { return m_count; }
+
+        /**
+         * @brief Bytes requested by those allocations.
+         */
+        size_t bytes() const noexcept { return m_bytes; }
+
+        /**
+         * @brief Whether this build counts allocations at all.
+         */
+        static bool enabled() noexcept;
+
+        /**
+         * @brief Records an allocation in every live scope on this thread
+         * (called by the operator new replacements).
+         */
+        static void note(size_t bytes) noexcept;
+
+    private:
+        AllocationScope *m_previous;
+        size_t m_count = 0;
+        size_t m_bytes = 0;
+    };
+
+} // namespace dsp::utils
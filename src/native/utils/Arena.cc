@@ -0,0 +1,119 @@
+#include "Arena.h"
+#include <algorithm>
+#include <new>
+
+using namespace dsp::utils;
+
+namespace
+{
+    thread_local Arena *t_current = nullptr;
+
+    size_t roundUp(size_t bytes)
+    {
+        return (bytes + Arena::kAlignment - 1) & ~(Arena::kAlignment - 1);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Arena
+// -----------------------------------------------------------------------------
+Arena::Arena(size_t blockSize)
+    : m_block_size(roundUp(std::max(blockSize, kAlignment)))
+{
+}
+
+void Arena::AlignedDelete::operator()(std::byte *block) const
+{
+    ::operator delete[](block, std::align_val_t(kAlignment));
+}
+
+void *Arena::allocate(size_t bytes)
+{
+    const size_t size = roundUp(std::max(bytes, static_cast<size_t>(1)));
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_blocks.empty() || m_blocks.back().size - m_blocks.back().used < size)
+    {
+        // Oversized requests get a block of their own
+        Block block;
+        block.size = std::max(m_block_size, size);
+        block.data.reset(static_cast<std::byte *>(::operator new[](block.size, std::align_val_t(kAlignment))));
+        m_blocks.push_back(std::move(block));
+    }
+
+    Block &block = m_blocks.back();
+    void *data = block.data.get() + block.used;
+    block.used += size;
+    return data;
+}
+
+size_t Arena::used() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t total = 0;
+    for (const auto &block : m_blocks)
+    {
+        total += block.used;
+    }
+    return total;
+}
+
+size_t Arena::capacity() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    size_t total = 0;
+    for (const auto &block : m_blocks)
+    {
+        total += block.size;
+    }
+    return total;
+}
+
+size_t Arena::blockCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_blocks.size();
+}
+
+// -----------------------------------------------------------------------------
+// ArenaScope
+// -----------------------------------------------------------------------------
+ArenaScope::ArenaScope(Arena *arena) : m_previous(t_current)
+{
+    t_current = arena;
+}
+
+ArenaScope::~ArenaScope()
+{
+    t_current = m_previous;
+}
+
+Arena *ArenaScope::current() noexcept
+{
+    return t_current;
+}
+
+// -----------------------------------------------------------------------------
+// Aligned allocation with heap fallback
+// -----------------------------------------------------------------------------
+namespace dsp::utils
+{
+    void *allocateAligned(size_t bytes, bool &fromArena)
+    {
+        if (Arena *arena = ArenaScope::current())
+        {
+            fromArena = true;
+            return arena->allocate(bytes);
+        }
+        fromArena = false;
+        return ::operator new[](roundUp(std::max(bytes, static_cast<size_t>(1))), std::align_val_t(Arena::kAlignment));
+    }
+
+    void freeAligned(void *data, bool fromArena) noexcept
+    {
+        if (data != nullptr && !fromArena)
+        {
+            ::operator delete[](data, std::align_val_t(Arena::kAlignment));
+        }
+    }
+}
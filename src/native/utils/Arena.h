@@ -0,0 +1,189 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dsp::utils
+{
+    /**
+     * @brief Bump allocator for the buffers of one pipeline's stages.
+     *
+     * Every allocation is 64-byte aligned (one cache line, one AVX-512
+     * vector) and carved from a few large blocks, so the windows of
+     * consecutive stages sit next to each other in memory. There is no
+     * per-allocation free: memory goes back all at once when the arena is
+     * destroyed, after the stages that used it.
+     *
+     * Blocks are never moved or resized, so pointers stay valid; when the
+     * current block is full a new one of at least the block size is added.
+     * Thread-safe, since a stage may be built on the main thread while a
+     * worker sets up another one.
+     */
+    class Arena
+    {
+    public:
+        static constexpr size_t kAlignment = 64;
+        static constexpr size_t kDefaultBlockSize = 64 * 1024;
+
+        explicit Arena(size_t blockSize = kDefaultBlockSize);
+
+        Arena(const Arena &) = delete;
+        Arena &operator=(const Arena &) = delete;
+
+        /**
+         * @brief Returns kAlignment-aligned, uninitialized storage for bytes bytes.
+         */
+        void *allocate(size_t bytes);
+
+        /**
+         * @brief Bytes handed out so far (including alignment padding).
+         */
+        size_t used() const;
+
+        /**
+         * @brief Bytes reserved across all blocks.
+         */
+        size_t capacity() const;
+
+        size_t blockCount() const;
+
+    private:
+        struct AlignedDelete
+        {
+            void operator()(std::byte *block) const;
+        };
+
+        struct Block
+        {
+            std::unique_ptr<std::byte[], AlignedDelete> data;
+            size_t size = 0;
+            size_t used = 0;
+        };
+
+        size_t m_block_size;
+        std::vector<Block> m_blocks;
+        mutable std::mutex m_mutex;
+    };
+
+    /**
+     * @brief Routes AlignedArray allocations on this thread to an arena
+     * while it is alive (RAII, nestable).
+     *
+     * DspPipeline opens one around stage construction and around each
+     * stage's first process() call, which is where stages size their
+     * windows; everything allocated later (channel-count changes, restored
+     * state) goes to the heap, so repeated loads cannot grow the arena.
+     */
+    class ArenaScope
+    {
+    public:
+        explicit ArenaScope(Arena *arena);
+        ~ArenaScope();
+
+        ArenaScope(const ArenaScope &) = delete;
+        ArenaScope &operator=(const ArenaScope &) = delete;
+
+        /**
+         * @brief The arena of the innermost live scope on this thread, or nullptr.
+         */
+        static Arena *current() noexcept;
+
+    private:
+        Arena *m_previous;
+    };
+
+    /**
+     * @brief 64-byte aligned storage for bytes bytes from the current
+     * arena, or from the heap outside an ArenaScope.
+     * @param fromArena Set to whether the arena served the request.
+     */
+    void *allocateAligned(size_t bytes, bool &fromArena);
+
+    /**
+     * @brief Releases storage from allocateAligned() (no-op for arena storage).
+     */
+    void freeAligned(void *data, bool fromArena) noexcept;
+
+    /**
+     * @brief Fixed-size, 64-byte aligned, value-initialized array of a
+     * trivial type, taken from the current ArenaScope if there is one.
+     *
+     * Drop-in for std::unique_ptr<T[]> (get(), operator[]) in stage
+     * buffers. Move-only; arena storage is released with the arena.
+     */
+    template <typename T>
+    class AlignedArray
+    {
+        static_assert(std::is_trivially_destructible_v<T> && std::is_trivially_copyable_v<T>,
+                      "AlignedArray holds trivial types only (arena memory is never destroyed)");
+
+    public:
+        AlignedArray() noexcept = default;
+
+        explicit AlignedArray(size_t count) : m_size(count)
+        {
+            if (count > 0)
+            {
+                m_data = static_cast<T *>(allocateAligned(count * sizeof(T), m_from_arena));
+                for (size_t i = 0; i < count; ++i)
+                {
+                    new (m_data + i) T();
+                }
+            }
+        }
+
+        AlignedArray(const AlignedArray &) = delete;
+        AlignedArray &operator=(const AlignedArray &) = delete;
+
+        AlignedArray(AlignedArray &&other) noexcept
+            : m_data(std::exchange(other.m_data, nullptr)),
+              m_size(std::exchange(other.m_size, 0)),
+              m_from_arena(other.m_from_arena)
+        {
+        }
+
+        AlignedArray &operator=(AlignedArray &&other) noexcept
+        {
+            if (this != &other)
+            {
+                freeAligned(m_data, m_from_arena);
+                m_data = std::exchange(other.m_data, nullptr);
+                m_size = std::exchange(other.m_size, 0);
+                m_from_arena = other.m_from_arena;
+            }
+            return *this;
+        }
+
+        ~AlignedArray() { freeAligned(m_data, m_from_arena); }
+
+        T *get() noexcept { return m_data; }
+        const T *get() const noexcept { return m_data; }
+        T *data() noexcept { return m_data; }
+        const T *data() const noexcept { return m_data; }
+        size_t size() const noexcept { return m_size; }
+
+        T *begin() noexcept { return m_data; }
+        T *end() noexcept { return m_data + m_size; }
+        const T *begin() const noexcept { return m_data; }
+        const T *end() const noexcept { return m_data + m_size; }
+
+        T &operator[](size_t i) noexcept { return m_data[i]; }
+        const T &operator[](size_t i) const noexcept { return m_data[i]; }
+
+        explicit operator bool() const noexcept { return m_data != nullptr; }
+
+        bool isFromArena() const noexcept { return m_from_arena; }
+
+    private:
+        T *m_data = nullptr;
+        size_t m_size = 0;
+        bool m_from_arena = false;
+    };
+
+} // namespace dsp::utils
@@ -0,0 +1,191 @@
+#include "BinaryState.h"
+#include <array>
+#include <atomic>
+
+namespace dsp::utils
+{
+    namespace
+    {
+        std::array<uint32_t, 256> makeCrcTable()
+        {
+            std::array<uint32_t, 256> table{};
+            for (uint32_t i = 0; i < 256; ++i)
+            {
+                uint32_t c = i;
+                for (int k = 0; k < 8; ++k)
+                {
+                    c = (c & 1u) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+                }
+                table[i] = c;
+            }
+            return table;
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+    // BinaryWriter
+    // -----------------------------------------------------------------------------
+    void BinaryWriter::writeRaw(const void *data, size_t bytes)
+    {
+        if (bytes == 0)
+        {
+            return;
+        }
+        size_t offset = m_buffer.size();
+        m_buffer.resize(offset + bytes);
+        std::memcpy(m_buffer.data() + offset, data, bytes);
+    }
+
+    void BinaryWriter::writeString(const std::string &value)
+    {
+        writeU32(static_cast<uint32_t>(value.size()));
+        writeRaw(value.data(), value.size());
+    }
+
+    void BinaryWriter::writeBoolArray(const std::vector<bool> &values)
+    {
+        writeU32(static_cast<uint32_t>(values.size()));
+        size_t offset = m_buffer.size();
+        m_buffer.resize(offset + values.size());
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            m_buffer[offset + i] = values[i] ? 1 : 0;
+        }
+    }
+
+    void BinaryWriter::writeEncodedFloats(const float *data, size_t count)
+    {
+        writeU32(static_cast<uint32_t>(count));
+        size_t marker = beginSection();
+        encodeFloats(m_floatCodec, data, count, m_buffer);
+        endSection(marker);
+    }
+
+    void BinaryWriter::writeReencoded(const BinaryWriter &capture, const std::vector<size_t> &offsets, size_t begin,
+                                      size_t end)
+    {
+        const uint8_t *bytes = capture.data();
+        auto array = std::lower_bound(offsets.begin(), offsets.end(), begin);
+        size_t pos = begin;
+        for (; array != offsets.end() && *array < end; ++array)
+        {
+            writeRaw(bytes + pos, *array - pos);
+            uint32_t count;
+            std::memcpy(&count, bytes + *array, sizeof(count));
+            m_scratch.resize(count);
+            std::memcpy(m_scratch.data(), bytes + *array + sizeof(count), count * sizeof(float));
+            writeArray(m_scratch.data(), count);
+            pos = *array + sizeof(count) + count * sizeof(float);
+        }
+        writeRaw(bytes + pos, end - pos);
+    }
+
+    size_t BinaryWriter::beginSection()
+    {
+        size_t marker = m_buffer.size();
+        writeU32(0);
+        return marker;
+    }
+
+    void BinaryWriter::endSection(size_t marker)
+    {
+        uint32_t length = static_cast<uint32_t>(m_buffer.size() - marker - sizeof(uint32_t));
+        std::memcpy(m_buffer.data() + marker, &length, sizeof(length));
+    }
+
+    // -----------------------------------------------------------------------------
+    // BinaryReader
+    // -----------------------------------------------------------------------------
+    void BinaryReader::readRaw(void *out, size_t bytes)
+    {
+        if (bytes > remaining())
+        {
+            throw std::runtime_error("Binary state truncated");
+        }
+        if (bytes > 0)
+        {
+            std::memcpy(out, m_data + m_pos, bytes);
+        }
+        m_pos += bytes;
+    }
+
+    std::string BinaryReader::readString()
+    {
+        size_t length = readU32();
+        if (length > remaining())
+        {
+            throw std::runtime_error("Binary state truncated");
+        }
+        std::string value(reinterpret_cast<const char *>(m_data + m_pos), length);
+        m_pos += length;
+        return value;
+    }
+
+    std::vector<bool> BinaryReader::readBoolArray()
+    {
+        size_t count = readU32();
+        if (count > remaining())
+        {
+            throw std::runtime_error("Binary state truncated");
+        }
+        std::vector<bool> values(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            values[i] = m_data[m_pos + i] != 0;
+        }
+        m_pos += count;
+        return values;
+    }
+
+    BinaryReader BinaryReader::readSection(size_t length)
+    {
+        if (length > remaining())
+        {
+            throw std::runtime_error("Binary state truncated");
+        }
+        BinaryReader section(m_data + m_pos, length);
+        section.m_floatCodec = m_floatCodec;
+        m_pos += length;
+        return section;
+    }
+
+    std::vector<float> BinaryReader::readEncodedFloats()
+    {
+        size_t count = readU32();
+        size_t length = readU32();
+        // Every codec spends at least one bit per value after the first
+        if (length > remaining() || count > length * 8 + 1)
+        {
+            throw std::runtime_error("Binary state truncated");
+        }
+        std::vector<float> values(count);
+        decodeFloats(m_floatCodec, m_data + m_pos, length, values.data(), count);
+        m_pos += length;
+        return values;
+    }
+
+    // -----------------------------------------------------------------------------
+    // nextWindowEpoch - Unique epochs for WindowMark (0 is never handed out)
+    // -----------------------------------------------------------------------------
+    uint64_t nextWindowEpoch() noexcept
+    {
+        static std::atomic<uint64_t> counter{0};
+        return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    // -----------------------------------------------------------------------------
+    // crc32 - Table-driven CRC-32
+    // -----------------------------------------------------------------------------
+    uint32_t crc32(const uint8_t *data, size_t size, uint32_t crc)
+    {
+        static const std::array<uint32_t, 256> table = makeCrcTable();
+
+        crc = ~crc;
+        for (size_t i = 0; i < size; ++i)
+        {
+            crc = table[(crc ^ data[i]) & 0xFFu] ^ (crc >> 8);
+        }
+        return ~crc;
+    }
+
+} // namespace dsp::utils
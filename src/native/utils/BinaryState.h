@@ -0,0 +1,328 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <type_traits>
+#include "FloatCodec.h"
+
+namespace dsp::utils
+{
+    /**
+     * @brief Appends primitives and raw arrays to a growable byte buffer.
+     *
+     * Values are written in host byte order (little-endian on every platform
+     * the addon targets). Arrays are a uint32 element count followed by the
+     * raw elements, so sample windows are copied with a single memcpy.
+     *
+     * With a float codec set, float arrays are instead written as a uint32
+     * count, a uint32 byte length and the encoded bytes (see FloatCodec.h).
+     */
+    class BinaryWriter
+    {
+    public:
+        BinaryWriter() = default;
+
+        void writeU8(uint8_t value) { writeRaw(&value, sizeof(value)); }
+        void writeU16(uint16_t value) { writeRaw(&value, sizeof(value)); }
+        void writeU32(uint32_t value) { writeRaw(&value, sizeof(value)); }
+        void writeU64(uint64_t value) { writeRaw(&value, sizeof(value)); }
+        void writeI32(int32_t value) { writeRaw(&value, sizeof(value)); }
+        void writeF32(float value) { writeRaw(&value, sizeof(value)); }
+        void writeF64(double value) { writeRaw(&value, sizeof(value)); }
+
+        /**
+         * @brief Writes a uint32 byte length followed by the characters.
+         */
+        void writeString(const std::string &value);
+
+        /**
+         * @brief Writes a uint32 element count followed by the raw elements.
+         */
+        template <typename T>
+        void writeArray(const T *data, size_t count)
+        {
+            static_assert(std::is_arithmetic<T>::value && !std::is_same<T, bool>::value,
+                          "writeArray requires a non-bool arithmetic type");
+            if constexpr (std::is_same<T, float>::value)
+            {
+                if (m_floatArrays != nullptr)
+                {
+                    m_floatArrays->push_back(m_buffer.size());
+                }
+                else if (m_floatCodec != FloatCodec::None)
+                {
+                    writeEncodedFloats(data, count);
+                    return;
+                }
+            }
+            writeU32(static_cast<uint32_t>(count));
+            writeRaw(data, count * sizeof(T));
+        }
+
+        template <typename T>
+        void writeArray(const std::vector<T> &values) { writeArray(values.data(), values.size()); }
+
+        /**
+         * @brief Writes a bool vector as a count followed by one byte per entry.
+         */
+        void writeBoolArray(const std::vector<bool> &values);
+
+        /**
+         * @brief Reserves a uint32 length slot and returns its offset.
+         * Pair with endSection() once the section body has been written.
+         */
+        size_t beginSection();
+
+        /**
+         * @brief Patches the slot reserved by beginSection() with the body length.
+         */
+        void endSection(size_t marker);
+
+        /**
+         * @brief Selects how subsequent float arrays are encoded.
+         */
+        void setFloatCodec(FloatCodec codec) noexcept { m_floatCodec = codec; }
+        FloatCodec floatCodec() const noexcept { return m_floatCodec; }
+
+        /**
+         * @brief Writes float arrays raw whatever the codec and appends the
+         * offset of each one to offsets (nullptr stops), so the codec can be
+         * applied later by writeReencoded() - away from whatever lock the
+         * capture needed.
+         */
+        void logFloatArrays(std::vector<size_t> *offsets) noexcept { m_floatArrays = offsets; }
+
+        /**
+         * @brief Appends bytes [begin, end) of a logFloatArrays() capture,
+         * encoding its float arrays with this writer's codec.
+         * @param offsets The capture's log; only entries within the range are used.
+         */
+        void writeReencoded(const BinaryWriter &capture, const std::vector<size_t> &offsets, size_t begin,
+                            size_t end);
+
+        void reserve(size_t bytes) { m_buffer.reserve(bytes); }
+        const uint8_t *data() const noexcept { return m_buffer.data(); }
+        size_t size() const noexcept { return m_buffer.size(); }
+        std::vector<uint8_t> &buffer() noexcept { return m_buffer; }
+
+    private:
+        void writeRaw(const void *data, size_t bytes);
+        void writeEncodedFloats(const float *data, size_t count);
+
+        std::vector<uint8_t> m_buffer;
+        FloatCodec m_floatCodec = FloatCodec::None;
+        std::vector<size_t> *m_floatArrays = nullptr;
+        std::vector<float> m_scratch; // writeReencoded(): one aligned array
+    };
+
+    /**
+     * @brief Bounds-checked reader over a byte range produced by BinaryWriter.
+     *
+     * Every read throws std::runtime_error instead of running past the end,
+     * so truncated or corrupted snapshots fail cleanly.
+     */
+    class BinaryReader
+    {
+    public:
+        BinaryReader(const uint8_t *data, size_t size) : m_data(data), m_size(size), m_pos(0) {}
+
+        uint8_t readU8() { return readValue<uint8_t>(); }
+        uint16_t readU16() { return readValue<uint16_t>(); }
+        uint32_t readU32() { return readValue<uint32_t>(); }
+        uint64_t readU64() { return readValue<uint64_t>(); }
+        int32_t readI32() { return readValue<int32_t>(); }
+        float readF32() { return readValue<float>(); }
+        double readF64() { return readValue<double>(); }
+
+        std::string readString();
+
+        template <typename T>
+        std::vector<T> readArray()
+        {
+            static_assert(std::is_arithmetic<T>::value && !std::is_same<T, bool>::value,
+                          "readArray requires a non-bool arithmetic type");
+            if constexpr (std::is_same<T, float>::value)
+            {
+                if (m_floatCodec != FloatCodec::None)
+                {
+                    return readEncodedFloats();
+                }
+            }
+            size_t count = readU32();
+            if (count > remaining() / sizeof(T))
+            {
+                throw std::runtime_error("Binary state truncated");
+            }
+            std::vector<T> values(count);
+            readRaw(values.data(), count * sizeof(T));
+            return values;
+        }
+
+        std::vector<bool> readBoolArray();
+
+        /**
+         * @brief Returns a reader over the next length bytes and skips past them.
+         * The section inherits this reader's float codec.
+         */
+        BinaryReader readSection(size_t length);
+
+        /**
+         * @brief Selects how subsequent float arrays are decoded; must match the writer.
+         */
+        void setFloatCodec(FloatCodec codec) noexcept { m_floatCodec = codec; }
+
+        size_t position() const noexcept { return m_pos; }
+        size_t remaining() const noexcept { return m_size - m_pos; }
+
+    private:
+        template <typename T>
+        T readValue()
+        {
+            T value;
+            readRaw(&value, sizeof(T));
+            return value;
+        }
+
+        void readRaw(void *out, size_t bytes);
+        std::vector<float> readEncodedFloats();
+
+        const uint8_t *m_data;
+        size_t m_size;
+        size_t m_pos;
+        FloatCodec m_floatCodec = FloatCodec::None;
+    };
+
+    /**
+     * @brief A point in a sliding window's push history.
+     *
+     * epoch changes whenever the window contents are replaced wholesale
+     * (construction, clear, state restore); pushed counts the samples added
+     * since. Two marks with the same epoch therefore tell exactly how many
+     * samples entered the window between them, which is what delta
+     * snapshots need.
+     */
+    struct WindowMark
+    {
+        uint64_t epoch = 0;
+        uint64_t pushed = 0;
+
+        bool operator==(const WindowMark &other) const noexcept
+        {
+            return epoch == other.epoch && pushed == other.pushed;
+        }
+        bool operator!=(const WindowMark &other) const noexcept { return !(*this == other); }
+    };
+
+    /**
+     * @brief Returns a process-wide unique, non-zero window epoch.
+     */
+    uint64_t nextWindowEpoch() noexcept;
+
+    /**
+     * @brief Number of samples pushed between two marks of the same window.
+     * @return false if the window was reset or restored in between.
+     */
+    inline bool windowPushedSince(const WindowMark &since, const WindowMark &now, uint64_t &count) noexcept
+    {
+        if (since.epoch != now.epoch || now.pushed < since.pushed)
+        {
+            return false;
+        }
+        count = now.pushed - since.pushed;
+        return true;
+    }
+
+    /**
+     * @brief Collects getWindowMark() from every filter, in order.
+     */
+    template <typename Filter>
+    std::vector<WindowMark> collectWindowMarks(const std::vector<Filter> &filters)
+    {
+        std::vector<WindowMark> marks;
+        marks.reserve(filters.size());
+        for (const auto &filter : filters)
+        {
+            marks.push_back(filter.getWindowMark());
+        }
+        return marks;
+    }
+
+    /**
+     * @brief Samples pushed into each window since the matching mark.
+     * @return false if the window count differs or any window was reset or restored.
+     */
+    inline bool pushedSinceMarks(const std::vector<WindowMark> &now, const std::vector<WindowMark> &since,
+                                 std::vector<uint64_t> &pushed)
+    {
+        if (now.size() != since.size())
+        {
+            return false;
+        }
+        pushed.resize(now.size());
+        for (size_t i = 0; i < now.size(); ++i)
+        {
+            if (!windowPushedSince(since[i], now[i], pushed[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Samples pushed into each filter since the matching mark.
+     * @return false if the filter count differs or any window was reset or restored.
+     */
+    template <typename Filter>
+    bool pushedSinceMarks(const std::vector<Filter> &filters, const std::vector<WindowMark> &since,
+                          std::vector<uint64_t> &pushed)
+    {
+        return pushedSinceMarks(collectWindowMarks(filters), since, pushed);
+    }
+
+    /**
+     * @brief Writes the delta of a window: its current length followed by
+     * the newest min(pushed, length) samples (the only ones a reader holding
+     * the older state is missing).
+     */
+    template <typename T>
+    void writeWindowTail(BinaryWriter &writer, const std::vector<T> &window, uint64_t pushed)
+    {
+        size_t tail = static_cast<size_t>(std::min<uint64_t>(pushed, window.size()));
+        writer.writeU32(static_cast<uint32_t>(window.size()));
+        writer.writeArray(window.data() + (window.size() - tail), tail);
+    }
+
+    /**
+     * @brief Applies a writeWindowTail() record to the older window contents.
+     *
+     * The new window is the newest (length - tail) old samples followed by
+     * the tail. Throws if the old window is too short, i.e. the delta does
+     * not follow the state it is applied to.
+     */
+    template <typename T>
+    void applyWindowTail(BinaryReader &reader, std::vector<T> &window)
+    {
+        size_t length = reader.readU32();
+        std::vector<T> tail = reader.readArray<T>();
+        if (tail.size() > length || window.size() + tail.size() < length)
+        {
+            throw std::runtime_error("Delta snapshot does not match the current window");
+        }
+        size_t keep = length - tail.size();
+        window.erase(window.begin(), window.end() - keep);
+        window.insert(window.end(), tail.begin(), tail.end());
+    }
+
+    /**
+     * @brief CRC-32 (IEEE 802.3, reflected) of a byte range.
+     * @param crc Running value from a previous call, for incremental use.
+     */
+    uint32_t crc32(const uint8_t *data, size_t size, uint32_t crc = 0);
+
+} // namespace dsp::utils
@@ -7,26 +7,27 @@ using namespace dsp::utils;
 
 // -----------------------------------------------------------------------------
 // Constructor
-// Initializes the circular buffer with a specified size using std::make_unique
+// Initializes the circular buffer with a specified size. Storage is 64-byte
+// aligned and comes from the current ArenaScope, if any (see Arena.h)
 // @ param size - The size of the circular buffer
 // @ param windowDuration_ms - Optional window duration for time-based expiration (0 = disabled)
 // @ return void
 // -----------------------------------------------------------------------------
 template <typename T>
 CircularBufferArray<T>::CircularBufferArray(size_t size, double windowDuration_ms)
-    : buffer(std::make_unique<T[]>(std::max(size, static_cast<size_t>(1)))),
-      timestamps(windowDuration_ms > 0.0 ? std::make_unique<double[]>(std::max(size, static_cast<size_t>(1))) : nullptr),
+    : buffer(std::max(size, static_cast<size_t>(1))),
+      timestamps(windowDuration_ms > 0.0 ? std::max(size, static_cast<size_t>(1)) : 0),
       head(0),
       tail(0),
       capacity(std::max(size, static_cast<size_t>(1))),
       count(0),
       windowDuration_ms(windowDuration_ms)
 {
-    // Buffers are automatically initialized by make_unique
+    // Buffers are value-initialized by AlignedArray
 }
 
 // Note: Move constructor and move assignment operator are now defaulted in the header
-// std::unique_ptr handles move semantics correctly by default
+// AlignedArray handles move semantics correctly by default
 
 // -----------------------------------------------------------------------------
 // Method: push
@@ -99,6 +100,34 @@ void CircularBufferArray<T>::pushOverwrite(const T &item)
         ++this->count;
 }
 
+// -----------------------------------------------------------------------------
+// Method: pushOverwrite (range)
+// Adds n items in order, as n single pushOverwrite() calls would
+// @ param items - The items to add, oldest first
+// @ param n - Number of items
+// -----------------------------------------------------------------------------
+template <typename T>
+void CircularBufferArray<T>::pushOverwrite(const T *items, size_t n)
+{
+    if (n >= this->capacity)
+    {
+        // Only the newest `capacity` items survive
+        std::copy(items + (n - this->capacity), items + n, this->buffer.get());
+        this->head = 0;
+        this->tail = 0;
+        this->count = this->capacity;
+        return;
+    }
+
+    const size_t first = std::min(n, this->capacity - this->head);
+    std::copy(items, items + first, this->buffer.get() + this->head);
+    std::copy(items + first, items + n, this->buffer.get());
+
+    this->head = (this->head + n) % this->capacity;
+    this->count = std::min(this->count + n, this->capacity);
+    this->tail = (this->head + this->capacity - this->count) % this->capacity;
+}
+
 // -----------------------------------------------------------------------------
 // Getter: getCapacity
 // @ param void
@@ -179,6 +208,19 @@ std::vector<T> CircularBufferArray<T>::toVector() const
     return result;
 }
 
+// -----------------------------------------------------------------------------
+// Method: copyTo
+// Copies the buffer contents in order (oldest to newest) without allocating
+// @ param out - Destination for getCount() items
+// -----------------------------------------------------------------------------
+template <typename T>
+void CircularBufferArray<T>::copyTo(T *out) const
+{
+    const size_t first = std::min(this->count, this->capacity - this->tail);
+    std::copy(this->buffer.get() + this->tail, this->buffer.get() + this->tail + first, out);
+    std::copy(this->buffer.get(), this->buffer.get() + (this->count - first), out + first);
+}
+
 // -----------------------------------------------------------------------------
 // Method: fromVector
 // Imports buffer contents from a vector, maintaining order
@@ -324,7 +366,7 @@ void CircularBufferArray<T>::fromVectorWithTimestamps(const std::vector<std::pai
 }
 
 // Note: Destructor is now defaulted in the header
-// std::unique_ptr automatically cleans up the buffers
+// AlignedArray automatically cleans up the buffers
 
 // Explicit template instantiation for common types
 namespace dsp::utils
@@ -3,6 +3,7 @@
 #include <vector>
 #include <stdexcept>
 #include <memory>
+#include "Arena.h"
 
 namespace dsp::utils
 {
@@ -17,7 +18,7 @@ namespace dsp::utils
         CircularBufferArray(const CircularBufferArray &other) = delete;            // disable copy to avoid shallow copy
         CircularBufferArray &operator=(const CircularBufferArray &other) = delete; // disable copy assignment to avoid shallow copy
 
-        // move semantics (defaulted - compiler generated is now safe with unique_ptr)
+        // move semantics (defaulted - AlignedArray is move-only)
         CircularBufferArray(CircularBufferArray &&other) noexcept = default;
         CircularBufferArray &operator=(CircularBufferArray &&other) noexcept = default;
 
@@ -26,6 +27,7 @@ namespace dsp::utils
         bool pop(T &item) noexcept;
         void clear() noexcept;
         void pushOverwrite(const T &item);
+        void pushOverwrite(const T *items, size_t n);
 
         // Time-aware methods (require timestamps to be enabled)
         void pushWithTimestamp(const T &item, double timestamp);
@@ -43,16 +45,17 @@ namespace dsp::utils
 
         // state management
         std::vector<T> toVector() const;
+        void copyTo(T *out) const;
         void fromVector(const std::vector<T> &data);
         std::vector<std::pair<double, T>> toVectorWithTimestamps() const;
         void fromVectorWithTimestamps(const std::vector<std::pair<double, T>> &data);
 
-        // destructor (defaulted - unique_ptr handles cleanup automatically)
+        // destructor (defaulted - AlignedArray handles cleanup automatically)
         ~CircularBufferArray() = default;
 
     private:
-        std::unique_ptr<T[]> buffer;
-        std::unique_ptr<double[]> timestamps; // Optional timestamp array (nullptr if not time-aware)
+        AlignedArray<T> buffer;           // 64-byte aligned; from the pipeline's arena while one is in scope
+        AlignedArray<double> timestamps; // Optional timestamp array (empty if not time-aware)
         size_t head;
         size_t tail;
         size_t capacity;
@@ -0,0 +1,97 @@
+#include "CpuFeatures.h"
+
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define DSP_CPU_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace dsp::utils
+{
+    namespace
+    {
+#if defined(DSP_CPU_X86)
+        void cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4]) noexcept
+        {
+#if defined(_MSC_VER)
+            int info[4];
+            __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+            for (int i = 0; i < 4; ++i)
+            {
+                regs[i] = static_cast<uint32_t>(info[i]);
+            }
+#else
+            __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+        }
+
+        // XCR0: which register states the OS saves on context switches
+        uint64_t xgetbv0() noexcept
+        {
+#if defined(_MSC_VER)
+            return _xgetbv(0);
+#else
+            uint32_t eax = 0;
+            uint32_t edx = 0;
+            __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+            return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+        }
+#endif
+
+        CpuFeatures detect() noexcept
+        {
+            CpuFeatures features;
+
+#if defined(DSP_CPU_X86)
+            uint32_t regs[4] = {0, 0, 0, 0}; // eax, ebx, ecx, edx
+            cpuid(0, 0, regs);
+            const uint32_t maxLeaf = regs[0];
+            if (maxLeaf < 1)
+            {
+                return features;
+            }
+
+            cpuid(1, 0, regs);
+            features.sse2 = (regs[3] & (1u << 26)) != 0;
+            features.sse3 = (regs[2] & (1u << 0)) != 0;
+            const bool fma = (regs[2] & (1u << 12)) != 0;
+            const bool osxsave = (regs[2] & (1u << 27)) != 0;
+            const bool avx = (regs[2] & (1u << 28)) != 0;
+
+            // XMM|YMM state (bits 1-2), plus opmask|ZMM_Hi256|Hi16_ZMM (bits 5-7)
+            const uint64_t xcr0 = osxsave ? xgetbv0() : 0;
+            const bool osYmm = (xcr0 & 0x06) == 0x06;
+            const bool osZmm = (xcr0 & 0xE6) == 0xE6;
+
+            features.avx = avx && osYmm;
+            features.fma = fma && features.avx;
+
+            if (maxLeaf >= 7)
+            {
+                cpuid(7, 0, regs);
+                features.avx2 = features.avx && (regs[1] & (1u << 5)) != 0;
+                features.avx512f = osZmm && (regs[1] & (1u << 16)) != 0;
+            }
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+            // Advanced SIMD is mandatory on AArch64 and a build-time choice on ARMv7
+            features.neon = true;
+#endif
+
+            return features;
+        }
+    }
+
+    const CpuFeatures &cpuFeatures() noexcept
+    {
+        static const CpuFeatures features = detect();
+        return features;
+    }
+
+} // namespace dsp::utils
@@ -0,0 +1,34 @@
+#pragma once
+
+/**
+ * @file CpuFeatures.h
+ * @brief Run-time CPU feature detection for SIMD kernel dispatch
+ *
+ * Detection runs once (cpuid + xgetbv on x86, compile-time on ARM) and is
+ * cached for the lifetime of the process. A feature is only reported when
+ * both the CPU and the operating system support it, i.e. AVX/AVX-512 also
+ * require the OS to save the wider register state on context switches.
+ */
+
+namespace dsp::utils
+{
+    struct CpuFeatures
+    {
+        // x86 / x64
+        bool sse2 = false;
+        bool sse3 = false;
+        bool avx = false;
+        bool avx2 = false;
+        bool fma = false;
+        bool avx512f = false;
+
+        // ARM
+        bool neon = false;
+    };
+
+    /**
+     * @brief Features of the CPU this process runs on.
+     */
+    const CpuFeatures &cpuFeatures() noexcept;
+
+} // namespace dsp::utils
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace dsp::utils
+{
+    /**
+     * @brief Whether a value is neither NaN nor infinite, read from its
+     * exponent bits.
+     *
+     * The addon is built with -ffast-math, which lets the compiler assume
+     * no NaN or infinity ever occurs: std::isfinite folds to true and NaN
+     * comparisons may be rewritten. Validation of parameters and restored
+     * state, and guards against NaN samples, must use these instead.
+     */
+    inline bool isFinite(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return (bits & 0x7f800000u) != 0x7f800000u;
+    }
+
+    inline bool isFinite(double value)
+    {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return (bits & 0x7ff0000000000000ull) != 0x7ff0000000000000ull;
+    }
+
+    /**
+     * @brief Whether a value is NaN (all exponent bits set, non-zero
+     * mantissa); see isFinite() for why this is not std::isnan.
+     */
+    inline bool isNaN(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return (bits & 0x7fffffffu) > 0x7f800000u;
+    }
+
+    inline bool isNaN(double value)
+    {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return (bits & 0x7fffffffffffffffull) > 0x7ff0000000000000ull;
+    }
+
+} // namespace dsp::utils
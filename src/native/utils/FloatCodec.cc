@@ -0,0 +1,354 @@
+#include "FloatCodec.h"
+#include <cstring>
+#include <stdexcept>
+
+namespace dsp::utils
+{
+    namespace
+    {
+        uint32_t floatBits(float value)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+
+        float bitsToFloat(uint32_t bits)
+        {
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        int leadingZeros(uint32_t x)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_clz(x);
+#else
+            int n = 0;
+            while (!(x & 0x80000000u))
+            {
+                x <<= 1;
+                ++n;
+            }
+            return n;
+#endif
+        }
+
+        int trailingZeros(uint32_t x)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_ctz(x);
+#else
+            int n = 0;
+            while (!(x & 1u))
+            {
+                x >>= 1;
+                ++n;
+            }
+            return n;
+#endif
+        }
+
+        uint64_t lowMask(int bits)
+        {
+            return (uint64_t(1) << bits) - 1;
+        }
+
+        // MSB-first bit packer over a byte vector
+        class BitWriter
+        {
+        public:
+            explicit BitWriter(std::vector<uint8_t> &out) : m_out(out) {}
+
+            void write(uint32_t value, int bits)
+            {
+                m_acc = (m_acc << bits) | (value & lowMask(bits));
+                m_bits += bits;
+                while (m_bits >= 8)
+                {
+                    m_bits -= 8;
+                    m_out.push_back(static_cast<uint8_t>(m_acc >> m_bits));
+                }
+            }
+
+            void flush()
+            {
+                if (m_bits > 0)
+                {
+                    m_out.push_back(static_cast<uint8_t>(m_acc << (8 - m_bits)));
+                    m_bits = 0;
+                }
+            }
+
+        private:
+            std::vector<uint8_t> &m_out;
+            uint64_t m_acc = 0;
+            int m_bits = 0;
+        };
+
+        class BitReader
+        {
+        public:
+            BitReader(const uint8_t *data, size_t size) : m_data(data), m_size(size) {}
+
+            uint32_t read(int bits)
+            {
+                while (m_bits < bits)
+                {
+                    if (m_pos >= m_size)
+                    {
+                        throw std::runtime_error("Compressed float array truncated");
+                    }
+                    m_acc = (m_acc << 8) | m_data[m_pos++];
+                    m_bits += 8;
+                }
+                m_bits -= bits;
+                return static_cast<uint32_t>((m_acc >> m_bits) & lowMask(bits));
+            }
+
+            size_t bytesRead() const noexcept { return m_pos; }
+
+        private:
+            const uint8_t *m_data;
+            size_t m_size;
+            size_t m_pos = 0;
+            uint64_t m_acc = 0;
+            int m_bits = 0;
+        };
+
+        // -------------------------------------------------------------------------
+        // Gorilla XOR (Pelkonen et al., adapted to 32-bit floats)
+        //   first value: 32 raw bits
+        //   then per value: '0'                    identical to the previous value
+        //                   '10' + bits            XOR fits the previous leading/trailing window
+        //                   '11' + 5b lead + 5b (len - 1) + len bits
+        // Only the encoder decides when to open a new window, so the format
+        // stays plain Gorilla.
+        // -------------------------------------------------------------------------
+        constexpr int kWindowHeaderBits = 10; // 5b lead + 5b length
+
+        void encodeXor(const float *values, size_t count, std::vector<uint8_t> &out)
+        {
+            BitWriter writer(out);
+            uint32_t prev = floatBits(values[0]);
+            writer.write(prev, 32);
+
+            int prevLead = -1;
+            int prevTrail = 0;
+            for (size_t i = 1; i < count; ++i)
+            {
+                uint32_t bits = floatBits(values[i]);
+                uint32_t x = bits ^ prev;
+                prev = bits;
+
+                if (x == 0)
+                {
+                    writer.write(0, 1);
+                    continue;
+                }
+
+                int lead = leadingZeros(x);
+                int trail = trailingZeros(x);
+                // Reuse the previous window only while it is no more expensive than
+                // describing a new one; otherwise one wide early window sticks forever
+                bool fits = prevLead >= 0 && lead >= prevLead && trail >= prevTrail;
+                if (fits && (lead + trail) - (prevLead + prevTrail) <= kWindowHeaderBits)
+                {
+                    writer.write(0b10, 2);
+                    writer.write(x >> prevTrail, 32 - prevLead - prevTrail);
+                }
+                else
+                {
+                    int length = 32 - lead - trail;
+                    writer.write(0b11, 2);
+                    writer.write(static_cast<uint32_t>(lead), 5);
+                    writer.write(static_cast<uint32_t>(length - 1), 5);
+                    writer.write(x >> trail, length);
+                    prevLead = lead;
+                    prevTrail = trail;
+                }
+            }
+            writer.flush();
+        }
+
+        size_t decodeXor(const uint8_t *data, size_t size, float *values, size_t count)
+        {
+            BitReader reader(data, size);
+            uint32_t prev = reader.read(32);
+            values[0] = bitsToFloat(prev);
+
+            int prevLead = -1;
+            int prevTrail = 0;
+            for (size_t i = 1; i < count; ++i)
+            {
+                if (reader.read(1) != 0)
+                {
+                    if (reader.read(1) == 0)
+                    {
+                        if (prevLead < 0)
+                        {
+                            throw std::runtime_error("Corrupt compressed float array");
+                        }
+                        prev ^= reader.read(32 - prevLead - prevTrail) << prevTrail;
+                    }
+                    else
+                    {
+                        int lead = static_cast<int>(reader.read(5));
+                        int length = static_cast<int>(reader.read(5)) + 1;
+                        if (lead + length > 32)
+                        {
+                            throw std::runtime_error("Corrupt compressed float array");
+                        }
+                        int trail = 32 - lead - length;
+                        prev ^= reader.read(length) << trail;
+                        prevLead = lead;
+                        prevTrail = trail;
+                    }
+                }
+                values[i] = bitsToFloat(prev);
+            }
+            return reader.bytesRead();
+        }
+
+        // -------------------------------------------------------------------------
+        // Delta + zigzag + varint over the bit patterns: neighbouring samples of
+        // a smooth signal share sign and exponent, so their patterns are close
+        // -------------------------------------------------------------------------
+        void encodeDeltaVarint(const float *values, size_t count, std::vector<uint8_t> &out)
+        {
+            uint32_t prev = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                uint32_t bits = floatBits(values[i]);
+                int32_t delta = static_cast<int32_t>(bits - prev);
+                prev = bits;
+
+                uint32_t zigzag = (static_cast<uint32_t>(delta) << 1) ^ static_cast<uint32_t>(delta >> 31);
+                while (zigzag >= 0x80u)
+                {
+                    out.push_back(static_cast<uint8_t>(zigzag | 0x80u));
+                    zigzag >>= 7;
+                }
+                out.push_back(static_cast<uint8_t>(zigzag));
+            }
+        }
+
+        size_t decodeDeltaVarint(const uint8_t *data, size_t size, float *values, size_t count)
+        {
+            size_t pos = 0;
+            uint32_t prev = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                uint32_t zigzag = 0;
+                for (int shift = 0;; shift += 7)
+                {
+                    if (pos >= size)
+                    {
+                        throw std::runtime_error("Compressed float array truncated");
+                    }
+                    if (shift > 28)
+                    {
+                        throw std::runtime_error("Corrupt compressed float array");
+                    }
+                    uint8_t byte = data[pos++];
+                    zigzag |= static_cast<uint32_t>(byte & 0x7Fu) << shift;
+                    if (!(byte & 0x80u))
+                    {
+                        break;
+                    }
+                }
+
+                uint32_t delta = (zigzag >> 1) ^ (0u - (zigzag & 1u));
+                prev += delta;
+                values[i] = bitsToFloat(prev);
+            }
+            return pos;
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+    // parseFloatCodec
+    // -----------------------------------------------------------------------------
+    FloatCodec parseFloatCodec(const std::string &name)
+    {
+        if (name == "none")
+        {
+            return FloatCodec::None;
+        }
+        if (name == "xor")
+        {
+            return FloatCodec::Xor;
+        }
+        if (name == "delta")
+        {
+            return FloatCodec::DeltaVarint;
+        }
+        throw std::invalid_argument("Unknown snapshot codec '" + name + "' (expected 'none', 'xor' or 'delta')");
+    }
+
+    // -----------------------------------------------------------------------------
+    // encodeFloats
+    // -----------------------------------------------------------------------------
+    void encodeFloats(FloatCodec codec, const float *values, size_t count, std::vector<uint8_t> &out)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        switch (codec)
+        {
+        case FloatCodec::Xor:
+            encodeXor(values, count, out);
+            break;
+        case FloatCodec::DeltaVarint:
+            encodeDeltaVarint(values, count, out);
+            break;
+        case FloatCodec::None:
+        default:
+        {
+            size_t offset = out.size();
+            out.resize(offset + count * sizeof(float));
+            std::memcpy(out.data() + offset, values, count * sizeof(float));
+            break;
+        }
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+    // decodeFloats
+    // -----------------------------------------------------------------------------
+    void decodeFloats(FloatCodec codec, const uint8_t *data, size_t size, float *values, size_t count)
+    {
+        size_t consumed = 0;
+        if (count > 0)
+        {
+            switch (codec)
+            {
+            case FloatCodec::Xor:
+                consumed = decodeXor(data, size, values, count);
+                break;
+            case FloatCodec::DeltaVarint:
+                consumed = decodeDeltaVarint(data, size, values, count);
+                break;
+            case FloatCodec::None:
+                consumed = count * sizeof(float);
+                if (consumed > size)
+                {
+                    throw std::runtime_error("Compressed float array truncated");
+                }
+                std::memcpy(values, data, consumed);
+                break;
+            default:
+                throw std::runtime_error("Unknown float codec " + std::to_string(static_cast<int>(codec)));
+            }
+        }
+
+        if (consumed != size)
+        {
+            throw std::runtime_error("Corrupt compressed float array");
+        }
+    }
+
+} // namespace dsp::utils
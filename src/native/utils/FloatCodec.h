@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace dsp::utils
+{
+    /**
+     * @brief Compression applied to float arrays in binary state snapshots.
+     *
+     * Both codecs are lossless and work on the IEEE-754 bit patterns, so a
+     * decoded window is bit-identical to the one that was saved.
+     */
+    enum class FloatCodec : uint8_t
+    {
+        None = 0,       // Raw 4 bytes per value
+        Xor = 1,        // Gorilla-style: XOR with the previous value, store the meaningful bits
+        DeltaVarint = 2 // Delta of the bit patterns, zigzag + LEB128 varint
+    };
+
+    /**
+     * @brief Parses "none", "xor" or "delta".
+     * @throws std::invalid_argument for anything else.
+     */
+    FloatCodec parseFloatCodec(const std::string &name);
+
+    /**
+     * @brief Appends the encoding of count values to out.
+     */
+    void encodeFloats(FloatCodec codec, const float *values, size_t count, std::vector<uint8_t> &out);
+
+    /**
+     * @brief Decodes exactly count values from size bytes.
+     * @throws std::runtime_error if the bytes do not hold exactly count values.
+     */
+    void decodeFloats(FloatCodec codec, const uint8_t *data, size_t size, float *values, size_t count);
+
+} // namespace dsp::utils
@@ -0,0 +1,136 @@
+#include "MultiChannelSlidingWindow.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+using namespace dsp::utils;
+
+// -----------------------------------------------------------------------------
+// Constructor
+// @ param window_size - Samples per channel in the window
+// @ param num_channels - Number of interleaved channels
+// @ param statistic - Statistic process() reports
+// @ param epsilon - ZScore stddev floor
+// -----------------------------------------------------------------------------
+MultiChannelSlidingWindow::MultiChannelSlidingWindow(size_t window_size, size_t num_channels,
+                                                     dsp::simd::WindowStatistic statistic, float epsilon)
+    : m_window_size(window_size),
+      m_num_channels(num_channels),
+      m_statistic(statistic),
+      m_epsilon(epsilon),
+      m_ring(window_size * num_channels),
+      m_sum(num_channels),
+      m_sum_sq(num_channels),
+      m_head(0),
+      m_count(0),
+      m_mark{nextWindowEpoch(), 0}
+{
+    if (window_size == 0)
+    {
+        throw std::invalid_argument("Window size must be greater than 0");
+    }
+    if (num_channels == 0)
+    {
+        throw std::invalid_argument("Channel count must be greater than 0");
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Method: process
+// Runs the frames through the kernel in runs that end at the ring's end
+// @ param buffer - Interleaved samples, replaced by the statistic
+// @ param numFrames - Number of frames
+// -----------------------------------------------------------------------------
+void MultiChannelSlidingWindow::process(float *buffer, size_t numFrames)
+{
+    size_t done = 0;
+    while (done < numFrames)
+    {
+        const size_t run = std::min(numFrames - done, m_window_size - m_head);
+
+        dsp::simd::WindowFrames frames;
+        frames.frames = buffer + done * m_num_channels;
+        frames.slots = m_ring.data() + m_head * m_num_channels;
+        frames.sum = m_sum.data();
+        frames.sum_sq = m_sum_sq.data();
+        frames.channels = m_num_channels;
+        frames.numFrames = run;
+        frames.count = m_count;
+        frames.windowSize = m_window_size;
+        frames.statistic = m_statistic;
+        frames.epsilon = m_epsilon;
+        dsp::simd::window_frames(frames);
+
+        m_count = std::min(m_count + run, m_window_size);
+        m_head = (m_head + run) % m_window_size;
+        done += run;
+    }
+    m_mark.pushed += numFrames;
+}
+
+// -----------------------------------------------------------------------------
+// Method: clear
+// -----------------------------------------------------------------------------
+void MultiChannelSlidingWindow::clear()
+{
+    std::fill(m_ring.begin(), m_ring.end(), 0.0f);
+    std::fill(m_sum.begin(), m_sum.end(), 0.0f);
+    std::fill(m_sum_sq.begin(), m_sum_sq.end(), 0.0f);
+    m_head = 0;
+    m_count = 0;
+    m_mark = {nextWindowEpoch(), 0};
+}
+
+// -----------------------------------------------------------------------------
+// Method: getChannelWindow
+// @ param channel - Channel index
+// @ return std::vector<float> - The channel's samples, oldest first
+// -----------------------------------------------------------------------------
+std::vector<float> MultiChannelSlidingWindow::getChannelWindow(size_t channel) const
+{
+    std::vector<float> window;
+    window.reserve(m_count);
+
+    size_t slot = (m_head + m_window_size - m_count) % m_window_size;
+    for (size_t i = 0; i < m_count; ++i)
+    {
+        window.push_back(m_ring[slot * m_num_channels + channel]);
+        slot = (slot + 1) % m_window_size;
+    }
+    return window;
+}
+
+// -----------------------------------------------------------------------------
+// Method: setChannelState
+// Channel 0 resets the windows; later channels must match its length
+// @ param channel - Channel index
+// @ param window - Samples, oldest first
+// @ param sum - Running sum (of |x| for MeanAbs)
+// @ param sumOfSquares - Running sum of squares
+// -----------------------------------------------------------------------------
+void MultiChannelSlidingWindow::setChannelState(size_t channel, const std::vector<float> &window,
+                                                float sum, float sumOfSquares)
+{
+    const size_t length = std::min(window.size(), m_window_size);
+    if (channel == 0)
+    {
+        clear();
+        m_count = length;
+        m_head = length % m_window_size;
+    }
+    else if (length != m_count)
+    {
+        throw std::runtime_error(
+            "Channel windows must have the same length: channel 0 has " +
+            std::to_string(m_count) + " samples but channel " +
+            std::to_string(channel) + " has " + std::to_string(length));
+    }
+
+    const size_t skip = window.size() - length;
+    for (size_t i = 0; i < length; ++i)
+    {
+        m_ring[i * m_num_channels + channel] = window[skip + i];
+    }
+    m_sum[channel] = sum;
+    m_sum_sq[channel] = sumOfSquares;
+}
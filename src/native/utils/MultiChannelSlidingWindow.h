@@ -0,0 +1,124 @@
+#pragma once
+#include "SimdOps.h"
+#include "BinaryState.h"
+#include "Arena.h"
+#include <vector>
+
+namespace dsp::utils
+{
+    /**
+     * @brief Lock-step sample-count sliding windows for every channel of an
+     * interleaved stream.
+     *
+     * Per-channel SlidingWindowFilters de-interleave each sample (i % channels)
+     * and update one channel's running sums at a time. Here the ring stores
+     * whole frames (slot s holds sample s of every channel, channels
+     * contiguous), so one interleaved frame maps onto one ring slot and the
+     * running sums of all channels are updated together by
+     * simd::window_frames(): a single vector instruction per frame covers
+     * 8 channels on AVX2 and 16 on AVX-512.
+     *
+     * All channels share one sample count, one ring position and one
+     * WindowMark, which is exactly what an interleaved stream produces.
+     * Results match the per-channel filters (same operations, same order).
+     */
+    class MultiChannelSlidingWindow
+    {
+    public:
+        /**
+         * @brief Channel count from which stages switch from per-channel
+         * filters to lock-step windows (one SSE2/NEON vector per frame).
+         */
+        static constexpr size_t kMinChannels = 4;
+
+        /**
+         * @brief Constructs the windows.
+         * @param window_size Samples per channel in the window.
+         * @param num_channels Number of interleaved channels.
+         * @param statistic What process() replaces each sample with.
+         * @param epsilon ZScore only: stddev below which the result is 0.
+         */
+        MultiChannelSlidingWindow(size_t window_size, size_t num_channels,
+                                  dsp::simd::WindowStatistic statistic, float epsilon = 1e-8f);
+
+        // Delete copy constructor and copy assignment
+        MultiChannelSlidingWindow(const MultiChannelSlidingWindow &) = delete;
+        MultiChannelSlidingWindow &operator=(const MultiChannelSlidingWindow &) = delete;
+
+        // Enable move semantics
+        MultiChannelSlidingWindow(MultiChannelSlidingWindow &&) noexcept = default;
+        MultiChannelSlidingWindow &operator=(MultiChannelSlidingWindow &&) noexcept = default;
+
+        /**
+         * @brief Pushes interleaved frames and replaces every sample with its
+         * channel's statistic.
+         * @param buffer numFrames * getNumChannels() interleaved samples (in-place).
+         * @param numFrames Number of frames.
+         */
+        void process(float *buffer, size_t numFrames);
+
+        /**
+         * @brief Empties every channel's window and zeroes the running sums.
+         */
+        void clear();
+
+        size_t getCount() const noexcept { return m_count; }
+        size_t getWindowSize() const noexcept { return m_window_size; }
+        size_t getNumChannels() const noexcept { return m_num_channels; }
+
+        /**
+         * @brief One channel's window contents, oldest first.
+         */
+        std::vector<float> getChannelWindow(size_t channel) const;
+
+        /**
+         * @brief Running sum of a channel (sum of |x| for MeanAbs).
+         */
+        float getSum(size_t channel) const { return m_sum[channel]; }
+
+        /**
+         * @brief Running sum of squares of a channel.
+         */
+        float getSumOfSquares(size_t channel) const { return m_sum_sq[channel]; }
+
+        /**
+         * @brief Restores one channel's window (oldest first) and running sums.
+         *
+         * Channels are restored in order: restoring channel 0 empties all
+         * windows and fixes the sample count; every other channel must then
+         * bring the same number of samples, since the windows move in
+         * lock-step. Windows longer than the window size keep their newest
+         * samples.
+         *
+         * @throws std::runtime_error if a channel's length differs from channel 0's.
+         */
+        void setChannelState(size_t channel, const std::vector<float> &window, float sum, float sumOfSquares);
+
+        /**
+         * @brief Position in the push history (shared by all channels).
+         */
+        WindowMark getWindowMark() const noexcept { return m_mark; }
+
+        /**
+         * @brief One WindowMark per channel, for IDspStage::windowMarks().
+         */
+        std::vector<WindowMark> windowMarks() const
+        {
+            return std::vector<WindowMark>(m_num_channels, m_mark);
+        }
+
+    private:
+        size_t m_window_size;
+        size_t m_num_channels;
+        dsp::simd::WindowStatistic m_statistic;
+        float m_epsilon;
+
+        AlignedArray<float> m_ring;   // m_window_size slots of m_num_channels samples; unused slots hold 0
+        AlignedArray<float> m_sum;    // Per channel (sum of |x| for MeanAbs)
+        AlignedArray<float> m_sum_sq; // Per channel
+        size_t m_head;               // Next slot to write
+        size_t m_count;              // Samples per channel in the window
+        WindowMark m_mark;           // New epoch on clear/restore, pushed++ per frame
+    };
+
+} // namespace dsp::utils
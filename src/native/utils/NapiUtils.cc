@@ -1,4 +1,6 @@
 #include "NapiUtils.h"
+#include <stdexcept>
+#include <string>
 
 template <typename T>
 std::vector<T> dsp::utils::NapiArrayToVector(const Napi::Array &arr)
@@ -43,6 +45,122 @@ Napi::Array dsp::utils::VectorToNapiArray(Napi::Env env, const std::vector<T> &v
     return arr;
 }
 
+namespace
+{
+    enum ValueTag : uint8_t
+    {
+        TagNull = 0,
+        TagFalse = 1,
+        TagTrue = 2,
+        TagNumber = 3,
+        TagString = 4,
+        TagArray = 5,
+        TagObject = 6
+    };
+
+    // Guards the recursive decoder against hostile or corrupted input
+    constexpr int kMaxValueDepth = 64;
+
+    Napi::Value readNapiValue(Napi::Env env, dsp::utils::BinaryReader &reader, int depth)
+    {
+        if (depth > kMaxValueDepth)
+        {
+            throw std::runtime_error("Binary state nested too deeply");
+        }
+
+        uint8_t tag = reader.readU8();
+        switch (tag)
+        {
+        case TagNull:
+            return env.Null();
+        case TagFalse:
+            return Napi::Boolean::New(env, false);
+        case TagTrue:
+            return Napi::Boolean::New(env, true);
+        case TagNumber:
+            return Napi::Number::New(env, reader.readF64());
+        case TagString:
+            return Napi::String::New(env, reader.readString());
+        case TagArray:
+        {
+            uint32_t length = reader.readU32();
+            Napi::Array arr = Napi::Array::New(env);
+            for (uint32_t i = 0; i < length; ++i)
+            {
+                arr.Set(i, readNapiValue(env, reader, depth + 1));
+            }
+            return arr;
+        }
+        case TagObject:
+        {
+            uint32_t length = reader.readU32();
+            Napi::Object obj = Napi::Object::New(env);
+            for (uint32_t i = 0; i < length; ++i)
+            {
+                std::string key = reader.readString();
+                obj.Set(key, readNapiValue(env, reader, depth + 1));
+            }
+            return obj;
+        }
+        default:
+            throw std::runtime_error("Binary state contains an unknown value tag");
+        }
+    }
+}
+
+void dsp::utils::WriteNapiValue(BinaryWriter &writer, const Napi::Value &value)
+{
+    if (value.IsBoolean())
+    {
+        writer.writeU8(value.As<Napi::Boolean>().Value() ? TagTrue : TagFalse);
+    }
+    else if (value.IsNumber())
+    {
+        writer.writeU8(TagNumber);
+        writer.writeF64(value.As<Napi::Number>().DoubleValue());
+    }
+    else if (value.IsString())
+    {
+        writer.writeU8(TagString);
+        writer.writeString(value.As<Napi::String>().Utf8Value());
+    }
+    else if (value.IsArray())
+    {
+        Napi::Array arr = value.As<Napi::Array>();
+        uint32_t length = arr.Length();
+        writer.writeU8(TagArray);
+        writer.writeU32(length);
+        for (uint32_t i = 0; i < length; ++i)
+        {
+            WriteNapiValue(writer, arr.Get(i));
+        }
+    }
+    else if (value.IsObject() && !value.IsFunction())
+    {
+        Napi::Object obj = value.As<Napi::Object>();
+        Napi::Array keys = obj.GetPropertyNames();
+        uint32_t length = keys.Length();
+        writer.writeU8(TagObject);
+        writer.writeU32(length);
+        for (uint32_t i = 0; i < length; ++i)
+        {
+            std::string key = keys.Get(i).As<Napi::String>().Utf8Value();
+            writer.writeString(key);
+            WriteNapiValue(writer, obj.Get(key));
+        }
+    }
+    else
+    {
+        // undefined, null, functions, symbols: same as JSON.stringify would drop/nullify
+        writer.writeU8(TagNull);
+    }
+}
+
+Napi::Value dsp::utils::ReadNapiValue(Napi::Env env, BinaryReader &reader)
+{
+    return readNapiValue(env, reader, 0);
+}
+
 // Explicit template instantiations
 template std::vector<float> dsp::utils::NapiArrayToVector<float>(const Napi::Array &);
 template std::vector<double> dsp::utils::NapiArrayToVector<double>(const Napi::Array &);
@@ -3,6 +3,7 @@
 #include <napi.h>
 #include <vector>
 #include <type_traits> // For std::is_same
+#include "BinaryState.h"
 
 namespace dsp::utils
 {
@@ -18,4 +19,16 @@ namespace dsp::utils
     template <typename T>
     Napi::Array VectorToNapiArray(Napi::Env env, const std::vector<T> &vec);
 
+    /**
+     * @brief Encodes a plain JS value tree (null, boolean, number, string,
+     * array, object) into a binary snapshot. Used for stages that do not
+     * write their own binary state section.
+     */
+    void WriteNapiValue(BinaryWriter &writer, const Napi::Value &value);
+
+    /**
+     * @brief Decodes a value tree written by WriteNapiValue.
+     */
+    Napi::Value ReadNapiValue(Napi::Env env, BinaryReader &reader);
+
 } // namespace dsp::utils
\ No newline at end of file
@@ -0,0 +1,48 @@
+#include "PipelineMetrics.h"
+
+namespace dsp::utils
+{
+    namespace
+    {
+        double *writeStats(double *out, const DurationStats &stats) noexcept
+        {
+            *out++ = static_cast<double>(stats.count.load(std::memory_order_relaxed));
+            *out++ = static_cast<double>(stats.totalNs.load(std::memory_order_relaxed));
+            *out++ = static_cast<double>(stats.maxNs.load(std::memory_order_relaxed));
+            return out;
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+    // PipelineMetrics::snapshot
+    // -----------------------------------------------------------------------------
+    void PipelineMetrics::snapshot(double *out) const noexcept
+    {
+        *out++ = static_cast<double>(m_stages.size());
+        out = writeStats(out, queue);
+        out = writeStats(out, execute);
+        out = writeStats(out, resolve);
+
+        for (const StageMetrics &stage : m_stages)
+        {
+            out = writeStats(out, stage.time);
+            *out++ = static_cast<double>(stage.samples.load(std::memory_order_relaxed));
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+    // PipelineMetrics::reset
+    // -----------------------------------------------------------------------------
+    void PipelineMetrics::reset() noexcept
+    {
+        queue.reset();
+        execute.reset();
+        resolve.reset();
+        for (StageMetrics &stage : m_stages)
+        {
+            stage.time.reset();
+            stage.samples.store(0, std::memory_order_relaxed);
+        }
+    }
+
+} // namespace dsp::utils
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+namespace dsp::utils
+{
+    /**
+     * @brief Monotonic time in nanoseconds (steady_clock).
+     */
+    inline uint64_t monotonicNs() noexcept
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                         std::chrono::steady_clock::now().time_since_epoch())
+                                         .count());
+    }
+
+    /**
+     * @brief Count, total and maximum of a series of durations.
+     *
+     * Written by one thread at a time (the worker holding the pipeline's
+     * state lock, or the main thread) and read from JS at any moment, so
+     * every field is a relaxed atomic: a snapshot may mix two consecutive
+     * updates, but never sees a torn value.
+     */
+    struct DurationStats
+    {
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> totalNs{0};
+        std::atomic<uint64_t> maxNs{0};
+
+        void record(uint64_t ns) noexcept
+        {
+            count.fetch_add(1, std::memory_order_relaxed);
+            totalNs.fetch_add(ns, std::memory_order_relaxed);
+            if (ns > maxNs.load(std::memory_order_relaxed))
+            {
+                maxNs.store(ns, std::memory_order_relaxed);
+            }
+        }
+
+        void reset() noexcept
+        {
+            count.store(0, std::memory_order_relaxed);
+            totalNs.store(0, std::memory_order_relaxed);
+            maxNs.store(0, std::memory_order_relaxed);
+        }
+    };
+
+    /**
+     * @brief Timing of one stage's process() calls plus the samples they handled.
+     */
+    struct StageMetrics
+    {
+        DurationStats time;
+        std::atomic<uint64_t> samples{0};
+
+        void record(uint64_t ns, size_t numSamples) noexcept
+        {
+            time.record(ns);
+            samples.fetch_add(numSamples, std::memory_order_relaxed);
+        }
+    };
+
+    /**
+     * @brief Per-stage timings and process() job latencies of a pipeline.
+     *
+     * A job's life is split into three phases:
+     *   queue   - from queueing the worker until it holds the state lock
+     *             (libuv thread pool wait plus any earlier job still running)
+     *   execute - running every stage
+     *   resolve - from the end of Execute() until OnOK()/OnError() runs on
+     *             the main thread
+     *
+     * snapshot() flattens everything into doubles (see kHeaderSize and
+     * kStageFields for the layout) so JS reads it as one Float64Array.
+     */
+    class PipelineMetrics
+    {
+    public:
+        // [stageCount, queue{count,totalNs,maxNs}, execute{...}, resolve{...}]
+        static constexpr size_t kHeaderSize = 10;
+        // Per stage: [calls, totalNs, maxNs, samples]
+        static constexpr size_t kStageFields = 4;
+
+        DurationStats queue;
+        DurationStats execute;
+        DurationStats resolve;
+
+        /**
+         * @brief Adds counters for a newly appended stage.
+         * Must not race with a worker that is recording stage timings.
+         */
+        void addStage() { m_stages.emplace_back(); }
+
+        StageMetrics &stage(size_t index) noexcept { return m_stages[index]; }
+
+        size_t stageCount() const noexcept { return m_stages.size(); }
+
+        size_t snapshotSize() const noexcept { return kHeaderSize + kStageFields * m_stages.size(); }
+
+        /**
+         * @brief Writes snapshotSize() values to out.
+         */
+        void snapshot(double *out) const noexcept;
+
+        /**
+         * @brief Zeroes every counter, keeping the stage list.
+         */
+        void reset() noexcept;
+
+    private:
+        // A deque never relocates existing counters when a stage is added
+        std::deque<StageMetrics> m_stages;
+    };
+
+} // namespace dsp::utils
@@ -0,0 +1,93 @@
+#include "PrefixSumWindow.h"
+#include <algorithm>
+
+using namespace dsp::utils;
+
+// -----------------------------------------------------------------------------
+// Method: process
+// Evaluates the chunk in kernel calls of up to max(kBlockSamples, w) samples
+// @ param window - Sample-count window, updated to hold the newest samples
+// @ param samples - First sample, replaced by the statistic
+// @ param count - Number of samples
+// @ param stride - Distance between consecutive samples
+// @ param statistic - Statistic to compute
+// @ param epsilon - ZScore stddev floor
+// @ param sum - Sum over the final window
+// @ param sumSq - Sum of squares over the final window
+// -----------------------------------------------------------------------------
+void PrefixSumWindow::process(CircularBufferArray<float> &window, float *samples, size_t count, size_t stride,
+                              dsp::simd::WindowStatistic statistic, float epsilon, double &sum, double &sumSq)
+{
+    const size_t windowSize = window.getCapacity();
+    const size_t blockSamples = std::max(kBlockSamples, windowSize);
+
+    size_t done = 0;
+    while (done < count)
+    {
+        const size_t numSamples = std::min(count - done, blockSamples);
+        const size_t history = window.getCount();
+        float *chunk = samples + done * stride;
+
+        // History (oldest first), then the chunk gathered from its channel
+        m_values.resize(history + numSamples);
+        window.copyTo(m_values.data());
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            m_values[history + i] = chunk[i * stride];
+        }
+        m_prefix.resize(history + numSamples + 1);
+        m_prefix_sq.resize(history + numSamples + 1);
+
+        float *out = chunk;
+        if (stride != 1)
+        {
+            m_out.resize(numSamples);
+            out = m_out.data();
+        }
+
+        dsp::simd::WindowBlock run;
+        run.values = m_values.data();
+        run.history = history;
+        run.numSamples = numSamples;
+        run.windowSize = windowSize;
+        run.statistic = statistic;
+        run.epsilon = epsilon;
+        run.prefix = m_prefix.data();
+        run.prefix_sq = m_prefix_sq.data();
+        run.out = out;
+        run.sum = &sum;
+        run.sum_sq = &sumSq;
+        dsp::simd::window_block(run);
+
+        if (stride != 1)
+        {
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                chunk[i * stride] = out[i];
+            }
+        }
+
+        window.pushOverwrite(m_values.data() + history, numSamples);
+        done += numSamples;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Method: reserve
+// Sizes the scratch for the largest kernel call a chunk can produce
+// @ param windowSize - Window capacity (bounds the history)
+// @ param maxCount - Largest chunk passed to process()
+// -----------------------------------------------------------------------------
+void PrefixSumWindow::reserve(size_t windowSize, size_t maxCount)
+{
+    if (!accepts(maxCount, windowSize))
+    {
+        return; // Such chunks never take the block path
+    }
+
+    const size_t numSamples = std::min(maxCount, std::max(kBlockSamples, windowSize));
+    m_values.reserve(windowSize + numSamples);
+    m_out.reserve(numSamples);
+    m_prefix.reserve(windowSize + numSamples + 1);
+    m_prefix_sq.reserve(windowSize + numSamples + 1);
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include "CircularBufferArray.h"
+#include "SimdOps.h"
+#include <vector>
+
+namespace dsp::utils
+{
+    /**
+     * @brief Block evaluation of a sample-count moving statistic.
+     *
+     * Instead of a push, a pop and a divide per sample, a whole chunk is
+     * evaluated at once by simd::window_block(): one prefix-sum pass over
+     * the window's history plus the chunk, then out[i] = f(P[i] - P[i - w]).
+     * Sums are accumulated in double and rebuilt from the window contents
+     * on every chunk, so rounding error cannot build up over a long stream.
+     *
+     * The history pass costs O(w) per chunk, so this only pays off for
+     * chunks at least one window long (see accepts()); shorter chunks stay
+     * on the per-sample path. Holds the scratch buffers only; the window
+     * itself stays in the filter's CircularBufferArray.
+     */
+    class PrefixSumWindow
+    {
+    public:
+        /**
+         * @brief Smallest chunk worth a block evaluation.
+         */
+        static constexpr size_t kMinSamples = 32;
+
+        /**
+         * @brief New samples per kernel call (bounds the scratch buffers).
+         */
+        static constexpr size_t kBlockSamples = 4096;
+
+        /**
+         * @brief Whether a chunk of `count` samples should take the block path.
+         */
+        static bool accepts(size_t count, size_t windowSize) noexcept
+        {
+            return count >= kMinSamples && count >= windowSize;
+        }
+
+        /**
+         * @brief Pushes a chunk through the window, replacing every sample
+         * with the statistic of the window ending at it.
+         * @param window The sample-count window (updated to hold the newest samples).
+         * @param samples First sample (in-place).
+         * @param count Number of samples.
+         * @param stride Distance between consecutive samples (channel count for interleaved data).
+         * @param statistic The statistic to compute.
+         * @param epsilon ZScore only: stddev below which the result is 0.
+         * @param sum Set to the sum over the final window (of |x| for MeanAbs).
+         * @param sumSq Set to the sum of squares over the final window.
+         */
+        void process(CircularBufferArray<float> &window, float *samples, size_t count, size_t stride,
+                     dsp::simd::WindowStatistic statistic, float epsilon, double &sum, double &sumSq);
+
+        /**
+         * @brief Sizes the scratch buffers for chunks of up to maxCount
+         * samples, so process() does not allocate afterwards.
+         */
+        void reserve(size_t windowSize, size_t maxCount);
+
+    private:
+        std::vector<float> m_values;   // History followed by the chunk
+        std::vector<float> m_out;      // Results (strided chunks only)
+        std::vector<double> m_prefix;  // Prefix sums
+        std::vector<double> m_prefix_sq;
+    };
+
+} // namespace dsp::utils
@@ -0,0 +1,160 @@
+#include "SimdKernels.h"
+#include "CpuFeatures.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace dsp::simd
+{
+    namespace detail
+    {
+        std::atomic<const KernelTable *> g_kernels{nullptr};
+    }
+
+    namespace
+    {
+        const KernelTable *tableFor(SimdLevel level) noexcept
+        {
+            const utils::CpuFeatures &cpu = utils::cpuFeatures();
+            switch (level)
+            {
+            case SimdLevel::Scalar:
+                return kernels_impl::scalarKernels();
+            case SimdLevel::Sse2:
+                return cpu.sse2 ? kernels_impl::sse2Kernels() : nullptr;
+            case SimdLevel::Avx2:
+                return cpu.avx2 ? kernels_impl::avx2Kernels() : nullptr;
+            case SimdLevel::Avx512:
+                return cpu.avx512f && cpu.avx2 ? kernels_impl::avx512Kernels() : nullptr;
+            case SimdLevel::Neon:
+                return cpu.neon ? kernels_impl::neonKernels() : nullptr;
+            }
+            return nullptr;
+        }
+
+        // Widest first; the scalar table always exists
+        constexpr SimdLevel kPreference[] = {
+            SimdLevel::Avx512,
+            SimdLevel::Avx2,
+            SimdLevel::Sse2,
+            SimdLevel::Neon,
+            SimdLevel::Scalar,
+        };
+
+        size_t rank(SimdLevel level) noexcept
+        {
+            for (size_t i = 0; i < sizeof(kPreference) / sizeof(kPreference[0]); ++i)
+            {
+                if (kPreference[i] == level)
+                {
+                    return i;
+                }
+            }
+            return 0;
+        }
+
+        /**
+         * Best supported table no wider than DSPX_SIMD (when set and valid).
+         */
+        const KernelTable *selectAtStartup() noexcept
+        {
+            size_t first = 0;
+            SimdLevel cap;
+            const char *env = std::getenv("DSPX_SIMD");
+            if (env != nullptr && parseLevel(env, cap))
+            {
+                first = rank(cap);
+            }
+
+            for (size_t i = first; i < sizeof(kPreference) / sizeof(kPreference[0]); ++i)
+            {
+                if (const KernelTable *table = tableFor(kPreference[i]))
+                {
+                    return table;
+                }
+            }
+            return kernels_impl::scalarKernels();
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+    // Resolution (first kernel call)
+    // -----------------------------------------------------------------------------
+    namespace detail
+    {
+        const KernelTable &resolveKernels() noexcept
+        {
+            // Threads racing here all select the same table; the first store wins
+            const KernelTable *expected = nullptr;
+            const KernelTable *selected = selectAtStartup();
+            if (!g_kernels.compare_exchange_strong(expected, selected, std::memory_order_acq_rel))
+            {
+                return *expected;
+            }
+            return *selected;
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+    // Level queries and overrides
+    // -----------------------------------------------------------------------------
+    bool isSupported(SimdLevel level) noexcept
+    {
+        return tableFor(level) != nullptr;
+    }
+
+    SimdLevel bestLevel() noexcept
+    {
+        for (SimdLevel level : kPreference)
+        {
+            if (isSupported(level))
+            {
+                return level;
+            }
+        }
+        return SimdLevel::Scalar;
+    }
+
+    bool setLevel(SimdLevel level) noexcept
+    {
+        const KernelTable *table = tableFor(level);
+        if (table == nullptr)
+        {
+            return false;
+        }
+        detail::g_kernels.store(table, std::memory_order_release);
+        return true;
+    }
+
+    const char *levelName(SimdLevel level) noexcept
+    {
+        switch (level)
+        {
+        case SimdLevel::Scalar:
+            return "scalar";
+        case SimdLevel::Sse2:
+            return "sse2";
+        case SimdLevel::Avx2:
+            return "avx2";
+        case SimdLevel::Avx512:
+            return "avx512";
+        case SimdLevel::Neon:
+            return "neon";
+        }
+        return "scalar";
+    }
+
+    bool parseLevel(const char *name, SimdLevel &level) noexcept
+    {
+        for (SimdLevel candidate : kPreference)
+        {
+            if (std::strcmp(name, levelName(candidate)) == 0)
+            {
+                level = candidate;
+                return true;
+            }
+        }
+        return false;
+    }
+
+} // namespace dsp::simd
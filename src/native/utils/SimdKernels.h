@@ -0,0 +1,658 @@
+#pragma once
+
+/**
+ * @file SimdKernels.h
+ * @brief Per-instruction-set kernel tables behind SimdOps.h (internal)
+ *
+ * Each SimdKernels<Isa>.cc defines one table. Files for wider instruction
+ * sets than the build baseline mark every function with DSP_SIMD_TARGET so
+ * GCC/Clang emit those instructions there and nowhere else; MSVC accepts
+ * the intrinsics without any flag. A table getter returns nullptr when the
+ * target architecture has no such instruction set.
+ */
+
+#include "SimdOps.h"
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SIMD_X86
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+#define SIMD_NEON
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define DSP_SIMD_TARGET(isa) __attribute__((target(isa)))
+#else
+#define DSP_SIMD_TARGET(isa)
+#endif
+
+// For shared loop bodies too large for the inliner's own judgement: they
+// must be inlined into each DSP_SIMD_TARGET caller to be vectorized for it
+#if defined(__GNUC__) || defined(__clang__)
+#define DSP_SIMD_INLINE inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define DSP_SIMD_INLINE __forceinline
+#else
+#define DSP_SIMD_INLINE inline
+#endif
+
+namespace dsp::simd::kernels_impl
+{
+    const KernelTable *scalarKernels() noexcept;
+    const KernelTable *sse2Kernels() noexcept;
+    const KernelTable *avx2Kernels() noexcept;
+    const KernelTable *avx512Kernels() noexcept;
+    const KernelTable *neonKernels() noexcept;
+
+    /**
+     * @brief Scalar radix-2 butterflies j in [j, halfLen) of the block at `block`.
+     * Shared remainder loop of every FFT stage kernel; k is the twiddle index
+     * of butterfly j.
+     */
+    template <typename T>
+    inline void radix2Butterflies(T *block, size_t j, size_t halfLen,
+                                  const T *twiddles, size_t k, size_t twiddleStep, bool inverse)
+    {
+        const T sign = inverse ? T(-1) : T(1);
+        for (; j < halfLen; ++j, k += twiddleStep)
+        {
+            T *a = block + 2 * j;
+            T *b = block + 2 * (j + halfLen);
+            const T wr = twiddles[2 * k];
+            const T wi = sign * twiddles[2 * k + 1];
+
+            const T tr = b[0] * wr - b[1] * wi;
+            const T ti = b[0] * wi + b[1] * wr;
+            b[0] = a[0] - tr;
+            b[1] = a[1] - ti;
+            a[0] += tr;
+            a[1] += ti;
+        }
+    }
+
+    /**
+     * @brief Portable window_frames() body, one frame at a time.
+     *
+     * The channel loop has no cross-lane dependency, so each kernel file
+     * lets the compiler vectorize it for its own instruction set (the
+     * DSP_SIMD_TARGET caller inlines it); MSVC vectorizes it for the
+     * build baseline only.
+     */
+    template <WindowStatistic Stat>
+    inline void windowFramesFor(const WindowFrames &run)
+    {
+        const size_t channels = run.channels;
+        float *__restrict sum = run.sum;
+        float *__restrict sum_sq = run.sum_sq;
+        size_t count = run.count;
+
+        for (size_t f = 0; f < run.numFrames; ++f)
+        {
+            float *__restrict x = run.frames + f * channels;
+            float *__restrict slot = run.slots + f * channels;
+            count = std::min(count + 1, run.windowSize);
+            const float n = static_cast<float>(count);
+
+            for (size_t c = 0; c < channels; ++c)
+            {
+                const float value = x[c];
+                const float oldest = slot[c];
+                slot[c] = value;
+
+                if constexpr (Stat == WindowStatistic::Mean)
+                {
+                    sum[c] = sum[c] - oldest + value;
+                    x[c] = sum[c] / n;
+                }
+                else if constexpr (Stat == WindowStatistic::MeanAbs)
+                {
+                    sum[c] = sum[c] - std::abs(oldest) + std::abs(value);
+                    x[c] = sum[c] / n;
+                }
+                else if constexpr (Stat == WindowStatistic::Rms)
+                {
+                    sum_sq[c] = sum_sq[c] - oldest * oldest + value * value;
+                    x[c] = std::sqrt(std::max(0.0f, sum_sq[c] / n));
+                }
+                else
+                {
+                    sum[c] = sum[c] - oldest + value;
+                    sum_sq[c] = sum_sq[c] - oldest * oldest + value * value;
+                    const float mean = sum[c] / n;
+                    const float variance = std::max(0.0f, sum_sq[c] / n - mean * mean);
+                    if constexpr (Stat == WindowStatistic::Variance)
+                    {
+                        x[c] = variance;
+                    }
+                    else
+                    {
+                        const float stddev = std::sqrt(variance);
+                        x[c] = stddev < run.epsilon ? 0.0f : (value - mean) / stddev;
+                    }
+                }
+            }
+        }
+    }
+
+    inline void windowFrames(const WindowFrames &run)
+    {
+        switch (run.statistic)
+        {
+        case WindowStatistic::Mean:
+            return windowFramesFor<WindowStatistic::Mean>(run);
+        case WindowStatistic::Rms:
+            return windowFramesFor<WindowStatistic::Rms>(run);
+        case WindowStatistic::MeanAbs:
+            return windowFramesFor<WindowStatistic::MeanAbs>(run);
+        case WindowStatistic::Variance:
+            return windowFramesFor<WindowStatistic::Variance>(run);
+        case WindowStatistic::ZScore:
+            return windowFramesFor<WindowStatistic::ZScore>(run);
+        }
+    }
+
+    /**
+     * @brief p[0] = 0, p[i + 1] = p[i] + term(v[i]), accumulated in double.
+     *
+     * Each group of four is summed on its own first, so the loop-carried
+     * chain is one add per group rather than one per sample.
+     */
+    template <typename Term>
+    inline void prefixSums(const float *__restrict v, double *__restrict p, size_t n, Term term)
+    {
+        double carry = 0.0;
+        p[0] = 0.0;
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            const double a = term(v[i]);
+            const double b = a + term(v[i + 1]);
+            const double c = b + term(v[i + 2]);
+            const double d = c + term(v[i + 3]);
+            p[i + 1] = carry + a;
+            p[i + 2] = carry + b;
+            p[i + 3] = carry + c;
+            p[i + 4] = carry + d;
+            carry += d;
+        }
+        for (; i < n; ++i)
+        {
+            carry += term(v[i]);
+            p[i + 1] = carry;
+        }
+    }
+
+    /**
+     * @brief The statistic of one window from its sums (in double).
+     */
+    template <WindowStatistic Stat>
+    inline double blockStatistic(double sum, double sumSq, double n, double value, double epsilon)
+    {
+        if constexpr (Stat == WindowStatistic::Mean || Stat == WindowStatistic::MeanAbs)
+        {
+            return sum / n;
+        }
+        else if constexpr (Stat == WindowStatistic::Rms)
+        {
+            return std::sqrt(std::max(0.0, sumSq / n));
+        }
+        else
+        {
+            const double mean = sum / n;
+            const double variance = std::max(0.0, sumSq / n - mean * mean);
+            if constexpr (Stat == WindowStatistic::Variance)
+            {
+                return variance;
+            }
+            else
+            {
+                const double stddev = std::sqrt(variance);
+                return stddev < epsilon ? 0.0 : (value - mean) / stddev;
+            }
+        }
+    }
+
+    /**
+     * @brief Portable window_block() body: prefix sums, then differences.
+     *
+     * Like windowFramesFor(), each kernel file compiles it for its own
+     * instruction set. Only the prefix pass is sequential; once the window
+     * is full every result reads P[end] and P[end - w] with a constant
+     * divisor, which the compiler vectorizes.
+     */
+    template <WindowStatistic Stat>
+    inline void windowBlockFor(const WindowBlock &run)
+    {
+        constexpr bool kSum = Stat != WindowStatistic::Rms;
+        constexpr bool kSumSq = Stat != WindowStatistic::Mean && Stat != WindowStatistic::MeanAbs;
+
+        const size_t total = run.history + run.numSamples;
+        if constexpr (kSum)
+        {
+            prefixSums(run.values, run.prefix, total, [](float x)
+                       { return static_cast<double>(Stat == WindowStatistic::MeanAbs ? std::abs(x) : x); });
+        }
+        if constexpr (kSumSq)
+        {
+            prefixSums(run.values, run.prefix_sq, total, [](float x)
+                       { return static_cast<double>(x) * static_cast<double>(x); });
+        }
+
+        const float *__restrict values = run.values;
+        const double *__restrict prefix = run.prefix;
+        const double *__restrict prefixSq = run.prefix_sq;
+        float *__restrict out = run.out;
+        const size_t w = run.windowSize;
+        const double epsilon = run.epsilon;
+
+        // Window still filling: it starts at the first sample
+        size_t i = 0;
+        for (; i < run.numSamples && run.history + i < w; ++i)
+        {
+            const size_t end = run.history + i + 1;
+            out[i] = static_cast<float>(blockStatistic<Stat>(
+                kSum ? prefix[end] : 0.0, kSumSq ? prefixSq[end] : 0.0,
+                static_cast<double>(end), values[end - 1], epsilon));
+        }
+
+        // Full window
+        const double n = static_cast<double>(w);
+        for (; i < run.numSamples; ++i)
+        {
+            const size_t end = run.history + i + 1;
+            out[i] = static_cast<float>(blockStatistic<Stat>(
+                kSum ? prefix[end] - prefix[end - w] : 0.0,
+                kSumSq ? prefixSq[end] - prefixSq[end - w] : 0.0,
+                n, values[end - 1], epsilon));
+        }
+
+        const size_t start = total > w ? total - w : 0;
+        *run.sum = kSum ? prefix[total] - prefix[start] : 0.0;
+        *run.sum_sq = kSumSq ? prefixSq[total] - prefixSq[start] : 0.0;
+    }
+
+    inline void windowBlock(const WindowBlock &run)
+    {
+        switch (run.statistic)
+        {
+        case WindowStatistic::Mean:
+            return windowBlockFor<WindowStatistic::Mean>(run);
+        case WindowStatistic::Rms:
+            return windowBlockFor<WindowStatistic::Rms>(run);
+        case WindowStatistic::MeanAbs:
+            return windowBlockFor<WindowStatistic::MeanAbs>(run);
+        case WindowStatistic::Variance:
+            return windowBlockFor<WindowStatistic::Variance>(run);
+        case WindowStatistic::ZScore:
+            return windowBlockFor<WindowStatistic::ZScore>(run);
+        }
+    }
+
+    /**
+     * @brief Portable mix_frames() body: a cache-blocked GEMM.
+     *
+     * Tiles of kMixFrameTile frames by kMixOutputTile output channels are
+     * accumulated over panels of kMixInputTile input channels (a 64 KiB
+     * weight panel, which stays in L2 while every frame of the tile passes
+     * over it). Inside a tile four frames are updated together, so each
+     * weight row is loaded once per four axpys; the output-channel loop has
+     * no cross-lane dependency and is vectorized by each kernel file for
+     * its own instruction set.
+     */
+    inline void mixFrames(const MixFrames &run)
+    {
+        constexpr size_t kMixFrameTile = 64;
+        constexpr size_t kMixOutputTile = 256;
+        constexpr size_t kMixInputTile = 64;
+
+        const size_t C = run.inputChannels;
+        const size_t M = run.outputChannels;
+
+        for (size_t f0 = 0; f0 < run.numFrames; f0 += kMixFrameTile)
+        {
+            const size_t f1 = std::min(f0 + kMixFrameTile, run.numFrames);
+            for (size_t m0 = 0; m0 < M; m0 += kMixOutputTile)
+            {
+                const size_t mb = std::min(kMixOutputTile, M - m0);
+                for (size_t k0 = 0; k0 < C; k0 += kMixInputTile)
+                {
+                    const size_t k1 = std::min(k0 + kMixInputTile, C);
+                    const bool first = k0 == 0;
+
+                    size_t f = f0;
+                    for (; f + 4 <= f1; f += 4)
+                    {
+                        const float *x0 = run.input + f * C;
+                        const float *x1 = x0 + C;
+                        const float *x2 = x1 + C;
+                        const float *x3 = x2 + C;
+                        float *__restrict y0 = run.output + f * M + m0;
+                        float *__restrict y1 = y0 + M;
+                        float *__restrict y2 = y1 + M;
+                        float *__restrict y3 = y2 + M;
+                        if (first)
+                        {
+                            std::fill(y0, y0 + mb, 0.0f);
+                            std::fill(y1, y1 + mb, 0.0f);
+                            std::fill(y2, y2 + mb, 0.0f);
+                            std::fill(y3, y3 + mb, 0.0f);
+                        }
+                        for (size_t k = k0; k < k1; ++k)
+                        {
+                            const float *__restrict w = run.weights + k * M + m0;
+                            const float a0 = x0[k], a1 = x1[k], a2 = x2[k], a3 = x3[k];
+                            for (size_t m = 0; m < mb; ++m)
+                            {
+                                const float weight = w[m];
+                                y0[m] += a0 * weight;
+                                y1[m] += a1 * weight;
+                                y2[m] += a2 * weight;
+                                y3[m] += a3 * weight;
+                            }
+                        }
+                    }
+                    for (; f < f1; ++f)
+                    {
+                        const float *x = run.input + f * C;
+                        float *__restrict y = run.output + f * M + m0;
+                        if (first)
+                        {
+                            std::fill(y, y + mb, 0.0f);
+                        }
+                        for (size_t k = k0; k < k1; ++k)
+                        {
+                            const float *__restrict w = run.weights + k * M + m0;
+                            const float a = x[k];
+                            for (size_t m = 0; m < mb; ++m)
+                            {
+                                y[m] += a * w[m];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Whether a measurement is usable (finite). Tests the exponent
+     * bits, so it survives -ffast-math (which lets the compiler assume
+     * std::isfinite is true) and stays a select per lane.
+     */
+    DSP_SIMD_INLINE bool kalmanValid(float measurement)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &measurement, sizeof(bits));
+        return (bits & 0x7f800000u) != 0x7f800000u;
+    }
+
+    /**
+     * @brief Portable kalman_frames() body for the General form, N states.
+     *
+     * Channels are processed in tiles of kKalmanTile, with the predicted
+     * state and covariance of the tile in stack scratch. Every loop runs
+     * over the channels of the tile with N unrolled at compile time, so
+     * each kernel file vectorizes it for its own instruction set. The
+     * covariance update is P = P- - (P- H^T)(P- H^T)^T / S, which keeps P
+     * exactly symmetric.
+     */
+    template <size_t N>
+    DSP_SIMD_INLINE void kalmanGeneralFor(const KalmanFrames &run)
+    {
+        constexpr size_t kKalmanTile = 64;
+
+        const size_t C = run.channels;
+        float F[N][N], Q[N][N], H[N];
+        for (size_t i = 0; i < N; ++i)
+        {
+            H[i] = run.observation[i];
+            for (size_t j = 0; j < N; ++j)
+            {
+                F[i][j] = run.transition[i * N + j];
+                Q[i][j] = run.processNoise[i * N + j];
+            }
+        }
+        const float R = run.measurementNoise;
+
+        float xp[N][kKalmanTile];    // F x
+        float fp[N][N][kKalmanTile]; // F P
+        float pp[N][N][kKalmanTile]; // F P F^T + Q
+
+        for (size_t f = 0; f < run.numFrames; ++f)
+        {
+            float *__restrict z = run.frames + f * C;
+            for (size_t c0 = 0; c0 < C; c0 += kKalmanTile)
+            {
+                const size_t T = std::min(kKalmanTile, C - c0);
+                float *__restrict x = run.state + c0;
+                float *__restrict P = run.covariance + c0;
+
+                for (size_t i = 0; i < N; ++i)
+                {
+                    for (size_t t = 0; t < T; ++t)
+                    {
+                        float acc = 0.0f;
+                        for (size_t j = 0; j < N; ++j)
+                        {
+                            acc += F[i][j] * x[j * C + t];
+                        }
+                        xp[i][t] = acc;
+                    }
+                    for (size_t k = 0; k < N; ++k)
+                    {
+                        for (size_t t = 0; t < T; ++t)
+                        {
+                            float acc = 0.0f;
+                            for (size_t j = 0; j < N; ++j)
+                            {
+                                acc += F[i][j] * P[(j * N + k) * C + t];
+                            }
+                            fp[i][k][t] = acc;
+                        }
+                    }
+                }
+                for (size_t i = 0; i < N; ++i)
+                {
+                    for (size_t l = 0; l < N; ++l)
+                    {
+                        for (size_t t = 0; t < T; ++t)
+                        {
+                            float acc = Q[i][l];
+                            for (size_t k = 0; k < N; ++k)
+                            {
+                                acc += fp[i][k][t] * F[l][k];
+                            }
+                            pp[i][l][t] = acc;
+                        }
+                    }
+                }
+
+                // Update the scratch (which cannot alias anything), then store it
+                for (size_t t = 0; t < T; ++t)
+                {
+                    float ph[N]; // P- H^T
+                    float s = R;
+                    float hx = 0.0f;
+                    for (size_t i = 0; i < N; ++i)
+                    {
+                        float acc = 0.0f;
+                        for (size_t j = 0; j < N; ++j)
+                        {
+                            acc += pp[i][j][t] * H[j];
+                        }
+                        ph[i] = acc;
+                        s += H[i] * acc;
+                        hx += H[i] * xp[i][t];
+                    }
+
+                    const float measured = z[c0 + t];
+                    const bool valid = kalmanValid(measured);
+                    const float w = valid ? 1.0f / s : 0.0f;
+                    const float y = valid ? (measured - hx) * w : 0.0f;
+
+                    float estimate = 0.0f;
+                    for (size_t i = 0; i < N; ++i)
+                    {
+                        xp[i][t] += ph[i] * y;
+                        estimate += H[i] * xp[i][t];
+                        for (size_t j = 0; j < N; ++j)
+                        {
+                            pp[i][j][t] -= ph[i] * ph[j] * w;
+                        }
+                    }
+                    z[c0 + t] = estimate;
+                }
+                for (size_t i = 0; i < N; ++i)
+                {
+                    std::copy(xp[i], xp[i] + T, x + i * C);
+                    for (size_t j = 0; j < N; ++j)
+                    {
+                        std::copy(pp[i][j], pp[i][j] + T, P + (i * N + j) * C);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief One frame of the ConstantVelocity form over every channel.
+     *
+     * Each array gets its own restrict parameter: restrict locals carved
+     * out of one buffer are not enough for GCC to drop the run-time alias
+     * checks, and with seven streams there are too many of those to
+     * vectorize at all.
+     */
+    DSP_SIMD_INLINE void kalmanConstantVelocityFrame(float *__restrict position, float *__restrict velocity,
+                                                     float *__restrict p00, float *__restrict p01,
+                                                     float *__restrict p10, float *__restrict p11,
+                                                     float *__restrict z, size_t channels, float dt,
+                                                     const float *q, float R)
+    {
+        const float q00 = q[0], q01 = q[1], q11 = q[3];
+        for (size_t c = 0; c < channels; ++c)
+        {
+            const float a = position[c] + dt * velocity[c];
+            const float b = velocity[c];
+            const float m00 = p00[c] + dt * (2.0f * p01[c] + dt * p11[c]) + q00;
+            const float m01 = p01[c] + dt * p11[c] + q01;
+            const float m11 = p11[c] + q11;
+
+            const float measured = z[c];
+            const bool valid = kalmanValid(measured);
+            const float w = valid ? 1.0f / (m00 + R) : 0.0f;
+            const float y = valid ? (measured - a) * w : 0.0f;
+
+            const float estimate = a + m00 * y;
+            const float off = m01 - m00 * m01 * w;
+            position[c] = estimate;
+            velocity[c] = b + m01 * y;
+            p00[c] = m00 - m00 * m00 * w;
+            p01[c] = off;
+            p10[c] = off;
+            p11[c] = m11 - m01 * m01 * w;
+            z[c] = estimate;
+        }
+    }
+
+    /**
+     * @brief Portable kalman_frames() body for the ConstantVelocity form.
+     *
+     * The General update written out for F = [1 dt; 0 1], H = [1 0]: no
+     * matrix products, no scratch, and one pass over the channels per
+     * frame. Only the upper triangle of P is read; both off-diagonal
+     * entries are written.
+     */
+    DSP_SIMD_INLINE void kalmanConstantVelocity(const KalmanFrames &run)
+    {
+        const size_t C = run.channels;
+        float *x = run.state;
+        float *P = run.covariance;
+        for (size_t f = 0; f < run.numFrames; ++f)
+        {
+            kalmanConstantVelocityFrame(x, x + C, P, P + C, P + 2 * C, P + 3 * C, run.frames + f * C, C,
+                                        run.transition[1], run.processNoise, run.measurementNoise);
+        }
+    }
+
+    /**
+     * @brief Portable kalman_frames() body for the SteadyState form, N states.
+     *
+     * Once P has converged the gain no longer changes, so the update is
+     * x = F x + K (z - H F x): no covariance is read or written.
+     */
+    template <size_t N>
+    DSP_SIMD_INLINE void kalmanSteadyStateFor(const KalmanFrames &run)
+    {
+        const size_t C = run.channels;
+        float F[N][N], H[N], K[N];
+        for (size_t i = 0; i < N; ++i)
+        {
+            H[i] = run.observation[i];
+            K[i] = run.gain[i];
+            for (size_t j = 0; j < N; ++j)
+            {
+                F[i][j] = run.transition[i * N + j];
+            }
+        }
+
+        float *__restrict x = run.state;
+        for (size_t f = 0; f < run.numFrames; ++f)
+        {
+            float *__restrict z = run.frames + f * C;
+            for (size_t c = 0; c < C; ++c)
+            {
+                float xp[N];
+                float hx = 0.0f;
+                for (size_t i = 0; i < N; ++i)
+                {
+                    float acc = 0.0f;
+                    for (size_t j = 0; j < N; ++j)
+                    {
+                        acc += F[i][j] * x[j * C + c];
+                    }
+                    xp[i] = acc;
+                    hx += H[i] * acc;
+                }
+
+                const float measured = z[c];
+                const float y = kalmanValid(measured) ? measured - hx : 0.0f;
+
+                float estimate = 0.0f;
+                for (size_t i = 0; i < N; ++i)
+                {
+                    const float value = xp[i] + K[i] * y;
+                    x[i * C + c] = value;
+                    estimate += H[i] * value;
+                }
+                z[c] = estimate;
+            }
+        }
+    }
+
+    DSP_SIMD_INLINE void kalmanFrames(const KalmanFrames &run)
+    {
+        if (run.form == KalmanForm::ConstantVelocity)
+        {
+            kalmanConstantVelocity(run);
+            return;
+        }
+        const bool steady = run.form == KalmanForm::SteadyState;
+        switch (run.states)
+        {
+        case 1:
+            steady ? kalmanSteadyStateFor<1>(run) : kalmanGeneralFor<1>(run);
+            break;
+        case 2:
+            steady ? kalmanSteadyStateFor<2>(run) : kalmanGeneralFor<2>(run);
+            break;
+        case 3:
+            steady ? kalmanSteadyStateFor<3>(run) : kalmanGeneralFor<3>(run);
+            break;
+        default:
+            steady ? kalmanSteadyStateFor<4>(run) : kalmanGeneralFor<4>(run);
+            break;
+        }
+    }
+
+} // namespace dsp::simd::kernels_impl
@@ -0,0 +1,490 @@
+/**
+ * AVX2 kernels (8 floats / 4 doubles per vector), compiled for AVX2 with
+ * function attributes so the rest of the addon keeps the SSE2 baseline.
+ * Only selected when cpuid and XCR0 report AVX2 (see CpuFeatures.cc).
+ */
+
+#include "SimdKernels.h"
+
+#if defined(SIMD_X86)
+#include <immintrin.h>
+
+#define AVX2_FN DSP_SIMD_TARGET("avx2")
+
+namespace dsp::simd::kernels_impl
+{
+    namespace
+    {
+        AVX2_FN void abs_inplace(float *buffer, size_t size)
+        {
+            const size_t simd_width = 8;
+            const size_t simd_count = size / simd_width;
+            const size_t simd_end = simd_count * simd_width;
+
+            // Sign bit mask (0x7FFFFFFF for each float)
+            const __m256 sign_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+
+            for (size_t i = 0; i < simd_end; i += simd_width)
+            {
+                __m256 values = _mm256_loadu_ps(&buffer[i]);
+                values = _mm256_and_ps(values, sign_mask); // Clear sign bit
+                _mm256_storeu_ps(&buffer[i], values);
+            }
+
+            // Handle remainder
+            for (size_t i = simd_end; i < size; ++i)
+            {
+                buffer[i] = std::fabs(buffer[i]);
+            }
+        }
+
+        AVX2_FN void max_zero_inplace(float *buffer, size_t size)
+        {
+            const size_t simd_width = 8;
+            const size_t simd_count = size / simd_width;
+            const size_t simd_end = simd_count * simd_width;
+
+            const __m256 zero = _mm256_setzero_ps();
+
+            for (size_t i = 0; i < simd_end; i += simd_width)
+            {
+                __m256 values = _mm256_loadu_ps(&buffer[i]);
+                values = _mm256_max_ps(values, zero);
+                _mm256_storeu_ps(&buffer[i], values);
+            }
+
+            for (size_t i = simd_end; i < size; ++i)
+            {
+                buffer[i] = std::max(0.0f, buffer[i]);
+            }
+        }
+
+        AVX2_FN inline double horizontal_sum(__m256d acc)
+        {
+            __m128d sum_high = _mm256_extractf128_pd(acc, 1);
+            __m128d sum_low = _mm256_castpd256_pd128(acc);
+            __m128d sum128 = _mm_add_pd(sum_low, sum_high);
+
+            double result[2];
+            _mm_storeu_pd(result, sum128);
+            return result[0] + result[1];
+        }
+
+        AVX2_FN double sum(const float *buffer, size_t size)
+        {
+            const size_t simd_width = 8;
+            const size_t simd_count = size / simd_width;
+            const size_t simd_end = simd_count * simd_width;
+
+            __m256d acc1 = _mm256_setzero_pd();
+            __m256d acc2 = _mm256_setzero_pd();
+
+            for (size_t i = 0; i < simd_end; i += simd_width)
+            {
+                // Load 8 floats
+                __m256 values = _mm256_loadu_ps(&buffer[i]);
+
+                // Convert to two groups of 4 doubles for precision
+                __m128 lo = _mm256_castps256_ps128(values);
+                __m128 hi = _mm256_extractf128_ps(values, 1);
+
+                acc1 = _mm256_add_pd(acc1, _mm256_cvtps_pd(lo));
+                acc2 = _mm256_add_pd(acc2, _mm256_cvtps_pd(hi));
+            }
+
+            double total = horizontal_sum(_mm256_add_pd(acc1, acc2));
+
+            // Handle remainder
+            for (size_t i = simd_end; i < size; ++i)
+            {
+                total += static_cast<double>(buffer[i]);
+            }
+
+            return total;
+        }
+
+        AVX2_FN double sum_of_squares(const float *buffer, size_t size)
+        {
+            const size_t simd_width = 8;
+            const size_t simd_count = size / simd_width;
+            const size_t simd_end = simd_count * simd_width;
+
+            __m256d acc1 = _mm256_setzero_pd();
+            __m256d acc2 = _mm256_setzero_pd();
+
+            for (size_t i = 0; i < simd_end; i += simd_width)
+            {
+                __m256 values = _mm256_loadu_ps(&buffer[i]);
+
+                // Square the values
+                __m256 squares = _mm256_mul_ps(values, values);
+
+                // Convert to doubles for precision accumulation
+                __m128 lo = _mm256_castps256_ps128(squares);
+                __m128 hi = _mm256_extractf128_ps(squares, 1);
+
+                acc1 = _mm256_add_pd(acc1, _mm256_cvtps_pd(lo));
+                acc2 = _mm256_add_pd(acc2, _mm256_cvtps_pd(hi));
+            }
+
+            double total = horizontal_sum(_mm256_add_pd(acc1, acc2));
+
+            // Handle remainder
+            for (size_t i = simd_end; i < size; ++i)
+            {
+                double val = static_cast<double>(buffer[i]);
+                total += val * val;
+            }
+
+            return total;
+        }
+
+        AVX2_FN void apply_window(const float *input, const float *window, float *output, size_t size)
+        {
+            const size_t simd_width = 8;
+            const size_t simd_count = size / simd_width;
+            const size_t simd_end = simd_count * simd_width;
+
+            for (size_t i = 0; i < simd_end; i += simd_width)
+            {
+                __m256 in = _mm256_loadu_ps(&input[i]);
+                __m256 win = _mm256_loadu_ps(&window[i]);
+                __m256 result = _mm256_mul_ps(in, win);
+                _mm256_storeu_ps(&output[i], result);
+            }
+
+            // Handle remainder
+            for (size_t i = simd_end; i < size; ++i)
+            {
+                output[i] = input[i] * window[i];
+            }
+        }
+
+        AVX2_FN void complex_magnitude(const float *real, const float *imag, float *magnitude, size_t size)
+        {
+            const size_t simd_width = 8;
+            const size_t simd_count = size / simd_width;
+            const size_t simd_end = simd_count * simd_width;
+
+            for (size_t i = 0; i < simd_end; i += simd_width)
+            {
+                __m256 re = _mm256_loadu_ps(&real[i]);
+                __m256 im = _mm256_loadu_ps(&imag[i]);
+
+                // mag² = re² + im²
+                __m256 re_sq = _mm256_mul_ps(re, re);
+                __m256 im_sq = _mm256_mul_ps(im, im);
+                __m256 mag_sq = _mm256_add_ps(re_sq, im_sq);
+
+                // mag = sqrt(mag²)
+                __m256 mag = _mm256_sqrt_ps(mag_sq);
+
+                _mm256_storeu_ps(&magnitude[i], mag);
+            }
+
+            for (size_t i = simd_end; i < size; ++i)
+            {
+                magnitude[i] = std::sqrt(real[i] * real[i] + imag[i] * imag[i]);
+            }
+        }
+
+        AVX2_FN void complex_power(const float *real, const float *imag, float *power, size_t size)
+        {
+            const size_t simd_width = 8;
+            const size_t simd_count = size / simd_width;
+            const size_t simd_end = simd_count * simd_width;
+
+            for (size_t i = 0; i < simd_end; i += simd_width)
+            {
+                __m256 re = _mm256_loadu_ps(&real[i]);
+                __m256 im = _mm256_loadu_ps(&imag[i]);
+
+                __m256 re_sq = _mm256_mul_ps(re, re);
+                __m256 im_sq = _mm256_mul_ps(im, im);
+                __m256 pwr = _mm256_add_ps(re_sq, im_sq);
+
+                _mm256_storeu_ps(&power[i], pwr);
+            }
+
+            for (size_t i = simd_end; i < size; ++i)
+            {
+                power[i] = real[i] * real[i] + imag[i] * imag[i];
+            }
+        }
+
+        AVX2_FN float dot_product(const float *a, const float *b, size_t size)
+        {
+            const size_t simd_width = 8;
+            const size_t simd_count = size / simd_width;
+            const size_t simd_end = simd_count * simd_width;
+
+            __m256 acc = _mm256_setzero_ps();
+
+            for (size_t i = 0; i < simd_end; i += simd_width)
+            {
+                __m256 va = _mm256_loadu_ps(&a[i]);
+                __m256 vb = _mm256_loadu_ps(&b[i]);
+                __m256 prod = _mm256_mul_ps(va, vb);
+                acc = _mm256_add_ps(acc, prod);
+            }
+
+            // Horizontal sum of the accumulator
+            __m128 hi = _mm256_extractf128_ps(acc, 1);
+            __m128 lo = _mm256_castps256_ps128(acc);
+            __m128 sum128 = _mm_add_ps(lo, hi);
+
+            // Reduce 4 floats to 1
+            sum128 = _mm_hadd_ps(sum128, sum128);
+            sum128 = _mm_hadd_ps(sum128, sum128);
+
+            float result = _mm_cvtss_f32(sum128);
+
+            // Handle remainder
+            for (size_t i = simd_end; i < size; ++i)
+            {
+                result += a[i] * b[i];
+            }
+
+            return result;
+        }
+
+        AVX2_FN void complex_multiply(const float *a_real, const float *a_imag,
+                                      const float *b_real, const float *b_imag,
+                                      float *out_real, float *out_imag, size_t size)
+        {
+            const size_t simd_width = 8;
+            const size_t simd_count = size / simd_width;
+            const size_t simd_end = simd_count * simd_width;
+
+            for (size_t i = 0; i < simd_end; i += simd_width)
+            {
+                __m256 ar = _mm256_loadu_ps(&a_real[i]);
+                __m256 ai = _mm256_loadu_ps(&a_imag[i]);
+                __m256 br = _mm256_loadu_ps(&b_real[i]);
+                __m256 bi = _mm256_loadu_ps(&b_imag[i]);
+
+                // (a + bi) * (c + di) = (ac - bd) + (ad + bc)i
+                __m256 ac = _mm256_mul_ps(ar, br);
+                __m256 bd = _mm256_mul_ps(ai, bi);
+                __m256 ad = _mm256_mul_ps(ar, bi);
+                __m256 bc = _mm256_mul_ps(ai, br);
+
+                __m256 real = _mm256_sub_ps(ac, bd);
+                __m256 imag = _mm256_add_ps(ad, bc);
+
+                _mm256_storeu_ps(&out_real[i], real);
+                _mm256_storeu_ps(&out_imag[i], imag);
+            }
+
+            for (size_t i = simd_end; i < size; ++i)
+            {
+                float ar = a_real[i], ai = a_imag[i];
+                float br = b_real[i], bi = b_imag[i];
+                out_real[i] = ar * br - ai * bi;
+                out_imag[i] = ar * bi + ai * br;
+            }
+        }
+
+        // ========== FFT butterflies ==========
+
+        AVX2_FN inline __m128 sse_complex_mul(__m128 a, __m128 b)
+        {
+            __m128 a_real = _mm_moveldup_ps(a);             // [ar1, ar1, ar2, ar2]
+            __m128 a_imag = _mm_movehdup_ps(a);             // [ai1, ai1, ai2, ai2]
+            __m128 b_shuffled = _mm_shuffle_ps(b, b, 0xB1); // [bi1, br1, bi2, br2]
+            __m128 mult1 = _mm_mul_ps(a_real, b);
+            __m128 mult2 = _mm_mul_ps(a_imag, b_shuffled);
+            return _mm_addsub_ps(mult1, mult2); // [r1, i1, r2, i2]
+        }
+
+        AVX2_FN inline __m256 avx_complex_mul(__m256 a, __m256 b)
+        {
+            __m256 a_real = _mm256_moveldup_ps(a);
+            __m256 a_imag = _mm256_movehdup_ps(a);
+            __m256 b_shuffled = _mm256_shuffle_ps(b, b, 0xB1);
+            __m256 mult1 = _mm256_mul_ps(a_real, b);
+            __m256 mult2 = _mm256_mul_ps(a_imag, b_shuffled);
+            return _mm256_addsub_ps(mult1, mult2);
+        }
+
+        AVX2_FN inline __m256d avx_complex_mul_double(__m256d a, __m256d b)
+        {
+            __m256d a_real = _mm256_permute_pd(a, 0x0);
+            __m256d a_imag = _mm256_permute_pd(a, 0xF);
+            __m256d b_shuffled = _mm256_permute_pd(b, 0x5);
+            __m256d mult1 = _mm256_mul_pd(a_real, b);
+            __m256d mult2 = _mm256_mul_pd(a_imag, b_shuffled);
+            return _mm256_addsub_pd(mult1, mult2);
+        }
+
+        AVX2_FN void fft_radix2_stage(float *data, size_t size, size_t halfLen,
+                                      const float *twiddles, size_t twiddleStep, bool inverse)
+        {
+            // Conjugate twiddle factors for the inverse FFT
+            const __m256 conj_mask = _mm256_setr_ps(1.0f, -1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f, -1.0f);
+            const __m128 sse_conj_mask = _mm_setr_ps(1.0f, -1.0f, 1.0f, -1.0f);
+            const size_t s = twiddleStep;
+
+            for (size_t i = 0; i < size; i += 2 * halfLen)
+            {
+                float *block = data + 2 * i;
+                size_t j = 0;
+                size_t k = 0;
+
+                // 4 butterflies per iteration
+                for (; j + 3 < halfLen; j += 4)
+                {
+                    const float *tw0 = twiddles + 2 * k;
+                    __m256 tw = _mm256_setr_ps(tw0[0], tw0[1],
+                                               tw0[2 * s], tw0[2 * s + 1],
+                                               tw0[4 * s], tw0[4 * s + 1],
+                                               tw0[6 * s], tw0[6 * s + 1]);
+                    if (inverse)
+                    {
+                        tw = _mm256_mul_ps(tw, conj_mask);
+                    }
+
+                    __m256 a = _mm256_loadu_ps(block + 2 * j);
+                    __m256 b = _mm256_loadu_ps(block + 2 * (j + halfLen));
+                    __m256 temp = avx_complex_mul(b, tw);
+                    _mm256_storeu_ps(block + 2 * (j + halfLen), _mm256_sub_ps(a, temp));
+                    _mm256_storeu_ps(block + 2 * j, _mm256_add_ps(a, temp));
+                    k += 4 * s;
+                }
+
+                // 2 butterflies (the halfLen == 2 stage)
+                for (; j + 1 < halfLen; j += 2)
+                {
+                    const float *tw0 = twiddles + 2 * k;
+                    __m128 tw = _mm_setr_ps(tw0[0], tw0[1], tw0[2 * s], tw0[2 * s + 1]);
+                    if (inverse)
+                    {
+                        tw = _mm_mul_ps(tw, sse_conj_mask);
+                    }
+
+                    __m128 a = _mm_loadu_ps(block + 2 * j);
+                    __m128 b = _mm_loadu_ps(block + 2 * (j + halfLen));
+                    __m128 temp = sse_complex_mul(b, tw);
+                    _mm_storeu_ps(block + 2 * (j + halfLen), _mm_sub_ps(a, temp));
+                    _mm_storeu_ps(block + 2 * j, _mm_add_ps(a, temp));
+                    k += 2 * s;
+                }
+
+                radix2Butterflies(block, j, halfLen, twiddles, k, twiddleStep, inverse);
+            }
+        }
+
+        AVX2_FN void fft_radix2_stage_double(double *data, size_t size, size_t halfLen,
+                                             const double *twiddles, size_t twiddleStep, bool inverse)
+        {
+            const __m256d conj_mask = _mm256_setr_pd(1.0, -1.0, 1.0, -1.0);
+            const size_t s = twiddleStep;
+
+            for (size_t i = 0; i < size; i += 2 * halfLen)
+            {
+                double *block = data + 2 * i;
+                size_t j = 0;
+                size_t k = 0;
+
+                // 2 butterflies per iteration
+                for (; j + 1 < halfLen; j += 2)
+                {
+                    const double *tw0 = twiddles + 2 * k;
+                    __m256d tw = _mm256_setr_pd(tw0[0], tw0[1], tw0[2 * s], tw0[2 * s + 1]);
+                    if (inverse)
+                    {
+                        tw = _mm256_mul_pd(tw, conj_mask);
+                    }
+
+                    __m256d a = _mm256_loadu_pd(block + 2 * j);
+                    __m256d b = _mm256_loadu_pd(block + 2 * (j + halfLen));
+                    __m256d temp = avx_complex_mul_double(b, tw);
+                    _mm256_storeu_pd(block + 2 * (j + halfLen), _mm256_sub_pd(a, temp));
+                    _mm256_storeu_pd(block + 2 * j, _mm256_add_pd(a, temp));
+                    k += 2 * s;
+                }
+
+                radix2Butterflies(block, j, halfLen, twiddles, k, twiddleStep, inverse);
+            }
+        }
+
+        // Lock-step sliding windows: the shared loop, vectorized for this target
+        AVX2_FN void window_frames(const WindowFrames &run)
+        {
+            windowFrames(run);
+        }
+
+        // Prefix-sum moving statistics: the shared loop, vectorized for this target
+        AVX2_FN void window_block(const WindowBlock &run)
+        {
+            windowBlock(run);
+        }
+
+        // Blocked mixing-matrix GEMM: the shared loop, vectorized for this target
+        AVX2_FN void mix_frames(const MixFrames &run)
+        {
+            mixFrames(run);
+        }
+
+        AVX2_FN void scaled_add(float *target, const float *source, float scale, size_t size)
+        {
+            const __m256 factor = _mm256_set1_ps(scale);
+
+            size_t i = 0;
+            for (; i + 8 <= size; i += 8)
+            {
+                __m256 t = _mm256_loadu_ps(&target[i]);
+                __m256 s = _mm256_loadu_ps(&source[i]);
+                _mm256_storeu_ps(&target[i], _mm256_add_ps(t, _mm256_mul_ps(factor, s)));
+            }
+            for (; i < size; ++i)
+            {
+                target[i] += scale * source[i];
+            }
+        }
+
+        // Bank of Kalman filters, one per lane: the shared loops, vectorized for this target
+        AVX2_FN void kalman_frames(const KalmanFrames &run)
+        {
+            kalmanFrames(run);
+        }
+
+        const KernelTable kTable = {
+            SimdLevel::Avx2,
+            abs_inplace,
+            max_zero_inplace,
+            sum,
+            sum_of_squares,
+            apply_window,
+            complex_magnitude,
+            complex_power,
+            dot_product,
+            complex_multiply,
+            fft_radix2_stage,
+            fft_radix2_stage_double,
+            window_frames,
+            window_block,
+            mix_frames,
+            scaled_add,
+            kalman_frames,
+        };
+    }
+
+    const KernelTable *avx2Kernels() noexcept
+    {
+        return &kTable;
+    }
+
+} // namespace dsp::simd::kernels_impl
+
+#else
+
+namespace dsp::simd::kernels_impl
+{
+    const KernelTable *avx2Kernels() noexcept
+    {
+        return nullptr;
+    }
+}
+
+#endif // SIMD_X86
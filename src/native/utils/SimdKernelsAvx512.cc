@@ -0,0 +1,477 @@
+/**
+ * AVX-512F kernels (16 floats / 8 doubles per vector). Remainders are
+ * handled with masked loads and stores instead of scalar loops, so every
+ * element goes through the same instructions. FFT stages with fewer than
+ * a vector's worth of butterflies per block pack several blocks into one
+ * vector instead. Only AVX-512 Foundation is used (no DQ/BW/VL), which
+ * every AVX-512 CPU implements.
+ */
+
+#include "SimdKernels.h"
+
+#if defined(SIMD_X86)
+#include <immintrin.h>
+
+#if defined(__GNUC__) && !defined(__clang__)
+// GCC 12 flags the _mm*_undefined_*() placeholders inside its own AVX-512
+// intrinsics (GCC PR 105593)
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+#define AVX512_FN DSP_SIMD_TARGET("avx512f")
+
+namespace dsp::simd::kernels_impl
+{
+    namespace
+    {
+        constexpr size_t kWidth = 16;
+
+        // Lanes [0, count) of a 16-lane mask, count <= 16
+        AVX512_FN inline __mmask16 tailMask(size_t count)
+        {
+            return static_cast<__mmask16>((1u << count) - 1u);
+        }
+
+        AVX512_FN void abs_inplace(float *buffer, size_t size)
+        {
+            size_t i = 0;
+            for (; i + kWidth <= size; i += kWidth)
+            {
+                _mm512_storeu_ps(&buffer[i], _mm512_abs_ps(_mm512_loadu_ps(&buffer[i])));
+            }
+            if (i < size)
+            {
+                const __mmask16 m = tailMask(size - i);
+                _mm512_mask_storeu_ps(&buffer[i], m, _mm512_abs_ps(_mm512_maskz_loadu_ps(m, &buffer[i])));
+            }
+        }
+
+        AVX512_FN void max_zero_inplace(float *buffer, size_t size)
+        {
+            const __m512 zero = _mm512_setzero_ps();
+
+            size_t i = 0;
+            for (; i + kWidth <= size; i += kWidth)
+            {
+                _mm512_storeu_ps(&buffer[i], _mm512_max_ps(_mm512_loadu_ps(&buffer[i]), zero));
+            }
+            if (i < size)
+            {
+                const __mmask16 m = tailMask(size - i);
+                _mm512_mask_storeu_ps(&buffer[i], m, _mm512_max_ps(_mm512_maskz_loadu_ps(m, &buffer[i]), zero));
+            }
+        }
+
+        // Widens 16 floats to two vectors of 8 doubles and adds them to acc1/acc2
+        AVX512_FN inline void accumulate_double(__m512 values, __m512d &acc1, __m512d &acc2)
+        {
+            __m256 lo = _mm512_castps512_ps256(values);
+            __m256 hi = _mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(values), 1));
+            acc1 = _mm512_add_pd(acc1, _mm512_cvtps_pd(lo));
+            acc2 = _mm512_add_pd(acc2, _mm512_cvtps_pd(hi));
+        }
+
+        AVX512_FN double sum(const float *buffer, size_t size)
+        {
+            __m512d acc1 = _mm512_setzero_pd();
+            __m512d acc2 = _mm512_setzero_pd();
+
+            size_t i = 0;
+            for (; i + kWidth <= size; i += kWidth)
+            {
+                accumulate_double(_mm512_loadu_ps(&buffer[i]), acc1, acc2);
+            }
+            if (i < size)
+            {
+                // Masked-off lanes load as 0.0f and add nothing
+                accumulate_double(_mm512_maskz_loadu_ps(tailMask(size - i), &buffer[i]), acc1, acc2);
+            }
+
+            return _mm512_reduce_add_pd(_mm512_add_pd(acc1, acc2));
+        }
+
+        AVX512_FN double sum_of_squares(const float *buffer, size_t size)
+        {
+            __m512d acc1 = _mm512_setzero_pd();
+            __m512d acc2 = _mm512_setzero_pd();
+
+            size_t i = 0;
+            for (; i + kWidth <= size; i += kWidth)
+            {
+                __m512 values = _mm512_loadu_ps(&buffer[i]);
+                accumulate_double(_mm512_mul_ps(values, values), acc1, acc2);
+            }
+            if (i < size)
+            {
+                __m512 values = _mm512_maskz_loadu_ps(tailMask(size - i), &buffer[i]);
+                accumulate_double(_mm512_mul_ps(values, values), acc1, acc2);
+            }
+
+            return _mm512_reduce_add_pd(_mm512_add_pd(acc1, acc2));
+        }
+
+        AVX512_FN void apply_window(const float *input, const float *window, float *output, size_t size)
+        {
+            size_t i = 0;
+            for (; i + kWidth <= size; i += kWidth)
+            {
+                __m512 result = _mm512_mul_ps(_mm512_loadu_ps(&input[i]), _mm512_loadu_ps(&window[i]));
+                _mm512_storeu_ps(&output[i], result);
+            }
+            if (i < size)
+            {
+                const __mmask16 m = tailMask(size - i);
+                __m512 result = _mm512_mul_ps(_mm512_maskz_loadu_ps(m, &input[i]),
+                                              _mm512_maskz_loadu_ps(m, &window[i]));
+                _mm512_mask_storeu_ps(&output[i], m, result);
+            }
+        }
+
+        AVX512_FN inline __m512 power_of(__m512 re, __m512 im)
+        {
+            return _mm512_add_ps(_mm512_mul_ps(re, re), _mm512_mul_ps(im, im));
+        }
+
+        AVX512_FN void complex_magnitude(const float *real, const float *imag, float *magnitude, size_t size)
+        {
+            size_t i = 0;
+            for (; i + kWidth <= size; i += kWidth)
+            {
+                __m512 mag_sq = power_of(_mm512_loadu_ps(&real[i]), _mm512_loadu_ps(&imag[i]));
+                _mm512_storeu_ps(&magnitude[i], _mm512_sqrt_ps(mag_sq));
+            }
+            if (i < size)
+            {
+                const __mmask16 m = tailMask(size - i);
+                __m512 mag_sq = power_of(_mm512_maskz_loadu_ps(m, &real[i]), _mm512_maskz_loadu_ps(m, &imag[i]));
+                _mm512_mask_storeu_ps(&magnitude[i], m, _mm512_sqrt_ps(mag_sq));
+            }
+        }
+
+        AVX512_FN void complex_power(const float *real, const float *imag, float *power, size_t size)
+        {
+            size_t i = 0;
+            for (; i + kWidth <= size; i += kWidth)
+            {
+                _mm512_storeu_ps(&power[i], power_of(_mm512_loadu_ps(&real[i]), _mm512_loadu_ps(&imag[i])));
+            }
+            if (i < size)
+            {
+                const __mmask16 m = tailMask(size - i);
+                __m512 pwr = power_of(_mm512_maskz_loadu_ps(m, &real[i]), _mm512_maskz_loadu_ps(m, &imag[i]));
+                _mm512_mask_storeu_ps(&power[i], m, pwr);
+            }
+        }
+
+        AVX512_FN float dot_product(const float *a, const float *b, size_t size)
+        {
+            __m512 acc = _mm512_setzero_ps();
+
+            size_t i = 0;
+            for (; i + kWidth <= size; i += kWidth)
+            {
+                acc = _mm512_fmadd_ps(_mm512_loadu_ps(&a[i]), _mm512_loadu_ps(&b[i]), acc);
+            }
+            if (i < size)
+            {
+                const __mmask16 m = tailMask(size - i);
+                acc = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, &a[i]), _mm512_maskz_loadu_ps(m, &b[i]), acc);
+            }
+
+            return _mm512_reduce_add_ps(acc);
+        }
+
+        // (a + bi) * (c + di) = (ac - bd) + (ad + bc)i
+        AVX512_FN inline void complex_product(__m512 ar, __m512 ai, __m512 br, __m512 bi,
+                                              __m512 &real, __m512 &imag)
+        {
+            real = _mm512_sub_ps(_mm512_mul_ps(ar, br), _mm512_mul_ps(ai, bi));
+            imag = _mm512_add_ps(_mm512_mul_ps(ar, bi), _mm512_mul_ps(ai, br));
+        }
+
+        AVX512_FN void complex_multiply(const float *a_real, const float *a_imag,
+                                        const float *b_real, const float *b_imag,
+                                        float *out_real, float *out_imag, size_t size)
+        {
+            __m512 real, imag;
+
+            size_t i = 0;
+            for (; i + kWidth <= size; i += kWidth)
+            {
+                complex_product(_mm512_loadu_ps(&a_real[i]), _mm512_loadu_ps(&a_imag[i]),
+                                _mm512_loadu_ps(&b_real[i]), _mm512_loadu_ps(&b_imag[i]), real, imag);
+                _mm512_storeu_ps(&out_real[i], real);
+                _mm512_storeu_ps(&out_imag[i], imag);
+            }
+            if (i < size)
+            {
+                const __mmask16 m = tailMask(size - i);
+                complex_product(_mm512_maskz_loadu_ps(m, &a_real[i]), _mm512_maskz_loadu_ps(m, &a_imag[i]),
+                                _mm512_maskz_loadu_ps(m, &b_real[i]), _mm512_maskz_loadu_ps(m, &b_imag[i]),
+                                real, imag);
+                _mm512_mask_storeu_ps(&out_real[i], m, real);
+                _mm512_mask_storeu_ps(&out_imag[i], m, imag);
+            }
+        }
+
+        // ========== FFT butterflies ==========
+
+        // b * tw for 8 interleaved complex floats
+        AVX512_FN inline __m512 complex_mul(__m512 b, __m512 tw)
+        {
+            __m512 b_real = _mm512_moveldup_ps(b);
+            __m512 b_imag = _mm512_movehdup_ps(b);
+            __m512 tw_swapped = _mm512_permute_ps(tw, 0xB1);
+            // Even lanes: re*wr - im*wi, odd lanes: re*wi + im*wr
+            return _mm512_fmaddsub_ps(b_real, tw, _mm512_mul_ps(b_imag, tw_swapped));
+        }
+
+        // b * tw for 4 interleaved complex doubles
+        AVX512_FN inline __m512d complex_mul_double(__m512d b, __m512d tw)
+        {
+            __m512d b_real = _mm512_permute_pd(b, 0x00);
+            __m512d b_imag = _mm512_permute_pd(b, 0xFF);
+            __m512d tw_swapped = _mm512_permute_pd(tw, 0x55);
+            return _mm512_fmaddsub_pd(b_real, tw, _mm512_mul_pd(b_imag, tw_swapped));
+        }
+
+        /**
+         * Per-lane multipliers for a stage with fewer butterflies per block
+         * than a vector holds: the lanes of each block's `a` half get 1 + 0i,
+         * the lanes of its `b` half get that butterfly's twiddle. `lanes` is
+         * the number of complex values per vector.
+         */
+        template <typename T>
+        inline void smallStageTwiddles(T *out, size_t lanes, size_t halfLen,
+                                       const T *twiddles, size_t twiddleStep, bool inverse)
+        {
+            for (size_t c = 0; c < lanes; ++c)
+            {
+                const size_t pos = c % (2 * halfLen);
+                if (pos < halfLen)
+                {
+                    out[2 * c] = T(1);
+                    out[2 * c + 1] = T(0);
+                    continue;
+                }
+                const T *w = twiddles + 2 * (pos - halfLen) * twiddleStep;
+                out[2 * c] = w[0];
+                out[2 * c + 1] = inverse ? -w[1] : w[1];
+            }
+        }
+
+        AVX512_FN void fft_radix2_stage(float *data, size_t size, size_t halfLen,
+                                        const float *twiddles, size_t twiddleStep, bool inverse)
+        {
+            const size_t s = twiddleStep;
+
+            if (halfLen < 8)
+            {
+                if (size < 8)
+                {
+                    for (size_t i = 0; i < size; i += 2 * halfLen)
+                    {
+                        radix2Butterflies(data + 2 * i, 0, halfLen, twiddles, 0, twiddleStep, inverse);
+                    }
+                    return;
+                }
+
+                // One vector spans 8 / (2 * halfLen) whole blocks. Multiply
+                // every b by its twiddle (every a by 1), swap the halves of
+                // each block, then a + b*w lands in the a lanes and a - b*w
+                // (swapped minus original) in the b lanes.
+                alignas(64) float tw_data[16];
+                smallStageTwiddles(tw_data, 8, halfLen, twiddles, twiddleStep, inverse);
+                const __m512 tw = _mm512_load_ps(tw_data);
+                const __mmask16 b_lanes = halfLen == 1   ? static_cast<__mmask16>(0xCCCC)
+                                          : halfLen == 2 ? static_cast<__mmask16>(0xF0F0)
+                                                         : static_cast<__mmask16>(0xFF00);
+
+                for (size_t i = 0; i < size; i += 8)
+                {
+                    float *chunk = data + 2 * i;
+                    __m512 t = complex_mul(_mm512_loadu_ps(chunk), tw);
+                    __m512 swapped = halfLen == 1   ? _mm512_permute_ps(t, _MM_SHUFFLE(1, 0, 3, 2))
+                                     : halfLen == 2 ? _mm512_shuffle_f32x4(t, t, _MM_SHUFFLE(2, 3, 0, 1))
+                                                    : _mm512_shuffle_f32x4(t, t, _MM_SHUFFLE(1, 0, 3, 2));
+                    _mm512_storeu_ps(chunk, _mm512_mask_sub_ps(_mm512_add_ps(t, swapped), b_lanes, swapped, t));
+                }
+                return;
+            }
+
+            // halfLen is a power of two >= 8: whole vectors, no remainder
+            const __m512 conj_mask = _mm512_setr_ps(1.0f, -1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f, -1.0f,
+                                                    1.0f, -1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f, -1.0f);
+            for (size_t i = 0; i < size; i += 2 * halfLen)
+            {
+                float *block = data + 2 * i;
+                size_t k = 0;
+
+                for (size_t j = 0; j < halfLen; j += 8)
+                {
+                    const float *tw0 = twiddles + 2 * k;
+                    __m512 tw = s == 1
+                                    ? _mm512_loadu_ps(tw0)
+                                    : _mm512_setr_ps(tw0[0], tw0[1], tw0[2 * s], tw0[2 * s + 1],
+                                                     tw0[4 * s], tw0[4 * s + 1], tw0[6 * s], tw0[6 * s + 1],
+                                                     tw0[8 * s], tw0[8 * s + 1], tw0[10 * s], tw0[10 * s + 1],
+                                                     tw0[12 * s], tw0[12 * s + 1], tw0[14 * s], tw0[14 * s + 1]);
+                    if (inverse)
+                    {
+                        tw = _mm512_mul_ps(tw, conj_mask);
+                    }
+
+                    __m512 a = _mm512_loadu_ps(block + 2 * j);
+                    __m512 b = _mm512_loadu_ps(block + 2 * (j + halfLen));
+                    __m512 temp = complex_mul(b, tw);
+                    _mm512_storeu_ps(block + 2 * (j + halfLen), _mm512_sub_ps(a, temp));
+                    _mm512_storeu_ps(block + 2 * j, _mm512_add_ps(a, temp));
+                    k += 8 * s;
+                }
+            }
+        }
+
+        AVX512_FN void fft_radix2_stage_double(double *data, size_t size, size_t halfLen,
+                                               const double *twiddles, size_t twiddleStep, bool inverse)
+        {
+            const size_t s = twiddleStep;
+
+            if (halfLen < 4)
+            {
+                if (size < 4)
+                {
+                    for (size_t i = 0; i < size; i += 2 * halfLen)
+                    {
+                        radix2Butterflies(data + 2 * i, 0, halfLen, twiddles, 0, twiddleStep, inverse);
+                    }
+                    return;
+                }
+
+                // Same half swap as the float stage, 4 complex per vector
+                alignas(64) double tw_data[8];
+                smallStageTwiddles(tw_data, 4, halfLen, twiddles, twiddleStep, inverse);
+                const __m512d tw = _mm512_load_pd(tw_data);
+                const __mmask8 b_lanes = halfLen == 1 ? static_cast<__mmask8>(0xCC) : static_cast<__mmask8>(0xF0);
+
+                for (size_t i = 0; i < size; i += 4)
+                {
+                    double *chunk = data + 2 * i;
+                    __m512d t = complex_mul_double(_mm512_loadu_pd(chunk), tw);
+                    __m512d swapped = halfLen == 1 ? _mm512_shuffle_f64x2(t, t, _MM_SHUFFLE(2, 3, 0, 1))
+                                                   : _mm512_shuffle_f64x2(t, t, _MM_SHUFFLE(1, 0, 3, 2));
+                    _mm512_storeu_pd(chunk, _mm512_mask_sub_pd(_mm512_add_pd(t, swapped), b_lanes, swapped, t));
+                }
+                return;
+            }
+
+            const __m512d conj_mask = _mm512_setr_pd(1.0, -1.0, 1.0, -1.0, 1.0, -1.0, 1.0, -1.0);
+            for (size_t i = 0; i < size; i += 2 * halfLen)
+            {
+                double *block = data + 2 * i;
+                size_t k = 0;
+
+                for (size_t j = 0; j < halfLen; j += 4)
+                {
+                    const double *tw0 = twiddles + 2 * k;
+                    __m512d tw = s == 1
+                                     ? _mm512_loadu_pd(tw0)
+                                     : _mm512_setr_pd(tw0[0], tw0[1], tw0[2 * s], tw0[2 * s + 1],
+                                                      tw0[4 * s], tw0[4 * s + 1], tw0[6 * s], tw0[6 * s + 1]);
+                    if (inverse)
+                    {
+                        tw = _mm512_mul_pd(tw, conj_mask);
+                    }
+
+                    __m512d a = _mm512_loadu_pd(block + 2 * j);
+                    __m512d b = _mm512_loadu_pd(block + 2 * (j + halfLen));
+                    __m512d temp = complex_mul_double(b, tw);
+                    _mm512_storeu_pd(block + 2 * (j + halfLen), _mm512_sub_pd(a, temp));
+                    _mm512_storeu_pd(block + 2 * j, _mm512_add_pd(a, temp));
+                    k += 4 * s;
+                }
+            }
+        }
+
+        // Lock-step sliding windows: the shared loop, vectorized for this target
+        AVX512_FN void window_frames(const WindowFrames &run)
+        {
+            windowFrames(run);
+        }
+
+        // Prefix-sum moving statistics: the shared loop, vectorized for this target
+        AVX512_FN void window_block(const WindowBlock &run)
+        {
+            windowBlock(run);
+        }
+
+        // Blocked mixing-matrix GEMM: the shared loop, vectorized for this target
+        AVX512_FN void mix_frames(const MixFrames &run)
+        {
+            mixFrames(run);
+        }
+
+        AVX512_FN void scaled_add(float *target, const float *source, float scale, size_t size)
+        {
+            const __m512 factor = _mm512_set1_ps(scale);
+
+            size_t i = 0;
+            for (; i + kWidth <= size; i += kWidth)
+            {
+                _mm512_storeu_ps(&target[i],
+                                 _mm512_fmadd_ps(factor, _mm512_loadu_ps(&source[i]), _mm512_loadu_ps(&target[i])));
+            }
+            if (i < size)
+            {
+                const __mmask16 m = tailMask(size - i);
+                _mm512_mask_storeu_ps(&target[i], m,
+                                      _mm512_fmadd_ps(factor, _mm512_maskz_loadu_ps(m, &source[i]),
+                                                      _mm512_maskz_loadu_ps(m, &target[i])));
+            }
+        }
+
+        // Bank of Kalman filters, one per lane: the shared loops, vectorized for this target
+        AVX512_FN void kalman_frames(const KalmanFrames &run)
+        {
+            kalmanFrames(run);
+        }
+
+        const KernelTable kTable = {
+            SimdLevel::Avx512,
+            abs_inplace,
+            max_zero_inplace,
+            sum,
+            sum_of_squares,
+            apply_window,
+            complex_magnitude,
+            complex_power,
+            dot_product,
+            complex_multiply,
+            fft_radix2_stage,
+            fft_radix2_stage_double,
+            window_frames,
+            window_block,
+            mix_frames,
+            scaled_add,
+            kalman_frames,
+        };
+    }
+
+    const KernelTable *avx512Kernels() noexcept
+    {
+        return &kTable;
+    }
+
+} // namespace dsp::simd::kernels_impl
+
+#else
+
+namespace dsp::simd::kernels_impl
+{
+    const KernelTable *avx512Kernels() noexcept
+    {
+        return nullptr;
+    }
+}
+
+#endif // SIMD_X86
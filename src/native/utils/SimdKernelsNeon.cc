@@ -0,0 +1,389 @@
+/**
+ * ARM NEON kernels (4 floats per vector). NEON is part of the AArch64
+ * baseline, so nothing here needs a target attribute; the double-precision
+ * accumulations use float64x2 on AArch64 only and stay scalar on ARMv7.
+ */
+
+#include "SimdKernels.h"
+
+#if defined(SIMD_NEON)
+#include <arm_neon.h>
+
+namespace dsp::simd::kernels_impl
+{
+    namespace
+    {
+        void abs_inplace(float *buffer, size_t size)
+        {
+            const size_t simd_width = 4;
+            const size_t simd_count = size / simd_width;
+            const size_t simd_end = simd_count * simd_width;
+
+            for (size_t i = 0; i < simd_end; i += simd_width)
+            {
+                float32x4_t values = vld1q_f32(&buffer[i]);
+                values = vabsq_f32(values);
+                vst1q_f32(&buffer[i], values);
+            }
+
+            for (size_t i = simd_end; i < size; ++i)
+            {
+                buffer[i] = std::fabs(buffer[i]);
+            }
+        }
+
+        void max_zero_inplace(float *buffer, size_t size)
+        {
+            const size_t simd_width = 4;
+            const size_t simd_count = size / simd_width;
+            const size_t simd_end = simd_count * simd_width;
+
+            const float32x4_t zero = vdupq_n_f32(0.0f);
+
+            for (size_t i = 0; i < simd_end; i += simd_width)
+            {
+                float32x4_t values = vld1q_f32(&buffer[i]);
+                values = vmaxq_f32(values, zero);
+                vst1q_f32(&buffer[i], values);
+            }
+
+            for (size_t i = simd_end; i < size; ++i)
+            {
+                buffer[i] = std::max(0.0f, buffer[i]);
+            }
+        }
+
+        double sum(const float *buffer, size_t size)
+        {
+            size_t simd_end = 0;
+            double total = 0.0;
+
+#if defined(__aarch64__)
+            const size_t simd_width = 4;
+            simd_end = (size / simd_width) * simd_width;
+
+            float64x2_t acc1 = vdupq_n_f64(0.0);
+            float64x2_t acc2 = vdupq_n_f64(0.0);
+
+            for (size_t i = 0; i < simd_end; i += simd_width)
+            {
+                float32x4_t values = vld1q_f32(&buffer[i]);
+
+                // Convert to doubles for precision
+                acc1 = vaddq_f64(acc1, vcvt_f64_f32(vget_low_f32(values)));
+                acc2 = vaddq_f64(acc2, vcvt_high_f64_f32(values));
+            }
+
+            total = vaddvq_f64(vaddq_f64(acc1, acc2));
+#endif
+
+            for (size_t i = simd_end; i < size; ++i)
+            {
+                total += static_cast<double>(buffer[i]);
+            }
+
+            return total;
+        }
+
+        double sum_of_squares(const float *buffer, size_t size)
+        {
+            size_t simd_end = 0;
+            double total = 0.0;
+
+#if defined(__aarch64__)
+            const size_t simd_width = 4;
+            simd_end = (size / simd_width) * simd_width;
+
+            float64x2_t acc1 = vdupq_n_f64(0.0);
+            float64x2_t acc2 = vdupq_n_f64(0.0);
+
+            for (size_t i = 0; i < simd_end; i += simd_width)
+            {
+                float32x4_t values = vld1q_f32(&buffer[i]);
+                float32x4_t squares = vmulq_f32(values, values);
+
+                acc1 = vaddq_f64(acc1, vcvt_f64_f32(vget_low_f32(squares)));
+                acc2 = vaddq_f64(acc2, vcvt_high_f64_f32(squares));
+            }
+
+            total = vaddvq_f64(vaddq_f64(acc1, acc2));
+#endif
+
+            for (size_t i = simd_end; i < size; ++i)
+            {
+                double val = static_cast<double>(buffer[i]);
+                total += val * val;
+            }
+
+            return total;
+        }
+
+        void apply_window(const float *input, const float *window, float *output, size_t size)
+        {
+            const size_t simd_width = 4;
+            const size_t simd_count = size / simd_width;
+            const size_t simd_end = simd_count * simd_width;
+
+            for (size_t i = 0; i < simd_end; i += simd_width)
+            {
+                float32x4_t in = vld1q_f32(&input[i]);
+                float32x4_t win = vld1q_f32(&window[i]);
+                float32x4_t result = vmulq_f32(in, win);
+                vst1q_f32(&output[i], result);
+            }
+
+            for (size_t i = simd_end; i < size; ++i)
+            {
+                output[i] = input[i] * window[i];
+            }
+        }
+
+        void complex_magnitude(const float *real, const float *imag, float *magnitude, size_t size)
+        {
+            size_t simd_end = 0;
+
+#if defined(__aarch64__)
+            const size_t simd_width = 4;
+            simd_end = (size / simd_width) * simd_width;
+
+            for (size_t i = 0; i < simd_end; i += simd_width)
+            {
+                float32x4_t re = vld1q_f32(&real[i]);
+                float32x4_t im = vld1q_f32(&imag[i]);
+
+                float32x4_t re_sq = vmulq_f32(re, re);
+                float32x4_t im_sq = vmulq_f32(im, im);
+                float32x4_t mag_sq = vaddq_f32(re_sq, im_sq);
+
+                // vsqrtq_f32 is AArch64-only
+                float32x4_t mag = vsqrtq_f32(mag_sq);
+
+                vst1q_f32(&magnitude[i], mag);
+            }
+#endif
+
+            for (size_t i = simd_end; i < size; ++i)
+            {
+                magnitude[i] = std::sqrt(real[i] * real[i] + imag[i] * imag[i]);
+            }
+        }
+
+        void complex_power(const float *real, const float *imag, float *power, size_t size)
+        {
+            const size_t simd_width = 4;
+            const size_t simd_count = size / simd_width;
+            const size_t simd_end = simd_count * simd_width;
+
+            for (size_t i = 0; i < simd_end; i += simd_width)
+            {
+                float32x4_t re = vld1q_f32(&real[i]);
+                float32x4_t im = vld1q_f32(&imag[i]);
+
+                float32x4_t re_sq = vmulq_f32(re, re);
+                float32x4_t im_sq = vmulq_f32(im, im);
+                float32x4_t pwr = vaddq_f32(re_sq, im_sq);
+
+                vst1q_f32(&power[i], pwr);
+            }
+
+            for (size_t i = simd_end; i < size; ++i)
+            {
+                power[i] = real[i] * real[i] + imag[i] * imag[i];
+            }
+        }
+
+        float dot_product(const float *a, const float *b, size_t size)
+        {
+            const size_t simd_width = 4;
+            const size_t simd_count = size / simd_width;
+            const size_t simd_end = simd_count * simd_width;
+
+            float32x4_t acc = vdupq_n_f32(0.0f);
+
+            for (size_t i = 0; i < simd_end; i += simd_width)
+            {
+                float32x4_t va = vld1q_f32(&a[i]);
+                float32x4_t vb = vld1q_f32(&b[i]);
+                acc = vmlaq_f32(acc, va, vb); // Fused multiply-add
+            }
+
+            // Horizontal sum
+            float32x2_t sum2 = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+            float result = vget_lane_f32(vpadd_f32(sum2, sum2), 0);
+
+            for (size_t i = simd_end; i < size; ++i)
+            {
+                result += a[i] * b[i];
+            }
+
+            return result;
+        }
+
+        void complex_multiply(const float *a_real, const float *a_imag,
+                              const float *b_real, const float *b_imag,
+                              float *out_real, float *out_imag, size_t size)
+        {
+            const size_t simd_width = 4;
+            const size_t simd_count = size / simd_width;
+            const size_t simd_end = simd_count * simd_width;
+
+            for (size_t i = 0; i < simd_end; i += simd_width)
+            {
+                float32x4_t ar = vld1q_f32(&a_real[i]);
+                float32x4_t ai = vld1q_f32(&a_imag[i]);
+                float32x4_t br = vld1q_f32(&b_real[i]);
+                float32x4_t bi = vld1q_f32(&b_imag[i]);
+
+                float32x4_t ac = vmulq_f32(ar, br);
+                float32x4_t bd = vmulq_f32(ai, bi);
+                float32x4_t ad = vmulq_f32(ar, bi);
+                float32x4_t bc = vmulq_f32(ai, br);
+
+                float32x4_t real = vsubq_f32(ac, bd);
+                float32x4_t imag = vaddq_f32(ad, bc);
+
+                vst1q_f32(&out_real[i], real);
+                vst1q_f32(&out_imag[i], imag);
+            }
+
+            for (size_t i = simd_end; i < size; ++i)
+            {
+                float ar = a_real[i], ai = a_imag[i];
+                float br = b_real[i], bi = b_imag[i];
+                out_real[i] = ar * br - ai * bi;
+                out_imag[i] = ar * bi + ai * br;
+            }
+        }
+
+        // ========== FFT butterflies ==========
+
+        void fft_radix2_stage(float *data, size_t size, size_t halfLen,
+                              const float *twiddles, size_t twiddleStep, bool inverse)
+        {
+            const float sign_data[4] = {-1.0f, 1.0f, -1.0f, 1.0f};
+            const float conj_data[4] = {1.0f, -1.0f, 1.0f, -1.0f};
+            const float32x4_t sign = vld1q_f32(sign_data);
+            const float32x4_t conj_mask = vld1q_f32(conj_data);
+
+            for (size_t i = 0; i < size; i += 2 * halfLen)
+            {
+                float *block = data + 2 * i;
+                size_t j = 0;
+                size_t k = 0;
+
+                // 2 butterflies per iteration
+                for (; j + 1 < halfLen; j += 2)
+                {
+                    const float *tw0 = twiddles + 2 * k;
+                    const float *tw1 = twiddles + 2 * (k + twiddleStep);
+                    float32x4_t tw = vcombine_f32(vld1_f32(tw0), vld1_f32(tw1));
+                    if (inverse)
+                    {
+                        tw = vmulq_f32(tw, conj_mask);
+                    }
+
+                    float32x4_t a = vld1q_f32(block + 2 * j);
+                    float32x4_t b = vld1q_f32(block + 2 * (j + halfLen));
+
+                    // b * tw = b.re * [wr, wi] + b.im * [-wi, wr]
+                    float32x4x2_t parts = vtrnq_f32(b, b); // [re, re, ...], [im, im, ...]
+                    float32x4_t tw_swapped = vrev64q_f32(tw);
+                    float32x4_t temp = vmlaq_f32(vmulq_f32(parts.val[0], tw),
+                                                 vmulq_f32(parts.val[1], tw_swapped), sign);
+
+                    vst1q_f32(block + 2 * (j + halfLen), vsubq_f32(a, temp));
+                    vst1q_f32(block + 2 * j, vaddq_f32(a, temp));
+                    k += 2 * twiddleStep;
+                }
+
+                radix2Butterflies(block, j, halfLen, twiddles, k, twiddleStep, inverse);
+            }
+        }
+
+        void fft_radix2_stage_double(double *data, size_t size, size_t halfLen,
+                                     const double *twiddles, size_t twiddleStep, bool inverse)
+        {
+            for (size_t i = 0; i < size; i += 2 * halfLen)
+            {
+                radix2Butterflies(data + 2 * i, 0, halfLen, twiddles, 0, twiddleStep, inverse);
+            }
+        }
+
+        // Lock-step sliding windows: the shared loop, vectorized for NEON
+        void window_frames(const WindowFrames &run)
+        {
+            windowFrames(run);
+        }
+
+        // Prefix-sum moving statistics: the shared loop, vectorized for NEON
+        void window_block(const WindowBlock &run)
+        {
+            windowBlock(run);
+        }
+
+        // Blocked mixing-matrix GEMM: the shared loop, vectorized for this target
+        void mix_frames(const MixFrames &run)
+        {
+            mixFrames(run);
+        }
+
+        void scaled_add(float *target, const float *source, float scale, size_t size)
+        {
+            const float32x4_t factor = vdupq_n_f32(scale);
+
+            size_t i = 0;
+            for (; i + 4 <= size; i += 4)
+            {
+                vst1q_f32(&target[i], vmlaq_f32(vld1q_f32(&target[i]), factor, vld1q_f32(&source[i])));
+            }
+            for (; i < size; ++i)
+            {
+                target[i] += scale * source[i];
+            }
+        }
+
+        // Bank of Kalman filters, one per lane: the shared loops, vectorized for this target
+        void kalman_frames(const KalmanFrames &run)
+        {
+            kalmanFrames(run);
+        }
+
+        const KernelTable kTable = {
+            SimdLevel::Neon,
+            abs_inplace,
+            max_zero_inplace,
+            sum,
+            sum_of_squares,
+            apply_window,
+            complex_magnitude,
+            complex_power,
+            dot_product,
+            complex_multiply,
+            fft_radix2_stage,
+            fft_radix2_stage_double,
+            window_frames,
+            window_block,
+            mix_frames,
+            scaled_add,
+            kalman_frames,
+        };
+    }
+
+    const KernelTable *neonKernels() noexcept
+    {
+        return &kTable;
+    }
+
+} // namespace dsp::simd::kernels_impl
+
+#else
+
+namespace dsp::simd::kernels_impl
+{
+    const KernelTable *neonKernels() noexcept
+    {
+        return nullptr;
+    }
+}
+
+#endif // SIMD_NEON
@@ -0,0 +1,154 @@
+/**
+ * Scalar kernels: the reference implementation every SIMD table is tested
+ * against, and the fallback on CPUs without a supported instruction set.
+ * Plain loops the compiler is free to auto-vectorize for the baseline ISA.
+ */
+
+#include "SimdKernels.h"
+
+namespace dsp::simd::kernels_impl
+{
+    namespace
+    {
+        void abs_inplace(float *buffer, size_t size)
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                buffer[i] = std::fabs(buffer[i]);
+            }
+        }
+
+        void max_zero_inplace(float *buffer, size_t size)
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                buffer[i] = std::max(0.0f, buffer[i]);
+            }
+        }
+
+        double sum(const float *buffer, size_t size)
+        {
+            // Kahan summation for precision
+            double sum = 0.0;
+            double c = 0.0; // Compensation for lost low-order bits
+
+            for (size_t i = 0; i < size; ++i)
+            {
+                double y = static_cast<double>(buffer[i]) - c;
+                double t = sum + y;
+                c = (t - sum) - y;
+                sum = t;
+            }
+
+            return sum;
+        }
+
+        double sum_of_squares(const float *buffer, size_t size)
+        {
+            double sum = 0.0;
+            double c = 0.0;
+
+            for (size_t i = 0; i < size; ++i)
+            {
+                double val = static_cast<double>(buffer[i]);
+                double y = (val * val) - c;
+                double t = sum + y;
+                c = (t - sum) - y;
+                sum = t;
+            }
+
+            return sum;
+        }
+
+        void apply_window(const float *input, const float *window, float *output, size_t size)
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                output[i] = input[i] * window[i];
+            }
+        }
+
+        void complex_magnitude(const float *real, const float *imag, float *magnitude, size_t size)
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                magnitude[i] = std::sqrt(real[i] * real[i] + imag[i] * imag[i]);
+            }
+        }
+
+        void complex_power(const float *real, const float *imag, float *power, size_t size)
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                power[i] = real[i] * real[i] + imag[i] * imag[i];
+            }
+        }
+
+        float dot_product(const float *a, const float *b, size_t size)
+        {
+            float result = 0.0f;
+            for (size_t i = 0; i < size; ++i)
+            {
+                result += a[i] * b[i];
+            }
+            return result;
+        }
+
+        void scaled_add(float *target, const float *source, float scale, size_t size)
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                target[i] += scale * source[i];
+            }
+        }
+
+        void complex_multiply(const float *a_real, const float *a_imag,
+                              const float *b_real, const float *b_imag,
+                              float *out_real, float *out_imag, size_t size)
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                float ar = a_real[i], ai = a_imag[i];
+                float br = b_real[i], bi = b_imag[i];
+                out_real[i] = ar * br - ai * bi;
+                out_imag[i] = ar * bi + ai * br;
+            }
+        }
+
+        template <typename T>
+        void fft_radix2_stage(T *data, size_t size, size_t halfLen,
+                              const T *twiddles, size_t twiddleStep, bool inverse)
+        {
+            for (size_t i = 0; i < size; i += 2 * halfLen)
+            {
+                radix2Butterflies(data + 2 * i, 0, halfLen, twiddles, 0, twiddleStep, inverse);
+            }
+        }
+
+        const KernelTable kTable = {
+            SimdLevel::Scalar,
+            abs_inplace,
+            max_zero_inplace,
+            sum,
+            sum_of_squares,
+            apply_window,
+            complex_magnitude,
+            complex_power,
+            dot_product,
+            complex_multiply,
+            fft_radix2_stage<float>,
+            fft_radix2_stage<double>,
+            windowFrames,
+            windowBlock,
+            mixFrames,
+            scaled_add,
+            kalmanFrames,
+        };
+    }
+
+    const KernelTable *scalarKernels() noexcept
+    {
+        return &kTable;
+    }
+
+} // namespace dsp::simd::kernels_impl
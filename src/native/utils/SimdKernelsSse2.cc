@@ -0,0 +1,430 @@
+/**
+ * SSE2 kernels (4 floats / 2 doubles per vector): the x64 baseline, and the
+ * minimum the x86 tables ask for on 32-bit builds.
+ */
+
+#include "SimdKernels.h"
+
+#if defined(SIMD_X86)
+#include <emmintrin.h>
+#include <xmmintrin.h>
+
+#define SSE2_FN DSP_SIMD_TARGET("sse2")
+
+namespace dsp::simd::kernels_impl
+{
+    namespace
+    {
+        SSE2_FN void abs_inplace(float *buffer, size_t size)
+        {
+            const size_t simd_width = 4;
+            const size_t simd_count = size / simd_width;
+            const size_t simd_end = simd_count * simd_width;
+
+            const __m128 sign_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+            for (size_t i = 0; i < simd_end; i += simd_width)
+            {
+                __m128 values = _mm_loadu_ps(&buffer[i]);
+                values = _mm_and_ps(values, sign_mask);
+                _mm_storeu_ps(&buffer[i], values);
+            }
+
+            for (size_t i = simd_end; i < size; ++i)
+            {
+                buffer[i] = std::fabs(buffer[i]);
+            }
+        }
+
+        SSE2_FN void max_zero_inplace(float *buffer, size_t size)
+        {
+            const size_t simd_width = 4;
+            const size_t simd_count = size / simd_width;
+            const size_t simd_end = simd_count * simd_width;
+
+            const __m128 zero = _mm_setzero_ps();
+
+            for (size_t i = 0; i < simd_end; i += simd_width)
+            {
+                __m128 values = _mm_loadu_ps(&buffer[i]);
+                values = _mm_max_ps(values, zero);
+                _mm_storeu_ps(&buffer[i], values);
+            }
+
+            for (size_t i = simd_end; i < size; ++i)
+            {
+                buffer[i] = std::max(0.0f, buffer[i]);
+            }
+        }
+
+        SSE2_FN double sum(const float *buffer, size_t size)
+        {
+            const size_t simd_width = 4;
+            const size_t simd_count = size / simd_width;
+            const size_t simd_end = simd_count * simd_width;
+
+            __m128d acc1 = _mm_setzero_pd();
+            __m128d acc2 = _mm_setzero_pd();
+
+            for (size_t i = 0; i < simd_end; i += simd_width)
+            {
+                __m128 values = _mm_loadu_ps(&buffer[i]);
+
+                // Convert to doubles for precision
+                __m128d dbl_lo = _mm_cvtps_pd(values);
+                __m128d dbl_hi = _mm_cvtps_pd(_mm_movehl_ps(values, values));
+
+                acc1 = _mm_add_pd(acc1, dbl_lo);
+                acc2 = _mm_add_pd(acc2, dbl_hi);
+            }
+
+            acc1 = _mm_add_pd(acc1, acc2);
+            double result[2];
+            _mm_storeu_pd(result, acc1);
+            double total = result[0] + result[1];
+
+            for (size_t i = simd_end; i < size; ++i)
+            {
+                total += static_cast<double>(buffer[i]);
+            }
+
+            return total;
+        }
+
+        SSE2_FN double sum_of_squares(const float *buffer, size_t size)
+        {
+            const size_t simd_width = 4;
+            const size_t simd_count = size / simd_width;
+            const size_t simd_end = simd_count * simd_width;
+
+            __m128d acc1 = _mm_setzero_pd();
+            __m128d acc2 = _mm_setzero_pd();
+
+            for (size_t i = 0; i < simd_end; i += simd_width)
+            {
+                __m128 values = _mm_loadu_ps(&buffer[i]);
+                __m128 squares = _mm_mul_ps(values, values);
+
+                __m128d dbl_lo = _mm_cvtps_pd(squares);
+                __m128d dbl_hi = _mm_cvtps_pd(_mm_movehl_ps(squares, squares));
+
+                acc1 = _mm_add_pd(acc1, dbl_lo);
+                acc2 = _mm_add_pd(acc2, dbl_hi);
+            }
+
+            acc1 = _mm_add_pd(acc1, acc2);
+            double result[2];
+            _mm_storeu_pd(result, acc1);
+            double total = result[0] + result[1];
+
+            for (size_t i = simd_end; i < size; ++i)
+            {
+                double val = static_cast<double>(buffer[i]);
+                total += val * val;
+            }
+
+            return total;
+        }
+
+        SSE2_FN void apply_window(const float *input, const float *window, float *output, size_t size)
+        {
+            const size_t simd_width = 4;
+            const size_t simd_count = size / simd_width;
+            const size_t simd_end = simd_count * simd_width;
+
+            for (size_t i = 0; i < simd_end; i += simd_width)
+            {
+                __m128 in = _mm_loadu_ps(&input[i]);
+                __m128 win = _mm_loadu_ps(&window[i]);
+                __m128 result = _mm_mul_ps(in, win);
+                _mm_storeu_ps(&output[i], result);
+            }
+
+            for (size_t i = simd_end; i < size; ++i)
+            {
+                output[i] = input[i] * window[i];
+            }
+        }
+
+        SSE2_FN void complex_magnitude(const float *real, const float *imag, float *magnitude, size_t size)
+        {
+            const size_t simd_width = 4;
+            const size_t simd_count = size / simd_width;
+            const size_t simd_end = simd_count * simd_width;
+
+            for (size_t i = 0; i < simd_end; i += simd_width)
+            {
+                __m128 re = _mm_loadu_ps(&real[i]);
+                __m128 im = _mm_loadu_ps(&imag[i]);
+
+                __m128 re_sq = _mm_mul_ps(re, re);
+                __m128 im_sq = _mm_mul_ps(im, im);
+                __m128 mag_sq = _mm_add_ps(re_sq, im_sq);
+                __m128 mag = _mm_sqrt_ps(mag_sq);
+
+                _mm_storeu_ps(&magnitude[i], mag);
+            }
+
+            for (size_t i = simd_end; i < size; ++i)
+            {
+                magnitude[i] = std::sqrt(real[i] * real[i] + imag[i] * imag[i]);
+            }
+        }
+
+        SSE2_FN void complex_power(const float *real, const float *imag, float *power, size_t size)
+        {
+            const size_t simd_width = 4;
+            const size_t simd_count = size / simd_width;
+            const size_t simd_end = simd_count * simd_width;
+
+            for (size_t i = 0; i < simd_end; i += simd_width)
+            {
+                __m128 re = _mm_loadu_ps(&real[i]);
+                __m128 im = _mm_loadu_ps(&imag[i]);
+
+                __m128 re_sq = _mm_mul_ps(re, re);
+                __m128 im_sq = _mm_mul_ps(im, im);
+                __m128 pwr = _mm_add_ps(re_sq, im_sq);
+
+                _mm_storeu_ps(&power[i], pwr);
+            }
+
+            for (size_t i = simd_end; i < size; ++i)
+            {
+                power[i] = real[i] * real[i] + imag[i] * imag[i];
+            }
+        }
+
+        SSE2_FN float dot_product(const float *a, const float *b, size_t size)
+        {
+            const size_t simd_width = 4;
+            const size_t simd_count = size / simd_width;
+            const size_t simd_end = simd_count * simd_width;
+
+            __m128 acc = _mm_setzero_ps();
+
+            for (size_t i = 0; i < simd_end; i += simd_width)
+            {
+                __m128 va = _mm_loadu_ps(&a[i]);
+                __m128 vb = _mm_loadu_ps(&b[i]);
+                __m128 prod = _mm_mul_ps(va, vb);
+                acc = _mm_add_ps(acc, prod);
+            }
+
+            // Horizontal sum
+            __m128 shuf = _mm_shuffle_ps(acc, acc, _MM_SHUFFLE(2, 3, 0, 1));
+            __m128 sums = _mm_add_ps(acc, shuf);
+            shuf = _mm_movehl_ps(shuf, sums);
+            sums = _mm_add_ss(sums, shuf);
+
+            float result = _mm_cvtss_f32(sums);
+
+            for (size_t i = simd_end; i < size; ++i)
+            {
+                result += a[i] * b[i];
+            }
+
+            return result;
+        }
+
+        SSE2_FN void complex_multiply(const float *a_real, const float *a_imag,
+                                      const float *b_real, const float *b_imag,
+                                      float *out_real, float *out_imag, size_t size)
+        {
+            const size_t simd_width = 4;
+            const size_t simd_count = size / simd_width;
+            const size_t simd_end = simd_count * simd_width;
+
+            for (size_t i = 0; i < simd_end; i += simd_width)
+            {
+                __m128 ar = _mm_loadu_ps(&a_real[i]);
+                __m128 ai = _mm_loadu_ps(&a_imag[i]);
+                __m128 br = _mm_loadu_ps(&b_real[i]);
+                __m128 bi = _mm_loadu_ps(&b_imag[i]);
+
+                __m128 ac = _mm_mul_ps(ar, br);
+                __m128 bd = _mm_mul_ps(ai, bi);
+                __m128 ad = _mm_mul_ps(ar, bi);
+                __m128 bc = _mm_mul_ps(ai, br);
+
+                __m128 real = _mm_sub_ps(ac, bd);
+                __m128 imag = _mm_add_ps(ad, bc);
+
+                _mm_storeu_ps(&out_real[i], real);
+                _mm_storeu_ps(&out_imag[i], imag);
+            }
+
+            for (size_t i = simd_end; i < size; ++i)
+            {
+                float ar = a_real[i], ai = a_imag[i];
+                float br = b_real[i], bi = b_imag[i];
+                out_real[i] = ar * br - ai * bi;
+                out_imag[i] = ar * bi + ai * br;
+            }
+        }
+
+        // ========== FFT butterflies ==========
+
+        /**
+         * b * tw for two interleaved complex floats [r0, i0, r1, i1], using
+         * SSE2 shuffles in place of SSE3 moveldup/movehdup/addsub.
+         */
+        SSE2_FN inline __m128 complex_mul(__m128 b, __m128 tw)
+        {
+            const __m128 sign = _mm_setr_ps(-1.0f, 1.0f, -1.0f, 1.0f);
+            __m128 b_real = _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 2, 0, 0));
+            __m128 b_imag = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 3, 1, 1));
+            __m128 tw_swapped = _mm_shuffle_ps(tw, tw, _MM_SHUFFLE(2, 3, 0, 1)); // [i0, r0, i1, r1]
+            __m128 mult1 = _mm_mul_ps(b_real, tw);
+            __m128 mult2 = _mm_mul_ps(_mm_mul_ps(b_imag, tw_swapped), sign);
+            return _mm_add_ps(mult1, mult2);
+        }
+
+        SSE2_FN void fft_radix2_stage(float *data, size_t size, size_t halfLen,
+                                      const float *twiddles, size_t twiddleStep, bool inverse)
+        {
+            const __m128 conj_mask = _mm_setr_ps(1.0f, -1.0f, 1.0f, -1.0f);
+
+            for (size_t i = 0; i < size; i += 2 * halfLen)
+            {
+                float *block = data + 2 * i;
+                size_t j = 0;
+                size_t k = 0;
+
+                for (; j + 1 < halfLen; j += 2)
+                {
+                    const float *tw0 = twiddles + 2 * k;
+                    const float *tw1 = twiddles + 2 * (k + twiddleStep);
+                    __m128 tw = _mm_setr_ps(tw0[0], tw0[1], tw1[0], tw1[1]);
+                    if (inverse)
+                    {
+                        tw = _mm_mul_ps(tw, conj_mask);
+                    }
+
+                    __m128 a = _mm_loadu_ps(block + 2 * j);
+                    __m128 b = _mm_loadu_ps(block + 2 * (j + halfLen));
+                    __m128 temp = complex_mul(b, tw);
+                    _mm_storeu_ps(block + 2 * (j + halfLen), _mm_sub_ps(a, temp));
+                    _mm_storeu_ps(block + 2 * j, _mm_add_ps(a, temp));
+                    k += 2 * twiddleStep;
+                }
+
+                radix2Butterflies(block, j, halfLen, twiddles, k, twiddleStep, inverse);
+            }
+        }
+
+        SSE2_FN void fft_radix2_stage_double(double *data, size_t size, size_t halfLen,
+                                             const double *twiddles, size_t twiddleStep, bool inverse)
+        {
+            // One complex double per vector: b * tw = b.re * [wr, wi] + b.im * [-wi, wr]
+            const __m128d sign = _mm_setr_pd(-1.0, 1.0);
+            const __m128d conj_mask = _mm_setr_pd(1.0, -1.0);
+
+            for (size_t i = 0; i < size; i += 2 * halfLen)
+            {
+                double *block = data + 2 * i;
+                size_t k = 0;
+
+                for (size_t j = 0; j < halfLen; ++j)
+                {
+                    __m128d tw = _mm_loadu_pd(twiddles + 2 * k);
+                    if (inverse)
+                    {
+                        tw = _mm_mul_pd(tw, conj_mask);
+                    }
+                    __m128d tw_swapped = _mm_shuffle_pd(tw, tw, 1);
+
+                    __m128d a = _mm_loadu_pd(block + 2 * j);
+                    __m128d b = _mm_loadu_pd(block + 2 * (j + halfLen));
+                    __m128d b_real = _mm_unpacklo_pd(b, b);
+                    __m128d b_imag = _mm_unpackhi_pd(b, b);
+                    __m128d temp = _mm_add_pd(_mm_mul_pd(b_real, tw),
+                                              _mm_mul_pd(_mm_mul_pd(b_imag, tw_swapped), sign));
+
+                    _mm_storeu_pd(block + 2 * (j + halfLen), _mm_sub_pd(a, temp));
+                    _mm_storeu_pd(block + 2 * j, _mm_add_pd(a, temp));
+                    k += twiddleStep;
+                }
+            }
+        }
+
+        // Lock-step sliding windows: the shared loop, vectorized for this target
+        SSE2_FN void window_frames(const WindowFrames &run)
+        {
+            windowFrames(run);
+        }
+
+        // Prefix-sum moving statistics: the shared loop, vectorized for this target
+        SSE2_FN void window_block(const WindowBlock &run)
+        {
+            windowBlock(run);
+        }
+
+        // Blocked mixing-matrix GEMM: the shared loop, vectorized for this target
+        SSE2_FN void mix_frames(const MixFrames &run)
+        {
+            mixFrames(run);
+        }
+
+        SSE2_FN void scaled_add(float *target, const float *source, float scale, size_t size)
+        {
+            const __m128 factor = _mm_set1_ps(scale);
+
+            size_t i = 0;
+            for (; i + 4 <= size; i += 4)
+            {
+                __m128 t = _mm_loadu_ps(&target[i]);
+                __m128 s = _mm_loadu_ps(&source[i]);
+                _mm_storeu_ps(&target[i], _mm_add_ps(t, _mm_mul_ps(factor, s)));
+            }
+            for (; i < size; ++i)
+            {
+                target[i] += scale * source[i];
+            }
+        }
+
+        // Bank of Kalman filters, one per lane: the shared loops, vectorized for this target
+        SSE2_FN void kalman_frames(const KalmanFrames &run)
+        {
+            kalmanFrames(run);
+        }
+
+        const KernelTable kTable = {
+            SimdLevel::Sse2,
+            abs_inplace,
+            max_zero_inplace,
+            sum,
+            sum_of_squares,
+            apply_window,
+            complex_magnitude,
+            complex_power,
+            dot_product,
+            complex_multiply,
+            fft_radix2_stage,
+            fft_radix2_stage_double,
+            window_frames,
+            window_block,
+            mix_frames,
+            scaled_add,
+            kalman_frames,
+        };
+    }
+
+    const KernelTable *sse2Kernels() noexcept
+    {
+        return &kTable;
+    }
+
+} // namespace dsp::simd::kernels_impl
+
+#else
+
+namespace dsp::simd::kernels_impl
+{
+    const KernelTable *sse2Kernels() noexcept
+    {
+        return nullptr;
+    }
+}
+
+#endif // SIMD_X86
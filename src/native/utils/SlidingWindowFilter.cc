@@ -1,8 +1,24 @@
 #include "SlidingWindowFilter.h"
 #include "../core/Policies.h"
+#include <stdexcept>
+#include <type_traits>
 
 using namespace dsp::utils;
 
+namespace
+{
+    // Policies that can be evaluated block-wise declare kBlockStatistic
+    template <typename Policy, typename = void>
+    struct HasBlockStatistic : std::false_type
+    {
+    };
+
+    template <typename Policy>
+    struct HasBlockStatistic<Policy, std::void_t<decltype(Policy::kBlockStatistic)>> : std::true_type
+    {
+    };
+}
+
 // -----------------------------------------------------------------------------
 // Constructor
 // Constructs a new sliding window filter with the specified window size
@@ -12,7 +28,12 @@ using namespace dsp::utils;
 // -----------------------------------------------------------------------------
 template <typename T, typename Policy>
 SlidingWindowFilter<T, Policy>::SlidingWindowFilter(size_t window_size, Policy policy)
-    : m_buffer(window_size), m_policy(std::move(policy))
+    : m_buffer(window_size),
+      m_time_buffer(1),
+      m_window_duration_ms(0.0),
+      m_time_aware(false),
+      m_policy(std::move(policy)),
+      m_mark{nextWindowEpoch(), 0}
 {
 }
 
@@ -26,7 +47,12 @@ SlidingWindowFilter<T, Policy>::SlidingWindowFilter(size_t window_size, Policy p
 // -----------------------------------------------------------------------------
 template <typename T, typename Policy>
 SlidingWindowFilter<T, Policy>::SlidingWindowFilter(size_t window_size, double window_duration_ms, Policy policy)
-    : m_buffer(window_size, window_duration_ms), m_policy(std::move(policy))
+    : m_buffer(1),
+      m_time_buffer(window_size, window_duration_ms),
+      m_window_duration_ms(window_duration_ms),
+      m_time_aware(window_duration_ms > 0.0),
+      m_policy(std::move(policy)),
+      m_mark{nextWindowEpoch(), 0}
 {
 }
 
@@ -36,10 +62,10 @@ SlidingWindowFilter<T, Policy>::SlidingWindowFilter(size_t window_size, double w
 // If buffer is full, removes oldest sample (delegates to policy.onRemove)
 // Then adds new sample (delegates to policy.onAdd)
 // @ param newValue - The new sample to add
-// @ return T - The computed result from the policy
+// @ return Result - The computed result from the policy
 // -----------------------------------------------------------------------------
 template <typename T, typename Policy>
-T SlidingWindowFilter<T, Policy>::addSample(T newValue)
+typename SlidingWindowFilter<T, Policy>::Result SlidingWindowFilter<T, Policy>::addSample(T newValue)
 {
     if (m_buffer.isFull())
     {
@@ -49,6 +75,7 @@ T SlidingWindowFilter<T, Policy>::addSample(T newValue)
 
     m_buffer.pushOverwrite(newValue);
     m_policy.onAdd(newValue);
+    ++m_mark.pushed;
 
     return m_policy.getResult(m_buffer.getCount());
 }
@@ -59,50 +86,96 @@ T SlidingWindowFilter<T, Policy>::addSample(T newValue)
 // Expires old samples first, then adds the new sample
 // @ param newValue - The new sample to add
 // @ param timestamp - The timestamp in milliseconds
-// @ return T - The computed result from the policy
+// @ return Result - The computed result from the policy
 // -----------------------------------------------------------------------------
 template <typename T, typename Policy>
-T SlidingWindowFilter<T, Policy>::addSampleWithTimestamp(T newValue, double timestamp)
+typename SlidingWindowFilter<T, Policy>::Result SlidingWindowFilter<T, Policy>::addSampleWithTimestamp(T newValue, double timestamp)
 {
-    if (!m_buffer.isTimeAware())
+    if (!m_time_aware)
     {
         throw std::runtime_error("addSampleWithTimestamp requires time-aware mode");
     }
 
-    // First, expire old samples and update policy
-    while (m_buffer.getCount() > 0)
+    // Expire old samples: binary search for the cutoff, then hand each
+    // expired value to the policy (no O(w) rebuild)
+    size_t expired_count = m_time_buffer.countOlderThan(timestamp - m_window_duration_ms);
+    for (size_t i = 0; i < expired_count; ++i)
     {
-        size_t initial_count = m_buffer.getCount();
-        m_buffer.expireOld(timestamp);
-        size_t expired_count = initial_count - m_buffer.getCount();
+        m_policy.onRemove(m_time_buffer.valueAt(i));
+    }
+    m_time_buffer.popFront(expired_count);
+
+    // Check if buffer is full (by sample count); push() overwrites the oldest
+    if (m_time_buffer.isFull())
+    {
+        m_policy.onRemove(m_time_buffer.valueAt(0));
+    }
+
+    // Add the new sample
+    m_time_buffer.push(timestamp, newValue);
+    m_policy.onAdd(newValue);
+    ++m_mark.pushed;
+
+    return m_policy.getResult(m_time_buffer.size());
+}
 
-        // We need to reconstruct the policy state from remaining samples
-        // This is inefficient but correct. Better approach: track what was removed
-        if (expired_count > 0)
+// -----------------------------------------------------------------------------
+// addSamples
+// Adds a chunk of samples; float chunks of at least one window go through
+// prefix sums when the policy supports it, everything else sample by sample
+// @ param samples - First sample (replaced by its result)
+// @ param count - Number of samples
+// @ param stride - Distance between consecutive samples
+// @ return void
+// -----------------------------------------------------------------------------
+template <typename T, typename Policy>
+void SlidingWindowFilter<T, Policy>::addSamples(T *samples, size_t count, size_t stride)
+{
+    if constexpr (std::is_same_v<T, float> && HasBlockStatistic<Policy>::value)
+    {
+        if (!m_time_aware && PrefixSumWindow::accepts(count, m_buffer.getCapacity()))
         {
-            // Rebuild policy from scratch using remaining samples
-            m_policy.clear();
-            auto remaining = m_buffer.toVector();
-            for (const auto &value : remaining)
-            {
-                m_policy.onAdd(value);
-            }
+            double sum = 0.0;
+            double sumSq = 0.0;
+            m_block.process(m_buffer, samples, count, stride, Policy::kBlockStatistic, 0.0f, sum, sumSq);
+            m_policy.setBlockSums(sum, sumSq);
+            m_mark.pushed += count;
+            return;
         }
-        break; // expireOld already removed all expired samples
     }
 
-    // Check if buffer is full (by sample count)
-    if (m_buffer.isFull())
+    if constexpr (std::is_same_v<Result, T>)
     {
-        T oldestValue = m_buffer.peek();
-        m_policy.onRemove(oldestValue);
+        for (size_t i = 0; i < count; ++i)
+        {
+            samples[i * stride] = addSample(samples[i * stride]);
+        }
+    }
+    else
+    {
+        throw std::logic_error("addSamples requires a policy with a single result per sample");
     }
+}
 
-    // Add the new sample
-    m_buffer.pushOverwriteWithTimestamp(newValue, timestamp);
-    m_policy.onAdd(newValue);
+// -----------------------------------------------------------------------------
+// reserve
+// Preallocates the scratch the add paths would otherwise grow lazily
+// @ param maxCount - Largest chunk passed to addSamples()
+// @ return void
+// -----------------------------------------------------------------------------
+template <typename T, typename Policy>
+void SlidingWindowFilter<T, Policy>::reserve(size_t maxCount)
+{
+    if (m_time_aware)
+    {
+        m_time_buffer.reserveClock();
+        return;
+    }
 
-    return m_policy.getResult(m_buffer.getCount());
+    if constexpr (std::is_same_v<T, float> && HasBlockStatistic<Policy>::value)
+    {
+        m_block.reserve(m_buffer.getCapacity(), maxCount);
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -115,7 +188,9 @@ template <typename T, typename Policy>
 void SlidingWindowFilter<T, Policy>::clear()
 {
     m_buffer.clear();
+    m_time_buffer.clear();
     m_policy.clear();
+    m_mark = {nextWindowEpoch(), 0};
 }
 
 // -----------------------------------------------------------------------------
@@ -126,7 +201,7 @@ void SlidingWindowFilter<T, Policy>::clear()
 template <typename T, typename Policy>
 bool SlidingWindowFilter<T, Policy>::isFull() const noexcept
 {
-    return m_buffer.isFull();
+    return m_time_aware ? m_time_buffer.isFull() : m_buffer.isFull();
 }
 
 // -----------------------------------------------------------------------------
@@ -137,7 +212,7 @@ bool SlidingWindowFilter<T, Policy>::isFull() const noexcept
 template <typename T, typename Policy>
 size_t SlidingWindowFilter<T, Policy>::getCount() const noexcept
 {
-    return m_buffer.getCount();
+    return m_time_aware ? m_time_buffer.size() : m_buffer.getCount();
 }
 
 // -----------------------------------------------------------------------------
@@ -148,7 +223,7 @@ size_t SlidingWindowFilter<T, Policy>::getCount() const noexcept
 template <typename T, typename Policy>
 size_t SlidingWindowFilter<T, Policy>::getWindowSize() const noexcept
 {
-    return m_buffer.getCapacity();
+    return m_time_aware ? m_time_buffer.getMaxSamples() : m_buffer.getCapacity();
 }
 
 // -----------------------------------------------------------------------------
@@ -159,7 +234,7 @@ size_t SlidingWindowFilter<T, Policy>::getWindowSize() const noexcept
 template <typename T, typename Policy>
 std::vector<T> SlidingWindowFilter<T, Policy>::getBufferContents() const
 {
-    return m_buffer.toVector();
+    return m_time_aware ? m_time_buffer.valuesToVector() : m_buffer.toVector();
 }
 
 // -----------------------------------------------------------------------------
@@ -171,7 +246,17 @@ std::vector<T> SlidingWindowFilter<T, Policy>::getBufferContents() const
 template <typename T, typename Policy>
 void SlidingWindowFilter<T, Policy>::setBufferContents(const std::vector<T> &bufferData)
 {
-    m_buffer.fromVector(bufferData);
+    if (m_time_aware)
+    {
+        // Saved state carries no timestamps; restored samples are stamped 0
+        // and expire as soon as the window moves past them
+        m_time_buffer.fromValues(bufferData);
+    }
+    else
+    {
+        m_buffer.fromVector(bufferData);
+    }
+    m_mark = {nextWindowEpoch(), 0};
 }
 
 // -----------------------------------------------------------------------------
@@ -236,4 +321,12 @@ namespace dsp::utils
 
     // WAMP,SSC instantiations
     template class dsp::utils::SlidingWindowFilter<bool, CounterPolicy>;
+
+    // PercentilePolicy instantiations (movingMedian / movingPercentile)
+    template class SlidingWindowFilter<float, PercentilePolicy<float>>;
+    template class SlidingWindowFilter<double, PercentilePolicy<double>>;
+
+    // CompositePolicy instantiations (movingStatistics)
+    template class SlidingWindowFilter<float, MovingStatisticsPolicy<float>>;
+    template class SlidingWindowFilter<double, MovingStatisticsPolicy<double>>;
 }
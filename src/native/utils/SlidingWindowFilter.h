@@ -1,27 +1,56 @@
 #pragma once
 #include "CircularBufferArray.h"
+#include "TimeSeriesBuffer.h"
+#include "BinaryState.h"
+#include "PrefixSumWindow.h"
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 namespace dsp::utils
 {
+    /**
+     * @brief What addSample() returns: Policy::Result when the policy
+     * declares one (e.g. CompositePolicy), otherwise T.
+     */
+    template <typename T, typename Policy, typename = void>
+    struct PolicyResult
+    {
+        using type = T;
+    };
+
+    template <typename T, typename Policy>
+    struct PolicyResult<T, Policy, std::void_t<typename Policy::Result>>
+    {
+        using type = typename Policy::Result;
+    };
     /**
      * @brief A generic, policy-based sliding window filter engine.
      *
      * This class implements the sliding window logic (circular buffer management)
      * while delegating the statistical computation to a Policy class.
      *
+     * Sample-count windows live in a CircularBufferArray; time-aware windows
+     * live in a TimeSeriesBuffer (SoA ring), whose binary-search expiration
+     * lets expired samples be handed to policy.onRemove() one by one instead
+     * of rebuilding the policy from the whole window.
+     *
      * This is a zero-cost abstraction: the compiler inlines all policy methods,
      * resulting in performance identical to hand-written specialized filters.
      *
      * @tparam T The numeric type (e.g., float, double).
      * @tparam Policy The struct that defines the state and math operations.
      *               Must implement: onAdd(T), onRemove(T), clear(), getResult(size_t)
+     *               May declare kBlockStatistic and setBlockSums(double, double)
+     *               to let addSamples() evaluate float chunks from prefix sums,
+     *               and a Result type when getResult() does not return T.
      */
     template <typename T, typename Policy>
     class SlidingWindowFilter
     {
     public:
+        using Result = typename PolicyResult<T, Policy>::type;
+
         /**
          * @brief Constructs a new sliding window filter.
          * @param window_size The number of samples in the sliding window.
@@ -52,9 +81,9 @@ namespace dsp::utils
          * then adds the new sample (delegates to policy.onAdd).
          *
          * @param newValue The new sample to add.
-         * @return T The computed result from the policy.
+         * @return Result The computed result from the policy.
          */
-        T addSample(T newValue);
+        Result addSample(T newValue);
 
         /**
          * @brief Adds a new sample with timestamp (time-aware mode).
@@ -63,9 +92,30 @@ namespace dsp::utils
          *
          * @param newValue The new sample to add.
          * @param timestamp The timestamp in milliseconds.
-         * @return T The computed result from the policy.
+         * @return Result The computed result from the policy.
          */
-        T addSampleWithTimestamp(T newValue, double timestamp);
+        Result addSampleWithTimestamp(T newValue, double timestamp);
+
+        /**
+         * @brief Adds a chunk of samples, replacing each with its result.
+         *
+         * Same results as addSample() per sample. Sample-count windows whose
+         * policy declares kBlockStatistic evaluate chunks of at least one
+         * window from prefix sums instead (see PrefixSumWindow). Only for
+         * policies whose result is a single T.
+         *
+         * @param samples First sample (in-place).
+         * @param count Number of samples.
+         * @param stride Distance between consecutive samples (channel count for interleaved data).
+         */
+        void addSamples(T *samples, size_t count, size_t stride = 1);
+
+        /**
+         * @brief Preallocates what adding chunks of up to maxCount samples
+         * needs (block scratch, or the time-aware clock), so later
+         * addSamples() / addSampleWithTimestamp() calls do not allocate.
+         */
+        void reserve(size_t maxCount);
 
         /**
          * @brief Clears all samples from the filter.
@@ -96,7 +146,7 @@ namespace dsp::utils
          * @brief Checks if this is a time-aware filter.
          * @return bool True if window duration is set.
          */
-        bool isTimeAware() const noexcept { return m_buffer.isTimeAware(); }
+        bool isTimeAware() const noexcept { return m_time_aware; }
 
         /**
          * @brief Exports the buffer contents.
@@ -110,6 +160,11 @@ namespace dsp::utils
          */
         void setBufferContents(const std::vector<T> &bufferData);
 
+        /**
+         * @brief Gets the window's position in its push history (for delta snapshots).
+         */
+        WindowMark getWindowMark() const noexcept { return m_mark; }
+
         /**
          * @brief Access to the policy for state serialization.
          * @return Policy& Reference to the internal policy object.
@@ -132,7 +187,7 @@ namespace dsp::utils
          */
         auto getState() const -> std::pair<std::vector<T>, decltype(std::declval<Policy>().getState())>
         {
-            return {m_buffer.toVector(), m_policy.getState()};
+            return {getBufferContents(), m_policy.getState()};
         }
 
         /**
@@ -147,13 +202,18 @@ namespace dsp::utils
         template <typename PolicyState>
         void setState(const std::vector<T> &bufferData, const PolicyState &policyState)
         {
-            m_buffer.fromVector(bufferData);
+            setBufferContents(bufferData);
             m_policy.setState(policyState);
         }
 
     private:
-        CircularBufferArray<T> m_buffer;
+        CircularBufferArray<T> m_buffer;     // Sample-count mode storage
+        TimeSeriesBuffer<T> m_time_buffer;   // Time-aware mode storage
+        double m_window_duration_ms;
+        bool m_time_aware;
         Policy m_policy;
+        WindowMark m_mark;       // New epoch on clear/restore, pushed++ per sample
+        PrefixSumWindow m_block; // Scratch for addSamples()
     };
 
 } // namespace dsp::utils
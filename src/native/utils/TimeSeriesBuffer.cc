@@ -1,39 +1,358 @@
 #include "TimeSeriesBuffer.h"
+#include <algorithm>
+#include <cmath>
 
 namespace dsp::utils
 {
+    namespace
+    {
+        // Smallest power of two >= n (n = 0 maps to 1)
+        size_t nextPowerOfTwo(size_t n)
+        {
+            size_t p = 1;
+            while (p < n)
+            {
+                p <<= 1;
+            }
+            return p;
+        }
+
+        constexpr size_t kDefaultCapacity = 16;
+
+        // The implicit clock gives up once it needs more than one segment per
+        // kSegmentBudgetDivisor slots of capacity (segments are 3x the size of
+        // a stored timestamp, so this caps them well below explicit storage).
+        constexpr size_t kSegmentBudgetDivisor = 8;
+        constexpr size_t kMinSegmentBudget = 8;
+    }
+
     // -----------------------------------------------------------------------------
     // Constructor
+    // Bounded buffers allocate their full (rounded-up) capacity once so that
+    // steady-state pushes never reallocate. The timestamp array only exists in
+    // Explicit mode.
+    // -----------------------------------------------------------------------------
+    template <typename T>
+    TimeSeriesBuffer<T>::TimeSeriesBuffer(size_t max_samples,
+                                          double window_duration_ms,
+                                          TimestampMode mode,
+                                          double period_ms,
+                                          double tolerance)
+        : m_mask(0), m_head(0), m_count(0), m_max_samples(max_samples), m_window_duration_ms(window_duration_ms),
+          m_mode(mode), m_period(period_ms > 0.0 ? period_ms : 0.0), m_tolerance(tolerance > 0.0 ? tolerance : 0.0)
+    {
+        size_t capacity = nextPowerOfTwo(max_samples > 0 ? max_samples : kDefaultCapacity);
+        if (m_mode == TimestampMode::Explicit)
+        {
+            m_timestamps = std::make_unique<TimestampType[]>(capacity);
+        }
+        m_values = std::make_unique<T[]>(capacity);
+        m_mask = capacity - 1;
+    }
+
+    // -----------------------------------------------------------------------------
+    // reserve - Grows the ring (power-of-two) and linearizes the live samples
+    // -----------------------------------------------------------------------------
+    template <typename T>
+    void TimeSeriesBuffer<T>::reserve(size_t min_capacity)
+    {
+        if (min_capacity <= capacity())
+        {
+            return;
+        }
+
+        size_t newCapacity = nextPowerOfTwo(min_capacity);
+        auto newValues = std::make_unique<T[]>(newCapacity);
+        for (size_t i = 0; i < m_count; ++i)
+        {
+            newValues[i] = m_values[(m_head + i) & m_mask];
+        }
+
+        if (m_mode == TimestampMode::Explicit)
+        {
+            auto newTimestamps = std::make_unique<TimestampType[]>(newCapacity);
+            for (size_t i = 0; i < m_count; ++i)
+            {
+                newTimestamps[i] = m_timestamps[(m_head + i) & m_mask];
+            }
+            m_timestamps = std::move(newTimestamps);
+        }
+
+        m_values = std::move(newValues);
+        m_mask = newCapacity - 1;
+        m_head = 0;
+    }
+
+    // -----------------------------------------------------------------------------
+    // timestampAt - Logical timestamp access
+    // Implicit mode evaluates the covering clock segment; the newest segment
+    // is checked first since most lookups are at the back of the window.
+    // -----------------------------------------------------------------------------
+    template <typename T>
+    typename TimeSeriesBuffer<T>::TimestampType TimeSeriesBuffer<T>::timestampAt(size_t index) const noexcept
+    {
+        if (m_mode == TimestampMode::Explicit)
+        {
+            return m_timestamps[(m_head + index) & m_mask];
+        }
+
+        uint64_t seq = m_head_seq + index;
+        auto it = m_segments.end() - 1;
+        if (seq < it->start)
+        {
+            it = std::upper_bound(m_segments.begin(), m_segments.end(), seq,
+                                  [](uint64_t s, const ClockSegment &segment)
+                                  { return s < segment.start; }) -
+                 1;
+        }
+        return it->t0 + static_cast<double>(seq - it->start) * it->period;
+    }
+
+    // -----------------------------------------------------------------------------
+    // recordTimestamp - Feeds the implicit clock
+    // A timestamp within tolerance of the newest segment's prediction costs
+    // nothing. A segment holding a single sample adopts the observed spacing
+    // as its period (this is also how the nominal period is auto-detected).
+    // Anything else opens a new segment.
+    // -----------------------------------------------------------------------------
+    template <typename T>
+    void TimeSeriesBuffer<T>::recordTimestamp(uint64_t seq, TimestampType timestamp)
+    {
+        if (!m_segments.empty())
+        {
+            ClockSegment &last = m_segments.back();
+            uint64_t offset = seq - last.start;
+            TimestampType predicted = last.t0 + static_cast<double>(offset) * last.period;
+            if (std::abs(timestamp - predicted) <= m_tolerance * last.period)
+            {
+                return;
+            }
+            if (offset == 1 && timestamp > last.t0)
+            {
+                last.period = timestamp - last.t0;
+                m_period = last.period;
+                return;
+            }
+        }
+
+        m_segments.push_back({seq, timestamp, m_period});
+
+        size_t budget = std::max(kMinSegmentBudget, capacity() / kSegmentBudgetDivisor);
+        if (m_segments.size() > budget)
+        {
+            // Too irregular for a clock model; store timestamps from now on
+            switchToExplicit(static_cast<size_t>(seq - m_head_seq));
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+    // storeTimestamp - Writes the timestamp of the sample at a logical index
     // -----------------------------------------------------------------------------
     template <typename T>
-    TimeSeriesBuffer<T>::TimeSeriesBuffer(size_t max_samples, uint64_t window_duration_ms)
-        : m_max_samples(max_samples), m_window_duration_ms(window_duration_ms)
+    void TimeSeriesBuffer<T>::storeTimestamp(size_t logical_index, TimestampType timestamp)
     {
+        if (m_mode == TimestampMode::Implicit)
+        {
+            recordTimestamp(m_head_seq + logical_index, timestamp);
+            if (m_mode == TimestampMode::Implicit)
+            {
+                return;
+            }
+        }
+        m_timestamps[(m_head + logical_index) & m_mask] = timestamp;
+    }
+
+    // -----------------------------------------------------------------------------
+    // pruneSegments - Drops segments that end before the oldest live sample
+    // -----------------------------------------------------------------------------
+    template <typename T>
+    void TimeSeriesBuffer<T>::pruneSegments()
+    {
+        if (m_count == 0)
+        {
+            m_segments.clear();
+            return;
+        }
+
+        size_t dead = 0;
+        while (dead + 1 < m_segments.size() && m_segments[dead + 1].start <= m_head_seq)
+        {
+            ++dead;
+        }
+        if (dead > 0)
+        {
+            m_segments.erase(m_segments.begin(), m_segments.begin() + dead);
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+    // switchToExplicit - Materializes the clock into a timestamp array
+    // -----------------------------------------------------------------------------
+    template <typename T>
+    void TimeSeriesBuffer<T>::switchToExplicit(size_t count)
+    {
+        auto timestamps = std::make_unique<TimestampType[]>(capacity());
+        for (size_t i = 0; i < count; ++i)
+        {
+            timestamps[(m_head + i) & m_mask] = timestampAt(i);
+        }
+
+        m_timestamps = std::move(timestamps);
+        m_mode = TimestampMode::Explicit;
+        m_segments.clear();
+        m_segments.shrink_to_fit();
     }
 
     // -----------------------------------------------------------------------------
     // push - Adds a new timestamped sample
-    // Automatically enforces window constraints after insertion
+    // Only the sample-count limit applies; age-based expiry is the caller's
     // -----------------------------------------------------------------------------
     template <typename T>
     void TimeSeriesBuffer<T>::push(TimestampType timestamp, T value)
     {
-        m_samples.emplace_back(timestamp, value);
-        enforceWindowConstraints();
+        if (isFull())
+        {
+            // Sample-count window: overwrite the oldest slot
+            popFront();
+        }
+        else if (m_count == capacity())
+        {
+            reserve(capacity() * 2);
+        }
+
+        storeTimestamp(m_count, timestamp);
+        m_values[(m_head + m_count) & m_mask] = value;
+        ++m_count;
     }
 
     // -----------------------------------------------------------------------------
-    // removeOlderThan - Removes samples older than cutoff timestamp
+    // pushBatch - Adds a block of samples with at most one reallocation
     // -----------------------------------------------------------------------------
     template <typename T>
-    size_t TimeSeriesBuffer<T>::removeOlderThan(TimestampType cutoff_timestamp)
+    void TimeSeriesBuffer<T>::pushBatch(const TimestampType *timestamps, const T *values, size_t count)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        if (m_max_samples > 0)
+        {
+            // Only the newest max_samples of the combined data can survive
+            if (count >= m_max_samples)
+            {
+                size_t skip = count - m_max_samples;
+                timestamps += skip;
+                values += skip;
+                count = m_max_samples;
+                clear();
+            }
+            else if (m_count + count > m_max_samples)
+            {
+                popFront(m_count + count - m_max_samples);
+            }
+        }
+
+        reserve(m_count + count);
+
+        // Copy in (at most) two contiguous pieces: up to the wrap point, then from 0
+        size_t start = (m_head + m_count) & m_mask;
+        size_t firstPart = std::min(count, capacity() - start);
+        if (m_mode == TimestampMode::Explicit)
+        {
+            std::copy(timestamps, timestamps + firstPart, m_timestamps.get() + start);
+            std::copy(timestamps + firstPart, timestamps + count, m_timestamps.get());
+        }
+        else
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                storeTimestamp(m_count + i, timestamps[i]);
+            }
+        }
+        std::copy(values, values + firstPart, m_values.get() + start);
+        std::copy(values + firstPart, values + count, m_values.get());
+        m_count += count;
+    }
+
+    // -----------------------------------------------------------------------------
+    // countOlderThan - Finds the first sample >= cutoff
+    // Explicit mode binary-searches the (at most two) sorted physical runs.
+    // Implicit mode solves t0 + k * period >= cutoff per clock segment.
+    // -----------------------------------------------------------------------------
+    template <typename T>
+    size_t TimeSeriesBuffer<T>::countOlderThan(TimestampType cutoff_timestamp) const noexcept
     {
-        size_t removed = 0;
-        while (!m_samples.empty() && m_samples.front().first < cutoff_timestamp)
+        if (m_count == 0)
         {
-            m_samples.pop_front();
-            ++removed;
+            return 0;
         }
+
+        if (m_mode == TimestampMode::Implicit)
+        {
+            uint64_t endSeq = m_head_seq + m_count;
+            for (size_t s = 0; s < m_segments.size(); ++s)
+            {
+                const ClockSegment &segment = m_segments[s];
+                uint64_t first = std::max(segment.start, m_head_seq);
+                uint64_t last = (s + 1 < m_segments.size()) ? m_segments[s + 1].start : endSeq;
+
+                auto timeOf = [&segment](uint64_t seq)
+                { return segment.t0 + static_cast<double>(seq - segment.start) * segment.period; };
+
+                if (timeOf(first) >= cutoff_timestamp)
+                {
+                    return static_cast<size_t>(first - m_head_seq);
+                }
+                if (segment.period <= 0.0)
+                {
+                    continue; // Every sample in the segment shares t0 < cutoff
+                }
+
+                // First offset whose time reaches the cutoff; nudge away rounding error
+                double steps = std::ceil((cutoff_timestamp - segment.t0) / segment.period);
+                double span = static_cast<double>(last - segment.start);
+                uint64_t seq = segment.start + static_cast<uint64_t>(std::min(std::max(0.0, steps), span));
+                while (seq > first && timeOf(seq - 1) >= cutoff_timestamp)
+                {
+                    --seq;
+                }
+                while (seq < last && timeOf(seq) < cutoff_timestamp)
+                {
+                    ++seq;
+                }
+                if (seq < last)
+                {
+                    return static_cast<size_t>(seq - m_head_seq);
+                }
+            }
+            return m_count;
+        }
+
+        const TimestampType *ts = m_timestamps.get();
+        size_t firstLen = std::min(m_count, capacity() - m_head);
+
+        const TimestampType *firstBegin = ts + m_head;
+        const TimestampType *firstEnd = firstBegin + firstLen;
+        const TimestampType *pos = std::lower_bound(firstBegin, firstEnd, cutoff_timestamp);
+        if (pos != firstEnd)
+        {
+            return static_cast<size_t>(pos - firstBegin);
+        }
+
+        const TimestampType *secondEnd = ts + (m_count - firstLen);
+        pos = std::lower_bound(ts, secondEnd, cutoff_timestamp);
+        return firstLen + static_cast<size_t>(pos - ts);
+    }
+
+    // -----------------------------------------------------------------------------
+    // removeOlderThan - Removes samples older than cutoff timestamp
+    // -----------------------------------------------------------------------------
+    template <typename T>
+    size_t TimeSeriesBuffer<T>::removeOlderThan(TimestampType cutoff_timestamp)
+    {
+        size_t removed = countOlderThan(cutoff_timestamp);
+        popFront(removed);
         return removed;
     }
 
@@ -41,26 +360,26 @@ namespace dsp::utils
     // front - Gets the oldest sample (does not remove)
     // -----------------------------------------------------------------------------
     template <typename T>
-    const typename TimeSeriesBuffer<T>::Sample &TimeSeriesBuffer<T>::front() const
+    typename TimeSeriesBuffer<T>::Sample TimeSeriesBuffer<T>::front() const
     {
-        if (m_samples.empty())
+        if (m_count == 0)
         {
             throw std::out_of_range("TimeSeriesBuffer::front() called on empty buffer");
         }
-        return m_samples.front();
+        return {timestampAt(0), valueAt(0)};
     }
 
     // -----------------------------------------------------------------------------
     // back - Gets the newest sample (does not remove)
     // -----------------------------------------------------------------------------
     template <typename T>
-    const typename TimeSeriesBuffer<T>::Sample &TimeSeriesBuffer<T>::back() const
+    typename TimeSeriesBuffer<T>::Sample TimeSeriesBuffer<T>::back() const
     {
-        if (m_samples.empty())
+        if (m_count == 0)
         {
             throw std::out_of_range("TimeSeriesBuffer::back() called on empty buffer");
         }
-        return m_samples.back();
+        return {timestampAt(m_count - 1), valueAt(m_count - 1)};
     }
 
     // -----------------------------------------------------------------------------
@@ -69,11 +388,46 @@ namespace dsp::utils
     template <typename T>
     void TimeSeriesBuffer<T>::popFront()
     {
-        if (m_samples.empty())
+        if (m_count == 0)
         {
             throw std::out_of_range("TimeSeriesBuffer::popFront() called on empty buffer");
         }
-        m_samples.pop_front();
+        m_head = (m_head + 1) & m_mask;
+        --m_count;
+        ++m_head_seq;
+        pruneSegments();
+    }
+
+    // -----------------------------------------------------------------------------
+    // popFront(n) - Removes the oldest n samples by advancing the head
+    // -----------------------------------------------------------------------------
+    template <typename T>
+    void TimeSeriesBuffer<T>::popFront(size_t n)
+    {
+        if (n > m_count)
+        {
+            throw std::out_of_range("TimeSeriesBuffer::popFront() called with n > size()");
+        }
+        m_head = (m_head + n) & m_mask;
+        m_count -= n;
+        m_head_seq += n;
+        pruneSegments();
+    }
+
+    // -----------------------------------------------------------------------------
+    // valueSpans - Splits a logical range into (at most) two contiguous spans
+    // -----------------------------------------------------------------------------
+    template <typename T>
+    std::pair<typename TimeSeriesBuffer<T>::Span, typename TimeSeriesBuffer<T>::Span>
+    TimeSeriesBuffer<T>::valueSpans(size_t first, size_t count) const noexcept
+    {
+        count = (first < m_count) ? std::min(count, m_count - first) : 0;
+        size_t start = (m_head + first) & m_mask;
+        size_t firstLen = std::min(count, capacity() - start);
+
+        Span a{m_values.get() + start, firstLen};
+        Span b{m_values.get(), count - firstLen};
+        return {a, b};
     }
 
     // -----------------------------------------------------------------------------
@@ -82,7 +436,7 @@ namespace dsp::utils
     template <typename T>
     size_t TimeSeriesBuffer<T>::size() const noexcept
     {
-        return m_samples.size();
+        return m_count;
     }
 
     // -----------------------------------------------------------------------------
@@ -91,16 +445,32 @@ namespace dsp::utils
     template <typename T>
     bool TimeSeriesBuffer<T>::empty() const noexcept
     {
-        return m_samples.empty();
+        return m_count == 0;
     }
 
     // -----------------------------------------------------------------------------
-    // clear - Removes all samples
+    // clear - Removes all samples (keeps the allocation and the learned period)
     // -----------------------------------------------------------------------------
     template <typename T>
     void TimeSeriesBuffer<T>::clear() noexcept
     {
-        m_samples.clear();
+        m_head = 0;
+        m_count = 0;
+        m_head_seq = 0;
+        m_segments.clear();
+    }
+
+    // -----------------------------------------------------------------------------
+    // reserveClock - Sizes the segment list for the most segments the clock keeps
+    // -----------------------------------------------------------------------------
+    template <typename T>
+    void TimeSeriesBuffer<T>::reserveClock()
+    {
+        if (m_mode == TimestampMode::Implicit)
+        {
+            // recordTimestamp() switches to Explicit once the list exceeds the budget
+            m_segments.reserve(std::max(kMinSegmentBudget, capacity() / kSegmentBudgetDivisor) + 1);
+        }
     }
 
     // -----------------------------------------------------------------------------
@@ -109,7 +479,27 @@ namespace dsp::utils
     template <typename T>
     std::vector<typename TimeSeriesBuffer<T>::Sample> TimeSeriesBuffer<T>::toVector() const
     {
-        return std::vector<Sample>(m_samples.begin(), m_samples.end());
+        std::vector<Sample> result;
+        result.reserve(m_count);
+        for (size_t i = 0; i < m_count; ++i)
+        {
+            result.emplace_back(timestampAt(i), valueAt(i));
+        }
+        return result;
+    }
+
+    // -----------------------------------------------------------------------------
+    // valuesToVector - Exports the values only
+    // -----------------------------------------------------------------------------
+    template <typename T>
+    std::vector<T> TimeSeriesBuffer<T>::valuesToVector() const
+    {
+        std::vector<T> result;
+        result.reserve(m_count);
+        auto spans = valueSpans(0, m_count);
+        result.insert(result.end(), spans.first.data, spans.first.data + spans.first.size);
+        result.insert(result.end(), spans.second.data, spans.second.data + spans.second.size);
+        return result;
     }
 
     // -----------------------------------------------------------------------------
@@ -118,10 +508,37 @@ namespace dsp::utils
     template <typename T>
     void TimeSeriesBuffer<T>::fromVector(const std::vector<Sample> &samples)
     {
-        m_samples.clear();
+        clear();
         for (const auto &sample : samples)
         {
-            m_samples.push_back(sample);
+            push(sample.first, sample.second);
+        }
+    }
+
+    // -----------------------------------------------------------------------------
+    // fromValues - Restores values saved without timestamps
+    // -----------------------------------------------------------------------------
+    template <typename T>
+    void TimeSeriesBuffer<T>::fromValues(const std::vector<T> &values, TimestampType timestamp)
+    {
+        clear();
+        size_t count = values.size();
+        size_t skip = (m_max_samples > 0 && count > m_max_samples) ? count - m_max_samples : 0;
+        reserve(count - skip);
+        for (size_t i = skip; i < count; ++i)
+        {
+            m_values[i - skip] = values[i];
+        }
+        m_count = count - skip;
+
+        if (m_mode == TimestampMode::Explicit)
+        {
+            std::fill(m_timestamps.get(), m_timestamps.get() + m_count, timestamp);
+        }
+        else if (m_count > 0)
+        {
+            // One flat segment; the next push starts a fresh one
+            m_segments.push_back({0, timestamp, 0.0});
         }
     }
 
@@ -129,70 +546,55 @@ namespace dsp::utils
     // getTimeSpan - Returns time difference between newest and oldest sample
     // -----------------------------------------------------------------------------
     template <typename T>
-    uint64_t TimeSeriesBuffer<T>::getTimeSpan() const noexcept
+    typename TimeSeriesBuffer<T>::TimestampType TimeSeriesBuffer<T>::getTimeSpan() const noexcept
     {
-        if (m_samples.size() < 2)
+        if (m_count < 2)
         {
             return 0;
         }
-        return m_samples.back().first - m_samples.front().first;
+        return timestampAt(m_count - 1) - timestampAt(0);
     }
 
     // -----------------------------------------------------------------------------
     // begin/end - Iterator access
     // -----------------------------------------------------------------------------
     template <typename T>
-    typename std::deque<typename TimeSeriesBuffer<T>::Sample>::const_iterator
-    TimeSeriesBuffer<T>::begin() const noexcept
+    typename TimeSeriesBuffer<T>::const_iterator TimeSeriesBuffer<T>::begin() const noexcept
     {
-        return m_samples.begin();
+        return const_iterator(this, 0);
     }
 
     template <typename T>
-    typename std::deque<typename TimeSeriesBuffer<T>::Sample>::const_iterator
-    TimeSeriesBuffer<T>::end() const noexcept
+    typename TimeSeriesBuffer<T>::const_iterator TimeSeriesBuffer<T>::end() const noexcept
     {
-        return m_samples.end();
+        return const_iterator(this, m_count);
     }
 
     // -----------------------------------------------------------------------------
-    // getMaxSamples - Returns the max sample count constraint
+    // getClockExceptionCount - Segments beyond the first (Implicit mode)
     // -----------------------------------------------------------------------------
     template <typename T>
-    size_t TimeSeriesBuffer<T>::getMaxSamples() const noexcept
+    size_t TimeSeriesBuffer<T>::getClockExceptionCount() const noexcept
     {
-        return m_max_samples;
+        return m_segments.empty() ? 0 : m_segments.size() - 1;
     }
 
     // -----------------------------------------------------------------------------
-    // getWindowDuration - Returns the time window constraint
+    // getMaxSamples - Returns the max sample count constraint
     // -----------------------------------------------------------------------------
     template <typename T>
-    uint64_t TimeSeriesBuffer<T>::getWindowDuration() const noexcept
+    size_t TimeSeriesBuffer<T>::getMaxSamples() const noexcept
     {
-        return m_window_duration_ms;
+        return m_max_samples;
     }
 
     // -----------------------------------------------------------------------------
-    // enforceWindowConstraints - Private helper to maintain window limits
-    // Called automatically after each push()
+    // getWindowDuration - Returns the time window constraint
     // -----------------------------------------------------------------------------
     template <typename T>
-    void TimeSeriesBuffer<T>::enforceWindowConstraints()
+    double TimeSeriesBuffer<T>::getWindowDuration() const noexcept
     {
-        // Enforce time-based window (if enabled)
-        if (m_window_duration_ms > 0 && m_samples.size() > 1)
-        {
-            TimestampType newest_timestamp = m_samples.back().first;
-            TimestampType cutoff = newest_timestamp - m_window_duration_ms;
-            removeOlderThan(cutoff);
-        }
-
-        // Enforce sample-count window (if enabled)
-        while (m_max_samples > 0 && m_samples.size() > m_max_samples)
-        {
-            m_samples.pop_front();
-        }
+        return m_window_duration_ms;
     }
 
     // -----------------------------------------------------------------------------
@@ -201,5 +603,6 @@ namespace dsp::utils
     template class TimeSeriesBuffer<int>;
     template class TimeSeriesBuffer<float>;
     template class TimeSeriesBuffer<double>;
+    template class TimeSeriesBuffer<bool>;
 
 } // namespace dsp::utils
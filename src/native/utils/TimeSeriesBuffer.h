@@ -1,21 +1,48 @@
 #pragma once
-#include <deque>
 #include <utility>
 #include <vector>
+#include <memory>
+#include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <stdexcept>
 
 namespace dsp::utils
 {
+    /**
+     * @brief How a TimeSeriesBuffer stores sample timestamps.
+     */
+    enum class TimestampMode
+    {
+        Implicit, // (t0, period) clock + exception list; falls back to Explicit if too irregular
+        Explicit  // One stored timestamp per sample
+    };
+
     /**
      * @brief A time-series buffer that stores timestamped samples.
      *
      * This buffer replaces CircularBuffer for time-aware processing.
-     * It stores pairs of (timestamp, value) and supports both:
+     * It stores (timestamp, value) samples and supports both:
      * - Sample-based windows (fixed number of samples)
      * - Time-based windows (fixed duration in milliseconds)
      *
-     * Uses std::deque for efficient front/back operations.
+     * Storage is a structure-of-arrays ring: timestamps and values live in two
+     * separate contiguous arrays sharing one power-of-two capacity, so index
+     * wrapping is a mask and each array can be scanned with vector loads.
+     * The ring doubles when it fills up (unless max_samples caps it, in which
+     * case the oldest sample is overwritten).
+     *
+     * Timestamps are expected to be non-decreasing, which lets time-based
+     * expiration locate the cutoff with a binary search instead of a
+     * per-sample pop loop.
+     *
+     * In Implicit mode (the default) no per-sample timestamp is stored at all.
+     * Timestamps are described by clock segments (first sample, t0, period):
+     * a push that lands within tolerance of the current segment's prediction
+     * costs nothing, while gaps, jitter beyond tolerance, or rate changes open
+     * a new segment (the "exception list"). Uniform streams therefore keep a
+     * single segment. If a stream is so irregular that segments pile up, the
+     * buffer materializes explicit timestamps and stays in Explicit mode.
      *
      * @tparam T The numeric type (e.g., float, double).
      */
@@ -23,28 +50,113 @@ namespace dsp::utils
     class TimeSeriesBuffer
     {
     public:
-        using TimestampType = uint64_t;
+        using TimestampType = double;
         using Sample = std::pair<TimestampType, T>;
 
+        /**
+         * @brief A contiguous view into one of the ring's arrays.
+         *
+         * A logical range of the ring maps onto at most two of these
+         * (before and after the wrap point).
+         */
+        struct Span
+        {
+            const T *data = nullptr;
+            size_t size = 0;
+        };
+
+        /**
+         * @brief Forward iterator over samples, oldest first.
+         */
+        class const_iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Sample;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = Sample;
+
+            const_iterator(const TimeSeriesBuffer *owner, size_t index) : m_owner(owner), m_index(index) {}
+
+            Sample operator*() const { return {m_owner->timestampAt(m_index), m_owner->valueAt(m_index)}; }
+            const_iterator &operator++()
+            {
+                ++m_index;
+                return *this;
+            }
+            const_iterator operator++(int)
+            {
+                const_iterator tmp = *this;
+                ++m_index;
+                return tmp;
+            }
+            bool operator==(const const_iterator &other) const { return m_index == other.m_index && m_owner == other.m_owner; }
+            bool operator!=(const const_iterator &other) const { return !(*this == other); }
+
+        private:
+            const TimeSeriesBuffer *m_owner;
+            size_t m_index;
+        };
+
         /**
          * @brief Constructs a time-series buffer.
          * @param max_samples Maximum number of samples (for sample-based mode, 0 = unlimited)
-         * @param window_duration_ms Maximum time window in milliseconds (for time-based mode, 0 = disabled)
+         * @param window_duration_ms Time window in milliseconds, reported by getWindowDuration() (0 = disabled)
+         * @param mode Timestamp storage mode (Implicit by default)
+         * @param period_ms Nominal sample period for the implicit clock (0 = detect from the first two samples)
+         * @param tolerance Allowed deviation from the implicit clock, as a fraction of the period
          */
-        explicit TimeSeriesBuffer(size_t max_samples = 0, uint64_t window_duration_ms = 0);
+        explicit TimeSeriesBuffer(size_t max_samples = 0,
+                                  double window_duration_ms = 0.0,
+                                  TimestampMode mode = TimestampMode::Implicit,
+                                  double period_ms = 0.0,
+                                  double tolerance = 0.01);
+
+        // Disable copy (owning raw arrays), enable move
+        TimeSeriesBuffer(const TimeSeriesBuffer &) = delete;
+        TimeSeriesBuffer &operator=(const TimeSeriesBuffer &) = delete;
+        TimeSeriesBuffer(TimeSeriesBuffer &&) noexcept = default;
+        TimeSeriesBuffer &operator=(TimeSeriesBuffer &&) noexcept = default;
 
         /**
          * @brief Adds a new timestamped sample.
          *
-         * Automatically removes old samples based on window constraints:
-         * - If max_samples > 0: removes oldest samples beyond the limit
-         * - If window_duration_ms > 0: removes samples older than (newest_timestamp - window_duration_ms)
+         * If max_samples > 0 and the buffer is full, the oldest sample is
+         * overwritten. Samples are never expired by age here: in Implicit
+         * mode the stored clock only approximates the pushed timestamp, so
+         * the caller computes the cutoff from the real timestamp, takes the
+         * expiring values out of its running statistics, and discards them
+         * with popFront(countOlderThan(cutoff)).
          *
          * @param timestamp The timestamp in milliseconds (or sample index)
          * @param value The sample value
          */
         void push(TimestampType timestamp, T value);
 
+        /**
+         * @brief Adds a block of timestamped samples in one go.
+         *
+         * Grows the ring at most once and copies each array with at most two
+         * contiguous block copies. Like push(), it only enforces max_samples.
+         *
+         * @param timestamps Pointer to count timestamps (non-decreasing)
+         * @param values Pointer to count values
+         * @param count Number of samples to add
+         */
+        void pushBatch(const TimestampType *timestamps, const T *values, size_t count);
+
+        /**
+         * @brief Counts samples older than the specified timestamp (binary search).
+         *
+         * Lets callers inspect the about-to-expire values (e.g. to update
+         * running statistics) before discarding them with popFront(n).
+         *
+         * @param cutoff_timestamp Samples with timestamp < cutoff_timestamp are counted
+         * @return size_t Number of leading samples older than the cutoff
+         */
+        size_t countOlderThan(TimestampType cutoff_timestamp) const noexcept;
+
         /**
          * @brief Removes samples older than the specified timestamp.
          * @param cutoff_timestamp Samples with timestamp < cutoff_timestamp will be removed
@@ -54,17 +166,17 @@ namespace dsp::utils
 
         /**
          * @brief Gets the oldest sample without removing it.
-         * @return const Sample& Reference to the oldest (front) sample
+         * @return Sample The oldest (front) sample
          * @throws std::out_of_range if buffer is empty
          */
-        const Sample &front() const;
+        Sample front() const;
 
         /**
          * @brief Gets the newest sample without removing it.
-         * @return const Sample& Reference to the newest (back) sample
+         * @return Sample The newest (back) sample
          * @throws std::out_of_range if buffer is empty
          */
-        const Sample &back() const;
+        Sample back() const;
 
         /**
          * @brief Removes the oldest sample.
@@ -72,46 +184,105 @@ namespace dsp::utils
          */
         void popFront();
 
+        /**
+         * @brief Removes the oldest n samples (O(1)).
+         * @throws std::out_of_range if n > size()
+         */
+        void popFront(size_t n);
+
+        /**
+         * @brief Logical (oldest = 0) element access without bounds checks.
+         */
+        T valueAt(size_t index) const noexcept { return m_values[(m_head + index) & m_mask]; }
+        TimestampType timestampAt(size_t index) const noexcept;
+
+        /**
+         * @brief Returns the values in logical range [first, first + count) as
+         * at most two contiguous spans, suitable for SIMD reductions.
+         */
+        std::pair<Span, Span> valueSpans(size_t first, size_t count) const noexcept;
+
         /**
          * @brief Gets the current number of samples in the buffer.
          * @return size_t The number of samples
          */
         size_t size() const noexcept;
 
+        /**
+         * @brief Gets the allocated ring capacity (always a power of two).
+         */
+        size_t capacity() const noexcept { return m_mask + 1; }
+
         /**
          * @brief Checks if the buffer is empty.
          * @return bool True if empty
          */
         bool empty() const noexcept;
 
+        /**
+         * @brief Checks if the buffer holds max_samples samples (never true when unlimited).
+         */
+        bool isFull() const noexcept { return m_max_samples > 0 && m_count >= m_max_samples; }
+
         /**
          * @brief Clears all samples from the buffer.
          */
         void clear() noexcept;
 
+        /**
+         * @brief Preallocates the implicit clock's segment list up to its
+         * budget, so pushes into a bounded buffer never allocate (short of
+         * a switch to Explicit mode, which allocates the timestamp array).
+         */
+        void reserveClock();
+
         /**
          * @brief Exports all samples as a vector.
          * @return std::vector<Sample> All timestamp-value pairs
          */
         std::vector<Sample> toVector() const;
 
+        /**
+         * @brief Exports only the values (oldest first).
+         */
+        std::vector<T> valuesToVector() const;
+
         /**
          * @brief Restores buffer from a vector of samples.
          * @param samples Vector of timestamp-value pairs to restore
          */
         void fromVector(const std::vector<Sample> &samples);
 
+        /**
+         * @brief Restores values that were saved without timestamps.
+         *
+         * Every value is stamped with the given timestamp, so the restored
+         * samples stay ordered before any newly pushed sample.
+         */
+        void fromValues(const std::vector<T> &values, TimestampType timestamp = 0.0);
+
         /**
          * @brief Gets the time span of the buffer (newest - oldest timestamp).
-         * @return uint64_t Time span in milliseconds (0 if empty or single sample)
+         * @return double Time span in milliseconds (0 if empty or single sample)
          */
-        uint64_t getTimeSpan() const noexcept;
+        TimestampType getTimeSpan() const noexcept;
 
         /**
          * @brief Provides iterator access to samples (const).
          */
-        typename std::deque<Sample>::const_iterator begin() const noexcept;
-        typename std::deque<Sample>::const_iterator end() const noexcept;
+        const_iterator begin() const noexcept;
+        const_iterator end() const noexcept;
+
+        /**
+         * @brief True while timestamps are represented by the implicit clock.
+         */
+        bool isImplicitClock() const noexcept { return m_mode == TimestampMode::Implicit; }
+
+        /**
+         * @brief Number of clock exceptions (segments beyond the first) covering
+         * the live samples. Always 0 in Explicit mode.
+         */
+        size_t getClockExceptionCount() const noexcept;
 
         /**
          * @brief Gets the maximum sample count constraint.
@@ -121,20 +292,63 @@ namespace dsp::utils
 
         /**
          * @brief Gets the time window duration constraint.
-         * @return uint64_t Window duration in milliseconds (0 = disabled)
+         * @return double Window duration in milliseconds (0 = disabled)
          */
-        uint64_t getWindowDuration() const noexcept;
+        double getWindowDuration() const noexcept;
 
     private:
-        std::deque<Sample> m_samples;
+        /**
+         * @brief One run of the implicit clock: sample seq has timestamp
+         * t0 + (seq - start) * period until the next segment begins.
+         */
+        struct ClockSegment
+        {
+            uint64_t start;
+            TimestampType t0;
+            TimestampType period;
+        };
+
+        std::unique_ptr<TimestampType[]> m_timestamps; // Explicit mode only
+        std::unique_ptr<T[]> m_values;
+        size_t m_mask;  // capacity - 1
+        size_t m_head;  // Physical index of the oldest sample
+        size_t m_count; // Number of live samples
         size_t m_max_samples;
-        uint64_t m_window_duration_ms;
+        double m_window_duration_ms;
+
+        TimestampMode m_mode;
+        std::vector<ClockSegment> m_segments; // Implicit mode: oldest first
+        uint64_t m_head_seq = 0;              // Sequence number of the oldest live sample
+        TimestampType m_period;               // Nominal period for new segments (0 = unknown)
+        double m_tolerance;
+
+        /**
+         * @brief Feeds the implicit clock with the timestamp of sample seq.
+         * Extends the newest segment, or opens a new one (an exception).
+         */
+        void recordTimestamp(uint64_t seq, TimestampType timestamp);
+
+        /**
+         * @brief Stores the timestamp of the sample at logical index, in
+         * whichever representation is active.
+         */
+        void storeTimestamp(size_t logical_index, TimestampType timestamp);
+
+        /**
+         * @brief Drops clock segments that no longer cover any live sample.
+         */
+        void pruneSegments();
+
+        /**
+         * @brief Materializes the first count timestamps and switches to Explicit mode.
+         */
+        void switchToExplicit(size_t count);
 
         /**
-         * @brief Enforces window constraints by removing old samples.
-         * Called automatically after push().
+         * @brief Reallocates so that at least min_capacity samples fit.
+         * Live samples are moved to the front of the new arrays.
          */
-        void enforceWindowConstraints();
+        void reserve(size_t min_capacity);
     };
 
 } // namespace dsp::utils
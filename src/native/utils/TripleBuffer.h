@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace dsp::utils
+{
+    /**
+     * @brief Wait-free hand-over of the latest value from one writer thread
+     * to one reader thread.
+     *
+     * Three slots: the writer fills back() and publish()es it, the reader
+     * calls update() and reads front(). Neither side ever blocks or
+     * allocates, and the reader always sees the most recent complete value
+     * (values published in between are skipped). The slots are assigned
+     * once, through slot(), before either thread starts using the buffer.
+     */
+    template <typename T>
+    class TripleBuffer
+    {
+    public:
+        TripleBuffer() = default;
+        TripleBuffer(const TripleBuffer &) = delete;
+        TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+        /**
+         * @brief Direct access for setup (not thread-safe).
+         */
+        T &slot(size_t index) { return m_slots[index]; }
+
+        // ---- Writer side
+
+        T &back() { return m_slots[m_back]; }
+
+        /**
+         * @brief Makes back() the latest value and hands the writer a free slot.
+         */
+        void publish()
+        {
+            m_back = m_middle.exchange(static_cast<uint8_t>(m_back | kFresh), std::memory_order_acq_rel) & kIndex;
+        }
+
+        // ---- Reader side
+
+        /**
+         * @brief Whether a value newer than front() has been published.
+         */
+        bool hasFresh() const
+        {
+            return (m_middle.load(std::memory_order_acquire) & kFresh) != 0;
+        }
+
+        /**
+         * @brief Swaps the latest published value into front().
+         * @return false (and front() unchanged) if nothing new was published.
+         */
+        bool update()
+        {
+            if (!hasFresh())
+            {
+                return false;
+            }
+            m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & kIndex;
+            return true;
+        }
+
+        T &front() { return m_slots[m_front]; }
+        const T &front() const { return m_slots[m_front]; }
+
+    private:
+        static constexpr uint8_t kIndex = 0x3;
+        static constexpr uint8_t kFresh = 0x4;
+
+        T m_slots[3];
+        uint8_t m_front = 0;                // Reader's slot
+        std::atomic<uint8_t> m_middle{1};   // Shared slot (| kFresh once published)
+        uint8_t m_back = 2;                 // Writer's slot
+    };
+
+} // namespace dsp::utils
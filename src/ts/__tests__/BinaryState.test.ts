@@ -0,0 +1,308 @@
+import { describe, test } from "node:test";
+import assert from "node:assert/strict";
+import {
+  createDspPipeline,
+  describeSnapshot,
+  DspProcessor,
+} from "../bindings.js";
+
+const DEFAULT_OPTIONS = { channels: 4, sampleRate: 1000 };
+
+function buildPipeline(): DspProcessor {
+  return createDspPipeline()
+    .MovingAverage({ mode: "moving", windowSize: 64 })
+    .Rectify({ mode: "full" })
+    .Rms({ mode: "moving", windowSize: 32 })
+    .MovingMedian({ windowSize: 9 })
+    .WillisonAmplitude({ windowSize: 16, threshold: 0.1 })
+    .SlopeSignChange({ windowSize: 16, threshold: 0.05 })
+    .WaveformLength({ windowSize: 16 });
+}
+
+function randomBuffer(length: number): Float32Array {
+  return new Float32Array(length).map(() => Math.random() * 2 - 1);
+}
+
+describe("Binary State Snapshots", () => {
+  test("should round-trip every stage and continue identically", async () => {
+    const original = buildPipeline();
+    await original.process(randomBuffer(4 * 200), DEFAULT_OPTIONS);
+
+    const snapshot = await original.saveStateBinary();
+    assert.ok(snapshot instanceof Uint8Array);
+
+    const restored = buildPipeline();
+    assert.strictEqual(await restored.loadStateBinary(snapshot), true);
+
+    const next = randomBuffer(4 * 50);
+    const a = await original.process(new Float32Array(next), DEFAULT_OPTIONS);
+    const b = await restored.process(new Float32Array(next), DEFAULT_OPTIONS);
+    assert.deepStrictEqual(Array.from(b), Array.from(a));
+  });
+
+  test("should accept an ArrayBuffer", async () => {
+    const original = createDspPipeline().MovingAverage({
+      mode: "moving",
+      windowSize: 3,
+    });
+    await original.process(new Float32Array([1, 2, 3]), { channels: 1 });
+    const snapshot = await original.saveStateBinary();
+    const arrayBuffer = snapshot.buffer.slice(
+      snapshot.byteOffset,
+      snapshot.byteOffset + snapshot.byteLength
+    );
+
+    const restored = createDspPipeline().MovingAverage({
+      mode: "moving",
+      windowSize: 3,
+    });
+    await restored.loadStateBinary(arrayBuffer);
+
+    const out = await restored.process(new Float32Array([6]), { channels: 1 });
+    assert.ok(Math.abs(out[0] - (2 + 3 + 6) / 3) < 1e-5);
+  });
+
+  test("should be much smaller than the JSON state", async () => {
+    const pipeline = createDspPipeline().MovingAverage({
+      mode: "moving",
+      windowSize: 1000,
+    });
+    await pipeline.process(randomBuffer(8 * 1000), {
+      channels: 8,
+      sampleRate: 1000,
+    });
+
+    const json = await pipeline.saveState();
+    const snapshot = await pipeline.saveStateBinary();
+    assert.ok(
+      snapshot.byteLength * 2 < json.length,
+      `binary ${snapshot.byteLength} bytes vs JSON ${json.length} chars`
+    );
+  });
+
+  test("should reject a corrupted snapshot", async () => {
+    const pipeline = createDspPipeline().MovingAverage({
+      mode: "moving",
+      windowSize: 4,
+    });
+    await pipeline.process(new Float32Array([1, 2, 3, 4]), { channels: 1 });
+    const snapshot = await pipeline.saveStateBinary();
+
+    const corrupted = Buffer.from(snapshot);
+    corrupted[corrupted.length - 10] ^= 0xff;
+    await assert.rejects(() => pipeline.loadStateBinary(corrupted), /checksum/);
+
+    await assert.rejects(
+      () => pipeline.loadStateBinary(snapshot.subarray(0, 10)),
+      /too small/
+    );
+  });
+
+  test("should reject a snapshot from a different pipeline", async () => {
+    const source = createDspPipeline().Rms({ mode: "moving", windowSize: 4 });
+    await source.process(new Float32Array([1, 2]), { channels: 1 });
+    const snapshot = await source.saveStateBinary();
+
+    const target = createDspPipeline().MovingAverage({
+      mode: "moving",
+      windowSize: 4,
+    });
+    await assert.rejects(() => target.loadStateBinary(snapshot), /type mismatch/);
+
+    const resized = createDspPipeline().Rms({ mode: "moving", windowSize: 8 });
+    await assert.rejects(
+      () => resized.loadStateBinary(snapshot),
+      /Window size mismatch/
+    );
+  });
+
+  test("should produce a loadable checkpoint while processing continues", async () => {
+    const pipeline = buildPipeline();
+    await pipeline.process(randomBuffer(4 * 100), DEFAULT_OPTIONS);
+
+    // Checkpoint and process concurrently; the capture lands between chunks
+    const [snapshot] = await Promise.all([
+      pipeline.checkpoint(),
+      pipeline.process(randomBuffer(4 * 100), DEFAULT_OPTIONS),
+    ]);
+
+    const restored = buildPipeline();
+    assert.strictEqual(await restored.loadStateBinary(snapshot), true);
+    assert.strictEqual(
+      restored.listState().stages.length,
+      pipeline.listState().stages.length
+    );
+
+    // A quiescent checkpoint matches saveStateBinary apart from the header
+    // (timestamp and generation)
+    const a = await pipeline.checkpoint();
+    const b = await pipeline.saveStateBinary();
+    assert.strictEqual(a.byteLength, b.byteLength);
+    assert.deepStrictEqual(a.subarray(36, -4), b.subarray(36, -4));
+  });
+
+  test("should restore from a full base plus delta checkpoints", async () => {
+    const options = { channels: 4, sampleRate: 1000 };
+    const pipeline = buildPipeline().MovingAverage({
+      mode: "moving",
+      windowSize: 1024,
+    });
+    await pipeline.process(randomBuffer(4 * 2048), options);
+
+    const base = await pipeline.checkpoint({ delta: true });
+    const chain: Buffer[] = [];
+    for (let i = 0; i < 3; i++) {
+      await pipeline.process(randomBuffer(4 * 128), options);
+      chain.push(await pipeline.checkpoint({ delta: true }));
+    }
+
+    const baseInfo = describeSnapshot(base);
+    assert.strictEqual(baseInfo.delta, false);
+    chain.forEach((delta, i) => {
+      const info = describeSnapshot(delta);
+      assert.strictEqual(info.delta, true);
+      assert.strictEqual(info.generation, baseInfo.generation + i + 1);
+      assert.strictEqual(info.baseGeneration, info.generation - 1);
+      // Only the 128 new samples per channel, not the 1024-sample window
+      assert.ok(
+        delta.byteLength * 4 < base.byteLength,
+        `delta ${delta.byteLength} bytes vs base ${base.byteLength}`
+      );
+    });
+
+    const restored = buildPipeline().MovingAverage({
+      mode: "moving",
+      windowSize: 1024,
+    });
+    await restored.loadStateBinary(base);
+    for (const delta of chain) {
+      await restored.loadStateBinary(delta);
+    }
+
+    const full = await pipeline.saveStateBinary();
+    const rebuilt = await restored.saveStateBinary();
+    assert.deepStrictEqual(rebuilt.subarray(36, -4), full.subarray(36, -4));
+
+    const next = randomBuffer(4 * 64);
+    const a = await pipeline.process(new Float32Array(next), options);
+    const b = await restored.process(new Float32Array(next), options);
+    assert.deepStrictEqual(Array.from(b), Array.from(a));
+  });
+
+  test("should keep the delta chain across plain saves", async () => {
+    const options = { channels: 2, sampleRate: 1000 };
+    const build = () =>
+      createDspPipeline().MovingAverage({ mode: "moving", windowSize: 256 });
+    const pipeline = build();
+    await pipeline.process(randomBuffer(2 * 512), options);
+
+    const chain = [await pipeline.checkpoint({ delta: true })];
+    for (let i = 0; i < 3; i++) {
+      await pipeline.process(randomBuffer(2 * 32), options);
+      // Not stored by the checkpoint consumer: must not rebase the chain
+      const plain = await pipeline.saveStateBinary();
+      assert.strictEqual(describeSnapshot(plain).generation, 0);
+      await pipeline.process(randomBuffer(2 * 32), options);
+      chain.push(await pipeline.checkpoint({ delta: true }));
+    }
+    assert.ok(chain.slice(1).every((part) => describeSnapshot(part).delta));
+
+    const restored = build();
+    for (const part of chain) {
+      await restored.loadStateBinary(part);
+    }
+    const next = randomBuffer(2 * 64);
+    const a = await pipeline.process(new Float32Array(next), options);
+    const b = await restored.process(new Float32Array(next), options);
+    assert.deepStrictEqual(Array.from(b), Array.from(a));
+  });
+
+  test("should reject a delta that does not follow the loaded state", async () => {
+    const pipeline = createDspPipeline().Rms({
+      mode: "moving",
+      windowSize: 256,
+    });
+    await pipeline.process(randomBuffer(512), { channels: 1 });
+    const base = await pipeline.checkpoint({ delta: true });
+    await pipeline.process(randomBuffer(16), { channels: 1 });
+    const first = await pipeline.checkpoint({ delta: true });
+    await pipeline.process(randomBuffer(16), { channels: 1 });
+    const second = await pipeline.checkpoint({ delta: true });
+
+    const restored = createDspPipeline().Rms({
+      mode: "moving",
+      windowSize: 256,
+    });
+    await assert.rejects(() => restored.loadStateBinary(first), /base generation/);
+
+    await restored.loadStateBinary(base);
+    await assert.rejects(() => restored.loadStateBinary(second), /base generation/);
+
+    await restored.process(randomBuffer(4), { channels: 1 });
+    await assert.rejects(() => restored.loadStateBinary(first), /has changed/);
+  });
+
+  test("should write a full base every fullEvery checkpoints", async () => {
+    const pipeline = createDspPipeline().MovingAverage({
+      mode: "moving",
+      windowSize: 256,
+    });
+    await pipeline.process(randomBuffer(512), { channels: 1 });
+
+    const kinds: string[] = [];
+    for (let i = 0; i < 6; i++) {
+      await pipeline.process(randomBuffer(8), { channels: 1 });
+      const snapshot = await pipeline.checkpoint({ delta: true, fullEvery: 3 });
+      kinds.push(describeSnapshot(snapshot).delta ? "delta" : "full");
+    }
+    assert.deepStrictEqual(kinds, [
+      "full",
+      "delta",
+      "delta",
+      "full",
+      "delta",
+      "delta",
+    ]);
+  });
+
+  test("should compress sample windows with each snapshot codec", async () => {
+    const smooth = new Float32Array(4 * 4096).map(
+      (_, i) => Math.sin(Math.floor(i / 4) * 0.01) * 100
+    );
+    const sizes: Record<string, number> = {};
+
+    for (const codec of ["none", "xor", "delta"] as const) {
+      const build = () =>
+        createDspPipeline({ snapshotCodec: codec })
+          .MovingAverage({ mode: "moving", windowSize: 4096 })
+          .Rms({ mode: "moving", windowSize: 1024 });
+      const original = build();
+      await original.process(new Float32Array(smooth), DEFAULT_OPTIONS);
+
+      const snapshot = await original.checkpoint();
+      assert.strictEqual(describeSnapshot(snapshot).codec, codec);
+      sizes[codec] = snapshot.byteLength;
+
+      // Any pipeline loads any codec; the codec only affects writing
+      const restored = createDspPipeline()
+        .MovingAverage({ mode: "moving", windowSize: 4096 })
+        .Rms({ mode: "moving", windowSize: 1024 });
+      await restored.loadStateBinary(snapshot);
+
+      const next = randomBuffer(4 * 32);
+      const a = await original.process(new Float32Array(next), DEFAULT_OPTIONS);
+      const b = await restored.process(new Float32Array(next), DEFAULT_OPTIONS);
+      assert.deepStrictEqual(Array.from(b), Array.from(a));
+    }
+
+    assert.ok(sizes.xor < sizes.none, `xor ${sizes.xor} vs ${sizes.none}`);
+    assert.ok(sizes.delta < sizes.none, `delta ${sizes.delta} vs ${sizes.none}`);
+  });
+
+  test("should reject an unknown snapshot codec", () => {
+    assert.throws(
+      () => createDspPipeline({ snapshotCodec: "zip" as never }),
+      /Unknown snapshot codec/
+    );
+  });
+});
@@ -0,0 +1,184 @@
+import { describe, test } from "node:test";
+import assert from "node:assert/strict";
+import { createDspPipeline } from "../bindings.js";
+import type { EmgFeatureName } from "../types.js";
+import {
+  assertRelativeClose,
+  continueAfterRestore,
+  makeSignal,
+} from "./helpers.js";
+
+const WINDOW_SIZE = 32;
+const HOP_SIZE = 8;
+const FEATURES: EmgFeatureName[] = [
+  "meanAbsoluteValue",
+  "rms",
+  "waveformLength",
+  "slopeSignChange",
+  "willisonAmplitude",
+  "zeroCrossings",
+  "variance",
+];
+
+// Features of one channel's window ending at frame `end` (inclusive)
+function reference(
+  signal: Float32Array,
+  channels: number,
+  channel: number,
+  end: number,
+  wampThreshold: number
+): number[] {
+  const x = (k: number) => signal[k * channels + channel];
+  const start = end - WINDOW_SIZE + 1;
+  let sum = 0;
+  let sumAbs = 0;
+  let sumSq = 0;
+  let length = 0;
+  let ssc = 0;
+  let wamp = 0;
+  let zc = 0;
+  for (let k = start; k <= end; k++) {
+    sum += x(k);
+    sumAbs += Math.abs(x(k));
+    sumSq += x(k) * x(k);
+    if (k >= 1) {
+      const step = Math.abs(x(k) - x(k - 1));
+      length += step;
+      if (step > wampThreshold) wamp++;
+      if (x(k) * x(k - 1) < 0) zc++;
+    }
+    if (k >= 2 && (x(k - 1) - x(k - 2)) * (x(k - 1) - x(k)) > 0) ssc++;
+  }
+  const mean = sum / WINDOW_SIZE;
+  return [
+    sumAbs / WINDOW_SIZE,
+    Math.sqrt(sumSq / WINDOW_SIZE),
+    length,
+    ssc,
+    wamp,
+    zc,
+    sumSq / WINDOW_SIZE - mean * mean,
+  ];
+}
+
+describe("EMG Features", () => {
+  test("should emit one frame of every feature per hop", async () => {
+    const channels = 2;
+    const frames = 200;
+    const signal = makeSignal(frames * channels);
+    const pipeline = createDspPipeline().EmgFeatures({
+      windowSize: WINDOW_SIZE,
+      hopSize: HOP_SIZE,
+      wampThreshold: 0.5,
+    });
+
+    const output = await pipeline.process(new Float32Array(signal), {
+      channels,
+    });
+
+    const numFrames = Math.floor((frames - WINDOW_SIZE) / HOP_SIZE) + 1;
+    assert.strictEqual(output.length, numFrames * channels * FEATURES.length);
+
+    const expected: number[] = [];
+    for (let f = 0; f < numFrames; f++) {
+      const end = WINDOW_SIZE - 1 + f * HOP_SIZE;
+      for (let c = 0; c < channels; c++) {
+        expected.push(...reference(signal, channels, c, end, 0.5));
+      }
+    }
+    assertRelativeClose(output, expected);
+  });
+
+  test("should keep the requested feature order", async () => {
+    const signal = makeSignal(64);
+    const all = await createDspPipeline()
+      .EmgFeatures({ windowSize: WINDOW_SIZE })
+      .process(new Float32Array(signal), { channels: 1 });
+    const some = await createDspPipeline()
+      .EmgFeatures({ windowSize: WINDOW_SIZE, features: ["variance", "rms"] })
+      .process(new Float32Array(signal), { channels: 1 });
+
+    assert.strictEqual(some.length, 4);
+    assertRelativeClose(some, [all[6], all[1], all[13], all[8]]);
+  });
+
+  test("should not depend on chunk boundaries", async () => {
+    const channels = 3;
+    const signal = makeSignal(channels * 300);
+    const params = { windowSize: WINDOW_SIZE, hopSize: 5 };
+
+    const whole = await createDspPipeline()
+      .EmgFeatures(params)
+      .process(new Float32Array(signal), { channels });
+
+    const pipeline = createDspPipeline().EmgFeatures(params);
+    const parts: number[] = [];
+    for (let start = 0; start < signal.length; start += channels * 7) {
+      const chunk = signal.slice(start, start + channels * 7);
+      parts.push(...(await pipeline.process(chunk, { channels })));
+    }
+    assertRelativeClose(parts, whole);
+  });
+
+  test("should emit nothing before the first full window", async () => {
+    const pipeline = createDspPipeline().EmgFeatures({
+      windowSize: WINDOW_SIZE,
+    });
+    const output = await pipeline.process(makeSignal(WINDOW_SIZE - 1), {
+      channels: 1,
+    });
+    assert.strictEqual(output.length, 0);
+  });
+
+  test("should feed its frames to later stages", async () => {
+    const signal = makeSignal(128);
+    const features = await createDspPipeline()
+      .EmgFeatures({ windowSize: WINDOW_SIZE, features: ["rms"] })
+      .process(new Float32Array(signal), { channels: 1 });
+    const rectified = await createDspPipeline()
+      .EmgFeatures({ windowSize: WINDOW_SIZE, features: ["rms"] })
+      .Rectify({ mode: "full" })
+      .process(new Float32Array(signal), { channels: 1 });
+    assertRelativeClose(rectified, features);
+  });
+
+  test("should restore state from JSON and binary snapshots", async () => {
+    const params = { windowSize: WINDOW_SIZE, hopSize: 6 };
+    const original = createDspPipeline().EmgFeatures(params);
+    await original.process(makeSignal(2 * 45), { channels: 2 });
+
+    const { expected, restored } = await continueAfterRestore(
+      original,
+      () => createDspPipeline().EmgFeatures(params),
+      makeSignal(2 * 40, 45),
+      { channels: 2 }
+    );
+    assert.ok(expected.length > 0);
+    for (const actual of restored) {
+      assertRelativeClose(actual, expected);
+    }
+  });
+
+  test("should reject invalid parameters", () => {
+    assert.throws(
+      () => createDspPipeline().EmgFeatures({ windowSize: 0 }),
+      TypeError
+    );
+    assert.throws(
+      () => createDspPipeline().EmgFeatures({ windowSize: 8, hopSize: 0 }),
+      TypeError
+    );
+    assert.throws(
+      () => createDspPipeline().EmgFeatures({ windowSize: 8, features: [] }),
+      TypeError
+    );
+    assert.throws(
+      () =>
+        createDspPipeline().EmgFeatures({
+          windowSize: 8,
+          features: ["median" as EmgFeatureName],
+        }),
+      TypeError
+    );
+  });
+});
@@ -0,0 +1,167 @@
+import { describe, test } from "node:test";
+import assert from "node:assert/strict";
+import { createDspPipeline } from "../bindings.js";
+import { assertClose, continueAfterRestore, makeNoise } from "./helpers.js";
+
+const CHANNELS = 8;
+
+// Channel c is a ramp of slope 0.01 * (c + 1) plus uniform noise in
+// [-0.25, 0.25]; returns the noisy interleaved frames and the truth
+function makeStream(frames: number): {
+  noisy: Float32Array;
+  truth: Float32Array;
+} {
+  const noise = makeNoise(frames * CHANNELS, 11);
+  const noisy = new Float32Array(frames * CHANNELS);
+  const truth = new Float32Array(frames * CHANNELS);
+  for (let f = 0; f < frames; f++) {
+    for (let c = 0; c < CHANNELS; c++) {
+      const i = f * CHANNELS + c;
+      truth[i] = 0.01 * (c + 1) * f;
+      noisy[i] = truth[i] + 0.25 * noise[i];
+    }
+  }
+  return { noisy, truth };
+}
+
+function rmsError(
+  actual: Float32Array,
+  truth: Float32Array,
+  fromFrame: number
+): number {
+  let sum = 0;
+  for (let i = fromFrame * CHANNELS; i < actual.length; i++) {
+    sum += (actual[i] - truth[i]) ** 2;
+  }
+  return Math.sqrt(sum / (actual.length - fromFrame * CHANNELS));
+}
+
+describe("Kalman filter", () => {
+  const velocity = {
+    model: "constantVelocity" as const,
+    processNoise: 1e-6,
+    measurementNoise: 0.02,
+  };
+
+  test("should track ramps with far less noise", async () => {
+    const { noisy, truth } = makeStream(600);
+    const raw = rmsError(noisy, truth, 200);
+
+    const tracked = await createDspPipeline()
+      .KalmanFilter(velocity)
+      .process(new Float32Array(noisy), { channels: CHANNELS });
+    // A level model lags behind every ramp
+    const level = await createDspPipeline()
+      .KalmanFilter({ processNoise: 1e-6, measurementNoise: 0.02 })
+      .process(new Float32Array(noisy), { channels: CHANNELS });
+
+    assert.strictEqual(tracked.length, noisy.length);
+    assert.ok(rmsError(tracked, truth, 200) < 0.5 * raw);
+    assert.ok(rmsError(level, truth, 200) > raw);
+  });
+
+  test("should match the steady-state gain once settled", async () => {
+    const { noisy } = makeStream(600);
+    const settling = { ...velocity, processNoise: 1e-4 };
+    const full = await createDspPipeline()
+      .KalmanFilter(settling)
+      .process(new Float32Array(noisy), { channels: CHANNELS });
+    const steady = await createDspPipeline()
+      .KalmanFilter({ ...settling, steadyState: true })
+      .process(new Float32Array(noisy), { channels: CHANNELS });
+
+    for (let i = 400 * CHANNELS; i < noisy.length; i++) {
+      assert.ok(Math.abs(steady[i] - full[i]) < 1e-3);
+    }
+  });
+
+  test("should match an equivalent custom model", async () => {
+    const { noisy } = makeStream(300);
+    const q = velocity.processNoise;
+    const custom = await createDspPipeline()
+      .KalmanFilter({
+        model: "custom",
+        measurementNoise: velocity.measurementNoise,
+        transition: [1, 1, 0, 1],
+        observation: [1, 0],
+        processCovariance: [q / 4, q / 2, q / 2, q],
+      })
+      .process(new Float32Array(noisy), { channels: CHANNELS });
+    const builtIn = await createDspPipeline()
+      .KalmanFilter(velocity)
+      .process(new Float32Array(noisy), { channels: CHANNELS });
+
+    for (let i = 0; i < noisy.length; i++) {
+      assert.ok(Math.abs(custom[i] - builtIn[i]) < 1e-3);
+    }
+  });
+
+  test("should predict through NaN dropouts", async () => {
+    const { noisy, truth } = makeStream(600);
+    for (let f = 300; f < 320; f++) {
+      noisy[f * CHANNELS + 3] = NaN;
+    }
+    const output = await createDspPipeline()
+      .KalmanFilter(velocity)
+      .process(new Float32Array(noisy), { channels: CHANNELS });
+
+    assert.ok(output.every(Number.isFinite));
+    // Holding the last estimate would be 20 * 0.04 = 0.8 behind here
+    const gap = 319 * CHANNELS + 3;
+    assert.ok(Math.abs(output[gap] - truth[gap]) < 0.4);
+  });
+
+  test("should keep every channel's state across a restore", async () => {
+    const { noisy } = makeStream(500);
+    const first = noisy.subarray(0, 250 * CHANNELS);
+    const rest = noisy.subarray(250 * CHANNELS);
+
+    const original = createDspPipeline().KalmanFilter(velocity);
+    await original.process(new Float32Array(first), { channels: CHANNELS });
+
+    const { expected, restored } = await continueAfterRestore(
+      original,
+      () => createDspPipeline().KalmanFilter(velocity),
+      rest,
+      { channels: CHANNELS }
+    );
+    for (const actual of restored) {
+      assertClose(actual, expected);
+    }
+
+    const other = createDspPipeline().KalmanFilter({ ...velocity, dt: 2 });
+    await assert.rejects(
+      async () => other.loadState(await original.saveState()),
+      /mismatch/
+    );
+  });
+
+  test("should reject invalid parameters", () => {
+    assert.throws(
+      () => createDspPipeline().KalmanFilter({ measurementNoise: 0 }),
+      TypeError
+    );
+    assert.throws(
+      () => createDspPipeline().KalmanFilter({ processNoise: -1 }),
+      TypeError
+    );
+    assert.throws(
+      () =>
+        createDspPipeline().KalmanFilter({
+          model: "custom",
+          observation: [1, 0],
+          transition: [1, 1, 0],
+          processCovariance: [1, 0, 0, 1],
+        }),
+      TypeError
+    );
+    assert.throws(
+      () =>
+        createDspPipeline().KalmanFilter({
+          processNoise: 0,
+          steadyState: true,
+        }),
+      /steady-state/
+    );
+  });
+});
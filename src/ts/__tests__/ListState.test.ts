@@ -133,6 +133,53 @@ describe("listState Method", () => {
     assert.strictEqual(summary.stages[3].windowSize, 5);
   });
 
+  it("should report occupancy for every windowed stage", async () => {
+    const pipeline = createDspPipeline()
+      .Variance({ mode: "moving", windowSize: 8 })
+      .ZScoreNormalize({ mode: "moving", windowSize: 8 })
+      .MeanAbsoluteValue({ mode: "moving", windowSize: 8 })
+      .WaveformLength({ windowSize: 8 })
+      .SlopeSignChange({ windowSize: 8, threshold: 0 })
+      .WillisonAmplitude({ windowSize: 8, threshold: 0 })
+      .MovingMedian({ windowSize: 8 })
+      .MovingAverage({ mode: "moving", windowDuration: 250 });
+
+    const input = new Float32Array(2 * 6).map((_, i) => Math.sin(i));
+    await pipeline.process(input, { sampleRate: 1000, channels: 2 });
+
+    const summary = pipeline.listState();
+    for (const stage of summary.stages.slice(0, 7)) {
+      assert.strictEqual(stage.windowSize, 8, stage.type);
+      assert.strictEqual(stage.numChannels, 2, stage.type);
+      assert.strictEqual(stage.channelCount, 2, stage.type);
+      assert.strictEqual(stage.bufferSize, 6, stage.type);
+    }
+
+    const timed = summary.stages[7];
+    assert.strictEqual(timed.windowDuration, 250);
+    assert.strictEqual(timed.bufferSize, 6);
+  });
+
+  it("should report the stage arena", async () => {
+    const pipeline = createDspPipeline()
+      .MovingAverage({ mode: "moving", windowSize: 100 })
+      .Rms({ mode: "moving", windowSize: 50 });
+    const input = new Float32Array(400).map((_, i) => Math.sin(i * 0.1));
+    await pipeline.process(new Float32Array(input), { channels: 2 });
+
+    const first = pipeline.listState().arena;
+    assert.ok(first.usedBytes >= 2 * (100 + 50) * 4, "windows in the arena");
+    assert.strictEqual(first.usedBytes % 64, 0);
+    assert.ok(first.capacityBytes >= first.usedBytes);
+    assert.ok(first.blocks >= 1);
+
+    // Later chunks and restored state do not carve more
+    await pipeline.process(new Float32Array(input), { channels: 2 });
+    await pipeline.loadState(await pipeline.saveState());
+    await pipeline.process(new Float32Array(input), { channels: 2 });
+    assert.strictEqual(pipeline.listState().arena.usedBytes, first.usedBytes);
+  });
+
   it("should update timestamp on each call", async () => {
     const pipeline = createDspPipeline().MovingAverage({ mode: "moving", windowSize: 5 });
 
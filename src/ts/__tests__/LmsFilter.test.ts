@@ -0,0 +1,149 @@
+import { describe, test } from "node:test";
+import assert from "node:assert/strict";
+import { createDspPipeline } from "../bindings.js";
+import { assertClose, continueAfterRestore, makeNoise } from "./helpers.js";
+
+// [primary, reference] frames: primary = signal + hum filtered by [0.8, -0.4]
+function makeStream(frames: number) {
+  const noise = makeNoise(frames);
+  const reference = noise.map(
+    (n, i) => Math.sin((2 * Math.PI * 50 * i) / 1000) + 0.3 * n
+  );
+  const signal = reference.map((_, i) =>
+    0.5 * Math.sin((2 * Math.PI * 7 * i) / 1000)
+  );
+  const stream = new Float32Array(frames * 2);
+  for (let i = 0; i < frames; i++) {
+    const hum = 0.8 * reference[i] - 0.4 * (i > 0 ? reference[i - 1] : 0);
+    stream[i * 2] = signal[i] + hum;
+    stream[i * 2 + 1] = reference[i];
+  }
+  return { stream, signal };
+}
+
+function residualRms(output: Float32Array, signal: number[], from: number) {
+  let sum = 0;
+  for (let i = from; i < output.length; i++) {
+    sum += (output[i] - signal[i]) ** 2;
+  }
+  return Math.sqrt(sum / (output.length - from));
+}
+
+describe("LMS / NLMS adaptive filters", () => {
+  test("should cancel the reference-correlated interference", async () => {
+    const frames = 10000;
+    const { stream, signal } = makeStream(frames);
+
+    for (const pipeline of [
+      createDspPipeline().LmsFilter({ numTaps: 8, stepSize: 0.01 }),
+      createDspPipeline().NlmsFilter({ numTaps: 8, stepSize: 0.1 }),
+    ]) {
+      const output = await pipeline.process(new Float32Array(stream), {
+        channels: 2,
+      });
+      assert.strictEqual(output.length, frames);
+      // Interference RMS is ~0.6; after convergence only misadjustment
+      assert.ok(residualRms(output, signal, frames - 2000) < 0.1);
+      assert.ok(residualRms(output.subarray(0, 100), signal, 0) > 0.1);
+    }
+  });
+
+  test("should honor the reference channel index", async () => {
+    const frames = 6000;
+    const { stream, signal } = makeStream(frames);
+    const swapped = new Float32Array(stream.length);
+    for (let i = 0; i < frames; i++) {
+      swapped[i * 2] = stream[i * 2 + 1];
+      swapped[i * 2 + 1] = stream[i * 2];
+    }
+
+    const output = await createDspPipeline()
+      .NlmsFilter({ numTaps: 8, stepSize: 0.1, referenceChannel: 0 })
+      .process(swapped, { channels: 2 });
+    assert.ok(residualRms(output, signal, frames - 2000) < 0.1);
+  });
+
+  test("should keep the adapted weights across a state restore", async () => {
+    const params = { numTaps: 8, stepSize: 0.1 };
+    const { stream } = makeStream(6000);
+    const first = stream.subarray(0, 4000 * 2);
+    const rest = stream.subarray(4000 * 2);
+
+    const original = createDspPipeline().NlmsFilter(params);
+    await original.process(new Float32Array(first), { channels: 2 });
+
+    const { expected, restored } = await continueAfterRestore(
+      original,
+      () => createDspPipeline().NlmsFilter(params),
+      rest,
+      { channels: 2 }
+    );
+    for (const actual of restored) {
+      assertClose(actual, expected);
+    }
+
+    // A fresh filter has not converged yet
+    const fresh = await createDspPipeline()
+      .NlmsFilter(params)
+      .process(new Float32Array(rest), { channels: 2 });
+    const head = fresh.subarray(0, 100);
+    assert.ok(residualRms(head, Array.from(expected), 0) > 0.1);
+
+    const other = createDspPipeline().NlmsFilter({ ...params, numTaps: 4 });
+    await assert.rejects(
+      async () => other.loadState(await original.saveState()),
+      /mismatch/
+    );
+  });
+
+  test("should reject streams without a primary channel", async () => {
+    await assert.rejects(
+      () =>
+        createDspPipeline()
+          .LmsFilter({ numTaps: 4, stepSize: 0.01 })
+          .process(new Float32Array(16), { channels: 1 }),
+      /reference and at least one primary/
+    );
+    await assert.rejects(
+      () =>
+        createDspPipeline()
+          .LmsFilter({ numTaps: 4, stepSize: 0.01, referenceChannel: 3 })
+          .process(new Float32Array(16), { channels: 2 }),
+      /out of range/
+    );
+  });
+
+  test("should reject invalid parameters", () => {
+    assert.throws(
+      () => createDspPipeline().LmsFilter({ numTaps: 0, stepSize: 0.1 }),
+      TypeError
+    );
+    assert.throws(
+      () => createDspPipeline().LmsFilter({ numTaps: 8, stepSize: 0 }),
+      TypeError
+    );
+    assert.throws(
+      () => createDspPipeline().NlmsFilter({ numTaps: 8, stepSize: 2 }),
+      TypeError
+    );
+    // A silent reference window would divide the step by zero
+    assert.throws(
+      () =>
+        createDspPipeline().NlmsFilter({
+          numTaps: 8,
+          stepSize: 0.5,
+          epsilon: 0,
+        }),
+      TypeError
+    );
+    assert.throws(
+      () =>
+        createDspPipeline().NlmsFilter({
+          numTaps: 8,
+          stepSize: 0.5,
+          referenceChannel: -1,
+        }),
+      TypeError
+    );
+  });
+});
@@ -0,0 +1,93 @@
+import { describe, test } from "node:test";
+import assert from "node:assert/strict";
+import {
+  createDspPipeline,
+  metricsToLogEntries,
+  parseMetrics,
+} from "../bindings.js";
+
+describe("Native Timing Metrics", () => {
+  test("should time every stage and every process() job", async () => {
+    const pipeline = createDspPipeline()
+      .MovingAverage({ mode: "moving", windowSize: 16 })
+      .Rectify({ mode: "full" })
+      .Rms({ mode: "moving", windowSize: 8 });
+
+    for (let i = 0; i < 5; i++) {
+      await pipeline.process(new Float32Array(2 * 100).fill(i), {
+        channels: 2,
+      });
+    }
+
+    const snapshot = pipeline.getMetrics();
+    assert.ok(snapshot instanceof Float64Array);
+    assert.strictEqual(snapshot.length, 10 + 3 * 4);
+
+    const metrics = pipeline.metrics();
+    for (const phase of [metrics.queue, metrics.execute, metrics.resolve]) {
+      assert.strictEqual(phase.count, 5);
+      assert.ok(phase.maxNs <= phase.totalNs);
+    }
+
+    assert.deepStrictEqual(
+      metrics.stages.map((stage) => stage.type),
+      ["movingAverage", "rectify", "rms"]
+    );
+    for (const stage of metrics.stages) {
+      assert.strictEqual(stage.count, 5);
+      assert.strictEqual(stage.samples, 5 * 200);
+      assert.ok(stage.totalNs > 0);
+      assert.ok(stage.maxNs <= stage.totalNs);
+    }
+
+    // Stages run inside the job, so their time is part of it
+    const stageNs = metrics.stages.reduce((sum, s) => sum + s.totalNs, 0);
+    assert.ok(stageNs <= metrics.execute.totalNs);
+  });
+
+  test("should reset the counters but keep the stages", async () => {
+    const pipeline = createDspPipeline().Rms({ mode: "moving", windowSize: 4 });
+    await pipeline.process(new Float32Array(8), { channels: 1 });
+
+    pipeline.resetMetrics();
+    const metrics = pipeline.metrics();
+    assert.strictEqual(metrics.stages.length, 1);
+    assert.strictEqual(metrics.stages[0].count, 0);
+    assert.strictEqual(metrics.stages[0].samples, 0);
+    assert.strictEqual(metrics.queue.count, 0);
+  });
+
+  test("should parse a snapshot and produce one log entry per counter", () => {
+    const snapshot = new Float64Array([
+      1, 3, 300, 200, 3, 3000, 1500, 3, 90, 40, 3, 2400, 1200, 96,
+    ]);
+    const metrics = parseMetrics(snapshot, ["rms"]);
+    assert.deepStrictEqual(metrics.queue, {
+      count: 3,
+      totalNs: 300,
+      maxNs: 200,
+    });
+    assert.deepStrictEqual(metrics.stages, [
+      {
+        index: 0,
+        type: "rms",
+        count: 3,
+        totalNs: 2400,
+        maxNs: 1200,
+        samples: 96,
+      },
+    ]);
+
+    const entries = metricsToLogEntries(metrics, 1_700_000_000_000);
+    assert.strictEqual(entries.length, 9 + 4);
+    const duration = entries.find(
+      (entry) => entry.topic === "dsp.stage.duration_ns_total"
+    );
+    assert.deepStrictEqual(duration?.context, {
+      stage: "0",
+      type: "rms",
+      value: 2400,
+    });
+    assert.strictEqual(duration?.timestamp, 1_700_000_000_000);
+  });
+});
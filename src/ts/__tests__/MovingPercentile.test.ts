@@ -0,0 +1,235 @@
+import { describe, test, beforeEach } from "node:test";
+import assert from "node:assert/strict";
+import { createDspPipeline, DspProcessor } from "../bindings.js";
+
+const DEFAULT_OPTIONS = { channels: 1, sampleRate: 44100 };
+
+// Reference percentile with linear interpolation (numpy "linear" method)
+function percentileOf(window: number[], p: number): number {
+  const sorted = [...window].sort((a, b) => a - b);
+  const pos = (p / 100) * (sorted.length - 1);
+  const lo = Math.floor(pos);
+  const hi = Math.min(lo + 1, sorted.length - 1);
+  return sorted[lo] + (pos - lo) * (sorted[hi] - sorted[lo]);
+}
+
+function slidingReference(input: number[], windowSize: number, p: number) {
+  return input.map((_, i) =>
+    percentileOf(input.slice(Math.max(0, i - windowSize + 1), i + 1), p)
+  );
+}
+
+describe("Moving Median", () => {
+  let pipeline: DspProcessor;
+
+  beforeEach(() => {
+    pipeline = createDspPipeline();
+  });
+
+  test("should remove single-sample spikes", async () => {
+    pipeline.MovingMedian({ windowSize: 3 });
+
+    const buffer = new Float32Array([1, 1, 100, 1, 1, -50, 1, 1]);
+    await pipeline.process(buffer, DEFAULT_OPTIONS);
+
+    // Once the window is full, isolated spikes never reach the output
+    for (let i = 2; i < buffer.length; i++) {
+      assert.strictEqual(buffer[i], 1);
+    }
+  });
+
+  test("should interpolate between the middle values for even windows", async () => {
+    pipeline.MovingMedian({ windowSize: 4 });
+
+    const buffer = new Float32Array([4, 1, 3, 2]);
+    await pipeline.process(buffer, DEFAULT_OPTIONS);
+
+    assert.strictEqual(buffer[0], 4);
+    assert.strictEqual(buffer[1], 2.5); // [4, 1]
+    assert.strictEqual(buffer[2], 3); // [4, 1, 3]
+    assert.strictEqual(buffer[3], 2.5); // [4, 1, 3, 2]
+  });
+
+  test("should match a brute-force median on random data", async () => {
+    pipeline.MovingMedian({ windowSize: 17 });
+
+    const input = Array.from({ length: 500 }, () =>
+      Math.round(Math.random() * 200 - 100)
+    );
+    const buffer = new Float32Array(input);
+    await pipeline.process(buffer, DEFAULT_OPTIONS);
+
+    const expected = slidingReference(input, 17, 50);
+    for (let i = 0; i < input.length; i++) {
+      assert.ok(
+        Math.abs(buffer[i] - expected[i]) < 1e-4,
+        `sample ${i}: expected ${expected[i]}, got ${buffer[i]}`
+      );
+    }
+  });
+
+  test("should keep channels independent", async () => {
+    pipeline.MovingMedian({ windowSize: 3 });
+
+    // ch0: 1, 5, 3  ch1: 10, 0, 10
+    const buffer = new Float32Array([1, 10, 5, 0, 3, 10]);
+    await pipeline.process(buffer, { channels: 2, sampleRate: 1000 });
+
+    assert.strictEqual(buffer[4], 3); // median(1, 5, 3)
+    assert.strictEqual(buffer[5], 10); // median(10, 0, 10)
+  });
+
+  test("should continue the window across process calls", async () => {
+    pipeline.MovingMedian({ windowSize: 3 });
+
+    await pipeline.process(new Float32Array([9, 1]), DEFAULT_OPTIONS);
+    const buffer = new Float32Array([5]);
+    await pipeline.process(buffer, DEFAULT_OPTIONS);
+
+    assert.strictEqual(buffer[0], 5); // median(9, 1, 5)
+  });
+
+  test("should restore state via saveState/loadState", async () => {
+    pipeline.MovingMedian({ windowSize: 5 });
+    await pipeline.process(new Float32Array([7, 3, 9, 1]), DEFAULT_OPTIONS);
+    const state = await pipeline.saveState();
+
+    const restored = createDspPipeline();
+    restored.MovingMedian({ windowSize: 5 });
+    await restored.loadState(state);
+
+    const a = new Float32Array([4]);
+    const b = new Float32Array([4]);
+    await pipeline.process(a, DEFAULT_OPTIONS);
+    await restored.process(b, DEFAULT_OPTIONS);
+
+    assert.strictEqual(a[0], 4); // median(7, 3, 9, 1, 4)
+    assert.strictEqual(b[0], a[0]);
+  });
+
+  test("should reject invalid parameters", () => {
+    assert.throws(() => pipeline.MovingMedian({}), TypeError);
+    assert.throws(() => pipeline.MovingMedian({ windowSize: 0 }), TypeError);
+    assert.throws(
+      () => pipeline.MovingMedian({ windowDuration: 100, method: "approximate" }),
+      TypeError
+    );
+  });
+});
+
+describe("Moving Percentile", () => {
+  let pipeline: DspProcessor;
+
+  beforeEach(() => {
+    pipeline = createDspPipeline();
+  });
+
+  test("should match a brute-force percentile for several quantiles", async () => {
+    const input = Array.from({ length: 300 }, () => Math.random() * 10);
+
+    for (const p of [0, 10, 25, 90, 100]) {
+      const stage = createDspPipeline().MovingPercentile({
+        percentile: p,
+        windowSize: 32,
+      });
+      const buffer = new Float32Array(input);
+      await stage.process(buffer, DEFAULT_OPTIONS);
+
+      const expected = slidingReference(Array.from(new Float32Array(input)), 32, p);
+      for (let i = 0; i < input.length; i++) {
+        assert.ok(
+          Math.abs(buffer[i] - expected[i]) < 1e-4,
+          `p${p} sample ${i}: expected ${expected[i]}, got ${buffer[i]}`
+        );
+      }
+    }
+  });
+
+  test("should approximate the quantile of a long window", async () => {
+    pipeline.MovingPercentile({
+      percentile: 50,
+      windowSize: 4000,
+      method: "approximate",
+    });
+
+    // Uniform [0, 1) -> median around 0.5
+    const buffer = new Float32Array(20000).map(() => Math.random());
+    await pipeline.process(buffer, DEFAULT_OPTIONS);
+
+    assert.ok(Math.abs(buffer[buffer.length - 1] - 0.5) < 0.05);
+  });
+
+  test("should skip NaN samples", async () => {
+    const input = Array.from({ length: 300 }, (_, i) =>
+      i % 7 === 3 ? NaN : Math.sin(i * 0.37) * 5
+    );
+    const values = Array.from(new Float32Array(input));
+
+    pipeline.MovingPercentile({ percentile: 50, windowSize: 9 });
+    const buffer = new Float32Array(input);
+    await pipeline.process(buffer, DEFAULT_OPTIONS);
+
+    // Percentile of the non-NaN samples in each window (numpy nanpercentile)
+    for (let i = 0; i < values.length; i++) {
+      const window = values
+        .slice(Math.max(0, i - 8), i + 1)
+        .filter((x) => !Number.isNaN(x));
+      const expected = percentileOf(window, 50);
+      assert.ok(
+        Math.abs(buffer[i] - expected) < 1e-4,
+        `sample ${i}: expected ${expected}, got ${buffer[i]}`
+      );
+    }
+
+    const approximate = createDspPipeline().MovingPercentile({
+      percentile: 50,
+      windowSize: 64,
+      method: "approximate",
+    });
+    const estimates = new Float32Array(input);
+    await approximate.process(estimates, DEFAULT_OPTIONS);
+    assert.ok(estimates.every(Number.isFinite));
+  });
+
+  test("should reject a corrupted approximate state", async () => {
+    const params = {
+      percentile: 50,
+      windowSize: 64,
+      method: "approximate" as const,
+    };
+    pipeline.MovingPercentile(params);
+    const input = new Float32Array(100).map((_, i) => i % 10);
+    await pipeline.process(input, DEFAULT_OPTIONS);
+
+    // Marker counts must be whole numbers
+    const state = JSON.parse(await pipeline.saveState());
+    state.stages[0].state.channels[0].estimatorA[0] = 2.5;
+
+    const restored = createDspPipeline().MovingPercentile(params);
+    await assert.rejects(
+      () => restored.loadState(JSON.stringify(state)),
+      /P2 estimator/
+    );
+  });
+
+  test("should report its type in listState", async () => {
+    pipeline.MovingPercentile({ percentile: 75, windowSize: 8 });
+    await pipeline.process(new Float32Array([1, 2, 3]), DEFAULT_OPTIONS);
+
+    const summary = pipeline.listState();
+    assert.strictEqual(summary.stages[0].type, "movingPercentile");
+    assert.strictEqual(summary.stages[0].windowSize, 8);
+    assert.strictEqual(summary.stages[0].bufferSize, 3);
+  });
+
+  test("should reject out-of-range percentiles", () => {
+    assert.throws(
+      () => pipeline.MovingPercentile({ percentile: 101, windowSize: 5 }),
+      TypeError
+    );
+    assert.throws(
+      () => pipeline.MovingPercentile({ percentile: -1, windowSize: 5 }),
+      TypeError
+    );
+  });
+});
@@ -0,0 +1,109 @@
+import { describe, test } from "node:test";
+import assert from "node:assert/strict";
+import { createDspPipeline } from "../bindings.js";
+import {
+  assertRelativeClose,
+  continueAfterRestore,
+  signalOf,
+} from "./helpers.js";
+
+const WINDOW_SIZE = 16;
+
+const makeSignal = signalOf(
+  (t) => Math.sin(t * 0.21) * 3 + Math.cos(t * 1.3) + 0.4
+);
+
+describe("Moving Statistics", () => {
+  test("should match the single-statistic stages", async () => {
+    const channels = 3;
+    const signal = makeSignal(channels * 100);
+    const options = { channels };
+
+    const combined = await createDspPipeline()
+      .MovingStatistics({
+        windowSize: WINDOW_SIZE,
+        statistics: ["mean", "rms", "meanAbsoluteValue", "variance"],
+      })
+      .process(new Float32Array(signal), options);
+
+    const singles = [
+      await createDspPipeline()
+        .MovingAverage({ mode: "moving", windowSize: WINDOW_SIZE })
+        .process(new Float32Array(signal), options),
+      await createDspPipeline()
+        .Rms({ mode: "moving", windowSize: WINDOW_SIZE })
+        .process(new Float32Array(signal), options),
+      await createDspPipeline()
+        .MeanAbsoluteValue({ mode: "moving", windowSize: WINDOW_SIZE })
+        .process(new Float32Array(signal), options),
+      await createDspPipeline()
+        .Variance({ mode: "moving", windowSize: WINDOW_SIZE })
+        .process(new Float32Array(signal), options),
+    ];
+
+    const expected: number[] = [];
+    for (let i = 0; i < signal.length; i++) {
+      for (const single of singles) {
+        expected.push(single[i]);
+      }
+    }
+    assertRelativeClose(combined, expected);
+  });
+
+  test("should keep the requested statistic order", async () => {
+    const signal = makeSignal(40);
+    const output = await createDspPipeline()
+      .MovingStatistics({
+        windowSize: WINDOW_SIZE,
+        statistics: ["variance", "mean"],
+      })
+      .process(new Float32Array(signal), { channels: 1 });
+    const mean = await createDspPipeline()
+      .MovingAverage({ mode: "moving", windowSize: WINDOW_SIZE })
+      .process(new Float32Array(signal), { channels: 1 });
+
+    assert.strictEqual(output.length, signal.length * 2);
+    assertRelativeClose(
+      output.filter((_, i) => i % 2 === 1),
+      mean
+    );
+  });
+
+  test("should restore state from JSON and binary snapshots", async () => {
+    const params = {
+      windowSize: WINDOW_SIZE,
+      statistics: ["rms", "variance"] as ("rms" | "variance")[],
+    };
+    const original = createDspPipeline().MovingStatistics(params);
+    await original.process(makeSignal(2 * 30), { channels: 2 });
+
+    const { expected, restored } = await continueAfterRestore(
+      original,
+      () => createDspPipeline().MovingStatistics(params),
+      makeSignal(2 * 20, 30),
+      { channels: 2 }
+    );
+    for (const actual of restored) {
+      assertRelativeClose(actual, expected);
+    }
+  });
+
+  test("should reject invalid parameters", () => {
+    assert.throws(
+      () =>
+        createDspPipeline().MovingStatistics({
+          windowSize: 0,
+          statistics: ["mean"],
+        }),
+      TypeError
+    );
+    assert.throws(
+      () =>
+        createDspPipeline().MovingStatistics({
+          windowSize: 8,
+          statistics: [],
+        }),
+      TypeError
+    );
+  });
+});
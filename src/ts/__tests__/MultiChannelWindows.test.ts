@@ -0,0 +1,92 @@
+import { describe, test } from "node:test";
+import assert from "node:assert/strict";
+import { createDspPipeline, DspProcessor } from "../bindings.js";
+
+const CHANNELS = 8;
+const WINDOW_SIZE = 16;
+
+// Moving statistics with enough channels run on lock-step windows; one
+// channel at a time still uses the per-channel filters
+const STAGES: Record<string, (pipeline: DspProcessor) => DspProcessor> = {
+  MovingAverage: (p) =>
+    p.MovingAverage({ mode: "moving", windowSize: WINDOW_SIZE }),
+  Rms: (p) => p.Rms({ mode: "moving", windowSize: WINDOW_SIZE }),
+  MeanAbsoluteValue: (p) =>
+    p.MeanAbsoluteValue({ mode: "moving", windowSize: WINDOW_SIZE }),
+  Variance: (p) => p.Variance({ mode: "moving", windowSize: WINDOW_SIZE }),
+  ZScoreNormalize: (p) =>
+    p.ZScoreNormalize({ mode: "moving", windowSize: WINDOW_SIZE }),
+};
+
+function makeFrames(frames: number, offset = 0): Float32Array {
+  const buffer = new Float32Array(frames * CHANNELS);
+  for (let f = 0; f < frames; f++) {
+    for (let c = 0; c < CHANNELS; c++) {
+      const t = f + offset;
+      buffer[f * CHANNELS + c] = Math.sin(t * 0.21 * (c + 1)) * (c + 1) - c;
+    }
+  }
+  return buffer;
+}
+
+function channel(buffer: Float32Array, c: number): Float32Array {
+  return buffer.filter((_, i) => i % CHANNELS === c);
+}
+
+function assertClose(actual: ArrayLike<number>, expected: ArrayLike<number>) {
+  assert.strictEqual(actual.length, expected.length);
+  for (let i = 0; i < expected.length; i++) {
+    const tolerance = 1e-4 * Math.max(1, Math.abs(expected[i]));
+    assert.ok(
+      Math.abs(actual[i] - expected[i]) <= tolerance,
+      `index ${i}: ${actual[i]} vs ${expected[i]}`
+    );
+  }
+}
+
+describe("Lock-step Multi-channel Windows", () => {
+  for (const [name, addStage] of Object.entries(STAGES)) {
+    test(`${name} should match single-channel runs`, async () => {
+      const pipeline = addStage(createDspPipeline());
+      const first = await pipeline.process(makeFrames(37), {
+        channels: CHANNELS,
+      });
+      const second = await pipeline.process(makeFrames(29, 37), {
+        channels: CHANNELS,
+      });
+
+      for (let c = 0; c < CHANNELS; c++) {
+        const single = addStage(createDspPipeline());
+        const a = await single.process(channel(makeFrames(37), c), {
+          channels: 1,
+        });
+        const b = await single.process(channel(makeFrames(29, 37), c), {
+          channels: 1,
+        });
+        assertClose(channel(first, c), a);
+        assertClose(channel(second, c), b);
+      }
+    });
+
+    test(`${name} should restore state and continue identically`, async () => {
+      const original = addStage(createDspPipeline());
+      await original.process(makeFrames(21), { channels: CHANNELS });
+
+      const fromJson = addStage(createDspPipeline());
+      await fromJson.loadState(await original.saveState());
+      const fromBinary = addStage(createDspPipeline());
+      await fromBinary.loadStateBinary(await original.saveStateBinary());
+
+      const next = makeFrames(11, 21);
+      const expected = await original.process(new Float32Array(next), {
+        channels: CHANNELS,
+      });
+      for (const restored of [fromJson, fromBinary]) {
+        const actual = await restored.process(new Float32Array(next), {
+          channels: CHANNELS,
+        });
+        assertClose(actual, expected);
+      }
+    });
+  }
+});
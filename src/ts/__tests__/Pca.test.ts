@@ -0,0 +1,139 @@
+import { describe, test } from "node:test";
+import assert from "node:assert/strict";
+import { createDspPipeline } from "../bindings.js";
+import { continueAfterRestore } from "./helpers.js";
+
+// Three correlated channels driven by two independent sources
+function makeSignal(frames: number, offset = 0): Float32Array {
+  const signal = new Float32Array(frames * 3);
+  for (let f = 0; f < frames; f++) {
+    const t = f + offset;
+    const a = Math.sin(t * 0.37) * 3;
+    const b = Math.sin(t * 1.13 + 0.4);
+    signal[f * 3] = a + 0.5 * b + 1;
+    signal[f * 3 + 1] = 0.8 * a - b;
+    signal[f * 3 + 2] = 0.3 * a + 0.2 * b - 2;
+  }
+  return signal;
+}
+
+function covariance(data: ArrayLike<number>, channels: number): number[][] {
+  const frames = data.length / channels;
+  const mean = new Array(channels).fill(0);
+  for (let i = 0; i < data.length; i++) {
+    mean[i % channels] += data[i] / frames;
+  }
+  const cov = Array.from({ length: channels }, () =>
+    new Array(channels).fill(0)
+  );
+  for (let f = 0; f < frames; f++) {
+    for (let i = 0; i < channels; i++) {
+      for (let j = 0; j < channels; j++) {
+        cov[i][j] +=
+          ((data[f * channels + i] - mean[i]) *
+            (data[f * channels + j] - mean[j])) /
+          frames;
+      }
+    }
+  }
+  return cov;
+}
+
+describe("Pca", () => {
+  test("should output decorrelated components, largest first", async () => {
+    const pipeline = createDspPipeline().Pca({
+      components: 2,
+      windowSize: 2000,
+      updateInterval: 500,
+      background: false,
+    });
+    const output = await pipeline.process(makeSignal(2000), { channels: 3 });
+    assert.strictEqual(output.length, 2000 * 2);
+
+    // The last interval is projected with the full-window estimate
+    const cov = covariance(output.subarray(1500 * 2), 2);
+    assert.ok(cov[0][0] > cov[1][1]);
+    assert.ok(Math.abs(cov[0][1]) < 0.05 * Math.sqrt(cov[0][0] * cov[1][1]));
+  });
+
+  test("should whiten to unit variance", async () => {
+    for (const mode of ["whiten", "zca"] as const) {
+      const output = await createDspPipeline()
+        .Pca({
+          mode,
+          components: 2,
+          windowSize: 4000,
+          updateInterval: 1000,
+          epsilon: 0,
+          background: false,
+        })
+        .process(makeSignal(4000), { channels: 3 });
+      const channels = mode === "zca" ? 3 : 2;
+      const cov = covariance(output.subarray(3000 * channels), channels);
+      if (mode === "whiten") {
+        assert.ok(Math.abs(cov[0][0] - 1) < 0.1, `${cov[0][0]}`);
+        assert.ok(Math.abs(cov[1][1] - 1) < 0.1, `${cov[1][1]}`);
+        assert.ok(Math.abs(cov[0][1]) < 0.1);
+      } else {
+        // Rank-2 data: the whitened subspace has total variance 2
+        const trace = cov[0][0] + cov[1][1] + cov[2][2];
+        assert.ok(Math.abs(trace - 2) < 0.2, `${trace}`);
+      }
+    }
+  });
+
+  test("should output zeros until the first decomposition", async () => {
+    const output = await createDspPipeline()
+      .Pca({ alpha: 0.01, updateInterval: 64, background: false })
+      .process(makeSignal(32), { channels: 3 });
+    assert.ok(output.every((value) => value === 0));
+  });
+
+  test("should continue identically after a state restore", async () => {
+    const params = {
+      mode: "whiten" as const,
+      alpha: 0.02,
+      updateInterval: 50,
+      background: false,
+    };
+    const original = createDspPipeline().Pca(params);
+    await original.process(makeSignal(300), { channels: 3 });
+
+    const { expected, restored } = await continueAfterRestore(
+      original,
+      () => createDspPipeline().Pca(params),
+      makeSignal(120, 300),
+      { channels: 3 }
+    );
+    for (const actual of restored) {
+      assert.deepStrictEqual(actual, expected);
+    }
+
+    const other = createDspPipeline().Pca({ ...params, alpha: 0.05 });
+    await assert.rejects(
+      async () => other.loadState(await original.saveState()),
+      /mismatch/
+    );
+  });
+
+  test("should reject invalid parameters", () => {
+    assert.throws(() => createDspPipeline().Pca({}), TypeError);
+    assert.throws(
+      () => createDspPipeline().Pca({ windowSize: 100, alpha: 0.1 }),
+      TypeError
+    );
+    assert.throws(() => createDspPipeline().Pca({ alpha: 1.5 }), TypeError);
+    assert.throws(
+      () => createDspPipeline().Pca({ windowSize: 100, components: 0 }),
+      TypeError
+    );
+    assert.throws(
+      () =>
+        createDspPipeline().Pca({
+          windowSize: 100,
+          mode: "ica" as "pca",
+        }),
+      TypeError
+    );
+  });
+});
@@ -0,0 +1,100 @@
+import { describe, test } from "node:test";
+import assert from "node:assert/strict";
+import { createDspPipeline } from "../bindings.js";
+import {
+  assertRelativeClose,
+  continueAfterRestore,
+  signalOf,
+} from "./helpers.js";
+
+const makeSignal = signalOf(
+  (t) => Math.sin(t * 0.17) * 2 + Math.cos(t * 1.1) * 0.5 - 0.3
+);
+
+// z-scores divide by a small stddev, so compare with a looser tolerance
+const TOLERANCE = 1e-3;
+
+describe("Prebuilt", () => {
+  test("rectifyMavZScore should match the dynamic chain", async () => {
+    for (const channels of [1, 2, 8]) {
+      const signal = makeSignal(channels * 300);
+      const options = { channels };
+
+      const prebuilt = createDspPipeline().Prebuilt({
+        name: "rectifyMavZScore",
+        windowSize: 8,
+        zScoreWindowSize: 64,
+      });
+      const dynamic = createDspPipeline()
+        .Rectify({ mode: "full" })
+        .MeanAbsoluteValue({ mode: "moving", windowSize: 8 })
+        .ZScoreNormalize({ mode: "moving", windowSize: 64 });
+
+      // Two chunks so state carries across calls
+      for (const chunk of [signal.subarray(0, channels * 120), signal]) {
+        const actual = await prebuilt.process(new Float32Array(chunk), options);
+        const expected = await dynamic.process(
+          new Float32Array(chunk),
+          options
+        );
+        assertRelativeClose(actual, expected, TOLERANCE);
+      }
+    }
+  });
+
+  test("rmsZScore should match the dynamic chain", async () => {
+    const signal = makeSignal(3 * 200);
+    const actual = await createDspPipeline()
+      .Prebuilt({ name: "rmsZScore", windowSize: 16 })
+      .process(new Float32Array(signal), { channels: 3 });
+    const expected = await createDspPipeline()
+      .Rms({ mode: "moving", windowSize: 16 })
+      .ZScoreNormalize({ mode: "moving", windowSize: 16 })
+      .process(new Float32Array(signal), { channels: 3 });
+    assertRelativeClose(actual, expected, TOLERANCE);
+  });
+
+  test("should restore state from JSON and binary snapshots", async () => {
+    const params = {
+      name: "rectifyMavZScore" as const,
+      windowSize: 8,
+      zScoreWindowSize: 32,
+    };
+    const original = createDspPipeline().Prebuilt(params);
+    await original.process(makeSignal(2 * 50), { channels: 2 });
+
+    const { expected, restored } = await continueAfterRestore(
+      original,
+      () => createDspPipeline().Prebuilt(params),
+      makeSignal(2 * 30, 50),
+      { channels: 2 }
+    );
+    for (const actual of restored) {
+      assertRelativeClose(actual, expected, TOLERANCE);
+    }
+  });
+
+  test("should reject invalid parameters", () => {
+    assert.throws(
+      () =>
+        createDspPipeline().Prebuilt({
+          name: "unknown" as "rmsZScore",
+          windowSize: 8,
+        }),
+      TypeError
+    );
+    assert.throws(
+      () => createDspPipeline().Prebuilt({ name: "rmsZScore", windowSize: 0 }),
+      TypeError
+    );
+    assert.throws(
+      () =>
+        createDspPipeline().Prebuilt({
+          name: "rmsZScore",
+          windowSize: 8,
+          zScoreWindowSize: 1.5,
+        }),
+      TypeError
+    );
+  });
+});
@@ -0,0 +1,92 @@
+import { describe, test } from "node:test";
+import assert from "node:assert/strict";
+import { createDspPipeline, DspProcessor } from "../bindings.js";
+
+const WINDOW_SIZE = 50;
+
+// Chunks of at least one window are evaluated from prefix sums; short
+// chunks go through the per-sample running sums
+const STAGES: Record<string, (pipeline: DspProcessor) => DspProcessor> = {
+  MovingAverage: (p) =>
+    p.MovingAverage({ mode: "moving", windowSize: WINDOW_SIZE }),
+  Rms: (p) => p.Rms({ mode: "moving", windowSize: WINDOW_SIZE }),
+  MeanAbsoluteValue: (p) =>
+    p.MeanAbsoluteValue({ mode: "moving", windowSize: WINDOW_SIZE }),
+  Variance: (p) => p.Variance({ mode: "moving", windowSize: WINDOW_SIZE }),
+  ZScoreNormalize: (p) =>
+    p.ZScoreNormalize({ mode: "moving", windowSize: WINDOW_SIZE }),
+};
+
+function makeSignal(length: number, offset = 0): Float32Array {
+  const signal = new Float32Array(length);
+  for (let i = 0; i < length; i++) {
+    const t = i + offset;
+    signal[i] = Math.sin(t * 0.05) * 4 + Math.cos(t * 0.9) + 0.5;
+  }
+  return signal;
+}
+
+async function processInChunks(
+  pipeline: DspProcessor,
+  signal: Float32Array,
+  chunkSize: number,
+  channels: number
+): Promise<Float32Array> {
+  const output = new Float32Array(signal.length);
+  for (let start = 0; start < signal.length; start += chunkSize) {
+    const chunk = signal.slice(start, start + chunkSize);
+    output.set(await pipeline.process(chunk, { channels }), start);
+  }
+  return output;
+}
+
+function assertClose(actual: ArrayLike<number>, expected: ArrayLike<number>) {
+  assert.strictEqual(actual.length, expected.length);
+  for (let i = 0; i < expected.length; i++) {
+    const tolerance = 1e-3 * Math.max(1, Math.abs(expected[i]));
+    assert.ok(
+      Math.abs(actual[i] - expected[i]) <= tolerance,
+      `index ${i}: ${actual[i]} vs ${expected[i]}`
+    );
+  }
+}
+
+describe("Prefix-sum Moving Windows", () => {
+  for (const [name, addStage] of Object.entries(STAGES)) {
+    test(`${name} should match per-sample results on long chunks`, async () => {
+      for (const channels of [1, 2, 3]) {
+        const signal = makeSignal(channels * 1200);
+        const perSample = await processInChunks(
+          addStage(createDspPipeline()),
+          signal,
+          channels * 7,
+          channels
+        );
+        const blocks = await processInChunks(
+          addStage(createDspPipeline()),
+          signal,
+          channels * 400,
+          channels
+        );
+        assertClose(blocks, perSample);
+      }
+    });
+
+    test(`${name} should save state after a long chunk`, async () => {
+      const original = addStage(createDspPipeline());
+      await original.process(makeSignal(500), { channels: 1 });
+
+      const restored = addStage(createDspPipeline());
+      await restored.loadState(await original.saveState());
+
+      const next = makeSignal(20, 500);
+      const expected = await original.process(new Float32Array(next), {
+        channels: 1,
+      });
+      const actual = await restored.process(new Float32Array(next), {
+        channels: 1,
+      });
+      assertClose(actual, expected);
+    });
+  }
+});
@@ -0,0 +1,118 @@
+import { describe, test } from "node:test";
+import assert from "node:assert/strict";
+import { createDspPipeline } from "../bindings.js";
+
+function makeSignal(length: number, offset = 0): Float32Array {
+  const signal = new Float32Array(length);
+  for (let i = 0; i < length; i++) {
+    const t = i + offset;
+    signal[i] = Math.sin(t * 0.13) * 1.5 + Math.cos(t * 0.9) * 0.4;
+  }
+  return signal;
+}
+
+function buildPipeline() {
+  return createDspPipeline()
+    .MovingAverage({ mode: "moving", windowSize: 16 })
+    .Rms({ mode: "moving", windowDuration: 20 })
+    .ZScoreNormalize({ mode: "moving", windowSize: 64 });
+}
+
+describe("prepare", () => {
+  test("should not change the output", async () => {
+    const options = { channels: 4, sampleRate: 1000 };
+    const prepared = buildPipeline().prepare({
+      maxBlockSize: 128,
+      channels: 4,
+      sampleRate: 1000,
+    });
+    const lazy = buildPipeline();
+
+    for (const [offset, frames] of [
+      [0, 128],
+      [128, 7],
+      [135, 100],
+    ]) {
+      const chunk = makeSignal(frames * 4, offset * 4);
+      const actual = await prepared.process(new Float32Array(chunk), options);
+      const expected = await lazy.process(new Float32Array(chunk), options);
+      assert.deepEqual(actual, expected);
+    }
+  });
+
+  test("should keep resizing stages consistent", async () => {
+    const build = () =>
+      createDspPipeline()
+        .EmgFeatures({
+          windowSize: 32,
+          hopSize: 8,
+          features: ["rms", "waveformLength"],
+        })
+        .MovingAverage({ mode: "moving", windowSize: 4 });
+    const prepared = build().prepare({ maxBlockSize: 64, channels: 2 });
+    const lazy = build();
+
+    for (let offset = 0; offset < 256; offset += 64) {
+      const chunk = makeSignal(64 * 2, offset * 2);
+      const actual = await prepared.process(new Float32Array(chunk), {
+        channels: 2,
+      });
+      const expected = await lazy.process(new Float32Array(chunk), {
+        channels: 2,
+      });
+      assert.deepEqual(actual, expected);
+    }
+  });
+
+  test("should report allocations made while processing", async () => {
+    const pipeline = createDspPipeline()
+      .Rectify({ mode: "full" })
+      .Rms({ mode: "moving", windowSize: 32 })
+      .prepare({ maxBlockSize: 256, channels: 2 });
+
+    const before = pipeline.allocations();
+    assert.equal(before.prepared, true);
+    assert.equal(before.calls, 0);
+    assert.equal(before.maxBlockSize, 256);
+    assert.equal(before.channels, 2);
+
+    for (let i = 0; i < 5; i++) {
+      await pipeline.process(makeSignal(256 * 2, i * 512), { channels: 2 });
+    }
+
+    // Builds without --dspx_track_allocations=true always report zero
+    const report = pipeline.allocations();
+    assert.equal(report.calls, 5);
+    assert.equal(report.allocations, 0);
+    assert.equal(report.allocatingCalls, 0);
+
+    pipeline.MovingAverage({ mode: "moving", windowSize: 8 });
+    assert.equal(pipeline.allocations().prepared, false);
+  });
+
+  test("should need a sample rate for duration windows", () => {
+    assert.throws(
+      () =>
+        createDspPipeline()
+          .MovingAverage({ mode: "moving", windowDuration: 50 })
+          .prepare({ maxBlockSize: 64, channels: 1 }),
+      TypeError
+    );
+  });
+
+  test("should reject invalid options", () => {
+    const pipeline = buildPipeline();
+    assert.throws(
+      () => pipeline.prepare({ maxBlockSize: 0, channels: 1 }),
+      TypeError
+    );
+    assert.throws(
+      () => pipeline.prepare({ maxBlockSize: 64, channels: 1.5 }),
+      TypeError
+    );
+    assert.throws(
+      () => pipeline.prepare({ maxBlockSize: 64, channels: 1, sampleRate: -1 }),
+      TypeError
+    );
+  });
+});
@@ -0,0 +1,121 @@
+import { describe, test } from "node:test";
+import assert from "node:assert/strict";
+import { createDspPipeline } from "../bindings.js";
+import { assertClose, continueAfterRestore, makeNoise } from "./helpers.js";
+
+const SYSTEM = [0.6, -0.3, 0.2, 0.1];
+
+// [primary, reference] frames: a strongly colored (AR(1)) reference and a
+// primary that is the reference through an unknown 4-tap system
+function makeStream(frames: number): Float32Array {
+  const reference: number[] = [];
+  let previous = 0;
+  for (const n of makeNoise(frames, 7)) {
+    previous = 0.95 * previous + n;
+    reference.push(previous);
+  }
+  const stream = new Float32Array(frames * 2);
+  for (let i = 0; i < frames; i++) {
+    let primary = 0;
+    SYSTEM.forEach((h, k) => {
+      primary += i >= k ? h * reference[i - k] : 0;
+    });
+    stream[i * 2] = primary;
+    stream[i * 2 + 1] = reference[i];
+  }
+  return stream;
+}
+
+function rms(values: Float32Array, from: number, to: number): number {
+  let sum = 0;
+  for (let i = from; i < to; i++) {
+    sum += values[i] ** 2;
+  }
+  return Math.sqrt(sum / (to - from));
+}
+
+describe("RLS adaptive filter", () => {
+  test("should converge within a few hundred frames", async () => {
+    const stream = makeStream(400);
+    const primaryRms = rms(
+      stream.filter((_, i) => i % 2 === 0),
+      0,
+      400
+    );
+
+    const rls = await createDspPipeline()
+      .RlsFilter({ numTaps: 8, lambda: 0.999 })
+      .process(new Float32Array(stream), { channels: 2 });
+    const nlms = await createDspPipeline()
+      .NlmsFilter({ numTaps: 8, stepSize: 0.5 })
+      .process(new Float32Array(stream), { channels: 2 });
+
+    assert.strictEqual(rls.length, 400);
+    assert.ok(rms(rls, 100, 400) < 0.01 * primaryRms);
+    // The colored reference slows NLMS down by orders of magnitude
+    assert.ok(rms(nlms, 100, 400) > 10 * rms(rls, 100, 400));
+  });
+
+  test("should recover from a NaN reference sample", async () => {
+    const stream = makeStream(600);
+    const primaryRms = rms(
+      stream.filter((_, i) => i % 2 === 0),
+      0,
+      600
+    );
+    stream[300 * 2 + 1] = NaN;
+
+    const output = await createDspPipeline()
+      .RlsFilter({ numTaps: 8, lambda: 0.99 })
+      .process(stream, { channels: 2 });
+
+    // The dropout enters the window as 0 instead of poisoning P and w
+    assert.ok(output.every(Number.isFinite));
+    assert.ok(rms(output, 500, 600) < 0.01 * primaryRms);
+  });
+
+  test("should keep weights and P across a state restore", async () => {
+    const params = { numTaps: 8, lambda: 0.99 };
+    const stream = makeStream(600);
+    const first = stream.subarray(0, 300 * 2);
+    const rest = stream.subarray(300 * 2);
+
+    const original = createDspPipeline().RlsFilter(params);
+    await original.process(new Float32Array(first), { channels: 2 });
+
+    const { expected, restored } = await continueAfterRestore(
+      original,
+      () => createDspPipeline().RlsFilter(params),
+      rest,
+      { channels: 2 }
+    );
+    for (const actual of restored) {
+      assertClose(actual, expected);
+    }
+
+    const other = createDspPipeline().RlsFilter({ ...params, lambda: 0.95 });
+    await assert.rejects(
+      async () => other.loadState(await original.saveState()),
+      /mismatch/
+    );
+  });
+
+  test("should reject invalid parameters", () => {
+    assert.throws(
+      () => createDspPipeline().RlsFilter({ numTaps: 0 }),
+      TypeError
+    );
+    assert.throws(
+      () => createDspPipeline().RlsFilter({ numTaps: 8, lambda: 1.01 }),
+      TypeError
+    );
+    assert.throws(
+      () => createDspPipeline().RlsFilter({ numTaps: 8, lambda: 0 }),
+      TypeError
+    );
+    assert.throws(
+      () => createDspPipeline().RlsFilter({ numTaps: 8, delta: 0 }),
+      TypeError
+    );
+  });
+});
@@ -0,0 +1,136 @@
+import { describe, test, after } from "node:test";
+import assert from "node:assert/strict";
+import { createDspPipeline, getSimdInfo, setSimdLevel } from "../bindings.js";
+import { FftProcessor, MovingFftProcessor } from "../fft.js";
+import { FirFilter } from "../filters.js";
+import type { SimdLevel } from "../types.js";
+
+const initialLevel = getSimdInfo().level;
+
+function makeSignal(length: number): Float32Array {
+  const signal = new Float32Array(length);
+  for (let i = 0; i < length; i++) {
+    signal[i] = Math.sin(i * 0.37) * 3 + Math.cos(i * 1.3) - 0.25;
+  }
+  return signal;
+}
+
+// Rectify, batch sums and an FFT all run through the SimdOps kernels
+async function runKernels(level: SimdLevel) {
+  setSimdLevel(level);
+  const signal = makeSignal(1027);
+
+  const rectified = await createDspPipeline()
+    .Rectify({ mode: "full" })
+    .process(new Float32Array(signal), { channels: 1 });
+  const rms = await createDspPipeline()
+    .Rms({ mode: "batch" })
+    .process(new Float32Array(signal), { channels: 1 });
+  const spectrum = new FftProcessor(512).fft({
+    real: signal.subarray(0, 512),
+    imag: signal.subarray(512, 1024),
+  });
+
+  return { rectified, rms, spectrum };
+}
+
+// The remaining kernels, at lengths that leave a partial vector at the end
+async function runTailKernels(level: SimdLevel) {
+  setSimdLevel(level);
+  const signal = makeSignal(1021);
+
+  const fir = FirFilter.createLowPass({
+    cutoffFrequency: 1000,
+    sampleRate: 8000,
+    order: 37,
+  });
+  const filtered = await fir.process(new Float32Array(signal));
+  const average = await createDspPipeline()
+    .MovingAverage({ mode: "batch" })
+    .process(new Float32Array(signal), { channels: 1 });
+
+  const fft = new FftProcessor(1021);
+  const spectrum = fft.rdft(signal);
+  const magnitude = fft.getMagnitude(spectrum);
+  const power = fft.getPower(spectrum);
+
+  const windowed: Float32Array[] = [];
+  new MovingFftProcessor({ fftSize: 256, hopSize: 100 }).addSamples(
+    signal,
+    (frame) => windowed.push(new Float32Array(frame.real))
+  );
+
+  return { filtered, average, magnitude, power, windowed };
+}
+
+function assertClose(actual: ArrayLike<number>, expected: ArrayLike<number>) {
+  assert.strictEqual(actual.length, expected.length);
+  for (let i = 0; i < expected.length; i++) {
+    const tolerance = 1e-4 * Math.max(1, Math.abs(expected[i]));
+    assert.ok(
+      Math.abs(actual[i] - expected[i]) <= tolerance,
+      `index ${i}: ${actual[i]} vs ${expected[i]}`
+    );
+  }
+}
+
+describe("SIMD Kernel Dispatch", () => {
+  after(() => {
+    setSimdLevel(initialLevel);
+  });
+
+  test("should report the kernel set picked for this CPU", () => {
+    const info = getSimdInfo();
+    assert.ok(info.supported.includes("scalar"));
+    assert.ok(info.supported.includes(info.level));
+    assert.ok(info.supported.includes(info.best));
+    if (info.features.avx2) {
+      assert.ok(info.supported.includes("avx2"));
+    }
+    if (info.features.sse2) {
+      assert.ok(info.supported.includes("sse2"));
+    }
+  });
+
+  test("should give the scalar results at every supported level", async () => {
+    const reference = await runKernels("scalar");
+
+    for (const level of getSimdInfo().supported) {
+      const result = await runKernels(level);
+      assert.strictEqual(getSimdInfo().level, level);
+      assertClose(result.rectified, reference.rectified);
+      assertClose(result.rms, reference.rms);
+      assertClose(result.spectrum.real, reference.spectrum.real);
+      assertClose(result.spectrum.imag, reference.spectrum.imag);
+    }
+  });
+
+  test("should match scalar on odd lengths at every level", async () => {
+    const reference = await runTailKernels("scalar");
+
+    for (const level of getSimdInfo().supported) {
+      const result = await runTailKernels(level);
+      assertClose(result.filtered, reference.filtered);
+      assertClose(result.average, reference.average);
+      assertClose(result.magnitude, reference.magnitude);
+      assertClose(result.power, reference.power);
+      assert.strictEqual(result.windowed.length, reference.windowed.length);
+      result.windowed.forEach((frame, i) =>
+        assertClose(frame, reference.windowed[i])
+      );
+    }
+  });
+
+  test("should reject unknown and unsupported levels", () => {
+    const before = getSimdInfo().level;
+    assert.throws(() => setSimdLevel("mmx" as SimdLevel), TypeError);
+
+    const unsupported = (
+      ["sse2", "avx2", "avx512", "neon"] as SimdLevel[]
+    ).find((level) => !getSimdInfo().supported.includes(level));
+    if (unsupported) {
+      assert.throws(() => setSimdLevel(unsupported), /not supported/);
+    }
+    assert.strictEqual(getSimdInfo().level, before);
+  });
+});
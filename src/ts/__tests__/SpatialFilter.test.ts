@@ -0,0 +1,155 @@
+import { describe, test } from "node:test";
+import assert from "node:assert/strict";
+import { createDspPipeline } from "../bindings.js";
+import { assertRelativeClose, restoreCopies, signalOf } from "./helpers.js";
+
+const makeSignal = signalOf(
+  (t) => Math.sin(t * 0.37) * 2 + Math.cos(t * 0.05) - 0.3
+);
+
+// Reference: every frame times the matrix, in double precision
+function mix(signal: Float32Array, matrix: number[][]): number[] {
+  const channels = matrix[0].length;
+  const output: number[] = [];
+  for (let f = 0; f < signal.length / channels; f++) {
+    for (const row of matrix) {
+      let acc = 0;
+      for (let c = 0; c < channels; c++) {
+        acc += row[c] * signal[f * channels + c];
+      }
+      output.push(acc);
+    }
+  }
+  return output;
+}
+
+describe("Spatial Filter", () => {
+  test("should subtract the common average", async () => {
+    const channels = 64;
+    const signal = makeSignal(channels * 50);
+    const matrix = Array.from({ length: channels }, (_, m) =>
+      Array.from(
+        { length: channels },
+        (_, c) => (m === c ? 1 : 0) - 1 / channels
+      )
+    );
+
+    for (const layout of ["auto", "dense", "sparse"] as const) {
+      const output = await createDspPipeline()
+        .SpatialFilter({ mode: "car", channels, layout })
+        .process(new Float32Array(signal), { channels });
+      assertRelativeClose(output, mix(signal, matrix));
+    }
+  });
+
+  test("should build Laplacian and bipolar montages", async () => {
+    const signal = makeSignal(4 * 40);
+    const laplacian = await createDspPipeline()
+      .SpatialFilter({
+        mode: "laplacian",
+        neighbors: [[1], [0, 2], [1, 3], []],
+      })
+      .process(new Float32Array(signal), { channels: 4 });
+    assertRelativeClose(
+      laplacian,
+      mix(signal, [
+        [1, -1, 0, 0],
+        [-0.5, 1, -0.5, 0],
+        [0, -0.5, 1, -0.5],
+        [0, 0, 0, 1],
+      ])
+    );
+
+    const bipolar = await createDspPipeline()
+      .SpatialFilter({
+        mode: "bipolar",
+        channels: 4,
+        pairs: [
+          [0, 1],
+          [3, 2],
+        ],
+      })
+      .process(new Float32Array(signal), { channels: 4 });
+    assertRelativeClose(
+      bipolar,
+      mix(signal, [
+        [1, -1, 0, 0],
+        [0, 0, -1, 1],
+      ])
+    );
+  });
+
+  test("should change the channel count for later stages", async () => {
+    const matrix = [
+      [0.5, 0.25, -1],
+      [2, 0, 0.75],
+    ];
+    const signal = makeSignal(3 * 30);
+    const output = await createDspPipeline()
+      .SpatialFilter({ mode: "matrix", matrix })
+      .MovingAverage({ mode: "moving", windowSize: 1 })
+      .process(new Float32Array(signal), { channels: 3 });
+    assertRelativeClose(output, mix(signal, matrix));
+  });
+
+  test("should restore from snapshots of the same matrix only", async () => {
+    const original = createDspPipeline().SpatialFilter({
+      mode: "car",
+      channels: 8,
+    });
+    const state = await original.saveState();
+
+    await restoreCopies(original, () =>
+      createDspPipeline().SpatialFilter({ mode: "car", channels: 8 })
+    );
+
+    const other = createDspPipeline().SpatialFilter({
+      mode: "car",
+      channels: 6,
+    });
+    await assert.rejects(() => other.loadState(state), /mismatch/);
+  });
+
+  test("should reject a stream with another channel count", async () => {
+    const pipeline = createDspPipeline().SpatialFilter({
+      mode: "car",
+      channels: 4,
+    });
+    await assert.rejects(
+      () => pipeline.process(makeSignal(3 * 10), { channels: 3 }),
+      /expected 4 input channels/
+    );
+  });
+
+  test("should reject invalid parameters", () => {
+    assert.throws(
+      () => createDspPipeline().SpatialFilter({ mode: "car", channels: 0 }),
+      TypeError
+    );
+    assert.throws(
+      () =>
+        createDspPipeline().SpatialFilter({
+          mode: "bipolar",
+          channels: 2,
+          pairs: [[0, 2]],
+        }),
+      TypeError
+    );
+    assert.throws(
+      () =>
+        createDspPipeline().SpatialFilter({
+          mode: "laplacian",
+          neighbors: [[0], [0]],
+        }),
+      TypeError
+    );
+    assert.throws(
+      () =>
+        createDspPipeline().SpatialFilter({
+          mode: "matrix",
+          matrix: [[1, 2], [3]],
+        }),
+      TypeError
+    );
+  });
+});
@@ -1,6 +1,7 @@
 import { describe, test } from "node:test";
 import assert from "node:assert";
 import { createDspPipeline } from "../index.js";
+import { makeNoise } from "./helpers.js";
 
 describe("True Time-Based Expiration", () => {
   test("should expire samples based on age, not count", async () => {
@@ -121,4 +122,89 @@ describe("True Time-Based Expiration", () => {
     assert.ok(result1 instanceof Float32Array);
     assert.strictEqual(result1.length, 5);
   });
+
+  test("should derive an implicit clock from sampleRate", async () => {
+    // 100 Hz -> 10ms per sample, so a 25ms window holds 3 samples
+    const implicit = createDspPipeline();
+    implicit.MovingAverage({ mode: "moving", windowDuration: 25 });
+
+    const explicit = createDspPipeline();
+    explicit.MovingAverage({ mode: "moving", windowDuration: 25 });
+
+    const a = new Float32Array([3, 6, 9, 12, 15, 18]);
+    const b = new Float32Array(a);
+    const timestamps = new Float32Array([0, 10, 20, 30, 40, 50]);
+
+    await implicit.process(a, { channels: 1, sampleRate: 100 });
+    await explicit.process(b, timestamps, { channels: 1 });
+
+    assert.deepStrictEqual(Array.from(a), Array.from(b));
+    assert.ok(Math.abs(a[5] - 15) < 0.01, `Expected avg(12, 15, 18), got ${a[5]}`);
+  });
+
+  test("should match a brute-force window under clock jitter", async () => {
+    // 10ms period with jitter inside the implicit clock's 1% tolerance and a
+    // window of whole periods, so a sample sits right at every cutoff
+    const period = 10;
+    const duration = 100;
+    const length = 600;
+    const chunk = 150;
+    const values = makeNoise(length, 3);
+    const jitter = makeNoise(length, 7);
+    const timestamps = new Float32Array(length);
+    for (let i = 1; i < length; i++) {
+      timestamps[i] = i * period + jitter[i] * 0.04;
+    }
+
+    // Mean and variance of the samples in [cutoff, timestamps[i]]
+    const windowStats = (i: number, cutoff: number) => {
+      let sum = 0;
+      let sumSq = 0;
+      let n = 0;
+      for (let j = 0; j <= i; j++) {
+        if (timestamps[j] >= cutoff) {
+          const x = Math.fround(values[j]);
+          sum += x;
+          sumSq += x * x;
+          n++;
+        }
+      }
+      const mean = sum / n;
+      return { mean, variance: Math.max(0, sumSq / n - mean * mean) };
+    };
+
+    const average = createDspPipeline();
+    average.MovingAverage({ mode: "moving", windowDuration: duration });
+    const variance = createDspPipeline();
+    variance.Variance({ mode: "moving", windowDuration: duration });
+
+    for (let start = 0; start < length; start += chunk) {
+      const ts = timestamps.slice(start, start + chunk);
+      const input = new Float32Array(values.slice(start, start + chunk));
+      const means = await average.process(new Float32Array(input), ts, {
+        channels: 1,
+      });
+      const variances = await variance.process(input, ts, { channels: 1 });
+
+      for (let k = 0; k < means.length; k++) {
+        // The clock stores the boundary sample's timestamp only to within
+        // its tolerance, so that one sample may fall on either side
+        const i = start + k;
+        const cutoff = timestamps[i] - duration;
+        const slack = 0.01 * period;
+        const candidates = [
+          windowStats(i, cutoff - slack),
+          windowStats(i, cutoff + slack),
+        ];
+        assert.ok(
+          candidates.some(
+            (c) =>
+              Math.abs(means[k] - c.mean) < 1e-4 &&
+              Math.abs(variances[k] - c.variance) < 1e-4
+          ),
+          `index ${i}: mean ${means[k]}, variance ${variances[k]}`
+        );
+      }
+    }
+  });
 });
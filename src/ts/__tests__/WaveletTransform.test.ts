@@ -0,0 +1,176 @@
+import { describe, test } from "node:test";
+import assert from "node:assert/strict";
+import { createDspPipeline } from "../bindings.js";
+import { assertClose, continueAfterRestore, makeNoise } from "./helpers.js";
+
+const CHANNELS = 3;
+
+// Uniform noise in [-amplitude / 2, amplitude / 2], interleaved frames
+function makeFrames(frames: number, seed: number, amplitude: number) {
+  return Float32Array.from(
+    makeNoise(frames * CHANNELS, seed),
+    (n) => (n * amplitude) / 2
+  );
+}
+
+describe("Wavelet transform", () => {
+  test("should emit haar coefficients in Mallat order", async () => {
+    const output = await createDspPipeline()
+      .WaveletTransform({ wavelet: "haar", levels: 2 })
+      .process(new Float32Array([1, 3, 5, 7, 2, 2, 2, 2]), { channels: 1 });
+
+    // a2, d2, d1 (2 values) per block of 4 frames
+    const r = Math.SQRT2;
+    assertClose(output, [8, 4, r, r, 4, 0, 0, 0]);
+  });
+
+  test("should give the same frames for any chunking", async () => {
+    const signal = makeFrames(203, 3, 2);
+    const params = { wavelet: "db4" as const, levels: 3 };
+    const whole = await createDspPipeline()
+      .WaveletTransform(params)
+      .process(new Float32Array(signal), { channels: CHANNELS });
+
+    // One frame of CHANNELS * 8 coefficients per 8 input frames
+    assert.strictEqual(whole.length, 25 * CHANNELS * 8);
+
+    const pipeline = createDspPipeline().WaveletTransform(params);
+    const parts: number[] = [];
+    for (let start = 0; start < signal.length; start += CHANNELS * 5) {
+      const chunk = signal.slice(start, start + CHANNELS * 5);
+      parts.push(...(await pipeline.process(chunk, { channels: CHANNELS })));
+    }
+    assertClose(parts, whole, 1e-6);
+  });
+
+  test("should have zero details on a low-degree polynomial", async () => {
+    const signal = new Float32Array(256);
+    for (let t = 0; t < signal.length; t++) {
+      const u = t / 64;
+      signal[t] = u * u - u + 0.5;
+    }
+    // db3 has 3 vanishing moments, so a quadratic leaves only a_2
+    const output = await createDspPipeline()
+      .WaveletTransform({ wavelet: "db3", levels: 2 })
+      .process(signal, { channels: 1 });
+
+    assert.strictEqual(output.length, 256);
+    // Skip the frames whose filters still reach back before the signal
+    for (let frame = 4; frame < 64; frame++) {
+      for (let k = 1; k < 4; k++) {
+        assert.ok(Math.abs(output[frame * 4 + k]) < 1e-4);
+      }
+    }
+  });
+
+  test("should reconstruct the delayed input with no threshold", async () => {
+    const signal = makeFrames(300, 5, 4);
+    const output = await createDspPipeline()
+      .WaveletTransform({ wavelet: "db4", levels: 3, mode: "denoise" })
+      .process(new Float32Array(signal), { channels: CHANNELS });
+
+    // 2^3 - 1 + (4 - 1) * (2^4 - 2) frames
+    const latency = 49;
+    assert.strictEqual(output.length, signal.length);
+    assert.ok(output.subarray(0, latency * CHANNELS).every((v) => v === 0));
+    assertClose(
+      output.subarray(latency * CHANNELS),
+      signal.subarray(0, signal.length - latency * CHANNELS)
+    );
+  });
+
+  test("should remove noise by thresholding the details", async () => {
+    const frames = 1024;
+    const latency = 49;
+    const noise = makeFrames(frames, 7, 0.6);
+    const clean = new Float32Array(frames * CHANNELS);
+    for (let f = 0; f < frames; f++) {
+      for (let c = 0; c < CHANNELS; c++) {
+        clean[f * CHANNELS + c] = Math.sin((2 * Math.PI * f) / 64 + c);
+      }
+    }
+    const noisy = clean.map((v, i) => v + noise[i]);
+
+    const error = (output: Float32Array) => {
+      let sum = 0;
+      let raw = 0;
+      for (let i = 200 * CHANNELS; i < output.length; i++) {
+        const truth = clean[i - latency * CHANNELS];
+        sum += (output[i] - truth) ** 2;
+        raw += (noisy[i - latency * CHANNELS] - truth) ** 2;
+      }
+      return Math.sqrt(sum / raw);
+    };
+
+    for (const [thresholdMode, ratio] of [
+      ["soft", 0.5],
+      ["hard", 0.8],
+    ] as const) {
+      const output = await createDspPipeline()
+        .WaveletTransform({
+          wavelet: "db4",
+          levels: 3,
+          mode: "denoise",
+          threshold: [0.3, 0.3, 0.3],
+          thresholdMode,
+        })
+        .process(new Float32Array(noisy), { channels: CHANNELS });
+      assert.ok(error(output) < ratio, thresholdMode);
+    }
+  });
+
+  test("should continue exactly across a restore", async () => {
+    const signal = makeFrames(400, 9, 2);
+    const first = signal.subarray(0, 173 * CHANNELS);
+    const rest = signal.subarray(173 * CHANNELS);
+
+    for (const mode of ["decompose", "denoise"] as const) {
+      const params = { wavelet: "db6" as const, levels: 2, mode };
+      const original = createDspPipeline().WaveletTransform(params);
+      await original.process(new Float32Array(first), { channels: CHANNELS });
+
+      const { expected, restored } = await continueAfterRestore(
+        original,
+        () => createDspPipeline().WaveletTransform(params),
+        rest,
+        { channels: CHANNELS }
+      );
+      for (const actual of restored) {
+        assertClose(actual, expected, 1e-6);
+      }
+
+      const other = createDspPipeline().WaveletTransform({
+        ...params,
+        wavelet: "db5",
+      });
+      await assert.rejects(
+        async () => other.loadState(await original.saveState()),
+        /mismatch/
+      );
+    }
+  });
+
+  test("should reject invalid parameters", () => {
+    assert.throws(
+      () =>
+        createDspPipeline().WaveletTransform({ wavelet: "db11" as "db10" }),
+      TypeError
+    );
+    assert.throws(
+      () => createDspPipeline().WaveletTransform({ levels: 0 }),
+      TypeError
+    );
+    assert.throws(
+      () =>
+        createDspPipeline().WaveletTransform({
+          levels: 2,
+          threshold: [0.1, 0.2, 0.3],
+        }),
+      TypeError
+    );
+    assert.throws(
+      () => createDspPipeline().WaveletTransform({ threshold: -1 }),
+      TypeError
+    );
+  });
+});
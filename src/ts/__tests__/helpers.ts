@@ -0,0 +1,96 @@
+// Shared by the stage tests; not a test file itself (scripts/test.js only
+// runs *.test.ts)
+import assert from "node:assert/strict";
+import type { DspProcessor } from "../bindings.js";
+import type { ProcessOptions } from "../types.js";
+
+// Signal generator sampling `wave`: makeSignal(length, offset) returns
+// samples [offset, offset + length), so a later call with offset = the
+// previous length continues the same signal
+export function signalOf(wave: (t: number) => number) {
+  return (length: number, offset = 0): Float32Array => {
+    const signal = new Float32Array(length);
+    for (let i = 0; i < length; i++) {
+      signal[i] = wave(i + offset);
+    }
+    return signal;
+  };
+}
+
+// Two tones and a DC offset
+export const makeSignal = signalOf(
+  (t) => Math.sin(t * 0.3) * 2 + Math.cos(t * 1.7) - 0.2
+);
+
+// Deterministic pseudo-random noise in [-1, 1)
+export function makeNoise(length: number, seed = 1): number[] {
+  const noise: number[] = [];
+  let state = seed;
+  for (let i = 0; i < length; i++) {
+    state = (Math.imul(state, 1103515245) + 12345) >>> 0;
+    noise.push(state / 2147483648 - 1);
+  }
+  return noise;
+}
+
+// Element-wise |actual - expected| <= tolerance
+export function assertClose(
+  actual: ArrayLike<number>,
+  expected: ArrayLike<number>,
+  tolerance = 1e-5
+) {
+  assert.strictEqual(actual.length, expected.length);
+  for (let i = 0; i < expected.length; i++) {
+    assert.ok(
+      Math.abs(actual[i] - expected[i]) <= tolerance,
+      `index ${i}: ${actual[i]} vs ${expected[i]}`
+    );
+  }
+}
+
+// Element-wise |actual - expected| <= tolerance, with the tolerance scaled
+// by |expected| above 1
+export function assertRelativeClose(
+  actual: ArrayLike<number>,
+  expected: ArrayLike<number>,
+  tolerance = 1e-4
+) {
+  assert.strictEqual(actual.length, expected.length);
+  for (let i = 0; i < expected.length; i++) {
+    const scaled = tolerance * Math.max(1, Math.abs(expected[i]));
+    assert.ok(
+      Math.abs(actual[i] - expected[i]) <= scaled,
+      `index ${i}: ${actual[i]} vs ${expected[i]}`
+    );
+  }
+}
+
+// Fresh pipelines from `build`, one restored from the JSON state of
+// `original` and one from its binary snapshot
+export async function restoreCopies(
+  original: DspProcessor,
+  build: () => DspProcessor
+): Promise<DspProcessor[]> {
+  const json = build();
+  await json.loadState(await original.saveState());
+  const binary = build();
+  await binary.loadStateBinary(await original.saveStateBinary());
+  return [json, binary];
+}
+
+// Processes `next` through `original` and through both restored copies;
+// each copy should continue exactly where the original left off
+export async function continueAfterRestore(
+  original: DspProcessor,
+  build: () => DspProcessor,
+  next: Float32Array,
+  options: ProcessOptions
+): Promise<{ expected: Float32Array; restored: Float32Array[] }> {
+  const copies = await restoreCopies(original, build);
+  const expected = await original.process(new Float32Array(next), options);
+  const restored: Float32Array[] = [];
+  for (const copy of copies) {
+    restored.push(await copy.process(new Float32Array(next), options));
+  }
+  return { expected, restored };
+}
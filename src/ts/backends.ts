@@ -425,13 +425,15 @@ export function createPrometheusHandler(config: BackendConfig) {
       await retryWithBackoff(async () => {
         // Convert log to Prometheus metrics format
         const metricName = log.topic?.replace(/\./g, "_") || "pipeline_metric";
+        // context.value is the sample; every other entry becomes a label
         const labels = Object.entries(log.context || {})
-          .map(([key, value]) => `${key}="${value}"`)
-          .join(",");
+          .filter(([key]) => key !== "value")
+          .map(([key, value]) => `${key}="${value}",`)
+          .join("");
 
         const timestamp = normalizeTimestamp(log.timestamp, "ms");
-        const metric = `${metricName}{${labels},schema="${SCHEMA_VERSION}"} ${
-          log.context?.value || 1
+        const metric = `${metricName}{${labels}schema="${SCHEMA_VERSION}"} ${
+          log.context?.value ?? 1
         } ${timestamp}`;
 
         try {
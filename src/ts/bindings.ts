@@ -14,11 +14,35 @@ import type {
   WaveformLengthParams,
   SlopeSignChangeParams,
   WillisonAmplitudeParams,
+  MovingMedianParams,
+  MovingPercentileParams,
+  MovingStatisticsParams,
+  MovingStatisticName,
+  EmgFeaturesParams,
+  EmgFeatureName,
+  PrebuiltParams,
+  PrebuiltPipelineName,
+  SpatialFilterParams,
+  PcaParams,
+  LmsFilterParams,
+  NlmsFilterParams,
+  RlsFilterParams,
+  KalmanFilterParams,
+  WaveletTransformParams,
   PipelineCallbacks,
   LogEntry,
   SampleBatch,
   TapCallback,
   PipelineStateSummary,
+  PrepareOptions,
+  AllocationReport,
+  CheckpointOptions,
+  SnapshotInfo,
+  SnapshotCodec,
+  DurationStats,
+  PipelineMetrics,
+  SimdInfo,
+  SimdLevel,
 } from "./types.js";
 import { CircularLogBuffer } from "./CircularLogBuffer.js";
 import { DriftDetector } from "./DriftDetector.js";
@@ -61,6 +85,31 @@ try {
   }
 }
 
+// Statistic names accepted by the movingStatistics stage
+const MOVING_STATISTICS: readonly MovingStatisticName[] = [
+  "mean",
+  "rms",
+  "meanAbsoluteValue",
+  "variance",
+];
+
+// Feature names accepted by the emgFeatures stage
+const EMG_FEATURES: readonly EmgFeatureName[] = [
+  "meanAbsoluteValue",
+  "rms",
+  "waveformLength",
+  "slopeSignChange",
+  "willisonAmplitude",
+  "zeroCrossings",
+  "variance",
+];
+
+// Chains accepted by the prebuilt stage
+const PREBUILT_PIPELINES: readonly PrebuiltPipelineName[] = [
+  "rectifyMavZScore",
+  "rmsZScore",
+];
+
 /**
  * DSP Processor class that wraps the native C++ DspPipeline
  * Provides a fluent API for building and processing DSP pipelines
@@ -553,6 +602,772 @@ class DspProcessor {
     return this;
   }
 
+  /**
+   * Add a moving median stage to the pipeline
+   * Replaces each sample with the median of its window; robust to spikes and outliers
+   * NaN samples (dropouts) are left out of the window's order statistics
+   *
+   * @param params - Configuration for the moving median filter
+   * @param params.windowSize - Number of samples in the sliding window
+   * @param params.windowDuration - Window duration in milliseconds (time-based processing)
+   * @param params.method - "exact" (default, O(log w) per sample) or "approximate" (P², constant memory)
+   * @returns this instance for method chaining
+   *
+   * @example
+   * // Despike a signal with a 5-sample median
+   * pipeline.MovingMedian({ windowSize: 5 });
+   *
+   * @example
+   * // Robust baseline over a long window with bounded memory
+   * pipeline.MovingMedian({ windowSize: 100000, method: "approximate" });
+   */
+  MovingMedian(params: MovingMedianParams): this {
+    this.validatePercentileParams("MovingMedian", params);
+    this.nativeInstance.addStage("movingMedian", params);
+    this.stages.push(`movingMedian:${params.method || "exact"}`);
+    return this;
+  }
+
+  /**
+   * Add a moving percentile stage to the pipeline
+   * Replaces each sample with the given percentile of its window (linear interpolation)
+   * NaN samples (dropouts) are left out of the window's order statistics
+   *
+   * @param params - Configuration for the moving percentile filter
+   * @param params.percentile - Percentile to track (0-100)
+   * @param params.windowSize - Number of samples in the sliding window
+   * @param params.windowDuration - Window duration in milliseconds (time-based processing)
+   * @param params.method - "exact" (default, O(log w) per sample) or "approximate" (P², constant memory)
+   * @returns this instance for method chaining
+   *
+   * @example
+   * // 90th percentile envelope over 200 samples
+   * pipeline.MovingPercentile({ percentile: 90, windowSize: 200 });
+   */
+  MovingPercentile(params: MovingPercentileParams): this {
+    if (
+      typeof params.percentile !== "number" ||
+      !(params.percentile >= 0 && params.percentile <= 100)
+    ) {
+      throw new TypeError(
+        `MovingPercentile: percentile must be between 0 and 100, got ${params.percentile}`
+      );
+    }
+    this.validatePercentileParams("MovingPercentile", params);
+    this.nativeInstance.addStage("movingPercentile", params);
+    this.stages.push(`movingPercentile:${params.percentile}`);
+    return this;
+  }
+
+  /**
+   * Add a multi-statistic moving window stage to the pipeline
+   * Computes several moving statistics from one shared window per channel,
+   * instead of one window per MovingAverage / Rms / MeanAbsoluteValue /
+   * Variance stage
+   *
+   * Every input channel becomes statistics.length output channels, so
+   * process() resolves with a new Float32Array of
+   * input.length * statistics.length values ([channel][statistic] per frame).
+   * Stages added after it see that many channels.
+   *
+   * @param params - Configuration for the moving statistics
+   * @param params.windowSize - Number of samples per channel in the window
+   * @param params.statistics - Statistics to compute, in output order
+   * @returns this instance for method chaining
+   *
+   * @example
+   * // Mean and variance of each of 4 channels -> 8 output channels
+   * pipeline.MovingStatistics({
+   *   windowSize: 100,
+   *   statistics: ["mean", "variance"],
+   * });
+   */
+  MovingStatistics(params: MovingStatisticsParams): this {
+    if (params.windowSize <= 0 || !Number.isInteger(params.windowSize)) {
+      throw new TypeError(
+        `MovingStatistics: windowSize must be a positive integer, got ${params.windowSize}`
+      );
+    }
+    if (!Array.isArray(params.statistics) || params.statistics.length === 0) {
+      throw new TypeError("MovingStatistics: statistics must not be empty");
+    }
+    for (const statistic of params.statistics) {
+      if (!MOVING_STATISTICS.includes(statistic)) {
+        throw new TypeError(
+          `MovingStatistics: unknown statistic "${statistic}"`
+        );
+      }
+    }
+    this.nativeInstance.addStage("movingStatistics", params);
+    this.stages.push(`movingStatistics:${params.statistics.join("+")}`);
+    return this;
+  }
+
+  /**
+   * Add a fused EMG feature stage to the pipeline
+   * Computes several time-domain EMG features from one shared window per
+   * channel, in a single pass, and emits one feature frame per hop
+   *
+   * Unlike the other stages this one changes the shape of the stream:
+   * process() resolves with a new Float32Array holding one frame per hop,
+   * each with numChannels * features.length values ([channel][feature]).
+   * Stages added after it see that many channels.
+   *
+   * @param params - Configuration for the feature extractor
+   * @param params.windowSize - Number of samples per channel in each window
+   * @param params.hopSize - Input frames between feature frames (default: windowSize)
+   * @param params.features - Features to compute, in output order (default: all)
+   * @param params.sscThreshold - Slope sign change threshold (default: 0.0)
+   * @param params.wampThreshold - Willison amplitude threshold (default: 0.0)
+   * @param params.zcThreshold - Minimum zero-crossing step (default: 0.0)
+   * @returns this instance for method chaining
+   *
+   * @example
+   * // 200-sample windows every 50 samples, four features per channel
+   * pipeline.EmgFeatures({
+   *   windowSize: 200,
+   *   hopSize: 50,
+   *   features: ["meanAbsoluteValue", "rms", "waveformLength", "zeroCrossings"],
+   * });
+   */
+  EmgFeatures(params: EmgFeaturesParams): this {
+    if (params.windowSize <= 0 || !Number.isInteger(params.windowSize)) {
+      throw new TypeError(
+        `EmgFeatures: windowSize must be a positive integer, got ${params.windowSize}`
+      );
+    }
+    if (
+      params.hopSize !== undefined &&
+      (params.hopSize <= 0 || !Number.isInteger(params.hopSize))
+    ) {
+      throw new TypeError(
+        `EmgFeatures: hopSize must be a positive integer, got ${params.hopSize}`
+      );
+    }
+    if (params.features !== undefined) {
+      if (params.features.length === 0) {
+        throw new TypeError("EmgFeatures: features must not be empty");
+      }
+      for (const feature of params.features) {
+        if (!EMG_FEATURES.includes(feature)) {
+          throw new TypeError(`EmgFeatures: unknown feature "${feature}"`);
+        }
+      }
+    }
+    const thresholds = ["sscThreshold", "wampThreshold", "zcThreshold"] as const;
+    for (const key of thresholds) {
+      const value = params[key];
+      if (value !== undefined && value < 0) {
+        throw new TypeError(
+          `EmgFeatures: ${key} must be non-negative, got ${value}`
+        );
+      }
+    }
+    this.nativeInstance.addStage("emgFeatures", params);
+    this.stages.push(
+      `emgFeatures:${params.windowSize}/${params.hopSize ?? params.windowSize}`
+    );
+    return this;
+  }
+
+  /**
+   * Add a prebuilt stage chain to the pipeline
+   * Runs a fixed chain of stages that is compiled into one fused loop
+   * instead of one pass (and one buffer round trip) per stage
+   *
+   * The output matches the same stages added one by one in "moving" mode
+   * with sample-count windows, e.g. "rectifyMavZScore" matches
+   * Rectify() -> MeanAbsoluteValue() -> ZScoreNormalize().
+   *
+   * @param params - Configuration for the chain
+   * @param params.name - "rectifyMavZScore" or "rmsZScore"
+   * @param params.windowSize - Envelope window in samples per channel
+   * @param params.zScoreWindowSize - Normalization window (default: windowSize)
+   * @param params.epsilon - Minimum standard deviation (default: 1e-6)
+   * @param params.mode - Rectify mode, "full" or "half" (default: "full")
+   * @returns this instance for method chaining
+   *
+   * @example
+   * // Rectified EMG envelope, normalized over the last 2000 samples
+   * pipeline.Prebuilt({
+   *   name: "rectifyMavZScore",
+   *   windowSize: 100,
+   *   zScoreWindowSize: 2000,
+   * });
+   */
+  Prebuilt(params: PrebuiltParams): this {
+    if (!PREBUILT_PIPELINES.includes(params.name)) {
+      throw new TypeError(`Prebuilt: unknown pipeline "${params.name}"`);
+    }
+    if (params.windowSize <= 0 || !Number.isInteger(params.windowSize)) {
+      throw new TypeError(
+        `Prebuilt: windowSize must be a positive integer, got ${params.windowSize}`
+      );
+    }
+    if (
+      params.zScoreWindowSize !== undefined &&
+      (params.zScoreWindowSize <= 0 ||
+        !Number.isInteger(params.zScoreWindowSize))
+    ) {
+      throw new TypeError(
+        `Prebuilt: zScoreWindowSize must be a positive integer, got ${params.zScoreWindowSize}`
+      );
+    }
+    if (params.epsilon !== undefined && params.epsilon < 0) {
+      throw new TypeError(
+        `Prebuilt: epsilon must be non-negative, got ${params.epsilon}`
+      );
+    }
+    if (params.mode !== undefined && !["full", "half"].includes(params.mode)) {
+      throw new TypeError(`Prebuilt: unknown rectify mode "${params.mode}"`);
+    }
+    this.nativeInstance.addStage("prebuilt", params);
+    this.stages.push(`prebuilt:${params.name}`);
+    return this;
+  }
+
+  /**
+   * Add a spatial filter stage to the pipeline
+   * Mixes the channels of every frame through a matrix: re-referencing
+   * (common average, Laplacian, bipolar montages) or custom weights such as
+   * CSP / ICA unmixing matrices
+   *
+   * The output has one channel per matrix row, so with bipolar montages or
+   * custom matrices the stream can change width: process() then resolves
+   * with a new Float32Array and stages added after it see that many
+   * channels. The input channel count must match the matrix.
+   *
+   * Dense matrices run as a cache-blocked SIMD matrix multiply over the
+   * chunk; montage-style matrices use a sparse path (see layout).
+   *
+   * @param params - Configuration for the spatial filter
+   * @param params.mode - "car", "laplacian", "bipolar" or "matrix"
+   * @param params.channels - Input channels ("car" and "bipolar")
+   * @param params.neighbors - Neighbor indices per channel ("laplacian")
+   * @param params.pairs - [a, b] pairs, output a - b ("bipolar")
+   * @param params.matrix - Rows of weights, one per output ("matrix")
+   * @param params.layout - "auto" (default), "dense" or "sparse"
+   * @returns this instance for method chaining
+   *
+   * @example
+   * // Re-reference 256-channel EEG to the common average
+   * pipeline.SpatialFilter({ mode: "car", channels: 256 });
+   *
+   * @example
+   * // Two bipolar derivations from 4 electrodes
+   * pipeline.SpatialFilter({
+   *   mode: "bipolar",
+   *   channels: 4,
+   *   pairs: [[0, 1], [2, 3]],
+   * });
+   */
+  SpatialFilter(params: SpatialFilterParams): this {
+    const isIndex = (value: number, channels: number) =>
+      Number.isInteger(value) && value >= 0 && value < channels;
+    const checkChannels = (channels: number) => {
+      if (channels <= 0 || !Number.isInteger(channels)) {
+        throw new TypeError(
+          `SpatialFilter: channels must be a positive integer, got ${channels}`
+        );
+      }
+    };
+    if (
+      params.layout !== undefined &&
+      !["auto", "dense", "sparse"].includes(params.layout)
+    ) {
+      throw new TypeError(`SpatialFilter: unknown layout "${params.layout}"`);
+    }
+
+    let native: Record<string, unknown>;
+    switch (params.mode) {
+      case "car":
+        checkChannels(params.channels);
+        native = { ...params };
+        break;
+      case "laplacian": {
+        const { neighbors } = params;
+        if (!Array.isArray(neighbors) || neighbors.length === 0) {
+          throw new TypeError("SpatialFilter: neighbors must not be empty");
+        }
+        neighbors.forEach((list, channel) => {
+          for (const neighbor of list) {
+            if (!isIndex(neighbor, neighbors.length) || neighbor === channel) {
+              throw new TypeError(
+                `SpatialFilter: invalid neighbor ${neighbor} of channel ${channel}`
+              );
+            }
+          }
+        });
+        native = { ...params };
+        break;
+      }
+      case "bipolar":
+        checkChannels(params.channels);
+        if (!Array.isArray(params.pairs) || params.pairs.length === 0) {
+          throw new TypeError("SpatialFilter: pairs must not be empty");
+        }
+        for (const [a, b] of params.pairs) {
+          if (
+            !isIndex(a, params.channels) ||
+            !isIndex(b, params.channels) ||
+            a === b
+          ) {
+            throw new TypeError(`SpatialFilter: invalid pair [${a}, ${b}]`);
+          }
+        }
+        native = { ...params };
+        break;
+      case "matrix": {
+        const { matrix } = params;
+        const channels = matrix?.[0]?.length ?? 0;
+        if (channels === 0) {
+          throw new TypeError("SpatialFilter: matrix must not be empty");
+        }
+        if (matrix.some((row) => row.length !== channels)) {
+          throw new TypeError(
+            "SpatialFilter: every matrix row must have the same length"
+          );
+        }
+        const weights = matrix.flat();
+        if (!weights.every(Number.isFinite)) {
+          throw new TypeError("SpatialFilter: weights must be finite");
+        }
+        native = { mode: "matrix", channels, weights, layout: params.layout };
+        break;
+      }
+      default:
+        throw new TypeError(
+          `SpatialFilter: unknown mode "${(params as { mode: string }).mode}"`
+        );
+    }
+    if (native.layout === undefined) {
+      delete native.layout;
+    }
+    this.nativeInstance.addStage("spatialFilter", native);
+    this.stages.push(`spatialFilter:${params.mode}`);
+    return this;
+  }
+
+  /**
+   * Add a streaming PCA / whitening stage to the pipeline
+   * Tracks the channel covariance of the stream (sliding window or
+   * exponential weighting) and projects every frame onto its principal
+   * components, optionally whitened
+   *
+   * The covariance is re-decomposed every updateInterval frames. By default
+   * that happens on a worker thread and the new projection is swapped in
+   * without blocking process(), so it may take effect a chunk later. The
+   * output is 0 until the first decomposition (2 frames at the earliest).
+   *
+   * With components set, "pca" and "whiten" change the channel count and
+   * stages added after it see that many channels; "zca" always keeps one
+   * output per input channel.
+   *
+   * @param params - Configuration for the PCA stage
+   * @param params.mode - "pca" (default), "whiten" or "zca"
+   * @param params.components - Components kept, largest first
+   * @param params.windowSize - Sliding covariance window in frames
+   * @param params.alpha - Exponential weight per frame (instead of windowSize)
+   * @param params.updateInterval - Frames between decompositions (default 256)
+   * @param params.epsilon - Whitening regularization (default 1e-6)
+   * @param params.background - Decompose on a worker thread (default true)
+   * @returns this instance for method chaining
+   *
+   * @example
+   * // Whiten 64-channel EEG over the last 10 s at 250 Hz
+   * pipeline.Pca({ mode: "whiten", windowSize: 2500 });
+   *
+   * @example
+   * // Keep the 8 strongest components of an adapting estimate
+   * pipeline.Pca({ components: 8, alpha: 0.001 });
+   */
+  Pca(params: PcaParams): this {
+    const mode = params.mode ?? "pca";
+    if (!["pca", "whiten", "zca"].includes(mode)) {
+      throw new TypeError(`Pca: unknown mode "${mode}"`);
+    }
+    if ((params.windowSize === undefined) === (params.alpha === undefined)) {
+      throw new TypeError(
+        "Pca: exactly one of windowSize and alpha is required"
+      );
+    }
+    const checkCount = (name: string, value: number | undefined) => {
+      if (value !== undefined && (value <= 0 || !Number.isInteger(value))) {
+        throw new TypeError(
+          `Pca: ${name} must be a positive integer, got ${value}`
+        );
+      }
+    };
+    checkCount("components", params.components);
+    checkCount("windowSize", params.windowSize);
+    checkCount("updateInterval", params.updateInterval);
+    if (
+      params.alpha !== undefined &&
+      !(params.alpha > 0 && params.alpha <= 1)
+    ) {
+      throw new TypeError(`Pca: alpha must be in (0, 1], got ${params.alpha}`);
+    }
+    if (
+      params.epsilon !== undefined &&
+      !(params.epsilon >= 0 && Number.isFinite(params.epsilon))
+    ) {
+      throw new TypeError(
+        `Pca: epsilon must be non-negative, got ${params.epsilon}`
+      );
+    }
+
+    this.nativeInstance.addStage("pca", { ...params, mode });
+    this.stages.push(`pca:${mode}`);
+    return this;
+  }
+
+  /**
+   * Add an LMS adaptive filter stage to the pipeline
+   * Adaptive noise cancellation with a reference channel: every other
+   * channel gets its own adaptive FIR filter over the reference, and the
+   * stage outputs the channel minus the filter's estimate (powerline hum,
+   * motion artifacts or anything else correlated with the reference)
+   *
+   * The reference channel is dropped from the output, so a stream with
+   * C channels continues with C - 1. The adapted weights are part of the
+   * pipeline state, so saveState() / loadState() carry them across
+   * restarts.
+   *
+   * @param params - Configuration for the LMS filter
+   * @param params.numTaps - Taps of every adaptive filter
+   * @param params.stepSize - Adaptation rate (mu)
+   * @param params.referenceChannel - Reference channel index (default: last)
+   * @returns this instance for method chaining
+   *
+   * @example
+   * // EMG on channels 0-1, accelerometer motion reference on channel 2
+   * pipeline.LmsFilter({ numTaps: 32, stepSize: 0.001 });
+   */
+  LmsFilter(params: LmsFilterParams): this {
+    this.validateAdaptiveParams("LmsFilter", params);
+    this.nativeInstance.addStage("lmsFilter", { ...params });
+    this.stages.push(`lmsFilter:${params.numTaps}`);
+    return this;
+  }
+
+  /**
+   * Add an NLMS (normalized LMS) adaptive filter stage to the pipeline
+   * Same as LmsFilter, but every update is divided by the energy of the
+   * reference window, so convergence does not depend on the reference
+   * level and any 0 < stepSize < 2 is stable
+   *
+   * @param params - Configuration for the NLMS filter
+   * @param params.numTaps - Taps of every adaptive filter
+   * @param params.stepSize - Normalized adaptation rate, in (0, 2)
+   * @param params.epsilon - Regularization of the energy, > 0 (default 1e-6)
+   * @param params.referenceChannel - Reference channel index (default: last)
+   * @returns this instance for method chaining
+   *
+   * @example
+   * // Remove 50 Hz hum picked up by a dedicated mains reference electrode
+   * pipeline.NlmsFilter({ numTaps: 16, stepSize: 0.1, referenceChannel: 0 });
+   */
+  NlmsFilter(params: NlmsFilterParams): this {
+    this.validateAdaptiveParams("NlmsFilter", params);
+    if (params.stepSize >= 2) {
+      throw new TypeError(
+        `NlmsFilter: stepSize must be below 2, got ${params.stepSize}`
+      );
+    }
+    if (
+      params.epsilon !== undefined &&
+      !(params.epsilon > 0 && Number.isFinite(params.epsilon))
+    ) {
+      throw new TypeError(
+        `NlmsFilter: epsilon must be positive, got ${params.epsilon}`
+      );
+    }
+    this.nativeInstance.addStage("nlmsFilter", { ...params });
+    this.stages.push(`nlmsFilter:${params.numTaps}`);
+    return this;
+  }
+
+  /**
+   * Add an RLS (recursive least squares) adaptive filter stage to the pipeline
+   * Same channel routing as LmsFilter (the reference channel drives one
+   * adaptive filter per remaining channel and is dropped from the output),
+   * but the weights are the exact exponentially weighted least-squares
+   * solution at every frame. It converges within a few times numTaps
+   * frames, even when the reference is strongly colored and NLMS would
+   * need thousands.
+   *
+   * Each frame costs O(numTaps²) once, plus O(numTaps) per channel, so
+   * it suits orders up to a few dozen taps. The inverse correlation
+   * matrix is saved with the weights in saveState().
+   *
+   * @param params - Configuration for the RLS filter
+   * @param params.numTaps - Taps of every adaptive filter
+   * @param params.lambda - Forgetting factor in (0, 1] (default 0.99)
+   * @param params.delta - Initial regularization (default 0.01)
+   * @param params.referenceChannel - Reference channel index (default: last)
+   * @returns this instance for method chaining
+   *
+   * @example
+   * // Echo cancellation: microphone on channel 0, loudspeaker feed on 1
+   * pipeline.RlsFilter({ numTaps: 32, lambda: 0.999 });
+   */
+  RlsFilter(params: RlsFilterParams): this {
+    if (params.numTaps <= 0 || !Number.isInteger(params.numTaps)) {
+      throw new TypeError(
+        `RlsFilter: numTaps must be a positive integer, got ${params.numTaps}`
+      );
+    }
+    if (
+      params.lambda !== undefined &&
+      !(params.lambda > 0 && params.lambda <= 1)
+    ) {
+      throw new TypeError(
+        `RlsFilter: lambda must be in (0, 1], got ${params.lambda}`
+      );
+    }
+    if (
+      params.delta !== undefined &&
+      !(params.delta > 0 && Number.isFinite(params.delta))
+    ) {
+      throw new TypeError(
+        `RlsFilter: delta must be positive, got ${params.delta}`
+      );
+    }
+    if (
+      params.referenceChannel !== undefined &&
+      (params.referenceChannel < 0 ||
+        !Number.isInteger(params.referenceChannel))
+    ) {
+      throw new TypeError(
+        `RlsFilter: referenceChannel must be a channel index, got ${params.referenceChannel}`
+      );
+    }
+    this.nativeInstance.addStage("rlsFilter", { ...params });
+    this.stages.push(`rlsFilter:${params.numTaps}`);
+    return this;
+  }
+
+  /**
+   * Add a Kalman filter stage: one independent filter per channel
+   *
+   * Every channel runs its own filter over the same small state-space
+   * model, and each sample is replaced by its channel's filtered
+   * estimate. The filters are updated together, vectorized across
+   * channels, so hundreds of IMU or sensor channels cost little more
+   * than a handful. A NaN sample is treated as a dropout: that channel
+   * predicts through it instead of updating.
+   *
+   * "constantVelocity" has a closed-form fast path, and steadyState
+   * replaces the covariance update with the precomputed converged gain.
+   * Every channel's state and covariance are saved in saveState().
+   *
+   * @param params - Configuration for the Kalman filter
+   * @param params.model - "level", "constantVelocity" or "custom" (default "level")
+   * @param params.processNoise - Process noise variance (default 1e-4)
+   * @param params.measurementNoise - Measurement noise variance (default 1e-2)
+   * @param params.dt - Time between frames for "constantVelocity" (default 1)
+   * @param params.initialCovariance - Initial covariance scale (default 1)
+   * @param params.steadyState - Use the steady-state gain (default false)
+   * @returns this instance for method chaining
+   *
+   * @example
+   * // Smooth 200 accelerometer channels sampled at 100 Hz
+   * pipeline.KalmanFilter({
+   *   model: "constantVelocity",
+   *   dt: 0.01,
+   *   processNoise: 0.5,
+   *   measurementNoise: 0.02,
+   * });
+   */
+  KalmanFilter(params: KalmanFilterParams = {}): this {
+    const model = params.model ?? "level";
+    if (!["level", "constantVelocity", "custom"].includes(model)) {
+      throw new TypeError(`KalmanFilter: unknown model '${model}'`);
+    }
+    const positive: Array<keyof KalmanFilterParams> = [
+      "measurementNoise",
+      "dt",
+      "initialCovariance",
+    ];
+    for (const name of positive) {
+      const value = params[name] as number | undefined;
+      if (value !== undefined && !(value > 0 && Number.isFinite(value))) {
+        throw new TypeError(
+          `KalmanFilter: ${name} must be positive, got ${value}`
+        );
+      }
+    }
+    if (
+      params.processNoise !== undefined &&
+      !(params.processNoise >= 0 && Number.isFinite(params.processNoise))
+    ) {
+      throw new TypeError(
+        `KalmanFilter: processNoise must be non-negative, got ${params.processNoise}`
+      );
+    }
+    if (model === "custom") {
+      const n = params.observation?.length ?? 0;
+      if (n < 1 || n > 4) {
+        throw new TypeError(
+          `KalmanFilter: a custom model needs an observation of 1 to 4 states, got ${n}`
+        );
+      }
+      if (
+        params.transition?.length !== n * n ||
+        params.processCovariance?.length !== n * n
+      ) {
+        throw new TypeError(
+          `KalmanFilter: transition and processCovariance must have ${n * n} entries for ${n} states`
+        );
+      }
+    }
+    this.nativeInstance.addStage("kalmanFilter", { ...params, model });
+    this.stages.push(`kalmanFilter:${model}`);
+    return this;
+  }
+
+  /**
+   * Add a streaming discrete wavelet transform stage (Daubechies haar to db10)
+   *
+   * Each level is computed with the lifting scheme, about half the
+   * multiplies of the equivalent filter bank, and keeps just enough
+   * history between chunks that any chunking gives the same result.
+   *
+   * In "decompose" mode this stage changes the stream size: every
+   * 2^levels input frames become one frame of numChannels * 2^levels
+   * coefficients, per channel a_J, d_J, d_J-1, ..., d_1 (coarsest first).
+   * In "denoise" mode the detail coefficients are soft- or
+   * hard-thresholded and the signal is reconstructed; the output is the
+   * same size as the input, delayed by a fixed number of frames.
+   *
+   * @param params - Configuration for the wavelet transform
+   * @param params.wavelet - "haar" or "db1" ... "db10" (default "db4")
+   * @param params.levels - Decomposition depth, 1 to 16 (default 3)
+   * @param params.mode - "decompose" or "denoise" (default "decompose")
+   * @param params.threshold - Detail threshold, one or one per level (default 0)
+   * @param params.thresholdMode - "soft" or "hard" (default "soft")
+   * @returns this instance for method chaining
+   *
+   * @example
+   * // Per-level coefficient bands of 8 EEG channels, 4 levels deep
+   * pipeline.WaveletTransform({ wavelet: "db4", levels: 4 });
+   *
+   * @example
+   * // Wavelet denoising, stronger on the finest levels
+   * pipeline.WaveletTransform({
+   *   wavelet: "db6",
+   *   levels: 3,
+   *   mode: "denoise",
+   *   threshold: [0.4, 0.2, 0.1],
+   * });
+   */
+  WaveletTransform(params: WaveletTransformParams = {}): this {
+    const wavelet = params.wavelet ?? "db4";
+    if (!/^(haar|db([1-9]|10))$/.test(wavelet)) {
+      throw new TypeError(`WaveletTransform: unknown wavelet '${wavelet}'`);
+    }
+    const levels = params.levels ?? 3;
+    if (!Number.isInteger(levels) || levels < 1 || levels > 16) {
+      throw new TypeError(
+        `WaveletTransform: levels must be an integer from 1 to 16, got ${levels}`
+      );
+    }
+    const mode = params.mode ?? "decompose";
+    if (mode !== "decompose" && mode !== "denoise") {
+      throw new TypeError(`WaveletTransform: unknown mode '${mode}'`);
+    }
+    const thresholdMode = params.thresholdMode ?? "soft";
+    if (thresholdMode !== "soft" && thresholdMode !== "hard") {
+      throw new TypeError(
+        `WaveletTransform: unknown thresholdMode '${thresholdMode}'`
+      );
+    }
+    if (params.threshold !== undefined) {
+      const thresholds = Array.isArray(params.threshold)
+        ? params.threshold
+        : [params.threshold];
+      if (Array.isArray(params.threshold) && thresholds.length !== levels) {
+        throw new TypeError(
+          `WaveletTransform: expected ${levels} thresholds, got ${thresholds.length}`
+        );
+      }
+      for (const value of thresholds) {
+        if (!(value >= 0 && Number.isFinite(value))) {
+          throw new TypeError(
+            `WaveletTransform: thresholds must be non-negative, got ${value}`
+          );
+        }
+      }
+    }
+    this.nativeInstance.addStage("waveletTransform", {
+      ...params,
+      wavelet,
+      levels,
+      mode,
+      thresholdMode,
+    });
+    this.stages.push(`waveletTransform:${wavelet}`);
+    return this;
+  }
+
+  private validateAdaptiveParams(name: string, params: LmsFilterParams): void {
+    if (params.numTaps <= 0 || !Number.isInteger(params.numTaps)) {
+      throw new TypeError(
+        `${name}: numTaps must be a positive integer, got ${params.numTaps}`
+      );
+    }
+    if (!(params.stepSize > 0 && Number.isFinite(params.stepSize))) {
+      throw new TypeError(
+        `${name}: stepSize must be positive, got ${params.stepSize}`
+      );
+    }
+    if (
+      params.referenceChannel !== undefined &&
+      (params.referenceChannel < 0 ||
+        !Number.isInteger(params.referenceChannel))
+    ) {
+      throw new TypeError(
+        `${name}: referenceChannel must be a channel index, got ${params.referenceChannel}`
+      );
+    }
+  }
+
+  private validatePercentileParams(
+    name: string,
+    params: MovingMedianParams
+  ): void {
+    if (params.windowSize === undefined && params.windowDuration === undefined) {
+      throw new TypeError(
+        `${name}: either windowSize or windowDuration must be specified`
+      );
+    }
+    if (
+      params.windowSize !== undefined &&
+      (params.windowSize <= 0 || !Number.isInteger(params.windowSize))
+    ) {
+      throw new TypeError(
+        `${name}: windowSize must be a positive integer, got ${params.windowSize}`
+      );
+    }
+    if (params.windowDuration !== undefined && params.windowDuration <= 0) {
+      throw new TypeError(
+        `${name}: windowDuration must be positive, got ${params.windowDuration}`
+      );
+    }
+    if (
+      params.method !== undefined &&
+      params.method !== "exact" &&
+      params.method !== "approximate"
+    ) {
+      throw new TypeError(
+        `${name}: method must be "exact" or "approximate", got ${params.method}`
+      );
+    }
+    if (params.method === "approximate" && params.windowSize === undefined) {
+      throw new TypeError(`${name}: "approximate" method requires windowSize`);
+    }
+  }
+
   /**
    * Tap into the pipeline for debugging and inspection
    * The callback is executed synchronously after processing, allowing you to inspect
@@ -930,7 +1745,11 @@ class DspProcessor {
    * Supports three modes:
    * 1. Legacy sample-based: process(samples, { sampleRate: 100, channels: 1 })
    * 2. Time-based with timestamps: process(samples, timestamps, { channels: 1 })
-   * 3. Auto-generated timestamps: process(samples, { channels: 1 }) - generates [0, 1, 2, ...]
+   * 3. Implicit timestamps: process(samples, { channels: 1 }) - sample indices [0, 1, 2, ...]
+   *
+   * Without explicit timestamps the stream is treated as uniformly sampled and
+   * the native layer supplies the clock (i * 1000 / sampleRate ms, or sample
+   * indices), so no timestamp array is allocated per call.
    *
    * IMPORTANT: This method modifies the input buffer in-place for performance.
    * If you need to preserve the original input, pass a copy instead.
@@ -938,7 +1757,9 @@ class DspProcessor {
    * @param input - Float32Array containing interleaved samples (will be modified in-place)
    * @param timestampsOrOptions - Either timestamps (Float32Array) or ProcessOptions
    * @param optionsIfTimestamps - ProcessOptions if second argument is timestamps
-   * @returns Promise that resolves to the processed Float32Array (same reference as input)
+   * @returns Promise that resolves to the processed Float32Array (same reference as input,
+   *          unless the pipeline has a stage that resizes the stream, such as EmgFeatures
+   *          or MovingStatistics)
    */
   async process(
     input: Float32Array,
@@ -960,23 +1781,9 @@ class DspProcessor {
         );
       }
     } else {
-      // Sample-based mode or auto-timestamps: process(samples, options)
+      // Sample-based mode: process(samples, options)
+      // The native layer supplies an implicit uniform clock
       options = { channels: 1, ...timestampsOrOptions };
-
-      if (options.sampleRate) {
-        // Legacy sample-based mode: auto-generate timestamps from sampleRate
-        const dt = 1000 / options.sampleRate; // milliseconds per sample
-        timestamps = new Float32Array(input.length);
-        for (let i = 0; i < input.length; i++) {
-          timestamps[i] = i * dt;
-        }
-      } else {
-        // Auto-generate sequential timestamps [0, 1, 2, ...]
-        timestamps = new Float32Array(input.length);
-        for (let i = 0; i < input.length; i++) {
-          timestamps[i] = i;
-        }
-      }
     }
 
     const startTime = performance.now();
@@ -1004,16 +1811,14 @@ class DspProcessor {
         sampleCount: input.length,
         channels: options.channels,
         stages: this.stages.length,
-        mode: options.sampleRate ? "sample-based" : "time-based",
+        mode: timestamps ? "time-based" : "sample-based",
       });
 
-      // Call native process with timestamps
+      // Call native process (timestamps only when the caller supplied them)
       // Note: The input buffer is modified in-place for zero-copy performance
-      const result = await this.nativeInstance.process(
-        input,
-        timestamps,
-        options
-      );
+      const result = timestamps
+        ? await this.nativeInstance.process(input, timestamps, options)
+        : await this.nativeInstance.process(input, options);
 
       // Execute tap callbacks for debugging/inspection
       if (this.tapCallbacks.length > 0) {
@@ -1155,6 +1960,76 @@ class DspProcessor {
     return this.nativeInstance.loadState(stateJson);
   }
 
+  /**
+   * Save the current pipeline state as a compact binary snapshot
+   *
+   * The snapshot is versioned and checksummed, and stores sample windows as
+   * raw float arrays, so it is much smaller and faster to produce than
+   * saveState() for pipelines with many channels or long windows. Use
+   * saveState() when a human-readable dump is needed for debugging.
+   *
+   * @returns Buffer containing the snapshot
+   *
+   * @example
+   * const snapshot = await pipeline.saveStateBinary();
+   * await redis.set('dsp:state', snapshot);
+   */
+  async saveStateBinary(): Promise<Buffer> {
+    return this.nativeInstance.saveStateBinary();
+  }
+
+  /**
+   * Load pipeline state from a binary snapshot produced by saveStateBinary()
+   *
+   * The snapshot is rejected (and an error thrown) if its checksum, version,
+   * stage count or stage types do not match this pipeline.
+   *
+   * @param snapshot - Buffer, Uint8Array or ArrayBuffer holding the snapshot
+   * @returns Promise that resolves to true if successful
+   *
+   * @example
+   * const snapshot = await redis.getBuffer('dsp:state');
+   * if (snapshot) {
+   *   await pipeline.loadStateBinary(snapshot);
+   * }
+   */
+  async loadStateBinary(snapshot: Uint8Array | ArrayBuffer): Promise<boolean> {
+    return this.nativeInstance.loadStateBinary(snapshot);
+  }
+
+  /**
+   * Take a checkpoint of the pipeline state without blocking the event loop
+   *
+   * Stage state is copied on a worker thread between two processed chunks,
+   * and the snapshot is then encoded off the main thread while processing
+   * continues. Resolves with the same format as saveStateBinary(), so it can
+   * be restored with loadStateBinary().
+   *
+   * With `delta: true` the checkpoint records, for window stages, only the
+   * samples pushed since the previous snapshot plus their running sums.
+   * Restore by loading the last full base and then every later delta in
+   * order; describeSnapshot() tells the two apart. A full base is written
+   * every `fullEvery` checkpoints, after the pipeline is restored, and
+   * whenever deltas grow past half the size of the base.
+   *
+   * @param options - Optional delta settings
+   * @returns Promise that resolves to a Buffer containing the snapshot
+   *
+   * @example
+   * setInterval(async () => {
+   *   await redis.set('dsp:state', await pipeline.checkpoint());
+   * }, 5000);
+   *
+   * @example
+   * // Append deltas to a Redis list, restarting it at every full base
+   * const snapshot = await pipeline.checkpoint({ delta: true, fullEvery: 32 });
+   * if (!describeSnapshot(snapshot).delta) await redis.del('dsp:chain');
+   * await redis.rpush('dsp:chain', snapshot);
+   */
+  async checkpoint(options?: CheckpointOptions): Promise<Buffer> {
+    return this.nativeInstance.checkpoint(options);
+  }
+
   /**
    * Clear all pipeline state (reset all filters to initial state)
    * This resets filter buffers without removing the stages
@@ -1170,6 +2045,8 @@ class DspProcessor {
    * List current pipeline state summary
    * Returns a lightweight view of the pipeline configuration without full state data.
    * Useful for debugging, monitoring, and inspecting pipeline structure.
+   * Never waits for a process() call in flight: while a chunk is running
+   * the counters are those published at the end of the previous chunk.
    *
    * @returns Object containing pipeline summary with stage info
    *
@@ -1188,12 +2065,108 @@ class DspProcessor {
    * //     { index: 0, type: 'movingAverage', windowSize: 100, numChannels: 1, bufferSize: 100, channelCount: 1 },
    * //     { index: 1, type: 'rectify', mode: 'full', numChannels: 1 },
    * //     { index: 2, type: 'rms', windowSize: 50, numChannels: 1, bufferSize: 50, channelCount: 1 }
-   * //   ]
+   * //   ],
+   * //   arena: { usedBytes: 704, capacityBytes: 65536, blocks: 1 }
    * // }
    */
   listState(): PipelineStateSummary {
     return this.nativeInstance.listState();
   }
+
+  /**
+   * Raw snapshot of the native timing counters. Every stage's process()
+   * call is timed with a monotonic clock, and every process() job records
+   * how long it queued, ran and waited to resolve. Reading the counters
+   * is lock-free and never waits for a chunk in progress.
+   *
+   * Layout (all durations in nanoseconds):
+   * `[stageCount, queue{count,totalNs,maxNs}, execute{...}, resolve{...}]`
+   * followed by `[calls, totalNs, maxNs, samples]` per stage.
+   * Use parseMetrics() or metrics() for a structured view.
+   *
+   * @returns A new Float64Array holding the current counter values
+   */
+  getMetrics(): Float64Array {
+    return this.nativeInstance.getMetrics();
+  }
+
+  /**
+   * Native timing counters with stage types filled in
+   *
+   * @example
+   * const { stages, queue } = pipeline.metrics();
+   * for (const stage of stages) {
+   *   console.log(`${stage.type}: ${stage.totalNs / stage.count} ns/call`);
+   * }
+   * console.log(`max queue wait: ${queue.maxNs / 1e6} ms`);
+   */
+  metrics(): PipelineMetrics {
+    const types = this.listState().stages.map((stage) => stage.type);
+    return parseMetrics(this.getMetrics(), types);
+  }
+
+  /**
+   * Zero every native timing counter (stages are kept)
+   */
+  resetMetrics(): void {
+    this.nativeInstance.resetMetrics();
+  }
+
+  /**
+   * Real-time mode: allocate every stage's windows and scratch buffers now
+   * instead of on the first chunk. Afterwards, process() calls with the
+   * same channel count and at most `maxBlockSize` samples per channel do
+   * not allocate in the native stage loop (the JS side still allocates its
+   * promise). Call it again after adding stages or changing the shape.
+   *
+   * Stage state is kept; stages whose channel count differs start empty.
+   * Exact moving percentiles still allocate while running; use
+   * `method: "approximate"` in real-time pipelines.
+   *
+   * @example
+   * const pipeline = createDspPipeline()
+   *   .Rms({ mode: "moving", windowDuration: 100 })
+   *   .prepare({ maxBlockSize: 256, channels: 8, sampleRate: 2000 });
+   */
+  prepare(options: PrepareOptions): this {
+    const { maxBlockSize, channels, sampleRate } = options;
+    if (!Number.isInteger(maxBlockSize) || maxBlockSize <= 0) {
+      throw new TypeError(
+        `prepare: maxBlockSize must be a positive integer, got ${maxBlockSize}`
+      );
+    }
+    if (!Number.isInteger(channels) || channels <= 0) {
+      throw new TypeError(
+        `prepare: channels must be a positive integer, got ${channels}`
+      );
+    }
+    if (
+      sampleRate !== undefined &&
+      (!Number.isFinite(sampleRate) || sampleRate <= 0)
+    ) {
+      throw new TypeError(
+        `prepare: sampleRate must be a positive number, got ${sampleRate}`
+      );
+    }
+    this.nativeInstance.prepare(maxBlockSize, channels, sampleRate ?? 0);
+    return this;
+  }
+
+  /**
+   * Heap allocations the native stages made while processing, counted
+   * since prepare(). A prepared pipeline should report
+   * `allocations === 0`. Counting needs a build made with
+   * `node-gyp rebuild --dspx_track_allocations=true`; check `tracked`.
+   *
+   * @example
+   * const report = pipeline.allocations();
+   * if (report.tracked && report.allocatingCalls > 0) {
+   *   console.warn(`${report.allocations} allocations while processing`);
+   * }
+   */
+  allocations(): AllocationReport {
+    return this.nativeInstance.getAllocations();
+  }
 }
 
 /**
@@ -1210,6 +2183,10 @@ class DspProcessor {
  * });
  *
  * @example
+ * // Compress sample windows in binary snapshots
+ * const pipeline = createDspPipeline({ snapshotCodec: 'delta' });
+ *
+ * @example
  * // Create pipeline without Redis (state is not persisted)
  * const pipeline = createDspPipeline();
  */
@@ -1218,4 +2195,161 @@ export function createDspPipeline(config?: RedisConfig): DspProcessor {
   return new DspProcessor(nativeInstance);
 }
 
+/**
+ * Read the header of a binary state snapshot without loading it
+ *
+ * Mirrors the header layout written by the native DspPipeline: magic "DSPB",
+ * u16 version, u16 flags (bit 0 delta, bits 1-2 float codec), f64 timestamp,
+ * u32 stage count and, from version 2, u64 generation and u64 base
+ * generation (all little-endian).
+ *
+ * @param snapshot - Snapshot from saveStateBinary() or checkpoint()
+ * @returns The snapshot's header fields
+ *
+ * @example
+ * const info = describeSnapshot(await pipeline.checkpoint({ delta: true }));
+ * console.log(info.delta ? `delta on ${info.baseGeneration}` : "full base");
+ */
+export function describeSnapshot(
+  snapshot: Uint8Array | ArrayBuffer
+): SnapshotInfo {
+  const bytes =
+    snapshot instanceof Uint8Array ? snapshot : new Uint8Array(snapshot);
+  const view = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+  const magic = String.fromCharCode(...bytes.subarray(0, 4));
+  if (bytes.byteLength < 20 || magic !== "DSPB") {
+    throw new Error("Not a DSP pipeline snapshot");
+  }
+
+  const version = view.getUint16(4, true);
+  const flags = view.getUint16(6, true);
+  const hasGeneration = version >= 2 && bytes.byteLength >= 36;
+  const generation = hasGeneration ? Number(view.getBigUint64(20, true)) : 0;
+  const codecs: SnapshotCodec[] = ["none", "xor", "delta"];
+  return {
+    version,
+    delta: (flags & 1) !== 0,
+    codec: codecs[(flags >> 1) & 3] ?? "none",
+    generation,
+    baseGeneration: hasGeneration
+      ? Number(view.getBigUint64(28, true))
+      : generation,
+    timestamp: view.getFloat64(8, true),
+    stageCount: view.getUint32(16, true),
+  };
+}
+
+/**
+ * Structure a getMetrics() snapshot
+ *
+ * @param snapshot - Float64Array from DspProcessor.getMetrics()
+ * @param stageTypes - Optional stage types, in pipeline order
+ * @returns Job latencies and per-stage timings
+ */
+export function parseMetrics(
+  snapshot: Float64Array,
+  stageTypes: string[] = []
+): PipelineMetrics {
+  const stats = (offset: number): DurationStats => ({
+    count: snapshot[offset],
+    totalNs: snapshot[offset + 1],
+    maxNs: snapshot[offset + 2],
+  });
+
+  const stageCount = snapshot[0] ?? 0;
+  const stages = [];
+  for (let i = 0; i < stageCount; i++) {
+    const offset = 10 + i * 4;
+    stages.push({
+      index: i,
+      type: stageTypes[i],
+      ...stats(offset),
+      samples: snapshot[offset + 3],
+    });
+  }
+
+  return { queue: stats(1), execute: stats(4), resolve: stats(7), stages };
+}
+
+/**
+ * Turn pipeline metrics into log entries, one per counter, for a metrics
+ * handler such as createPrometheusHandler(). Topics become metric names
+ * (e.g. `dsp.stage.duration_ns_total`) and the stage index and type
+ * become labels.
+ *
+ * @example
+ * const prometheus = createPrometheusHandler({ endpoint: PUSHGATEWAY });
+ * setInterval(async () => {
+ *   for (const entry of metricsToLogEntries(pipeline.metrics())) {
+ *     await prometheus(entry);
+ *   }
+ * }, 15000);
+ */
+export function metricsToLogEntries(
+  metrics: PipelineMetrics,
+  timestamp: number = Date.now()
+): LogEntry[] {
+  const entries: LogEntry[] = [];
+  const push = (
+    topic: string,
+    value: number,
+    labels: Record<string, string> = {}
+  ) => {
+    entries.push({
+      topic,
+      level: "info",
+      message: `${topic} ${value}`,
+      context: { ...labels, value },
+      timestamp,
+    });
+  };
+
+  for (const phase of ["queue", "execute", "resolve"] as const) {
+    const { count, totalNs, maxNs } = metrics[phase];
+    push(`dsp.job.${phase}_total`, count);
+    push(`dsp.job.${phase}_ns_total`, totalNs);
+    push(`dsp.job.${phase}_ns_max`, maxNs);
+  }
+
+  for (const stage of metrics.stages) {
+    const labels = {
+      stage: String(stage.index),
+      type: stage.type ?? "unknown",
+    };
+    push("dsp.stage.calls_total", stage.count, labels);
+    push("dsp.stage.duration_ns_total", stage.totalNs, labels);
+    push("dsp.stage.duration_ns_max", stage.maxNs, labels);
+    push("dsp.stage.samples_total", stage.samples, labels);
+  }
+
+  return entries;
+}
+
+/**
+ * Report which native SIMD kernel set is in use. The addon is built for
+ * the architecture baseline and picks the widest kernels the CPU supports
+ * (e.g. AVX2 over SSE2) when it loads; set DSPX_SIMD to cap that choice.
+ *
+ * @example
+ * const { level, supported } = getSimdInfo();
+ * console.log(`SIMD: ${level} (supported: ${supported.join(", ")})`);
+ */
+export function getSimdInfo(): SimdInfo {
+  return DspAddon.getSimdInfo();
+}
+
+/**
+ * Switch every native SIMD kernel to another supported level, process-wide.
+ * Meant for tests and benchmarks; a pipeline job already running may see
+ * both levels.
+ *
+ * @param level - One of getSimdInfo().supported
+ * @returns The level that was active before
+ * @throws {TypeError} If the level name is unknown
+ * @throws {Error} If the CPU does not support the level
+ */
+export function setSimdLevel(level: SimdLevel): SimdLevel {
+  return DspAddon.setSimdLevel(level);
+}
+
 export { DspProcessor };
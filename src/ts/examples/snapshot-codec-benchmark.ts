@@ -0,0 +1,92 @@
+/**
+ * Snapshot Codec Benchmark
+ *
+ * Compares the binary snapshot codecs ("none", "xor", "delta") on a
+ * multi-channel pipeline with long windows: snapshot size, and encode /
+ * decode throughput of saveStateBinary() / loadStateBinary().
+ *
+ * Run with: node --experimental-strip-types src/ts/examples/snapshot-codec-benchmark.ts
+ *
+ * Note: For accurate benchmarks, build in Release mode and run multiple times
+ * to account for V8 JIT compilation and CPU thermal throttling.
+ */
+
+import { createDspPipeline } from "../bindings.js";
+import type { SnapshotCodec } from "../types.js";
+
+const CHANNELS = 8;
+const WINDOW = 8192;
+const ITERATIONS = 50;
+
+function buildPipeline(codec: SnapshotCodec) {
+  return createDspPipeline({ snapshotCodec: codec })
+    .MovingAverage({ mode: "moving", windowSize: WINDOW })
+    .Rms({ mode: "moving", windowSize: WINDOW })
+    .Variance({ mode: "moving", windowSize: WINDOW });
+}
+
+// Smooth sensor-like signal: two slow sines plus a little noise
+function makeSignal(samplesPerChannel: number): Float32Array {
+  const signal = new Float32Array(samplesPerChannel * CHANNELS);
+  for (let i = 0; i < samplesPerChannel; i++) {
+    for (let c = 0; c < CHANNELS; c++) {
+      signal[i * CHANNELS + c] =
+        Math.sin(i * 0.002 + c) * 100 +
+        Math.cos(i * 0.013) * 20 +
+        (Math.random() - 0.5) * 0.05;
+    }
+  }
+  return signal;
+}
+
+async function benchmark() {
+  console.log("📦 Snapshot Codec Benchmark");
+  console.log("===========================\n");
+  console.log(
+    `  • ${CHANNELS} channels, 3 window stages of ${WINDOW} samples, ${ITERATIONS} iterations\n`
+  );
+
+  const signal = makeSignal(WINDOW);
+  const windowBytes = 3 * CHANNELS * WINDOW * 4;
+  let rawSize = 0;
+
+  for (const codec of ["none", "xor", "delta"] as const) {
+    const pipeline = buildPipeline(codec);
+    await pipeline.process(new Float32Array(signal), {
+      channels: CHANNELS,
+      sampleRate: 1000,
+    });
+
+    let snapshot = await pipeline.saveStateBinary();
+    const encodeStart = performance.now();
+    for (let i = 0; i < ITERATIONS; i++) {
+      snapshot = await pipeline.saveStateBinary();
+    }
+    const encodeMs = performance.now() - encodeStart;
+
+    const target = buildPipeline(codec);
+    const decodeStart = performance.now();
+    for (let i = 0; i < ITERATIONS; i++) {
+      await target.loadStateBinary(snapshot);
+    }
+    const decodeMs = performance.now() - decodeStart;
+
+    if (codec === "none") {
+      rawSize = snapshot.byteLength;
+    }
+    const mbPerSec = (ms: number) =>
+      ((windowBytes * ITERATIONS) / (ms / 1000) / 1e6).toFixed(0);
+
+    console.log(`🔧 ${codec}`);
+    console.log(
+      `  ✅ Size: ${(snapshot.byteLength / 1024).toFixed(1)} KiB (${(
+        (snapshot.byteLength / rawSize) *
+        100
+      ).toFixed(1)}% of raw)`
+    );
+    console.log(`  ✅ Encode: ${mbPerSec(encodeMs)} MB/s of window data`);
+    console.log(`  ✅ Decode: ${mbPerSec(decodeMs)} MB/s of window data\n`);
+  }
+}
+
+benchmark().catch(console.error);
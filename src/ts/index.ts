@@ -1,5 +1,13 @@
 // Export the main API
-export { createDspPipeline, DspProcessor } from "./bindings.js";
+export {
+  createDspPipeline,
+  DspProcessor,
+  describeSnapshot,
+  parseMetrics,
+  metricsToLogEntries,
+  getSimdInfo,
+  setSimdLevel,
+} from "./bindings.js";
 export {
   TopicRouter,
   TopicRouterBuilder,
@@ -85,6 +93,29 @@ export type {
   VarianceParams,
   ZScoreNormalizeParams,
   MeanAbsoluteValueParams,
+  MovingMedianParams,
+  MovingPercentileParams,
+  MovingStatisticsParams,
+  MovingStatisticName,
+  EmgFeaturesParams,
+  EmgFeatureName,
+  PrebuiltParams,
+  PrebuiltPipelineName,
+  SpatialFilterParams,
+  SpatialFilterLayout,
+  CommonAverageSpatialFilterParams,
+  LaplacianSpatialFilterParams,
+  BipolarSpatialFilterParams,
+  MatrixSpatialFilterParams,
+  PcaParams,
+  PcaMode,
+  LmsFilterParams,
+  NlmsFilterParams,
+  RlsFilterParams,
+  KalmanFilterParams,
+  KalmanModel,
+  WaveletTransformParams,
+  WaveletName,
 
   // logging and monitoring interfaces
   PipelineCallbacks,
@@ -96,7 +127,18 @@ export type {
   SampleBatch,
   TapCallback,
   PipelineStateSummary,
+  ArenaSummary,
+  PrepareOptions,
+  AllocationReport,
   StageSummary,
+  CheckpointOptions,
+  SnapshotInfo,
+  DurationStats,
+  StageMetrics,
+  PipelineMetrics,
+  SimdInfo,
+  SimdLevel,
+  SnapshotCodec,
 
   // Advanced DSP types
   HjorthParameters,
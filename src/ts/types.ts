@@ -57,8 +57,22 @@ export interface RedisConfig {
   redisHost?: string;
   redisPort?: number;
   stateKey?: string;
+  /**
+   * Lossless compression for float arrays (sample windows) in binary
+   * snapshots from saveStateBinary() and checkpoint():
+   * - "none": raw 4 bytes per sample (default, fastest)
+   * - "xor": Gorilla-style XOR of consecutive values
+   * - "delta": delta + zigzag + varint of the float bit patterns
+   * Snapshots record their codec, so any pipeline can load them.
+   */
+  snapshotCodec?: SnapshotCodec;
 }
 
+/**
+ * Float compression codec for binary snapshots
+ */
+export type SnapshotCodec = "none" | "xor" | "delta";
+
 /**
  * Parameters for adding a moving average stage
  *
@@ -240,6 +254,497 @@ export interface WillisonAmplitudeParams {
   threshold?: number;
 }
 
+/**
+ * Parameters shared by the moving median / percentile stages
+ *
+ * Two windowing modes supported:
+ * 1. Sample-based: windowSize in samples
+ * 2. Time-based: windowDuration in milliseconds ("exact" method only)
+ */
+export interface MovingMedianParams {
+  /**
+   * Window size in samples
+   * Required when windowDuration is not given, and for the "approximate" method
+   */
+  windowSize?: number;
+
+  /**
+   * Window duration in milliseconds (time-based mode)
+   */
+  windowDuration?: number;
+
+  /**
+   * Order-statistic algorithm (default: "exact")
+   * - "exact": double heap with lazy deletion, O(log w) per sample
+   * - "approximate": P² estimator, constant memory, for very long windows
+   */
+  method?: "exact" | "approximate";
+}
+
+/**
+ * Parameters for adding a moving percentile stage
+ */
+export interface MovingPercentileParams extends MovingMedianParams {
+  /**
+   * Percentile to track, between 0 and 100 (50 = median)
+   */
+  percentile: number;
+}
+
+/**
+ * A statistic computed by the movingStatistics stage
+ */
+export type MovingStatisticName =
+  | "mean"
+  | "rms"
+  | "meanAbsoluteValue"
+  | "variance";
+
+/**
+ * Parameters for adding a multi-statistic moving window stage
+ *
+ * All statistics share one window per channel. Every input sample yields
+ * one value per statistic, so the output has
+ * numChannels * statistics.length channels ([channel][statistic] per frame).
+ */
+export interface MovingStatisticsParams {
+  /**
+   * Window size in samples per channel
+   */
+  windowSize: number;
+
+  /**
+   * Statistics to compute, in output order
+   */
+  statistics: MovingStatisticName[];
+}
+
+/**
+ * A time-domain EMG feature computed by the emgFeatures stage
+ */
+export type EmgFeatureName =
+  | "meanAbsoluteValue"
+  | "rms"
+  | "waveformLength"
+  | "slopeSignChange"
+  | "willisonAmplitude"
+  | "zeroCrossings"
+  | "variance";
+
+/**
+ * Parameters for adding a fused EMG feature stage
+ *
+ * All features share one window per channel and are computed in a single
+ * pass. One feature frame is emitted every hopSize input frames, so the
+ * output has numChannels * features.length channels
+ * ([channel][feature] per frame) and is shorter than the input.
+ */
+export interface EmgFeaturesParams {
+  /**
+   * Window size in samples per channel
+   */
+  windowSize: number;
+
+  /**
+   * Input frames between feature frames (default: windowSize)
+   */
+  hopSize?: number;
+
+  /**
+   * Features to compute, in output order (default: all seven, in the
+   * order of EmgFeatureName)
+   */
+  features?: EmgFeatureName[];
+
+  /**
+   * Slope sign change threshold (default: 0.0)
+   */
+  sscThreshold?: number;
+
+  /**
+   * Willison amplitude threshold (default: 0.0)
+   */
+  wampThreshold?: number;
+
+  /**
+   * Minimum step |x[k] - x[k-1]| for a zero crossing to count (default: 0.0)
+   */
+  zcThreshold?: number;
+}
+
+/**
+ * A fixed stage chain available as one fused prebuilt stage
+ *
+ * - rectifyMavZScore: Rectify -> MeanAbsoluteValue -> ZScoreNormalize
+ * - rmsZScore: Rms -> ZScoreNormalize
+ */
+export type PrebuiltPipelineName = "rectifyMavZScore" | "rmsZScore";
+
+/**
+ * Parameters for adding a prebuilt (statically fused) stage chain
+ *
+ * The chain produces the same output as its stages added one by one in
+ * "moving" mode with sample-count windows, but runs them in a single pass.
+ */
+export interface PrebuiltParams {
+  /**
+   * Which chain to run
+   */
+  name: PrebuiltPipelineName;
+
+  /**
+   * Envelope window in samples per channel (MeanAbsoluteValue / Rms)
+   */
+  windowSize: number;
+
+  /**
+   * ZScoreNormalize window in samples per channel (default: windowSize)
+   */
+  zScoreWindowSize?: number;
+
+  /**
+   * ZScoreNormalize: standard deviation below which the output is 0
+   * (default: 1e-6)
+   */
+  epsilon?: number;
+
+  /**
+   * Rectify mode for chains that start with Rectify (default: "full")
+   */
+  mode?: "full" | "half";
+}
+
+/**
+ * How a spatial filter evaluates its matrix
+ *
+ * - auto: sparse when the matrix is montage-like, otherwise dense
+ * - dense: cache-blocked SIMD matrix multiply over the whole chunk
+ * - sparse: per-row nonzero terms plus a per-row constant times the
+ *   channel sum (common average reference is O(channels) per frame)
+ */
+export type SpatialFilterLayout = "auto" | "dense" | "sparse";
+
+/**
+ * Common average reference: every channel minus the mean of all channels
+ */
+export interface CommonAverageSpatialFilterParams {
+  mode: "car";
+
+  /**
+   * Number of input (and output) channels
+   */
+  channels: number;
+
+  layout?: SpatialFilterLayout;
+}
+
+/**
+ * Surface Laplacian: every channel minus the mean of its neighbors
+ */
+export interface LaplacianSpatialFilterParams {
+  mode: "laplacian";
+
+  /**
+   * Neighbor channel indices of each channel (one list per channel);
+   * channels with an empty list pass through unchanged
+   */
+  neighbors: number[][];
+
+  layout?: SpatialFilterLayout;
+}
+
+/**
+ * Bipolar montage: one output channel x[a] - x[b] per pair
+ */
+export interface BipolarSpatialFilterParams {
+  mode: "bipolar";
+
+  /**
+   * Number of input channels
+   */
+  channels: number;
+
+  /**
+   * [a, b] channel index pairs, in output order
+   */
+  pairs: Array<[number, number]>;
+
+  layout?: SpatialFilterLayout;
+}
+
+/**
+ * Arbitrary mixing matrix (e.g. CSP or ICA unmixing weights)
+ */
+export interface MatrixSpatialFilterParams {
+  mode: "matrix";
+
+  /**
+   * One row per output channel, one weight per input channel
+   */
+  matrix: number[][];
+
+  layout?: SpatialFilterLayout;
+}
+
+/**
+ * Parameters for adding a spatial filter (channel mixing matrix) stage
+ */
+export type SpatialFilterParams =
+  | CommonAverageSpatialFilterParams
+  | LaplacianSpatialFilterParams
+  | BipolarSpatialFilterParams
+  | MatrixSpatialFilterParams;
+
+/**
+ * What a PCA stage outputs
+ *
+ * - pca: projections onto the principal components, largest first
+ * - whiten: the same projections scaled to unit variance
+ * - zca: whitened data rotated back into channel space (one output per
+ *   input channel)
+ */
+export type PcaMode = "pca" | "whiten" | "zca";
+
+/**
+ * Parameters for adding a streaming PCA / whitening stage
+ *
+ * Exactly one of windowSize and alpha selects how the covariance is
+ * tracked.
+ */
+export interface PcaParams {
+  /**
+   * Output mode (default: "pca")
+   */
+  mode?: PcaMode;
+
+  /**
+   * Components kept, largest first (default: all). In "zca" mode the
+   * output stays one channel per input and the discarded components are
+   * projected out.
+   */
+  components?: number;
+
+  /**
+   * Frames in a sliding covariance window
+   */
+  windowSize?: number;
+
+  /**
+   * Exponential weight of each new frame, in (0, 1]
+   */
+  alpha?: number;
+
+  /**
+   * Frames between eigen-decompositions (default: 256)
+   */
+  updateInterval?: number;
+
+  /**
+   * Added to the eigenvalues before whitening (default: 1e-6)
+   */
+  epsilon?: number;
+
+  /**
+   * Decompose on a worker thread so process() never waits for it
+   * (default: true). With false every update happens inline, which makes
+   * the output deterministic.
+   */
+  background?: boolean;
+}
+
+/**
+ * Parameters for adding an LMS adaptive filter stage
+ *
+ * One channel of the stream is the noise reference; every other channel
+ * gets its own adaptive FIR filter that learns to predict its
+ * reference-correlated part, and the stage outputs what is left.
+ */
+export interface LmsFilterParams {
+  /**
+   * Taps of every adaptive filter (how far back the reference is used)
+   */
+  numTaps: number;
+
+  /**
+   * Adaptation rate mu. LMS is only stable below 2 / (numTaps * reference
+   * power); NLMS normalizes by the reference energy and needs 0 < mu < 2
+   */
+  stepSize: number;
+
+  /**
+   * Index of the reference channel (default: the last channel)
+   */
+  referenceChannel?: number;
+}
+
+/**
+ * Parameters for adding an NLMS (normalized LMS) adaptive filter stage
+ */
+export interface NlmsFilterParams extends LmsFilterParams {
+  /**
+   * Added to the reference energy before normalizing; must be positive,
+   * since a silent reference window would otherwise divide by zero
+   * (default: 1e-6)
+   */
+  epsilon?: number;
+}
+
+/**
+ * Parameters for adding an RLS (recursive least squares) adaptive filter
+ * stage; channels are routed like LmsFilterParams
+ */
+export interface RlsFilterParams {
+  /**
+   * Taps of every adaptive filter (the filter order); cost grows with
+   * numTaps squared, so keep it to a few dozen
+   */
+  numTaps: number;
+
+  /**
+   * Forgetting factor in (0, 1] (default: 0.99); the filter tracks the
+   * last ~1 / (1 - lambda) frames
+   */
+  lambda?: number;
+
+  /**
+   * Initial regularization: the inverse correlation matrix starts at
+   * I / delta (default: 0.01)
+   */
+  delta?: number;
+
+  /**
+   * Index of the reference channel (default: the last channel)
+   */
+  referenceChannel?: number;
+}
+
+/**
+ * State-space model of a Kalman filter stage
+ *
+ * - level: a random walk, x = level (smoothing a slowly drifting value)
+ * - constantVelocity: x = (position, velocity) with random acceleration;
+ *   tracks ramps without lag
+ * - custom: transition, observation and processCovariance given
+ *   explicitly (up to 4 states)
+ */
+export type KalmanModel = "level" | "constantVelocity" | "custom";
+
+/**
+ * Parameters for adding a Kalman filter stage: one independent filter per
+ * channel, all sharing the same model and noise levels
+ */
+export interface KalmanFilterParams {
+  /**
+   * State-space model (default: "level")
+   */
+  model?: KalmanModel;
+
+  /**
+   * Process noise variance per frame: of a level step ("level") or of
+   * the acceleration ("constantVelocity") (default: 1e-4)
+   */
+  processNoise?: number;
+
+  /**
+   * Measurement noise variance (default: 1e-2). The ratio
+   * processNoise / measurementNoise sets how much smoothing you get.
+   */
+  measurementNoise?: number;
+
+  /**
+   * Time between frames for "constantVelocity" (default: 1); the
+   * velocity state is in units per dt
+   */
+  dt?: number;
+
+  /**
+   * Every covariance starts at initialCovariance * I (default: 1)
+   */
+  initialCovariance?: number;
+
+  /**
+   * Use the precomputed steady-state gain instead of propagating the
+   * covariance (default: false). Same output once the filter has
+   * settled, several times cheaper per sample; the covariance is not
+   * tracked, so dropouts do not widen it.
+   */
+  steadyState?: boolean;
+
+  /**
+   * "custom" only: state transition F, states x states row-major
+   */
+  transition?: number[];
+
+  /**
+   * "custom" only: observation row H (one entry per state); the number
+   * of states is its length
+   */
+  observation?: number[];
+
+  /**
+   * "custom" only: process noise covariance Q, states x states
+   * row-major, symmetric
+   */
+  processCovariance?: number[];
+}
+
+/**
+ * Daubechies wavelet of a wavelet transform stage: "haar" (= "db1") or
+ * "db2" ... "db10". dbN has 2N taps and N vanishing moments: its detail
+ * coefficients are zero for polynomials of degree below N.
+ */
+export type WaveletName =
+  | "haar"
+  | "db1"
+  | "db2"
+  | "db3"
+  | "db4"
+  | "db5"
+  | "db6"
+  | "db7"
+  | "db8"
+  | "db9"
+  | "db10";
+
+/**
+ * Parameters for adding a streaming discrete wavelet transform stage
+ */
+export interface WaveletTransformParams {
+  /**
+   * Wavelet (default: "db4")
+   */
+  wavelet?: WaveletName;
+
+  /**
+   * Decomposition depth J, 1 to 16 (default: 3)
+   */
+  levels?: number;
+
+  /**
+   * - decompose: every 2^levels input frames become one output frame of
+   *   numChannels * 2^levels coefficients: per channel a_J, d_J,
+   *   d_J-1 (2 values), ..., d_1 (2^(levels-1) values)
+   * - denoise: threshold the detail coefficients and reconstruct the
+   *   signal, same size as the input but delayed
+   *
+   * (default: "decompose")
+   */
+  mode?: "decompose" | "denoise";
+
+  /**
+   * "denoise" only: detail threshold, one for every level or one per
+   * level, finest first (default: 0, which reconstructs the input)
+   */
+  threshold?: number | number[];
+
+  /**
+   * "denoise" only: soft thresholding shrinks every detail towards 0 by
+   * the threshold, hard thresholding zeroes the ones below it
+   * (default: "soft")
+   */
+  thresholdMode?: "soft" | "hard";
+}
+
 /**
  * Tap callback function for inspecting samples at any point in the pipeline
  * @param samples - Float32Array view of the current samples
@@ -415,9 +920,9 @@ export interface StageSummary {
   windowDuration?: number;
   /** Number of channels (if applicable) */
   numChannels?: number;
-  /** Rectification mode for rectify stage (if applicable) */
-  mode?: "full" | "half";
-  /** Buffer size for stateful filters (if applicable) */
+  /** Rectify mode ("full" | "half") or averaging mode ("moving" | "batch") */
+  mode?: "full" | "half" | "moving" | "batch";
+  /** Samples buffered in the first channel's window (if applicable) */
   bufferSize?: number;
   /** Number of channels with state (if applicable) */
   channelCount?: number;
@@ -434,6 +939,166 @@ export interface PipelineStateSummary {
   timestamp: number;
   /** Array of stage summaries */
   stages: StageSummary[];
+  /** The pipeline's arena, which holds the stages' window buffers */
+  arena: ArenaSummary;
+}
+
+/**
+ * Memory held by a pipeline's stage arena (see listState())
+ *
+ * Window buffers are carved from 64-byte aligned blocks when a stage is
+ * added and on its first process() call; they are released together
+ * with the pipeline.
+ */
+export interface ArenaSummary {
+  /** Bytes handed out to stage buffers */
+  usedBytes: number;
+  /** Bytes reserved across all blocks */
+  capacityBytes: number;
+  /** Number of blocks */
+  blocks: number;
+}
+
+/**
+ * Options for DspProcessor.prepare()
+ */
+export interface PrepareOptions {
+  /** Largest chunk process() will be given, in samples per channel */
+  maxBlockSize: number;
+  /** Channel count of every chunk */
+  channels: number;
+  /**
+   * Sample rate in Hz. Required when a stage uses `windowDuration`, whose
+   * window is otherwise sized from the first chunk's timestamps.
+   */
+  sampleRate?: number;
+}
+
+/**
+ * Heap allocations made by the stages while processing (see allocations())
+ *
+ * Counts are only collected by builds made with
+ * `node-gyp rebuild --dspx_track_allocations=true`; other builds report
+ * `tracked: false` and zero counts.
+ */
+export interface AllocationReport {
+  /** Whether this build counts allocations */
+  tracked: boolean;
+  /** Whether prepare() has run since the last stage was added */
+  prepared: boolean;
+  /** process() calls since prepare() (or since the pipeline was built) */
+  calls: number;
+  /** Calls that allocated at least once */
+  allocatingCalls: number;
+  /** Allocations across those calls */
+  allocations: number;
+  /** Bytes requested by those allocations */
+  bytes: number;
+  /** Allocations made by the most recent call */
+  lastCallAllocations: number;
+  /** The prepare() options (only when prepared) */
+  maxBlockSize?: number;
+  channels?: number;
+  sampleRate?: number;
+}
+
+/**
+ * Options for DspProcessor.checkpoint()
+ */
+export interface CheckpointOptions {
+  /**
+   * Write a delta against the previous snapshot when possible: window stages
+   * then record only the samples pushed since, not their whole windows.
+   * Default: false (always a full snapshot)
+   */
+  delta?: boolean;
+  /** With delta, write a full base at least every N checkpoints. Default: 16 */
+  fullEvery?: number;
+}
+
+/**
+ * Header fields of a binary state snapshot (see describeSnapshot())
+ */
+export interface SnapshotInfo {
+  /** Snapshot format version */
+  version: number;
+  /** True for a delta, which only applies on top of baseGeneration */
+  delta: boolean;
+  /** Float codec used for the sample windows */
+  codec: SnapshotCodec;
+  /**
+   * Generation of this snapshot: counts checkpoint() calls. 0 for
+   * saveStateBinary() and version 1 snapshots, which are not part of a
+   * delta chain
+   */
+  generation: number;
+  /** Generation this snapshot applies to (equals generation for full snapshots) */
+  baseGeneration: number;
+  /** Unix time (seconds) at which the snapshot was written */
+  timestamp: number;
+  /** Number of stages in the snapshot */
+  stageCount: number;
+}
+
+/**
+ * Count, total and maximum of a series of durations, in nanoseconds
+ */
+export interface DurationStats {
+  count: number;
+  totalNs: number;
+  maxNs: number;
+}
+
+/**
+ * Native timing of one stage's process() calls
+ */
+export interface StageMetrics extends DurationStats {
+  /** Stage index in the pipeline */
+  index: number;
+  /** Stage type (e.g., 'movingAverage'), when known */
+  type?: string;
+  /** Interleaved samples handled across all calls */
+  samples: number;
+}
+
+/**
+ * Native timing counters of a pipeline (see DspProcessor.metrics())
+ */
+export interface PipelineMetrics {
+  /** From queueing a process() job until a worker starts running it */
+  queue: DurationStats;
+  /** Running every stage of a job */
+  execute: DurationStats;
+  /** From the end of a job until its promise settles on the main thread */
+  resolve: DurationStats;
+  stages: StageMetrics[];
+}
+
+/**
+ * Native SIMD kernel set
+ */
+export type SimdLevel = "scalar" | "sse2" | "avx2" | "avx512" | "neon";
+
+/**
+ * SIMD kernel dispatch state of the native addon (see getSimdInfo())
+ */
+export interface SimdInfo {
+  /** Kernel set in use */
+  level: SimdLevel;
+  /** Widest kernel set this CPU supports */
+  best: SimdLevel;
+  /** Every kernel set that can run on this CPU */
+  supported: SimdLevel[];
+  /** CPU features detected at load time */
+  features: {
+    sse2: boolean;
+    sse3: boolean;
+    avx: boolean;
+    avx2: boolean;
+    fma: boolean;
+    avx512f: boolean;
+    neon: boolean;
+  };
 }
 
 /**